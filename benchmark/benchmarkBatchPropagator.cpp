@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/numeric/odeint.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/batchPropagator.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+//! Benchmark batch propagation against separate odeint integrations.
+/*!
+ * Propagates N low Earth orbits (N = first argument, default = 4096) over one orbital period,
+ * once as N separate calls to odeint and once as a single batch, for both the fixed-step and the
+ * adaptive variant. Throughput is reported as states propagated per second.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const unsigned int numberOfStates
+        = numberOfInputs > 1 ? std::atoi( inputArguments[ 1 ] ) : 4096;
+    const double gravitationalParameter = 398600.4418;
+    const double startTime = 0.0;
+    const double endTime = 6000.0;
+    const double stepSize = 10.0;
+    const double tolerance = 1.0e-10;
+
+    std::vector< scarab::State > initialStates( numberOfStates );
+    for ( unsigned int i = 0; i < numberOfStates; i++ )
+    {
+        const double inclination = 1.0e-4 * i;
+        initialStates[ i ][ 0 ] = 7000.0 + 0.01 * i;
+        initialStates[ i ][ 1 ] = 0.0;
+        initialStates[ i ][ 2 ] = 0.0;
+        initialStates[ i ][ 3 ] = 0.0;
+        initialStates[ i ][ 4 ] = 7.5 * std::cos( inclination );
+        initialStates[ i ][ 5 ] = 7.5 * std::sin( inclination );
+    }
+
+    scarab::ListOfAccelerationModels listOfAccelerationModels;
+    scarab::DataStore data( initialStates[ 0 ], startTime, gravitationalParameter,
+                            listOfAccelerationModels );
+    data.listOfAccelerationModels[ scarab::centralGravityModelId ]
+        = boost::make_shared< scarab::CentralGravityModel >( data.gravitationalParameter );
+    scarab::StateDerivativeModel stateDerivativeModel( data );
+
+    scarab::ListOfBatchAccelerationModels batchModels;
+    batchModels.push_back(
+        boost::make_shared< scarab::BatchCentralGravityModel >( gravitationalParameter ) );
+    scarab::BatchPropagator propagator( batchModels, numberOfStates );
+
+    scarab::BatchState initialBatch( numberOfStates );
+    for ( unsigned int i = 0; i < numberOfStates; i++ )
+    {
+        initialBatch.setState( i, initialStates[ i ] );
+    }
+
+    std::cout << "Number of states: " << numberOfStates << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Variant"
+              << std::setw( 16 ) << "Time [s]"
+              << std::setw( 20 ) << "States per second" << std::endl;
+
+    // Fixed step: separate odeint integrations.
+    double checksum = 0.0;
+    Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfStates; i++ )
+    {
+        scarab::State state = initialStates[ i ];
+        boost::numeric::odeint::integrate_const(
+            boost::numeric::odeint::runge_kutta4< scarab::State >( ),
+            stateDerivativeModel, state, startTime, endTime, stepSize );
+        checksum += state[ 0 ];
+    }
+    const double fixedStepOdeintTime
+        = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "odeint RK4 (per state)"
+              << std::setw( 16 ) << fixedStepOdeintTime
+              << std::setw( 20 ) << numberOfStates / fixedStepOdeintTime << std::endl;
+
+    // Fixed step: batch.
+    scarab::BatchState batch( initialBatch );
+    start = Clock::now( );
+    propagator.propagateFixedStep( batch, startTime, endTime, stepSize );
+    const double fixedStepBatchTime
+        = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "Batch RK4"
+              << std::setw( 16 ) << fixedStepBatchTime
+              << std::setw( 20 ) << numberOfStates / fixedStepBatchTime << std::endl;
+    checksum += batch[ 0 ][ 0 ];
+
+    // Adaptive: separate odeint integrations.
+    start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfStates; i++ )
+    {
+        scarab::State state = initialStates[ i ];
+        boost::numeric::odeint::integrate_adaptive(
+            boost::numeric::odeint::make_controlled(
+                tolerance, tolerance,
+                boost::numeric::odeint::runge_kutta_dopri5< scarab::State >( ) ),
+            stateDerivativeModel, state, startTime, endTime, stepSize );
+        checksum += state[ 0 ];
+    }
+    const double adaptiveOdeintTime
+        = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "odeint DOPRI5 (per state)"
+              << std::setw( 16 ) << adaptiveOdeintTime
+              << std::setw( 20 ) << numberOfStates / adaptiveOdeintTime << std::endl;
+
+    // Adaptive: batch.
+    batch = initialBatch;
+    start = Clock::now( );
+    propagator.propagateAdaptive( batch, startTime, endTime, stepSize, tolerance, tolerance );
+    const double adaptiveBatchTime
+        = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "Batch DOPRI5 (lane-wise control)"
+              << std::setw( 16 ) << adaptiveBatchTime
+              << std::setw( 20 ) << numberOfStates / adaptiveBatchTime << std::endl;
+    checksum += batch[ 0 ][ 0 ];
+
+    std::cout << std::endl;
+    std::cout << "Speed-up fixed step:                " << fixedStepOdeintTime / fixedStepBatchTime
+              << std::endl;
+    std::cout << "Speed-up adaptive:                  " << adaptiveOdeintTime / adaptiveBatchTime
+              << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
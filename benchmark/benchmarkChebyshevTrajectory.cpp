@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+//! Get state on synthetic eccentric orbit at given time.
+scarab::State getEccentricOrbitState( const double time )
+{
+    const double gravitationalParameter = 398600.4418;
+    const double semiMajorAxis = 8000.0;
+    const double eccentricity = 0.1;
+    const double inclination = 0.9;
+    const double meanMotion
+        = std::sqrt( gravitationalParameter / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) );
+
+    // Solve Kepler's equation for the eccentric anomaly.
+    const double meanAnomaly = meanMotion * time;
+    double eccentricAnomaly = meanAnomaly;
+    for ( unsigned int i = 0; i < 10; i++ )
+    {
+        eccentricAnomaly -= ( eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly )
+                              - meanAnomaly )
+                            / ( 1.0 - eccentricity * std::cos( eccentricAnomaly ) );
+    }
+
+    const double semiMinorAxis = semiMajorAxis * std::sqrt( 1.0 - eccentricity * eccentricity );
+    const double anomalyRate
+        = meanMotion / ( 1.0 - eccentricity * std::cos( eccentricAnomaly ) );
+    const double x = semiMajorAxis * ( std::cos( eccentricAnomaly ) - eccentricity );
+    const double y = semiMinorAxis * std::sin( eccentricAnomaly );
+    const double vx = -semiMajorAxis * std::sin( eccentricAnomaly ) * anomalyRate;
+    const double vy = semiMinorAxis * std::cos( eccentricAnomaly ) * anomalyRate;
+
+    scarab::State state;
+    state[ 0 ] = x;
+    state[ 1 ] = y * std::cos( inclination );
+    state[ 2 ] = y * std::sin( inclination );
+    state[ 3 ] = vx;
+    state[ 4 ] = vy * std::cos( inclination );
+    state[ 5 ] = vy * std::sin( inclination );
+    return state;
+}
+
+//! Get size of file [MB].
+double getFileSize( const std::string& filename )
+{
+    std::ifstream file( filename.c_str( ), std::ios::binary | std::ios::ate );
+    return file.tellg( ) / 1.0e6;
+}
+
+//! Benchmark size and evaluation cost of Chebyshev trajectories.
+/*!
+ * Writes a synthetic eccentric orbit of N samples every 30 s (N = first argument, default =
+ * 100000) as CSV file, as binary trajectory file and as Chebyshev trajectory files with position
+ * tolerances of 1 m and 1 mm, and reports the file sizes and the time to write them. The
+ * Chebyshev trajectory with the tightest tolerance is then evaluated at 1000000 random epochs and
+ * at 1000000 consecutive epochs, and the time per evaluation and the maximum position error with
+ * respect to the orbit are reported.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::size_t numberOfSamples
+        = numberOfInputs > 1 ? std::strtoul( inputArguments[ 1 ], 0, 10 ) : 100000;
+    const double sampleInterval = 30.0;
+    const std::string csvFilename = "benchmarkChebyshevTrajectory.csv";
+    const std::string binaryFilename = "benchmarkChebyshevTrajectory.bin";
+    const std::string chebyshevFilename = "benchmarkChebyshevTrajectory.cheb";
+
+    std::cout << "Number of samples: " << numberOfSamples << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Variant"
+              << std::setw( 16 ) << "Time [s]"
+              << std::setw( 16 ) << "Size [MB]"
+              << std::setw( 16 ) << "Segments" << std::endl;
+
+    Clock::time_point start = Clock::now( );
+    {
+        std::ofstream file( csvFilename.c_str( ) );
+        scarab::StreamingStateHistoryWriter writer( file, 4096, "t,x,y,z,vx,vy,vz" );
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            writer.write( i * sampleInterval, getEccentricOrbitState( i * sampleInterval ) );
+        }
+    }
+    double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    const double csvSize = getFileSize( csvFilename );
+    std::cout << std::setw( 36 ) << "CSV"
+              << std::setw( 16 ) << elapsedTime
+              << std::setw( 16 ) << csvSize
+              << std::setw( 16 ) << "-" << std::endl;
+
+    start = Clock::now( );
+    {
+        scarab::BinaryStateHistoryWriter writer( binaryFilename, 4096 );
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            writer.write( i * sampleInterval, getEccentricOrbitState( i * sampleInterval ) );
+        }
+        writer.close( scarab::TrajectoryMetadata( ) );
+    }
+    elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "Binary"
+              << std::setw( 16 ) << elapsedTime
+              << std::setw( 16 ) << getFileSize( binaryFilename )
+              << std::setw( 16 ) << "-" << std::endl;
+
+    const double positionTolerances[ ] = { 1.0e-3, 1.0e-6 };
+    double chebyshevSize = 0.0;
+    for ( unsigned int j = 0; j < 2; j++ )
+    {
+        std::size_t numberOfSegments = 0;
+        start = Clock::now( );
+        {
+            scarab::ChebyshevTrajectoryWriter writer( chebyshevFilename,
+                                                      positionTolerances[ j ],
+                                                      1.0e-3 * positionTolerances[ j ],
+                                                      12,
+                                                      1024 );
+            for ( std::size_t i = 0; i < numberOfSamples; i++ )
+            {
+                writer.write( i * sampleInterval, getEccentricOrbitState( i * sampleInterval ) );
+            }
+            writer.close( scarab::TrajectoryMetadata( ) );
+            numberOfSegments = writer.getNumberOfSegments( );
+        }
+        elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        chebyshevSize = getFileSize( chebyshevFilename );
+        std::cout << std::setw( 36 )
+                  << ( j == 0 ? "Chebyshev, tolerance 1 m" : "Chebyshev, tolerance 1 mm" )
+                  << std::setw( 16 ) << elapsedTime
+                  << std::setw( 16 ) << chebyshevSize
+                  << std::setw( 16 ) << numberOfSegments << std::endl;
+    }
+
+    // Evaluate Chebyshev trajectory with tolerance of 1 mm.
+    const scarab::ChebyshevTrajectory trajectory( chebyshevFilename );
+    const double duration = trajectory.getEndTime( ) - trajectory.getStartTime( );
+    const std::size_t numberOfEvaluations = 1000000;
+    std::vector< double > randomTimes( numberOfEvaluations );
+    std::vector< double > consecutiveTimes( numberOfEvaluations );
+    unsigned long long seed = 42;
+    for ( std::size_t i = 0; i < numberOfEvaluations; i++ )
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        randomTimes[ i ]
+            = trajectory.getStartTime( ) + ( seed >> 11 ) * ( duration / 9007199254740992.0 );
+        consecutiveTimes[ i ] = trajectory.getStartTime( ) + i * ( duration / numberOfEvaluations );
+    }
+
+    double checksum = 0.0;
+    std::cout << std::endl;
+    std::cout << std::setw( 36 ) << "Evaluation" << std::setw( 16 ) << "Time [ns]" << std::endl;
+    for ( unsigned int j = 0; j < 2; j++ )
+    {
+        const std::vector< double >& times = j == 0 ? randomTimes : consecutiveTimes;
+        start = Clock::now( );
+        for ( std::size_t i = 0; i < times.size( ); i++ )
+        {
+            checksum += trajectory.getState( times[ i ] )[ 0 ];
+        }
+        elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        std::cout << std::setw( 36 )
+                  << ( j == 0 ? "State, random epochs" : "State, consecutive epochs" )
+                  << std::setw( 16 ) << elapsedTime / times.size( ) * 1.0e9 << std::endl;
+    }
+
+    double maximumPositionError = 0.0;
+    for ( std::size_t i = 0; i < randomTimes.size( ); i += 100 )
+    {
+        const scarab::State state = trajectory.getState( randomTimes[ i ] );
+        const scarab::State expectedState = getEccentricOrbitState( randomTimes[ i ] );
+        double positionErrorSquared = 0.0;
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            positionErrorSquared += ( state[ j ] - expectedState[ j ] )
+                                    * ( state[ j ] - expectedState[ j ] );
+        }
+        maximumPositionError = std::max( maximumPositionError, std::sqrt( positionErrorSquared ) );
+    }
+
+    std::cout << std::endl;
+    std::cout << "Compression ratio over CSV:         " << csvSize / chebyshevSize << std::endl;
+    std::cout << "Maximum position error [km]:        " << maximumPositionError << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    std::remove( csvFilename.c_str( ) );
+    std::remove( binaryFilename.c_str( ) );
+    std::remove( chebyshevFilename.c_str( ) );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/tools.hpp"
+#include "Scarab/typedefs.hpp"
+
+//! Get sample of synthetic circular orbit at given row.
+void getSample( const std::size_t row, double& time, scarab::State& state )
+{
+    time = 0.37 * row;
+    const double angle = 1.1e-3 * time;
+    state[ 0 ] = 7000.0 * std::cos( angle );
+    state[ 1 ] = 7000.0 * std::sin( angle );
+    state[ 2 ] = 12.5 * std::sin( 3.0 * angle );
+    state[ 3 ] = -7.5 * std::sin( angle );
+    state[ 4 ] = 7.5 * std::cos( angle );
+    state[ 5 ] = 1.0e-3 * std::cos( 3.0 * angle );
+}
+
+//! Get size of file [MB].
+double getFileSize( const std::string& filename )
+{
+    std::ifstream file( filename.c_str( ), std::ios::binary | std::ios::ate );
+    return file.tellg( ) / 1.0e6;
+}
+
+//! Benchmark CSV output of state history.
+/*!
+ * Writes a synthetic state history of N rows (N = first argument, default = 10000000) to a CSV
+ * file (second argument, default = benchmarkCsvWriter.csv), using:
+ *  - iostreams with std::endl per row, as print() used to do,
+ *  - print(), in blocks of 100000 rows, and
+ *  - StreamingStateHistoryWriter with shortest round-trip formatting.
+ * Throughput is reported as rows written per second. The file is removed afterwards.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::size_t numberOfRows
+        = numberOfInputs > 1 ? std::strtoul( inputArguments[ 1 ], 0, 10 ) : 10000000;
+    const std::string filename
+        = numberOfInputs > 2 ? inputArguments[ 2 ] : "benchmarkCsvWriter.csv";
+    const std::string header = "t,x,y,z,vx,vy,vz";
+    const std::size_t blockSize = 100000;
+
+    double time = 0.0;
+    scarab::State state;
+
+    std::cout << "Number of rows: " << numberOfRows << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 40 ) << "Variant"
+              << std::setw( 16 ) << "Time [s]"
+              << std::setw( 16 ) << "Size [MB]"
+              << std::setw( 20 ) << "Rows per second" << std::endl;
+
+    // iostreams with std::endl per row.
+    Clock::time_point start = Clock::now( );
+    {
+        std::ofstream file( filename.c_str( ) );
+        file << header << std::endl;
+        file << std::setprecision( std::numeric_limits< double >::digits10 );
+        for ( std::size_t row = 0; row < numberOfRows; row++ )
+        {
+            getSample( row, time, state );
+            file << time << ",";
+            for ( unsigned int i = 0; i < state.size( ) - 1; i++ )
+            {
+                file << state[ i ] << ",";
+            }
+            file << state[ state.size( ) - 1 ] << std::endl;
+        }
+    }
+    const double endlTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 40 ) << "iostreams, std::endl per row"
+              << std::setw( 16 ) << endlTime
+              << std::setw( 16 ) << getFileSize( filename )
+              << std::setw( 20 ) << numberOfRows / endlTime << std::endl;
+
+    // print(), in blocks.
+    start = Clock::now( );
+    {
+        std::ofstream file( filename.c_str( ) );
+        for ( std::size_t firstRow = 0; firstRow < numberOfRows; firstRow += blockSize )
+        {
+            scarab::StateHistory stateHistory( blockSize );
+            for ( std::size_t row = firstRow;
+                  row < firstRow + blockSize && row < numberOfRows;
+                  row++ )
+            {
+                getSample( row, time, state );
+                stateHistory.append( time, state );
+            }
+            scarab::print( file, stateHistory, firstRow == 0 ? header : "" );
+        }
+    }
+    const double printTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 40 ) << "print( ), blocks of 100000 rows"
+              << std::setw( 16 ) << printTime
+              << std::setw( 16 ) << getFileSize( filename )
+              << std::setw( 20 ) << numberOfRows / printTime << std::endl;
+
+    // Streaming writer.
+    start = Clock::now( );
+    {
+        std::ofstream file( filename.c_str( ) );
+        scarab::StreamingStateHistoryWriter writer( file, 4096, header );
+        for ( std::size_t row = 0; row < numberOfRows; row++ )
+        {
+            getSample( row, time, state );
+            writer.write( time, state );
+        }
+    }
+    const double writerTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 40 ) << "StreamingStateHistoryWriter"
+              << std::setw( 16 ) << writerTime
+              << std::setw( 16 ) << getFileSize( filename )
+              << std::setw( 20 ) << numberOfRows / writerTime << std::endl;
+
+    // Time to generate samples, which is included in all variants above.
+    start = Clock::now( );
+    double checksum = 0.0;
+    for ( std::size_t row = 0; row < numberOfRows; row++ )
+    {
+        getSample( row, time, state );
+        checksum += state[ 0 ];
+    }
+    const double sampleTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+
+    std::cout << std::endl;
+    std::cout << "Time to generate samples [s]:           " << sampleTime << std::endl;
+    std::cout << "Speed-up over std::endl per row:        " << endlTime / writerTime << std::endl;
+    std::cout << "Speed-up over print( ):                 " << printTime / writerTime << std::endl;
+    std::cout << "Checksum:                               " << checksum << std::endl;
+
+    std::remove( filename.c_str( ) );
+
+    return EXIT_SUCCESS;
+}
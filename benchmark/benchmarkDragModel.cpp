@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/dragModel.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+//! Evaluate state derivative model along sample states and return time per call [ns].
+double evaluateStateDerivativeModel( const scarab::StateDerivativeModel& model,
+                                     const std::vector< scarab::State >& states,
+                                     const unsigned int numberOfRepetitions,
+                                     double& checksum )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    scarab::State stateDerivative;
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        for ( unsigned int j = 0; j < states.size( ); j++ )
+        {
+            model( states[ j ], stateDerivative, 0.0 );
+            checksum += stateDerivative[ 3 ] + stateDerivative[ 4 ] + stateDerivative[ 5 ];
+        }
+    }
+    const double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    return elapsedTime / ( static_cast< double >( numberOfRepetitions ) * states.size( ) ) * 1.0e9;
+}
+
+//! Evaluate density function at sample altitudes and return time per call [ns].
+template < typename DensityFunction >
+double evaluateDensity( const DensityFunction& densityFunction,
+                        const std::vector< double >& altitudes,
+                        const unsigned int numberOfRepetitions,
+                        double& checksum )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        for ( unsigned int j = 0; j < altitudes.size( ); j++ )
+        {
+            checksum += densityFunction( altitudes[ j ] );
+        }
+    }
+    const double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    return elapsedTime / ( static_cast< double >( numberOfRepetitions ) * altitudes.size( ) )
+           * 1.0e9;
+}
+
+//! Benchmark cost of state derivative with drag on and off.
+/*!
+ * Evaluates the state derivative at 1000 states along a low Earth orbit between 300 and 500 km
+ * altitude M times (M = first argument, default = 10000), once with central gravity only and
+ * once with central gravity and drag, and reports the time per call. The density lookup in
+ * altitude buckets is compared with the lookup in the atmosphere table, i.e., a binary search
+ * over the layers and an exponential function.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    const unsigned int numberOfRepetitions
+        = numberOfInputs > 1 ? std::atoi( inputArguments[ 1 ] ) : 10000;
+    const double gravitationalParameter = 398600.4418;
+    const double earthRadius = 6378.1363;
+
+    // States on an eccentric orbit between 300 and 500 km altitude, in the xy-plane.
+    std::vector< scarab::State > states( 1000 );
+    std::vector< double > altitudes( states.size( ) );
+    for ( unsigned int i = 0; i < states.size( ); i++ )
+    {
+        const double angle = 2.0 * 3.14159265358979323846 * i / states.size( );
+        const double radius = earthRadius + 400.0 + 100.0 * std::cos( angle );
+        states[ i ][ 0 ] = radius * std::cos( angle );
+        states[ i ][ 1 ] = radius * std::sin( angle );
+        states[ i ][ 2 ] = 0.0;
+        states[ i ][ 3 ] = -7.7 * std::sin( angle );
+        states[ i ][ 4 ] = 7.7 * std::cos( angle );
+        states[ i ][ 5 ] = 0.0;
+        altitudes[ i ] = radius - earthRadius;
+    }
+
+    const scarab::AtmosphereTable atmosphereTable = scarab::getExponentialAtmosphereTable( );
+    const scarab::DragModelPtr dragModel = boost::make_shared< scarab::DragModel >(
+        2.2, 10.0, 1000.0, atmosphereTable, earthRadius, 7.292115e-5 );
+
+    scarab::ListOfAccelerationModels listOfAccelerationModels;
+    scarab::DataStore gravityData(
+        states[ 0 ], 0.0, gravitationalParameter, listOfAccelerationModels );
+    gravityData.listOfAccelerationModels[ scarab::centralGravityModelId ]
+        = boost::make_shared< scarab::CentralGravityModel >( gravityData.gravitationalParameter );
+    const scarab::StateDerivativeModel gravityModel( gravityData );
+
+    scarab::DataStore dragData(
+        states[ 0 ], 0.0, gravitationalParameter, listOfAccelerationModels );
+    dragData.listOfAccelerationModels[ scarab::centralGravityModelId ]
+        = boost::make_shared< scarab::CentralGravityModel >( dragData.gravitationalParameter );
+    dragData.listOfAccelerationModels[ scarab::dragModelId ] = dragModel;
+    const scarab::StateDerivativeModel gravityAndDragModel( dragData );
+
+    std::cout << "Number of repetitions: " << numberOfRepetitions << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Variant"
+              << std::setw( 16 ) << "Time [ns]" << std::endl;
+
+    double checksum = 0.0;
+
+    const double gravityTime
+        = evaluateStateDerivativeModel( gravityModel, states, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "State derivative, drag off"
+              << std::setw( 16 ) << gravityTime << std::endl;
+
+    const double gravityAndDragTime = evaluateStateDerivativeModel(
+        gravityAndDragModel, states, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "State derivative, drag on"
+              << std::setw( 16 ) << gravityAndDragTime << std::endl;
+
+    std::cout << std::setw( 36 ) << "Density, altitude buckets"
+              << std::setw( 16 )
+              << evaluateDensity( [ &dragModel ]( const double altitude )
+                                  {
+                                      return dragModel->computeDensity( altitude );
+                                  },
+                                  altitudes, numberOfRepetitions, checksum )
+              << std::endl;
+
+    std::cout << std::setw( 36 ) << "Density, table search and exp"
+              << std::setw( 16 )
+              << evaluateDensity( [ &atmosphereTable ]( const double altitude )
+                                  {
+                                      return scarab::computeAtmosphereDensity( atmosphereTable,
+                                                                               altitude );
+                                  },
+                                  altitudes, numberOfRepetitions, checksum )
+              << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Cost of drag per call [ns]:         " << gravityAndDragTime - gravityTime
+              << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/thirdBodyGravityModel.hpp"
+
+//! Evaluate ephemeris at sample times and return time per call [ns].
+double evaluateEphemeris( const scarab::ChebyshevEphemeris& ephemeris,
+                          const std::vector< double >& times,
+                          const unsigned int numberOfRepetitions,
+                          double& checksum )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        for ( unsigned int j = 0; j < times.size( ); j++ )
+        {
+            checksum += ephemeris.getPosition( 0, times[ j ] )[ 0 ];
+        }
+    }
+    const double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    return elapsedTime / ( static_cast< double >( numberOfRepetitions ) * times.size( ) ) * 1.0e9;
+}
+
+//! Benchmark cost of ephemeris lookup and third-body gravity.
+/*!
+ * Evaluates a synthetic ephemeris of 1000 segments with 14 coefficients per component at 1000
+ * times M times (M = first argument, default = 10000), once with consecutive times within the
+ * same segment, as during integration, where the cached segment is reused, and once with every
+ * time in a different segment, where the segment is looked up on every call. The cost of the
+ * third-body gravity model for two bodies is reported as well.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    const unsigned int numberOfRepetitions
+        = numberOfInputs > 1 ? std::atoi( inputArguments[ 1 ] ) : 10000;
+    const std::string filename = "benchmarkEphemeris.bin";
+
+    const std::size_t numberOfSegments = 1000;
+    const std::size_t numberOfCoefficients = 14;
+    const double segmentDuration = 86400.0;
+    std::vector< double > coefficients( numberOfSegments * 3 * numberOfCoefficients );
+    for ( std::size_t i = 0; i < coefficients.size( ); i++ )
+    {
+        coefficients[ i ] = 384400.0 / ( 1.0 + i % numberOfCoefficients );
+    }
+
+    std::vector< scarab::EphemerisBody > bodies;
+    bodies.push_back( scarab::EphemerisBody( "moon", 4902.800066, 0.0, segmentDuration,
+                                             numberOfSegments, numberOfCoefficients,
+                                             &coefficients[ 0 ] ) );
+    bodies.push_back( scarab::EphemerisBody( "sun", 1.32712440018e11, 0.0, segmentDuration,
+                                             numberOfSegments, numberOfCoefficients,
+                                             &coefficients[ 0 ] ) );
+    scarab::writeChebyshevEphemeris( filename, bodies );
+    const scarab::ChebyshevEphemerisPtr ephemeris
+        = boost::make_shared< scarab::ChebyshevEphemeris >( filename );
+
+    std::vector< double > sameSegmentTimes( 1000 );
+    std::vector< double > differentSegmentTimes( sameSegmentTimes.size( ) );
+    for ( unsigned int i = 0; i < sameSegmentTimes.size( ); i++ )
+    {
+        sameSegmentTimes[ i ] = 10.0 * i;
+        differentSegmentTimes[ i ] = ( ( 7 * i ) % numberOfSegments + 0.5 ) * segmentDuration;
+    }
+
+    std::vector< std::size_t > bodyIndices;
+    bodyIndices.push_back( 0 );
+    bodyIndices.push_back( 1 );
+    const scarab::ThirdBodyGravityModel thirdBodyModel( ephemeris, bodyIndices );
+    scarab::State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 7000.0;
+
+    std::cout << "Number of repetitions: " << numberOfRepetitions << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Variant"
+              << std::setw( 16 ) << "Time [ns]" << std::endl;
+
+    double checksum = 0.0;
+
+    std::cout << std::setw( 36 ) << "Position, cached segment"
+              << std::setw( 16 )
+              << evaluateEphemeris( *ephemeris, sameSegmentTimes, numberOfRepetitions, checksum )
+              << std::endl;
+
+    std::cout << std::setw( 36 ) << "Position, segment lookup"
+              << std::setw( 16 )
+              << evaluateEphemeris(
+                     *ephemeris, differentSegmentTimes, numberOfRepetitions, checksum )
+              << std::endl;
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        for ( unsigned int j = 0; j < sameSegmentTimes.size( ); j++ )
+        {
+            checksum += thirdBodyModel( state, sameSegmentTimes[ j ] )[ 0 ];
+        }
+    }
+    const double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 36 ) << "Third-body gravity, Sun and Moon"
+              << std::setw( 16 )
+              << elapsedTime / ( static_cast< double >( numberOfRepetitions )
+                                 * sameSegmentTimes.size( ) ) * 1.0e9
+              << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    std::remove( filename.c_str( ) );
+
+    return EXIT_SUCCESS;
+}
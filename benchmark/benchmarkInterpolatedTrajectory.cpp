@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "Scarab/interpolatedTrajectory.hpp"
+#include "Scarab/typedefs.hpp"
+
+//! State history stored in a map (key=epoch, value=State).
+typedef std::map< double, scarab::State > StateHistoryMap;
+
+//! Interpolate state from state history, looking up the interval in the map.
+scarab::State interpolateStateHistory( const StateHistoryMap& stateHistory, const double time )
+{
+    StateHistoryMap::const_iterator end = stateHistory.upper_bound( time );
+    if ( end == stateHistory.end( ) )
+    {
+        end--;
+    }
+    StateHistoryMap::const_iterator start = end;
+    start--;
+
+    const double stepSize = end->first - start->first;
+    const double s = ( time - start->first ) / stepSize;
+    const double h00 = 2.0 * s * s * s - 3.0 * s * s + 1.0;
+    const double h10 = ( s * s * s - 2.0 * s * s + s ) * stepSize;
+    const double h01 = -2.0 * s * s * s + 3.0 * s * s;
+    const double h11 = ( s * s * s - s * s ) * stepSize;
+
+    scarab::State state;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        state[ i ] = h00 * start->second[ i ] + h10 * start->second[ i + 3 ]
+                     + h01 * end->second[ i ] + h11 * end->second[ i + 3 ];
+        state[ i + 3 ] = 0.0;
+    }
+    return state;
+}
+
+//! Benchmark queries of interpolated trajectory.
+/*!
+ * Builds an interpolated trajectory from a state history of N samples of a circular orbit at
+ * irregular epochs (N = first argument, default = 100000), and evaluates the state at 1000000
+ * random and 1000000 monotone epochs, using:
+ *  - std::map::upper_bound on the state history, followed by Hermite interpolation of the
+ *    position (baseline),
+ *  - InterpolatedTrajectory::getState( ), with bucket lookup, and
+ *  - TrajectoryCursor::getState( ), for the monotone epochs.
+ * The time per query is reported.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::size_t numberOfSamples
+        = numberOfInputs > 1 ? std::strtoul( inputArguments[ 1 ], 0, 10 ) : 100000;
+    const std::size_t numberOfQueries = 1000000;
+
+    StateHistoryMap stateHistoryMap;
+    scarab::StateHistory stateHistory( numberOfSamples );
+    double time = 0.0;
+    for ( std::size_t i = 0; i < numberOfSamples; i++ )
+    {
+        const double angle = 1.1e-3 * time;
+        scarab::State state;
+        state[ 0 ] = 7000.0 * std::cos( angle );
+        state[ 1 ] = 7000.0 * std::sin( angle );
+        state[ 2 ] = 0.0;
+        state[ 3 ] = -7.7 * std::sin( angle );
+        state[ 4 ] = 7.7 * std::cos( angle );
+        state[ 5 ] = 0.0;
+        stateHistoryMap[ time ] = state;
+        stateHistory.append( time, state );
+        time += 20.0 + 15.0 * std::sin( 0.37 * i );
+    }
+
+    Clock::time_point start = Clock::now( );
+    const scarab::InterpolatedTrajectory trajectory( stateHistory );
+    const double constructionTime
+        = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+
+    const double duration = trajectory.getEndTime( ) - trajectory.getStartTime( );
+    std::vector< double > randomTimes( numberOfQueries );
+    std::vector< double > monotoneTimes( numberOfQueries );
+    unsigned long long seed = 42;
+    for ( std::size_t i = 0; i < numberOfQueries; i++ )
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        randomTimes[ i ]
+            = trajectory.getStartTime( ) + ( seed >> 11 ) * ( duration / 9007199254740992.0 );
+        monotoneTimes[ i ] = trajectory.getStartTime( ) + i * ( duration / numberOfQueries );
+    }
+
+    std::cout << "Number of samples: " << numberOfSamples << std::endl;
+    std::cout << "Construction time [ms]: " << constructionTime * 1.0e3 << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 40 ) << "Variant"
+              << std::setw( 16 ) << "Random [ns]"
+              << std::setw( 16 ) << "Monotone [ns]" << std::endl;
+
+    double checksum = 0.0;
+    double elapsedTime[ 2 ];
+    for ( unsigned int j = 0; j < 2; j++ )
+    {
+        const std::vector< double >& times = j == 0 ? randomTimes : monotoneTimes;
+        start = Clock::now( );
+        for ( std::size_t i = 0; i < times.size( ); i++ )
+        {
+            checksum += interpolateStateHistory( stateHistoryMap, times[ i ] )[ 0 ];
+        }
+        elapsedTime[ j ] = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    }
+    std::cout << std::setw( 40 ) << "std::map::upper_bound"
+              << std::setw( 16 ) << elapsedTime[ 0 ] / numberOfQueries * 1.0e9
+              << std::setw( 16 ) << elapsedTime[ 1 ] / numberOfQueries * 1.0e9 << std::endl;
+
+    for ( unsigned int j = 0; j < 2; j++ )
+    {
+        const std::vector< double >& times = j == 0 ? randomTimes : monotoneTimes;
+        start = Clock::now( );
+        for ( std::size_t i = 0; i < times.size( ); i++ )
+        {
+            checksum += trajectory.getState( times[ i ] )[ 0 ];
+        }
+        elapsedTime[ j ] = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    }
+    std::cout << std::setw( 40 ) << "InterpolatedTrajectory"
+              << std::setw( 16 ) << elapsedTime[ 0 ] / numberOfQueries * 1.0e9
+              << std::setw( 16 ) << elapsedTime[ 1 ] / numberOfQueries * 1.0e9 << std::endl;
+
+    start = Clock::now( );
+    scarab::TrajectoryCursor cursor( trajectory );
+    for ( std::size_t i = 0; i < monotoneTimes.size( ); i++ )
+    {
+        checksum += cursor.getState( monotoneTimes[ i ] )[ 0 ];
+    }
+    elapsedTime[ 1 ] = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    std::cout << std::setw( 40 ) << "TrajectoryCursor"
+              << std::setw( 16 ) << "-"
+              << std::setw( 16 ) << elapsedTime[ 1 ] / numberOfQueries * 1.0e9 << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Checksum:                               " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
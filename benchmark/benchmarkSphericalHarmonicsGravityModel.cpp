@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/interpolatedAccelerationModel.hpp"
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
+#include "Scarab/typedefs.hpp"
+
+//! Create coefficients of given degree and order with synthetic values following Kaula's rule.
+scarab::SphericalHarmonicsCoefficients createCoefficients( const unsigned int degree )
+{
+    scarab::SphericalHarmonicsCoefficients coefficients( degree, degree );
+    std::mt19937 generator( 42 );
+    std::normal_distribution< double > distribution( 0.0, 1.0 );
+    for ( unsigned int n = 2; n <= degree; n++ )
+    {
+        const double kaula = 1.0e-5 / ( n * n );
+        for ( unsigned int m = 0; m <= n; m++ )
+        {
+            const std::size_t index = scarab::SphericalHarmonicsCoefficients::getIndex( n, m );
+            coefficients.cosineCoefficients[ index ] = kaula * distribution( generator );
+            coefficients.sineCoefficients[ index ]
+                = m == 0 ? 0.0 : kaula * distribution( generator );
+        }
+    }
+    return coefficients;
+}
+
+//! Evaluate model at sample positions and return elapsed wall-clock time per call [ns].
+template < typename Model >
+double evaluateModel( const Model& model,
+                      const std::vector< scarab::State >& states,
+                      const unsigned int numberOfRepetitions,
+                      double& checksum )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        for ( unsigned int j = 0; j < states.size( ); j++ )
+        {
+            const scarab::Acceleration acceleration = model( states[ j ], 0.0 );
+            checksum += acceleration[ 0 ] + acceleration[ 1 ] + acceleration[ 2 ];
+        }
+    }
+    const double elapsedTime = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    return elapsedTime / ( static_cast< double >( numberOfRepetitions ) * states.size( ) ) * 1.0e9;
+}
+
+//! Benchmark evaluation of spherical harmonics gravity model.
+/*!
+ * Evaluates the spherical harmonics gravity model of degree and order N = 2, 8, 20 and 70 at
+ * 1000 positions on a low Earth orbit shell, M times (M = first argument, default = 1000), and
+ * reports the time per call, with the central gravity model as baseline. For N = 70, the model is
+ * also evaluated at 1000 positions in a small proximity region, directly and interpolated.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    const unsigned int numberOfRepetitions
+        = numberOfInputs > 1 ? std::atoi( inputArguments[ 1 ] ) : 1000;
+    const double gravitationalParameter = 398600.4418;
+    const double referenceRadius = 6378.1363;
+
+    std::vector< scarab::State > states( 1000 );
+    std::mt19937 generator( 7 );
+    std::uniform_real_distribution< double > distribution( -1.0, 1.0 );
+    for ( unsigned int i = 0; i < states.size( ); i++ )
+    {
+        double norm = 0.0;
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            states[ i ][ j ] = distribution( generator );
+            norm += states[ i ][ j ] * states[ i ][ j ];
+        }
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            states[ i ][ j ] *= 7000.0 / std::sqrt( norm );
+            states[ i ][ j + 3 ] = 0.0;
+        }
+    }
+
+    std::cout << "Number of repetitions: " << numberOfRepetitions << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Model"
+              << std::setw( 16 ) << "Time [ns]" << std::endl;
+
+    double checksum = 0.0;
+
+    const scarab::CentralGravityModel centralGravityModel( gravitationalParameter );
+    std::cout << std::setw( 36 ) << "Central gravity"
+              << std::setw( 16 )
+              << evaluateModel( centralGravityModel, states, numberOfRepetitions, checksum )
+              << std::endl;
+
+    const unsigned int degrees[ ] = { 2, 8, 20, 70 };
+    for ( unsigned int i = 0; i < sizeof( degrees ) / sizeof( degrees[ 0 ] ); i++ )
+    {
+        const scarab::SphericalHarmonicsGravityModel model(
+            gravitationalParameter, referenceRadius, createCoefficients( degrees[ i ] ) );
+        std::cout << std::setw( 36 ) << "Spherical harmonics, N = " + std::to_string( degrees[ i ] )
+                  << std::setw( 16 )
+                  << evaluateModel( model, states, numberOfRepetitions, checksum )
+                  << std::endl;
+    }
+
+    // Evaluate the model of degree 70 in a proximity region of 2 km x 2 km x 2 km, directly and
+    // from an interpolation grid with cells of 0.5 km, which is built during the first repetition.
+    std::vector< scarab::State > proximityStates( 1000 );
+    for ( unsigned int i = 0; i < proximityStates.size( ); i++ )
+    {
+        proximityStates[ i ] = states[ 0 ];
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            proximityStates[ i ][ j ] += distribution( generator );
+        }
+    }
+
+    const scarab::AccelerationModel3dPtr sphericalHarmonicsModel
+        = boost::make_shared< scarab::SphericalHarmonicsGravityModel >(
+            gravitationalParameter, referenceRadius, createCoefficients( 70 ) );
+    std::cout << std::setw( 36 ) << "Proximity, N = 70"
+              << std::setw( 16 )
+              << evaluateModel(
+                     *sphericalHarmonicsModel, proximityStates, numberOfRepetitions, checksum )
+              << std::endl;
+
+    const scarab::InterpolatedAccelerationModel interpolatedModel(
+        sphericalHarmonicsModel, 0.5, 1.0e-14, 10000 );
+    std::cout << std::setw( 36 ) << "Proximity, N = 70, interpolated"
+              << std::setw( 16 )
+              << evaluateModel( interpolatedModel, proximityStates, numberOfRepetitions, checksum )
+              << std::endl;
+    const scarab::InterpolationStatistics statistics = interpolatedModel.getStatistics( );
+    std::cout << std::setw( 36 ) << "  hits / misses / rejected cells"
+              << statistics.numberOfHits << " / " << statistics.numberOfMisses << " / "
+              << statistics.numberOfRejectedCells << std::endl;
+    std::cout << std::setw( 36 ) << "  maximum error estimate [km s^-2]"
+              << statistics.maximumErrorEstimate << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <boost/make_shared.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/composedStateDerivativeModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/integratorTemplate.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+//! Propagate state and return elapsed wall-clock time [s].
+template < typename Model >
+double propagate( const scarab::IntegratorSettings& settings,
+                  const Model& model,
+                  const unsigned int numberOfRepetitions,
+                  double& checksum )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::time_point start = Clock::now( );
+    for ( unsigned int i = 0; i < numberOfRepetitions; i++ )
+    {
+        scarab::State state = settings.initialState;
+        scarab::integrateState( settings, model, state );
+        checksum += state[ 0 ];
+    }
+    return std::chrono::duration< double >( Clock::now( ) - start ).count( );
+}
+
+//! Benchmark compile-time composed against runtime-polymorphic state derivative model.
+/*!
+ * Propagates a low Earth orbit over one orbital period N times (N = first argument, default =
+ * 200), once with the runtime-polymorphic StateDerivativeModel and once with the compile-time
+ * ComposedStateDerivativeModel, using the same central gravity model, for a fixed-step and an
+ * adaptive integrator. Both models are integrated with integrateState( ), which calls the composed
+ * model through its static type.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    const unsigned int numberOfRepetitions
+        = numberOfInputs > 1 ? std::atoi( inputArguments[ 1 ] ) : 200;
+    const double gravitationalParameter = 398600.4418;
+
+    scarab::State initialState;
+    initialState[ 0 ] = 7000.0;
+    initialState[ 1 ] = 0.0;
+    initialState[ 2 ] = 0.0;
+    initialState[ 3 ] = 0.0;
+    initialState[ 4 ] = 7.5;
+    initialState[ 5 ] = 1.0;
+
+    scarab::ListOfAccelerationModels listOfAccelerationModels;
+    scarab::DataStore data( initialState, 0.0, gravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ scarab::centralGravityModelId ]
+        = boost::make_shared< scarab::CentralGravityModel >( data.gravitationalParameter );
+    const scarab::StateDerivativeModel runtimeModel( data );
+
+    const scarab::CentralGravityModel centralGravityModel( data.gravitationalParameter );
+    const scarab::ComposedStateDerivativeModel< scarab::CentralGravityModel >
+        composedModel( centralGravityModel );
+
+    const scarab::IntegratorSettings fixedStepSettings(
+        initialState, 0.0, 6000.0, 1.0, scarab::rungeKutta4Integrator, 1.0e-12, 1.0e-12, 1.0 );
+    const scarab::IntegratorSettings adaptiveSettings(
+        initialState, 0.0, 6000.0, 1.0, scarab::dormandPrince5Integrator, 1.0e-12, 1.0e-12,
+        6000.0 );
+
+    std::cout << "Number of repetitions: " << numberOfRepetitions << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 36 ) << "Variant"
+              << std::setw( 16 ) << "Time [s]" << std::endl;
+
+    double checksum = 0.0;
+
+    const double fixedStepRuntimeTime
+        = propagate( fixedStepSettings, runtimeModel, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "RK4, runtime-polymorphic"
+              << std::setw( 16 ) << fixedStepRuntimeTime << std::endl;
+
+    const double fixedStepComposedTime
+        = propagate( fixedStepSettings, composedModel, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "RK4, compile-time composed"
+              << std::setw( 16 ) << fixedStepComposedTime << std::endl;
+
+    const double adaptiveRuntimeTime
+        = propagate( adaptiveSettings, runtimeModel, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "DOPRI5, runtime-polymorphic"
+              << std::setw( 16 ) << adaptiveRuntimeTime << std::endl;
+
+    const double adaptiveComposedTime
+        = propagate( adaptiveSettings, composedModel, numberOfRepetitions, checksum );
+    std::cout << std::setw( 36 ) << "DOPRI5, compile-time composed"
+              << std::setw( 16 ) << adaptiveComposedTime << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "Speed-up fixed step:                "
+              << fixedStepRuntimeTime / fixedStepComposedTime << std::endl;
+    std::cout << "Speed-up adaptive:                  "
+              << adaptiveRuntimeTime / adaptiveComposedTime << std::endl;
+    std::cout << "Checksum:                           " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "Scarab/stateHistory.hpp"
+#include "Scarab/typedefs.hpp"
+
+//! Number of bytes currently allocated through CountingAllocator.
+std::size_t numberOfAllocatedBytes = 0;
+
+//! Allocator that counts the number of bytes allocated.
+template< typename T >
+struct CountingAllocator : public std::allocator< T >
+{
+    template< typename U >
+    struct rebind
+    {
+        typedef CountingAllocator< U > other;
+    };
+
+    CountingAllocator( ) { }
+
+    template< typename U >
+    CountingAllocator( const CountingAllocator< U >& ) { }
+
+    T* allocate( const std::size_t n )
+    {
+        numberOfAllocatedBytes += n * sizeof( T );
+        return std::allocator< T >::allocate( n );
+    }
+
+    void deallocate( T* pointer, const std::size_t n )
+    {
+        numberOfAllocatedBytes -= n * sizeof( T );
+        std::allocator< T >::deallocate( pointer, n );
+    }
+};
+
+//! State history stored in a map (key=epoch, value=State), with counted allocations.
+typedef std::map< double, scarab::State, std::less< double >,
+                  CountingAllocator< std::pair< const double, scarab::State > > > StateHistoryMap;
+
+//! Get sample of synthetic circular orbit at given index.
+void getSample( const std::size_t index, double& time, scarab::State& state )
+{
+    time = 10.0 * index;
+    const double angle = 1.1e-3 * time;
+    state[ 0 ] = 7000.0 * std::cos( angle );
+    state[ 1 ] = 7000.0 * std::sin( angle );
+    state[ 2 ] = 0.0;
+    state[ 3 ] = -7.5 * std::sin( angle );
+    state[ 4 ] = 7.5 * std::cos( angle );
+    state[ 5 ] = 0.0;
+}
+
+//! Print result of benchmark variant.
+void printResult( const std::string& variant,
+                  const double time,
+                  const std::size_t numberOfSamples,
+                  const double bytesPerSample,
+                  const double checksum )
+{
+    std::cout << std::setw( 40 ) << variant
+              << std::setw( 20 ) << 1.0e9 * time / numberOfSamples
+              << std::setw( 20 ) << bytesPerSample
+              << std::setw( 20 ) << checksum << std::endl;
+}
+
+//! Benchmark recording of state history.
+/*!
+ * Records N samples of a circular orbit (N = first argument, default = 1000000) and sums the
+ * x-coordinate of all samples afterwards, using:
+ *  - std::map (baseline, as StateHistory used to be),
+ *  - StateHistory without reserved capacity, and
+ *  - StateHistory with capacity estimated from the end time and step size.
+ * The time per sample, for appending and summing, and the heap memory per sample are reported;
+ * the memory of the map is counted by its allocator, not including allocator overhead per node.
+ */
+int main( const int numberOfInputs, const char* inputArguments[ ] )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const std::size_t numberOfSamples
+        = numberOfInputs > 1 ? std::strtoul( inputArguments[ 1 ], 0, 10 ) : 1000000;
+
+    double time = 0.0;
+    scarab::State state;
+
+    std::cout << "Number of samples: " << numberOfSamples << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw( 40 ) << "Variant"
+              << std::setw( 20 ) << "Time [ns/sample]"
+              << std::setw( 20 ) << "Memory [B/sample]"
+              << std::setw( 20 ) << "Checksum" << std::endl;
+
+    // std::map.
+    {
+        Clock::time_point start = Clock::now( );
+        StateHistoryMap stateHistory;
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            getSample( i, time, state );
+            stateHistory[ time ] = state;
+        }
+        double checksum = 0.0;
+        for ( StateHistoryMap::const_iterator it = stateHistory.begin( );
+              it != stateHistory.end( );
+              it++ )
+        {
+            checksum += it->second[ 0 ];
+        }
+        const double elapsedTime
+            = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        printResult( "std::map", elapsedTime, numberOfSamples,
+                     static_cast< double >( numberOfAllocatedBytes ) / numberOfSamples, checksum );
+    }
+
+    // StateHistory, without reserved capacity.
+    {
+        Clock::time_point start = Clock::now( );
+        scarab::StateHistory stateHistory;
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            getSample( i, time, state );
+            stateHistory.append( time, state );
+        }
+        double checksum = 0.0;
+        const double* x = stateHistory.getComponent( 0 );
+        for ( std::size_t i = 0; i < stateHistory.size( ); i++ )
+        {
+            checksum += x[ i ];
+        }
+        const double elapsedTime
+            = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        printResult( "StateHistory", elapsedTime, numberOfSamples,
+                     7.0 * sizeof( double ) * stateHistory.capacity( ) / numberOfSamples,
+                     checksum );
+    }
+
+    // StateHistory, with estimated capacity.
+    {
+        Clock::time_point start = Clock::now( );
+        scarab::StateHistory stateHistory(
+            scarab::StateHistory::estimateCapacity( 0.0, 10.0 * ( numberOfSamples - 1 ), 10.0 ) );
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            getSample( i, time, state );
+            stateHistory.append( time, state );
+        }
+        double checksum = 0.0;
+        const double* x = stateHistory.getComponent( 0 );
+        for ( std::size_t i = 0; i < stateHistory.size( ); i++ )
+        {
+            checksum += x[ i ];
+        }
+        const double elapsedTime
+            = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        printResult( "StateHistory, estimated capacity", elapsedTime, numberOfSamples,
+                     7.0 * sizeof( double ) * stateHistory.capacity( ) / numberOfSamples,
+                     checksum );
+    }
+
+    // Time to generate samples, which is included in all variants above.
+    {
+        Clock::time_point start = Clock::now( );
+        double checksum = 0.0;
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            getSample( i, time, state );
+            checksum += state[ 0 ];
+        }
+        const double elapsedTime
+            = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+        printResult( "Sample generation only", elapsedTime, numberOfSamples, 0.0, checksum );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -32,13 +32,17 @@ public:
     /*!
      * Computes acceleration by overloading ()-operator.
      *
-     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     * This if a pure virtual function, hence it must be implemented by any derived classes. The
+     * operator is const, but that alone does not make it safe to evaluate a model from multiple
+     * threads at once, since models may keep mutable caches, work buffers or statistics; models
+     * that can be shared between threads say so. Ensembles and sweeps construct separate models
+     * for every member or run.
      *
      * @param[in] state Current state                                                     [km]
      * @param[in] time  Current time                                                      [s]
      * @return          Computed Acceleration                                             [km s^-2]
      */
-    virtual Acceleration operator( )( const State& state, const double time ) = 0;
+    virtual Acceleration operator( )( const State& state, const double time ) const = 0;
 
     //! Default destructor.
     /*!
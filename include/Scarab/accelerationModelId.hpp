@@ -19,12 +19,17 @@ namespace scarab
 
 //! Acceleration Model ID.
 /*!
- * Acceleration model identifier.
+ * Acceleration model identifier. The last identifier is not a model, but gives the number of
+ * acceleration models available.
  */
 enum AccelerationModelId
 {
     centralGravityModelId = 0,
-    radiationPressureModelId = 1
+    radiationPressureModelId = 1,
+    sphericalHarmonicsGravityModelId = 2,
+    dragModelId = 3,
+    thirdBodyGravityModelId = 4,
+    numberOfAccelerationModelIds
 };
 
 //! List of acceleration models.
@@ -12,19 +12,25 @@
 
 #include "Scarab/accelerationModelId.hpp"
 #include "Scarab/dataStore.hpp"
+#include "Scarab/simulatorSettings.hpp"
 
 namespace scarab
 {
 
 //! Generate list of acceleration models.
 /*!
- * Generates a list of acceleration models. The data to construct the acceleration models is
- * retrieved from the simulator data provided.
+ * Generates a list of acceleration models. The models generated are those listed in the simulator
+ * settings; they are created by the factories in the acceleration model registry. The data to
+ * construct the acceleration models is retrieved from the simulator settings and data provided.
  *
- * @param[in] data  Data store containing all simulation data, including populated list of
- *                  acceleration models
+ * An error is thrown if a model is unknown or listed more than once.
+ *
+ * @sa findAccelerationModel
+ * @param[in]     settings  Simulator settings
+ * @param[in,out] data      Data store containing all simulation data, including populated list of
+ *                          acceleration models
  */
-void generateAccelerationModelList( DataStore& data );
+void generateAccelerationModelList( const SimulatorSettings& settings, DataStore& data );
 
 } // namespace scarab
 
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_ACCELERATION_MODEL_REGISTRY_HPP
+#define SCARAB_ACCELERATION_MODEL_REGISTRY_HPP
+
+#include <string>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/simulatorSettings.hpp"
+
+namespace scarab
+{
+
+//! Acceleration model factory.
+/*!
+ * Function that creates an acceleration model, given the simulator settings and the data store
+ * of the simulation that the model is part of.
+ */
+typedef AccelerationModel3dPtr ( *AccelerationModelFactory )( const SimulatorSettings& settings,
+                                                              DataStore& data );
+
+//! Acceleration model registration.
+/*!
+ * Entry in the acceleration model registry, linking the name of a model used in the "models" list
+ * of the config file to its identifier and the factory that creates it.
+ */
+struct AccelerationModelRegistration
+{
+public:
+
+    //! Name of model in config file.
+    const char* name;
+
+    //! Acceleration model identifier.
+    AccelerationModelId id;
+
+    //! Factory that creates model.
+    AccelerationModelFactory factory;
+
+protected:
+
+private:
+};
+
+//! Find acceleration model registration.
+/*!
+ * Finds registration of acceleration model with given name. An error is thrown if no model with
+ * the given name is registered.
+ *
+ * @param[in] modelName Name of acceleration model, as used in "models" list of config file
+ * @return              Registration of acceleration model
+ */
+const AccelerationModelRegistration& findAccelerationModel( const std::string& modelName );
+
+//! Get acceleration model name.
+/*!
+ * Gets name of acceleration model with given identifier, as used in "models" list of config
+ * file. An error is thrown if no model with the given identifier is registered.
+ *
+ * @param[in] modelId Acceleration model identifier
+ * @return            Name of acceleration model
+ */
+std::string getAccelerationModelName( const AccelerationModelId modelId );
+
+} // namespace scarab
+
+#endif // SCARAB_ACCELERATION_MODEL_REGISTRY_HPP
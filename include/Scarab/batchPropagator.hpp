@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_BATCH_PROPAGATOR_HPP
+#define SCARAB_BATCH_PROPAGATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Batch of states.
+/*!
+ * Batch of states stored as structure-of-arrays: each of the six state components is stored in
+ * its own contiguous, 64-byte aligned array, with one entry per lane. The number of entries per
+ * array is padded to a multiple of 8, so that loops over lanes map onto full SIMD registers
+ * (AVX2/AVX-512) without remainder handling.
+ */
+class BatchState
+{
+public:
+
+    //! Number of state components.
+    static const std::size_t numberOfComponents = 6;
+
+    //! Construct batch of states.
+    /*!
+     * Constructs batch of states, with all components initialized to zero.
+     *
+     * @param[in] aNumberOfLanes Number of lanes, i.e., states in batch
+     */
+    explicit BatchState( const std::size_t aNumberOfLanes );
+
+    //! Copy constructor.
+    /*!
+     * Copies batch of states, re-aligning component arrays in the new buffer.
+     *
+     * @param[in] otherBatchState Batch of states to copy
+     */
+    BatchState( const BatchState& otherBatchState );
+
+    //! Assignment operator.
+    /*!
+     * Copies component arrays of batch of states with the same number of lanes.
+     *
+     * @param[in] otherBatchState Batch of states to copy
+     * @return                    Reference to this batch of states
+     */
+    BatchState& operator=( const BatchState& otherBatchState );
+
+    //! Get number of lanes.
+    /*!
+     * Returns number of lanes, i.e., states in batch.
+     *
+     * @return Number of lanes
+     */
+    std::size_t size( ) const { return numberOfLanes; }
+
+    //! Get padded number of lanes.
+    /*!
+     * Returns number of entries per component array, including padding.
+     *
+     * @return Padded number of lanes
+     */
+    std::size_t paddedSize( ) const { return stride; }
+
+    //! Get component array.
+    /*!
+     * Returns pointer to contiguous, aligned array containing given state component for all lanes.
+     *
+     * @param[in] component Index of state component (0 = x, ..., 5 = vz)
+     * @return              Pointer to component array
+     */
+    double* operator[ ]( const std::size_t component ) { return components + component * stride; }
+
+    //! Get component array.
+    /*!
+     * Returns pointer to contiguous, aligned array containing given state component for all lanes.
+     *
+     * @param[in] component Index of state component (0 = x, ..., 5 = vz)
+     * @return              Pointer to component array
+     */
+    const double* operator[ ]( const std::size_t component ) const
+    {
+        return components + component * stride;
+    }
+
+    //! Get state of lane.
+    /*!
+     * Gathers state of a single lane from component arrays.
+     *
+     * @param[in] lane Index of lane
+     * @return         State of lane
+     */
+    State getState( const std::size_t lane ) const;
+
+    //! Set state of lane.
+    /*!
+     * Scatters state of a single lane into component arrays.
+     *
+     * @param[in] lane  Index of lane
+     * @param[in] state State of lane
+     */
+    void setState( const std::size_t lane, const State& state );
+
+protected:
+
+private:
+
+    //! Set up aligned component arrays in buffer.
+    void align( );
+
+    //! Number of lanes.
+    std::size_t numberOfLanes;
+
+    //! Number of entries per component array, including padding.
+    std::size_t stride;
+
+    //! Buffer holding component arrays, over-allocated to allow for alignment.
+    std::vector< double > buffer;
+
+    //! Pointer to aligned start of component arrays in buffer.
+    double* components;
+};
+
+//! Batch acceleration model.
+/*!
+ * Acceleration model base class for batches of states. A batch model is called once per stage of
+ * the numerical integrator for all lanes, so the cost of the virtual call is amortized over the
+ * batch and the computation itself is a loop over contiguous component arrays.
+ */
+class BatchAccelerationModel
+{
+public:
+
+    //! Add acceleration to state derivatives.
+    /*!
+     * Computes acceleration for all lanes and adds it to the velocity derivative components (3-5)
+     * of the batch of state derivatives.
+     *
+     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     *
+     * @param[in]  state            Batch of current states                         [km; km s^-1]
+     * @param[in]  time             Current time per lane                           [s]
+     * @param[out] stateDerivative  Batch of state derivatives           [km s^-1; km s^-2]
+     */
+    virtual void operator( )( const BatchState& state,
+                              const double* time,
+                              BatchState& stateDerivative ) const = 0;
+
+    //! Default destructor.
+    /*!
+     * Calls default (virtual) destructor.
+     */
+    virtual ~BatchAccelerationModel( ) { }
+
+protected:
+
+private:
+};
+
+//! Pointer to batch acceleration model.
+typedef boost::shared_ptr< BatchAccelerationModel > BatchAccelerationModelPtr;
+
+//! List of batch acceleration models.
+typedef std::vector< BatchAccelerationModelPtr > ListOfBatchAccelerationModels;
+
+//! Central gravitational acceleration model for batches of states.
+class BatchCentralGravityModel : public BatchAccelerationModel
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs central gravity model for batches of states.
+     *
+     * @param[in] aGravitationalParameter Gravitational parameter of central body [km^3 s^-2]
+     */
+    BatchCentralGravityModel( const double aGravitationalParameter )
+        : gravitationalParameter( aGravitationalParameter )
+    { }
+
+    //! Add acceleration to state derivatives.
+    /*!
+     * Computes central gravitational acceleration for all lanes and adds it to the velocity
+     * derivative components of the batch of state derivatives.
+     *
+     * @param[in]  state            Batch of current states                         [km; km s^-1]
+     * @param[in]  time             Current time per lane (unused)                  [s]
+     * @param[out] stateDerivative  Batch of state derivatives           [km s^-1; km s^-2]
+     */
+    void operator( )( const BatchState& state,
+                      const double* time,
+                      BatchState& stateDerivative ) const;
+
+protected:
+
+private:
+
+    //! Gravitational parameter of central body [km^3 s^-2].
+    const double gravitationalParameter;
+};
+
+//! Batch propagation statistics.
+/*!
+ * Data struct containing statistics of a batch propagation.
+ */
+struct BatchPropagationStatistics
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all counters set to zero.
+     */
+    BatchPropagationStatistics( )
+        : numberOfBatchSteps( 0 ),
+          numberOfAcceptedSteps( 0 ),
+          numberOfRejectedSteps( 0 )
+    { }
+
+    //! Number of steps taken for the batch as a whole (all lanes in lockstep).
+    std::size_t numberOfBatchSteps;
+
+    //! Number of steps accepted, summed over lanes.
+    std::size_t numberOfAcceptedSteps;
+
+    //! Number of steps rejected, summed over lanes.
+    std::size_t numberOfRejectedSteps;
+
+protected:
+
+private:
+};
+
+//! Batch propagator.
+/*!
+ * Numerical integrator that propagates a batch of states in lockstep. All Runge-Kutta stages are
+ * evaluated across lanes, using the structure-of-arrays layout of BatchState, so that both the
+ * acceleration models and the stage arithmetic are executed as vectorized loops.
+ *
+ * Two variants are available: a fixed-step 4th-order Runge-Kutta method, and an adaptive
+ * Dormand-Prince 5(4) method in which every lane controls its own step size based on its own
+ * error estimate. In the adaptive variant, lanes accept or reject steps independently and lanes
+ * that have reached the end time are frozen, while the remaining lanes continue.
+ *
+ * Work buffers are allocated once on construction.
+ */
+class BatchPropagator
+{
+public:
+
+    //! Construct batch propagator.
+    /*!
+     * Constructs batch propagator for a given number of lanes.
+     *
+     * @param[in] aListOfAccelerationModels List of batch acceleration models
+     * @param[in] aNumberOfLanes            Number of lanes, i.e., states in batch
+     */
+    BatchPropagator( const ListOfBatchAccelerationModels& aListOfAccelerationModels,
+                     const std::size_t aNumberOfLanes );
+
+    //! Propagate batch with fixed step size.
+    /*!
+     * Propagates batch of states from start time to end time using 4th-order Runge-Kutta method
+     * with fixed step size. The last step is shortened to end exactly at the end time. An error is
+     * thrown if the step size is not positive or too small to advance the time, or if the end
+     * time is not after the start time.
+     *
+     * @param[in,out] state     Batch of states at start time; on return at end time
+     * @param[in]     startTime Start time                                      [s]
+     * @param[in]     endTime   End time                                        [s]
+     * @param[in]     stepSize  Step size                                       [s]
+     * @return                  Propagation statistics
+     */
+    BatchPropagationStatistics propagateFixedStep( BatchState& state,
+                                                   const double startTime,
+                                                   const double endTime,
+                                                   const double stepSize );
+
+    //! Propagate batch with adaptive step size.
+    /*!
+     * Propagates batch of states from start time to end time using Dormand-Prince 5(4) method with
+     * lane-wise step size control. An error is thrown if the initial step size or the absolute
+     * tolerance is not positive, if the relative tolerance is negative, if the end time is not
+     * after the start time, or if the step size of a lane becomes too small to advance its time.
+     *
+     * @param[in,out] state             Batch of states at start time; on return at end time
+     * @param[in]     startTime         Start time                              [s]
+     * @param[in]     endTime           End time                                [s]
+     * @param[in]     initialStepSize   Initial step size                       [s]
+     * @param[in]     absoluteTolerance Absolute error tolerance per step
+     * @param[in]     relativeTolerance Relative error tolerance per step
+     * @return                          Propagation statistics
+     */
+    BatchPropagationStatistics propagateAdaptive( BatchState& state,
+                                                  const double startTime,
+                                                  const double endTime,
+                                                  const double initialStepSize,
+                                                  const double absoluteTolerance,
+                                                  const double relativeTolerance );
+
+protected:
+
+private:
+
+    //! Compute state derivatives.
+    /*!
+     * Computes state derivatives for all lanes by summing the contributions of all batch
+     * acceleration models.
+     *
+     * @param[in]  state            Batch of states
+     * @param[in]  time             Time per lane                                   [s]
+     * @param[out] stateDerivative  Batch of state derivatives
+     */
+    void computeStateDerivative( const BatchState& state,
+                                 const double* time,
+                                 BatchState& stateDerivative ) const;
+
+    //! List of batch acceleration models.
+    const ListOfBatchAccelerationModels listOfAccelerationModels;
+
+    //! Number of lanes.
+    const std::size_t numberOfLanes;
+
+    //! Stage derivatives.
+    std::vector< BatchState > stages;
+
+    //! Intermediate stage state.
+    BatchState stageState;
+
+    //! Candidate state at end of step.
+    BatchState candidateState;
+
+    //! Current time per lane [s].
+    std::vector< double > laneTime;
+
+    //! Stage time per lane [s].
+    std::vector< double > stageTime;
+
+    //! Current step size per lane [s].
+    std::vector< double > laneStepSize;
+
+    //! Step size attempted per lane in current step [s].
+    std::vector< double > attemptedStepSize;
+
+    //! Normalized error estimate per lane.
+    std::vector< double > laneError;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_BATCH_PROPAGATOR_HPP
@@ -21,7 +21,7 @@ namespace scarab
 {
 
 //! Central gravitational acceleration model.
-class CentralGravityModel : public AccelerationModel< Acceleration >
+class CentralGravityModel final : public AccelerationModel< Acceleration >
 {
 public:
 
@@ -29,7 +29,7 @@ public:
         : gravitationalParameter( aGravitationalParameter )
     { }
 
-    Acceleration operator( )( const State& state, const double /* time */ )
+    Acceleration operator( )( const State& state, const double /* time */ ) const
     {
         Acceleration acceleration;
 
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_CHEBYSHEV_TRAJECTORY_HPP
+#define SCARAB_CHEBYSHEV_TRAJECTORY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Scarab/internalTools.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Version of Chebyshev trajectory file format.
+const unsigned int chebyshevTrajectoryFileVersion = 1;
+
+//! Maximum number of coefficients per component and segment of Chebyshev trajectory.
+const std::size_t maximumNumberOfChebyshevCoefficients = 32;
+
+//! Chebyshev trajectory writer.
+/*!
+ * State history sink that compresses the state history into piecewise Chebyshev polynomials of
+ * the position, and writes only the coefficients to a Chebyshev trajectory file. The velocity is
+ * the derivative of the position polynomials, so that position and velocity are consistent.
+ *
+ * The samples are split into contiguous segments; consecutive segments share the sample at their
+ * common boundary. The coefficients of a segment are fitted in a least-squares sense to both the
+ * positions and the velocities of its samples, and a segment is accepted if the errors at all
+ * samples are within the position and velocity tolerances set. If a segment has enough samples,
+ * every third interior sample is held out of the fit, so that the fit is also checked in between
+ * the samples it was fitted to; shorter segments are only checked at their samples, so the samples
+ * must be dense enough to resolve the trajectory. Segments are grown greedily while
+ * the samples are written: the fit is repeated every time the number of buffered samples has
+ * grown by a quarter, and the last fit within tolerance is written as soon as a longer fit fails
+ * or the maximum number of samples per segment is reached. Segments with fewer samples than
+ * needed for the full number of coefficients are fitted with fewer coefficients, down to cubic
+ * Hermite interpolation between two samples; if even that violates the tolerances, e.g., because
+ * fewer than four coefficients are set, an error is thrown.
+ *
+ * Samples must be written in ascending order of time. A sample with the same time as the previous
+ * sample, but a different state (e.g., an impulsive manoeuvre), closes the current segment, such
+ * that the discontinuity is preserved; the state at the boundary is then that of the later
+ * segment.
+ *
+ * The file format (version 1) is:
+ *
+ *  - bytes 0-7: magic string "SCARABCT";
+ *  - bytes 8-11: format version (uint32);
+ *  - bytes 12-15: length of header in bytes (uint32);
+ *  - bytes 16-23: number of segments (uint64);
+ *  - header: JSON object containing "number_of_coefficients", "position_tolerance",
+ *    "velocity_tolerance" and "metadata" (array of objects with "name", "value" and "units"),
+ *    padded with spaces such that the data starts at a multiple of 64 bytes;
+ *  - data: the segment boundaries (number of segments + 1 doubles), followed by the
+ *    coefficients of every segment, stored per segment as x, y and z coefficient blocks.
+ *
+ * All numbers are stored little-endian. Only the coefficients of completed segments are kept in
+ * memory, besides the samples of the segment that is being fitted.
+ *
+ * @sa ChebyshevTrajectory
+ */
+class ChebyshevTrajectoryWriter : public StateHistorySink
+{
+public:
+
+    //! Construct Chebyshev trajectory writer.
+    /*!
+     * Constructs Chebyshev trajectory writer.
+     *
+     * @param[in] aFilename                     Chebyshev trajectory filename
+     * @param[in] aPositionTolerance            Maximum position error at samples        [km]
+     * @param[in] aVelocityTolerance            Maximum velocity error at samples   [km s^-1]
+     * @param[in] aNumberOfCoefficients         Number of coefficients per component and segment
+     *                                          (2-maximumNumberOfChebyshevCoefficients)
+     * @param[in] aMaximumNumberOfSamples       Maximum number of samples per segment
+     */
+    ChebyshevTrajectoryWriter( const std::string& aFilename,
+                               const double aPositionTolerance,
+                               const double aVelocityTolerance,
+                               const std::size_t aNumberOfCoefficients,
+                               const std::size_t aMaximumNumberOfSamples );
+
+    //! Destruct Chebyshev trajectory writer.
+    /*!
+     * Closes writer with empty metadata, if close() has not been called, so that no samples are
+     * lost.
+     */
+    ~ChebyshevTrajectoryWriter( );
+
+    //! Write sample.
+    /*!
+     * Adds sample to the segment that is being fitted, and writes the segment if it cannot be
+     * extended any further.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void write( const double time, const State& state );
+
+    //! Flush sink.
+    /*!
+     * Fits all buffered samples, such that the last segment ends at the last sample written.
+     * Samples written afterwards start a new segment, so flushing during integration reduces the
+     * compression, but not the accuracy.
+     */
+    void flush( );
+
+    //! Close writer.
+    /*!
+     * Fits the remaining samples and writes Chebyshev trajectory file, consisting of the header
+     * with the given metadata, the segment boundaries and the coefficients. No samples can be
+     * written after the writer has been closed.
+     *
+     * @param[in] metadata Simulation metadata to store in header
+     */
+    void close( const TrajectoryMetadata& metadata );
+
+    //! Write checkpoint.
+    /*!
+     * Writes the completed segments and the samples of the segment that is being fitted to
+     * checkpoint. The writer is not flushed, since that would end the segment that is being
+     * fitted, so a resumed simulation yields the same segments as an uninterrupted simulation.
+     * The size of the checkpoint grows with the number of completed segments.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void writeCheckpoint( Checkpoint& checkpoint );
+
+    //! Restore checkpoint.
+    /*!
+     * Restores the completed segments and the samples of the segment that is being fitted from
+     * checkpoint.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void restoreCheckpoint( Checkpoint& checkpoint );
+
+    //! Get number of samples written.
+    /*!
+     * Returns number of samples accepted by the writer.
+     *
+     * @return Number of samples written
+     */
+    std::size_t getNumberOfSamples( ) const { return numberOfSamples; }
+
+    //! Get number of segments.
+    /*!
+     * Returns number of segments fitted so far.
+     *
+     * @return Number of segments
+     */
+    std::size_t getNumberOfSegments( ) const
+    {
+        return boundaries.empty( ) ? 0 : boundaries.size( ) - 1;
+    }
+
+    //! Get maximum position error.
+    /*!
+     * Returns maximum position error of the segments fitted so far, at the samples.
+     *
+     * @return Maximum position error                                             [km]
+     */
+    double getMaximumPositionError( ) const { return maximumPositionError; }
+
+    //! Get maximum velocity error.
+    /*!
+     * Returns maximum velocity error of the segments fitted so far, at the samples.
+     *
+     * @return Maximum velocity error                                             [km s^-1]
+     */
+    double getMaximumVelocityError( ) const { return maximumVelocityError; }
+
+protected:
+
+private:
+
+    //! Fit segment to buffered samples.
+    /*!
+     * Fits Chebyshev coefficients to the first samples in the buffer. If the remaining samples
+     * overdetermine the coefficients, every third interior sample is held out of the fit. The
+     * errors are computed at all samples, so that a fit that strays from the trajectory in
+     * between the fitted samples is rejected.
+     *
+     * @param[in]  numberOfSegmentSamples   Number of samples in segment, at least two
+     * @param[out] segmentCoefficients      Coefficients of segment, as x, y and z blocks
+     * @param[out] positionError            Maximum position error at samples     [km]
+     * @param[out] velocityError            Maximum velocity error at samples     [km s^-1]
+     * @return                              True if errors are within tolerances
+     */
+    bool fitSegment( const std::size_t numberOfSegmentSamples,
+                     std::vector< double >& segmentCoefficients,
+                     double& positionError,
+                     double& velocityError ) const;
+
+    //! Try to extend segment with buffered samples.
+    /*!
+     * Fits segment to all buffered samples. If the fit is within tolerance, it is kept as
+     * candidate segment; otherwise the candidate segment is written.
+     */
+    void extendSegment( );
+
+    //! Write longest segment within tolerance.
+    /*!
+     * Writes segment covering the longest prefix of the buffered samples that is found to be
+     * within tolerance, trying all buffered samples, the candidate segment and halving the number
+     * of samples, in that order. An error is thrown if not even the segment between the first
+     * two samples is within tolerance.
+     */
+    void writeLongestSegment( );
+
+    //! Write segment.
+    /*!
+     * Appends segment covering the first samples in the buffer to the list of segments, and
+     * removes these samples from the buffer, except for the sample at the end of the segment,
+     * which starts the next segment.
+     *
+     * @param[in] numberOfSegmentSamples    Number of samples in segment
+     * @param[in] segmentCoefficients       Coefficients of segment
+     * @param[in] positionError             Maximum position error at samples     [km]
+     * @param[in] velocityError             Maximum velocity error at samples     [km s^-1]
+     */
+    void writeSegment( const std::size_t numberOfSegmentSamples,
+                       const std::vector< double >& segmentCoefficients,
+                       const double positionError,
+                       const double velocityError );
+
+    //! Chebyshev trajectory filename.
+    const std::string filename;
+
+    //! Maximum position error at samples [km].
+    const double positionTolerance;
+
+    //! Maximum velocity error at samples [km s^-1].
+    const double velocityTolerance;
+
+    //! Number of coefficients per component and segment.
+    const std::size_t numberOfCoefficients;
+
+    //! Maximum number of samples per segment.
+    const std::size_t maximumNumberOfSamples;
+
+    //! Epochs of buffered samples [s].
+    std::vector< double > sampleTimes;
+
+    //! Buffered samples [km; km s^-1].
+    std::vector< State > sampleStates;
+
+    //! Number of buffered samples at which the next fit is attempted.
+    std::size_t nextFitSize;
+
+    //! Number of samples covered by candidate segment; zero if there is no candidate.
+    std::size_t candidateSize;
+
+    //! Coefficients of candidate segment.
+    std::vector< double > candidateCoefficients;
+
+    //! Maximum position error of candidate segment [km].
+    double candidatePositionError;
+
+    //! Maximum velocity error of candidate segment [km s^-1].
+    double candidateVelocityError;
+
+    //! Boundaries of segments written [s].
+    std::vector< double > boundaries;
+
+    //! Coefficients of segments written.
+    std::vector< double > coefficients;
+
+    //! Number of samples accepted by the writer.
+    std::size_t numberOfSamples;
+
+    //! Maximum position error of segments written [km].
+    double maximumPositionError;
+
+    //! Maximum velocity error of segments written [km s^-1].
+    double maximumVelocityError;
+
+    //! Flag indicating if writer has been closed.
+    bool isClosed;
+};
+
+//! Chebyshev trajectory.
+/*!
+ * Reader for Chebyshev trajectory files written by ChebyshevTrajectoryWriter, which evaluates the
+ * position and velocity at any epoch within the time span of the file. The file is memory mapped,
+ * so that the coefficients are used directly, without copying or parsing the data. An error is
+ * thrown if the file is not a valid Chebyshev trajectory file or has an unsupported version.
+ *
+ * The segments generally have different durations. To find the segment containing an epoch in
+ * constant expected time, the time span is divided into uniform buckets on construction (four
+ * per segment), each of which stores the first segment overlapping it; the lookup starts at the
+ * bucket containing the epoch and advances over the (on average at most two) segment boundaries
+ * within the bucket.
+ *
+ * @sa ChebyshevTrajectoryWriter
+ */
+class ChebyshevTrajectory
+{
+public:
+
+    //! Construct Chebyshev trajectory.
+    /*!
+     * Constructs Chebyshev trajectory by memory mapping the Chebyshev trajectory file, parsing its
+     * header and building the segment lookup table.
+     *
+     * @param[in] filename Chebyshev trajectory filename
+     */
+    explicit ChebyshevTrajectory( const std::string& filename );
+
+    //! Get number of segments.
+    /*!
+     * Returns number of segments in Chebyshev trajectory file.
+     *
+     * @return Number of segments
+     */
+    std::size_t getNumberOfSegments( ) const { return numberOfSegments; }
+
+    //! Get number of coefficients.
+    /*!
+     * Returns number of coefficients per component and segment.
+     *
+     * @return Number of coefficients
+     */
+    std::size_t getNumberOfCoefficients( ) const { return numberOfCoefficients; }
+
+    //! Get start time.
+    /*!
+     * Returns start of time span covered by Chebyshev trajectory.
+     *
+     * @return Start time                                                         [s]
+     */
+    double getStartTime( ) const { return boundaries[ 0 ]; }
+
+    //! Get end time.
+    /*!
+     * Returns end of time span covered by Chebyshev trajectory.
+     *
+     * @return End time                                                           [s]
+     */
+    double getEndTime( ) const { return boundaries[ numberOfSegments ]; }
+
+    //! Get position tolerance.
+    /*!
+     * Returns position tolerance used to fit the Chebyshev trajectory.
+     *
+     * @return Position tolerance                                                 [km]
+     */
+    double getPositionTolerance( ) const { return positionTolerance; }
+
+    //! Get velocity tolerance.
+    /*!
+     * Returns velocity tolerance used to fit the Chebyshev trajectory.
+     *
+     * @return Velocity tolerance                                                 [km s^-1]
+     */
+    double getVelocityTolerance( ) const { return velocityTolerance; }
+
+    //! Get metadata.
+    /*!
+     * Returns simulation metadata stored in header of Chebyshev trajectory file.
+     *
+     * @return Simulation metadata
+     */
+    const TrajectoryMetadata& getMetadata( ) const { return metadata; }
+
+    //! Find segment.
+    /*!
+     * Returns index of segment containing given epoch. An epoch at the boundary between two
+     * segments belongs to the later segment, except for the end time, which belongs to the last
+     * segment. An error is thrown if the epoch is outside the time span of the trajectory.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         Index of segment
+     */
+    std::size_t findSegment( const double time ) const;
+
+    //! Get position.
+    /*!
+     * Evaluates position at given epoch.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         Position at epoch                                          [km]
+     */
+    Position getPosition( const double time ) const;
+
+    //! Get state.
+    /*!
+     * Evaluates position and velocity at given epoch.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         State at epoch                                             [km; km s^-1]
+     */
+    State getState( const double time ) const;
+
+protected:
+
+private:
+
+    //! Mapped Chebyshev trajectory file.
+    boost::interprocess::file_mapping file;
+
+    //! Mapped region of Chebyshev trajectory file.
+    boost::interprocess::mapped_region region;
+
+    //! Number of segments.
+    std::size_t numberOfSegments;
+
+    //! Number of coefficients per component and segment.
+    std::size_t numberOfCoefficients;
+
+    //! Position tolerance used to fit the trajectory [km].
+    double positionTolerance;
+
+    //! Velocity tolerance used to fit the trajectory [km s^-1].
+    double velocityTolerance;
+
+    //! Simulation metadata.
+    TrajectoryMetadata metadata;
+
+    //! Pointer to segment boundaries in mapped region [s].
+    const double* boundaries;
+
+    //! Pointer to coefficients in mapped region.
+    const double* coefficients;
+
+    //! Lookup table of segments.
+    IntervalLookupTable lookupTable;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_CHEBYSHEV_TRAJECTORY_HPP
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_CHECKPOINT_HPP
+#define SCARAB_CHECKPOINT_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Version of checkpoint file format.
+const unsigned int checkpointFileVersion = 3;
+
+//! Checkpoint.
+/*!
+ * Binary snapshot of the state of a simulation, from which the simulation can be resumed. The
+ * components of the simulation (integrator, event detector, state history sink, etc.) append
+ * their state to the checkpoint in a fixed order, and read it back in the same order when the
+ * simulation is resumed.
+ *
+ * Values are stored in little-endian byte order, independent of the host; doubles are stored
+ * bit-for-bit, so that a resumed simulation continues with exactly the same values. An error is
+ * thrown if a value is read beyond the end of the checkpoint.
+ *
+ * @sa writeCheckpointFile, readCheckpointFile
+ */
+class Checkpoint
+{
+public:
+
+    //! Construct empty checkpoint.
+    /*!
+     * Constructs empty checkpoint, to which values can be written.
+     */
+    Checkpoint( ) : readPosition( 0 ) { }
+
+    //! Construct checkpoint from data.
+    /*!
+     * Constructs checkpoint from serialized data, from which values can be read.
+     *
+     * @param[in] someData Serialized checkpoint data
+     */
+    explicit Checkpoint( const std::vector< char >& someData )
+        : data( someData ),
+          readPosition( 0 )
+    { }
+
+    //! Write unsigned integer.
+    /*!
+     * Appends unsigned integer to checkpoint, as 8 bytes.
+     *
+     * @param[in] value Unsigned integer
+     */
+    void writeSize( const boost::uint64_t value );
+
+    //! Write double.
+    /*!
+     * Appends double to checkpoint, bit-for-bit.
+     *
+     * @param[in] value Double
+     */
+    void writeDouble( const double value );
+
+    //! Write string.
+    /*!
+     * Appends string to checkpoint, as its length followed by its characters.
+     *
+     * @param[in] value String
+     */
+    void writeString( const std::string& value );
+
+    //! Write state.
+    /*!
+     * Appends the six components of a state to checkpoint.
+     *
+     * @param[in] state State
+     */
+    void writeState( const State& state );
+
+    //! Write list of doubles.
+    /*!
+     * Appends list of doubles to checkpoint, as its size followed by its values.
+     *
+     * @param[in] values List of doubles
+     */
+    void writeDoubles( const std::vector< double >& values );
+
+    //! Read unsigned integer.
+    /*!
+     * Reads next unsigned integer from checkpoint.
+     *
+     * @return Unsigned integer
+     */
+    boost::uint64_t readSize( );
+
+    //! Read double.
+    /*!
+     * Reads next double from checkpoint.
+     *
+     * @return Double
+     */
+    double readDouble( );
+
+    //! Read string.
+    /*!
+     * Reads next string from checkpoint.
+     *
+     * @return String
+     */
+    std::string readString( );
+
+    //! Read state.
+    /*!
+     * Reads next state from checkpoint.
+     *
+     * @return State
+     */
+    State readState( );
+
+    //! Read list of doubles.
+    /*!
+     * Reads next list of doubles from checkpoint.
+     *
+     * @return List of doubles
+     */
+    std::vector< double > readDoubles( );
+
+    //! Check if all values have been read.
+    /*!
+     * Checks if the read position has reached the end of the checkpoint.
+     *
+     * @return True if all values have been read
+     */
+    bool isAtEnd( ) const { return readPosition == data.size( ); }
+
+    //! Get serialized data.
+    /*!
+     * Returns serialized checkpoint data.
+     *
+     * @return Serialized checkpoint data
+     */
+    const std::vector< char >& getData( ) const { return data; }
+
+    //! Swap serialized data.
+    /*!
+     * Swaps serialized data of checkpoint with given buffer, without copying, and resets the read
+     * position.
+     *
+     * @param[in,out] someData Buffer to swap with
+     */
+    void swap( std::vector< char >& someData );
+
+protected:
+
+private:
+
+    //! Read given number of bytes, checking that they are available.
+    const unsigned char* read( const std::size_t numberOfBytes );
+
+    //! Serialized checkpoint data.
+    std::vector< char > data;
+
+    //! Read position in serialized data.
+    std::size_t readPosition;
+};
+
+//! Compute checksum.
+/*!
+ * Computes 64-bit FNV-1a checksum of data, as stored in the header of checkpoint files.
+ *
+ * @param[in] data Data
+ * @return         Checksum
+ */
+boost::uint64_t computeChecksum( const std::vector< char >& data );
+
+//! Write checkpoint file.
+/*!
+ * Writes checkpoint to file, with a header containing a magic string, the file format version,
+ * the size of the checkpoint data and a checksum. The checkpoint is first written to a temporary
+ * file and flushed to disk, after which it replaces the checkpoint file, so that the checkpoint
+ * file is always complete, also if the process is killed or the system crashes while writing it.
+ *
+ * @sa readCheckpointFile
+ * @param[in] filename   Checkpoint filename
+ * @param[in] checkpoint Checkpoint
+ */
+void writeCheckpointFile( const std::string& filename, const Checkpoint& checkpoint );
+
+//! Read checkpoint file.
+/*!
+ * Reads checkpoint from file. An error is thrown if the file cannot be read, is not a checkpoint
+ * file of the supported version, or if the checksum does not match.
+ *
+ * @sa writeCheckpointFile
+ * @param[in] filename Checkpoint filename
+ * @return             Checkpoint
+ */
+Checkpoint readCheckpointFile( const std::string& filename );
+
+//! Asynchronous checkpoint writer.
+/*!
+ * Writes checkpoints to file on a background thread, so that writing a checkpoint does not stall
+ * the integration. The caller only serializes the checkpoint and hands over its data.
+ *
+ * At most one checkpoint is pending: if a checkpoint is submitted while the previous one is still
+ * waiting to be written, the previous one is dropped, since only the latest checkpoint is needed
+ * to resume. The first error raised while writing is stored and rethrown by wait().
+ *
+ * @sa writeCheckpointFile
+ */
+class AsyncCheckpointWriter
+{
+public:
+
+    //! Construct asynchronous checkpoint writer.
+    /*!
+     * Constructs asynchronous checkpoint writer and starts background thread.
+     *
+     * @param[in] aFilename Checkpoint filename
+     */
+    explicit AsyncCheckpointWriter( const std::string& aFilename );
+
+    //! Destruct asynchronous checkpoint writer.
+    /*!
+     * Writes pending checkpoint, if any, and joins background thread. Errors are ignored.
+     */
+    ~AsyncCheckpointWriter( );
+
+    //! Submit checkpoint.
+    /*!
+     * Submits checkpoint to be written to file. The data of the checkpoint is moved to the writer,
+     * so that the checkpoint is empty on return.
+     *
+     * @param[in,out] checkpoint Checkpoint; empty on return
+     */
+    void submit( Checkpoint& checkpoint );
+
+    //! Wait for checkpoint to be written.
+    /*!
+     * Blocks until the pending checkpoint, if any, has been written. If writing a checkpoint
+     * failed, the error is rethrown.
+     */
+    void wait( );
+
+    //! Get number of checkpoints written.
+    /*!
+     * Returns number of checkpoints written to file so far.
+     *
+     * @return Number of checkpoints written
+     */
+    std::size_t getNumberOfCheckpointsWritten( ) const;
+
+protected:
+
+private:
+
+    //! Run background thread.
+    void run( );
+
+    //! Checkpoint filename.
+    const std::string filename;
+
+    //! Mutex guarding members below.
+    mutable std::mutex mutex;
+
+    //! Condition signalled when a checkpoint is submitted or the writer is stopped.
+    std::condition_variable checkpointSubmitted;
+
+    //! Condition signalled when a checkpoint has been written.
+    std::condition_variable checkpointWritten;
+
+    //! Data of pending checkpoint.
+    std::vector< char > pendingData;
+
+    //! Flag indicating if a checkpoint is pending.
+    bool isPending;
+
+    //! Flag indicating if a checkpoint is being written.
+    bool isWriting;
+
+    //! Flag indicating if the writer is stopping.
+    bool isStopping;
+
+    //! Number of checkpoints written.
+    std::size_t numberOfCheckpointsWritten;
+
+    //! First error raised while writing.
+    std::exception_ptr error;
+
+    //! Background thread.
+    std::thread worker;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_CHECKPOINT_HPP
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_CHECKPOINT_SETTINGS_HPP
+#define SCARAB_CHECKPOINT_SETTINGS_HPP
+
+#include <string>
+
+namespace scarab
+{
+
+//! Checkpoint settings.
+/*!
+ * Data struct containing all valid input parameters for checkpoints of long-running simulations.
+ * This struct is populated by the checkSimulatorSettings() function.
+ *
+ * Checkpoints are written to file periodically during integration, measured in wall-clock time,
+ * so that an interrupted simulation can be resumed from the last checkpoint.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, Checkpoint
+ */
+struct CheckpointSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] aStatus               Flag indicating if checkpoints are on or off
+     * @param[in] aCheckpointFilename   Filename for checkpoints
+     * @param[in] aCheckpointInterval   Wall-clock time between checkpoints (0 = every step)  [s]
+     */
+    CheckpointSettings( const bool          aStatus,
+                        const std::string&  aCheckpointFilename,
+                        const double        aCheckpointInterval )
+        : status( aStatus ),
+          checkpointFilename( aCheckpointFilename ),
+          checkpointInterval( aCheckpointInterval )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Checkpoint filename.
+    const std::string checkpointFilename;
+
+    //! Wall-clock time between checkpoints (0 = every step) [s].
+    const double checkpointInterval;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_CHECKPOINT_SETTINGS_HPP
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_COMPOSED_STATE_DERIVATIVE_MODEL_HPP
+#define SCARAB_COMPOSED_STATE_DERIVATIVE_MODEL_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Composed state derivative model.
+/*!
+ * State derivative model that composes a fixed set of acceleration models at compile time. The
+ * acceleration models are stored by value and their ()-operators are called through their static
+ * types, so the compiler can inline them into the odeint stepper instead of dispatching through
+ * the virtual ()-operator of AccelerationModel. The acceleration models shipped with Scarab are
+ * declared final, so that these calls are not dispatched virtually even though the ()-operator is
+ * virtual. This model fulfills the requirements to be used with the Boost odeint library (K. Ahnert
+ * and M. Mulansky, 2011).
+ *
+ * The composed model is intended for production scenarios in which the set of acceleration models
+ * is known when compiling; for sets of models read from the configuration file, the
+ * runtime-polymorphic StateDerivativeModel is used. The composed model is integrated with the
+ * integrateState( ) template in integratorTemplate.hpp, which calls it through its static type.
+ *
+ * @sa StateDerivativeModel, makeComposedStateDerivativeModel, integrateState
+ * @tparam AccelerationModels Types of acceleration models, each of which provides
+ *                            Acceleration operator( )( const State&, const double ) const
+ */
+template < typename... AccelerationModels >
+class ComposedStateDerivativeModel
+{
+public:
+
+    //! Construct composed state derivative model.
+    /*!
+     * Constructs composed state derivative model, storing copies of the acceleration models.
+     *
+     * @param[in] someAccelerationModels Acceleration models
+     */
+    explicit ComposedStateDerivativeModel( const AccelerationModels&... someAccelerationModels )
+        : accelerationModels( someAccelerationModels... )
+    { }
+
+    //! Compute state derivative.
+    /*!
+     * Computes state derivative by overloading ()-operator. The acceleration is the sum of the
+     * accelerations computed by all acceleration models.
+     *
+     * @param[in]  state            Current state                               [km; km s^-1]
+     * @param[out] stateDerivative  Computed state derivative           [km s^-1; km s^-2]
+     * @param[in]  time             Current time                                [s]
+     */
+    void operator( )( const State& state, State& stateDerivative, const double time ) const
+    {
+        Acceleration acceleration;
+        acceleration[ 0 ] = 0.0;
+        acceleration[ 1 ] = 0.0;
+        acceleration[ 2 ] = 0.0;
+        addAccelerations< 0 >( state, time, acceleration );
+
+        stateDerivative[ 0 ] = state[ 3 ];
+        stateDerivative[ 1 ] = state[ 4 ];
+        stateDerivative[ 2 ] = state[ 5 ];
+        stateDerivative[ 3 ] = acceleration[ 0 ];
+        stateDerivative[ 4 ] = acceleration[ 1 ];
+        stateDerivative[ 5 ] = acceleration[ 2 ];
+    }
+
+protected:
+
+private:
+
+    //! Add acceleration of model and of all subsequent models.
+    /*!
+     * Adds acceleration computed by model at given index to the total acceleration, and recurses
+     * to the next model. The recursion is resolved at compile time.
+     *
+     * @tparam     index        Index of acceleration model
+     * @param[in]  state        Current state                                   [km; km s^-1]
+     * @param[in]  time         Current time                                    [s]
+     * @param[out] acceleration Total acceleration                              [km s^-2]
+     */
+    template < std::size_t index >
+    typename std::enable_if< ( index < sizeof...( AccelerationModels ) ) >::type
+    addAccelerations( const State& state, const double time, Acceleration& acceleration ) const
+    {
+        const Acceleration modelAcceleration
+            = std::get< index >( accelerationModels )( state, time );
+        acceleration[ 0 ] += modelAcceleration[ 0 ];
+        acceleration[ 1 ] += modelAcceleration[ 1 ];
+        acceleration[ 2 ] += modelAcceleration[ 2 ];
+
+        addAccelerations< index + 1 >( state, time, acceleration );
+    }
+
+    //! End recursion over acceleration models.
+    /*!
+     * Ends compile-time recursion over acceleration models; does nothing.
+     *
+     * @tparam     index        Index past last acceleration model
+     * @param[in]  state        Current state (unused)                          [km; km s^-1]
+     * @param[in]  time         Current time (unused)                           [s]
+     * @param[out] acceleration Total acceleration (unused)                     [km s^-2]
+     */
+    template < std::size_t index >
+    typename std::enable_if< ( index == sizeof...( AccelerationModels ) ) >::type
+    addAccelerations( const State& /* state */,
+                      const double /* time */,
+                      Acceleration& /* acceleration */ ) const
+    { }
+
+    //! Acceleration models.
+    const std::tuple< AccelerationModels... > accelerationModels;
+};
+
+//! Make composed state derivative model.
+/*!
+ * Makes composed state derivative model, deducing the types of the acceleration models from the
+ * arguments.
+ *
+ * @sa ComposedStateDerivativeModel
+ * @tparam    AccelerationModels      Types of acceleration models
+ * @param[in] someAccelerationModels  Acceleration models
+ * @return                            Composed state derivative model
+ */
+template < typename... AccelerationModels >
+ComposedStateDerivativeModel< AccelerationModels... > makeComposedStateDerivativeModel(
+    const AccelerationModels&... someAccelerationModels )
+{
+    return ComposedStateDerivativeModel< AccelerationModels... >( someAccelerationModels... );
+}
+
+} // namespace scarab
+
+#endif // SCARAB_COMPOSED_STATE_DERIVATIVE_MODEL_HPP
+
+/*!
+ * K. Ahnert and M. Mulansky, Odeint - Solving Ordinary Differential Equations in C++, AIP Conf.
+ *  Proc. 1389, pp. 1586-1589 (2011), doi:http://dx.doi.org/10.1063/1.3637934.
+ */
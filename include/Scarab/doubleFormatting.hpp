@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_DOUBLE_FORMATTING_HPP
+#define SCARAB_DOUBLE_FORMATTING_HPP
+
+#include <cstddef>
+#include <ostream>
+
+namespace scarab
+{
+
+//! Maximum number of characters written by formatShortestDouble().
+const std::size_t maximumFormattedDoubleLength = 25;
+
+//! Format double with shortest round-trip representation.
+/*!
+ * Formats double as the shortest decimal string that parses back to exactly the same double
+ * (e.g., using std::strtod). If there are several shortest strings, the one closest to the exact
+ * value is written. Values with a decimal exponent in [-4, 17) are written in fixed notation,
+ * other values in scientific notation (e.g., 1.5e-07), similar to the %g conversion of printf.
+ * Infinity and NaN are written as "inf" and "nan". No terminating null character is written.
+ *
+ * The digits are computed with the Ryu algorithm (U. Adams, 2018), which only uses integer
+ * arithmetic and is an order of magnitude faster than formatting with printf or iostreams. On
+ * compilers without a 128-bit integer type, the digits are found by formatting with 15, 16 and 17
+ * significant digits using printf, until the string parses back to the same double; this also
+ * round-trips exactly, but may write one digit more than necessary for subnormal numbers.
+ *
+ * @param[in]  value  Value to format
+ * @param[out] buffer Buffer of at least maximumFormattedDoubleLength characters
+ * @return            Number of characters written to buffer
+ */
+std::size_t formatShortestDouble( const double value, char* buffer );
+
+//! Write double to stream with shortest round-trip representation.
+/*!
+ * Writes double to stream as formatted by formatShortestDouble( ), independent of the precision
+ * and format flags of the stream.
+ *
+ * @sa formatShortestDouble
+ * @param[in,out] stream Output stream
+ * @param[in]     value  Value to write
+ */
+void writeShortestDouble( std::ostream& stream, const double value );
+
+} // namespace scarab
+
+#endif // SCARAB_DOUBLE_FORMATTING_HPP
+
+/*!
+ * U. Adams, Ryu: Fast Float-to-String Conversion, Proceedings of the 39th ACM SIGPLAN Conference
+ *  on Programming Language Design and Implementation, pp. 270-282 (2018),
+ *  doi:http://dx.doi.org/10.1145/3192366.3192369.
+ */
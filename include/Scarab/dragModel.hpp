@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+/*!
+ * D.A. Vallado, Fundamentals of Astrodynamics and Applications, 4th edition, Microcosm Press
+ *  (2013), Section 8.6.2, Table 8-4.
+ */
+
+#ifndef SCARAB_DRAG_MODEL_HPP
+#define SCARAB_DRAG_MODEL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/dragSettings.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Get exponential atmosphere table.
+/*!
+ * Returns table of the exponential atmosphere model for the Earth (Vallado, 2013), with layers
+ * from 0 to 1000 km altitude; the top layer extends beyond 1000 km.
+ *
+ * @return Table of atmosphere layers
+ */
+AtmosphereTable getExponentialAtmosphereTable( );
+
+//! Read atmosphere table.
+/*!
+ * Reads density profile from file and converts it to a table of atmosphere layers. Every data
+ * line contains an altitude [km] and the density at that altitude [kg m^-3], separated by
+ * whitespace or commas; empty lines and lines starting with "#" are skipped. The altitudes must
+ * increase and the densities decrease from line to line. The density is interpolated
+ * exponentially between consecutive lines; above the last line, the scale height between the
+ * last two lines is used.
+ *
+ * @param[in] filename Name of density file
+ * @return             Table of atmosphere layers
+ */
+AtmosphereTable readAtmosphereTable( const std::string& filename );
+
+//! Compute density of piecewise exponential atmosphere.
+/*!
+ * Computes density at given altitude by looking up the layer with a binary search and evaluating
+ * its exponential profile. Below the lowest layer, the profile of the lowest layer is used.
+ *
+ * @param[in] atmosphereTable Table of atmosphere layers
+ * @param[in] altitude        Altitude                                           [km]
+ * @return                    Density                                            [kg m^-3]
+ */
+double computeAtmosphereDensity( const AtmosphereTable& atmosphereTable, const double altitude );
+
+//! Atmospheric drag acceleration model.
+/*!
+ * Atmospheric drag acceleration model for a cannonball spacecraft in an atmosphere that
+ * co-rotates with the central body about the z-axis. The acceleration opposes the velocity with
+ * respect to the atmosphere, with magnitude 1/2 rho C_D A / m v^2.
+ *
+ * The density is computed from a piecewise exponential atmosphere (Vallado, 2013), which is
+ * tabulated on construction in altitude buckets of equal width, so that a density lookup costs
+ * one multiplication to find the bucket and one polynomial evaluation, without a search over the
+ * layers or an exponential function. In every bucket, the exponential profile is represented by
+ * its Taylor polynomial of degree 5 about the bottom of the bucket, which is accurate to better
+ * than 1e-7 relative for scale heights down to 5 km; a bucket that contains the base of a layer
+ * holds a second polynomial for the part above. Outside the tabulated altitudes, the density is
+ * computed from the atmosphere table directly.
+ */
+class DragModel final : public AccelerationModel< Acceleration >
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs drag model and tabulates density in altitude buckets.
+     *
+     * @param[in] aDragCoefficient      Drag coefficient                            [-]
+     * @param[in] aDragArea             Area subject to drag                        [m^2]
+     * @param[in] aMass                 Spacecraft mass                             [kg]
+     * @param[in] anAtmosphereTable     Table of atmosphere layers
+     * @param[in] aCentralBodyRadius    Radius of central body                      [km]
+     * @param[in] aRotationRate         Rotation rate of atmosphere about z-axis    [rad s^-1]
+     */
+    DragModel( const double             aDragCoefficient,
+               const double             aDragArea,
+               const double             aMass,
+               const AtmosphereTable&   anAtmosphereTable,
+               const double             aCentralBodyRadius,
+               const double             aRotationRate );
+
+    //! Compute acceleration.
+    /*!
+     * Computes drag acceleration, opposite to the velocity with respect to the atmosphere.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time (unused)                                   [s]
+     * @return          Computed acceleration                                   [km s^-2]
+     */
+    Acceleration operator( )( const State& state, const double /* time */ ) const
+    {
+        const double altitude = std::sqrt( state[ 0 ] * state[ 0 ]
+                                           + state[ 1 ] * state[ 1 ]
+                                           + state[ 2 ] * state[ 2 ] ) - centralBodyRadius;
+
+        // Velocity with respect to atmosphere, v - omega x r.
+        const double vx = state[ 3 ] + rotationRate * state[ 1 ];
+        const double vy = state[ 4 ] - rotationRate * state[ 0 ];
+        const double vz = state[ 5 ];
+        const double factor = -accelerationFactor * computeDensity( altitude )
+                              * std::sqrt( vx * vx + vy * vy + vz * vz );
+
+        Acceleration acceleration;
+        acceleration[ 0 ] = factor * vx;
+        acceleration[ 1 ] = factor * vy;
+        acceleration[ 2 ] = factor * vz;
+        return acceleration;
+    }
+
+    //! Compute density.
+    /*!
+     * Computes density at given altitude from the altitude buckets.
+     *
+     * @param[in] altitude Altitude                                             [km]
+     * @return             Density                                              [kg m^-3]
+     */
+    double computeDensity( const double altitude ) const
+    {
+        const double offset = altitude - minimumAltitude;
+        if ( !( offset >= 0.0 && offset < altitudeRange ) )
+        {
+            return computeAtmosphereDensity( atmosphereTable, altitude );
+        }
+
+        const std::size_t index = std::min( static_cast< std::size_t >( offset / bucketWidth ),
+                                            buckets.size( ) - 1 );
+        const DensityBucket& bucket = buckets[ index ];
+        double height = offset - index * bucketWidth;
+        const double* coefficients = bucket.lowerCoefficients;
+        if ( height >= bucket.splitHeight )
+        {
+            height -= bucket.splitHeight;
+            coefficients = bucket.upperCoefficients;
+        }
+
+        return coefficients[ 0 ]
+               + height * ( coefficients[ 1 ]
+               + height * ( coefficients[ 2 ]
+               + height * ( coefficients[ 3 ]
+               + height * ( coefficients[ 4 ]
+               + height * coefficients[ 5 ] ) ) ) );
+    }
+
+protected:
+
+private:
+
+    //! Number of coefficients of density polynomial per bucket.
+    static const std::size_t numberOfCoefficients = 6;
+
+    //! Altitude bucket.
+    /*!
+     * Density polynomials of an altitude bucket, in the height above the bottom of the bucket
+     * and, above the split height, in the height above the split height.
+     */
+    struct DensityBucket
+    {
+        //! Height of base of layer within bucket; bucket width if there is none [km].
+        double splitHeight;
+
+        //! Coefficients of density polynomial below split height [kg m^-3 km^-i].
+        double lowerCoefficients[ numberOfCoefficients ];
+
+        //! Coefficients of density polynomial above split height [kg m^-3 km^-i].
+        double upperCoefficients[ numberOfCoefficients ];
+    };
+
+    //! Compute Taylor coefficients of exponential profile of layer at given altitude.
+    void computeCoefficients( const AtmosphereLayer& layer,
+                              const double altitude,
+                              double coefficients[ numberOfCoefficients ] ) const;
+
+    //! Drag acceleration factor 1/2 C_D A / m, converted to [km^-1] for velocities in [km s^-1].
+    const double accelerationFactor;
+
+    //! Table of atmosphere layers.
+    const AtmosphereTable atmosphereTable;
+
+    //! Radius of central body [km].
+    const double centralBodyRadius;
+
+    //! Rotation rate of atmosphere about z-axis [rad s^-1].
+    const double rotationRate;
+
+    //! Width of altitude buckets [km].
+    double bucketWidth;
+
+    //! Bottom altitude of lowest bucket [km].
+    double minimumAltitude;
+
+    //! Altitude range covered by buckets [km].
+    double altitudeRange;
+
+    //! Altitude buckets.
+    std::vector< DensityBucket > buckets;
+};
+
+//! Pointer to drag model.
+typedef boost::shared_ptr< DragModel > DragModelPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_DRAG_MODEL_HPP
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_DRAG_SETTINGS_HPP
+#define SCARAB_DRAG_SETTINGS_HPP
+
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+
+//! Atmosphere layer.
+/*!
+ * Data struct containing a layer of a piecewise exponential atmosphere: the density decays
+ * exponentially with the scale height of the layer from its base density at its base altitude,
+ * up to the base altitude of the next layer.
+ */
+struct AtmosphereLayer
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct.
+     *
+     * @param[in] aBaseAltitude Base altitude of layer                              [km]
+     * @param[in] aBaseDensity  Density at base altitude                            [kg m^-3]
+     * @param[in] aScaleHeight  Scale height of layer                               [km]
+     */
+    AtmosphereLayer( const double aBaseAltitude,
+                     const double aBaseDensity,
+                     const double aScaleHeight )
+        : baseAltitude( aBaseAltitude ),
+          baseDensity( aBaseDensity ),
+          scaleHeight( aScaleHeight )
+    { }
+
+    //! Base altitude of layer [km].
+    double baseAltitude;
+
+    //! Density at base altitude [kg m^-3].
+    double baseDensity;
+
+    //! Scale height of layer [km].
+    double scaleHeight;
+
+protected:
+
+private:
+};
+
+//! Table of atmosphere layers, ordered by increasing base altitude.
+typedef std::vector< AtmosphereLayer > AtmosphereTable;
+
+//! Drag model settings.
+/*!
+ * Data struct containing all valid input parameters for the drag model. This struct is populated
+ * by the checkSimulatorSettings() function, which also reads the density table from file, if set,
+ * so that it is read once, also for ensembles.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, DragModel
+ */
+struct DragSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] aStatus               Flag indicating if model is on or off
+     * @param[in] aDragCoefficient      Drag coefficient                            [-]
+     * @param[in] aDragArea             Area subject to drag                        [m^2]
+     * @param[in] aDensityFilename      Name of density file; empty for built-in table
+     * @param[in] anAtmosphereTable     Table of atmosphere layers
+     * @param[in] aCentralBodyRadius    Radius of central body                      [km]
+     * @param[in] aRotationRate         Rotation rate of atmosphere about z-axis    [rad s^-1]
+     */
+    DragSettings( const bool                aStatus,
+                  const double              aDragCoefficient,
+                  const double              aDragArea,
+                  const std::string&        aDensityFilename,
+                  const AtmosphereTable&    anAtmosphereTable,
+                  const double              aCentralBodyRadius,
+                  const double              aRotationRate )
+        : status( aStatus ),
+          dragCoefficient( aDragCoefficient ),
+          dragArea( aDragArea ),
+          densityFilename( aDensityFilename ),
+          atmosphereTable( anAtmosphereTable ),
+          centralBodyRadius( aCentralBodyRadius ),
+          rotationRate( aRotationRate )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Drag coefficient [-].
+    const double dragCoefficient;
+
+    //! Drag area [m^2].
+    const double dragArea;
+
+    //! Name of density file; empty for built-in table.
+    const std::string densityFilename;
+
+    //! Table of atmosphere layers.
+    const AtmosphereTable atmosphereTable;
+
+    //! Radius of central body [km].
+    const double centralBodyRadius;
+
+    //! Rotation rate of atmosphere about z-axis [rad s^-1].
+    const double rotationRate;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_DRAG_SETTINGS_HPP
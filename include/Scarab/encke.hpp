@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+/*!
+ * R.H. Battin, An Introduction to the Mathematics and Methods of Astrodynamics, Revised Edition,
+ *  AIAA Education Series (1999), Section 10.2.
+ * H.D. Curtis, Orbital Mechanics for Engineering Students, 3rd Edition, Butterworth-Heinemann
+ *  (2014), Section 3.7.
+ * D.A. Vallado, Fundamentals of Astrodynamics and Applications, 4th Edition, Microcosm Press
+ *  (2013), Algorithm 8.
+ */
+
+#ifndef SCARAB_ENCKE_HPP
+#define SCARAB_ENCKE_HPP
+
+#include <vector>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/simulatorSettings.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Propagate Keplerian orbit.
+/*!
+ * Propagates state on a Keplerian (two-body) orbit over the given elapsed time, using the
+ * universal-variable formulation of Kepler's equation, so that elliptic, parabolic and hyperbolic
+ * orbits are treated alike (Curtis, 2014). Kepler's equation is solved with Newton's method.
+ *
+ * @param[in] gravitationalParameter    Gravitational parameter of central body [km^3 s^-2]
+ * @param[in] initialState              Initial state                           [km; km s^-1]
+ * @param[in] elapsedTime               Time elapsed since initial epoch        [s]
+ * @return                              Propagated state                        [km; km s^-1]
+ */
+State propagateKeplerOrbit( const double gravitationalParameter,
+                            const State& initialState,
+                            const double elapsedTime );
+
+//! Compute Encke function.
+/*!
+ * Computes f( q ) = 1 - ( 1 + q )^( -3/2 ) in a form that does not suffer from cancellation for
+ * small q (Battin, 1999). With reference position rho and deviation delta,
+ * q = delta . ( 2 rho + delta ) / |rho|^2, and the difference between the central gravitational
+ * accelerations at rho + delta and at rho is mu / |rho|^3 ( f( q ) ( rho + delta ) - delta ).
+ *
+ * @param[in] q Ratio q                                                         [-]
+ * @return      Encke function f( q )                                           [-]
+ */
+double computeEnckeFunction( const double q );
+
+//! Target trajectory.
+/*!
+ * Dense target trajectory, stored as the states and state derivatives at the end of every
+ * integration step. States between steps are interpolated with the quintic Hermite polynomial of
+ * the step, so the target trajectory is as accurate as the numerical integration itself.
+ *
+ * @sa interpolateState, propagateTargetTrajectory
+ */
+class TargetTrajectory
+{
+public:
+
+    //! Construct target trajectory.
+    /*!
+     * Constructs target trajectory from states and state derivatives at ascending epochs.
+     *
+     * @param[in] someEpochs            Epochs, in ascending order              [s]
+     * @param[in] someStates            States at epochs                        [km; km s^-1]
+     * @param[in] someStateDerivatives  State derivatives at epochs  [km s^-1; km s^-2]
+     */
+    TargetTrajectory( const std::vector< double >& someEpochs,
+                      const std::vector< State >& someStates,
+                      const std::vector< State >& someStateDerivatives );
+
+    //! Get state.
+    /*!
+     * Gets state of target at given time, by interpolation within the step containing it. Times
+     * outside the trajectory are clamped to its first or last step.
+     *
+     * @param[in] time  Time                                                    [s]
+     * @return          State of target                                         [km; km s^-1]
+     */
+    State getState( const double time ) const;
+
+    //! Get number of steps.
+    /*!
+     * Returns number of integration steps stored.
+     *
+     * @return Number of steps
+     */
+    std::size_t getNumberOfSteps( ) const { return epochs.size( ) - 1; }
+
+protected:
+
+private:
+
+    //! Epochs [s].
+    const std::vector< double > epochs;
+
+    //! States at epochs [km; km s^-1].
+    const std::vector< State > states;
+
+    //! State derivatives at epochs [km s^-1; km s^-2].
+    const std::vector< State > stateDerivatives;
+};
+
+//! Generate list of acceleration models of target.
+/*!
+ * Generates list of acceleration models acting on the target. The drag and radiation pressure
+ * models are created with the mass and areas of the target, taking the areas of the chaser if
+ * those of the target are not set; all other models are shared with the chaser.
+ *
+ * @sa generateAccelerationModelList, TargetSettings
+ * @param[in] settings                  Simulator settings
+ * @param[in] chaserAccelerationModels  List of acceleration models of chaser
+ * @return                              List of acceleration models of target
+ */
+ListOfAccelerationModels generateTargetAccelerationModelList(
+    const SimulatorSettings& settings, const ListOfAccelerationModels& chaserAccelerationModels );
+
+//! Propagate target trajectory.
+/*!
+ * Propagates target from its initial state to the end time with the numerical integrator of the
+ * simulator and the given state derivative model, and stores the dense target trajectory.
+ *
+ * @sa TargetTrajectory, generateTargetAccelerationModelList
+ * @param[in]  settings             Simulator settings
+ * @param[in]  stateDerivativeModel State derivative model of target
+ * @param[out] statistics           Integration statistics of target
+ * @return                          Target trajectory
+ */
+TargetTrajectory propagateTargetTrajectory( const SimulatorSettings& settings,
+                                            const StateDerivativeModel& stateDerivativeModel,
+                                            IntegrationStatistics& statistics );
+
+//! Encke state derivative model.
+/*!
+ * State derivative model of the deviation of the chaser from a reference trajectory (Battin,
+ * 1999). Initially, the reference is the target trajectory, so the deviation is the state of the
+ * chaser relative to the target, and its derivative is the difference between the accelerations
+ * of chaser and target. After rectification, the reference is the osculating Keplerian orbit of
+ * the chaser at the epoch of rectification, and the perturbing accelerations act on the deviation
+ * in full.
+ *
+ * The difference of the central gravitational accelerations is computed with the Encke function,
+ * so the deviation is integrated without the loss of precision incurred by differencing two
+ * absolute accelerations, and the step size is set by the deviation instead of the orbit.
+ *
+ * @sa computeEnckeFunction, propagateEncke
+ */
+class EnckeStateDerivativeModel
+{
+public:
+
+    //! Construct Encke state derivative model.
+    /*!
+     * Constructs Encke state derivative model with the target trajectory as reference. The
+     * central gravity model is replaced by the Encke formulation; all other acceleration models
+     * are perturbations, of the chaser and, as long as the reference is the target trajectory,
+     * of the target.
+     *
+     * @param[in] aGravitationalParameter           Gravitational parameter of central body
+     *                                              [km^3 s^-2]
+     * @param[in] aListOfAccelerationModels         List of acceleration models of chaser
+     * @param[in] aListOfTargetAccelerationModels   List of acceleration models of target
+     * @param[in] aTargetTrajectory                 Target trajectory
+     */
+    EnckeStateDerivativeModel( const double aGravitationalParameter,
+                               const ListOfAccelerationModels& aListOfAccelerationModels,
+                               const ListOfAccelerationModels& aListOfTargetAccelerationModels,
+                               const TargetTrajectory& aTargetTrajectory );
+
+    //! Compute deviation derivative.
+    /*!
+     * Computes derivative of deviation from reference trajectory by overloading ()-operator.
+     *
+     * @param[in]  deviation            Current deviation                       [km; km s^-1]
+     * @param[out] deviationDerivative  Computed deviation derivative   [km s^-1; km s^-2]
+     * @param[in]  time                 Current time                            [s]
+     */
+    void operator( )( const State& deviation,
+                      State& deviationDerivative,
+                      const double time ) const;
+
+    //! Get reference state.
+    /*!
+     * Gets state on reference trajectory at given time.
+     *
+     * @param[in] time  Time                                                    [s]
+     * @return          Reference state                                         [km; km s^-1]
+     */
+    State getReferenceState( const double time ) const;
+
+    //! Check if reference is rectified.
+    /*!
+     * Checks if reference has been rectified, i.e., is no longer the target trajectory.
+     *
+     * @return True if reference is rectified
+     */
+    bool isRectified( ) const { return isReferenceRectified; }
+
+    //! Rectify reference.
+    /*!
+     * Rectifies reference to the osculating Keplerian orbit of the given state, after which the
+     * deviation is to be restarted from zero.
+     *
+     * @param[in] epoch             Epoch of rectification                      [s]
+     * @param[in] osculatingState   State of chaser at epoch                    [km; km s^-1]
+     */
+    void rectify( const double epoch, const State& osculatingState );
+
+protected:
+
+private:
+
+    //! Gravitational parameter of central body [km^3 s^-2].
+    const double gravitationalParameter;
+
+    //! Perturbing acceleration models of chaser, i.e., all models except central gravity.
+    std::vector< AccelerationModel3dPtr > perturbationModels;
+
+    //! Perturbing acceleration models of target, i.e., all models except central gravity.
+    std::vector< AccelerationModel3dPtr > targetPerturbationModels;
+
+    //! Target trajectory.
+    const TargetTrajectory& targetTrajectory;
+
+    //! Flag indicating if reference is rectified.
+    bool isReferenceRectified;
+
+    //! Epoch of osculating Keplerian reference orbit [s].
+    double referenceEpoch;
+
+    //! State of osculating Keplerian reference orbit at epoch [km; km s^-1].
+    State referenceState;
+};
+
+//! Encke propagation statistics.
+/*!
+ * Data struct containing statistics of an Encke propagation.
+ */
+struct EnckeStatistics
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all counters set to zero.
+     */
+    EnckeStatistics( )
+        : numberOfRectifications( 0 )
+    { }
+
+    //! Integration statistics of target trajectory.
+    IntegrationStatistics targetStatistics;
+
+    //! Integration statistics of deviation, summed over all rectification intervals.
+    IntegrationStatistics deviationStatistics;
+
+    //! Number of rectifications of reference.
+    unsigned int numberOfRectifications;
+
+protected:
+
+private:
+};
+
+//! Propagate with Encke's method.
+/*!
+ * Propagates target trajectory once and integrates the deviation of the chaser from it. The
+ * deviation is integrated in rectification intervals; at the end of every interval, the reference
+ * is rectified if the ratio of the position deviation to the reference position exceeds the
+ * rectification threshold. Every interval continues with the step size suggested at the end of
+ * the previous one, unless the reference was rectified.
+ *
+ * The state of the chaser relative to the target is passed to the state history sink, at the
+ * output epochs or, if none are set, after every step. As long as the reference is not rectified,
+ * the relative state is the integrated deviation itself.
+ *
+ * @sa EnckeStateDerivativeModel, propagateTargetTrajectory
+ * @param[in]  settings         Simulator settings
+ * @param[out] stateHistorySink State history sink
+ * @return                      Encke propagation statistics
+ */
+EnckeStatistics propagateEncke( const SimulatorSettings& settings,
+                                StateHistorySink& stateHistorySink );
+
+//! Execute Encke propagation.
+/*!
+ * Executes Encke propagation and writes the simulation metadata and the relative state history
+ * to file, in the same formats as the simulator.
+ *
+ * @sa executeSimulator, propagateEncke
+ * @param[in] settings Simulator settings
+ * @return             Simulation metadata written to file
+ */
+TrajectoryMetadata executeEncke( const SimulatorSettings& settings );
+
+} // namespace scarab
+
+#endif // SCARAB_ENCKE_HPP
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_ENCKE_SETTINGS_HPP
+#define SCARAB_ENCKE_SETTINGS_HPP
+
+namespace scarab
+{
+
+//! Encke settings.
+/*!
+ * Data struct containing all valid input parameters for Encke propagation. This struct is
+ * populated by the checkSimulatorSettings() function.
+ *
+ * In Encke mode, the target trajectory is propagated once and only the deviation of the chaser
+ * from a reference trajectory is integrated. The reference is the target trajectory, until the
+ * deviation exceeds the rectification threshold; the reference is then rectified to the
+ * osculating Keplerian orbit of the chaser.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, executeEncke
+ */
+struct EnckeSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator, executeEncke
+     * @param[in] aStatus                   Flag indicating if Encke mode is on or off
+     * @param[in] aRectificationThreshold   Ratio of deviation to reference position above which
+     *                                      the reference is rectified                  [-]
+     * @param[in] aRectificationInterval    Time interval between checks for rectification [s]
+     */
+    EnckeSettings( const bool   aStatus,
+                   const double aRectificationThreshold,
+                   const double aRectificationInterval )
+        : status( aStatus ),
+          rectificationThreshold( aRectificationThreshold ),
+          rectificationInterval( aRectificationInterval )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Ratio of deviation to reference position above which the reference is rectified [-].
+    const double rectificationThreshold;
+
+    //! Time interval between checks for rectification [s].
+    const double rectificationInterval;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_ENCKE_SETTINGS_HPP
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_ENSEMBLE_HPP
+#define SCARAB_ENSEMBLE_HPP
+
+#include <vector>
+
+#include "Scarab/ensembleSettings.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/simulatorSettings.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Ensemble member.
+/*!
+ * Data struct containing the dispersed initial state and the propagated final state of a single
+ * member of a Monte Carlo ensemble. If the member is terminated by an event, the final state is
+ * the state at the event.
+ */
+struct EnsembleMember
+{
+public:
+
+    //! Index of member in ensemble.
+    unsigned int index;
+
+    //! Dispersed initial state.
+    State initialState;
+
+    //! Final state at end time, or at the terminating event.
+    State finalState;
+
+    //! Integration statistics, including the final time reached.
+    IntegrationStatistics statistics;
+
+    //! Log of events triggered.
+    EventLog eventLog;
+
+protected:
+
+private:
+};
+
+//! Ensemble of propagated members, ordered by member index.
+typedef std::vector< EnsembleMember > Ensemble;
+
+//! Sample initial state of ensemble member.
+/*!
+ * Samples initial state of an ensemble member from a normal distribution centred on the nominal
+ * initial state, with the standard deviations per state component given in the ensemble settings.
+ *
+ * Every member has its own random stream, seeded by the ensemble seed and the member index, so the
+ * sampled initial state only depends on these two and not on the order in which members are
+ * propagated or the number of threads used. The random numbers are drawn with
+ * generateNormalRandomNumber( ), so the samples do not depend on the standard library either.
+ *
+ * @sa generateNormalRandomNumber
+ * @param[in] nominalState  Nominal initial state                           [km; km s^-1]
+ * @param[in] settings      Ensemble settings
+ * @param[in] memberIndex   Index of ensemble member
+ * @return                  Dispersed initial state                         [km; km s^-1]
+ */
+State sampleInitialState( const State&              nominalState,
+                          const EnsembleSettings&   settings,
+                          const unsigned int        memberIndex );
+
+//! Propagate ensemble member.
+/*!
+ * Propagates a single ensemble member from its dispersed initial state to the end time. Each call
+ * constructs its own data store, acceleration models and state derivative model, so that members
+ * can be propagated concurrently.
+ *
+ * @sa sampleInitialState
+ * @param[in] settings      Simulator settings
+ * @param[in] memberIndex   Index of ensemble member
+ * @return                  Propagated ensemble member
+ */
+EnsembleMember propagateEnsembleMember( const SimulatorSettings& settings,
+                                        const unsigned int memberIndex );
+
+//! Propagate ensemble.
+/*!
+ * Propagates all members of an ensemble concurrently on a work-stealing thread pool. The result
+ * is independent of the number of threads used.
+ *
+ * @sa propagateEnsembleMember, ThreadPool
+ * @param[in] settings Simulator settings
+ * @return             Propagated ensemble, ordered by member index
+ */
+Ensemble propagateEnsemble( const SimulatorSettings& settings );
+
+//! Execute ensemble.
+/*!
+ * Executes Monte Carlo ensemble and writes the simulation metadata and the initial and final
+ * states of all members to file.
+ *
+ * @sa executeSimulator, propagateEnsemble
+ * @param[in] settings Simulator settings
+ * @return             Simulation metadata written to file
+ */
+TrajectoryMetadata executeEnsemble( const SimulatorSettings& settings );
+
+} // namespace scarab
+
+#endif // SCARAB_ENSEMBLE_HPP
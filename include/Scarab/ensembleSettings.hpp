@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_ENSEMBLE_SETTINGS_HPP
+#define SCARAB_ENSEMBLE_SETTINGS_HPP
+
+#include <string>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Ensemble settings.
+/*!
+ * Data struct containing all valid input parameters for Monte Carlo ensemble runs. This struct is
+ * populated by the checkSimulatorSettings() function.
+ *
+ * Each member of the ensemble is propagated from an initial state that is drawn from a normal
+ * distribution centred on the nominal initial state, with the standard deviations given per state
+ * component.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, executeEnsemble
+ */
+struct EnsembleSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator, executeEnsemble
+     * @param[in] aStatus                   Flag indicating if ensemble mode is on or off
+     * @param[in] aNumberOfSamples          Number of ensemble members
+     * @param[in] aNumberOfThreads          Number of worker threads (0 = hardware concurrency)
+     * @param[in] aSeed                     Seed for random number generator
+     * @param[in] anInitialStateDispersion  Standard deviation of initial state components
+     *                                                                          [km; km s^-1]
+     * @param[in] anEnsembleFilename        Filename for ensemble output
+     */
+    EnsembleSettings( const bool            aStatus,
+                      const unsigned int    aNumberOfSamples,
+                      const unsigned int    aNumberOfThreads,
+                      const unsigned int    aSeed,
+                      const State&          anInitialStateDispersion,
+                      const std::string&    anEnsembleFilename )
+        : status( aStatus ),
+          numberOfSamples( aNumberOfSamples ),
+          numberOfThreads( aNumberOfThreads ),
+          seed( aSeed ),
+          initialStateDispersion( anInitialStateDispersion ),
+          ensembleFilename( anEnsembleFilename )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Number of ensemble members.
+    const unsigned int numberOfSamples;
+
+    //! Number of worker threads (0 = hardware concurrency).
+    const unsigned int numberOfThreads;
+
+    //! Seed for random number generator.
+    const unsigned int seed;
+
+    //! Standard deviation of initial state components [km; km s^-1].
+    const State initialStateDispersion;
+
+    //! Ensemble output filename.
+    const std::string ensembleFilename;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_ENSEMBLE_SETTINGS_HPP
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_EPHEMERIS_HPP
+#define SCARAB_EPHEMERIS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Version of binary ephemeris file format.
+const unsigned int ephemerisFileVersion = 1;
+
+//! Ephemeris body.
+/*!
+ * Data struct containing the Chebyshev approximation of the position of a single body with
+ * respect to the central body. The time span of the ephemeris is divided into segments of equal
+ * duration; within each segment, each position component is given by a Chebyshev series
+ *
+ *  x(t) = sum_{k = 0}^{n - 1} c_k T_k( tau ),  tau = 2 ( t - t_i ) / dt - 1,
+ *
+ * where t_i is the start time of the segment and dt the segment duration. A time on the boundary
+ * between two segments belongs to the later one. The coefficients are stored per segment, as n
+ * coefficients for x, followed by n for y and n for z.
+ */
+struct EphemerisBody
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct. The coefficients are not copied.
+     *
+     * @param[in] aName                     Name of body
+     * @param[in] aGravitationalParameter   Gravitational parameter of body         [km^3 s^-2]
+     * @param[in] aStartTime                Start time of first segment             [s]
+     * @param[in] aSegmentDuration          Duration of segments                    [s]
+     * @param[in] aNumberOfSegments         Number of segments
+     * @param[in] aNumberOfCoefficients     Number of coefficients per component and segment
+     * @param[in] someCoefficients          Pointer to coefficients of all segments [km]
+     */
+    EphemerisBody( const std::string& aName,
+                   const double aGravitationalParameter,
+                   const double aStartTime,
+                   const double aSegmentDuration,
+                   const std::size_t aNumberOfSegments,
+                   const std::size_t aNumberOfCoefficients,
+                   const double* someCoefficients )
+        : name( aName ),
+          gravitationalParameter( aGravitationalParameter ),
+          startTime( aStartTime ),
+          segmentDuration( aSegmentDuration ),
+          numberOfSegments( aNumberOfSegments ),
+          numberOfCoefficients( aNumberOfCoefficients ),
+          coefficients( someCoefficients )
+    { }
+
+    //! Get end time.
+    /*!
+     * Returns end time of last segment.
+     *
+     * @return End time                                                         [s]
+     */
+    double getEndTime( ) const { return startTime + segmentDuration * numberOfSegments; }
+
+    //! Name of body.
+    std::string name;
+
+    //! Gravitational parameter of body [km^3 s^-2].
+    double gravitationalParameter;
+
+    //! Start time of first segment [s].
+    double startTime;
+
+    //! Duration of segments [s].
+    double segmentDuration;
+
+    //! Number of segments.
+    std::size_t numberOfSegments;
+
+    //! Number of coefficients per component and segment.
+    std::size_t numberOfCoefficients;
+
+    //! Pointer to coefficients of all segments [km].
+    const double* coefficients;
+
+protected:
+
+private:
+};
+
+//! Write Chebyshev ephemeris file.
+/*!
+ * Writes bodies to a binary ephemeris file. The file format (version 1) is:
+ *
+ *  - bytes 0-7: magic string "SCARABEP";
+ *  - bytes 8-11: format version (uint32);
+ *  - bytes 12-15: length of header in bytes (uint32);
+ *  - bytes 16-23: total number of coefficients in data (uint64);
+ *  - header: JSON object containing "bodies" (array of objects with "name",
+ *    "gravitational_parameter", "start_time", "segment_duration", "number_of_segments",
+ *    "number_of_coefficients" and "offset", i.e., the index of the first coefficient of the body
+ *    in the data), padded with spaces such that the data starts at a multiple of 64 bytes;
+ *  - data: coefficients of all bodies, stored as doubles.
+ *
+ * All numbers are stored little-endian. Ephemeris files are normally generated offline with
+ * python/ephemeris.py; this function is mainly used for testing.
+ *
+ * @sa ChebyshevEphemeris
+ * @param[in] filename  Ephemeris filename
+ * @param[in] bodies    Bodies to write
+ */
+void writeChebyshevEphemeris( const std::string& filename,
+                              const std::vector< EphemerisBody >& bodies );
+
+//! Chebyshev ephemeris.
+/*!
+ * Reader for binary ephemeris files (see writeChebyshevEphemeris()). The file is memory mapped
+ * once on construction, so that the coefficients are accessed directly, without copying or
+ * parsing the data. Times are given in the same time scale as the start time of the simulation.
+ *
+ * Since all segments of a body have the same duration, the segment containing a given time is
+ * found in constant time. In addition, every thread caches the last segment used per body, so
+ * that the repeated calls made from the acceleration models within a step of the numerical
+ * integrator skip the lookup altogether. The position is evaluated from the Chebyshev series
+ * using Clenshaw's recurrence.
+ *
+ * @sa writeChebyshevEphemeris
+ */
+class ChebyshevEphemeris
+{
+public:
+
+    //! Construct ephemeris.
+    /*!
+     * Constructs ephemeris by memory mapping the ephemeris file and parsing its header. An error
+     * is thrown if the file is not a valid ephemeris file or has an unsupported version.
+     *
+     * @param[in] filename Ephemeris filename
+     */
+    explicit ChebyshevEphemeris( const std::string& filename );
+
+    //! Get number of bodies.
+    /*!
+     * Returns number of bodies in ephemeris file.
+     *
+     * @return Number of bodies
+     */
+    std::size_t getNumberOfBodies( ) const { return bodies.size( ); }
+
+    //! Get body.
+    /*!
+     * Returns body at given index, with coefficients mapped from file.
+     *
+     * @param[in] bodyIndex Index of body
+     * @return              Ephemeris body
+     */
+    const EphemerisBody& getBody( const std::size_t bodyIndex ) const
+    {
+        return bodies.at( bodyIndex );
+    }
+
+    //! Find body.
+    /*!
+     * Returns index of body with given name. An error is thrown if the body does not exist.
+     *
+     * @param[in] bodyName Name of body
+     * @return             Index of body
+     */
+    std::size_t findBody( const std::string& bodyName ) const;
+
+    //! Get position.
+    /*!
+     * Computes position of body with respect to central body at given time. An error is thrown if
+     * the time lies outside of the time span of the body.
+     *
+     * @param[in] bodyIndex Index of body
+     * @param[in] time      Time                                                [s]
+     * @return              Position of body                                    [km]
+     */
+    Position getPosition( const std::size_t bodyIndex, const double time ) const;
+
+protected:
+
+private:
+
+    //! Mapped ephemeris file.
+    boost::interprocess::file_mapping file;
+
+    //! Mapped region of ephemeris file.
+    boost::interprocess::mapped_region region;
+
+    //! Bodies in ephemeris file.
+    std::vector< EphemerisBody > bodies;
+
+    //! Unique identifier of ephemeris, used to key per-thread segment cache.
+    const std::size_t identifier;
+};
+
+//! Pointer to Chebyshev ephemeris.
+typedef boost::shared_ptr< const ChebyshevEphemeris > ChebyshevEphemerisPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_EPHEMERIS_HPP
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_EPHEMERIS_SETTINGS_HPP
+#define SCARAB_EPHEMERIS_SETTINGS_HPP
+
+#include <string>
+
+#include "Scarab/ephemeris.hpp"
+
+namespace scarab
+{
+
+//! Ephemeris settings.
+/*!
+ * Data struct containing the ephemeris used by the third-body gravity and radiation pressure
+ * models. This struct is populated by the checkSimulatorSettings() function, which also maps the
+ * ephemeris file, if set, so that it is loaded once and shared by all models, also for ensembles.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, ChebyshevEphemeris
+ */
+struct EphemerisSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] anEphemerisFilename   Name of ephemeris file; empty if not set
+     * @param[in] anEphemeris           Ephemeris mapped from file; not set if filename is empty
+     */
+    EphemerisSettings( const std::string&           anEphemerisFilename,
+                       const ChebyshevEphemerisPtr& anEphemeris )
+        : ephemerisFilename( anEphemerisFilename ),
+          ephemeris( anEphemeris )
+    { }
+
+    //! Name of ephemeris file; empty if not set.
+    const std::string ephemerisFilename;
+
+    //! Ephemeris mapped from file; not set if filename is empty.
+    const ChebyshevEphemerisPtr ephemeris;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_EPHEMERIS_SETTINGS_HPP
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_EVENT_DETECTOR_HPP
+#define SCARAB_EVENT_DETECTOR_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/eventFunction.hpp"
+#include "Scarab/eventSettings.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Event occurrence.
+/*!
+ * Data struct containing a single entry of the event log.
+ */
+struct EventOccurrence
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct for an event that was triggered.
+     *
+     * @param[in] aName     Name of event
+     * @param[in] aTime     Time of event                                       [s]
+     * @param[in] aState    State at event                                      [km; km s^-1]
+     * @param[in] anAction  Action taken
+     * @param[in] aPhase    Phase in which event was triggered
+     */
+    EventOccurrence( const std::string& aName,
+                     const double aTime,
+                     const State& aState,
+                     const EventAction anAction,
+                     const std::string& aPhase )
+        : name( aName ),
+          time( aTime ),
+          state( aState ),
+          action( anAction ),
+          phase( aPhase )
+    { }
+
+    //! Name of event.
+    std::string name;
+
+    //! Time of event [s].
+    double time;
+
+    //! State at event [km; km s^-1].
+    State state;
+
+    //! Action taken.
+    EventAction action;
+
+    //! Phase in which event was triggered.
+    std::string phase;
+
+protected:
+
+private:
+};
+
+//! Event log, in chronological order.
+typedef std::vector< EventOccurrence > EventLog;
+
+//! Get event action name.
+/*!
+ * Gets name of event action, as used in the configuration file.
+ *
+ * @param[in] action Event action
+ * @return           Name of event action
+ */
+std::string getEventActionName( const EventAction action );
+
+//! Write event log.
+/*!
+ * Writes event log to stream in Comma-Separated Value (CSV) format, with one row per event.
+ *
+ * @param[in] stream    Output stream
+ * @param[in] eventLog  Event log
+ */
+void writeEventLog( std::ostream& stream, const EventLog& eventLog );
+
+//! Event detector.
+/*!
+ * Event detector that checks every accepted integration step for zero crossings of the event
+ * functions set. A crossing is detected from the sign of an event function at the start and end
+ * of the step; the time of the crossing is then located by root-finding (TOMS 748) on the state
+ * interpolated within the step, so that events are located to round-off precision without
+ * shortening the steps of the integrator.
+ *
+ * The events within a step are handled in chronological order: every event is logged, and
+ * depending on its action, the integration is terminated at the event or the phase is switched.
+ * Events can be restricted to a phase, so that, e.g., a distance event is only active once the
+ * approach phase has been entered.
+ *
+ * Since crossings are detected from the signs at the ends of a step only, an event function that
+ * crosses zero twice within one step, e.g., a brief excursion through a distance threshold, has
+ * the same sign at both ends and the crossings are missed. The maximum step of the integrator
+ * bounds this: excursions that last longer than the maximum step are always detected.
+ *
+ * The event functions are evaluated on the absolute state of the chaser, so that events are only
+ * available for the numerical integration of the absolute state; range and approach corridor
+ * events relative to the target are not available, and events cannot be combined with relative
+ * motion or Encke propagation.
+ *
+ * @sa integrateState, EventSettings
+ */
+class EventDetector
+{
+public:
+
+    //! Construct event detector.
+    /*!
+     * Constructs event detector, with the event functions defined in the event settings.
+     *
+     * @param[in] settings Event settings
+     */
+    EventDetector( const EventSettings& settings );
+
+    //! Initialize event detector.
+    /*!
+     * Evaluates all event functions at the start of the integration.
+     *
+     * @param[in] state Initial state                                           [km; km s^-1]
+     * @param[in] time  Start time                                              [s]
+     */
+    void initialize( const State& state, const double time );
+
+    //! Detect events within integration step.
+    /*!
+     * Detects, locates and handles all events within an accepted integration step.
+     *
+     * @param[in] step  Accepted integration step
+     * @return          True if the integration is terminated by an event in this step
+     */
+    bool detectEvents( const IntegrationStep& step );
+
+    //! Check if integration is terminated.
+    /*!
+     * Checks if the integration has been terminated by an event.
+     *
+     * @return True if terminated
+     */
+    bool isTerminated( ) const { return terminated; }
+
+    //! Get termination time.
+    /*!
+     * Returns time of the event that terminated the integration.
+     *
+     * @return Termination time                                                 [s]
+     */
+    double getTerminationTime( ) const { return terminationTime; }
+
+    //! Get termination state.
+    /*!
+     * Returns state at the event that terminated the integration.
+     *
+     * @return Termination state                                                [km; km s^-1]
+     */
+    const State& getTerminationState( ) const { return terminationState; }
+
+    //! Get current phase.
+    /*!
+     * Returns current phase.
+     *
+     * @return Current phase
+     */
+    const std::string& getPhase( ) const { return phase; }
+
+    //! Get event log.
+    /*!
+     * Returns log of all events triggered, in chronological order.
+     *
+     * @return Event log
+     */
+    const EventLog& getEventLog( ) const { return eventLog; }
+
+    //! Write checkpoint.
+    /*!
+     * Writes values of event functions, current phase and event log to checkpoint.
+     *
+     * @sa restoreCheckpoint
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void writeCheckpoint( Checkpoint& checkpoint ) const;
+
+    //! Restore checkpoint.
+    /*!
+     * Restores values of event functions, current phase and event log from checkpoint, instead of
+     * initializing the event detector.
+     *
+     * @sa writeCheckpoint
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void restoreCheckpoint( Checkpoint& checkpoint );
+
+protected:
+
+private:
+
+    //! Check if event is active in current phase.
+    bool isActive( const std::size_t eventIndex ) const;
+
+    //! Event definitions.
+    const ListOfEventDefinitions listOfEventDefinitions;
+
+    //! Event functions, in the order of the event definitions.
+    std::vector< EventFunctionPtr > listOfEventFunctions;
+
+    //! Values of event functions at the end of the last step.
+    std::vector< double > values;
+
+    //! Values of event functions at the end of the current step.
+    std::vector< double > endValues;
+
+    //! Current phase.
+    std::string phase;
+
+    //! Event log.
+    EventLog eventLog;
+
+    //! Flag indicating if integration is terminated.
+    bool terminated;
+
+    //! Termination time [s].
+    double terminationTime;
+
+    //! Termination state [km; km s^-1].
+    State terminationState;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_EVENT_DETECTOR_HPP
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_EVENT_FUNCTION_HPP
+#define SCARAB_EVENT_FUNCTION_HPP
+
+#include <cmath>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Event function.
+/*!
+ * Event function base class. An event function is a scalar function of state and time, whose zero
+ * crossings mark events, e.g., a range threshold being crossed or impact on the central body.
+ */
+class EventFunction
+{
+public:
+
+    //! Evaluate event function.
+    /*!
+     * Evaluates event function by overloading ()-operator.
+     *
+     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time                                            [s]
+     * @return          Value of event function
+     */
+    virtual double operator( )( const State& state, const double time ) const = 0;
+
+    //! Default destructor.
+    /*!
+     * Calls default (virtual) destructor.
+     */
+    virtual ~EventFunction( ) { }
+
+protected:
+
+private:
+};
+
+//! Pointer to event function.
+typedef boost::shared_ptr< EventFunction > EventFunctionPtr;
+
+//! Distance event function.
+/*!
+ * Event function equal to the distance of the position from a reference point, minus a threshold.
+ * With the reference point at the origin, this detects, e.g., impact on the central body; with
+ * the reference point at the target, it detects range thresholds.
+ */
+class DistanceEventFunction : public EventFunction
+{
+public:
+
+    //! Construct event function.
+    /*!
+     * Constructs distance event function.
+     *
+     * @param[in] aReferencePoint   Reference point                             [km]
+     * @param[in] aThreshold        Distance threshold                          [km]
+     */
+    DistanceEventFunction( const Position& aReferencePoint, const double aThreshold )
+        : referencePoint( aReferencePoint ),
+          threshold( aThreshold )
+    { }
+
+    //! Evaluate event function.
+    /*!
+     * Evaluates distance of position from reference point minus threshold.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time (unused)                                   [s]
+     * @return          Distance minus threshold                                [km]
+     */
+    double operator( )( const State& state, const double /* time */ ) const
+    {
+        const double dx = state[ 0 ] - referencePoint[ 0 ];
+        const double dy = state[ 1 ] - referencePoint[ 1 ];
+        const double dz = state[ 2 ] - referencePoint[ 2 ];
+        return std::sqrt( dx * dx + dy * dy + dz * dz ) - threshold;
+    }
+
+protected:
+
+private:
+
+    //! Reference point [km].
+    const Position referencePoint;
+
+    //! Distance threshold [km].
+    const double threshold;
+};
+
+//! State component event function.
+/*!
+ * Event function equal to a state component minus a threshold, e.g., to detect the crossing of a
+ * plane or the violation of an approach corridor.
+ */
+class StateComponentEventFunction : public EventFunction
+{
+public:
+
+    //! Construct event function.
+    /*!
+     * Constructs state component event function.
+     *
+     * @param[in] aStateComponent   Index of state component (0 = x, ..., 5 = vz)
+     * @param[in] aThreshold        Threshold                                   [km; km s^-1]
+     */
+    StateComponentEventFunction( const unsigned int aStateComponent, const double aThreshold )
+        : stateComponent( aStateComponent ),
+          threshold( aThreshold )
+    { }
+
+    //! Evaluate event function.
+    /*!
+     * Evaluates state component minus threshold.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time (unused)                                   [s]
+     * @return          State component minus threshold                         [km; km s^-1]
+     */
+    double operator( )( const State& state, const double /* time */ ) const
+    {
+        return state[ stateComponent ] - threshold;
+    }
+
+protected:
+
+private:
+
+    //! Index of state component.
+    const unsigned int stateComponent;
+
+    //! Threshold [km; km s^-1].
+    const double threshold;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_EVENT_FUNCTION_HPP
@@ -10,6 +10,7 @@
 #ifndef SCARAB_EVENT_MANAGER_HPP
 #define SCARAB_EVENT_MANAGER_HPP
 
+#include "Scarab/stateHistorySink.hpp"
 #include "Scarab/typedefs.hpp"
 
 namespace scarab
@@ -17,7 +18,10 @@ namespace scarab
 
 //! Event manager.
 /*!
- * Event manager that executes after each step taken by the numerical integrator.
+ * Event manager that executes after each step taken by the numerical integrator. The state after
+ * each step is passed on to a state history sink, which either records or streams it.
+ *
+ * @sa StateHistorySink
  */
 class EventManager
 {
@@ -27,10 +31,10 @@ public:
     /*!
      * Calls default constructor.
      *
-     * @param[in] aStateHistory State history (key=epoch, value=State)
+     * @param[in] aStateHistorySink State history sink
      */
-    EventManager( StateHistory& aStateHistory )
-        : stateHistory( aStateHistory )
+    EventManager( StateHistorySink& aStateHistorySink )
+        : stateHistorySink( aStateHistorySink )
     { }
 
     //! Execute event manager.
@@ -42,11 +46,11 @@ public:
      */
     void operator( )( const State& state, const double time )
     {
-        stateHistory[ time ] = state;
+        stateHistorySink.write( time, state );
     }
 
-    //! State history (key=epoch, value=State)
-    StateHistory& stateHistory;
+    //! State history sink.
+    StateHistorySink& stateHistorySink;
 
 protected:
 
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_EVENT_SETTINGS_HPP
+#define SCARAB_EVENT_SETTINGS_HPP
+
+#include <string>
+#include <vector>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Event function type.
+enum EventType
+{
+    //! Distance from a reference point crossing a threshold.
+    distanceEventType,
+    //! State component crossing a threshold.
+    stateComponentEventType
+};
+
+//! Direction of zero crossing of event function that triggers an event.
+enum EventDirection
+{
+    risingEventDirection,
+    fallingEventDirection,
+    anyEventDirection
+};
+
+//! Action taken when an event is triggered.
+enum EventAction
+{
+    //! Log event and continue.
+    logEventAction,
+    //! Log event and terminate integration at the event.
+    terminateEventAction,
+    //! Log event and switch to another phase.
+    switchPhaseEventAction
+};
+
+//! Event definition.
+/*!
+ * Data struct containing all valid input parameters that define a single event. An event is
+ * triggered when its event function crosses zero in the direction set. The event function is
+ * either the distance of the position from a reference point, or a state component, minus a
+ * threshold.
+ *
+ * @sa EventSettings, EventDetector
+ */
+struct EventDefinition
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, EventSettings
+     * @param[in] aName             Name of event
+     * @param[in] aType             Event function type
+     * @param[in] aThreshold        Threshold                              [km; km s^-1]
+     * @param[in] aReferencePoint   Reference point (distance events only)  [km]
+     * @param[in] aStateComponent   Index of state component (state component events only)
+     * @param[in] aDirection        Direction of zero crossing that triggers event
+     * @param[in] anAction          Action taken when event is triggered
+     * @param[in] aPhase            Phase in which event is active (empty = all phases)
+     * @param[in] aNextPhase        Phase switched to (switch phase action only)
+     */
+    EventDefinition( const std::string&     aName,
+                     const EventType        aType,
+                     const double           aThreshold,
+                     const Position&        aReferencePoint,
+                     const unsigned int     aStateComponent,
+                     const EventDirection   aDirection,
+                     const EventAction      anAction,
+                     const std::string&     aPhase,
+                     const std::string&     aNextPhase )
+        : name( aName ),
+          type( aType ),
+          threshold( aThreshold ),
+          referencePoint( aReferencePoint ),
+          stateComponent( aStateComponent ),
+          direction( aDirection ),
+          action( anAction ),
+          phase( aPhase ),
+          nextPhase( aNextPhase )
+    { }
+
+    //! Name of event.
+    const std::string name;
+
+    //! Event function type.
+    const EventType type;
+
+    //! Threshold [km; km s^-1].
+    const double threshold;
+
+    //! Reference point (distance events only) [km].
+    const Position referencePoint;
+
+    //! Index of state component (state component events only).
+    const unsigned int stateComponent;
+
+    //! Direction of zero crossing that triggers event.
+    const EventDirection direction;
+
+    //! Action taken when event is triggered.
+    const EventAction action;
+
+    //! Phase in which event is active (empty = all phases).
+    const std::string phase;
+
+    //! Phase switched to (switch phase action only).
+    const std::string nextPhase;
+
+protected:
+
+private:
+};
+
+//! List of event definitions.
+typedef std::vector< EventDefinition > ListOfEventDefinitions;
+
+//! Event settings.
+/*!
+ * Data struct containing all valid input parameters for event detection. This struct is populated
+ * by the checkSimulatorSettings() function.
+ *
+ * @sa checkSimulatorSettings, EventDetector
+ */
+struct EventSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, EventDetector
+     * @param[in] anInitialPhase            Phase at start time
+     * @param[in] anEventFilename           Filename for event log (empty = not written)
+     * @param[in] aListOfEventDefinitions   List of event definitions
+     */
+    EventSettings( const std::string&               anInitialPhase,
+                   const std::string&               anEventFilename,
+                   const ListOfEventDefinitions&    aListOfEventDefinitions )
+        : initialPhase( anInitialPhase ),
+          eventFilename( anEventFilename ),
+          listOfEventDefinitions( aListOfEventDefinitions )
+    { }
+
+    //! Phase at start time.
+    const std::string initialPhase;
+
+    //! Event log filename (empty = not written).
+    const std::string eventFilename;
+
+    //! List of event definitions.
+    const ListOfEventDefinitions listOfEventDefinitions;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_EVENT_SETTINGS_HPP
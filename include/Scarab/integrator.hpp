@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_INTEGRATOR_HPP
+#define SCARAB_INTEGRATOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/integratorSettings.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Integration statistics.
+/*!
+ * Data struct containing the cost of a numerical integration, used to compare integrators and
+ * tolerances for a given scenario, the range of step sizes taken, and the time at which the
+ * integration ended.
+ */
+struct IntegrationStatistics
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all counters set to zero.
+     */
+    IntegrationStatistics( )
+        : numberOfFunctionEvaluations( 0 ),
+          numberOfAcceptedSteps( 0 ),
+          numberOfRejectedSteps( 0 ),
+          minimumStepSize( 0.0 ),
+          maximumStepSize( 0.0 ),
+          nextStepSize( 0.0 ),
+          finalTime( 0.0 )
+    { }
+
+    //! Number of evaluations of the state derivative model.
+    std::size_t numberOfFunctionEvaluations;
+
+    //! Number of steps accepted.
+    std::size_t numberOfAcceptedSteps;
+
+    //! Number of steps rejected by the step size controller.
+    std::size_t numberOfRejectedSteps;
+
+    //! Size of smallest accepted step; zero if no step was accepted [s].
+    double minimumStepSize;
+
+    //! Size of largest accepted step; zero if no step was accepted [s].
+    double maximumStepSize;
+
+    //! Step size suggested after last accepted step; zero for fixed-step integrators [s].
+    double nextStepSize;
+
+    //! Time at which integration ended, i.e., end time or time of terminating event [s].
+    double finalTime;
+
+protected:
+
+private:
+};
+
+//! Accumulate integration statistics.
+/*!
+ * Adds the counters of the integration statistics of a single integration, e.g., of an ensemble
+ * member, to the total statistics, and widens the range of step sizes of the total statistics to
+ * include the steps of the integration. The final time of the total statistics is not changed.
+ *
+ * @param[in]     statistics      Integration statistics of single integration
+ * @param[in,out] totalStatistics Total integration statistics
+ */
+void accumulateIntegrationStatistics( const IntegrationStatistics& statistics,
+                                      IntegrationStatistics& totalStatistics );
+
+//! Observer called with the state and time after every accepted integration step.
+typedef std::function< void( const State&, const double ) > IntegratorObserver;
+
+//! State derivative function, with the same signature as StateDerivativeModel::operator( ).
+typedef std::function< void( const State&, State&, const double ) > StateDerivativeFunction;
+
+//! Get numerical integrator type.
+/*!
+ * Gets numerical integrator type from its name in the configuration file. An error is thrown if
+ * the name is not known.
+ *
+ * @sa getIntegratorName
+ * @param[in] integratorName Name of numerical integrator, e.g., "dopri5"
+ * @return                   Numerical integrator type
+ */
+IntegratorType getIntegratorType( const std::string& integratorName );
+
+//! Get numerical integrator name.
+/*!
+ * Gets name of numerical integrator type, as used in the configuration file.
+ *
+ * @sa getIntegratorType
+ * @param[in] integrator Numerical integrator type
+ * @return               Name of numerical integrator
+ */
+std::string getIntegratorName( const IntegratorType integrator );
+
+//! Interpolate state within integration step.
+/*!
+ * Interpolates state within an integration step, from the states and state derivatives at the
+ * start and end of the step. The position is interpolated with a quintic Hermite polynomial that
+ * matches position, velocity and acceleration at both ends of the step; the velocity is the
+ * derivative of this polynomial. The interpolation error is of order 6 in the step size for the
+ * position and of order 5 for the velocity, so it does not degrade the accuracy of the
+ * integrators available.
+ *
+ * @param[in] time                  Time at which state is interpolated             [s]
+ * @param[in] startTime             Start time of step                              [s]
+ * @param[in] startState            State at start of step                          [km; km s^-1]
+ * @param[in] startStateDerivative  State derivative at start of step    [km s^-1; km s^-2]
+ * @param[in] endTime               End time of step                                [s]
+ * @param[in] endState              State at end of step                            [km; km s^-1]
+ * @param[in] endStateDerivative    State derivative at end of step      [km s^-1; km s^-2]
+ * @return                          Interpolated state                              [km; km s^-1]
+ */
+State interpolateState( const double time,
+                        const double startTime,
+                        const State& startState,
+                        const State& startStateDerivative,
+                        const double endTime,
+                        const State& endState,
+                        const State& endStateDerivative );
+
+//! Integration step.
+/*!
+ * Data struct containing the states and state derivatives at the start and end of an accepted
+ * integration step, from which the state anywhere within the step can be interpolated.
+ *
+ * @sa interpolateState
+ */
+struct IntegrationStep
+{
+public:
+
+    //! Interpolate state within step.
+    /*!
+     * Interpolates state within step.
+     *
+     * @sa interpolateState
+     * @param[in] time  Time within step                                        [s]
+     * @return          Interpolated state                                      [km; km s^-1]
+     */
+    State interpolate( const double time ) const
+    {
+        return interpolateState( time,
+                                 startTime,
+                                 startState,
+                                 startStateDerivative,
+                                 endTime,
+                                 endState,
+                                 endStateDerivative );
+    }
+
+    //! Start time of step [s].
+    double startTime;
+
+    //! State at start of step [km; km s^-1].
+    State startState;
+
+    //! State derivative at start of step [km s^-1; km s^-2].
+    State startStateDerivative;
+
+    //! End time of step [s].
+    double endTime;
+
+    //! State at end of step [km; km s^-1].
+    State endState;
+
+    //! State derivative at end of step [km s^-1; km s^-2].
+    State endStateDerivative;
+
+protected:
+
+private:
+};
+
+//! Integrator checkpoint.
+/*!
+ * Data struct containing the state of a numerical integration after an accepted step, from which
+ * the integration can be resumed with exactly the same steps as if it had not been interrupted.
+ *
+ * @sa integrateState, IntegratorCheckpointHandler
+ */
+struct IntegratorCheckpoint
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all values set to zero.
+     */
+    IntegratorCheckpoint( )
+        : time( 0.0 ),
+          stepSize( 0.0 ),
+          numberOfSteps( 0 ),
+          outputEpochIndex( 0 )
+    {
+        state.fill( 0.0 );
+        stateDerivative.fill( 0.0 );
+    }
+
+    //! Time at end of last accepted step [s].
+    double time;
+
+    //! State at end of last accepted step [km; km s^-1].
+    State state;
+
+    //! State derivative at end of last accepted step [km s^-1; km s^-2].
+    State stateDerivative;
+
+    //! Size of next step, as suggested by the step size controller [s].
+    double stepSize;
+
+    //! Number of steps taken (fixed-step integrators only).
+    std::size_t numberOfSteps;
+
+    //! Integration statistics up to last accepted step.
+    IntegrationStatistics statistics;
+
+    //! Index of next output epoch.
+    std::size_t outputEpochIndex;
+
+    //! History of state derivatives kept by multistep integrators, most recent first.
+    std::vector< State > multistepStateDerivatives;
+
+protected:
+
+private:
+};
+
+//! Write integrator checkpoint.
+/*!
+ * Appends integrator checkpoint to checkpoint.
+ *
+ * @sa readIntegratorCheckpoint
+ * @param[in]     integratorCheckpoint  Integrator checkpoint
+ * @param[in,out] checkpoint            Checkpoint
+ */
+void writeIntegratorCheckpoint( const IntegratorCheckpoint& integratorCheckpoint,
+                                Checkpoint& checkpoint );
+
+//! Read integrator checkpoint.
+/*!
+ * Reads integrator checkpoint from checkpoint.
+ *
+ * @sa writeIntegratorCheckpoint
+ * @param[in,out] checkpoint Checkpoint
+ * @return                   Integrator checkpoint
+ */
+IntegratorCheckpoint readIntegratorCheckpoint( Checkpoint& checkpoint );
+
+//! Integrator checkpoint handler.
+/*!
+ * Checkpoint handler base class. The numerical integrator asks the handler after every accepted
+ * step whether a checkpoint is due and, if so, passes it the integrator checkpoint, to which the
+ * handler adds the state of the rest of the simulation before writing it.
+ *
+ * @sa integrateState, IntegratorCheckpoint
+ */
+class IntegratorCheckpointHandler
+{
+public:
+
+    //! Check if checkpoint is due.
+    /*!
+     * Checks if a checkpoint is due. This is called after every accepted step, so it must be
+     * cheap.
+     *
+     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     *
+     * @return True if checkpoint is due
+     */
+    virtual bool isCheckpointDue( ) = 0;
+
+    //! Write checkpoint.
+    /*!
+     * Writes checkpoint, given the state of the numerical integration.
+     *
+     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     *
+     * @param[in] integratorCheckpoint Integrator checkpoint
+     */
+    virtual void writeCheckpoint( const IntegratorCheckpoint& integratorCheckpoint ) = 0;
+
+    //! Default destructor.
+    /*!
+     * Calls default (virtual) destructor.
+     */
+    virtual ~IntegratorCheckpointHandler( ) { }
+
+protected:
+
+private:
+};
+
+class EventDetector;
+
+//! Integrate state.
+/*!
+ * Integrates state from start time to end time with the numerical integrator set, using the
+ * Boost odeint steppers (K. Ahnert and M. Mulansky, 2011):
+ *  - rk4: 4th-order Runge-Kutta, fixed step
+ *  - dopri5: Dormand-Prince 5(4), adaptive step
+ *  - cash_karp54: Cash-Karp 5(4), adaptive step
+ *  - fehlberg78: Runge-Kutta-Fehlberg 7(8), adaptive step
+ *  - bulirsch_stoer: Bulirsch-Stoer extrapolation, adaptive step and order
+ *  - adams_bashforth_moulton: 5th-order Adams-Bashforth-Moulton predictor-corrector, fixed step
+ *
+ * Fixed-step integrators take equal steps no larger than the initial step and the maximum step,
+ * such that the last step ends exactly at the end time. Adaptive integrators start with the
+ * initial step and control the step size to meet the absolute and relative tolerances; steps are
+ * limited to the maximum step, and the last step is shortened to end exactly at the end time.
+ *
+ * By default, the observer is called for the initial state and after every accepted step. If an
+ * output interval or a list of output epochs is given, the observer is instead called at the
+ * start time plus multiples of the output interval, or at the output epochs, that lie within
+ * [start time, end time]. The states at these epochs are interpolated within the accepted steps
+ * (dense output), so the output grid has no effect on the steps taken by the integrator. The
+ * interpolation error grows with the step size; for integrators that take very long steps, such
+ * as bulirsch_stoer, the maximum step can be used to bound it.
+ *
+ * If an event detector is given, every accepted step is checked for events. If an event
+ * terminates the integration, the state is returned at the event, and the observer is called up
+ * to the event only.
+ *
+ * If a checkpoint handler is given, it is asked after every accepted step, except the last one,
+ * whether a checkpoint is due. If an initial checkpoint is given, the integration is resumed from
+ * it instead of started from the initial state: the observer is not called for the initial state
+ * and the event detector is not initialized, so the event detector must be restored from the
+ * same checkpoint. The resumed integration takes exactly the same steps as the original one.
+ * Checkpoints are not supported for bulirsch_stoer, since its step size and order controller
+ * cannot be restored; for adams_bashforth_moulton, checkpoints are only written once the history
+ * of the multistep method is complete.
+ *
+ * @sa interpolateState, EventDetector, IntegratorCheckpoint
+ * @param[in]     settings              Numerical integrator settings
+ * @param[in]     stateDerivativeModel  State derivative model
+ * @param[in,out] state                 State at start time; on return at end time [km; km s^-1]
+ * @param[in]     observer              Observer (optional)
+ * @param[in]     outputInterval        Time interval between calls to observer; zero to call
+ *                                      observer after every step (optional)        [s]
+ * @param[in]     outputEpochs          Epochs at which to call observer, in ascending order
+ *                                      (optional)                                  [s]
+ * @param[in,out] eventDetector         Event detector (optional)
+ * @param[in,out] checkpointHandler     Checkpoint handler (optional)
+ * @param[in]     initialCheckpoint     Checkpoint to resume integration from (optional)
+ * @return                              Integration statistics
+ */
+IntegrationStatistics integrateState(
+    const IntegratorSettings& settings,
+    const StateDerivativeModel& stateDerivativeModel,
+    State& state,
+    const IntegratorObserver& observer = IntegratorObserver( ),
+    const double outputInterval = 0.0,
+    const std::vector< double >& outputEpochs = std::vector< double >( ),
+    EventDetector* eventDetector = 0,
+    IntegratorCheckpointHandler* checkpointHandler = 0,
+    const IntegratorCheckpoint* initialCheckpoint = 0 );
+
+//! Integrate state with state derivative function.
+/*!
+ * Integrates state as integrateState( ) above, for equations of motion that are not given by a
+ * StateDerivativeModel, e.g., the equations of motion of the deviation from a reference
+ * trajectory in Encke's method. The function is called through std::function, so the
+ * StateDerivativeModel overload is preferred where possible.
+ *
+ * @sa integrateState, EnckeStateDerivativeModel
+ * @param[in]     settings                  Numerical integrator settings
+ * @param[in]     stateDerivativeFunction   State derivative function
+ * @param[in,out] state                     State at start time; on return at end time
+ * @param[in]     observer                  Observer (optional)
+ * @param[in]     outputInterval            Time interval between calls to observer; zero to call
+ *                                          observer after every step (optional)    [s]
+ * @param[in]     outputEpochs              Epochs at which to call observer, in ascending
+ *                                          order (optional)                        [s]
+ * @param[in,out] eventDetector             Event detector (optional)
+ * @param[in,out] checkpointHandler         Checkpoint handler (optional)
+ * @param[in]     initialCheckpoint         Checkpoint to resume integration from (optional)
+ * @return                                  Integration statistics
+ */
+IntegrationStatistics integrateState(
+    const IntegratorSettings& settings,
+    const StateDerivativeFunction& stateDerivativeFunction,
+    State& state,
+    const IntegratorObserver& observer = IntegratorObserver( ),
+    const double outputInterval = 0.0,
+    const std::vector< double >& outputEpochs = std::vector< double >( ),
+    EventDetector* eventDetector = 0,
+    IntegratorCheckpointHandler* checkpointHandler = 0,
+    const IntegratorCheckpoint* initialCheckpoint = 0 );
+
+} // namespace scarab
+
+#endif // SCARAB_INTEGRATOR_HPP
+
+/*!
+ * K. Ahnert and M. Mulansky, Odeint - Solving Ordinary Differential Equations in C++, AIP Conf.
+ *  Proc. 1389, pp. 1586-1589 (2011), doi:http://dx.doi.org/10.1063/1.3637934.
+ */
@@ -15,6 +15,17 @@
 namespace scarab
 {
 
+//! Numerical integrator type.
+enum IntegratorType
+{
+    rungeKutta4Integrator,
+    dormandPrince5Integrator,
+    cashKarp54Integrator,
+    fehlberg78Integrator,
+    bulirschStoerIntegrator,
+    adamsBashforthMoultonIntegrator
+};
+
 //! Numerical integrator settings.
 /*!
  * Data struct containing all valid settings parameters for the numerical integrator. This struct
@@ -35,15 +46,27 @@ public:
      * @param[in] aStartTime              Simulation start time                    [s]
      * @param[in] anEndTime               Simulation end time                      [s]
      * @param[in] anInitialStep           Simulation initial time step             [s]
+     * @param[in] anIntegrator            Numerical integrator type
+     * @param[in] anAbsoluteTolerance     Absolute error tolerance per step
+     * @param[in] aRelativeTolerance      Relative error tolerance per step
+     * @param[in] aMaximumStep            Maximum time step                        [s]
      */
     IntegratorSettings( const State&            anInitialState,
                         const double            aStartTime,
                         const double            anEndTime,
-                        const double            anInitialStep )
+                        const double            anInitialStep,
+                        const IntegratorType    anIntegrator,
+                        const double            anAbsoluteTolerance,
+                        const double            aRelativeTolerance,
+                        const double            aMaximumStep )
         : initialState( anInitialState ),
           startTime( aStartTime ),
           endTime( anEndTime ),
-          initialStep( anInitialStep )
+          initialStep( anInitialStep ),
+          integrator( anIntegrator ),
+          absoluteTolerance( anAbsoluteTolerance ),
+          relativeTolerance( aRelativeTolerance ),
+          maximumStep( aMaximumStep )
     { }
 
     //! Initial state.
@@ -56,8 +79,24 @@ public:
     const double endTime;
 
     //! Initial step for numerical integration [s].
+    /*!
+     * For fixed-step integrators, this is the step size, reduced where needed to end exactly at
+     * the end time.
+     */
     const double initialStep;
 
+    //! Numerical integrator type.
+    const IntegratorType integrator;
+
+    //! Absolute error tolerance per step (only used by adaptive integrators).
+    const double absoluteTolerance;
+
+    //! Relative error tolerance per step (only used by adaptive integrators).
+    const double relativeTolerance;
+
+    //! Maximum time step for numerical integration [s].
+    const double maximumStep;
+
 protected:
 
 private:
@@ -0,0 +1,876 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_INTEGRATOR_TEMPLATE_HPP
+#define SCARAB_INTEGRATOR_TEMPLATE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/numeric/odeint.hpp>
+
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+namespace detail
+{
+
+//! Maximum number of consecutive steps rejected by the step size controller.
+const std::size_t maximumNumberOfRejectedSteps = 500;
+
+//! State derivative model that counts its evaluations.
+template< typename Model >
+class CountingStateDerivativeModel
+{
+public:
+
+    //! Construct counting state derivative model.
+    /*!
+     * Constructs state derivative model that forwards to a given model and counts the number of
+     * evaluations. The wrapper is copied by the odeint steppers, so the counter is held by
+     * reference.
+     *
+     * @param[in] aStateDerivativeModel         State derivative model
+     * @param[in] aNumberOfFunctionEvaluations  Counter of evaluations
+     */
+    CountingStateDerivativeModel( const Model& aStateDerivativeModel,
+                                  std::size_t& aNumberOfFunctionEvaluations )
+        : stateDerivativeModel( aStateDerivativeModel ),
+          numberOfFunctionEvaluations( aNumberOfFunctionEvaluations )
+    { }
+
+    //! Compute state derivative.
+    /*!
+     * Computes state derivative and increments counter of evaluations.
+     *
+     * @param[in]  state            Current state                               [km; km s^-1]
+     * @param[out] stateDerivative  Computed state derivative           [km s^-1; km s^-2]
+     * @param[in]  time             Current time                                [s]
+     */
+    void operator( )( const State& state, State& stateDerivative, const double time ) const
+    {
+        numberOfFunctionEvaluations++;
+        stateDerivativeModel( state, stateDerivative, time );
+    }
+
+private:
+
+    //! State derivative model.
+    const Model& stateDerivativeModel;
+
+    //! Counter of evaluations.
+    std::size_t& numberOfFunctionEvaluations;
+};
+
+//! Sampler passing the state at output epochs to the observer.
+class OutputSampler
+{
+public:
+
+    //! Construct output sampler.
+    /*!
+     * Constructs output sampler. If neither an output interval nor output epochs are given, the
+     * state after every step is passed on to the observer.
+     *
+     * @param[in] anObserver        Observer
+     * @param[in] aStartTime        Start time of integration                   [s]
+     * @param[in] anEndTime         End time of integration                     [s]
+     * @param[in] anOutputInterval  Time interval between output epochs         [s]
+     * @param[in] someOutputEpochs  Output epochs, in ascending order           [s]
+     */
+    OutputSampler( const IntegratorObserver& anObserver,
+                   const double aStartTime,
+                   const double anEndTime,
+                   const double anOutputInterval,
+                   const std::vector< double >& someOutputEpochs )
+        : observer( anObserver ),
+          startTime( aStartTime ),
+          endTime( anEndTime ),
+          outputInterval( anOutputInterval ),
+          outputEpochs( someOutputEpochs ),
+          numberOfEpochs( 0 ),
+          epochIndex( 0 )
+    {
+        if ( outputInterval > 0.0 )
+        {
+            // Allow for round-off, so that the end time is sampled if it lies on the grid.
+            numberOfEpochs = static_cast< std::size_t >(
+                std::floor( ( endTime - startTime ) / outputInterval * ( 1.0 + 1.0e-12 ) ) ) + 1;
+        }
+        else
+        {
+            numberOfEpochs = outputEpochs.size( );
+            while ( epochIndex < numberOfEpochs && outputEpochs[ epochIndex ] < startTime )
+            {
+                epochIndex++;
+            }
+        }
+    }
+
+    //! Check if states are interpolated at output epochs.
+    /*!
+     * Checks if states are interpolated at output epochs, in which case the state derivative at
+     * the end of every step is needed.
+     *
+     * @return True if states are interpolated
+     */
+    bool isInterpolating( ) const
+    {
+        return observer && ( outputInterval > 0.0 || !outputEpochs.empty( ) );
+    }
+
+    //! Get index of next output epoch.
+    /*!
+     * Returns index of next output epoch, as stored in integrator checkpoints.
+     *
+     * @return Index of next output epoch
+     */
+    std::size_t getEpochIndex( ) const { return epochIndex; }
+
+    //! Resume sampling.
+    /*!
+     * Resumes sampling from an integrator checkpoint, instead of sampling the initial state.
+     *
+     * @param[in] anEpochIndex Index of next output epoch
+     */
+    void resume( const std::size_t anEpochIndex ) { epochIndex = anEpochIndex; }
+
+    //! Sample initial state.
+    /*!
+     * Passes initial state to observer, if the start time is an output epoch.
+     *
+     * @param[in] state Initial state                                   [km; km s^-1]
+     */
+    void sampleInitialState( const State& state )
+    {
+        if ( !observer )
+        {
+            return;
+        }
+
+        if ( !isInterpolating( ) )
+        {
+            observer( state, startTime );
+            return;
+        }
+
+        while ( epochIndex < numberOfEpochs && getEpoch( epochIndex ) <= startTime )
+        {
+            observer( state, getEpoch( epochIndex ) );
+            epochIndex++;
+        }
+    }
+
+    //! Sample step.
+    /*!
+     * Passes states at output epochs within step (start time of step, last time] to observer.
+     * The last time is the end time of the step, unless the integration is terminated within the
+     * step.
+     *
+     * @param[in] step      Accepted integration step
+     * @param[in] lastTime  Last time of step that is sampled                   [s]
+     * @param[in] lastState State at last time                                  [km; km s^-1]
+     */
+    void sampleStep( const IntegrationStep& step, const double lastTime, const State& lastState )
+    {
+        if ( !observer )
+        {
+            return;
+        }
+
+        if ( !isInterpolating( ) )
+        {
+            observer( lastState, lastTime );
+            return;
+        }
+
+        while ( epochIndex < numberOfEpochs && getEpoch( epochIndex ) <= lastTime )
+        {
+            const double epoch = getEpoch( epochIndex );
+            if ( epoch == lastTime )
+            {
+                observer( lastState, epoch );
+            }
+            else
+            {
+                observer( step.interpolate( epoch ), epoch );
+            }
+            epochIndex++;
+        }
+    }
+
+private:
+
+    //! Get output epoch.
+    /*!
+     * Returns output epoch with given index; the last epoch on the output grid is clipped to the
+     * end time.
+     *
+     * @param[in] index Index of output epoch
+     * @return          Output epoch                                    [s]
+     */
+    double getEpoch( const std::size_t index ) const
+    {
+        if ( outputInterval > 0.0 )
+        {
+            return std::min( startTime + index * outputInterval, endTime );
+        }
+        return outputEpochs[ index ];
+    }
+
+    //! Observer.
+    const IntegratorObserver& observer;
+
+    //! Start time of integration [s].
+    const double startTime;
+
+    //! End time of integration [s].
+    const double endTime;
+
+    //! Time interval between output epochs [s].
+    const double outputInterval;
+
+    //! Output epochs [s].
+    const std::vector< double >& outputEpochs;
+
+    //! Number of output epochs.
+    std::size_t numberOfEpochs;
+
+    //! Index of next output epoch.
+    std::size_t epochIndex;
+};
+
+//! Adams-Bashforth-Moulton stepper.
+/*!
+ * 5th-order Adams-Bashforth-Moulton predictor-corrector stepper, composed of the odeint
+ * Adams-Bashforth and Adams-Moulton steppers in the same way as odeint::adams_bashforth_moulton,
+ * such that the steps taken are identical. Unlike the odeint stepper, it gives access to the
+ * history of state derivatives, so that it can be stored in and restored from a checkpoint.
+ */
+class AdamsBashforthMoultonStepper
+{
+public:
+
+    //! Number of steps of multistep method.
+    static const std::size_t numberOfSteps = 5;
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper with empty history.
+     */
+    AdamsBashforthMoultonStepper( ) : numberOfStepsTaken( 0 ) { }
+
+    //! Take step.
+    /*!
+     * Takes step; the first steps, until the history is complete, are taken with the 4th-order
+     * Runge-Kutta method.
+     *
+     * @param[in]     system    State derivative function
+     * @param[in,out] state     State at start of step; on return at end of step
+     * @param[in]     time      Time at start of step                       [s]
+     * @param[in]     stepSize  Step size                                   [s]
+     */
+    template< typename System >
+    void do_step( System system, State& state, const double time, const double stepSize )
+    {
+        if ( adamsBashforth.is_initialized( ) )
+        {
+            adamsBashforth.do_step( system, state, time, prediction, stepSize );
+            adamsMoulton.do_step( system, state, prediction, time + stepSize, state, stepSize,
+                                  adamsBashforth.step_storage( ) );
+        }
+        else
+        {
+            adamsBashforth.do_step( system, state, time, stepSize );
+        }
+        numberOfStepsTaken++;
+    }
+
+    //! Get history of state derivatives.
+    /*!
+     * Gets history of state derivatives, most recent first. The history is only available once it
+     * has been filled completely.
+     *
+     * @param[out] history History of state derivatives               [km s^-1; km s^-2]
+     * @return             True if history is available
+     */
+    bool getHistory( std::vector< State >& history ) const
+    {
+        if ( numberOfStepsTaken < numberOfSteps )
+        {
+            return false;
+        }
+
+        history.resize( numberOfSteps );
+        for ( std::size_t i = 0; i < numberOfSteps; i++ )
+        {
+            history[ i ] = adamsBashforth.step_storage( )[ i ].m_v;
+        }
+        return true;
+    }
+
+    //! Restore history of state derivatives.
+    /*!
+     * Restores history of state derivatives, as returned by getHistory( ).
+     *
+     * @param[in] history History of state derivatives                [km s^-1; km s^-2]
+     */
+    void restoreHistory( const std::vector< State >& history )
+    {
+        if ( history.size( ) != numberOfSteps )
+        {
+            throw std::runtime_error(
+                "ERROR: History of multistep integrator in checkpoint is incomplete!" );
+        }
+
+        // Mark the Adams-Bashforth stepper as initialized, which runs the initialization on
+        // dummy values, and then overwrite its history.
+        State dummyState;
+        dummyState.fill( 0.0 );
+        double dummyTime = 0.0;
+        adamsBashforth.initialize(
+            []( const State&, State& stateDerivative, const double )
+            {
+                stateDerivative.fill( 0.0 );
+            },
+            dummyState, dummyTime, 1.0 );
+        for ( std::size_t i = 0; i < numberOfSteps; i++ )
+        {
+            adamsBashforth.step_storage( )[ i ].m_v = history[ i ];
+        }
+        numberOfStepsTaken = numberOfSteps;
+    }
+
+private:
+
+    //! Odeint Adams-Bashforth-Moulton stepper, which defines the composed steppers.
+    typedef boost::numeric::odeint::adams_bashforth_moulton< numberOfSteps, State >
+        OdeintAdamsBashforthMoultonStepper;
+
+    //! Adams-Bashforth (predictor) stepper, which holds the history of state derivatives.
+    OdeintAdamsBashforthMoultonStepper::adams_bashforth_type adamsBashforth;
+
+    //! Adams-Moulton (corrector) stepper.
+    OdeintAdamsBashforthMoultonStepper::adams_moulton_type adamsMoulton;
+
+    //! Predicted state.
+    State prediction;
+
+    //! Number of steps taken.
+    std::size_t numberOfStepsTaken;
+};
+
+
+//! Get history of single-step stepper, which is empty.
+template< typename Stepper >
+bool getStepperHistory( const Stepper&, std::vector< State >& history )
+{
+    history.clear( );
+    return true;
+}
+
+//! Get history of Adams-Bashforth-Moulton stepper.
+inline bool getStepperHistory( const AdamsBashforthMoultonStepper& stepper,
+                               std::vector< State >& history )
+{
+    return stepper.getHistory( history );
+}
+
+//! Restore history of single-step stepper, which is empty.
+template< typename Stepper >
+void restoreStepperHistory( Stepper&, const std::vector< State >& )
+{ }
+
+//! Restore history of Adams-Bashforth-Moulton stepper.
+inline void restoreStepperHistory( AdamsBashforthMoultonStepper& stepper,
+                                   const std::vector< State >& history )
+{
+    stepper.restoreHistory( history );
+}
+
+//! Write integrator checkpoint, if due.
+template< typename Stepper >
+void writeCheckpointIfDue( IntegratorCheckpointHandler* checkpointHandler,
+                                  const Stepper& stepper,
+                                  const double time,
+                                  const State& state,
+                                  const State& stateDerivative,
+                                  const double stepSize,
+                                  const std::size_t numberOfSteps,
+                                  const IntegrationStatistics& statistics,
+                                  const OutputSampler& sampler )
+{
+    if ( checkpointHandler == 0 || !checkpointHandler->isCheckpointDue( ) )
+    {
+        return;
+    }
+
+    // If the stepper cannot be checkpointed yet, the handler is asked again after the next step.
+    IntegratorCheckpoint checkpoint;
+    if ( !getStepperHistory( stepper, checkpoint.multistepStateDerivatives ) )
+    {
+        return;
+    }
+
+    checkpoint.time = time;
+    checkpoint.state = state;
+    checkpoint.stateDerivative = stateDerivative;
+    checkpoint.stepSize = stepSize;
+    checkpoint.numberOfSteps = numberOfSteps;
+    checkpoint.statistics = statistics;
+    checkpoint.outputEpochIndex = sampler.getEpochIndex( );
+    checkpointHandler->writeCheckpoint( checkpoint );
+}
+
+//! Count accepted step and update range of step sizes.
+inline void addAcceptedStep( const double stepSize, IntegrationStatistics& statistics )
+{
+    if ( statistics.numberOfAcceptedSteps == 0 )
+    {
+        statistics.minimumStepSize = stepSize;
+        statistics.maximumStepSize = stepSize;
+    }
+    else
+    {
+        statistics.minimumStepSize = std::min( statistics.minimumStepSize, stepSize );
+        statistics.maximumStepSize = std::max( statistics.maximumStepSize, stepSize );
+    }
+    statistics.numberOfAcceptedSteps++;
+}
+
+//! Take fixed step and update state derivative.
+template< typename Stepper, typename System >
+void takeFixedStep( Stepper& stepper,
+                           const System& system,
+                           State& state,
+                           State& stateDerivative,
+                           const double time,
+                           const double stepSize,
+                           const bool isLastStep,
+                           const bool isDerivativeRequired )
+{
+    // The derivative at the start of the step is passed in, so that it is computed only once; it
+    // is the input of the next step, so it is only skipped after the last step.
+    stepper.do_step( system, state, stateDerivative, time, stepSize );
+    if ( !isLastStep || isDerivativeRequired )
+    {
+        system( state, stateDerivative, time + stepSize );
+    }
+}
+
+//! Take fixed Adams-Bashforth-Moulton step and update state derivative.
+template< typename System >
+void takeFixedStep(
+    AdamsBashforthMoultonStepper& stepper,
+    const System& system,
+    State& state,
+    State& stateDerivative,
+    const double time,
+    const double stepSize,
+    const bool /* isLastStep */,
+    const bool isDerivativeRequired )
+{
+    // The multistep method keeps its own history of derivatives and ignores the derivative passed
+    // in, so the derivative at the end of the step costs an additional evaluation, which is only
+    // done if it is needed to interpolate states or detect events. Otherwise, the derivative is
+    // left stale; it is then not used.
+    stepper.do_step( system, state, time, stepSize );
+    if ( isDerivativeRequired )
+    {
+        system( state, stateDerivative, time + stepSize );
+    }
+}
+
+//! Try controlled step and update state derivative.
+template< typename ControlledStepper, typename System >
+boost::numeric::odeint::controlled_step_result tryStep(
+    ControlledStepper& stepper,
+    const System& system,
+    State& state,
+    State& stateDerivative,
+    double& time,
+    double& stepSize,
+    boost::numeric::odeint::controlled_stepper_tag )
+{
+    // The derivative at the start of the step is passed in, so that it is not recomputed after a
+    // rejected step.
+    const boost::numeric::odeint::controlled_step_result result
+        = stepper.try_step( system, state, stateDerivative, time, stepSize );
+    if ( result == boost::numeric::odeint::success )
+    {
+        system( state, stateDerivative, time );
+    }
+    return result;
+}
+
+//! Try controlled step with first-same-as-last stepper and update state derivative.
+template< typename ControlledStepper, typename System >
+boost::numeric::odeint::controlled_step_result tryStep(
+    ControlledStepper& stepper,
+    const System& system,
+    State& state,
+    State& stateDerivative,
+    double& time,
+    double& stepSize,
+    boost::numeric::odeint::explicit_controlled_stepper_fsal_tag )
+{
+    // The derivative at the end of the step is the last stage of the step, so it comes for free.
+    return stepper.try_step( system, state, stateDerivative, time, stepSize );
+}
+
+//! Handle accepted step.
+inline bool handleStep( const IntegrationStep& step,
+                        State& state,
+                        OutputSampler& sampler,
+                        EventDetector* eventDetector )
+{
+    if ( eventDetector != 0 && eventDetector->detectEvents( step ) )
+    {
+        state = eventDetector->getTerminationState( );
+        sampler.sampleStep( step, eventDetector->getTerminationTime( ), state );
+        return false;
+    }
+
+    sampler.sampleStep( step, step.endTime, step.endState );
+    return true;
+}
+
+//! Integrate state with fixed-step stepper.
+template< typename Stepper, typename System >
+void integrateFixedStep( Stepper stepper,
+                                const System& system,
+                                const IntegratorSettings& settings,
+                                State& state,
+                                State& stateDerivative,
+                                OutputSampler& sampler,
+                                EventDetector* eventDetector,
+                                IntegrationStatistics& statistics,
+                                IntegratorCheckpointHandler* checkpointHandler,
+                                const IntegratorCheckpoint* initialCheckpoint )
+{
+    const double duration = settings.endTime - settings.startTime;
+    const double maximumStep = std::min( settings.initialStep, settings.maximumStep );
+    const std::size_t numberOfSteps
+        = std::max( static_cast< std::size_t >( std::ceil( duration / maximumStep ) ),
+                    static_cast< std::size_t >( 1 ) );
+    const double stepSize = duration / numberOfSteps;
+    const bool isDerivativeRequired = sampler.isInterpolating( ) || eventDetector != 0;
+
+    // The step times follow from the step index, so a resumed integration continues on the same
+    // grid of steps.
+    std::size_t firstStep = 0;
+    IntegrationStep step;
+    step.endTime = settings.startTime;
+    if ( initialCheckpoint != 0 )
+    {
+        firstStep = initialCheckpoint->numberOfSteps;
+        step.endTime = initialCheckpoint->time;
+        restoreStepperHistory( stepper, initialCheckpoint->multistepStateDerivatives );
+    }
+    step.endState = state;
+    step.endStateDerivative = stateDerivative;
+    for ( std::size_t i = firstStep; i < numberOfSteps; i++ )
+    {
+        const bool isLastStep = ( i + 1 == numberOfSteps );
+        step.startTime = step.endTime;
+        step.startState = step.endState;
+        step.startStateDerivative = step.endStateDerivative;
+
+        takeFixedStep( stepper, system, state, stateDerivative, step.startTime, stepSize,
+                       isLastStep, isDerivativeRequired );
+
+        step.endTime = isLastStep ? settings.endTime : settings.startTime + ( i + 1 ) * stepSize;
+        addAcceptedStep( step.endTime - step.startTime, statistics );
+        step.endState = state;
+        step.endStateDerivative = stateDerivative;
+        if ( !handleStep( step, state, sampler, eventDetector ) )
+        {
+            return;
+        }
+
+        if ( !isLastStep )
+        {
+            writeCheckpointIfDue( checkpointHandler, stepper, step.endTime, state, stateDerivative,
+                                  stepSize, i + 1, statistics, sampler );
+        }
+    }
+}
+
+//! Integrate state with controlled (adaptive) stepper.
+template< typename ControlledStepper, typename System >
+void integrateAdaptiveStep( ControlledStepper stepper,
+                                   const System& system,
+                                   const IntegratorSettings& settings,
+                                   State& state,
+                                   State& stateDerivative,
+                                   OutputSampler& sampler,
+                                   EventDetector* eventDetector,
+                                   IntegrationStatistics& statistics,
+                                   IntegratorCheckpointHandler* checkpointHandler,
+                                   const IntegratorCheckpoint* initialCheckpoint )
+{
+    double time = settings.startTime;
+    double stepSize = std::min( settings.initialStep, settings.maximumStep );
+    if ( initialCheckpoint != 0 )
+    {
+        time = initialCheckpoint->time;
+        stepSize = initialCheckpoint->stepSize;
+    }
+    std::size_t numberOfConsecutiveRejectedSteps = 0;
+
+    IntegrationStep step;
+    step.endTime = time;
+    step.endState = state;
+    step.endStateDerivative = stateDerivative;
+    while ( time < settings.endTime )
+    {
+        const double proposedStepSize = stepSize;
+        const bool isLastStep = stepSize >= settings.endTime - time;
+        if ( isLastStep )
+        {
+            stepSize = settings.endTime - time;
+        }
+
+        // On success, the state, state derivative and time are advanced and the next step size is
+        // suggested; on failure, only the step size is reduced.
+        if ( tryStep( stepper, system, state, stateDerivative, time, stepSize,
+                      typename ControlledStepper::stepper_category( ) )
+             == boost::numeric::odeint::success )
+        {
+            numberOfConsecutiveRejectedSteps = 0;
+            if ( isLastStep )
+            {
+                time = settings.endTime;
+            }
+            stepSize = std::min( stepSize, settings.maximumStep );
+
+            // The last step is shortened to end at the end time, so the step size suggested after
+            // it is at least the step size proposed before it was shortened.
+            statistics.nextStepSize
+                = isLastStep ? std::max( stepSize, proposedStepSize ) : stepSize;
+
+            step.startTime = step.endTime;
+            step.startState = step.endState;
+            step.startStateDerivative = step.endStateDerivative;
+            step.endTime = time;
+            addAcceptedStep( step.endTime - step.startTime, statistics );
+            step.endState = state;
+            step.endStateDerivative = stateDerivative;
+            if ( !handleStep( step, state, sampler, eventDetector ) )
+            {
+                return;
+            }
+
+            if ( !isLastStep )
+            {
+                writeCheckpointIfDue( checkpointHandler, stepper, time, state, stateDerivative,
+                                      stepSize, 0, statistics, sampler );
+            }
+        }
+        else
+        {
+            statistics.numberOfRejectedSteps++;
+            numberOfConsecutiveRejectedSteps++;
+            if ( numberOfConsecutiveRejectedSteps >= maximumNumberOfRejectedSteps )
+            {
+                throw std::runtime_error(
+                    "ERROR: Numerical integrator failed to meet tolerances at t = "
+                    + std::to_string( time ) + " s!" );
+            }
+        }
+    }
+}
+
+//! Integrate state with given state derivative model.
+template< typename Model >
+IntegrationStatistics integrateStateWithModel(
+    const IntegratorSettings& settings,
+    const Model& stateDerivativeModel,
+    State& state,
+    const IntegratorObserver& observer,
+    const double outputInterval,
+    const std::vector< double >& outputEpochs,
+    EventDetector* eventDetector,
+    IntegratorCheckpointHandler* checkpointHandler,
+    const IntegratorCheckpoint* initialCheckpoint )
+{
+    namespace odeint = boost::numeric::odeint;
+
+    if ( !( settings.initialStep > 0.0 ) || !( settings.maximumStep > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Initial and maximum step must be positive!" );
+    }
+
+    if ( settings.integrator == bulirschStoerIntegrator
+         && ( checkpointHandler != 0 || initialCheckpoint != 0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Checkpoints are not supported for the bulirsch_stoer integrator!" );
+    }
+
+    IntegrationStatistics statistics;
+    const CountingStateDerivativeModel< Model > system( stateDerivativeModel,
+                                                        statistics.numberOfFunctionEvaluations );
+
+    OutputSampler sampler( observer,
+                           settings.startTime,
+                           settings.endTime,
+                           outputInterval,
+                           outputEpochs );
+    if ( initialCheckpoint != 0 )
+    {
+        sampler.resume( initialCheckpoint->outputEpochIndex );
+        state = initialCheckpoint->state;
+        statistics = initialCheckpoint->statistics;
+    }
+    else
+    {
+        sampler.sampleInitialState( state );
+        if ( eventDetector != 0 )
+        {
+            eventDetector->initialize( state, settings.startTime );
+        }
+    }
+
+    statistics.finalTime = settings.startTime;
+    if ( !( settings.endTime > settings.startTime ) )
+    {
+        return statistics;
+    }
+
+    // The state derivative at the start of every step is tracked, both to pass it on to the
+    // steppers and to interpolate states within steps.
+    State stateDerivative;
+    stateDerivative.fill( 0.0 );
+    if ( initialCheckpoint != 0 )
+    {
+        stateDerivative = initialCheckpoint->stateDerivative;
+    }
+    else if ( settings.integrator != adamsBashforthMoultonIntegrator
+              || sampler.isInterpolating( ) || eventDetector != 0 )
+    {
+        system( state, stateDerivative, settings.startTime );
+    }
+
+    const double absoluteTolerance = settings.absoluteTolerance;
+    const double relativeTolerance = settings.relativeTolerance;
+    switch ( settings.integrator )
+    {
+        case rungeKutta4Integrator:
+            integrateFixedStep( odeint::runge_kutta4< State >( ),
+                                system, settings, state, stateDerivative,
+                                sampler, eventDetector, statistics,
+                                checkpointHandler, initialCheckpoint );
+            break;
+
+        case dormandPrince5Integrator:
+            integrateAdaptiveStep(
+                odeint::make_controlled( absoluteTolerance,
+                                         relativeTolerance,
+                                         odeint::runge_kutta_dopri5< State >( ) ),
+                system, settings, state, stateDerivative, sampler, eventDetector, statistics,
+                checkpointHandler, initialCheckpoint );
+            break;
+
+        case cashKarp54Integrator:
+            integrateAdaptiveStep(
+                odeint::make_controlled( absoluteTolerance,
+                                         relativeTolerance,
+                                         odeint::runge_kutta_cash_karp54< State >( ) ),
+                system, settings, state, stateDerivative, sampler, eventDetector, statistics,
+                checkpointHandler, initialCheckpoint );
+            break;
+
+        case fehlberg78Integrator:
+            integrateAdaptiveStep(
+                odeint::make_controlled( absoluteTolerance,
+                                         relativeTolerance,
+                                         odeint::runge_kutta_fehlberg78< State >( ) ),
+                system, settings, state, stateDerivative, sampler, eventDetector, statistics,
+                checkpointHandler, initialCheckpoint );
+            break;
+
+        case bulirschStoerIntegrator:
+            integrateAdaptiveStep(
+                odeint::bulirsch_stoer< State >( absoluteTolerance, relativeTolerance ),
+                system, settings, state, stateDerivative, sampler, eventDetector, statistics,
+                checkpointHandler, initialCheckpoint );
+            break;
+
+        case adamsBashforthMoultonIntegrator:
+            integrateFixedStep( AdamsBashforthMoultonStepper( ),
+                                system, settings, state, stateDerivative,
+                                sampler, eventDetector, statistics,
+                                checkpointHandler, initialCheckpoint );
+            break;
+    }
+
+    statistics.finalTime = settings.endTime;
+    if ( eventDetector != 0 && eventDetector->isTerminated( ) )
+    {
+        statistics.finalTime = eventDetector->getTerminationTime( );
+    }
+
+    return statistics;
+}
+
+} // namespace detail
+
+//! Integrate state with state derivative model of any type.
+/*!
+ * Integrates state as integrateState( ) in integrator.hpp, for a state derivative model of any
+ * type that provides void operator( )( const State&, State&, const double ) const. The model is
+ * called through its static type, so the calls can be inlined into the odeint steppers; this is
+ * the overload used for a ComposedStateDerivativeModel. The runtime-polymorphic
+ * StateDerivativeModel and StateDerivativeFunction are integrated with the non-template
+ * overloads, which are preferred for these types.
+ *
+ * @sa integrateState, ComposedStateDerivativeModel
+ * @tparam Model                        Type of state derivative model
+ * @param[in]     settings              Numerical integrator settings
+ * @param[in]     stateDerivativeModel  State derivative model
+ * @param[in,out] state                 State at start time; on return at end time [km; km s^-1]
+ * @param[in]     observer              Observer (optional)
+ * @param[in]     outputInterval        Time interval between calls to observer; zero to call
+ *                                      observer after every step (optional)        [s]
+ * @param[in]     outputEpochs          Epochs at which to call observer, in ascending order
+ *                                      (optional)                                  [s]
+ * @param[in,out] eventDetector         Event detector (optional)
+ * @param[in,out] checkpointHandler     Checkpoint handler (optional)
+ * @param[in]     initialCheckpoint     Checkpoint to resume integration from (optional)
+ * @return                              Integration statistics
+ */
+template< typename Model >
+IntegrationStatistics integrateState(
+    const IntegratorSettings& settings,
+    const Model& stateDerivativeModel,
+    State& state,
+    const IntegratorObserver& observer = IntegratorObserver( ),
+    const double outputInterval = 0.0,
+    const std::vector< double >& outputEpochs = std::vector< double >( ),
+    EventDetector* eventDetector = 0,
+    IntegratorCheckpointHandler* checkpointHandler = 0,
+    const IntegratorCheckpoint* initialCheckpoint = 0 )
+{
+    return detail::integrateStateWithModel( settings, stateDerivativeModel, state,
+                                            observer, outputInterval, outputEpochs, eventDetector,
+                                            checkpointHandler, initialCheckpoint );
+}
+
+} // namespace scarab
+
+#endif // SCARAB_INTEGRATOR_TEMPLATE_HPP
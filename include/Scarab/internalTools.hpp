@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_INTERNAL_TOOLS_HPP
+#define SCARAB_INTERNAL_TOOLS_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+// Tools shared by the implementation of the binary file formats and trajectories; not part of the
+// public interface.
+
+namespace scarab
+{
+
+//! Check if host is little-endian.
+/*!
+ * Checks if host is little-endian; the binary file formats store doubles in little-endian byte
+ * order and are mapped into memory directly, so they are only supported on little-endian hosts.
+ *
+ * @return True if host is little-endian
+ */
+bool isLittleEndian( );
+
+//! Write unsigned integer to stream as little-endian.
+/*!
+ * Writes the least significant bytes of an unsigned integer to a stream in little-endian byte
+ * order, independent of the byte order of the host.
+ *
+ * @param[in,out] stream        Output stream
+ * @param[in]     value         Value to write
+ * @param[in]     numberOfBytes Number of bytes to write (at most 8)
+ */
+void writeLittleEndian( std::ostream& stream,
+                        const boost::uint64_t value,
+                        const std::size_t numberOfBytes );
+
+//! Append unsigned integer to buffer as little-endian.
+/*!
+ * Appends the least significant bytes of an unsigned integer to a buffer in little-endian byte
+ * order, independent of the byte order of the host.
+ *
+ * @param[in,out] buffer        Buffer
+ * @param[in]     value         Value to append
+ * @param[in]     numberOfBytes Number of bytes to append (at most 8)
+ */
+void writeLittleEndian( std::vector< char >& buffer,
+                        const boost::uint64_t value,
+                        const std::size_t numberOfBytes );
+
+//! Read unsigned integer stored as little-endian.
+/*!
+ * Reads an unsigned integer stored in little-endian byte order, independent of the byte order of
+ * the host.
+ *
+ * @param[in] bytes         Bytes to read
+ * @param[in] numberOfBytes Number of bytes to read (at most 8)
+ * @return                  Value read
+ */
+boost::uint64_t readLittleEndian( const unsigned char* bytes, const std::size_t numberOfBytes );
+
+//! Escape string for use in JSON.
+/*!
+ * Escapes string for use between the quotes of a JSON string: quotes and backslashes are
+ * preceded by a backslash and control characters are written as \\u00XX.
+ *
+ * @param[in] text Text to escape
+ * @return         Escaped text, without enclosing quotes
+ */
+std::string escapeJsonString( const std::string& text );
+
+//! Interval lookup table.
+/*!
+ * Table that finds the interval between consecutive boundaries (e.g., samples or segment
+ * boundaries of a trajectory) containing an epoch in constant expected time. The time span is
+ * divided into uniform buckets, each of which stores the first interval overlapping it; the
+ * lookup starts at the bucket containing the epoch and advances over the boundaries within the
+ * bucket.
+ *
+ * The boundaries are not stored in the table, but passed to every lookup, so that the table stays
+ * valid when the object holding the boundaries is copied.
+ */
+class IntervalLookupTable
+{
+public:
+
+    //! Construct empty interval lookup table.
+    IntervalLookupTable( );
+
+    //! Construct interval lookup table.
+    /*!
+     * Constructs interval lookup table for given boundaries, which must be strictly ascending.
+     *
+     * @param[in] boundaries                  Boundaries of intervals                       [s]
+     * @param[in] aNumberOfIntervals          Number of intervals (number of boundaries - 1)
+     * @param[in] numberOfBucketsPerInterval  Number of buckets per interval
+     */
+    IntervalLookupTable( const double* boundaries,
+                         const std::size_t aNumberOfIntervals,
+                         const std::size_t numberOfBucketsPerInterval );
+
+    //! Find interval.
+    /*!
+     * Returns index of interval containing given epoch, i.e., the index i of the last boundary
+     * t_i <= time, limited to the last interval. The epoch must lie within the boundaries.
+     *
+     * @param[in] boundaries  Boundaries of intervals, as passed on construction       [s]
+     * @param[in] time        Epoch                                                     [s]
+     * @return                Index of interval
+     */
+    std::size_t findInterval( const double* boundaries, const double time ) const;
+
+protected:
+
+private:
+
+    //! Number of intervals.
+    std::size_t numberOfIntervals;
+
+    //! Start time of first interval [s].
+    double startTime;
+
+    //! Inverse of width of lookup buckets [s^-1].
+    double inverseBucketWidth;
+
+    //! First interval overlapping every lookup bucket.
+    std::vector< std::size_t > bucketIntervals;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_INTERNAL_TOOLS_HPP
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_INTERPOLATED_ACCELERATION_MODEL_HPP
+#define SCARAB_INTERPOLATED_ACCELERATION_MODEL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Interpolation statistics.
+/*!
+ * Data struct containing the counters of an interpolated acceleration model. Every call of the
+ * model is counted either as a hit, if it is served from a cell of the grid that was built
+ * before, or as a miss otherwise. A miss builds the cell that contains the position, unless the
+ * cell was rejected before or the grid is full; if the cell is not available, the wrapped model
+ * is evaluated directly, which is counted as a fallback.
+ */
+struct InterpolationStatistics
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all counters set to zero.
+     */
+    InterpolationStatistics( )
+        : numberOfHits( 0 ),
+          numberOfMisses( 0 ),
+          numberOfFallbacks( 0 ),
+          numberOfCells( 0 ),
+          numberOfRejectedCells( 0 ),
+          maximumErrorEstimate( 0.0 )
+    { }
+
+    //! Number of calls served from an existing cell.
+    std::size_t numberOfHits;
+
+    //! Number of calls not served from an existing cell.
+    std::size_t numberOfMisses;
+
+    //! Number of calls served by the wrapped model.
+    std::size_t numberOfFallbacks;
+
+    //! Number of cells built, including rejected cells.
+    std::size_t numberOfCells;
+
+    //! Number of cells rejected, since their error estimate exceeds the tolerance.
+    std::size_t numberOfRejectedCells;
+
+    //! Maximum error estimate of accepted cells [km s^-2].
+    double maximumErrorEstimate;
+
+protected:
+
+private:
+};
+
+//! Interpolated acceleration model.
+/*!
+ * Acceleration model that serves the acceleration of a wrapped model from a 3D interpolation
+ * grid. The grid consists of cubic cells of equal size, which are built lazily: the first call
+ * with a position in a cell evaluates the wrapped model at the 4 x 4 x 4 Chebyshev nodes of the
+ * cell, and subsequent calls in the cell interpolate the acceleration with the tricubic Lagrange
+ * polynomial through these nodes. Hence, only the region actually visited is tabulated, which
+ * pays off when a high-degree gravity field is evaluated many times in a small region, e.g.,
+ * during proximity operations or for the members of an ensemble.
+ *
+ * On construction of a cell, the interpolation error is estimated by comparing the interpolated
+ * and the wrapped acceleration at the centre and at the corners of the cell, where the error of
+ * the Chebyshev interpolant is largest. Cells with an error estimate that exceeds the tolerance
+ * are rejected, and the acceleration in these cells is always computed by the wrapped model, so
+ * that the error of the served accelerations is bounded by the tolerance. The number of cells is
+ * bounded as well; beyond this number, the wrapped model is evaluated directly.
+ *
+ * The grid is fixed to a frame that rotates about the z-axis at a constant rate, aligned with the
+ * frame of the state at time zero. The wrapped model is evaluated in this frame at time zero, so
+ * it may depend on time only through this rotation, as the spherical harmonics gravity model
+ * does; a rotation rate of zero gives an inertial grid for time-independent models.
+ *
+ * The model can be evaluated concurrently: the grid is guarded by a mutex, which is held only to
+ * look up and build cells, while the interpolation itself is done outside the lock.
+ *
+ * @sa InterpolationStatistics
+ */
+class InterpolatedAccelerationModel final : public AccelerationModel< Acceleration >
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs interpolated acceleration model, with an empty grid.
+     *
+     * @param[in] aWrappedModel         Wrapped acceleration model
+     * @param[in] aCellSize             Size of cubic cells of grid                 [km]
+     * @param[in] aTolerance            Tolerance on error estimate of cells        [km s^-2]
+     * @param[in] aMaximumNumberOfCells Maximum number of cells in grid
+     * @param[in] aRotationRate         Rotation rate of grid about z-axis
+     *                                  (default = 0)                               [rad s^-1]
+     */
+    InterpolatedAccelerationModel( const AccelerationModel3dPtr&   aWrappedModel,
+                                   const double                    aCellSize,
+                                   const double                    aTolerance,
+                                   const std::size_t               aMaximumNumberOfCells,
+                                   const double                    aRotationRate = 0.0 );
+
+    //! Compute acceleration.
+    /*!
+     * Computes acceleration by interpolation in the cell of the grid that contains the position,
+     * building the cell if needed, or by the wrapped model if the cell is not available.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time                                            [s]
+     * @return          Computed acceleration                                   [km s^-2]
+     */
+    Acceleration operator( )( const State& state, const double time ) const;
+
+    //! Get interpolation statistics.
+    /*!
+     * Returns snapshot of counters of calls and cells.
+     *
+     * @return Interpolation statistics
+     */
+    InterpolationStatistics getStatistics( ) const;
+
+protected:
+
+private:
+
+    //! Number of interpolation nodes per axis.
+    static const std::size_t numberOfNodes = 4;
+
+    //! Index of cell in grid.
+    struct CellIndex
+    {
+        //! Indices along x-, y- and z-axis.
+        long long i, j, k;
+
+        //! Compare cell indices.
+        bool operator==( const CellIndex& other ) const
+        {
+            return i == other.i && j == other.j && k == other.k;
+        }
+    };
+
+    //! Hash of cell index.
+    struct CellIndexHash
+    {
+        //! Compute hash of cell index.
+        std::size_t operator( )( const CellIndex& index ) const;
+    };
+
+    //! Cell of grid.
+    struct Cell
+    {
+        //! Flag indicating if error estimate of cell is within tolerance.
+        bool isAccepted;
+
+        //! Accelerations at nodes, ordered by x-, y- and z-node and component [km s^-2].
+        double nodeAccelerations[ numberOfNodes * numberOfNodes * numberOfNodes * 3 ];
+    };
+
+    //! Grid of cells, by cell index.
+    typedef std::unordered_map< CellIndex, std::unique_ptr< Cell >, CellIndexHash > Grid;
+
+    //! Build cell.
+    /*!
+     * Evaluates wrapped model at the nodes of a cell and estimates the interpolation error.
+     *
+     * @param[in]  index    Index of cell
+     * @param[out] cell     Built cell
+     * @return              Error estimate                                      [km s^-2]
+     */
+    double buildCell( const CellIndex& index, Cell& cell ) const;
+
+    //! Interpolate acceleration in cell.
+    /*!
+     * Interpolates acceleration at position in given cell.
+     *
+     * @param[in] index    Index of cell
+     * @param[in] cell     Cell containing position
+     * @param[in] position Position in frame of grid                            [km]
+     * @return             Interpolated acceleration in frame of grid           [km s^-2]
+     */
+    Acceleration interpolate( const CellIndex& index,
+                              const Cell& cell,
+                              const Position& position ) const;
+
+    //! Evaluate wrapped model.
+    /*!
+     * Evaluates wrapped model at position in frame of grid.
+     *
+     * @param[in] position Position in frame of grid                            [km]
+     * @return             Acceleration in frame of grid                        [km s^-2]
+     */
+    Acceleration evaluateWrappedModel( const Position& position ) const;
+
+    //! Wrapped acceleration model.
+    const AccelerationModel3dPtr wrappedModel;
+
+    //! Size of cubic cells of grid [km].
+    const double cellSize;
+
+    //! Tolerance on error estimate of cells [km s^-2].
+    const double tolerance;
+
+    //! Maximum number of cells in grid.
+    const std::size_t maximumNumberOfCells;
+
+    //! Rotation rate of grid about z-axis [rad s^-1].
+    const double rotationRate;
+
+    //! Mutex guarding grid and statistics.
+    mutable std::mutex mutex;
+
+    //! Grid of cells built so far.
+    mutable Grid grid;
+
+    //! Counters of calls and cells.
+    mutable InterpolationStatistics statistics;
+};
+
+//! Pointer to interpolated acceleration model.
+typedef boost::shared_ptr< InterpolatedAccelerationModel > InterpolatedAccelerationModelPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_INTERPOLATED_ACCELERATION_MODEL_HPP
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_INTERPOLATED_TRAJECTORY_HPP
+#define SCARAB_INTERPOLATED_TRAJECTORY_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Scarab/internalTools.hpp"
+#include "Scarab/stateHistory.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Interpolated trajectory.
+/*!
+ * Trajectory that evaluates the state at any epoch between the first and last samples of a state
+ * history. Within every interval between consecutive samples, the position is interpolated with
+ * the cubic Hermite polynomial through the positions and velocities at both ends, and the
+ * velocity is the derivative of this polynomial. The interpolated state therefore matches the
+ * samples exactly, and is continuous in position and velocity across samples.
+ *
+ * The samples are copied into contiguous arrays on construction. To find the interval containing
+ * an epoch in constant expected time, the time span is divided into uniform buckets, one per
+ * interval, each of which stores the first interval overlapping it. For sequences of
+ * (approximately) monotone queries, a TrajectoryCursor avoids even the bucket lookup.
+ *
+ * The epochs of the samples must be strictly ascending, since every interval must have a
+ * positive length. Binary trajectory files that store an impulsive manoeuvre as two samples with
+ * the same epoch are therefore rejected.
+ *
+ * A trajectory can be constructed from a state history recorded in memory, or, after
+ * executeSimulator() has returned, from the binary trajectory file it has written.
+ *
+ * @sa TrajectoryCursor, TrajectoryFileReader
+ */
+class InterpolatedTrajectory
+{
+public:
+
+    //! Construct interpolated trajectory from state history.
+    /*!
+     * Constructs interpolated trajectory from samples of a state history. An error is thrown if
+     * the state history contains fewer than two samples.
+     *
+     * @param[in] stateHistory State history
+     */
+    explicit InterpolatedTrajectory( const StateHistory& stateHistory );
+
+    //! Construct interpolated trajectory from binary trajectory file.
+    /*!
+     * Constructs interpolated trajectory from samples stored in a binary trajectory file. An
+     * error is thrown if the file contains fewer than two samples, or if the samples are not in
+     * strictly ascending order of time.
+     *
+     * @param[in] reader Reader of binary trajectory file
+     */
+    explicit InterpolatedTrajectory( const TrajectoryFileReader& reader );
+
+    //! Get number of samples.
+    /*!
+     * Returns number of samples in trajectory.
+     *
+     * @return Number of samples
+     */
+    std::size_t getNumberOfSamples( ) const { return times.size( ); }
+
+    //! Get start time.
+    /*!
+     * Returns epoch of first sample.
+     *
+     * @return Start time                                                         [s]
+     */
+    double getStartTime( ) const { return times.front( ); }
+
+    //! Get end time.
+    /*!
+     * Returns epoch of last sample.
+     *
+     * @return End time                                                           [s]
+     */
+    double getEndTime( ) const { return times.back( ); }
+
+    //! Find interval.
+    /*!
+     * Returns index of interval containing given epoch, i.e., the index i of the last sample with
+     * epoch t_i <= time, limited to the second to last sample. An error is thrown if the epoch is
+     * outside the time span of the trajectory.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         Index of interval
+     */
+    std::size_t findInterval( const double time ) const;
+
+    //! Find interval, starting from previous interval.
+    /*!
+     * Returns index of interval containing given epoch, checking the given interval and the
+     * interval following it before looking up the interval in the bucket table.
+     *
+     * @sa findInterval
+     * @param[in] time              Epoch                                         [s]
+     * @param[in] previousInterval  Index of interval containing previous epoch queried
+     * @return                      Index of interval
+     */
+    std::size_t findInterval( const double time, const std::size_t previousInterval ) const;
+
+    //! Get state.
+    /*!
+     * Interpolates state at given epoch.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         State at epoch                                             [km; km s^-1]
+     */
+    State getState( const double time ) const
+    {
+        return interpolateState( time, findInterval( time ) );
+    }
+
+    //! Get position.
+    /*!
+     * Interpolates position at given epoch.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         Position at epoch                                          [km]
+     */
+    Position getPosition( const double time ) const;
+
+    //! Interpolate state in interval.
+    /*!
+     * Interpolates state at given epoch in given interval, without checking that the epoch lies
+     * within the interval.
+     *
+     * @param[in] time      Epoch                                                 [s]
+     * @param[in] interval  Index of interval
+     * @return              State at epoch                                        [km; km s^-1]
+     */
+    State interpolateState( const double time, const std::size_t interval ) const;
+
+protected:
+
+private:
+
+    //! Build interval lookup table.
+    void buildLookupTable( );
+
+    //! Epochs of samples [s].
+    std::vector< double > times;
+
+    //! States at samples [km; km s^-1].
+    std::vector< State > states;
+
+    //! Lookup table of intervals.
+    IntervalLookupTable lookupTable;
+};
+
+//! Trajectory cursor.
+/*!
+ * Cursor that evaluates an interpolated trajectory for a sequence of epochs, remembering the
+ * interval of the previous query. For monotone sequences of epochs, which step through the
+ * trajectory by at most one sample per query, the interval is found by one or two comparisons.
+ * Other epochs fall back to the bucket lookup of the trajectory.
+ *
+ * A cursor is cheap to create. The trajectory can be shared between threads, each of which
+ * uses its own cursor.
+ *
+ * @sa InterpolatedTrajectory
+ */
+class TrajectoryCursor
+{
+public:
+
+    //! Construct cursor.
+    /*!
+     * Constructs cursor positioned at the first interval of the trajectory.
+     *
+     * @param[in] aTrajectory Interpolated trajectory, which must outlive the cursor
+     */
+    explicit TrajectoryCursor( const InterpolatedTrajectory& aTrajectory )
+        : trajectory( aTrajectory ),
+          interval( 0 )
+    { }
+
+    //! Get state.
+    /*!
+     * Interpolates state at given epoch, and moves cursor to interval containing the epoch.
+     *
+     * @param[in] time Epoch                                                      [s]
+     * @return         State at epoch                                             [km; km s^-1]
+     */
+    State getState( const double time )
+    {
+        interval = trajectory.findInterval( time, interval );
+        return trajectory.interpolateState( time, interval );
+    }
+
+protected:
+
+private:
+
+    //! Interpolated trajectory.
+    const InterpolatedTrajectory& trajectory;
+
+    //! Index of interval of previous query.
+    std::size_t interval;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_INTERPOLATED_TRAJECTORY_HPP
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_LOGGER_HPP
+#define SCARAB_LOGGER_HPP
+
+#include <ostream>
+#include <string>
+
+namespace scarab
+{
+
+//! Log levels, in order of increasing verbosity.
+enum LogLevel
+{
+    quietLogLevel,
+    infoLogLevel,
+    debugLogLevel
+};
+
+//! Get log level.
+/*!
+ * Gets log level from its name in the configuration file ("quiet", "info" or "debug"). An error
+ * is thrown if the name is not known.
+ *
+ * @param[in] logLevelName Name of log level
+ * @return                 Log level
+ */
+LogLevel getLogLevel( const std::string& logLevelName );
+
+//! Set log level.
+/*!
+ * Sets log level of the process; messages of a higher (more verbose) level are discarded. The
+ * default log level is infoLogLevel. Setting the log level is thread-safe.
+ *
+ * @param[in] level Log level
+ */
+void setLogLevel( const LogLevel level );
+
+//! Get current log level.
+/*!
+ * Returns current log level of the process.
+ *
+ * @return Current log level
+ */
+LogLevel getCurrentLogLevel( );
+
+//! Set log sink.
+/*!
+ * Sets stream to which log messages are written once they are flushed, e.g., to capture the log
+ * in tests. The default log sink is std::cout. The stream must outlive all log output written to
+ * it. Buffered messages of all threads are flushed to the old sink first.
+ *
+ * @param[in] sink Log sink
+ */
+void setLogSink( std::ostream& sink );
+
+//! Get log stream.
+/*!
+ * Returns log stream of the calling thread for the given log level. If the level is not logged,
+ * a stream is returned that discards all output without formatting it.
+ *
+ * Every thread has its own log buffer, so threads do not contend while writing messages;
+ * std::endl does not flush the buffer to the log sink. A buffer is written to the log sink as one
+ * block once it exceeds a fixed size, when flushLog() or setLogSink() is called, and when the
+ * thread exits, so the lines of different threads are never interleaved.
+ *
+ * @param[in] level Log level of messages
+ * @return          Log stream
+ */
+std::ostream& getLogStream( const LogLevel level );
+
+//! Get log stream for informational messages.
+/*!
+ * Returns log stream of the calling thread for informational messages, e.g., settings, progress
+ * and results of a simulation.
+ *
+ * @sa getLogStream
+ * @return Log stream
+ */
+inline std::ostream& logInfo( ) { return getLogStream( infoLogLevel ); }
+
+//! Get log stream for debug messages.
+/*!
+ * Returns log stream of the calling thread for debug messages, e.g., the individual set-up steps
+ * of a simulation.
+ *
+ * @sa getLogStream
+ * @return Log stream
+ */
+inline std::ostream& logDebug( ) { return getLogStream( debugLogLevel ); }
+
+//! Flush log.
+/*!
+ * Writes buffered log messages of the calling thread to the log sink.
+ */
+void flushLog( );
+
+} // namespace scarab
+
+#endif // SCARAB_LOGGER_HPP
@@ -10,11 +10,63 @@
 #ifndef SCARAB_OUTPUT_SETTINGS_HPP
 #define SCARAB_OUTPUT_SETTINGS_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace scarab
 {
 
+//! State history file format.
+enum StateHistoryFormat
+{
+    csvStateHistoryFormat,
+    binaryStateHistoryFormat,
+    chebyshevStateHistoryFormat
+};
+
+//! Chebyshev trajectory settings.
+/*!
+ * Data struct containing all valid input parameters for compressing the state history into
+ * piecewise Chebyshev polynomials. The settings are only used if the state history format is
+ * set to chebyshevStateHistoryFormat.
+ *
+ * @sa ChebyshevTrajectoryWriter
+ */
+struct ChebyshevTrajectorySettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @param[in] aPositionTolerance        Maximum position error at samples       [km]
+     * @param[in] aVelocityTolerance        Maximum velocity error at samples       [km s^-1]
+     * @param[in] aNumberOfCoefficients     Number of coefficients per component and segment
+     */
+    ChebyshevTrajectorySettings( const double aPositionTolerance,
+                                 const double aVelocityTolerance,
+                                 const std::size_t aNumberOfCoefficients )
+        : positionTolerance( aPositionTolerance ),
+          velocityTolerance( aVelocityTolerance ),
+          numberOfCoefficients( aNumberOfCoefficients )
+    { }
+
+    //! Maximum position error at samples [km].
+    const double positionTolerance;
+
+    //! Maximum velocity error at samples [km s^-1].
+    const double velocityTolerance;
+
+    //! Number of coefficients per component and segment.
+    const std::size_t numberOfCoefficients;
+
+protected:
+
+private:
+};
+
 //! Output settings.
 /*!
  * Data struct containing all valid output settings. This struct is populated by the
@@ -31,12 +83,36 @@ public:
      * Constructs data struct based on verified input parameters.
      *
      * @sa checkSimulatorSettings, executeSimulator
-     *
+     * @param[in] aMetadataFilename         Metadata filename
+     * @param[in] aStateHistoryFilename     State history filename
+     * @param[in] aStateHistoryChunkSize    Number of samples of the state history buffered in
+     *                                      memory before they are written to file
+     * @param[in] aStateHistoryFormat       State history file format
+     * @param[in] aStateHistoryInterval     Time interval between samples of the state history;
+     *                                      zero to sample every integration step       [s]
+     * @param[in] someStateHistoryEpochs    Epochs at which the state history is sampled, in
+     *                                      ascending order; empty to sample every integration
+     *                                      step or at the time interval set            [s]
+     * @param[in] someChebyshevTrajectorySettings Chebyshev trajectory settings
+     * @param[in] aSummaryFilename          Filename for JSON run summary; empty if no summary is
+     *                                      written
      */
     OutputSettings( const std::string& aMetadataFilename,
-                    const std::string& aStateHistoryFilename )
+                    const std::string& aStateHistoryFilename,
+                    const std::size_t aStateHistoryChunkSize,
+                    const StateHistoryFormat aStateHistoryFormat,
+                    const double aStateHistoryInterval,
+                    const std::vector< double >& someStateHistoryEpochs,
+                    const ChebyshevTrajectorySettings& someChebyshevTrajectorySettings,
+                    const std::string& aSummaryFilename )
         : metadataFilename( aMetadataFilename ),
-          stateHistoryFilename( aStateHistoryFilename )
+          stateHistoryFilename( aStateHistoryFilename ),
+          stateHistoryChunkSize( aStateHistoryChunkSize ),
+          stateHistoryFormat( aStateHistoryFormat ),
+          stateHistoryInterval( aStateHistoryInterval ),
+          stateHistoryEpochs( someStateHistoryEpochs ),
+          chebyshevTrajectorySettings( someChebyshevTrajectorySettings ),
+          summaryFilename( aSummaryFilename )
     { }
 
     //! Metadata filename.
@@ -45,6 +121,24 @@ public:
     //! State history filename.
     const std::string stateHistoryFilename;
 
+    //! Number of samples of the state history buffered in memory before they are written to file.
+    const std::size_t stateHistoryChunkSize;
+
+    //! State history file format.
+    const StateHistoryFormat stateHistoryFormat;
+
+    //! Time interval between samples of the state history; zero to sample every step [s].
+    const double stateHistoryInterval;
+
+    //! Epochs at which the state history is sampled, in ascending order [s].
+    const std::vector< double > stateHistoryEpochs;
+
+    //! Chebyshev trajectory settings.
+    const ChebyshevTrajectorySettings chebyshevTrajectorySettings;
+
+    //! Filename for JSON run summary; empty if no summary is written.
+    const std::string summaryFilename;
+
 protected:
 
 private:
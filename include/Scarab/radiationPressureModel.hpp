@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_RADIATION_PRESSURE_MODEL_HPP
+#define SCARAB_RADIATION_PRESSURE_MODEL_HPP
+
+#include <cmath>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/radiationPressureSettings.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Radiation pressure acceleration model.
+/*!
+ * Radiation pressure acceleration model for a cannonball spacecraft. The source of radiation
+ * pressure, e.g., the Sun, is either at a fixed position with respect to the central body, or
+ * its position is taken from a Chebyshev ephemeris at the current time. The acceleration is
+ * directed away from the source and scaled by the shadow function, i.e., the fraction of the
+ * source that is visible from the spacecraft.
+ *
+ * The constant factor P C_R A / m is computed once on construction, as is the geometry of the
+ * shadow for a fixed source; for a source taken from an ephemeris, the geometry is updated on
+ * every call. The shadow test starts with a cheap prefilter, which only requires the projection
+ * of the position onto the direction of the source: on the illuminated side of the central body
+ * and outside the shadow cylinder (or penumbra cone) the spacecraft is fully illuminated without
+ * further computation. Only within the penumbra cone is the conical shadow function evaluated in
+ * full (O. Montenbruck and E. Gill, Satellite Orbits, 2000, Section 3.4.2).
+ */
+class RadiationPressureModel final : public AccelerationModel< Acceleration >
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs radiation pressure model with source at a fixed position.
+     *
+     * @param[in] aRadiationPressure            Radiation pressure                      [N m^-2]
+     * @param[in] aRadiationPressureCoefficient Radiation pressure coefficient          [-]
+     * @param[in] aRadiationPressureArea        Area subject to radiation pressure      [m^2]
+     * @param[in] aMass                         Spacecraft mass                         [kg]
+     * @param[in] aVectorToSource               Position vector of source with respect to
+     *                                          central body                            [m]
+     * @param[in] aShadowModel                  Shadow model
+     * @param[in] aCentralBodyRadius            Radius of central body                  [km]
+     * @param[in] aSourceRadius                 Radius of source                        [km]
+     */
+    RadiationPressureModel( const double        aRadiationPressure,
+                            const double        aRadiationPressureCoefficient,
+                            const double        aRadiationPressureArea,
+                            const double        aMass,
+                            const Position&     aVectorToSource,
+                            const ShadowModel   aShadowModel,
+                            const double        aCentralBodyRadius,
+                            const double        aSourceRadius );
+
+    //! Construct model.
+    /*!
+     * Constructs radiation pressure model with position of source taken from ephemeris.
+     *
+     * @param[in] aRadiationPressure            Radiation pressure                      [N m^-2]
+     * @param[in] aRadiationPressureCoefficient Radiation pressure coefficient          [-]
+     * @param[in] aRadiationPressureArea        Area subject to radiation pressure      [m^2]
+     * @param[in] aMass                         Spacecraft mass                         [kg]
+     * @param[in] anEphemeris                   Ephemeris containing position of source
+     * @param[in] aSourceBodyIndex              Index of source in ephemeris
+     * @param[in] aShadowModel                  Shadow model
+     * @param[in] aCentralBodyRadius            Radius of central body                  [km]
+     * @param[in] aSourceRadius                 Radius of source                        [km]
+     */
+    RadiationPressureModel( const double                    aRadiationPressure,
+                            const double                    aRadiationPressureCoefficient,
+                            const double                    aRadiationPressureArea,
+                            const double                    aMass,
+                            const ChebyshevEphemerisPtr&    anEphemeris,
+                            const std::size_t               aSourceBodyIndex,
+                            const ShadowModel               aShadowModel,
+                            const double                    aCentralBodyRadius,
+                            const double                    aSourceRadius );
+
+    //! Compute acceleration.
+    /*!
+     * Computes radiation pressure acceleration, directed away from the source.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time, used for source taken from ephemeris      [s]
+     * @return          Computed acceleration                                   [km s^-2]
+     */
+    Acceleration operator( )( const State& state, const double time ) const
+    {
+        if ( ephemeris )
+        {
+            return computeAcceleration(
+                state, computeSourceGeometry( ephemeris->getPosition( sourceBodyIndex, time ) ) );
+        }
+        return computeAcceleration( state, sourceGeometry );
+    }
+
+    //! Compute shadow function.
+    /*!
+     * Computes shadow function, i.e., fraction of the disk of the source that is visible from the
+     * spacecraft: 1 if fully illuminated, 0 in umbra (or within the shadow cylinder) and in
+     * between in penumbra. For a source taken from an ephemeris, the position of the source at
+     * the start of the ephemeris is used.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @return          Shadow function                                         [-]
+     */
+    double computeShadowFunction( const State& state ) const
+    {
+        return computeShadowFunction( state, sourceGeometry );
+    }
+
+protected:
+
+private:
+
+    //! Geometry of source.
+    /*!
+     * Data struct containing the position of the source and the quantities derived from it that
+     * are needed for the shadow test.
+     */
+    struct SourceGeometry
+    {
+        //! Position of source with respect to central body [km].
+        Position position;
+
+        //! Unit vector from central body to source [-].
+        Position direction;
+
+        //! Tangent of half-angle of penumbra cone [-].
+        double penumbraSlope;
+
+        //! Projection onto direction of source of vertex of penumbra cone [km].
+        double penumbraVertexProjection;
+
+        //! Projection onto direction of source beyond which spacecraft is fully illuminated [km].
+        double shadowBoundaryProjection;
+    };
+
+    //! Compute geometry of source.
+    /*!
+     * Computes direction of source and penumbra cone from position of source. An error is thrown
+     * if the source coincides with the central body, or, if a shadow model is set, if the source
+     * does not lie beyond the central body.
+     *
+     * @param[in] sourcePosition Position of source with respect to central body  [km]
+     * @return                   Geometry of source
+     */
+    SourceGeometry computeSourceGeometry( const Position& sourcePosition ) const;
+
+    //! Compute acceleration for given geometry of source.
+    Acceleration computeAcceleration( const State& state, const SourceGeometry& geometry ) const
+    {
+        Acceleration acceleration;
+        acceleration[ 0 ] = 0.0;
+        acceleration[ 1 ] = 0.0;
+        acceleration[ 2 ] = 0.0;
+
+        const double shadowFunction = computeShadowFunction( state, geometry );
+        if ( shadowFunction == 0.0 )
+        {
+            return acceleration;
+        }
+
+        const double x = state[ 0 ] - geometry.position[ 0 ];
+        const double y = state[ 1 ] - geometry.position[ 1 ];
+        const double z = state[ 2 ] - geometry.position[ 2 ];
+        const double factor
+            = shadowFunction * accelerationFactor / std::sqrt( x * x + y * y + z * z );
+
+        acceleration[ 0 ] = factor * x;
+        acceleration[ 1 ] = factor * y;
+        acceleration[ 2 ] = factor * z;
+
+        return acceleration;
+    }
+
+    //! Compute shadow function for given geometry of source.
+    double computeShadowFunction( const State& state, const SourceGeometry& geometry ) const
+    {
+        if ( shadowModel == noShadowModel )
+        {
+            return 1.0;
+        }
+
+        // Projection of position onto direction of source, measured from the central body.
+        const double projection = state[ 0 ] * geometry.direction[ 0 ]
+                                  + state[ 1 ] * geometry.direction[ 1 ]
+                                  + state[ 2 ] * geometry.direction[ 2 ];
+        if ( projection > geometry.shadowBoundaryProjection )
+        {
+            return 1.0;
+        }
+
+        const double distanceToAxisSquared = state[ 0 ] * state[ 0 ]
+                                             + state[ 1 ] * state[ 1 ]
+                                             + state[ 2 ] * state[ 2 ]
+                                             - projection * projection;
+
+        if ( shadowModel == cylindricalShadowModel )
+        {
+            return ( distanceToAxisSquared < centralBodyRadius * centralBodyRadius ) ? 0.0 : 1.0;
+        }
+
+        const double penumbraRadius
+            = ( geometry.penumbraVertexProjection - projection ) * geometry.penumbraSlope;
+        if ( distanceToAxisSquared >= penumbraRadius * penumbraRadius )
+        {
+            return 1.0;
+        }
+
+        return computeConicalShadowFunction( state, geometry );
+    }
+
+    //! Compute conical shadow function.
+    /*!
+     * Computes shadow function from the apparent radii of, and the angular separation between, the
+     * source and the central body as seen from the spacecraft.
+     *
+     * @param[in] state     Current state                                       [km; km s^-1]
+     * @param[in] geometry  Geometry of source
+     * @return              Shadow function                                     [-]
+     */
+    double computeConicalShadowFunction( const State& state,
+                                         const SourceGeometry& geometry ) const;
+
+    //! Radiation pressure acceleration factor P C_R A / m, converted to [km s^-2].
+    const double accelerationFactor;
+
+    //! Shadow model.
+    const ShadowModel shadowModel;
+
+    //! Radius of central body [km].
+    const double centralBodyRadius;
+
+    //! Radius of source [km].
+    const double sourceRadius;
+
+    //! Ephemeris containing position of source; not set for source at fixed position.
+    const ChebyshevEphemerisPtr ephemeris;
+
+    //! Index of source in ephemeris.
+    const std::size_t sourceBodyIndex;
+
+    //! Geometry of source at fixed position, or at start of ephemeris.
+    const SourceGeometry sourceGeometry;
+};
+
+typedef boost::shared_ptr< RadiationPressureModel > RadiationPressureModelPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_RADIATION_PRESSURE_MODEL_HPP
@@ -10,11 +10,27 @@
 #ifndef SCARAB_RADIATION_PRESSURE_SETTINGS_HPP
 #define SCARAB_RADIATION_PRESSURE_SETTINGS_HPP
 
+#include <string>
+
 #include "Scarab/typedefs.hpp"
 
 namespace scarab
 {
 
+//! Shadow model.
+/*!
+ * Model of the shadow cast by the central body, used to reduce the radiation pressure in eclipse.
+ */
+enum ShadowModel
+{
+    //! No shadow, i.e., always fully illuminated.
+    noShadowModel,
+    //! Cylindrical shadow: no illumination within cylinder behind central body.
+    cylindricalShadowModel,
+    //! Conical shadow: umbra and penumbra, with partial illumination in penumbra.
+    conicalShadowModel
+};
+
 //! Radiation pressure model settings.
 /*!
  * Data struct containing all valid input parameters for the radiation pressure model. This struct
@@ -37,17 +53,31 @@ public:
      * @param[in] aVectorToSource               Position vector to source of radiation
      *                                          pressure, e.g, the Sun                      [m]
      * @param[in] aRadiationPressureArea        Area subject to radiation pressure          [m^2]
+     * @param[in] aShadowModel                  Shadow model
+     * @param[in] aCentralBodyRadius            Radius of central body casting shadow       [km]
+     * @param[in] aSourceRadius                 Radius of source of radiation pressure      [km]
+     * @param[in] aSourceBodyName               Name of source in ephemeris; if set, the position
+     *                                          of the source is taken from the ephemeris
+     *                                          instead of the fixed position vector
      */
-    RadiationPressureSettings( const bool      aStatus,
-                               const double    aRadiationPressure,
-                               const double    aRadiationPressureCoefficient,
-                               const Position& aVectorToSource,
-                               const double    aRadiationPressureArea )
+    RadiationPressureSettings( const bool           aStatus,
+                               const double         aRadiationPressure,
+                               const double         aRadiationPressureCoefficient,
+                               const Position&      aVectorToSource,
+                               const double         aRadiationPressureArea,
+                               const ShadowModel    aShadowModel,
+                               const double         aCentralBodyRadius,
+                               const double         aSourceRadius,
+                               const std::string&   aSourceBodyName )
         : status( aStatus ),
           radiationPressure( aRadiationPressure ),
           radiationPressureCoefficient( aRadiationPressureCoefficient ),
           vectorToSource( aVectorToSource ),
-          radiationPressureArea( aRadiationPressureArea )
+          radiationPressureArea( aRadiationPressureArea ),
+          shadowModel( aShadowModel ),
+          centralBodyRadius( aCentralBodyRadius ),
+          sourceRadius( aSourceRadius ),
+          sourceBodyName( aSourceBodyName )
     { }
 
     //! Status.
@@ -65,6 +95,18 @@ public:
     //! Radiation pressure area [m^2].
     const double radiationPressureArea;
 
+    //! Shadow model.
+    const ShadowModel shadowModel;
+
+    //! Radius of central body casting shadow [km].
+    const double centralBodyRadius;
+
+    //! Radius of source of radiation pressure [km].
+    const double sourceRadius;
+
+    //! Name of source in ephemeris; empty for source at fixed position.
+    const std::string sourceBodyName;
+
 protected:
 
 private:
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_RANDOM_NUMBERS_HPP
+#define SCARAB_RANDOM_NUMBERS_HPP
+
+#include <cstddef>
+#include <random>
+
+namespace scarab
+{
+
+//! Random number generator.
+/*!
+ * 64-bit Mersenne Twister, whose output for a given seed is specified exactly by the C++
+ * standard. The distributions of the standard library are not: their algorithms differ between
+ * implementations, so random numbers are drawn from the generator with the functions below
+ * instead, which give the same sequence with every standard library.
+ */
+typedef std::mt19937_64 RandomNumberGenerator;
+
+//! Generate uniformly distributed random number.
+/*!
+ * Generates random number uniformly distributed in [0, 1), from the 53 most significant bits of
+ * the next output of the generator.
+ *
+ * @param[in,out] generator Random number generator
+ * @return                  Random number in [0, 1)
+ */
+double generateUniformRandomNumber( RandomNumberGenerator& generator );
+
+//! Generate random index.
+/*!
+ * Generates random index uniformly distributed in [0, number of indices), from the output of the
+ * generator modulo the number of indices. Outputs beyond the largest multiple of the number of
+ * indices are rejected, so that every index is equally likely.
+ *
+ * @param[in,out] generator         Random number generator
+ * @param[in]     numberOfIndices   Number of indices (positive)
+ * @return                          Random index
+ */
+std::size_t generateRandomIndex( RandomNumberGenerator& generator,
+                                 const std::size_t numberOfIndices );
+
+//! Generate normally distributed random number.
+/*!
+ * Generates random number from the standard normal distribution with the polar method of
+ * Marsaglia (Knuth, 1997), using only the first of the two numbers generated by every accepted
+ * pair of uniform random numbers. The result only depends on the generator output and the
+ * rounding of std::log, which is exact to within an ulp on all common platforms.
+ *
+ * @param[in,out] generator Random number generator
+ * @return                  Random number from standard normal distribution
+ */
+double generateNormalRandomNumber( RandomNumberGenerator& generator );
+
+} // namespace scarab
+
+#endif // SCARAB_RANDOM_NUMBERS_HPP
+
+/*!
+ * D.E. Knuth, The Art of Computer Programming, Volume 2: Seminumerical Algorithms, 3rd edition,
+ *  Addison-Wesley, Section 3.4.1 (1997).
+ */
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_RELATIVE_MOTION_HPP
+#define SCARAB_RELATIVE_MOTION_HPP
+
+#include <vector>
+
+#include <boost/array.hpp>
+
+#include "Scarab/simulatorSettings.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! State transition matrix (6x6, row-major).
+typedef boost::array< double, 36 > StateTransitionMatrix;
+
+//! Compute mean motion of circular orbit.
+/*!
+ * Computes mean motion of circular orbit, n = sqrt( mu / a^3 ).
+ *
+ * @param[in] gravitationalParameter    Gravitational parameter of central body [km^3 s^-2]
+ * @param[in] semiMajorAxis             Semi-major axis of circular orbit       [km]
+ * @return                              Mean motion                             [rad s^-1]
+ */
+double computeMeanMotion( const double gravitationalParameter, const double semiMajorAxis );
+
+//! Compute Clohessy-Wiltshire state transition matrix.
+/*!
+ * Computes state transition matrix of the closed-form Clohessy-Wiltshire (Hill) solution of the
+ * linearized relative motion about a target on a circular orbit. The relative state is expressed
+ * in the Hill frame of the target: x radially outward, y along-track and z along the orbital
+ * angular momentum.
+ *
+ * The matrix only depends on the elapsed time, so it can be computed once per epoch and applied to
+ * any number of initial relative states.
+ *
+ * @sa propagateRelativeState
+ * @param[in] meanMotion    Mean motion of target                               [rad s^-1]
+ * @param[in] elapsedTime   Time elapsed since initial epoch                    [s]
+ * @return                  State transition matrix                             [-; s; s^-1]
+ */
+StateTransitionMatrix computeClohessyWiltshireStateTransitionMatrix( const double meanMotion,
+                                                                     const double elapsedTime );
+
+//! Propagate relative state with state transition matrix.
+/*!
+ * Propagates relative state by multiplying it with a state transition matrix.
+ *
+ * @sa computeClohessyWiltshireStateTransitionMatrix
+ * @param[in] stateTransitionMatrix State transition matrix                     [-; s; s^-1]
+ * @param[in] initialState          Initial relative state                      [km; km s^-1]
+ * @return                          Propagated relative state                   [km; km s^-1]
+ */
+State propagateRelativeState( const StateTransitionMatrix& stateTransitionMatrix,
+                              const State& initialState );
+
+//! Propagate relative state with Clohessy-Wiltshire solution.
+/*!
+ * Propagates relative state in the Hill frame of the target to the given elapsed time, in O(1),
+ * using the closed-form Clohessy-Wiltshire solution.
+ *
+ * @sa computeClohessyWiltshireStateTransitionMatrix
+ * @param[in] meanMotion    Mean motion of target                               [rad s^-1]
+ * @param[in] initialState  Initial relative state                              [km; km s^-1]
+ * @param[in] elapsedTime   Time elapsed since initial epoch                    [s]
+ * @return                  Propagated relative state                           [km; km s^-1]
+ */
+State propagateRelativeState( const double meanMotion,
+                              const State& initialState,
+                              const double elapsedTime );
+
+//! Get output epochs of relative motion.
+/*!
+ * Gets epochs at which the relative state is written to the state history: the output epochs set
+ * within [start time, end time], or the start time plus multiples of the output interval set. If
+ * neither is set, the initial step is used as output interval.
+ *
+ * @param[in] settings  Simulator settings
+ * @return              Output epochs                                           [s]
+ */
+std::vector< double > getRelativeMotionEpochs( const SimulatorSettings& settings );
+
+//! Propagate relative motion.
+/*!
+ * Propagates initial relative state to all output epochs with the Clohessy-Wiltshire solution and
+ * passes the relative states to the state history sink.
+ *
+ * @sa getRelativeMotionEpochs, propagateRelativeState
+ * @param[in]  settings         Simulator settings
+ * @param[out] stateHistorySink State history sink
+ * @return                      Number of relative states written
+ */
+std::size_t propagateRelativeMotion( const SimulatorSettings& settings,
+                                     StateHistorySink& stateHistorySink );
+
+//! Execute relative motion.
+/*!
+ * Executes analytical relative motion propagation and writes the simulation metadata and the
+ * relative state history to file, in the same formats as the simulator.
+ *
+ * @sa executeSimulator, propagateRelativeMotion
+ * @param[in] settings Simulator settings
+ * @return             Simulation metadata written to file
+ */
+TrajectoryMetadata executeRelativeMotion( const SimulatorSettings& settings );
+
+} // namespace scarab
+
+#endif // SCARAB_RELATIVE_MOTION_HPP
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_RELATIVE_MOTION_SETTINGS_HPP
+#define SCARAB_RELATIVE_MOTION_SETTINGS_HPP
+
+namespace scarab
+{
+
+//! Relative motion settings.
+/*!
+ * Data struct containing all valid input parameters for the analytical relative motion mode. This
+ * struct is populated by the checkSimulatorSettings() function.
+ *
+ * In relative motion mode, the initial state is the state of the chaser relative to the target,
+ * expressed in the Hill frame of the target, which is on a circular orbit with the given
+ * semi-major axis. The relative state is propagated with the closed-form Clohessy-Wiltshire
+ * solution instead of numerical integration.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, executeRelativeMotion
+ */
+struct RelativeMotionSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator, executeRelativeMotion
+     * @param[in] aStatus                   Flag indicating if relative motion mode is on or off
+     * @param[in] aTargetSemiMajorAxis      Semi-major axis of circular target orbit    [km]
+     */
+    RelativeMotionSettings( const bool      aStatus,
+                            const double    aTargetSemiMajorAxis )
+        : status( aStatus ),
+          targetSemiMajorAxis( aTargetSemiMajorAxis )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Semi-major axis of circular target orbit [km].
+    const double targetSemiMajorAxis;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_RELATIVE_MOTION_SETTINGS_HPP
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_SIMULATION_HPP
+#define SCARAB_SIMULATION_HPP
+
+#include "Scarab/dataStore.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/simulatorSettings.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistory.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Simulation result.
+/*!
+ * Data struct containing the state history, final state, integration statistics and event log of
+ * a single run of a simulation. A result can be passed to successive runs, in which case the
+ * memory reserved for the state history is reused.
+ */
+struct SimulationResult
+{
+public:
+
+    //! State history, sampled as set in the output settings.
+    StateHistory stateHistory;
+
+    //! Final state at end time, or at the terminating event.
+    State finalState;
+
+    //! Integration statistics, including the final time reached.
+    IntegrationStatistics statistics;
+
+    //! Log of events triggered.
+    EventLog eventLog;
+
+protected:
+
+private:
+};
+
+//! Simulation.
+/*!
+ * Simulation that can be embedded in other programs: it takes verified simulator settings, keeps
+ * the trajectory and statistics in memory and does not write to the console or to files.
+ *
+ * The data store, acceleration models and state derivative model are built once on construction
+ * and reused by every run, so that the cost of repeated short runs is dominated by the numerical
+ * integration. Each run may start from a different initial state and cover a different time
+ * interval; all other settings are fixed for the lifetime of the simulation.
+ *
+ * A simulation always integrates the absolute trajectory of the chaser; the ensemble and sweep
+ * settings are ignored, since the caller drives the runs. A simulation is not thread-safe, so
+ * concurrent runs require one simulation per thread.
+ *
+ * @sa SimulatorSettings, executeSimulator
+ */
+class Simulation
+{
+public:
+
+    //! Construct simulation.
+    /*!
+     * Constructs simulation and builds acceleration models from simulator settings. Files
+     * referenced by the settings (ephemeris, atmosphere table, gravity field coefficients) are
+     * already loaded when the settings are checked, so no files are read here.
+     *
+     * An error is thrown if relative motion, Encke propagation or checkpoints are switched on.
+     *
+     * @param[in] aSettings Simulator settings
+     */
+    explicit Simulation( const SimulatorSettings& aSettings );
+
+    //! Run simulation.
+    /*!
+     * Integrates trajectory from the initial state and start time to the end time set in the
+     * integrator settings.
+     *
+     * @return Simulation result
+     */
+    SimulationResult run( );
+
+    //! Run simulation.
+    /*!
+     * Integrates trajectory from given initial state and start time to given end time. The
+     * result is overwritten; the memory reserved for its state history is reused.
+     *
+     * @param[in]  initialState Initial state                                   [km; km s^-1]
+     * @param[in]  startTime    Start time                                      [s]
+     * @param[in]  endTime      End time                                        [s]
+     * @param[out] result       Simulation result
+     */
+    void run( const State& initialState,
+              const double startTime,
+              const double endTime,
+              SimulationResult& result );
+
+    //! Get simulator settings.
+    /*!
+     * Returns simulator settings.
+     *
+     * @return Simulator settings
+     */
+    const SimulatorSettings& getSettings( ) const { return settings; }
+
+protected:
+
+private:
+
+    //! Copy constructor, not implemented, since models refer to the data store of the simulation.
+    Simulation( const Simulation& otherSimulation );
+
+    //! Assignment operator, not implemented.
+    Simulation& operator=( const Simulation& otherSimulation );
+
+    //! Simulator settings.
+    const SimulatorSettings settings;
+
+    //! Simulation data store, including the acceleration models.
+    DataStore data;
+
+    //! State derivative model, resolved from the acceleration models in the data store.
+    StateDerivativeModel stateDerivativeModel;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_SIMULATION_HPP
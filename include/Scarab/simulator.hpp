@@ -10,9 +10,19 @@
 #ifndef SCARAB_SIMULATOR_HPP
 #define SCARAB_SIMULATOR_HPP
 
+#include <ostream>
+#include <string>
+
+#include <boost/cstdint.hpp>
+
 #include <rapidjson/document.h>
 
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
 #include "Scarab/simulatorSettings.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/trajectoryFile.hpp"
 
 namespace scarab
 {
@@ -21,9 +31,18 @@ namespace scarab
 /*!
  * Executes simulator using parameters specified by user in JSON input file.
  *
- * @param[in] config User-defined configuration options (extracted from JSON input file)
+ * If checkpoints are on, the simulation can be resumed from the last checkpoint written by an
+ * interrupted run with the same settings; the output is then the same as that of an uninterrupted
+ * run. If no checkpoint has been written, the simulation starts from the start time.
+ *
+ * If a summary file is set in the output settings, a JSON run summary is written to it once the
+ * simulation is completed.
+ *
+ * @sa writeRunSummary
+ * @param[in] config    User-defined configuration options (extracted from JSON input file)
+ * @param[in] isResumed Flag indicating if simulation is resumed from checkpoint (default = false)
  */
-void executeSimulator( const rapidjson::Document& config );
+void executeSimulator( const rapidjson::Document& config, const bool isResumed = false );
 
 //! Check simulator settings.
 /*!
@@ -39,6 +58,93 @@ void executeSimulator( const rapidjson::Document& config );
  */
 SimulatorSettings checkSimulatorSettings( const rapidjson::Document& config );
 
+//! Get simulation metadata.
+/*!
+ * Gets simulation metadata (gravitational parameter, initial state and integrator settings) from
+ * simulator settings. The metadata is written to the metadata file and stored in the header of
+ * binary trajectory files.
+ *
+ * @sa executeSimulator, TrajectoryFileReader
+ * @param[in] settings Simulator settings
+ * @return             Simulation metadata
+ */
+TrajectoryMetadata getSimulationMetadata( const SimulatorSettings& settings );
+
+//! Get checkpoint fingerprint.
+/*!
+ * Gets fingerprint of all simulator settings that affect the trajectory: the metadata, the
+ * integrator, the chaser mass, the acceleration models and their parameters, the ephemeris, the
+ * events and the state history output. The fingerprint is stored in every checkpoint, and a
+ * simulation is only resumed from a checkpoint with the same fingerprint, so that two different
+ * trajectories are not spliced together.
+ *
+ * @sa executeSimulator, Checkpoint
+ * @param[in] settings Simulator settings
+ * @return             Checkpoint fingerprint
+ */
+boost::uint64_t getCheckpointFingerprint( const SimulatorSettings& settings );
+
+//! Add integration statistics to simulation metadata.
+/*!
+ * Adds number of function evaluations, number of accepted and rejected steps, minimum and maximum
+ * step size and final time of a numerical integration to simulation metadata.
+ *
+ * @sa getSimulationMetadata, integrateState
+ * @param[in]     statistics Integration statistics
+ * @param[in,out] metadata   Simulation metadata
+ */
+void addIntegrationStatistics( const IntegrationStatistics& statistics,
+                               TrajectoryMetadata& metadata );
+
+//! Add acceleration model timings to simulation metadata.
+/*!
+ * Adds time spent in every acceleration model of the state derivative model, e.g., as
+ * "central_gravity_time", to simulation metadata. The timings are only measured if Scarab is built
+ * with instrumentation (BUILD_INSTRUMENTATION); otherwise, nothing is added. The timings cover a
+ * single trajectory, so ensemble and sweep metadata do not contain them.
+ *
+ * @sa StateDerivativeModel
+ * @param[in]     stateDerivativeModel State derivative model
+ * @param[in,out] metadata             Simulation metadata
+ */
+void addAccelerationModelTimings( const StateDerivativeModel& stateDerivativeModel,
+                                  TrajectoryMetadata& metadata );
+
+//! Add Chebyshev trajectory statistics to simulation metadata.
+/*!
+ * Adds number of segments and maximum position and velocity errors at the samples of a Chebyshev
+ * trajectory to simulation metadata. The statistics only cover the samples fitted so far, so the
+ * writer must be flushed first; they must be added before the writer is closed, to be stored in
+ * the header of the Chebyshev trajectory file.
+ *
+ * @sa getSimulationMetadata, ChebyshevTrajectoryWriter
+ * @param[in]     writer    Chebyshev trajectory writer
+ * @param[in,out] metadata  Simulation metadata
+ */
+void addChebyshevTrajectoryStatistics( const ChebyshevTrajectoryWriter& writer,
+                                       TrajectoryMetadata& metadata );
+
+//! Write run summary.
+/*!
+ * Writes machine-readable summary of a completed run to stream in JSON format. The summary
+ * contains the simulation mode ("trajectory", "ensemble", "sweep", "relative_motion" or
+ * "encke"), the wall-clock time of the run, the simulation metadata written to the metadata file
+ * (including the integration statistics), with the value and units of every entry, and the event
+ * log. Values that are not finite are written as null.
+ *
+ * @sa executeSimulator
+ * @param[in] stream        Output stream
+ * @param[in] mode          Simulation mode
+ * @param[in] metadata      Simulation metadata
+ * @param[in] eventLog      Event log; empty if the simulation mode does not have a single log
+ * @param[in] wallClockTime Wall-clock time of run                              [s]
+ */
+void writeRunSummary( std::ostream& stream,
+                      const std::string& mode,
+                      const TrajectoryMetadata& metadata,
+                      const EventLog& eventLog,
+                      const double wallClockTime );
+
 } // namespace scarab
 
 #endif // SCARAB_SIMULATOR_HPP
@@ -14,10 +14,21 @@
 
 #include "Scarab/centralGravitySettings.hpp"
 #include "Scarab/chaserSettings.hpp"
+#include "Scarab/checkpointSettings.hpp"
+#include "Scarab/dragSettings.hpp"
+#include "Scarab/enckeSettings.hpp"
+#include "Scarab/ephemerisSettings.hpp"
+#include "Scarab/ensembleSettings.hpp"
+#include "Scarab/eventSettings.hpp"
 #include "Scarab/integratorSettings.hpp"
 #include "Scarab/outputSettings.hpp"
 #include "Scarab/radiationPressureSettings.hpp"
+#include "Scarab/relativeMotionSettings.hpp"
+#include "Scarab/sphericalHarmonicsSettings.hpp"
+#include "Scarab/sweepSettings.hpp"
 #include "Scarab/targetSettings.hpp"
+#include "Scarab/thirdBodySettings.hpp"
+#include "Scarab/typedefs.hpp"
 
 namespace scarab
 {
@@ -38,25 +49,59 @@ public:
      * Constructs data struct based on verified input parameters.
      *
      * @sa checkSimulatorSettings, executeSimulator, IntegratorSettings
-     * @param[in] integratorUserSettings        User-defined numerical integrator settings
-     * @param[in] chaserUserSettings            User-defined chaser settings
-     * @param[in] targetUserSettings            User-defined target settings
-     * @param[in] centralGravityUserSettings    User-defined central gravity model settings
-     * @param[in] radiationPressureUserSettings User-defined radiation pressure model settings
-     * @param[in] outputUserSettings            User-defined output settings
+     * @param[in] integratorUserSettings         User-defined numerical integrator settings
+     * @param[in] chaserUserSettings             User-defined chaser settings
+     * @param[in] targetUserSettings             User-defined target settings
+     * @param[in] centralGravityUserSettings     User-defined central gravity model settings
+     * @param[in] radiationPressureUserSettings  User-defined radiation pressure model settings
+     * @param[in] sphericalHarmonicsUserSettings User-defined spherical harmonics gravity model
+     *                                           settings
+     * @param[in] dragUserSettings               User-defined drag model settings
+     * @param[in] ephemerisUserSettings          User-defined ephemeris settings
+     * @param[in] thirdBodyUserSettings          User-defined third-body gravity model settings
+     * @param[in] outputUserSettings             User-defined output settings
+     * @param[in] ensembleUserSettings           User-defined ensemble settings
+     * @param[in] listOfUserModelNames           User-defined list of acceleration model names
+     * @param[in] eventUserSettings              User-defined event settings
+     * @param[in] relativeMotionUserSettings     User-defined relative motion settings
+     * @param[in] enckeUserSettings              User-defined Encke settings
+     * @param[in] checkpointUserSettings         User-defined checkpoint settings
+     * @param[in] sweepUserSettings              User-defined parameter sweep settings
      */
-    SimulatorSettings( const IntegratorSettings&        integratorUserSettings,
-                       const ChaserSettings&            chaserUserSettings,
-                       const TargetSettings&            targetUserSettings,
-                       const CentralGravitySettings&    centralGravityUserSettings,
-                       const RadiationPressureSettings& radiationPressureUserSettings,
-                       const OutputSettings&            outputUserSettings )
+    SimulatorSettings( const IntegratorSettings&         integratorUserSettings,
+                       const ChaserSettings&             chaserUserSettings,
+                       const TargetSettings&             targetUserSettings,
+                       const CentralGravitySettings&     centralGravityUserSettings,
+                       const RadiationPressureSettings&  radiationPressureUserSettings,
+                       const SphericalHarmonicsSettings& sphericalHarmonicsUserSettings,
+                       const DragSettings&               dragUserSettings,
+                       const EphemerisSettings&          ephemerisUserSettings,
+                       const ThirdBodySettings&          thirdBodyUserSettings,
+                       const OutputSettings&             outputUserSettings,
+                       const EnsembleSettings&           ensembleUserSettings,
+                       const ListOfModelNames&           listOfUserModelNames,
+                       const EventSettings&              eventUserSettings,
+                       const RelativeMotionSettings&     relativeMotionUserSettings,
+                       const EnckeSettings&              enckeUserSettings,
+                       const CheckpointSettings&         checkpointUserSettings,
+                       const SweepSettings&              sweepUserSettings )
         : integratorSettings( integratorUserSettings ),
           chaserSettings( chaserUserSettings ),
           targetSettings( targetUserSettings ),
           centralGravitySettings( centralGravityUserSettings ),
           radiationPressureSettings( radiationPressureUserSettings ),
-          outputSettings( outputUserSettings )
+          sphericalHarmonicsSettings( sphericalHarmonicsUserSettings ),
+          dragSettings( dragUserSettings ),
+          ephemerisSettings( ephemerisUserSettings ),
+          thirdBodySettings( thirdBodyUserSettings ),
+          outputSettings( outputUserSettings ),
+          ensembleSettings( ensembleUserSettings ),
+          listOfModelNames( listOfUserModelNames ),
+          eventSettings( eventUserSettings ),
+          relativeMotionSettings( relativeMotionUserSettings ),
+          enckeSettings( enckeUserSettings ),
+          checkpointSettings( checkpointUserSettings ),
+          sweepSettings( sweepUserSettings )
     { }
 
     //! Numerical integrator settings.
@@ -74,9 +119,42 @@ public:
     //! Radiation pressure model settings.
     const RadiationPressureSettings radiationPressureSettings;
 
+    //! Spherical harmonics gravity model settings.
+    const SphericalHarmonicsSettings sphericalHarmonicsSettings;
+
+    //! Drag model settings.
+    const DragSettings dragSettings;
+
+    //! Ephemeris settings.
+    const EphemerisSettings ephemerisSettings;
+
+    //! Third-body gravity model settings.
+    const ThirdBodySettings thirdBodySettings;
+
     //! Output settings.
     const OutputSettings outputSettings;
 
+    //! Ensemble settings.
+    const EnsembleSettings ensembleSettings;
+
+    //! List of names of acceleration models included in simulator.
+    const ListOfModelNames listOfModelNames;
+
+    //! Event settings.
+    const EventSettings eventSettings;
+
+    //! Relative motion settings.
+    const RelativeMotionSettings relativeMotionSettings;
+
+    //! Encke settings.
+    const EnckeSettings enckeSettings;
+
+    //! Checkpoint settings.
+    const CheckpointSettings checkpointSettings;
+
+    //! Parameter sweep settings.
+    const SweepSettings sweepSettings;
+
 protected:
 
 private:
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+/*!
+ * O. Montenbruck and E. Gill, Satellite Orbits, Springer (2000), Section 3.2.
+ * S.A. Holmes and W.E. Featherstone, A unified approach to the Clenshaw summation and the
+ *  recursive computation of very high degree and order normalised associated Legendre functions,
+ *  Journal of Geodesy 76, pp. 279-299 (2002), doi:http://dx.doi.org/10.1007/s00190-002-0216-2.
+ */
+
+#ifndef SCARAB_SPHERICAL_HARMONICS_GRAVITY_MODEL_HPP
+#define SCARAB_SPHERICAL_HARMONICS_GRAVITY_MODEL_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/sphericalHarmonicsSettings.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Read spherical harmonics coefficients.
+/*!
+ * Reads fully normalized spherical harmonics coefficients from file, up to the given degree and
+ * order. Every data line contains the degree n, order m, C_nm and S_nm, separated by whitespace
+ * or commas, optionally preceded by a "gfc" keyword and followed by further columns, e.g., the
+ * standard deviations, as in the ICGEM format; Fortran exponents ("D") are accepted. Empty lines,
+ * lines starting with "#" and header lines are skipped, as are coefficients beyond the degree and
+ * order requested.
+ *
+ * @param[in] filename  Name of coefficient file
+ * @param[in] degree    Maximum degree to read
+ * @param[in] order     Maximum order to read, not larger than degree
+ * @return              Spherical harmonics coefficients
+ */
+SphericalHarmonicsCoefficients readSphericalHarmonicsCoefficients( const std::string& filename,
+                                                                   const unsigned int degree,
+                                                                   const unsigned int order );
+
+//! Spherical harmonics gravitational acceleration model.
+/*!
+ * Gravitational acceleration due to the non-central terms of a spherical harmonics expansion of
+ * the potential, i.e., degrees 2 up to the maximum degree; the central term is given by
+ * CentralGravityModel, and the degree-1 terms vanish with the origin at the centre of mass.
+ *
+ * The acceleration is computed from the fully normalized harmonics V_nm and W_nm, i.e., the solid
+ * spherical harmonics ( R / r )^( n + 1 ) P_nm( sin phi ) cos( m lambda ) and sin( m lambda ),
+ * times the normalization factors of the coefficients (Montenbruck and Gill, 2000). The
+ * normalized sectoral, first and second column recursions are numerically stable up to high
+ * degree (Holmes and Featherstone, 2002), and need no trigonometric functions: the sectoral
+ * recursion in x and y generates the terms cos( m lambda ) and sin( m lambda ) of each order from
+ * those of the previous order. The formulation has no singularity at the poles.
+ *
+ * All recursion and acceleration factors are computed once on construction; the harmonics are
+ * stored in work buffers that are allocated once per thread, so that evaluations do not allocate
+ * and the model can be evaluated concurrently.
+ *
+ * The coefficients are given in a frame that rotates with the central body about the z-axis at a
+ * constant rate, aligned with the frame of the state at time zero.
+ */
+class SphericalHarmonicsGravityModel final : public AccelerationModel< Acceleration >
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs spherical harmonics gravity model.
+     *
+     * @param[in] aGravitationalParameter   Gravitational parameter of central body [km^3 s^-2]
+     * @param[in] aReferenceRadius          Reference radius of coefficients        [km]
+     * @param[in] someCoefficients          Fully normalized coefficients
+     * @param[in] aRotationRate             Rotation rate of central body about z-axis
+     *                                      (default = 0)                           [rad s^-1]
+     */
+    SphericalHarmonicsGravityModel( const double                            aGravitationalParameter,
+                                    const double                            aReferenceRadius,
+                                    const SphericalHarmonicsCoefficients&   someCoefficients,
+                                    const double                            aRotationRate = 0.0 );
+
+    //! Compute acceleration.
+    /*!
+     * Computes gravitational acceleration due to the non-central terms of the expansion.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time                                            [s]
+     * @return          Computed acceleration                                   [km s^-2]
+     */
+    Acceleration operator( )( const State& state, const double time ) const;
+
+    //! Get maximum degree.
+    /*!
+     * Returns maximum degree of expansion.
+     *
+     * @return Maximum degree
+     */
+    unsigned int getDegree( ) const { return coefficients.degree; }
+
+protected:
+
+private:
+
+    //! Gravitational parameter of central body [km^3 s^-2].
+    const double gravitationalParameter;
+
+    //! Reference radius of coefficients [km].
+    const double referenceRadius;
+
+    //! Fully normalized coefficients.
+    const SphericalHarmonicsCoefficients coefficients;
+
+    //! Rotation rate of central body about z-axis [rad s^-1].
+    const double rotationRate;
+
+    //! Sectoral recursion factors, per order up to maximum degree + 1.
+    std::vector< double > sectoralFactors;
+
+    //! Factors of first term of column recursion, per degree and order up to maximum degree + 1.
+    std::vector< double > firstColumnFactors;
+
+    //! Factors of second term of column recursion, per degree and order up to maximum degree + 1.
+    std::vector< double > secondColumnFactors;
+
+    //! Factors of harmonics of order m + 1 in horizontal acceleration, per degree and order.
+    std::vector< double > upperOrderFactors;
+
+    //! Factors of harmonics of order m - 1 in horizontal acceleration, per degree and order.
+    std::vector< double > lowerOrderFactors;
+
+    //! Factors of harmonics of order m in vertical acceleration, per degree and order.
+    std::vector< double > sameOrderFactors;
+};
+
+//! Pointer to spherical harmonics gravity model.
+typedef boost::shared_ptr< SphericalHarmonicsGravityModel > SphericalHarmonicsGravityModelPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_SPHERICAL_HARMONICS_GRAVITY_MODEL_HPP
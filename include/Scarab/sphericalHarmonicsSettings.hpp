@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_SPHERICAL_HARMONICS_SETTINGS_HPP
+#define SCARAB_SPHERICAL_HARMONICS_SETTINGS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+
+//! Spherical harmonics coefficients.
+/*!
+ * Data struct containing the fully normalized cosine and sine coefficients of a spherical
+ * harmonics expansion of the gravitational potential, up to a maximum degree and order. The
+ * coefficients are stored row by row in triangular arrays, i.e., the coefficient of degree n and
+ * order m is at index n ( n + 1 ) / 2 + m.
+ */
+struct SphericalHarmonicsCoefficients
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct with all coefficients set to zero.
+     *
+     * @param[in] aDegree   Maximum degree
+     * @param[in] anOrder   Maximum order, not larger than maximum degree
+     */
+    SphericalHarmonicsCoefficients( const unsigned int aDegree,
+                                    const unsigned int anOrder )
+        : degree( aDegree ),
+          order( anOrder ),
+          cosineCoefficients( getIndex( aDegree, aDegree ) + 1, 0.0 ),
+          sineCoefficients( getIndex( aDegree, aDegree ) + 1, 0.0 )
+    { }
+
+    //! Get index of coefficient.
+    /*!
+     * Returns index of coefficient of given degree and order in triangular arrays.
+     *
+     * @param[in] n Degree
+     * @param[in] m Order, not larger than degree
+     * @return      Index of coefficient
+     */
+    static std::size_t getIndex( const unsigned int n, const unsigned int m )
+    {
+        return static_cast< std::size_t >( n ) * ( n + 1 ) / 2 + m;
+    }
+
+    //! Maximum degree.
+    unsigned int degree;
+
+    //! Maximum order.
+    unsigned int order;
+
+    //! Fully normalized cosine coefficients C_nm [-].
+    std::vector< double > cosineCoefficients;
+
+    //! Fully normalized sine coefficients S_nm [-].
+    std::vector< double > sineCoefficients;
+
+protected:
+
+private:
+};
+
+//! Gravity field interpolation settings.
+/*!
+ * Data struct containing all valid input parameters for the interpolation grid of the spherical
+ * harmonics gravity model.
+ *
+ * @sa SphericalHarmonicsSettings, InterpolatedAccelerationModel
+ */
+struct GravityInterpolationSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] aStatus               Flag indicating if interpolation is on or off
+     * @param[in] aCellSize             Size of cubic cells of grid                 [km]
+     * @param[in] aTolerance            Tolerance on error estimate of cells        [km s^-2]
+     * @param[in] aMaximumNumberOfCells Maximum number of cells in grid
+     */
+    GravityInterpolationSettings( const bool          aStatus,
+                                  const double        aCellSize,
+                                  const double        aTolerance,
+                                  const std::size_t   aMaximumNumberOfCells )
+        : status( aStatus ),
+          cellSize( aCellSize ),
+          tolerance( aTolerance ),
+          maximumNumberOfCells( aMaximumNumberOfCells )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Size of cubic cells of grid [km].
+    const double cellSize;
+
+    //! Tolerance on error estimate of cells [km s^-2].
+    const double tolerance;
+
+    //! Maximum number of cells in grid.
+    const std::size_t maximumNumberOfCells;
+
+protected:
+
+private:
+};
+
+//! Spherical harmonics gravity model settings.
+/*!
+ * Data struct containing all valid input parameters for the spherical harmonics gravity model.
+ * This struct is populated by the checkSimulatorSettings() function, which also reads the
+ * coefficients from file, so that they are read once, also for ensembles.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, SphericalHarmonicsGravityModel
+ */
+struct SphericalHarmonicsSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] aStatus               Flag indicating if model is on or off
+     * @param[in] aCoefficientFilename  Name of coefficient file
+     * @param[in] someCoefficients      Coefficients read from file, up to degree and order set
+     * @param[in] aReferenceRadius      Reference radius of coefficients            [km]
+     * @param[in] aRotationRate         Rotation rate of central body about z-axis  [rad s^-1]
+     * @param[in] someInterpolationSettings Gravity field interpolation settings
+     */
+    SphericalHarmonicsSettings( const bool                              aStatus,
+                                const std::string&                      aCoefficientFilename,
+                                const SphericalHarmonicsCoefficients&   someCoefficients,
+                                const double                            aReferenceRadius,
+                                const double                            aRotationRate,
+                                const GravityInterpolationSettings&     someInterpolationSettings )
+        : status( aStatus ),
+          coefficientFilename( aCoefficientFilename ),
+          coefficients( someCoefficients ),
+          referenceRadius( aReferenceRadius ),
+          rotationRate( aRotationRate ),
+          interpolationSettings( someInterpolationSettings )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Name of coefficient file.
+    const std::string coefficientFilename;
+
+    //! Coefficients, up to degree and order set.
+    const SphericalHarmonicsCoefficients coefficients;
+
+    //! Reference radius of coefficients [km].
+    const double referenceRadius;
+
+    //! Rotation rate of central body about z-axis [rad s^-1].
+    const double rotationRate;
+
+    //! Gravity field interpolation settings.
+    const GravityInterpolationSettings interpolationSettings;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_SPHERICAL_HARMONICS_SETTINGS_HPP
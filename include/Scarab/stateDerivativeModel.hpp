@@ -10,6 +10,16 @@
 #ifndef SCARAB_STATE_DERIVATIVE_MODEL_HPP
 #define SCARAB_STATE_DERIVATIVE_MODEL_HPP
 
+#include <cstddef>
+#include <stdexcept>
+
+#ifdef SCARAB_INSTRUMENTATION
+#include <chrono>
+#endif
+
+#include <boost/array.hpp>
+
+#include "Scarab/accelerationModel.hpp"
 #include "Scarab/accelerationModelId.hpp"
 #include "Scarab/dataStore.hpp"
 #include "Scarab/typedefs.hpp"
@@ -17,12 +27,31 @@
 namespace scarab
 {
 
+#ifdef SCARAB_INSTRUMENTATION
+//! Interval of state derivative evaluations at which acceleration models are timed.
+const unsigned int accelerationModelTimingInterval = 16;
+#endif
+
 //! State derivative model.
 /*!
  * State derivative model that can be used to compute the state derivative for a given state and
  * parameter values at a given epoch. This model fulfills the requirements to be used with the
  * Boost odeint library (K. Ahnert and M. Mulansky, 2011).
  *
+ * On construction, the acceleration models in the data store are resolved into a fixed-size,
+ * contiguous array of model pointers. Evaluating the state derivative walks this array, so it
+ * does not allocate memory or touch the reference counts of the shared model pointers. The list
+ * of acceleration models in the data store must therefore be populated before the state
+ * derivative model is constructed and must not be changed afterwards.
+ *
+ * If Scarab is built with instrumentation (BUILD_INSTRUMENTATION, which defines
+ * SCARAB_INSTRUMENTATION), the time spent in every acceleration model is sampled with
+ * std::chrono::steady_clock: only every accelerationModelTimingInterval-th evaluation is timed,
+ * reading the clock once per model, and the accumulated times are scaled by the ratio of all to
+ * timed evaluations. The timings are kept in the state derivative model, so an instrumented model
+ * must not be evaluated by multiple threads at once, and they cover a single trajectory; ensemble
+ * and sweep runs do not report them. Without instrumentation, no timing code is compiled in.
+ *
  * @sa <a href="http://www.odeint.com">odeint</a>
  */
 class StateDerivativeModel
@@ -36,21 +65,72 @@ public:
      * @param[in] aDataStore Data store containing simulation data
      */
     StateDerivativeModel( DataStore& aDataStore )
-        : data( aDataStore )
-    { }
+        : data( aDataStore ),
+          numberOfAccelerationModels( 0 )
+    {
+        if ( data.listOfAccelerationModels.size( ) > accelerationModels.size( ) )
+        {
+            throw std::runtime_error( "ERROR: Too many acceleration models in data store!" );
+        }
+
+#ifdef SCARAB_INSTRUMENTATION
+        numberOfEvaluations = 0;
+        numberOfTimedEvaluations = 0;
+#endif
+
+        for ( ListOfAccelerationModels::const_iterator it = data.listOfAccelerationModels.begin( );
+              it != data.listOfAccelerationModels.end( );
+              it++ )
+        {
+            accelerationModels[ numberOfAccelerationModels ] = it->second.get( );
+#ifdef SCARAB_INSTRUMENTATION
+            accelerationModelIds[ numberOfAccelerationModels ] = it->first;
+            accelerationModelTimes[ numberOfAccelerationModels ]
+                = std::chrono::steady_clock::duration::zero( );
+#endif
+            numberOfAccelerationModels++;
+        }
+    }
 
-    void operator( )( const State& state, State& stateDerivative, double time )
+    //! Compute state derivative.
+    /*!
+     * Computes state derivative by overloading ()-operator. The acceleration is the sum of the
+     * accelerations computed by all acceleration models.
+     *
+     * @param[in]  state            Current state                               [km; km s^-1]
+     * @param[out] stateDerivative  Computed state derivative           [km s^-1; km s^-2]
+     * @param[in]  time             Current time                                [s]
+     */
+    void operator( )( const State& state, State& stateDerivative, const double time ) const
     {
         Acceleration acceleration;
         acceleration[ 0 ] = 0.0;
         acceleration[ 1 ] = 0.0;
         acceleration[ 2 ] = 0.0;
-        ListOfAccelerationModels modelList = data.listOfAccelerationModels;
-        for ( ListOfAccelerationModels::iterator it = modelList.begin( );
-              it != modelList.end( );
-              it++ )
+
+#ifdef SCARAB_INSTRUMENTATION
+        const bool isTimed = ( numberOfEvaluations++ % accelerationModelTimingInterval == 0 );
+        std::chrono::steady_clock::time_point lastTime;
+        if ( isTimed )
         {
-            Acceleration _acceleration = ( *it->second )( state, time );
+            numberOfTimedEvaluations++;
+            lastTime = std::chrono::steady_clock::now( );
+        }
+#endif
+
+        for ( unsigned int j = 0; j < numberOfAccelerationModels; j++ )
+        {
+            const Acceleration _acceleration = ( *accelerationModels[ j ] )( state, time );
+
+#ifdef SCARAB_INSTRUMENTATION
+            if ( isTimed )
+            {
+                const std::chrono::steady_clock::time_point currentTime
+                    = std::chrono::steady_clock::now( );
+                accelerationModelTimes[ j ] += currentTime - lastTime;
+                lastTime = currentTime;
+            }
+#endif
 
             for ( unsigned int i = 0; i < _acceleration.size( ); i++ )
             {
@@ -66,12 +146,75 @@ public:
         stateDerivative[ 5 ] = acceleration[ 2 ];
     }
 
+#ifdef SCARAB_INSTRUMENTATION
+    //! Get number of acceleration models.
+    /*!
+     * Returns number of acceleration models resolved from data store.
+     *
+     * @return Number of acceleration models
+     */
+    unsigned int getNumberOfAccelerationModels( ) const { return numberOfAccelerationModels; }
+
+    //! Get acceleration model ID.
+    /*!
+     * Returns ID of acceleration model at given index, in order of acceleration model ID.
+     *
+     * @param[in] index Index of acceleration model
+     * @return          Acceleration model ID
+     */
+    AccelerationModelId getAccelerationModelId( const unsigned int index ) const
+    {
+        return accelerationModelIds[ index ];
+    }
+
+    //! Get time spent in acceleration model.
+    /*!
+     * Returns time spent in acceleration model at given index over all evaluations of the state
+     * derivative model, estimated from the timed evaluations.
+     *
+     * @param[in] index Index of acceleration model
+     * @return          Time spent in acceleration model                        [s]
+     */
+    double getAccelerationModelTime( const unsigned int index ) const
+    {
+        if ( numberOfTimedEvaluations == 0 )
+        {
+            return 0.0;
+        }
+
+        return std::chrono::duration< double >( accelerationModelTimes[ index ] ).count( )
+            * static_cast< double >( numberOfEvaluations )
+            / static_cast< double >( numberOfTimedEvaluations );
+    }
+#endif
+
 protected:
 
 private:
 
     //! Simulation data store.
     const DataStore& data;
+
+    //! Acceleration models resolved from data store, in order of acceleration model ID.
+    boost::array< const AccelerationModel3d*, numberOfAccelerationModelIds > accelerationModels;
+
+    //! Number of acceleration models resolved from data store.
+    unsigned int numberOfAccelerationModels;
+
+#ifdef SCARAB_INSTRUMENTATION
+    //! IDs of acceleration models resolved from data store.
+    boost::array< AccelerationModelId, numberOfAccelerationModelIds > accelerationModelIds;
+
+    //! Time spent in acceleration models, accumulated over timed evaluations.
+    mutable boost::array< std::chrono::steady_clock::duration, numberOfAccelerationModelIds >
+        accelerationModelTimes;
+
+    //! Number of evaluations of state derivative model.
+    mutable std::size_t numberOfEvaluations;
+
+    //! Number of timed evaluations of state derivative model.
+    mutable std::size_t numberOfTimedEvaluations;
+#endif
 };
 
 } // namespace scarab
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_STATE_HISTORY_HPP
+#define SCARAB_STATE_HISTORY_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/array.hpp>
+
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! State history.
+/*!
+ * Time series of states, stored contiguously: the epochs are stored in their own array and each
+ * of the six state components in its own column (structure-of-arrays). Compared to a node-based
+ * container, appending a sample does not allocate once the capacity has been reserved, a sample
+ * takes 56 bytes and iterating over the history walks contiguous memory.
+ *
+ * The history is append-only and the epochs are strictly ascending, so that samples can be looked
+ * up by binary search on the epoch array. A sample appended at the epoch of the last sample
+ * replaces the last sample.
+ */
+class StateHistory
+{
+public:
+
+    //! Number of state components.
+    static const std::size_t numberOfComponents = 6;
+
+    //! Maximum capacity returned by capacity estimate.
+    static const std::size_t maximumEstimatedCapacity = 1048576;
+
+    //! Construct empty state history.
+    /*!
+     * Constructs empty state history, without reserving capacity.
+     */
+    StateHistory( ) { }
+
+    //! Construct empty state history with reserved capacity.
+    /*!
+     * Constructs empty state history and reserves capacity for a given number of samples.
+     *
+     * @sa estimateCapacity
+     * @param[in] aCapacity Number of samples to reserve capacity for
+     */
+    explicit StateHistory( const std::size_t aCapacity ) { reserve( aCapacity ); }
+
+    //! Estimate capacity.
+    /*!
+     * Estimates number of samples in a state history between start and end time, given the
+     * (initial) step size, e.g., the end_time and initial_step of the integrator settings. The
+     * estimate is capped at maximumEstimatedCapacity, so that a tiny initial step of an adaptive
+     * integrator does not reserve an excessive amount of memory; the history grows beyond the
+     * reserved capacity if needed.
+     *
+     * @param[in] startTime Start time                                              [s]
+     * @param[in] endTime   End time                                                [s]
+     * @param[in] stepSize  Step size                                               [s]
+     * @return              Estimated number of samples
+     */
+    static std::size_t estimateCapacity( const double startTime,
+                                         const double endTime,
+                                         const double stepSize );
+
+    //! Reserve capacity.
+    /*!
+     * Reserves capacity in the epoch array and state columns for a given number of samples.
+     *
+     * @param[in] aCapacity Number of samples to reserve capacity for
+     */
+    void reserve( const std::size_t aCapacity );
+
+    //! Get capacity.
+    /*!
+     * Returns number of samples that can be stored without reallocation.
+     *
+     * @return Capacity
+     */
+    std::size_t capacity( ) const { return times.capacity( ); }
+
+    //! Get number of samples.
+    /*!
+     * Returns number of samples in state history.
+     *
+     * @return Number of samples
+     */
+    std::size_t size( ) const { return times.size( ); }
+
+    //! Check if state history is empty.
+    /*!
+     * Checks if state history contains no samples.
+     *
+     * @return True if state history is empty
+     */
+    bool empty( ) const { return times.empty( ); }
+
+    //! Clear state history.
+    /*!
+     * Removes all samples from state history; the reserved capacity is retained.
+     */
+    void clear( );
+
+    //! Append sample.
+    /*!
+     * Appends sample to end of state history. The epoch must not precede the epoch of the last
+     * sample; a sample at the epoch of the last sample replaces the last sample.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void append( const double time, const State& state )
+    {
+        if ( !times.empty( ) && time <= times.back( ) )
+        {
+            if ( time < times.back( ) )
+            {
+                throw std::runtime_error(
+                    "ERROR: Epoch of sample appended to state history precedes last epoch!" );
+            }
+
+            for ( std::size_t i = 0; i < numberOfComponents; i++ )
+            {
+                components[ i ].back( ) = state[ i ];
+            }
+            return;
+        }
+
+        times.push_back( time );
+        for ( std::size_t i = 0; i < numberOfComponents; i++ )
+        {
+            components[ i ].push_back( state[ i ] );
+        }
+    }
+
+    //! Get epoch of sample.
+    /*!
+     * Returns epoch of sample at given index.
+     *
+     * @param[in] index Index of sample
+     * @return          Epoch of sample                                             [s]
+     */
+    double getTime( const std::size_t index ) const { return times[ index ]; }
+
+    //! Get epochs.
+    /*!
+     * Returns contiguous, strictly ascending array of epochs of all samples.
+     *
+     * @return Epochs of samples                                                    [s]
+     */
+    const std::vector< double >& getTimes( ) const { return times; }
+
+    //! Get state component column.
+    /*!
+     * Returns pointer to contiguous array containing given state component for all samples.
+     *
+     * @param[in] component Index of state component (0 = x, ..., 5 = vz)
+     * @return              Pointer to component column
+     */
+    const double* getComponent( const std::size_t component ) const
+    {
+        return components[ component ].data( );
+    }
+
+    //! Get state of sample.
+    /*!
+     * Gathers state of sample at given index from state component columns.
+     *
+     * @param[in] index Index of sample
+     * @return          State of sample                                             [km; km s^-1]
+     */
+    State getState( const std::size_t index ) const
+    {
+        State state;
+        for ( std::size_t i = 0; i < numberOfComponents; i++ )
+        {
+            state[ i ] = components[ i ][ index ];
+        }
+        return state;
+    }
+
+    //! Find sample at or before time.
+    /*!
+     * Finds index of last sample with epoch not after given time, by binary search on the epoch
+     * array. Returns size() if the state history is empty or if the time precedes the first epoch.
+     *
+     * @param[in] time Time                                                         [s]
+     * @return         Index of last sample with epoch <= time, or size() if there is none
+     */
+    std::size_t findIndex( const double time ) const;
+
+    //! Find sample at time.
+    /*!
+     * Finds index of sample at exactly the given epoch, by binary search on the epoch array.
+     *
+     * @param[in] time Epoch                                                        [s]
+     * @return         Index of sample at epoch, or size() if there is none
+     */
+    std::size_t find( const double time ) const;
+
+protected:
+
+private:
+
+    //! Epochs of samples, strictly ascending [s].
+    std::vector< double > times;
+
+    //! State component columns [km; km s^-1].
+    boost::array< std::vector< double >, numberOfComponents > components;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_STATE_HISTORY_HPP
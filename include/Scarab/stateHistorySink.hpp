@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_STATE_HISTORY_SINK_HPP
+#define SCARAB_STATE_HISTORY_SINK_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/stateHistory.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! State history sink.
+/*!
+ * State history sink base class. A sink receives the samples of the state history (epoch and
+ * state) one at a time from the event manager, during integration.
+ *
+ * @sa EventManager
+ */
+class StateHistorySink
+{
+public:
+
+    //! Write sample.
+    /*!
+     * Writes a sample of the state history to the sink.
+     *
+     * This if a pure virtual function, hence it must be implemented by any derived classes.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    virtual void write( const double time, const State& state ) = 0;
+
+    //! Flush sink.
+    /*!
+     * Flushes any samples buffered by the sink. The default implementation does nothing.
+     */
+    virtual void flush( ) { }
+
+    //! Write checkpoint.
+    /*!
+     * Writes state of sink to checkpoint, such that the sink can continue writing samples when the
+     * simulation is resumed. Samples written before the checkpoint must be retained by the sink.
+     * The default implementation throws an error, since not every sink supports checkpoints.
+     *
+     * @sa restoreCheckpoint
+     * @param[in,out] checkpoint Checkpoint
+     */
+    virtual void writeCheckpoint( Checkpoint& /* checkpoint */ )
+    {
+        throw std::runtime_error( "ERROR: State history sink does not support checkpoints!" );
+    }
+
+    //! Restore checkpoint.
+    /*!
+     * Restores state of sink from checkpoint, such that samples written after the checkpoint are
+     * discarded and the sink continues as if the simulation had not been interrupted. The default
+     * implementation throws an error, since not every sink supports checkpoints.
+     *
+     * @sa writeCheckpoint
+     * @param[in,out] checkpoint Checkpoint
+     */
+    virtual void restoreCheckpoint( Checkpoint& /* checkpoint */ )
+    {
+        throw std::runtime_error( "ERROR: State history sink does not support checkpoints!" );
+    }
+
+    //! Default destructor.
+    /*!
+     * Calls default (virtual) destructor.
+     */
+    virtual ~StateHistorySink( ) { }
+
+protected:
+
+private:
+};
+
+//! State history recorder.
+/*!
+ * State history sink that records all samples in a state history container in memory. Memory use
+ * grows with the number of samples; the recorder is intended for short runs and for tests.
+ */
+class StateHistoryRecorder : public StateHistorySink
+{
+public:
+
+    //! Construct recorder.
+    /*!
+     * Constructs recorder that appends samples to the given state history.
+     *
+     * @param[in] aStateHistory State history
+     */
+    StateHistoryRecorder( StateHistory& aStateHistory )
+        : stateHistory( aStateHistory )
+    { }
+
+    //! Write sample.
+    /*!
+     * Appends sample to state history. Samples must be written in chronological order; a sample at
+     * the epoch of the last sample replaces the last sample.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void write( const double time, const State& state )
+    {
+        stateHistory.append( time, state );
+    }
+
+    //! State history.
+    StateHistory& stateHistory;
+
+protected:
+
+private:
+};
+
+//! Streaming state history writer.
+/*!
+ * State history sink that streams samples to an output stream in Comma-Separated Value (CSV)
+ * format. Samples are collected in a buffer of fixed size and written to the stream as one chunk
+ * once the buffer is full, so that memory use is bounded by the chunk size, independent of the
+ * duration of the simulation.
+ *
+ * Values are written with the shortest representation that parses back to exactly the same
+ * double, and each chunk is formatted into a reusable text buffer and written to the stream with
+ * a single call, which is an order of magnitude faster than print().
+ *
+ * @sa formatShortestDouble, print
+ */
+class StreamingStateHistoryWriter : public StateHistorySink
+{
+public:
+
+    //! Construct streaming writer.
+    /*!
+     * Constructs streaming writer and writes header to stream.
+     *
+     * @param[out] aStream       Output stream
+     * @param[in]  aChunkSize    Number of samples buffered before writing to stream
+     * @param[in]  streamHeader  A header for the output stream (default = "")
+     */
+    StreamingStateHistoryWriter( std::ostream& aStream,
+                                 const std::size_t aChunkSize,
+                                 const std::string& streamHeader = "" );
+
+    //! Destruct streaming writer.
+    /*!
+     * Writes remaining buffered samples to stream.
+     */
+    ~StreamingStateHistoryWriter( );
+
+    //! Write sample.
+    /*!
+     * Adds sample to buffer, and writes buffer to stream if it is full.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void write( const double time, const State& state );
+
+    //! Flush sink.
+    /*!
+     * Writes buffered samples to stream and flushes stream.
+     */
+    void flush( );
+
+    //! Write checkpoint.
+    /*!
+     * Flushes writer and writes number of samples and position in stream to checkpoint.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void writeCheckpoint( Checkpoint& checkpoint );
+
+    //! Restore checkpoint.
+    /*!
+     * Restores number of samples and moves to position in stream stored in checkpoint, such that
+     * the samples written after the checkpoint are overwritten. The stream must therefore be
+     * opened without truncating the existing output. Output after the position stored in the
+     * checkpoint is not removed from the stream; for files, CsvStateHistoryFileWriter truncates
+     * the file to this position.
+     *
+     * @sa CsvStateHistoryFileWriter
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void restoreCheckpoint( Checkpoint& checkpoint );
+
+    //! Get number of samples written.
+    /*!
+     * Returns number of samples accepted by the writer, including samples that are still buffered.
+     *
+     * @return Number of samples written
+     */
+    std::size_t getNumberOfSamples( ) const { return numberOfSamples; }
+
+protected:
+
+private:
+
+    //! Write buffered samples to stream.
+    void writeChunk( );
+
+    //! Output stream.
+    std::ostream& stream;
+
+    //! Number of samples buffered before writing to stream.
+    const std::size_t chunkSize;
+
+    //! Buffered samples, stored as epoch followed by state, per sample.
+    std::vector< double > buffer;
+
+    //! Number of buffered samples.
+    std::size_t numberOfBufferedSamples;
+
+    //! Number of samples accepted by the writer.
+    std::size_t numberOfSamples;
+
+    //! Text buffer, used to format a chunk before writing it to stream.
+    std::vector< char > text;
+};
+
+//! CSV state history file writer.
+/*!
+ * State history sink that streams samples to a Comma-Separated Value (CSV) file, using a
+ * streaming state history writer. When restored from a checkpoint, the file is truncated to the
+ * position stored in the checkpoint, so that no output of the interrupted simulation is left
+ * behind the samples written after resuming.
+ *
+ * @sa StreamingStateHistoryWriter
+ */
+class CsvStateHistoryFileWriter : public StateHistorySink
+{
+public:
+
+    //! Construct CSV file writer.
+    /*!
+     * Constructs CSV file writer, which opens the file and writes the header. The file is
+     * truncated, unless the simulation is resumed, in which case the existing output is kept
+     * until the writer is restored from the checkpoint. An error is thrown if the file cannot be
+     * opened.
+     *
+     * @param[in] aFilename     Name of CSV file
+     * @param[in] aChunkSize    Number of samples buffered before writing to file
+     * @param[in] fileHeader    A header for the CSV file
+     * @param[in] isResumed     Flag indicating if simulation is resumed from a checkpoint
+     */
+    CsvStateHistoryFileWriter( const std::string& aFilename,
+                               const std::size_t aChunkSize,
+                               const std::string& fileHeader,
+                               const bool isResumed );
+
+    //! Write sample.
+    /*!
+     * Writes sample to streaming writer.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void write( const double time, const State& state ) { writer.write( time, state ); }
+
+    //! Flush sink.
+    /*!
+     * Writes buffered samples to file and flushes file.
+     */
+    void flush( ) { writer.flush( ); }
+
+    //! Write checkpoint.
+    /*!
+     * Writes checkpoint of streaming writer.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void writeCheckpoint( Checkpoint& checkpoint ) { writer.writeCheckpoint( checkpoint ); }
+
+    //! Restore checkpoint.
+    /*!
+     * Restores streaming writer from checkpoint and truncates file to the position stored in the
+     * checkpoint. An error is thrown if the file cannot be truncated.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void restoreCheckpoint( Checkpoint& checkpoint );
+
+    //! Get number of samples written.
+    /*!
+     * Returns number of samples accepted by the writer, including samples that are still buffered.
+     *
+     * @return Number of samples written
+     */
+    std::size_t getNumberOfSamples( ) const { return writer.getNumberOfSamples( ); }
+
+protected:
+
+private:
+
+    //! Name of CSV file.
+    const std::string filename;
+
+    //! CSV file.
+    std::fstream file;
+
+    //! Streaming writer to CSV file.
+    StreamingStateHistoryWriter writer;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_STATE_HISTORY_SINK_HPP
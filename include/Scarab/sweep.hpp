@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_SWEEP_HPP
+#define SCARAB_SWEEP_HPP
+
+#include <string>
+#include <vector>
+
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/simulatorSettings.hpp"
+#include "Scarab/sweepSettings.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Values of the sweep parameters of a run, in the order of the sweep parameter definitions.
+typedef std::vector< double > SweepPoint;
+
+//! Sweep run.
+/*!
+ * Data struct containing the parameter values and the propagated final state of a single run of a
+ * parameter sweep. If the run is terminated by an event, the final state is the state at the
+ * event.
+ */
+struct SweepRun
+{
+public:
+
+    //! Index of run in sweep.
+    unsigned int index;
+
+    //! Values of sweep parameters.
+    SweepPoint point;
+
+    //! Final state at end time, or at the terminating event.
+    State finalState;
+
+    //! Integration statistics, including the final time reached.
+    IntegrationStatistics statistics;
+
+    //! Log of events triggered.
+    EventLog eventLog;
+
+protected:
+
+private:
+};
+
+//! Sweep of propagated runs, ordered by run index.
+typedef std::vector< SweepRun > Sweep;
+
+//! Get sweep parameter.
+/*!
+ * Returns sweep parameter corresponding to name given. The names match the names of the
+ * simulation metadata and of the settings in the JSON input file.
+ *
+ * @sa getSweepParameterName
+ * @param[in] parameterName Name of sweep parameter
+ * @return                  Sweep parameter
+ */
+SweepParameter getSweepParameter( const std::string& parameterName );
+
+//! Get sweep parameter name.
+/*!
+ * Returns name of sweep parameter.
+ *
+ * @sa getSweepParameter
+ * @param[in] parameter Sweep parameter
+ * @return              Name of sweep parameter
+ */
+std::string getSweepParameterName( const SweepParameter parameter );
+
+//! Expand sweep.
+/*!
+ * Expands the parameters of a sweep into the list of points at which runs are propagated.
+ *
+ * For a grid sweep, the points are the Cartesian product of the grid points of all parameters,
+ * with the last parameter varying fastest. For a Latin hypercube sweep, the range of every
+ * parameter is divided into as many strata of equal width as there are samples, and every
+ * stratum is sampled exactly once per parameter; the strata are combined across parameters by
+ * random permutations. The permutations and samples are computed from the raw output of the
+ * random number generator, so they only depend on the seed and not on the standard library.
+ *
+ * @param[in] settings Sweep settings
+ * @return             List of sweep points, ordered by run index
+ */
+std::vector< SweepPoint > expandSweep( const SweepSettings& settings );
+
+//! Get simulator settings of sweep run.
+/*!
+ * Returns a copy of the simulator settings in which the sweep parameters are set to the values
+ * of the given sweep point. Throws if the settings of the run are invalid, e.g., if the end time
+ * is before the start time, or if a mass or area is negative.
+ *
+ * @param[in] settings  Simulator settings
+ * @param[in] point     Values of sweep parameters
+ * @return              Simulator settings of sweep run
+ */
+SimulatorSettings getSweepRunSettings( const SimulatorSettings& settings,
+                                       const SweepPoint& point );
+
+//! Propagate sweep run.
+/*!
+ * Propagates a single run of a sweep from its initial state to the end time. Each call constructs
+ * its own data store, acceleration models and state derivative model, so that runs can be
+ * propagated concurrently. Data read from file (e.g., ephemerides and gravity field coefficients)
+ * is shared between runs through the simulator settings.
+ *
+ * @sa getSweepRunSettings
+ * @param[in] settings  Simulator settings
+ * @param[in] point     Values of sweep parameters
+ * @param[in] runIndex  Index of run
+ * @return              Propagated sweep run
+ */
+SweepRun propagateSweepRun( const SimulatorSettings& settings,
+                            const SweepPoint& point,
+                            const unsigned int runIndex );
+
+//! Propagate sweep.
+/*!
+ * Expands sweep and propagates all runs concurrently on a work-stealing thread pool, which
+ * balances runs of different duration across the worker threads. The result is independent of
+ * the number of threads used. The settings of all runs are checked before any run is propagated.
+ *
+ * @sa expandSweep, propagateSweepRun, ThreadPool
+ * @param[in] settings Simulator settings
+ * @return             Propagated sweep, ordered by run index
+ */
+Sweep propagateSweep( const SimulatorSettings& settings );
+
+//! Execute sweep.
+/*!
+ * Executes parameter sweep and writes the simulation metadata and the parameter values and final
+ * states of all runs to one file, indexed by run.
+ *
+ * @sa executeSimulator, propagateSweep
+ * @param[in] settings Simulator settings
+ * @return             Simulation metadata written to file
+ */
+TrajectoryMetadata executeSweep( const SimulatorSettings& settings );
+
+} // namespace scarab
+
+#endif // SCARAB_SWEEP_HPP
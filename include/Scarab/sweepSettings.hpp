@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_SWEEP_SETTINGS_HPP
+#define SCARAB_SWEEP_SETTINGS_HPP
+
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+
+//! Method used to expand the parameters of a sweep into runs.
+enum SweepMethod
+{
+    //! Cartesian product of the grid points of all parameters.
+    gridSweepMethod,
+    //! Latin hypercube sample within the ranges of all parameters.
+    latinHypercubeSweepMethod
+};
+
+//! Simulator settings that can be varied in a sweep.
+enum SweepParameter
+{
+    initialXSweepParameter,
+    initialYSweepParameter,
+    initialZSweepParameter,
+    initialVxSweepParameter,
+    initialVySweepParameter,
+    initialVzSweepParameter,
+    startTimeSweepParameter,
+    endTimeSweepParameter,
+    initialStepSweepParameter,
+    absoluteToleranceSweepParameter,
+    relativeToleranceSweepParameter,
+    maximumStepSweepParameter,
+    gravitationalParameterSweepParameter,
+    chaserMassSweepParameter,
+    targetMassSweepParameter,
+    radiationPressureSweepParameter,
+    radiationPressureCoefficientSweepParameter,
+    radiationPressureAreaSweepParameter,
+    dragCoefficientSweepParameter,
+    dragAreaSweepParameter
+};
+
+//! Sweep parameter definition.
+/*!
+ * Data struct containing all valid input parameters that define a single parameter of a sweep.
+ * For a grid sweep, the parameter takes the grid points listed; for a Latin hypercube sweep, the
+ * parameter is sampled within the range from the minimum to the maximum.
+ *
+ * @sa SweepSettings, expandSweep
+ */
+struct SweepParameterDefinition
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, SweepSettings
+     * @param[in] aParameter    Simulator setting that is varied
+     * @param[in] someValues    Grid points (grid sweeps only)
+     * @param[in] aMinimum      Minimum of range (Latin hypercube sweeps only)
+     * @param[in] aMaximum      Maximum of range (Latin hypercube sweeps only)
+     */
+    SweepParameterDefinition( const SweepParameter          aParameter,
+                              const std::vector< double >&  someValues,
+                              const double                  aMinimum,
+                              const double                  aMaximum )
+        : parameter( aParameter ),
+          values( someValues ),
+          minimum( aMinimum ),
+          maximum( aMaximum )
+    { }
+
+    //! Simulator setting that is varied.
+    const SweepParameter parameter;
+
+    //! Grid points (grid sweeps only).
+    const std::vector< double > values;
+
+    //! Minimum of range (Latin hypercube sweeps only).
+    const double minimum;
+
+    //! Maximum of range (Latin hypercube sweeps only).
+    const double maximum;
+
+protected:
+
+private:
+};
+
+//! List of sweep parameter definitions.
+typedef std::vector< SweepParameterDefinition > ListOfSweepParameterDefinitions;
+
+//! Sweep settings.
+/*!
+ * Data struct containing all valid input parameters for parameter sweeps. This struct is
+ * populated by the checkSimulatorSettings() function.
+ *
+ * A sweep varies simulator settings over a grid or a Latin hypercube sample; every resulting
+ * combination of parameter values is propagated as a separate run within the same process.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, executeSweep
+ */
+struct SweepSettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator, executeSweep
+     * @param[in] aStatus                       Flag indicating if sweep mode is on or off
+     * @param[in] aMethod                       Method used to expand parameters into runs
+     * @param[in] aNumberOfSamples              Number of runs (Latin hypercube sweeps only)
+     * @param[in] aNumberOfThreads              Number of worker threads (0 = hardware
+     *                                          concurrency)
+     * @param[in] aSeed                         Seed for random number generator (Latin
+     *                                          hypercube sweeps only)
+     * @param[in] aListOfParameterDefinitions   List of sweep parameter definitions
+     * @param[in] aSweepFilename                Filename for sweep output
+     */
+    SweepSettings( const bool                               aStatus,
+                   const SweepMethod                        aMethod,
+                   const unsigned int                       aNumberOfSamples,
+                   const unsigned int                       aNumberOfThreads,
+                   const unsigned int                       aSeed,
+                   const ListOfSweepParameterDefinitions&   aListOfParameterDefinitions,
+                   const std::string&                       aSweepFilename )
+        : status( aStatus ),
+          method( aMethod ),
+          numberOfSamples( aNumberOfSamples ),
+          numberOfThreads( aNumberOfThreads ),
+          seed( aSeed ),
+          listOfParameterDefinitions( aListOfParameterDefinitions ),
+          sweepFilename( aSweepFilename )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Method used to expand parameters into runs.
+    const SweepMethod method;
+
+    //! Number of runs (Latin hypercube sweeps only).
+    const unsigned int numberOfSamples;
+
+    //! Number of worker threads (0 = hardware concurrency).
+    const unsigned int numberOfThreads;
+
+    //! Seed for random number generator (Latin hypercube sweeps only).
+    const unsigned int seed;
+
+    //! List of sweep parameter definitions.
+    const ListOfSweepParameterDefinitions listOfParameterDefinitions;
+
+    //! Sweep output filename.
+    const std::string sweepFilename;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_SWEEP_SETTINGS_HPP
@@ -10,6 +10,8 @@
 #ifndef SCARAB_TARGET_SETTINGS_HPP
 #define SCARAB_TARGET_SETTINGS_HPP
 
+#include "Scarab/typedefs.hpp"
+
 namespace scarab
 {
 
@@ -29,15 +31,36 @@ public:
      * Constructs data struct based on verified input parameters.
      *
      * @sa checkSimulatorInput, executeSimulator
-     * @param[in] aMass     Target mass [kg]
+     * @param[in] aMass                     Target mass                         [kg]
+     * @param[in] aDragArea                 Area of target subject to drag; NaN if same as
+     *                                      chaser                              [m^2]
+     * @param[in] aRadiationPressureArea    Area of target subject to radiation pressure; NaN
+     *                                      if same as chaser                   [m^2]
+     * @param[in] anInitialState            Initial state of target; only used by Encke
+     *                                      propagation, NaN if not set         [km; km s^-1]
      */
-    TargetSettings( const double aMass )
-        : mass( aMass )
+    TargetSettings( const double aMass,
+                    const double aDragArea,
+                    const double aRadiationPressureArea,
+                    const State& anInitialState )
+        : mass( aMass ),
+          dragArea( aDragArea ),
+          radiationPressureArea( aRadiationPressureArea ),
+          initialState( anInitialState )
     { }
 
     //! Mass [kg].
     const double mass;
 
+    //! Drag area [m^2]; NaN if same as chaser.
+    const double dragArea;
+
+    //! Radiation pressure area [m^2]; NaN if same as chaser.
+    const double radiationPressureArea;
+
+    //! Initial state [km; km s^-1].
+    const State initialState;
+
 protected:
 
 private:
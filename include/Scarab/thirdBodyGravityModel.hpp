@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_THIRD_BODY_GRAVITY_MODEL_HPP
+#define SCARAB_THIRD_BODY_GRAVITY_MODEL_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Third-body gravitational acceleration model.
+/*!
+ * Point-mass gravitational perturbation of one or more third bodies, e.g., the Sun and the Moon,
+ * with the positions of the bodies taken from a Chebyshev ephemeris. Since the state is given
+ * with respect to the (accelerated) central body, the acceleration of each third body consists of
+ * the direct attraction of the spacecraft minus the attraction of the central body:
+ *
+ *  a = sum_b mu_b ( ( s_b - r ) / |s_b - r|^3 - s_b / |s_b|^3 ),
+ *
+ * where s_b is the position of body b with respect to the central body (O. Montenbruck and E.
+ * Gill, Satellite Orbits, 2000, Section 3.2).
+ */
+class ThirdBodyGravityModel final : public AccelerationModel< Acceleration >
+{
+public:
+
+    //! Construct model.
+    /*!
+     * Constructs third-body gravity model. The gravitational parameters of the bodies are taken
+     * from the ephemeris.
+     *
+     * @param[in] anEphemeris       Ephemeris containing positions of third bodies
+     * @param[in] someBodyIndices   Indices of third bodies in ephemeris
+     */
+    ThirdBodyGravityModel( const ChebyshevEphemerisPtr& anEphemeris,
+                           const std::vector< std::size_t >& someBodyIndices )
+        : ephemeris( anEphemeris ),
+          bodyIndices( someBodyIndices )
+    {
+        for ( std::size_t i = 0; i < bodyIndices.size( ); i++ )
+        {
+            gravitationalParameters.push_back(
+                ephemeris->getBody( bodyIndices[ i ] ).gravitationalParameter );
+        }
+    }
+
+    //! Compute acceleration.
+    /*!
+     * Computes sum of third-body perturbations.
+     *
+     * @param[in] state Current state                                           [km; km s^-1]
+     * @param[in] time  Current time                                            [s]
+     * @return          Computed acceleration                                   [km s^-2]
+     */
+    Acceleration operator( )( const State& state, const double time ) const
+    {
+        Acceleration acceleration;
+        acceleration[ 0 ] = 0.0;
+        acceleration[ 1 ] = 0.0;
+        acceleration[ 2 ] = 0.0;
+
+        for ( std::size_t i = 0; i < bodyIndices.size( ); i++ )
+        {
+            const Position bodyPosition = ephemeris->getPosition( bodyIndices[ i ], time );
+
+            const double x = bodyPosition[ 0 ] - state[ 0 ];
+            const double y = bodyPosition[ 1 ] - state[ 1 ];
+            const double z = bodyPosition[ 2 ] - state[ 2 ];
+            const double distance = std::sqrt( x * x + y * y + z * z );
+            const double bodyDistance = std::sqrt( bodyPosition[ 0 ] * bodyPosition[ 0 ]
+                                                   + bodyPosition[ 1 ] * bodyPosition[ 1 ]
+                                                   + bodyPosition[ 2 ] * bodyPosition[ 2 ] );
+
+            const double directFactor
+                = gravitationalParameters[ i ] / ( distance * distance * distance );
+            const double indirectFactor
+                = gravitationalParameters[ i ] / ( bodyDistance * bodyDistance * bodyDistance );
+
+            acceleration[ 0 ] += directFactor * x - indirectFactor * bodyPosition[ 0 ];
+            acceleration[ 1 ] += directFactor * y - indirectFactor * bodyPosition[ 1 ];
+            acceleration[ 2 ] += directFactor * z - indirectFactor * bodyPosition[ 2 ];
+        }
+
+        return acceleration;
+    }
+
+protected:
+
+private:
+
+    //! Ephemeris containing positions of third bodies.
+    const ChebyshevEphemerisPtr ephemeris;
+
+    //! Indices of third bodies in ephemeris.
+    const std::vector< std::size_t > bodyIndices;
+
+    //! Gravitational parameters of third bodies [km^3 s^-2].
+    std::vector< double > gravitationalParameters;
+};
+
+typedef boost::shared_ptr< ThirdBodyGravityModel > ThirdBodyGravityModelPtr;
+
+} // namespace scarab
+
+#endif // SCARAB_THIRD_BODY_GRAVITY_MODEL_HPP
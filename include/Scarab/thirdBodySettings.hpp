@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_THIRD_BODY_SETTINGS_HPP
+#define SCARAB_THIRD_BODY_SETTINGS_HPP
+
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+
+//! Third-body gravity model settings.
+/*!
+ * Data struct containing all valid input parameters for the third-body gravity model. This struct
+ * is populated by the checkSimulatorSettings() function. The positions and gravitational
+ * parameters of the bodies are taken from the ephemeris.
+ *
+ * @sa checkSimulatorSettings, executeSimulator, EphemerisSettings, ThirdBodyGravityModel
+ */
+struct ThirdBodySettings
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs data struct based on verified input parameters.
+     *
+     * @sa checkSimulatorSettings, executeSimulator
+     * @param[in] aStatus           Flag indicating if model is on or off
+     * @param[in] someBodyNames     Names of third bodies in ephemeris
+     */
+    ThirdBodySettings( const bool aStatus, const std::vector< std::string >& someBodyNames )
+        : status( aStatus ),
+          bodyNames( someBodyNames )
+    { }
+
+    //! Status.
+    const bool status;
+
+    //! Names of third bodies in ephemeris.
+    const std::vector< std::string > bodyNames;
+
+protected:
+
+private:
+};
+
+} // namespace scarab
+
+#endif // SCARAB_THIRD_BODY_SETTINGS_HPP
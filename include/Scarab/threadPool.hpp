@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_THREAD_POOL_HPP
+#define SCARAB_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scarab
+{
+
+//! Work-stealing thread pool.
+/*!
+ * Thread pool with one task queue per worker thread. Submitted tasks are distributed round-robin
+ * over the queues. Each worker takes tasks from the back of its own queue and, once that is empty,
+ * steals tasks from the front of the queues of the other workers. This balances the load when the
+ * run time of tasks varies strongly, e.g., for ensemble members that are propagated with adaptive
+ * step sizes.
+ *
+ * The first exception thrown by a task is stored and rethrown by wait().
+ */
+class ThreadPool
+{
+public:
+
+    //! Task executed by thread pool.
+    typedef std::function< void( ) > Task;
+
+    //! Construct thread pool.
+    /*!
+     * Constructs thread pool and starts worker threads.
+     *
+     * @param[in] aNumberOfThreads Number of worker threads; if zero, the number of concurrent
+     *                             threads supported by the hardware is used (default = 0)
+     */
+    explicit ThreadPool( const unsigned int aNumberOfThreads = 0 );
+
+    //! Destruct thread pool.
+    /*!
+     * Waits for all submitted tasks to complete and joins worker threads.
+     */
+    ~ThreadPool( );
+
+    //! Submit task.
+    /*!
+     * Submits task to be executed by one of the worker threads.
+     *
+     * @param[in] task Task to execute
+     */
+    void submit( const Task& task );
+
+    //! Wait for tasks.
+    /*!
+     * Blocks until all submitted tasks have completed. If any of the tasks threw an exception, the
+     * first exception caught is rethrown.
+     */
+    void wait( );
+
+    //! Get number of worker threads.
+    /*!
+     * Returns number of worker threads in pool.
+     *
+     * @return Number of worker threads
+     */
+    unsigned int size( ) const { return workers.size( ); }
+
+protected:
+
+private:
+
+    //! Task queue owned by a single worker thread.
+    struct TaskQueue
+    {
+        //! Mutex guarding queue.
+        std::mutex mutex;
+
+        //! Queued tasks.
+        std::deque< Task > tasks;
+    };
+
+    //! Run worker thread.
+    /*!
+     * Executes tasks until the pool is stopped.
+     *
+     * @param[in] index Index of worker thread
+     */
+    void run( const unsigned int index );
+
+    //! Take task.
+    /*!
+     * Takes a task from the back of the worker's own queue or, if that queue is empty, steals a
+     * task from the front of another worker's queue.
+     *
+     * @param[in]  index Index of worker thread
+     * @param[out] task  Task taken
+     * @return           True if a task was taken
+     */
+    bool take( const unsigned int index, Task& task );
+
+    //! Task queues, one per worker thread.
+    std::vector< std::unique_ptr< TaskQueue > > queues;
+
+    //! Worker threads.
+    std::vector< std::thread > workers;
+
+    //! Mutex guarding task counters, stop flag and stored exception.
+    std::mutex mutex;
+
+    //! Condition signalled when tasks are submitted or pool is stopped.
+    std::condition_variable taskSubmitted;
+
+    //! Condition signalled when all tasks have completed.
+    std::condition_variable tasksCompleted;
+
+    //! Number of tasks queued, but not yet taken by a worker.
+    std::size_t numberOfQueuedTasks;
+
+    //! Number of tasks submitted, but not yet completed.
+    std::size_t numberOfPendingTasks;
+
+    //! Index of queue that next submitted task is added to.
+    unsigned int nextQueue;
+
+    //! Flag indicating that worker threads should stop.
+    bool isStopping;
+
+    //! First exception thrown by a task.
+    std::exception_ptr error;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_THREAD_POOL_HPP
@@ -17,6 +17,7 @@
 
 #include <rapidjson/document.h>
 
+#include "Scarab/stateHistory.hpp"
 #include "Scarab/typedefs.hpp"
 
 namespace scarab
@@ -49,7 +50,7 @@ ConfigIterator find( const rapidjson::Document& config, const std::string& param
  *                           (default = number of digits of precision for a double)
  */
 void print( std::ostream& stream,
-            const StateHistory stateHistory,
+            const StateHistory& stateHistory,
             const std::string& streamHeader = "",
             const int precision = std::numeric_limits< double >::digits10 );
 
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_TRAJECTORY_FILE_HPP
+#define SCARAB_TRAJECTORY_FILE_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/array.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+
+//! Version of binary trajectory file format.
+const unsigned int trajectoryFileVersion = 1;
+
+//! Trajectory metadata entry.
+/*!
+ * Data struct containing a single metadata parameter, as written to the metadata file and stored
+ * in the header of a binary trajectory file.
+ */
+struct TrajectoryMetadataEntry
+{
+public:
+
+    //! Construct data struct.
+    /*!
+     * Constructs metadata entry.
+     *
+     * @param[in] aName  Name of metadata parameter
+     * @param[in] aValue Value of metadata parameter
+     * @param[in] aUnits Units of metadata parameter
+     */
+    TrajectoryMetadataEntry( const std::string& aName,
+                             const double aValue,
+                             const std::string& aUnits )
+        : name( aName ),
+          value( aValue ),
+          units( aUnits )
+    { }
+
+    //! Name of metadata parameter.
+    std::string name;
+
+    //! Value of metadata parameter.
+    double value;
+
+    //! Units of metadata parameter.
+    std::string units;
+
+protected:
+
+private:
+};
+
+//! Trajectory metadata.
+typedef std::vector< TrajectoryMetadataEntry > TrajectoryMetadata;
+
+//! Binary state history writer.
+/*!
+ * State history sink that writes samples to a binary trajectory file. The file format (version 1)
+ * is columnar:
+ *
+ *  - bytes 0-7: magic string "SCARABTR";
+ *  - bytes 8-11: format version (uint32);
+ *  - bytes 12-15: length of header in bytes (uint32);
+ *  - bytes 16-23: number of rows (uint64);
+ *  - header: JSON object containing "columns" (array of objects with "name" and "units") and
+ *    "metadata" (array of objects with "name", "value" and "units"), padded with spaces such that
+ *    the data starts at a multiple of 64 bytes;
+ *  - data: one contiguous array of doubles per column, in the order t, x, y, z, vx, vy, vz.
+ *
+ * All numbers are stored little-endian. Since the number of rows is only known at the end of the
+ * integration, samples are buffered in chunks and appended to one temporary spill file per
+ * column during integration; on close(), the header is written and the columns are concatenated
+ * into the trajectory file. Memory use is therefore bounded by the chunk size.
+ *
+ * @sa TrajectoryFileReader
+ */
+class BinaryStateHistoryWriter : public StateHistorySink
+{
+public:
+
+    //! Construct binary writer.
+    /*!
+     * Constructs binary writer and opens spill files next to the trajectory file. If the
+     * simulation is resumed, the existing spill files are opened without truncating them, such
+     * that the writer can be restored from a checkpoint.
+     *
+     * @sa restoreCheckpoint
+     * @param[in] aFilename     Trajectory filename
+     * @param[in] aChunkSize    Number of samples buffered before writing to spill files
+     * @param[in] isResumed     Flag indicating if simulation is resumed (default = false)
+     */
+    BinaryStateHistoryWriter( const std::string& aFilename,
+                              const std::size_t aChunkSize,
+                              const bool isResumed = false );
+
+    //! Destruct binary writer.
+    /*!
+     * Closes writer with empty metadata, if close() has not been called, so that no samples are
+     * lost.
+     */
+    ~BinaryStateHistoryWriter( );
+
+    //! Write sample.
+    /*!
+     * Adds sample to buffer, and writes buffer to spill files if it is full.
+     *
+     * @param[in] time  Epoch of sample                                           [s]
+     * @param[in] state State at epoch                                            [km; km s^-1]
+     */
+    void write( const double time, const State& state );
+
+    //! Flush sink.
+    /*!
+     * Writes buffered samples to spill files.
+     */
+    void flush( );
+
+    //! Close writer.
+    /*!
+     * Writes trajectory file, consisting of the header with the given metadata and the columns
+     * collected in the spill files, and removes the spill files. No samples can be written after
+     * the writer has been closed.
+     *
+     * @param[in] metadata Simulation metadata to store in header
+     */
+    void close( const TrajectoryMetadata& metadata );
+
+    //! Write checkpoint.
+    /*!
+     * Flushes writer and writes number of samples to checkpoint.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void writeCheckpoint( Checkpoint& checkpoint );
+
+    //! Restore checkpoint.
+    /*!
+     * Restores number of samples and moves to the corresponding position in the spill files, such
+     * that the samples written after the checkpoint are overwritten. Since a resumed simulation
+     * writes exactly the same samples, the trajectory file is the same as that of an
+     * uninterrupted simulation.
+     *
+     * @param[in,out] checkpoint Checkpoint
+     */
+    void restoreCheckpoint( Checkpoint& checkpoint );
+
+    //! Get number of samples written.
+    /*!
+     * Returns number of samples accepted by the writer, including samples that are still buffered.
+     *
+     * @return Number of samples written
+     */
+    std::size_t getNumberOfSamples( ) const { return numberOfSamples; }
+
+protected:
+
+private:
+
+    //! Write buffered samples to spill files.
+    void writeChunk( );
+
+    //! Get spill filename of column.
+    /*!
+     * Returns name of temporary file to which values of given column are appended.
+     *
+     * @param[in] column Index of column
+     * @return           Spill filename
+     */
+    std::string getSpillFilename( const std::size_t column ) const;
+
+    //! Trajectory filename.
+    const std::string filename;
+
+    //! Number of samples buffered before writing to spill files.
+    const std::size_t chunkSize;
+
+    //! Buffered samples, stored per column.
+    std::vector< double > buffer;
+
+    //! Number of buffered samples.
+    std::size_t numberOfBufferedSamples;
+
+    //! Number of samples accepted by the writer.
+    std::size_t numberOfSamples;
+
+    //! Flag indicating if writer has been closed.
+    bool isClosed;
+
+    //! Spill files, one per column.
+    boost::array< std::ofstream, 7 > spillFiles;
+};
+
+//! Trajectory file reader.
+/*!
+ * Reader for binary trajectory files written by BinaryStateHistoryWriter. The file is memory
+ * mapped, so that the columns can be accessed directly, without copying or parsing the data.
+ * An error is thrown if the file is not a valid trajectory file or has an unsupported version.
+ *
+ * @sa BinaryStateHistoryWriter
+ */
+class TrajectoryFileReader
+{
+public:
+
+    //! Construct reader.
+    /*!
+     * Constructs reader by memory mapping the trajectory file and parsing its header.
+     *
+     * @param[in] filename Trajectory filename
+     */
+    explicit TrajectoryFileReader( const std::string& filename );
+
+    //! Get number of rows.
+    /*!
+     * Returns number of rows, i.e., samples, in trajectory file.
+     *
+     * @return Number of rows
+     */
+    std::size_t getNumberOfRows( ) const { return numberOfRows; }
+
+    //! Get column names.
+    /*!
+     * Returns names of columns in trajectory file, in order of storage.
+     *
+     * @return Column names
+     */
+    const std::vector< std::string >& getColumnNames( ) const { return columnNames; }
+
+    //! Get column units.
+    /*!
+     * Returns units of columns in trajectory file, in order of storage.
+     *
+     * @return Column units
+     */
+    const std::vector< std::string >& getColumnUnits( ) const { return columnUnits; }
+
+    //! Get metadata.
+    /*!
+     * Returns simulation metadata stored in header of trajectory file.
+     *
+     * @return Simulation metadata
+     */
+    const TrajectoryMetadata& getMetadata( ) const { return metadata; }
+
+    //! Get column.
+    /*!
+     * Returns pointer to contiguous array of values of given column, mapped from file.
+     *
+     * @param[in] column Index of column
+     * @return           Pointer to column values
+     */
+    const double* getColumn( const std::size_t column ) const;
+
+    //! Get column.
+    /*!
+     * Returns pointer to contiguous array of values of column with given name, mapped from file.
+     * An error is thrown if the column does not exist.
+     *
+     * @param[in] columnName Name of column
+     * @return               Pointer to column values
+     */
+    const double* getColumn( const std::string& columnName ) const;
+
+    //! Get state.
+    /*!
+     * Gathers state at given row from columns x, y, z, vx, vy, vz.
+     *
+     * @param[in] row Index of row
+     * @return        State at row                                                [km; km s^-1]
+     */
+    State getState( const std::size_t row ) const;
+
+protected:
+
+private:
+
+    //! Mapped trajectory file.
+    boost::interprocess::file_mapping file;
+
+    //! Mapped region of trajectory file.
+    boost::interprocess::mapped_region region;
+
+    //! Number of rows.
+    std::size_t numberOfRows;
+
+    //! Column names.
+    std::vector< std::string > columnNames;
+
+    //! Column units.
+    std::vector< std::string > columnUnits;
+
+    //! Simulation metadata.
+    TrajectoryMetadata metadata;
+
+    //! Pointer to start of data in mapped region.
+    const double* data;
+};
+
+} // namespace scarab
+
+#endif // SCARAB_TRAJECTORY_FILE_HPP
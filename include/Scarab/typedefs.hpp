@@ -10,7 +10,6 @@
 #ifndef SCARAB_TYPEDEFS_HPP
 #define SCARAB_TYPEDEFS_HPP
 
-#include <map>
 #include <string>
 #include <vector>
 
@@ -31,9 +30,6 @@ typedef boost::array< double, 3 > Acceleration;
 //! State-type.
 typedef boost::array< double, 6 > State;
 
-//! State history.
-typedef std::map< double, State > StateHistory;
-
 //! Typedef for list of acceleration model names.
 typedef std::vector< std::string > ListOfModelNames;
 
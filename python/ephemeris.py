@@ -0,0 +1,258 @@
+'''
+Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+Distributed under the MIT License.
+See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+All rights reserved.
+'''
+
+# Offline generator for binary Chebyshev ephemeris files read by Scarab (see
+# include/Scarab/ephemeris.hpp).
+#
+# The positions of the bodies with respect to the central body (Earth) are either computed from the
+# low-precision analytical series for the Sun and the Moon of O. Montenbruck and E. Gill (Satellite
+# Orbits, 2000, Section 3.3.2), in the EME2000 frame, or read from a CSV file with lines
+# "t [s], x [km], y [km], z [km]", e.g., exported from a high-precision ephemeris. Simulation time t
+# is mapped to the Julian date epoch + t / 86400 (TT).
+#
+# File format (version 1):
+#  - bytes 0-7: magic string "SCARABEP";
+#  - bytes 8-11: format version (uint32, little-endian);
+#  - bytes 12-15: length of header in bytes (uint32, little-endian);
+#  - bytes 16-23: total number of coefficients in data (uint64, little-endian);
+#  - header: JSON object with "bodies" (name, gravitational_parameter, start_time,
+#    segment_duration, number_of_segments, number_of_coefficients, offset);
+#  - data: per body and segment, the Chebyshev coefficients of x, y and z (little-endian doubles).
+#
+# Example:
+#  python ephemeris.py --epoch 2458849.5 --start 0 --end 864000 --output ephemeris.bin
+
+# I/O
+import argparse
+import json
+import struct
+
+# Numerical
+import numpy as np
+
+ephemeris_file_magic = b'SCARABEP'
+ephemeris_file_version = 1
+ephemeris_file_prefix_size = 24
+ephemeris_file_alignment = 64
+
+# Gravitational parameters [km^3 s^-2].
+gravitational_parameters = {'sun': 1.32712440018e11, 'moon': 4902.800066}
+
+# Default segment durations [s] and numbers of coefficients per component, chosen such that the
+# fit error is well below the accuracy of the analytical series.
+default_segment_durations = {'sun': 16.0 * 86400.0, 'moon': 2.0 * 86400.0}
+default_numbers_of_coefficients = {'sun': 12, 'moon': 14}
+
+# Obliquity of the ecliptic at J2000 [rad].
+obliquity = np.radians(23.43929111)
+
+def compute_sun_position(julian_date):
+    '''Compute low-precision position of the Sun with respect to the Earth in EME2000 [km].'''
+    t = (julian_date - 2451545.0) / 36525.0
+    mean_anomaly = np.radians(357.5256 + 35999.049 * t)
+    longitude = np.radians(282.9400) + mean_anomaly \
+        + np.radians((6892.0 * np.sin(mean_anomaly) + 72.0 * np.sin(2.0 * mean_anomaly)) / 3600.0)
+    distance = (149.619 - 2.499 * np.cos(mean_anomaly) - 0.021 * np.cos(2.0 * mean_anomaly)) * 1.0e6
+    return np.array([distance * np.cos(longitude),
+                     distance * np.sin(longitude) * np.cos(obliquity),
+                     distance * np.sin(longitude) * np.sin(obliquity)])
+
+def compute_moon_position(julian_date):
+    '''Compute low-precision position of the Moon with respect to the Earth in EME2000 [km].'''
+    t = (julian_date - 2451545.0) / 36525.0
+    mean_longitude = 218.31617 + 481267.88088 * t - 1.3972 * t
+    l = np.radians(134.96292 + 477198.86753 * t)
+    lp = np.radians(357.52543 + 35999.04944 * t)
+    f = np.radians(93.27283 + 483202.01873 * t)
+    d = np.radians(297.85027 + 445267.11135 * t)
+
+    longitude = mean_longitude + (22640.0 * np.sin(l) + 769.0 * np.sin(2.0 * l)
+                                  - 4586.0 * np.sin(l - 2.0 * d) + 2370.0 * np.sin(2.0 * d)
+                                  - 668.0 * np.sin(lp) - 412.0 * np.sin(2.0 * f)
+                                  - 212.0 * np.sin(2.0 * l - 2.0 * d)
+                                  - 206.0 * np.sin(l + lp - 2.0 * d)
+                                  + 192.0 * np.sin(l + 2.0 * d) - 165.0 * np.sin(lp - 2.0 * d)
+                                  + 148.0 * np.sin(l - lp) - 125.0 * np.sin(d)
+                                  - 110.0 * np.sin(l + lp) - 55.0 * np.sin(2.0 * f - 2.0 * d)) \
+        / 3600.0
+    latitude = (18520.0 * np.sin(f + np.radians(longitude - mean_longitude
+                                               + (412.0 * np.sin(2.0 * f) + 541.0 * np.sin(lp))
+                                               / 3600.0))
+                - 526.0 * np.sin(f - 2.0 * d) + 44.0 * np.sin(l + f - 2.0 * d)
+                - 31.0 * np.sin(-l + f - 2.0 * d) - 25.0 * np.sin(-2.0 * l + f)
+                - 23.0 * np.sin(lp + f - 2.0 * d) + 21.0 * np.sin(-l + f)
+                + 11.0 * np.sin(-lp + f - 2.0 * d)) / 3600.0
+    distance = 385000.0 - 20905.0 * np.cos(l) - 3699.0 * np.cos(2.0 * d - l) \
+        - 2956.0 * np.cos(2.0 * d) - 570.0 * np.cos(2.0 * l) + 246.0 * np.cos(2.0 * l - 2.0 * d) \
+        - 205.0 * np.cos(lp - 2.0 * d) - 171.0 * np.cos(l + 2.0 * d) \
+        - 152.0 * np.cos(l + lp - 2.0 * d)
+
+    longitude = np.radians(longitude)
+    latitude = np.radians(latitude)
+    x = distance * np.cos(latitude) * np.cos(longitude)
+    y = distance * np.cos(latitude) * np.sin(longitude)
+    z = distance * np.sin(latitude)
+    return np.array([x,
+                     y * np.cos(obliquity) - z * np.sin(obliquity),
+                     y * np.sin(obliquity) + z * np.cos(obliquity)])
+
+analytical_positions = {'sun': compute_sun_position, 'moon': compute_moon_position}
+
+def fit_function(position_function, segment_start, segment_duration, number_of_coefficients):
+    '''Fit Chebyshev coefficients of x, y and z in a segment by interpolation at Chebyshev nodes.
+
+    Returns an array of shape (3, number_of_coefficients).
+    '''
+    n = number_of_coefficients
+    angles = np.pi * (np.arange(n) + 0.5) / n
+    times = segment_start + 0.5 * segment_duration * (np.cos(angles) + 1.0)
+    values = np.array([position_function(time) for time in times]).T
+    coefficients = 2.0 / n * values.dot(np.cos(np.outer(angles, np.arange(n))))
+    coefficients[:, 0] *= 0.5
+    return coefficients
+
+def fit_samples(samples, segment_start, segment_duration, number_of_coefficients):
+    '''Fit Chebyshev coefficients of x, y and z in a segment to samples by least squares.
+
+    Returns an array of shape (3, number_of_coefficients).
+    '''
+    segment_end = segment_start + segment_duration
+    in_segment = (samples[:, 0] >= segment_start) & (samples[:, 0] <= segment_end)
+    if np.count_nonzero(in_segment) < number_of_coefficients:
+        raise Exception("Not enough samples in segment starting at " + str(segment_start) + " s!")
+    tau = 2.0 * (samples[in_segment, 0] - segment_start) / segment_duration - 1.0
+    return np.array([np.polynomial.chebyshev.chebfit(tau, samples[in_segment, i + 1],
+                                                     number_of_coefficients - 1)
+                     for i in range(3)])
+
+def evaluate_position(coefficients, start_time, segment_duration, time):
+    '''Evaluate position from coefficients of shape (segments, 3, coefficients) at given time.'''
+    segment = min(int((time - start_time) / segment_duration), coefficients.shape[0] - 1)
+    tau = 2.0 * (time - start_time - segment * segment_duration) / segment_duration - 1.0
+    return np.array([np.polynomial.chebyshev.chebval(tau, coefficients[segment, i])
+                     for i in range(3)])
+
+def write_ephemeris(filename, bodies):
+    '''Write binary ephemeris file.
+
+    Every body is a dict with name, gravitational_parameter, start_time, segment_duration and
+    coefficients, an array of shape (segments, 3, coefficients).
+    '''
+    entries = []
+    offset = 0
+    for body in bodies:
+        number_of_segments, _, number_of_coefficients = body['coefficients'].shape
+        entries.append({'name': body['name'],
+                        'gravitational_parameter': body['gravitational_parameter'],
+                        'start_time': body['start_time'],
+                        'segment_duration': body['segment_duration'],
+                        'number_of_segments': number_of_segments,
+                        'number_of_coefficients': number_of_coefficients,
+                        'offset': offset})
+        offset += body['coefficients'].size
+
+    header = json.dumps({'bodies': entries}, separators=(',', ':')).encode('utf-8')
+    unpadded_size = ephemeris_file_prefix_size + len(header)
+    header += b' ' * ((ephemeris_file_alignment - unpadded_size % ephemeris_file_alignment)
+                      % ephemeris_file_alignment)
+
+    with open(filename, 'wb') as ephemeris_file:
+        ephemeris_file.write(ephemeris_file_magic)
+        ephemeris_file.write(struct.pack('<IIQ', ephemeris_file_version, len(header), offset))
+        ephemeris_file.write(header)
+        for body in bodies:
+            ephemeris_file.write(body['coefficients'].astype('<f8').tobytes())
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate Chebyshev ephemeris file for Scarab.')
+    parser.add_argument('--output', required=True, help='ephemeris filename')
+    parser.add_argument('--start', type=float, required=True, help='start time [s]')
+    parser.add_argument('--end', type=float, required=True, help='end time [s]')
+    parser.add_argument('--epoch', type=float, default=2451545.0,
+                        help='Julian date (TT) at t = 0 s (default: J2000)')
+    parser.add_argument('--bodies', nargs='+', default=['sun', 'moon'],
+                        help='bodies computed from analytical series (sun, moon)')
+    parser.add_argument('--samples', nargs='*', default=[], metavar='NAME=FILE[:MU]',
+                        help='bodies fitted to samples "t, x, y, z" in CSV file')
+    parser.add_argument('--segment_duration', nargs='*', default=[], metavar='NAME=DURATION',
+                        help='segment duration per body [s]')
+    parser.add_argument('--number_of_coefficients', nargs='*', default=[], metavar='NAME=N',
+                        help='number of coefficients per component per body')
+    arguments = parser.parse_args()
+
+    if not arguments.end > arguments.start:
+        raise Exception("End time must be after start time!")
+
+    segment_durations = dict(default_segment_durations)
+    segment_durations.update({name: float(value) for name, value in
+                              (entry.split('=') for entry in arguments.segment_duration)})
+    numbers_of_coefficients = dict(default_numbers_of_coefficients)
+    numbers_of_coefficients.update({name: int(value) for name, value in
+                                    (entry.split('=') for entry in
+                                     arguments.number_of_coefficients)})
+
+    sources = []
+    for name in arguments.bodies:
+        if name not in analytical_positions:
+            raise Exception("No analytical series available for body \"" + name + "\"!")
+        position_function = analytical_positions[name]
+        sources.append((name, gravitational_parameters[name],
+                        lambda time, f=position_function: f(arguments.epoch + time / 86400.0),
+                        None))
+    for entry in arguments.samples:
+        name, specification = entry.split('=')
+        sample_filename, _, mu = specification.partition(':')
+        gravitational_parameter = float(mu) if mu else gravitational_parameters[name]
+        sources.append((name, gravitational_parameter, None,
+                        np.loadtxt(sample_filename, delimiter=',', ndmin=2)))
+
+    bodies = []
+    for name, gravitational_parameter, position_function, samples in sources:
+        segment_duration = segment_durations.get(name, 86400.0)
+        number_of_coefficients = numbers_of_coefficients.get(name, 12)
+        number_of_segments = max(1, int(np.ceil((arguments.end - arguments.start)
+                                                / segment_duration - 1.0e-9)))
+
+        coefficients = np.empty((number_of_segments, 3, number_of_coefficients))
+        for i in range(number_of_segments):
+            segment_start = arguments.start + i * segment_duration
+            if samples is None:
+                coefficients[i] = fit_function(position_function, segment_start,
+                                               segment_duration, number_of_coefficients)
+            else:
+                coefficients[i] = fit_samples(samples, segment_start, segment_duration,
+                                              number_of_coefficients)
+
+        # Check fit error halfway between the interpolation nodes.
+        maximum_error = 0.0
+        if samples is None:
+            check_times = np.linspace(arguments.start,
+                                      arguments.start + number_of_segments * segment_duration,
+                                      number_of_segments * 4 * number_of_coefficients + 1)
+            for time in check_times:
+                error = evaluate_position(coefficients, arguments.start, segment_duration, time) \
+                    - position_function(time)
+                maximum_error = max(maximum_error, np.linalg.norm(error))
+
+        print(name + ": " + str(number_of_segments) + " segments of " + str(segment_duration)
+              + " s, " + str(number_of_coefficients) + " coefficients, maximum fit error "
+              + str(maximum_error) + " km")
+
+        bodies.append({'name': name,
+                       'gravitational_parameter': gravitational_parameter,
+                       'start_time': arguments.start,
+                       'segment_duration': segment_duration,
+                       'coefficients': coefficients})
+
+    write_ephemeris(arguments.output, bodies)
+    print("Ephemeris written to " + arguments.output)
+
+if __name__ == '__main__':
+    main()
@@ -27,6 +27,11 @@ from pprint import pprint
 import numpy as np
 import pandas as pd
 
+# Scarab
+from trajectory import is_trajectory_file, load_trajectory
+from trajectory import is_chebyshev_trajectory_file, load_chebyshev_trajectory
+from trajectory import evaluate_chebyshev_trajectory
+
 # System
 import sys
 import time
@@ -79,7 +84,17 @@ metadata_table.append(["$Vz_{0}$",               float(metadata[1][6]), "$km s^{
 metadata_table.append(["$t_{0}$",                float(metadata[1][7]), "$s$"])
 metadata_table.append(["$t_{f}$",                float(metadata[1][8]), "$s$"])
 metadata_table.append(["$\Delta t_{0}$",         float(metadata[1][9]), "$s$"])
-state_history = pd.read_csv(config['state_history'])
+# Binary trajectory files are memory mapped; CSV files are parsed. Chebyshev trajectory files are
+# evaluated at 20 epochs per segment.
+if is_trajectory_file(config['state_history']):
+    state_history, state_history_metadata = load_trajectory(config['state_history'])
+elif is_chebyshev_trajectory_file(config['state_history']):
+    boundaries, coefficients, header = load_chebyshev_trajectory(config['state_history'])
+    state_history = evaluate_chebyshev_trajectory(
+        boundaries, coefficients,
+        np.linspace(boundaries[0], boundaries[-1], 20 * (len(boundaries) - 1) + 1))
+else:
+    state_history = pd.read_csv(config['state_history'])
 print "Input data files successfully read!"
 
 print "Figure being generated ..."
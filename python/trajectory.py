@@ -0,0 +1,143 @@
+'''
+Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+Distributed under the MIT License.
+See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+All rights reserved.
+'''
+
+# Loader for binary trajectory files written by Scarab (see include/Scarab/trajectoryFile.hpp).
+#
+# File format (version 1):
+#  - bytes 0-7: magic string "SCARABTR";
+#  - bytes 8-11: format version (uint32, little-endian);
+#  - bytes 12-15: length of header in bytes (uint32, little-endian);
+#  - bytes 16-23: number of rows (uint64, little-endian);
+#  - header: JSON object with "columns" (name, units) and "metadata" (name, value, units);
+#  - data: one contiguous array of little-endian doubles per column.
+#
+# Chebyshev trajectory files (see include/Scarab/chebyshevTrajectory.hpp) share the layout of the
+# prefix, with magic string "SCARABCT" and the number of segments instead of the number of rows;
+# the header contains "number_of_coefficients", "position_tolerance", "velocity_tolerance" and
+# "metadata", and the data consists of the segment boundaries, followed by the x, y and z
+# coefficient blocks of every segment.
+
+# I/O
+import json
+import struct
+
+# Numerical
+import numpy as np
+
+trajectory_file_magic = b'SCARABTR'
+trajectory_file_version = 1
+trajectory_file_prefix_size = 24
+chebyshev_trajectory_file_magic = b'SCARABCT'
+chebyshev_trajectory_file_version = 1
+
+def is_trajectory_file(filename):
+    '''Check if file is a binary trajectory file, based on its magic string.'''
+    with open(filename, 'rb') as trajectory_file:
+        return trajectory_file.read(len(trajectory_file_magic)) == trajectory_file_magic
+
+def read_trajectory_header(filename):
+    '''Read header of binary trajectory file.
+
+    Returns the number of rows, the parsed JSON header and the byte offset of the data.
+    '''
+    with open(filename, 'rb') as trajectory_file:
+        prefix = trajectory_file.read(trajectory_file_prefix_size)
+        if len(prefix) != trajectory_file_prefix_size \
+                or prefix[0:len(trajectory_file_magic)] != trajectory_file_magic:
+            raise Exception(filename + " is not a trajectory file!")
+        version, header_size, number_of_rows = struct.unpack('<IIQ', prefix[8:24])
+        if version != trajectory_file_version:
+            raise Exception("Trajectory file version " + str(version) + " is not supported!")
+        header = json.loads(trajectory_file.read(header_size).decode('utf-8'))
+    return number_of_rows, header, trajectory_file_prefix_size + header_size
+
+def load_trajectory(filename):
+    '''Load binary trajectory file without copying the data.
+
+    The columns are memory mapped using numpy.memmap. Returns a dict mapping column names
+    (t, x, y, z, vx, vy, vz) to read-only arrays, and the list of metadata entries stored in the
+    header (dicts with name, value and units).
+    '''
+    number_of_rows, header, data_offset = read_trajectory_header(filename)
+    column_names = [column['name'] for column in header['columns']]
+
+    columns = {}
+    if number_of_rows > 0:
+        data = np.memmap(filename, dtype='<f8', mode='r', offset=data_offset,
+                         shape=(len(column_names), number_of_rows))
+        for index, name in enumerate(column_names):
+            columns[name] = data[index]
+    else:
+        for name in column_names:
+            columns[name] = np.empty(0)
+
+    return columns, header['metadata']
+
+def is_chebyshev_trajectory_file(filename):
+    '''Check if file is a Chebyshev trajectory file, based on its magic string.'''
+    with open(filename, 'rb') as trajectory_file:
+        return trajectory_file.read(len(chebyshev_trajectory_file_magic)) \
+            == chebyshev_trajectory_file_magic
+
+def load_chebyshev_trajectory(filename):
+    '''Load Chebyshev trajectory file without copying the data.
+
+    Returns the segment boundaries (number of segments + 1), the coefficients as array of shape
+    (number of segments, 3, number of coefficients), both memory mapped, and the parsed header.
+    '''
+    with open(filename, 'rb') as trajectory_file:
+        prefix = trajectory_file.read(trajectory_file_prefix_size)
+        if len(prefix) != trajectory_file_prefix_size \
+                or prefix[0:len(chebyshev_trajectory_file_magic)] \
+                != chebyshev_trajectory_file_magic:
+            raise Exception(filename + " is not a Chebyshev trajectory file!")
+        version, header_size, number_of_segments = struct.unpack('<IIQ', prefix[8:24])
+        if version != chebyshev_trajectory_file_version:
+            raise Exception("Chebyshev trajectory file version " + str(version)
+                            + " is not supported!")
+        header = json.loads(trajectory_file.read(header_size).decode('utf-8'))
+    if number_of_segments == 0:
+        raise Exception(filename + " contains no segments!")
+
+    data_offset = trajectory_file_prefix_size + header_size
+    number_of_coefficients = header['number_of_coefficients']
+    boundaries = np.memmap(filename, dtype='<f8', mode='r', offset=data_offset,
+                           shape=(number_of_segments + 1,))
+    coefficients = np.memmap(filename, dtype='<f8', mode='r',
+                             offset=data_offset + 8 * (number_of_segments + 1),
+                             shape=(number_of_segments, 3, number_of_coefficients))
+    return boundaries, coefficients, header
+
+def evaluate_chebyshev_trajectory(boundaries, coefficients, times):
+    '''Evaluate Chebyshev trajectory at given epochs.
+
+    Returns a dict mapping column names (t, x, y, z, vx, vy, vz) to arrays. An epoch at the
+    boundary between two segments is evaluated with the later segment.
+    '''
+    times = np.asarray(times, dtype=float)
+    segments = np.clip(np.searchsorted(boundaries, times, side='right') - 1,
+                       0, len(boundaries) - 2)
+    segment_start = boundaries[segments]
+    time_scale = 2.0 / (boundaries[segments + 1] - segment_start)
+    tau = (times - segment_start) * time_scale - 1.0
+
+    columns = {'t': times}
+    names = ['x', 'y', 'z']
+    for component in range(3):
+        position = np.empty(len(times))
+        velocity = np.empty(len(times))
+        for index in range(len(times)):
+            series = np.polynomial.chebyshev.Chebyshev(coefficients[segments[index], component])
+            position[index] = series(tau[index])
+            velocity[index] = series.deriv()(tau[index]) * time_scale[index]
+        columns[names[component]] = position
+        columns['v' + names[component]] = velocity
+    return columns
+
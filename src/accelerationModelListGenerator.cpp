@@ -7,22 +7,34 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
-#include <boost/make_shared.hpp>
+#include <sstream>
+#include <stdexcept>
 
-#include "Scarab/accelerationModel.hpp"
-#include "Scarab/accelerationModelId.hpp"
 #include "Scarab/accelerationModelListGenerator.hpp"
-#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/accelerationModelRegistry.hpp"
 
 namespace scarab
 {
 
 //! Generate list of acceleration models.
-void generateAccelerationModelList( DataStore& data )
+void generateAccelerationModelList( const SimulatorSettings& settings, DataStore& data )
 {
-    // Create central gravity model and add to list.
-    data.listOfAccelerationModels[ centralGravityModelId ]
-        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    // Create models listed in config, using factories from acceleration model registry.
+    for ( unsigned int i = 0; i < settings.listOfModelNames.size( ); i++ )
+    {
+        const AccelerationModelRegistration& registration
+            = findAccelerationModel( settings.listOfModelNames[ i ] );
+
+        if ( data.listOfAccelerationModels.count( registration.id ) != 0 )
+        {
+            std::ostringstream error;
+            error << "ERROR: Acceleration model \"" << registration.name
+                  << "\" is listed more than once!";
+            throw std::runtime_error( error.str( ) );
+        }
+
+        data.listOfAccelerationModels[ registration.id ] = registration.factory( settings, data );
+    }
 }
 
 } // namespace scarab
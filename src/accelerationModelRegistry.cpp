@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Scarab/accelerationModelRegistry.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dragModel.hpp"
+#include "Scarab/interpolatedAccelerationModel.hpp"
+#include "Scarab/radiationPressureModel.hpp"
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
+#include "Scarab/thirdBodyGravityModel.hpp"
+
+namespace scarab
+{
+
+//! Create central gravity model.
+AccelerationModel3dPtr createCentralGravityModel( const SimulatorSettings& /* settings */,
+                                                  DataStore& data )
+{
+    return boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+}
+
+//! Create radiation pressure model.
+AccelerationModel3dPtr createRadiationPressureModel( const SimulatorSettings& settings,
+                                                     DataStore& /* data */ )
+{
+    const RadiationPressureSettings& radiationPressureSettings = settings.radiationPressureSettings;
+
+    // Take position of source from ephemeris, if requested.
+    if ( !radiationPressureSettings.sourceBodyName.empty( ) )
+    {
+        const ChebyshevEphemerisPtr& ephemeris = settings.ephemerisSettings.ephemeris;
+        if ( !ephemeris )
+        {
+            throw std::runtime_error(
+                "ERROR: Source of radiation pressure requires an ephemeris file!" );
+        }
+        return boost::make_shared< RadiationPressureModel >(
+            radiationPressureSettings.radiationPressure,
+            radiationPressureSettings.radiationPressureCoefficient,
+            radiationPressureSettings.radiationPressureArea,
+            settings.chaserSettings.mass,
+            ephemeris,
+            ephemeris->findBody( radiationPressureSettings.sourceBodyName ),
+            radiationPressureSettings.shadowModel,
+            radiationPressureSettings.centralBodyRadius,
+            radiationPressureSettings.sourceRadius );
+    }
+
+    return boost::make_shared< RadiationPressureModel >(
+        radiationPressureSettings.radiationPressure,
+        radiationPressureSettings.radiationPressureCoefficient,
+        radiationPressureSettings.radiationPressureArea,
+        settings.chaserSettings.mass,
+        radiationPressureSettings.vectorToSource,
+        radiationPressureSettings.shadowModel,
+        radiationPressureSettings.centralBodyRadius,
+        radiationPressureSettings.sourceRadius );
+}
+
+//! Create spherical harmonics gravity model.
+AccelerationModel3dPtr createSphericalHarmonicsGravityModel( const SimulatorSettings& settings,
+                                                             DataStore& data )
+{
+    const SphericalHarmonicsSettings& sphericalHarmonicsSettings
+        = settings.sphericalHarmonicsSettings;
+    const AccelerationModel3dPtr model = boost::make_shared< SphericalHarmonicsGravityModel >(
+        data.gravitationalParameter,
+        sphericalHarmonicsSettings.referenceRadius,
+        sphericalHarmonicsSettings.coefficients,
+        sphericalHarmonicsSettings.rotationRate );
+
+    // Serve acceleration from interpolation grid fixed to central body, if requested.
+    const GravityInterpolationSettings& interpolationSettings
+        = sphericalHarmonicsSettings.interpolationSettings;
+    if ( interpolationSettings.status )
+    {
+        return boost::make_shared< InterpolatedAccelerationModel >(
+            model,
+            interpolationSettings.cellSize,
+            interpolationSettings.tolerance,
+            interpolationSettings.maximumNumberOfCells,
+            sphericalHarmonicsSettings.rotationRate );
+    }
+
+    return model;
+}
+
+//! Create drag model.
+AccelerationModel3dPtr createDragModel( const SimulatorSettings& settings,
+                                        DataStore& /* data */ )
+{
+    const DragSettings& dragSettings = settings.dragSettings;
+    return boost::make_shared< DragModel >( dragSettings.dragCoefficient,
+                                            dragSettings.dragArea,
+                                            settings.chaserSettings.mass,
+                                            dragSettings.atmosphereTable,
+                                            dragSettings.centralBodyRadius,
+                                            dragSettings.rotationRate );
+}
+
+//! Create third-body gravity model.
+AccelerationModel3dPtr createThirdBodyGravityModel( const SimulatorSettings& settings,
+                                                    DataStore& /* data */ )
+{
+    const ChebyshevEphemerisPtr& ephemeris = settings.ephemerisSettings.ephemeris;
+    if ( !ephemeris )
+    {
+        throw std::runtime_error( "ERROR: Third-body gravity model requires an ephemeris file!" );
+    }
+
+    const std::vector< std::string >& bodyNames = settings.thirdBodySettings.bodyNames;
+    std::vector< std::size_t > bodyIndices;
+    for ( std::size_t i = 0; i < bodyNames.size( ); i++ )
+    {
+        bodyIndices.push_back( ephemeris->findBody( bodyNames[ i ] ) );
+    }
+
+    return boost::make_shared< ThirdBodyGravityModel >( ephemeris, bodyIndices );
+}
+
+//! Registry of acceleration models available in config file.
+const AccelerationModelRegistration accelerationModelRegistry[ ]
+    = { { "central_gravity", centralGravityModelId, &createCentralGravityModel },
+        { "radiation_pressure", radiationPressureModelId, &createRadiationPressureModel },
+        { "spherical_harmonics_gravity",
+          sphericalHarmonicsGravityModelId,
+          &createSphericalHarmonicsGravityModel },
+        { "atmospheric_drag", dragModelId, &createDragModel },
+        { "third_body_gravity", thirdBodyGravityModelId, &createThirdBodyGravityModel } };
+
+//! Find acceleration model registration.
+const AccelerationModelRegistration& findAccelerationModel( const std::string& modelName )
+{
+    const unsigned int numberOfRegistrations
+        = sizeof( accelerationModelRegistry ) / sizeof( accelerationModelRegistry[ 0 ] );
+
+    for ( unsigned int i = 0; i < numberOfRegistrations; i++ )
+    {
+        if ( modelName == accelerationModelRegistry[ i ].name )
+        {
+            return accelerationModelRegistry[ i ];
+        }
+    }
+
+    std::ostringstream error;
+    error << "ERROR: Acceleration model \"" << modelName << "\" is not available!";
+    throw std::runtime_error( error.str( ) );
+}
+
+//! Get acceleration model name.
+std::string getAccelerationModelName( const AccelerationModelId modelId )
+{
+    const unsigned int numberOfRegistrations
+        = sizeof( accelerationModelRegistry ) / sizeof( accelerationModelRegistry[ 0 ] );
+
+    for ( unsigned int i = 0; i < numberOfRegistrations; i++ )
+    {
+        if ( modelId == accelerationModelRegistry[ i ].id )
+        {
+            return accelerationModelRegistry[ i ].name;
+        }
+    }
+
+    std::ostringstream error;
+    error << "ERROR: Acceleration model with ID " << modelId << " is not available!";
+    throw std::runtime_error( error.str( ) );
+}
+
+} // namespace scarab
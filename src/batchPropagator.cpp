@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Scarab/batchPropagator.hpp"
+
+namespace scarab
+{
+
+//! Number of lanes that component arrays are padded to (one AVX-512 register of doubles).
+const std::size_t laneWidth = 8;
+
+//! Alignment of component arrays [bytes].
+const std::size_t laneAlignment = laneWidth * sizeof( double );
+
+//! Add weighted stage derivatives to state.
+/*!
+ * Computes output = state + stepSize * sum_j( weights[ j ] * stages[ j ] ) for all components and
+ * lanes, with a step size per lane. This is the core of every Runge-Kutta stage and is written as
+ * a plain loop over contiguous lanes, so that it is vectorized by the compiler.
+ *
+ * @param[in]  state            Batch of states
+ * @param[in]  stepSize         Step size per lane                              [s]
+ * @param[in]  stages           Stage derivatives
+ * @param[in]  weights          Weight per stage derivative
+ * @param[in]  numberOfWeights  Number of stage derivatives to add
+ * @param[out] output           Batch of output states
+ */
+void addStages( const BatchState& state,
+                const double* stepSize,
+                const std::vector< BatchState >& stages,
+                const double* weights,
+                const std::size_t numberOfWeights,
+                BatchState& output )
+{
+    const std::size_t numberOfLanes = state.paddedSize( );
+    const double* __restrict h = stepSize;
+
+    for ( std::size_t c = 0; c < BatchState::numberOfComponents; c++ )
+    {
+        const double* __restrict x = state[ c ];
+        double* __restrict y = output[ c ];
+
+        for ( std::size_t i = 0; i < numberOfLanes; i++ )
+        {
+            y[ i ] = x[ i ];
+        }
+
+        for ( std::size_t j = 0; j < numberOfWeights; j++ )
+        {
+            if ( weights[ j ] == 0.0 )
+            {
+                continue;
+            }
+
+            const double weight = weights[ j ];
+            const double* __restrict k = stages[ j ][ c ];
+            for ( std::size_t i = 0; i < numberOfLanes; i++ )
+            {
+                y[ i ] += h[ i ] * weight * k[ i ];
+            }
+        }
+    }
+}
+
+//! Construct batch of states.
+BatchState::BatchState( const std::size_t aNumberOfLanes )
+    : numberOfLanes( aNumberOfLanes ),
+      stride( std::max< std::size_t >( ( aNumberOfLanes + laneWidth - 1 ) / laneWidth, 1 )
+              * laneWidth ),
+      buffer( numberOfComponents * stride + laneWidth, 0.0 ),
+      components( 0 )
+{
+    align( );
+}
+
+//! Copy constructor.
+BatchState::BatchState( const BatchState& otherBatchState )
+    : numberOfLanes( otherBatchState.numberOfLanes ),
+      stride( otherBatchState.stride ),
+      buffer( otherBatchState.buffer.size( ), 0.0 ),
+      components( 0 )
+{
+    align( );
+    std::copy( otherBatchState.components,
+               otherBatchState.components + numberOfComponents * stride,
+               components );
+}
+
+//! Assignment operator.
+BatchState& BatchState::operator=( const BatchState& otherBatchState )
+{
+    if ( otherBatchState.stride != stride )
+    {
+        throw std::runtime_error( "ERROR: Batches of states differ in number of lanes!" );
+    }
+
+    numberOfLanes = otherBatchState.numberOfLanes;
+    std::copy( otherBatchState.components,
+               otherBatchState.components + numberOfComponents * stride,
+               components );
+    return *this;
+}
+
+//! Get state of lane.
+State BatchState::getState( const std::size_t lane ) const
+{
+    State state;
+    for ( std::size_t c = 0; c < numberOfComponents; c++ )
+    {
+        state[ c ] = ( *this )[ c ][ lane ];
+    }
+    return state;
+}
+
+//! Set state of lane.
+void BatchState::setState( const std::size_t lane, const State& state )
+{
+    for ( std::size_t c = 0; c < numberOfComponents; c++ )
+    {
+        ( *this )[ c ][ lane ] = state[ c ];
+    }
+}
+
+//! Set up aligned component arrays in buffer.
+void BatchState::align( )
+{
+    const std::uintptr_t address = reinterpret_cast< std::uintptr_t >( &buffer[ 0 ] );
+    const std::size_t offset
+        = ( ( laneAlignment - address % laneAlignment ) % laneAlignment ) / sizeof( double );
+    components = &buffer[ 0 ] + offset;
+}
+
+//! Add acceleration to state derivatives.
+void BatchCentralGravityModel::operator( )( const BatchState& state,
+                                            const double* /* time */,
+                                            BatchState& stateDerivative ) const
+{
+    const std::size_t numberOfLanes = state.paddedSize( );
+    const double* __restrict x = state[ 0 ];
+    const double* __restrict y = state[ 1 ];
+    const double* __restrict z = state[ 2 ];
+    double* __restrict ax = stateDerivative[ 3 ];
+    double* __restrict ay = stateDerivative[ 4 ];
+    double* __restrict az = stateDerivative[ 5 ];
+
+    for ( std::size_t i = 0; i < numberOfLanes; i++ )
+    {
+        const double radiusSquared = x[ i ] * x[ i ] + y[ i ] * y[ i ] + z[ i ] * z[ i ];
+
+        // Padding lanes are all zero; guard against division by zero without branching.
+        const double safeRadiusSquared = radiusSquared > 0.0 ? radiusSquared : 1.0;
+        const double factor = -gravitationalParameter
+                              / ( safeRadiusSquared * std::sqrt( safeRadiusSquared ) );
+
+        ax[ i ] += factor * x[ i ];
+        ay[ i ] += factor * y[ i ];
+        az[ i ] += factor * z[ i ];
+    }
+}
+
+//! Construct batch propagator.
+BatchPropagator::BatchPropagator( const ListOfBatchAccelerationModels& aListOfAccelerationModels,
+                                  const std::size_t aNumberOfLanes )
+    : listOfAccelerationModels( aListOfAccelerationModels ),
+      numberOfLanes( aNumberOfLanes ),
+      stages( 7, BatchState( aNumberOfLanes ) ),
+      stageState( aNumberOfLanes ),
+      candidateState( aNumberOfLanes ),
+      laneTime( stageState.paddedSize( ), 0.0 ),
+      stageTime( stageState.paddedSize( ), 0.0 ),
+      laneStepSize( stageState.paddedSize( ), 0.0 ),
+      attemptedStepSize( stageState.paddedSize( ), 0.0 ),
+      laneError( stageState.paddedSize( ), 0.0 )
+{ }
+
+//! Propagate batch with fixed step size.
+BatchPropagationStatistics BatchPropagator::propagateFixedStep( BatchState& state,
+                                                               const double startTime,
+                                                               const double endTime,
+                                                               const double stepSize )
+{
+    if ( state.paddedSize( ) != stageState.paddedSize( ) )
+    {
+        throw std::runtime_error( "ERROR: Batch size does not match batch propagator!" );
+    }
+
+    if ( !( stepSize > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Step size must be positive!" );
+    }
+
+    if ( !( endTime > startTime ) )
+    {
+        throw std::runtime_error( "ERROR: End time must be after start time!" );
+    }
+
+    // Classical 4th-order Runge-Kutta tableau.
+    const double a2[ ] = { 0.5 };
+    const double a3[ ] = { 0.0, 0.5 };
+    const double a4[ ] = { 0.0, 0.0, 1.0 };
+    const double b[ ]  = { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 };
+
+    BatchPropagationStatistics statistics;
+
+    double time = startTime;
+    while ( time < endTime )
+    {
+        const bool isLastStep = time + stepSize >= endTime;
+        const double h = isLastStep ? endTime - time : stepSize;
+        if ( !isLastStep && time + h == time )
+        {
+            throw std::runtime_error( "ERROR: Step size is too small to advance time at t = "
+                                      + std::to_string( time ) + " s!" );
+        }
+        std::fill( attemptedStepSize.begin( ), attemptedStepSize.end( ), h );
+
+        std::fill( stageTime.begin( ), stageTime.end( ), time );
+        computeStateDerivative( state, &stageTime[ 0 ], stages[ 0 ] );
+
+        std::fill( stageTime.begin( ), stageTime.end( ), time + 0.5 * h );
+        addStages( state, &attemptedStepSize[ 0 ], stages, a2, 1, stageState );
+        computeStateDerivative( stageState, &stageTime[ 0 ], stages[ 1 ] );
+
+        addStages( state, &attemptedStepSize[ 0 ], stages, a3, 2, stageState );
+        computeStateDerivative( stageState, &stageTime[ 0 ], stages[ 2 ] );
+
+        std::fill( stageTime.begin( ), stageTime.end( ), time + h );
+        addStages( state, &attemptedStepSize[ 0 ], stages, a4, 3, stageState );
+        computeStateDerivative( stageState, &stageTime[ 0 ], stages[ 3 ] );
+
+        addStages( state, &attemptedStepSize[ 0 ], stages, b, 4, candidateState );
+        state = candidateState;
+
+        time = isLastStep ? endTime : time + h;
+        statistics.numberOfBatchSteps++;
+        statistics.numberOfAcceptedSteps += numberOfLanes;
+    }
+
+    return statistics;
+}
+
+//! Propagate batch with adaptive step size.
+BatchPropagationStatistics BatchPropagator::propagateAdaptive( BatchState& state,
+                                                              const double startTime,
+                                                              const double endTime,
+                                                              const double initialStepSize,
+                                                              const double absoluteTolerance,
+                                                              const double relativeTolerance )
+{
+    if ( state.paddedSize( ) != stageState.paddedSize( ) )
+    {
+        throw std::runtime_error( "ERROR: Batch size does not match batch propagator!" );
+    }
+
+    if ( !( initialStepSize > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Initial step must be positive!" );
+    }
+
+    if ( !( endTime > startTime ) )
+    {
+        throw std::runtime_error( "ERROR: End time must be after start time!" );
+    }
+
+    if ( !( absoluteTolerance > 0.0 ) || !( relativeTolerance >= 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Absolute tolerance must be positive and relative "
+                                  "tolerance must be non-negative!" );
+    }
+
+    // Dormand-Prince 5(4) tableau (Dormand and Prince, 1980).
+    const double c[ ]  = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+    const double a2[ ] = { 1.0 / 5.0 };
+    const double a3[ ] = { 3.0 / 40.0, 9.0 / 40.0 };
+    const double a4[ ] = { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 };
+    const double a5[ ] = { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0,
+                           -212.0 / 729.0 };
+    const double a6[ ] = { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+                           -5103.0 / 18656.0 };
+    const double a7[ ] = { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0,
+                           11.0 / 84.0 };
+    const double* const a[ ] = { 0, a2, a3, a4, a5, a6, a7 };
+
+    // Difference between 5th- and embedded 4th-order weights.
+    const double e[ ] = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+                          -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+
+    const double minimumFactor = 0.2;
+    const double maximumFactor = 5.0;
+    const double safetyFactor = 0.9;
+    const double timeTolerance
+        = 16.0 * std::numeric_limits< double >::epsilon( )
+          * std::max( std::fabs( startTime ), std::fabs( endTime ) );
+
+    BatchPropagationStatistics statistics;
+    const std::size_t paddedSize = state.paddedSize( );
+
+    std::fill( laneTime.begin( ), laneTime.end( ), startTime );
+    std::fill( laneStepSize.begin( ), laneStepSize.end( ), initialStepSize );
+
+    // First stage of first step; afterwards the last stage of each step is reused (FSAL).
+    computeStateDerivative( state, &laneTime[ 0 ], stages[ 0 ] );
+
+    std::size_t numberOfActiveLanes = numberOfLanes;
+    while ( numberOfActiveLanes > 0 )
+    {
+        // Clip step size to end time; lanes that have arrived take a step of zero.
+        for ( std::size_t i = 0; i < paddedSize; i++ )
+        {
+            const double remainingTime = endTime - laneTime[ i ];
+            attemptedStepSize[ i ] = i < numberOfLanes && remainingTime > timeTolerance
+                                     ? std::min( laneStepSize[ i ], remainingTime ) : 0.0;
+        }
+
+        for ( std::size_t s = 1; s < 7; s++ )
+        {
+            BatchState& output = s < 6 ? stageState : candidateState;
+            addStages( state, &attemptedStepSize[ 0 ], stages, a[ s ], s, output );
+            for ( std::size_t i = 0; i < paddedSize; i++ )
+            {
+                stageTime[ i ] = laneTime[ i ] + c[ s ] * attemptedStepSize[ i ];
+            }
+            computeStateDerivative( output, &stageTime[ 0 ], stages[ s ] );
+        }
+
+        // Lane-wise error estimate, scaled by the mixed absolute/relative tolerance.
+        std::fill( laneError.begin( ), laneError.end( ), 0.0 );
+        for ( std::size_t k = 0; k < BatchState::numberOfComponents; k++ )
+        {
+            const double* __restrict x = state[ k ];
+            const double* __restrict y = candidateState[ k ];
+            const double* __restrict h = &attemptedStepSize[ 0 ];
+            const double* __restrict k1 = stages[ 0 ][ k ];
+            const double* __restrict k3 = stages[ 2 ][ k ];
+            const double* __restrict k4 = stages[ 3 ][ k ];
+            const double* __restrict k5 = stages[ 4 ][ k ];
+            const double* __restrict k6 = stages[ 5 ][ k ];
+            const double* __restrict k7 = stages[ 6 ][ k ];
+            double* __restrict error = &laneError[ 0 ];
+
+            for ( std::size_t i = 0; i < paddedSize; i++ )
+            {
+                const double errorEstimate
+                    = e[ 0 ] * k1[ i ] + e[ 2 ] * k3[ i ] + e[ 3 ] * k4[ i ]
+                      + e[ 4 ] * k5[ i ] + e[ 5 ] * k6[ i ] + e[ 6 ] * k7[ i ];
+                const double scale = absoluteTolerance
+                                     + relativeTolerance
+                                       * std::max( std::fabs( x[ i ] ), std::fabs( y[ i ] ) );
+                error[ i ] = std::max( error[ i ], std::fabs( h[ i ] * errorEstimate ) / scale );
+            }
+        }
+
+        // Accept or reject step per lane and adapt lane step size.
+        numberOfActiveLanes = 0;
+        for ( std::size_t i = 0; i < numberOfLanes; i++ )
+        {
+            const double h = attemptedStepSize[ i ];
+            if ( h == 0.0 )
+            {
+                continue;
+            }
+
+            const double error = laneError[ i ];
+            const bool isAccepted = error <= 1.0;
+            double factor = error > 0.0
+                            ? safetyFactor * std::pow( error, -0.2 ) : maximumFactor;
+            factor = std::min( maximumFactor, std::max( minimumFactor, factor ) );
+
+            if ( isAccepted )
+            {
+                const bool isLastStep = h >= endTime - laneTime[ i ];
+                laneTime[ i ] = isLastStep ? endTime : laneTime[ i ] + h;
+                for ( std::size_t k = 0; k < BatchState::numberOfComponents; k++ )
+                {
+                    state[ k ][ i ] = candidateState[ k ][ i ];
+                    stages[ 0 ][ k ][ i ] = stages[ 6 ][ k ][ i ];
+                }
+                laneStepSize[ i ] = h * factor;
+                statistics.numberOfAcceptedSteps++;
+            }
+            else
+            {
+                // A step that no longer advances the time of the lane would be retried forever.
+                laneStepSize[ i ] = h * std::min( factor, 1.0 );
+                statistics.numberOfRejectedSteps++;
+                if ( laneTime[ i ] + laneStepSize[ i ] == laneTime[ i ] )
+                {
+                    throw std::runtime_error(
+                        "ERROR: Batch propagator failed to meet tolerances at t = "
+                        + std::to_string( laneTime[ i ] ) + " s!" );
+                }
+            }
+
+            if ( endTime - laneTime[ i ] > timeTolerance )
+            {
+                numberOfActiveLanes++;
+            }
+        }
+
+        statistics.numberOfBatchSteps++;
+    }
+
+    return statistics;
+}
+
+//! Compute state derivatives.
+void BatchPropagator::computeStateDerivative( const BatchState& state,
+                                              const double* time,
+                                              BatchState& stateDerivative ) const
+{
+    const std::size_t paddedSize = state.paddedSize( );
+    for ( std::size_t k = 0; k < 3; k++ )
+    {
+        const double* __restrict velocity = state[ k + 3 ];
+        double* __restrict positionDerivative = stateDerivative[ k ];
+        double* __restrict velocityDerivative = stateDerivative[ k + 3 ];
+        for ( std::size_t i = 0; i < paddedSize; i++ )
+        {
+            positionDerivative[ i ] = velocity[ i ];
+            velocityDerivative[ i ] = 0.0;
+        }
+    }
+
+    for ( std::size_t j = 0; j < listOfAccelerationModels.size( ); j++ )
+    {
+        ( *listOfAccelerationModels[ j ] )( state, time, stateDerivative );
+    }
+}
+
+} // namespace scarab
+
+/*!
+ * J.R. Dormand and P.J. Prince, A family of embedded Runge-Kutta formulae, Journal of
+ *  Computational and Applied Mathematics 6(1), pp. 19-26 (1980).
+ */
@@ -0,0 +1,739 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+#include <rapidjson/document.h>
+
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/internalTools.hpp"
+
+namespace scarab
+{
+
+//! Magic string at start of Chebyshev trajectory file.
+static const char chebyshevTrajectoryFileMagic[ ] = "SCARABCT";
+
+//! Size of fixed prefix of Chebyshev trajectory file (magic, version, header length, segments).
+static const std::size_t chebyshevTrajectoryFilePrefixSize = 24;
+
+//! Alignment of data in Chebyshev trajectory file [bytes].
+static const std::size_t chebyshevTrajectoryFileAlignment = 64;
+
+//! Number of segment lookup buckets per segment.
+static const std::size_t numberOfBucketsPerSegment = 4;
+
+//! Evaluate Chebyshev polynomials and their derivatives.
+/*!
+ * Evaluates the Chebyshev polynomials T_k and their derivatives T_k' = k U_{k-1} at the given
+ * normalized time, for k = 0, ..., n - 1, using the recurrences of the polynomials of the first
+ * (T) and second (U) kind.
+ */
+static void evaluateChebyshevPolynomials( const double tau,
+                                          const std::size_t numberOfPolynomials,
+                                          double* polynomials,
+                                          double* derivatives )
+{
+    double previousU = 0.0;
+    double currentU = 1.0;
+    polynomials[ 0 ] = 1.0;
+    derivatives[ 0 ] = 0.0;
+    if ( numberOfPolynomials > 1 )
+    {
+        polynomials[ 1 ] = tau;
+        derivatives[ 1 ] = 1.0;
+    }
+    for ( std::size_t k = 2; k < numberOfPolynomials; k++ )
+    {
+        polynomials[ k ] = 2.0 * tau * polynomials[ k - 1 ] - polynomials[ k - 2 ];
+        const double nextU = 2.0 * tau * currentU - previousU;
+        previousU = currentU;
+        currentU = nextU;
+        derivatives[ k ] = k * currentU;
+    }
+}
+
+//! Solve linear least-squares problem.
+/*!
+ * Solves the overdetermined (or square) system A X = B in a least-squares sense by Householder QR
+ * decomposition, where A is an m x n matrix (m >= n) and B an m x 3 matrix, both stored row-major.
+ * The matrices are overwritten. Unknowns that do not affect the residual (zero pivot) are set to
+ * zero.
+ */
+static void solveLeastSquares( std::vector< double >& matrix,
+                               std::vector< double >& rightHandSide,
+                               const std::size_t numberOfRows,
+                               const std::size_t numberOfColumns,
+                               std::vector< double >& solution )
+{
+    std::vector< double > reflector( numberOfRows );
+    for ( std::size_t k = 0; k < numberOfColumns; k++ )
+    {
+        double columnNorm = 0.0;
+        for ( std::size_t i = k; i < numberOfRows; i++ )
+        {
+            columnNorm += matrix[ i * numberOfColumns + k ] * matrix[ i * numberOfColumns + k ];
+        }
+        columnNorm = std::sqrt( columnNorm );
+        if ( columnNorm == 0.0 )
+        {
+            continue;
+        }
+
+        // Householder reflection that maps column k onto -sign( A_kk ) |A_k| e_k.
+        const double diagonal = matrix[ k * numberOfColumns + k ];
+        const double alpha = diagonal > 0.0 ? -columnNorm : columnNorm;
+        double reflectorNorm = 0.0;
+        for ( std::size_t i = k; i < numberOfRows; i++ )
+        {
+            reflector[ i ] = matrix[ i * numberOfColumns + k ];
+        }
+        reflector[ k ] -= alpha;
+        for ( std::size_t i = k; i < numberOfRows; i++ )
+        {
+            reflectorNorm += reflector[ i ] * reflector[ i ];
+        }
+
+        for ( std::size_t j = k; j < numberOfColumns; j++ )
+        {
+            double projection = 0.0;
+            for ( std::size_t i = k; i < numberOfRows; i++ )
+            {
+                projection += reflector[ i ] * matrix[ i * numberOfColumns + j ];
+            }
+            const double scale = 2.0 * projection / reflectorNorm;
+            for ( std::size_t i = k; i < numberOfRows; i++ )
+            {
+                matrix[ i * numberOfColumns + j ] -= scale * reflector[ i ];
+            }
+        }
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            double projection = 0.0;
+            for ( std::size_t i = k; i < numberOfRows; i++ )
+            {
+                projection += reflector[ i ] * rightHandSide[ i * 3 + j ];
+            }
+            const double scale = 2.0 * projection / reflectorNorm;
+            for ( std::size_t i = k; i < numberOfRows; i++ )
+            {
+                rightHandSide[ i * 3 + j ] -= scale * reflector[ i ];
+            }
+        }
+    }
+
+    // Back-substitute upper-triangular system R X = Q^T B.
+    solution.assign( numberOfColumns * 3, 0.0 );
+    for ( std::size_t k = numberOfColumns; k-- > 0; )
+    {
+        const double pivot = matrix[ k * numberOfColumns + k ];
+        if ( pivot == 0.0 )
+        {
+            continue;
+        }
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            double sum = rightHandSide[ k * 3 + j ];
+            for ( std::size_t i = k + 1; i < numberOfColumns; i++ )
+            {
+                sum -= matrix[ k * numberOfColumns + i ] * solution[ i * 3 + j ];
+            }
+            solution[ k * 3 + j ] = sum / pivot;
+        }
+    }
+}
+
+//! Construct Chebyshev trajectory writer.
+ChebyshevTrajectoryWriter::ChebyshevTrajectoryWriter( const std::string& aFilename,
+                                                      const double aPositionTolerance,
+                                                      const double aVelocityTolerance,
+                                                      const std::size_t aNumberOfCoefficients,
+                                                      const std::size_t aMaximumNumberOfSamples )
+    : filename( aFilename ),
+      positionTolerance( aPositionTolerance ),
+      velocityTolerance( aVelocityTolerance ),
+      numberOfCoefficients( aNumberOfCoefficients ),
+      maximumNumberOfSamples( aMaximumNumberOfSamples ),
+      nextFitSize( 0 ),
+      candidateSize( 0 ),
+      candidatePositionError( 0.0 ),
+      candidateVelocityError( 0.0 ),
+      numberOfSamples( 0 ),
+      maximumPositionError( 0.0 ),
+      maximumVelocityError( 0.0 ),
+      isClosed( false )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Chebyshev trajectory files require little-endian host!" );
+    }
+
+    if ( !( positionTolerance > 0.0 ) || !( velocityTolerance > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Tolerances of Chebyshev trajectory must be positive!" );
+    }
+
+    if ( numberOfCoefficients < 2 || numberOfCoefficients > maximumNumberOfChebyshevCoefficients )
+    {
+        std::ostringstream error;
+        error << "ERROR: Number of Chebyshev coefficients must be in the range 2-"
+              << maximumNumberOfChebyshevCoefficients << "!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    if ( maximumNumberOfSamples < 2 )
+    {
+        throw std::runtime_error(
+            "ERROR: Maximum number of samples per Chebyshev segment must be at least 2!" );
+    }
+
+    // The first fit is attempted as soon as there are enough samples (positions and velocities)
+    // to overdetermine the full number of coefficients.
+    nextFitSize = std::min( numberOfCoefficients / 2 + 1, maximumNumberOfSamples );
+}
+
+//! Destruct Chebyshev trajectory writer.
+ChebyshevTrajectoryWriter::~ChebyshevTrajectoryWriter( )
+{
+    if ( !isClosed )
+    {
+        try
+        {
+            close( TrajectoryMetadata( ) );
+        }
+        catch ( ... ) { }
+    }
+}
+
+//! Write sample.
+void ChebyshevTrajectoryWriter::write( const double time, const State& state )
+{
+    if ( isClosed )
+    {
+        throw std::runtime_error( "ERROR: Chebyshev trajectory writer is closed!" );
+    }
+
+    if ( !sampleTimes.empty( ) )
+    {
+        if ( time < sampleTimes.back( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Samples of Chebyshev trajectory must be written in ascending order!" );
+        }
+
+        // Repeated samples are skipped; a jump in the state at the same epoch ends the segment.
+        if ( time == sampleTimes.back( ) )
+        {
+            if ( state == sampleStates.back( ) )
+            {
+                return;
+            }
+            flush( );
+            sampleTimes.clear( );
+            sampleStates.clear( );
+        }
+    }
+
+    sampleTimes.push_back( time );
+    sampleStates.push_back( state );
+    numberOfSamples++;
+
+    if ( sampleTimes.size( ) >= nextFitSize )
+    {
+        extendSegment( );
+    }
+}
+
+//! Flush sink.
+void ChebyshevTrajectoryWriter::flush( )
+{
+    while ( sampleTimes.size( ) >= 2 )
+    {
+        writeLongestSegment( );
+    }
+    nextFitSize = std::min( numberOfCoefficients / 2 + 1, maximumNumberOfSamples );
+}
+
+//! Write checkpoint.
+void ChebyshevTrajectoryWriter::writeCheckpoint( Checkpoint& checkpoint )
+{
+    checkpoint.writeDoubles( sampleTimes );
+    for ( std::size_t i = 0; i < sampleStates.size( ); i++ )
+    {
+        checkpoint.writeState( sampleStates[ i ] );
+    }
+    checkpoint.writeSize( nextFitSize );
+    checkpoint.writeSize( candidateSize );
+    checkpoint.writeDoubles( candidateCoefficients );
+    checkpoint.writeDouble( candidatePositionError );
+    checkpoint.writeDouble( candidateVelocityError );
+    checkpoint.writeDoubles( boundaries );
+    checkpoint.writeDoubles( coefficients );
+    checkpoint.writeSize( numberOfSamples );
+    checkpoint.writeDouble( maximumPositionError );
+    checkpoint.writeDouble( maximumVelocityError );
+}
+
+//! Restore checkpoint.
+void ChebyshevTrajectoryWriter::restoreCheckpoint( Checkpoint& checkpoint )
+{
+    sampleTimes = checkpoint.readDoubles( );
+    sampleStates.clear( );
+    for ( std::size_t i = 0; i < sampleTimes.size( ); i++ )
+    {
+        sampleStates.push_back( checkpoint.readState( ) );
+    }
+    nextFitSize = checkpoint.readSize( );
+    candidateSize = checkpoint.readSize( );
+    candidateCoefficients = checkpoint.readDoubles( );
+    candidatePositionError = checkpoint.readDouble( );
+    candidateVelocityError = checkpoint.readDouble( );
+    boundaries = checkpoint.readDoubles( );
+    coefficients = checkpoint.readDoubles( );
+    numberOfSamples = checkpoint.readSize( );
+    maximumPositionError = checkpoint.readDouble( );
+    maximumVelocityError = checkpoint.readDouble( );
+}
+
+//! Close writer.
+void ChebyshevTrajectoryWriter::close( const TrajectoryMetadata& metadata )
+{
+    if ( isClosed )
+    {
+        return;
+    }
+
+    flush( );
+    isClosed = true;
+
+    // Assemble header, padded such that the data starts at an aligned offset.
+    std::ostringstream header;
+    char value[ 32 ];
+    header << "{\"number_of_coefficients\":" << numberOfCoefficients;
+    std::snprintf( value, sizeof( value ), "%.17g", positionTolerance );
+    header << ",\"position_tolerance\":" << value;
+    std::snprintf( value, sizeof( value ), "%.17g", velocityTolerance );
+    header << ",\"velocity_tolerance\":" << value;
+    header << ",\"metadata\":[";
+    for ( std::size_t i = 0; i < metadata.size( ); i++ )
+    {
+        std::snprintf( value, sizeof( value ), "%.17g", metadata[ i ].value );
+        header << ( i > 0 ? "," : "" )
+               << "{\"name\":\"" << escapeJsonString( metadata[ i ].name )
+               << "\",\"value\":" << value
+               << ",\"units\":\"" << escapeJsonString( metadata[ i ].units ) << "\"}";
+    }
+    header << "]}";
+
+    std::string headerText = header.str( );
+    const std::size_t unpaddedSize = chebyshevTrajectoryFilePrefixSize + headerText.size( );
+    headerText.append( ( chebyshevTrajectoryFileAlignment
+                         - unpaddedSize % chebyshevTrajectoryFileAlignment )
+                       % chebyshevTrajectoryFileAlignment, ' ' );
+
+    std::ofstream file( filename.c_str( ), std::ios::binary | std::ios::trunc );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not open Chebyshev trajectory file \""
+                                  + filename + "\"!" );
+    }
+
+    file.write( chebyshevTrajectoryFileMagic, 8 );
+    writeLittleEndian( file, chebyshevTrajectoryFileVersion, 4 );
+    writeLittleEndian( file, headerText.size( ), 4 );
+    writeLittleEndian( file, getNumberOfSegments( ), 8 );
+    file.write( headerText.data( ), headerText.size( ) );
+    if ( !boundaries.empty( ) )
+    {
+        file.write( reinterpret_cast< const char* >( &boundaries[ 0 ] ),
+                    boundaries.size( ) * sizeof( double ) );
+        file.write( reinterpret_cast< const char* >( &coefficients[ 0 ] ),
+                    coefficients.size( ) * sizeof( double ) );
+    }
+
+    file.close( );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not write Chebyshev trajectory file \""
+                                  + filename + "\"!" );
+    }
+}
+
+//! Fit segment to buffered samples.
+bool ChebyshevTrajectoryWriter::fitSegment( const std::size_t numberOfSegmentSamples,
+                                            std::vector< double >& segmentCoefficients,
+                                            double& positionError,
+                                            double& velocityError ) const
+{
+    // If enough samples remain to overdetermine the coefficients, every third interior sample is
+    // held out of the fit, so that the errors at the held-out samples show if the polynomials
+    // stray from the trajectory in between the fitted samples.
+    const std::size_t numberOfHeldOutSamples = ( numberOfSegmentSamples - 1 ) / 3;
+    const bool isHoldingOut
+        = 2 * ( numberOfSegmentSamples - numberOfHeldOutSamples ) > numberOfCoefficients;
+    std::vector< std::size_t > fittedSamples;
+    for ( std::size_t i = 0; i < numberOfSegmentSamples; i++ )
+    {
+        if ( !isHoldingOut || i % 3 != 2 || i == numberOfSegmentSamples - 1 )
+        {
+            fittedSamples.push_back( i );
+        }
+    }
+
+    // Every fitted sample contributes three position and three velocity equations; with few
+    // samples, the number of coefficients fitted is reduced, such that the system is not
+    // underdetermined.
+    const std::size_t numberOfRows = 2 * fittedSamples.size( );
+    const std::size_t numberOfFittedCoefficients = std::min( numberOfCoefficients, numberOfRows );
+
+    const double segmentStart = sampleTimes[ 0 ];
+    const double segmentEnd = sampleTimes[ numberOfSegmentSamples - 1 ];
+    const double timeScale = 2.0 / ( segmentEnd - segmentStart );
+
+    // The velocity equations are weighted with the ratio of the tolerances, such that position
+    // and velocity residuals are measured relative to their tolerances.
+    const double velocityWeight = positionTolerance / velocityTolerance;
+
+    double polynomials[ maximumNumberOfChebyshevCoefficients ];
+    double derivatives[ maximumNumberOfChebyshevCoefficients ];
+    std::vector< double > matrix( numberOfRows * numberOfFittedCoefficients );
+    std::vector< double > rightHandSide( numberOfRows * 3 );
+    for ( std::size_t l = 0; l < fittedSamples.size( ); l++ )
+    {
+        const std::size_t i = fittedSamples[ l ];
+        const double tau = ( sampleTimes[ i ] - segmentStart ) * timeScale - 1.0;
+        evaluateChebyshevPolynomials( tau, numberOfFittedCoefficients, polynomials, derivatives );
+
+        double* positionRow = &matrix[ 2 * l * numberOfFittedCoefficients ];
+        double* velocityRow = positionRow + numberOfFittedCoefficients;
+        for ( std::size_t k = 0; k < numberOfFittedCoefficients; k++ )
+        {
+            positionRow[ k ] = polynomials[ k ];
+            velocityRow[ k ] = derivatives[ k ] * timeScale * velocityWeight;
+        }
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            rightHandSide[ 6 * l + j ] = sampleStates[ i ][ j ];
+            rightHandSide[ 6 * l + 3 + j ] = sampleStates[ i ][ j + 3 ] * velocityWeight;
+        }
+    }
+
+    std::vector< double > solution;
+    solveLeastSquares(
+        matrix, rightHandSide, numberOfRows, numberOfFittedCoefficients, solution );
+
+    segmentCoefficients.assign( 3 * numberOfCoefficients, 0.0 );
+    for ( std::size_t k = 0; k < numberOfFittedCoefficients; k++ )
+    {
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            segmentCoefficients[ j * numberOfCoefficients + k ] = solution[ k * 3 + j ];
+        }
+    }
+
+    // Compute errors at all samples, fitted and held out.
+    positionError = 0.0;
+    velocityError = 0.0;
+    for ( std::size_t i = 0; i < numberOfSegmentSamples; i++ )
+    {
+        const double tau = ( sampleTimes[ i ] - segmentStart ) * timeScale - 1.0;
+        evaluateChebyshevPolynomials( tau, numberOfFittedCoefficients, polynomials, derivatives );
+
+        double positionErrorSquared = 0.0;
+        double velocityErrorSquared = 0.0;
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            const double* componentCoefficients = &segmentCoefficients[ j * numberOfCoefficients ];
+            double position = 0.0;
+            double velocity = 0.0;
+            for ( std::size_t k = 0; k < numberOfFittedCoefficients; k++ )
+            {
+                position += componentCoefficients[ k ] * polynomials[ k ];
+                velocity += componentCoefficients[ k ] * derivatives[ k ];
+            }
+            const double positionDifference = position - sampleStates[ i ][ j ];
+            const double velocityDifference = velocity * timeScale - sampleStates[ i ][ j + 3 ];
+            positionErrorSquared += positionDifference * positionDifference;
+            velocityErrorSquared += velocityDifference * velocityDifference;
+        }
+        positionError = std::max( positionError, std::sqrt( positionErrorSquared ) );
+        velocityError = std::max( velocityError, std::sqrt( velocityErrorSquared ) );
+    }
+
+    return positionError <= positionTolerance && velocityError <= velocityTolerance;
+}
+
+//! Try to extend segment with buffered samples.
+void ChebyshevTrajectoryWriter::extendSegment( )
+{
+    const std::size_t minimumFitSize
+        = std::min( numberOfCoefficients / 2 + 1, maximumNumberOfSamples );
+
+    while ( sampleTimes.size( ) >= nextFitSize )
+    {
+        const std::size_t fitSize = sampleTimes.size( );
+        std::vector< double > segmentCoefficients;
+        double positionError = 0.0;
+        double velocityError = 0.0;
+        if ( fitSegment( fitSize, segmentCoefficients, positionError, velocityError ) )
+        {
+            if ( fitSize >= maximumNumberOfSamples )
+            {
+                writeSegment( fitSize, segmentCoefficients, positionError, velocityError );
+            }
+            else
+            {
+                candidateSize = fitSize;
+                candidateCoefficients.swap( segmentCoefficients );
+                candidatePositionError = positionError;
+                candidateVelocityError = velocityError;
+                nextFitSize = std::min( fitSize + fitSize / 4 + 1, maximumNumberOfSamples );
+                return;
+            }
+        }
+        else if ( candidateSize > 0 )
+        {
+            writeSegment( candidateSize, candidateCoefficients,
+                          candidatePositionError, candidateVelocityError );
+        }
+        else
+        {
+            writeLongestSegment( );
+        }
+
+        nextFitSize = minimumFitSize;
+    }
+}
+
+//! Write longest segment within tolerance.
+void ChebyshevTrajectoryWriter::writeLongestSegment( )
+{
+    std::size_t fitSize = sampleTimes.size( );
+    std::vector< double > segmentCoefficients;
+    double positionError = 0.0;
+    double velocityError = 0.0;
+    while ( !fitSegment( fitSize, segmentCoefficients, positionError, velocityError ) )
+    {
+        if ( fitSize == 2 )
+        {
+            std::ostringstream error;
+            error << "ERROR: Chebyshev segment between t = " << sampleTimes[ 0 ] << " s and t = "
+                  << sampleTimes[ 1 ] << " s is not within tolerance; increase the number of "
+                  << "coefficients or decrease the state history interval!";
+            throw std::runtime_error( error.str( ) );
+        }
+
+        if ( candidateSize > 1 && candidateSize < fitSize )
+        {
+            fitSize = candidateSize;
+        }
+        else
+        {
+            fitSize = std::max( fitSize / 2, std::size_t( 2 ) );
+        }
+    }
+    writeSegment( fitSize, segmentCoefficients, positionError, velocityError );
+}
+
+//! Write segment.
+void ChebyshevTrajectoryWriter::writeSegment( const std::size_t numberOfSegmentSamples,
+                                              const std::vector< double >& segmentCoefficients,
+                                              const double positionError,
+                                              const double velocityError )
+{
+    if ( boundaries.empty( ) )
+    {
+        boundaries.push_back( sampleTimes[ 0 ] );
+    }
+    boundaries.push_back( sampleTimes[ numberOfSegmentSamples - 1 ] );
+    coefficients.insert( coefficients.end( ),
+                         segmentCoefficients.begin( ), segmentCoefficients.end( ) );
+    maximumPositionError = std::max( maximumPositionError, positionError );
+    maximumVelocityError = std::max( maximumVelocityError, velocityError );
+
+    sampleTimes.erase( sampleTimes.begin( ),
+                       sampleTimes.begin( ) + numberOfSegmentSamples - 1 );
+    sampleStates.erase( sampleStates.begin( ),
+                        sampleStates.begin( ) + numberOfSegmentSamples - 1 );
+    candidateSize = 0;
+}
+
+//! Construct Chebyshev trajectory.
+ChebyshevTrajectory::ChebyshevTrajectory( const std::string& filename )
+    : file( filename.c_str( ), boost::interprocess::read_only ),
+      region( file, boost::interprocess::read_only ),
+      numberOfSegments( 0 ),
+      numberOfCoefficients( 0 ),
+      positionTolerance( 0.0 ),
+      velocityTolerance( 0.0 ),
+      boundaries( 0 ),
+      coefficients( 0 )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Chebyshev trajectory files require little-endian host!" );
+    }
+
+    const unsigned char* bytes = static_cast< const unsigned char* >( region.get_address( ) );
+    const std::size_t fileSize = region.get_size( );
+
+    if ( fileSize < chebyshevTrajectoryFilePrefixSize
+         || std::memcmp( bytes, chebyshevTrajectoryFileMagic, 8 ) != 0 )
+    {
+        throw std::runtime_error( "ERROR: \"" + filename
+                                  + "\" is not a Chebyshev trajectory file!" );
+    }
+
+    const boost::uint64_t version = readLittleEndian( bytes + 8, 4 );
+    if ( version != chebyshevTrajectoryFileVersion )
+    {
+        std::ostringstream error;
+        error << "ERROR: Chebyshev trajectory file version " << version << " is not supported!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    const std::size_t headerSize = static_cast< std::size_t >( readLittleEndian( bytes + 12, 4 ) );
+    numberOfSegments = static_cast< std::size_t >( readLittleEndian( bytes + 16, 8 ) );
+    if ( fileSize < chebyshevTrajectoryFilePrefixSize + headerSize )
+    {
+        throw std::runtime_error( "ERROR: Header of Chebyshev trajectory file \"" + filename
+                                  + "\" is truncated!" );
+    }
+
+    // Parse header.
+    const std::string headerText(
+        reinterpret_cast< const char* >( bytes + chebyshevTrajectoryFilePrefixSize ), headerSize );
+    rapidjson::Document header;
+    header.Parse( headerText.c_str( ) );
+    if ( header.HasParseError( ) || !header.IsObject( )
+         || !header.HasMember( "number_of_coefficients" )
+         || !header.HasMember( "position_tolerance" )
+         || !header.HasMember( "velocity_tolerance" ) || !header.HasMember( "metadata" ) )
+    {
+        throw std::runtime_error( "ERROR: Header of Chebyshev trajectory file \"" + filename
+                                  + "\" is invalid!" );
+    }
+
+    numberOfCoefficients
+        = static_cast< std::size_t >( header[ "number_of_coefficients" ].GetUint64( ) );
+    positionTolerance = header[ "position_tolerance" ].GetDouble( );
+    velocityTolerance = header[ "velocity_tolerance" ].GetDouble( );
+    if ( numberOfCoefficients < 2 || numberOfCoefficients > maximumNumberOfChebyshevCoefficients )
+    {
+        throw std::runtime_error( "ERROR: Number of coefficients in Chebyshev trajectory file \""
+                                  + filename + "\" is not supported!" );
+    }
+
+    const rapidjson::Value& metadataEntries = header[ "metadata" ];
+    for ( rapidjson::SizeType i = 0; i < metadataEntries.Size( ); i++ )
+    {
+        const rapidjson::Value& entry = metadataEntries[ i ];
+        metadata.push_back( TrajectoryMetadataEntry( entry[ "name" ].GetString( ),
+                                                     entry[ "value" ].GetDouble( ),
+                                                     entry[ "units" ].GetString( ) ) );
+    }
+
+    if ( numberOfSegments == 0 )
+    {
+        throw std::runtime_error( "ERROR: Chebyshev trajectory file \"" + filename
+                                  + "\" contains no segments!" );
+    }
+
+    const std::size_t dataOffset = chebyshevTrajectoryFilePrefixSize + headerSize;
+    const std::size_t numberOfValues
+        = numberOfSegments + 1 + 3 * numberOfSegments * numberOfCoefficients;
+    if ( fileSize < dataOffset + numberOfValues * sizeof( double ) )
+    {
+        throw std::runtime_error( "ERROR: Data of Chebyshev trajectory file \"" + filename
+                                  + "\" is truncated!" );
+    }
+    boundaries = reinterpret_cast< const double* >( bytes + dataOffset );
+    coefficients = boundaries + numberOfSegments + 1;
+
+    for ( std::size_t i = 0; i < numberOfSegments; i++ )
+    {
+        if ( !( boundaries[ i + 1 ] > boundaries[ i ] ) )
+        {
+            throw std::runtime_error( "ERROR: Segments of Chebyshev trajectory file \""
+                                      + filename + "\" are not in ascending order!" );
+        }
+    }
+
+    // Build lookup table of segments.
+    lookupTable = IntervalLookupTable( boundaries, numberOfSegments, numberOfBucketsPerSegment );
+}
+
+//! Find segment.
+std::size_t ChebyshevTrajectory::findSegment( const double time ) const
+{
+    if ( !( time >= getStartTime( ) && time <= getEndTime( ) ) )
+    {
+        std::ostringstream error;
+        error << "ERROR: Time " << time << " s is outside of Chebyshev trajectory ["
+              << getStartTime( ) << "; " << getEndTime( ) << "] s!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    return lookupTable.findInterval( boundaries, time );
+}
+
+//! Get position.
+Position ChebyshevTrajectory::getPosition( const double time ) const
+{
+    const State state = getState( time );
+
+    Position position;
+    for ( unsigned int i = 0; i < position.size( ); i++ )
+    {
+        position[ i ] = state[ i ];
+    }
+    return position;
+}
+
+//! Get state.
+State ChebyshevTrajectory::getState( const double time ) const
+{
+    const std::size_t segment = findSegment( time );
+    const double segmentStart = boundaries[ segment ];
+    const double timeScale = 2.0 / ( boundaries[ segment + 1 ] - segmentStart );
+    const double tau = ( time - segmentStart ) * timeScale - 1.0;
+
+    double polynomials[ maximumNumberOfChebyshevCoefficients ];
+    double derivatives[ maximumNumberOfChebyshevCoefficients ];
+    evaluateChebyshevPolynomials( tau, numberOfCoefficients, polynomials, derivatives );
+
+    State state;
+    const double* segmentCoefficients = coefficients + 3 * segment * numberOfCoefficients;
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+        const double* componentCoefficients = segmentCoefficients + j * numberOfCoefficients;
+        double position = 0.0;
+        double velocity = 0.0;
+        for ( std::size_t k = 0; k < numberOfCoefficients; k++ )
+        {
+            position += componentCoefficients[ k ] * polynomials[ k ];
+            velocity += componentCoefficients[ k ] * derivatives[ k ];
+        }
+        state[ j ] = position;
+        state[ j + 3 ] = velocity * timeScale;
+    }
+    return state;
+}
+
+} // namespace scarab
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/internalTools.hpp"
+
+namespace scarab
+{
+
+//! Magic string at start of checkpoint file.
+static const char checkpointFileMagic[ ] = "SCARABCK";
+
+//! Size of checkpoint file header (magic, version, padding, data size, checksum) [bytes].
+static const std::size_t checkpointFileHeaderSize = 32;
+
+//! Flush file to disk, so that its data survives a crash of the operating system.
+static bool synchronizeFile( std::FILE* file )
+{
+#ifdef _WIN32
+    return _commit( _fileno( file ) ) == 0;
+#else
+    return fsync( fileno( file ) ) == 0;
+#endif
+}
+
+//! Compute checksum.
+boost::uint64_t computeChecksum( const std::vector< char >& data )
+{
+    boost::uint64_t checksum = 14695981039346656037ULL;
+    for ( std::size_t i = 0; i < data.size( ); i++ )
+    {
+        checksum ^= static_cast< unsigned char >( data[ i ] );
+        checksum *= 1099511628211ULL;
+    }
+    return checksum;
+}
+
+//! Write unsigned integer.
+void Checkpoint::writeSize( const boost::uint64_t value )
+{
+    writeLittleEndian( data, value, 8 );
+}
+
+//! Write double.
+void Checkpoint::writeDouble( const double value )
+{
+    boost::uint64_t bits = 0;
+    std::memcpy( &bits, &value, sizeof( double ) );
+    writeLittleEndian( data, bits, 8 );
+}
+
+//! Write string.
+void Checkpoint::writeString( const std::string& value )
+{
+    writeSize( value.size( ) );
+    data.insert( data.end( ), value.begin( ), value.end( ) );
+}
+
+//! Write state.
+void Checkpoint::writeState( const State& state )
+{
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        writeDouble( state[ i ] );
+    }
+}
+
+//! Write list of doubles.
+void Checkpoint::writeDoubles( const std::vector< double >& values )
+{
+    writeSize( values.size( ) );
+    for ( std::size_t i = 0; i < values.size( ); i++ )
+    {
+        writeDouble( values[ i ] );
+    }
+}
+
+//! Read unsigned integer.
+boost::uint64_t Checkpoint::readSize( )
+{
+    return readLittleEndian( read( 8 ), 8 );
+}
+
+//! Read double.
+double Checkpoint::readDouble( )
+{
+    const boost::uint64_t bits = readLittleEndian( read( 8 ), 8 );
+    double value = 0.0;
+    std::memcpy( &value, &bits, sizeof( double ) );
+    return value;
+}
+
+//! Read string.
+std::string Checkpoint::readString( )
+{
+    const std::size_t length = static_cast< std::size_t >( readSize( ) );
+    const char* characters = reinterpret_cast< const char* >( read( length ) );
+    return std::string( characters, characters + length );
+}
+
+//! Read state.
+State Checkpoint::readState( )
+{
+    State state;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        state[ i ] = readDouble( );
+    }
+    return state;
+}
+
+//! Read list of doubles.
+std::vector< double > Checkpoint::readDoubles( )
+{
+    const std::size_t size = static_cast< std::size_t >( readSize( ) );
+    if ( size > ( data.size( ) - readPosition ) / 8 )
+    {
+        throw std::runtime_error( "ERROR: Checkpoint is truncated!" );
+    }
+
+    std::vector< double > values( size );
+    for ( std::size_t i = 0; i < size; i++ )
+    {
+        values[ i ] = readDouble( );
+    }
+    return values;
+}
+
+//! Swap serialized data.
+void Checkpoint::swap( std::vector< char >& someData )
+{
+    data.swap( someData );
+    readPosition = 0;
+}
+
+//! Read given number of bytes, checking that they are available.
+const unsigned char* Checkpoint::read( const std::size_t numberOfBytes )
+{
+    if ( numberOfBytes > data.size( ) - readPosition )
+    {
+        throw std::runtime_error( "ERROR: Checkpoint is truncated!" );
+    }
+
+    const unsigned char* bytes = reinterpret_cast< const unsigned char* >( data.data( ) )
+                                 + readPosition;
+    readPosition += numberOfBytes;
+    return bytes;
+}
+
+//! Write checkpoint file.
+void writeCheckpointFile( const std::string& filename, const Checkpoint& checkpoint )
+{
+    const std::vector< char >& data = checkpoint.getData( );
+
+    std::vector< char > header( checkpointFileMagic, checkpointFileMagic + 8 );
+    writeLittleEndian( header, checkpointFileVersion, 4 );
+    writeLittleEndian( header, 0, 4 );
+    writeLittleEndian( header, data.size( ), 8 );
+    writeLittleEndian( header, computeChecksum( data ), 8 );
+
+    // Write to temporary file first, which replaces the checkpoint file once it is complete. The
+    // temporary file is flushed to disk before it is renamed, so that a crash cannot leave an
+    // empty or partial checkpoint file in place.
+    const std::string temporaryFilename = filename + ".tmp";
+    std::FILE* file = std::fopen( temporaryFilename.c_str( ), "wb" );
+    bool isWritten = file != 0
+                     && std::fwrite( header.data( ), 1, header.size( ), file ) == header.size( )
+                     && std::fwrite( data.data( ), 1, data.size( ), file ) == data.size( )
+                     && std::fflush( file ) == 0
+                     && synchronizeFile( file );
+    if ( file != 0 && std::fclose( file ) != 0 )
+    {
+        isWritten = false;
+    }
+    if ( !isWritten )
+    {
+        throw std::runtime_error( "ERROR: Could not write checkpoint file \""
+                                  + temporaryFilename + "\"!" );
+    }
+
+    boost::system::error_code error;
+    boost::filesystem::rename( temporaryFilename, filename, error );
+    if ( error )
+    {
+        throw std::runtime_error( "ERROR: Could not replace checkpoint file \"" + filename
+                                  + "\"!" );
+    }
+}
+
+//! Read checkpoint file.
+Checkpoint readCheckpointFile( const std::string& filename )
+{
+    std::ifstream file( filename.c_str( ), std::ios::binary );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not open checkpoint file \"" + filename + "\"!" );
+    }
+
+    std::vector< char > header( checkpointFileHeaderSize );
+    file.read( header.data( ), header.size( ) );
+    const unsigned char* bytes = reinterpret_cast< const unsigned char* >( header.data( ) );
+    if ( !file || std::memcmp( bytes, checkpointFileMagic, 8 ) != 0 )
+    {
+        throw std::runtime_error( "ERROR: \"" + filename + "\" is not a checkpoint file!" );
+    }
+
+    if ( readLittleEndian( bytes + 8, 4 ) != checkpointFileVersion )
+    {
+        throw std::runtime_error( "ERROR: Version of checkpoint file \"" + filename
+                                  + "\" is not supported!" );
+    }
+
+    const boost::uint64_t dataSize = readLittleEndian( bytes + 16, 8 );
+    const boost::uint64_t checksum = readLittleEndian( bytes + 24, 8 );
+    std::vector< char > data( ( std::istreambuf_iterator< char >( file ) ),
+                              std::istreambuf_iterator< char >( ) );
+    if ( data.size( ) != dataSize || computeChecksum( data ) != checksum )
+    {
+        throw std::runtime_error( "ERROR: Checkpoint file \"" + filename + "\" is corrupt!" );
+    }
+
+    return Checkpoint( data );
+}
+
+//! Construct asynchronous checkpoint writer.
+AsyncCheckpointWriter::AsyncCheckpointWriter( const std::string& aFilename )
+    : filename( aFilename ),
+      isPending( false ),
+      isWriting( false ),
+      isStopping( false ),
+      numberOfCheckpointsWritten( 0 )
+{
+    worker = std::thread( &AsyncCheckpointWriter::run, this );
+}
+
+//! Destruct asynchronous checkpoint writer.
+AsyncCheckpointWriter::~AsyncCheckpointWriter( )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        isStopping = true;
+    }
+    checkpointSubmitted.notify_one( );
+    worker.join( );
+}
+
+//! Submit checkpoint.
+void AsyncCheckpointWriter::submit( Checkpoint& checkpoint )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        checkpoint.swap( pendingData );
+        isPending = true;
+    }
+    checkpointSubmitted.notify_one( );
+
+    // The checkpoint now holds the data of a dropped checkpoint, if any, which is discarded.
+    std::vector< char > droppedData;
+    checkpoint.swap( droppedData );
+}
+
+//! Wait for checkpoint to be written.
+void AsyncCheckpointWriter::wait( )
+{
+    std::exception_ptr caughtError;
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        checkpointWritten.wait( lock, [ this ]( ) { return !isPending && !isWriting; } );
+        caughtError = error;
+        error = std::exception_ptr( );
+    }
+
+    if ( caughtError )
+    {
+        std::rethrow_exception( caughtError );
+    }
+}
+
+//! Get number of checkpoints written.
+std::size_t AsyncCheckpointWriter::getNumberOfCheckpointsWritten( ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    return numberOfCheckpointsWritten;
+}
+
+//! Run background thread.
+void AsyncCheckpointWriter::run( )
+{
+    Checkpoint checkpoint;
+    while ( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mutex );
+            checkpointSubmitted.wait( lock, [ this ]( ) { return isStopping || isPending; } );
+            if ( !isPending )
+            {
+                return;
+            }
+
+            std::vector< char > data;
+            data.swap( pendingData );
+            checkpoint.swap( data );
+            isPending = false;
+            isWriting = true;
+        }
+
+        try
+        {
+            writeCheckpointFile( filename, checkpoint );
+            std::lock_guard< std::mutex > lock( mutex );
+            numberOfCheckpointsWritten++;
+        }
+        catch ( ... )
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            if ( !error )
+            {
+                error = std::current_exception( );
+            }
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            isWriting = false;
+        }
+        checkpointWritten.notify_all( );
+    }
+}
+
+} // namespace scarab
@@ -0,0 +1,582 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+/*
+ * The computation of the shortest digits is ported from the reference implementation of Ryu
+ * (Copyright 2018 Ulf Adams, https://github.com/ulfjack/ryu), used under the Boost Software
+ * License, Version 1.0 (see http://www.boost.org/LICENSE_1_0.txt). The small-table variant is
+ * used, which computes the required powers of 5 from a few tabulated values.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+
+#include "Scarab/doubleFormatting.hpp"
+
+namespace scarab
+{
+
+using boost::int32_t;
+using boost::uint32_t;
+using boost::uint64_t;
+
+//! Smallest decimal exponent of leading digit written in fixed notation.
+static const int32_t minimumFixedExponent = -4;
+
+//! Smallest decimal exponent of leading digit written in scientific notation, if positive.
+static const int32_t maximumFixedExponent = 17;
+
+//! Write decimal digits and exponent to buffer.
+/*!
+ * Writes number given by significant decimal digits and decimal exponent of leading digit to
+ * buffer, in fixed or scientific notation.
+ */
+static std::size_t writeDecimal( const bool isNegative,
+                                 const char* digits,
+                                 const int32_t numberOfDigits,
+                                 const int32_t exponent,
+                                 char* buffer )
+{
+    char* position = buffer;
+    if ( isNegative )
+    {
+        *position++ = '-';
+    }
+
+    if ( exponent < minimumFixedExponent || exponent >= maximumFixedExponent )
+    {
+        // Scientific notation, e.g., 1.2345e-07.
+        *position++ = digits[ 0 ];
+        if ( numberOfDigits > 1 )
+        {
+            *position++ = '.';
+            std::memcpy( position, digits + 1, numberOfDigits - 1 );
+            position += numberOfDigits - 1;
+        }
+        *position++ = 'e';
+        *position++ = exponent < 0 ? '-' : '+';
+        const int32_t absoluteExponent = exponent < 0 ? -exponent : exponent;
+        if ( absoluteExponent >= 100 )
+        {
+            *position++ = static_cast< char >( '0' + absoluteExponent / 100 );
+        }
+        *position++ = static_cast< char >( '0' + ( absoluteExponent / 10 ) % 10 );
+        *position++ = static_cast< char >( '0' + absoluteExponent % 10 );
+    }
+    else if ( exponent < 0 )
+    {
+        // Fixed notation with leading zeros, e.g., 0.00123.
+        *position++ = '0';
+        *position++ = '.';
+        for ( int32_t i = -1; i > exponent; i-- )
+        {
+            *position++ = '0';
+        }
+        std::memcpy( position, digits, numberOfDigits );
+        position += numberOfDigits;
+    }
+    else if ( numberOfDigits <= exponent + 1 )
+    {
+        // Integer, e.g., 7000.
+        std::memcpy( position, digits, numberOfDigits );
+        position += numberOfDigits;
+        for ( int32_t i = numberOfDigits; i <= exponent; i++ )
+        {
+            *position++ = '0';
+        }
+    }
+    else
+    {
+        // Fixed notation, e.g., 6999.59.
+        std::memcpy( position, digits, exponent + 1 );
+        position += exponent + 1;
+        *position++ = '.';
+        std::memcpy( position, digits + exponent + 1, numberOfDigits - exponent - 1 );
+        position += numberOfDigits - exponent - 1;
+    }
+
+    return static_cast< std::size_t >( position - buffer );
+}
+
+#ifdef __SIZEOF_INT128__
+
+//! Unsigned 128-bit integer.
+__extension__ typedef unsigned __int128 uint128;
+
+//! Number of mantissa bits of double.
+static const uint32_t doubleMantissaBits = 52;
+
+//! Exponent bias of double.
+static const int32_t doubleBias = 1023;
+
+//! Number of bits of tabulated inverse powers of 5.
+static const int32_t doublePow5InverseBitCount = 125;
+
+//! Number of bits of tabulated powers of 5.
+static const int32_t doublePow5BitCount = 125;
+
+//! Inverse powers 5^-(26 i), as (low, high) 64-bit words.
+static const uint64_t doublePow5InverseSplit2[ 15 ][ 2 ] =
+{
+    { 1u, 2305843009213693952u },
+    { 5955668970331000884u, 1784059615882449851u },
+    { 8982663654677661702u, 1380349269358112757u },
+    { 7286864317269821294u, 2135987035920910082u },
+    { 7005857020398200553u, 1652639921975621497u },
+    { 17965325103354776697u, 1278668206209430417u },
+    { 8928596168509315048u, 1978643211784836272u },
+    { 10075671573058298858u, 1530901034580419511u },
+    { 597001226353042382u, 1184477304306571148u },
+    { 1527430471115325346u, 1832889850782397517u },
+    { 12533209867169019542u, 1418129833677084982u },
+    { 5577825024675947042u, 2194449627517475473u },
+    { 11006974540203867551u, 1697873161311732311u },
+    { 10313493231639821582u, 1313665730009899186u },
+    { 12701016819766672773u, 2032799256770390445u }
+};
+
+//! Corrections of computed inverse powers of 5, 2 bits per power.
+static const uint32_t pow5InverseOffsets[ 19 ] =
+{
+    0x54544554u, 0x04055545u, 0x10041000u, 0x00400414u, 0x40010000u, 0x41155555u, 0x00000454u,
+    0x00010044u, 0x40000000u, 0x44000041u, 0x50454450u, 0x55550054u, 0x51655554u, 0x40004000u,
+    0x01000001u, 0x00010500u, 0x51515411u, 0x05555554u, 0x00000000u
+};
+
+//! Powers 5^(26 i), as (low, high) 64-bit words.
+static const uint64_t doublePow5Split2[ 13 ][ 2 ] =
+{
+    { 0u, 1152921504606846976u },
+    { 0u, 1490116119384765625u },
+    { 1032610780636961552u, 1925929944387235853u },
+    { 7910200175544436838u, 1244603055572228341u },
+    { 16941905809032713930u, 1608611746708759036u },
+    { 13024893955298202172u, 2079081953128979843u },
+    { 6607496772837067824u, 1343575221513417750u },
+    { 17332926989895652603u, 1736530273035216783u },
+    { 13037379183483547984u, 2244412773384604712u },
+    { 1605989338741628675u, 1450417759929778918u },
+    { 9630225068416591280u, 1874621017369538693u },
+    { 665883850346957067u, 1211445438634777304u },
+    { 14931890668723713708u, 1565756531257009982u }
+};
+
+//! Corrections of computed powers of 5, 2 bits per power.
+static const uint32_t pow5Offsets[ 21 ] =
+{
+    0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x40000000u, 0x59695995u, 0x55545555u,
+    0x56555515u, 0x41150504u, 0x40555410u, 0x44555145u, 0x44504540u, 0x45555550u, 0x40004000u,
+    0x96440440u, 0x55565565u, 0x54454045u, 0x40154151u, 0x55559155u, 0x51405555u, 0x00000105u
+};
+
+//! Powers 5^i, for i = 0, ..., 25.
+static const uint64_t doublePow5Table[ 26 ] =
+{
+    1u, 5u, 25u, 125u, 625u, 3125u, 15625u, 78125u, 390625u, 1953125u, 9765625u, 48828125u,
+    244140625u, 1220703125u, 6103515625u, 30517578125u, 152587890625u, 762939453125u,
+    3814697265625u, 19073486328125u, 95367431640625u, 476837158203125u, 2384185791015625u,
+    11920928955078125u, 59604644775390625u, 298023223876953125u
+};
+
+//! Compute ceil(log2(5^e)) for e > 0, and 1 for e = 0.
+static inline int32_t pow5Bits( const int32_t e )
+{
+    return static_cast< int32_t >( ( ( static_cast< uint32_t >( e ) * 1217359u ) >> 19 ) + 1 );
+}
+
+//! Compute floor(log10(2^e)).
+static inline uint32_t log10Pow2( const int32_t e )
+{
+    return ( static_cast< uint32_t >( e ) * 78913u ) >> 18;
+}
+
+//! Compute floor(log10(5^e)).
+static inline uint32_t log10Pow5( const int32_t e )
+{
+    return ( static_cast< uint32_t >( e ) * 732923u ) >> 20;
+}
+
+//! Compute 5^i, scaled to 125 bits.
+static inline void computePow5( const uint32_t i, uint64_t result[ 2 ] )
+{
+    const uint32_t base = i / 26;
+    const uint32_t base2 = base * 26;
+    const uint32_t offset = i - base2;
+    const uint64_t* multiplier = doublePow5Split2[ base ];
+    if ( offset == 0 )
+    {
+        result[ 0 ] = multiplier[ 0 ];
+        result[ 1 ] = multiplier[ 1 ];
+        return;
+    }
+
+    const uint64_t m = doublePow5Table[ offset ];
+    const uint128 b0 = static_cast< uint128 >( m ) * multiplier[ 0 ];
+    const uint128 b2 = static_cast< uint128 >( m ) * multiplier[ 1 ];
+    const uint32_t delta = static_cast< uint32_t >( pow5Bits( i ) - pow5Bits( base2 ) );
+    const uint128 shiftedSum = ( b0 >> delta ) + ( b2 << ( 64 - delta ) )
+                               + ( ( pow5Offsets[ i / 16 ] >> ( ( i % 16 ) << 1 ) ) & 3 );
+    result[ 0 ] = static_cast< uint64_t >( shiftedSum );
+    result[ 1 ] = static_cast< uint64_t >( shiftedSum >> 64 );
+}
+
+//! Compute 5^-i, scaled to 125 bits.
+static inline void computeInversePow5( const uint32_t i, uint64_t result[ 2 ] )
+{
+    const uint32_t base = ( i + 26 - 1 ) / 26;
+    const uint32_t base2 = base * 26;
+    const uint32_t offset = base2 - i;
+    const uint64_t* multiplier = doublePow5InverseSplit2[ base ];
+    if ( offset == 0 )
+    {
+        result[ 0 ] = multiplier[ 0 ];
+        result[ 1 ] = multiplier[ 1 ];
+        return;
+    }
+
+    const uint64_t m = doublePow5Table[ offset ];
+    const uint128 b0 = static_cast< uint128 >( m ) * ( multiplier[ 0 ] - 1 );
+    const uint128 b2 = static_cast< uint128 >( m ) * multiplier[ 1 ];
+    const uint32_t delta = static_cast< uint32_t >( pow5Bits( base2 ) - pow5Bits( i ) );
+    const uint128 shiftedSum = ( ( b0 >> delta ) + ( b2 << ( 64 - delta ) ) ) + 1
+                               + ( ( pow5InverseOffsets[ i / 16 ] >> ( ( i % 16 ) << 1 ) ) & 3 );
+    result[ 0 ] = static_cast< uint64_t >( shiftedSum );
+    result[ 1 ] = static_cast< uint64_t >( shiftedSum >> 64 );
+}
+
+//! Compute number of factors 5 in value.
+static inline uint32_t pow5Factor( uint64_t value )
+{
+    const uint64_t inverse5 = 14757395258967641293u;
+    const uint64_t maximumMultipleOf5 = 3689348814741910323u;
+    uint32_t count = 0;
+    while ( true )
+    {
+        value *= inverse5;
+        if ( value > maximumMultipleOf5 )
+        {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+//! Check if value is divisible by 5^p.
+static inline bool isMultipleOfPowerOf5( const uint64_t value, const uint32_t p )
+{
+    return pow5Factor( value ) >= p;
+}
+
+//! Check if value is divisible by 2^p.
+static inline bool isMultipleOfPowerOf2( const uint64_t value, const uint32_t p )
+{
+    return ( value & ( ( static_cast< uint64_t >( 1 ) << p ) - 1 ) ) == 0;
+}
+
+//! Compute ( m * multiplier ) >> j, for j >= 64.
+static inline uint64_t multiplyShift64( const uint64_t m,
+                                        const uint64_t multiplier[ 2 ],
+                                        const uint32_t j )
+{
+    const uint128 b0 = static_cast< uint128 >( m ) * multiplier[ 0 ];
+    const uint128 b2 = static_cast< uint128 >( m ) * multiplier[ 1 ];
+    return static_cast< uint64_t >( ( ( b0 >> 64 ) + b2 ) >> ( j - 64 ) );
+}
+
+//! Compute number of decimal digits of value with at most 17 digits.
+static inline int32_t decimalLength17( const uint64_t value )
+{
+    int32_t length = 1;
+    uint64_t power = 10;
+    while ( length < 17 && value >= power )
+    {
+        length++;
+        power *= 10;
+    }
+    return length;
+}
+
+//! Compute shortest decimal representation of finite, non-zero double.
+/*!
+ * Computes shortest decimal significand and exponent, such that significand * 10^exponent parses
+ * back to the double given by its IEEE mantissa and exponent bits.
+ */
+static void computeShortestDecimal( const uint64_t ieeeMantissa,
+                                    const uint32_t ieeeExponent,
+                                    uint64_t& significand,
+                                    int32_t& exponent )
+{
+    // Step 1: Decode the floating-point number; subtract 2 so that the bounds computation has
+    // 2 additional bits.
+    int32_t e2;
+    uint64_t m2;
+    if ( ieeeExponent == 0 )
+    {
+        e2 = 1 - doubleBias - static_cast< int32_t >( doubleMantissaBits ) - 2;
+        m2 = ieeeMantissa;
+    }
+    else
+    {
+        e2 = static_cast< int32_t >( ieeeExponent ) - doubleBias
+             - static_cast< int32_t >( doubleMantissaBits ) - 2;
+        m2 = ( static_cast< uint64_t >( 1 ) << doubleMantissaBits ) | ieeeMantissa;
+    }
+    const bool acceptBounds = ( m2 & 1 ) == 0;
+
+    // Step 2: Determine the interval of valid decimal representations.
+    const uint64_t mv = 4 * m2;
+    const uint32_t mmShift = ( ieeeMantissa != 0 || ieeeExponent <= 1 ) ? 1 : 0;
+
+    // Step 3: Convert to a decimal power base using 128-bit arithmetic.
+    uint64_t vr;
+    uint64_t vp;
+    uint64_t vm;
+    int32_t e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    uint64_t multiplier[ 2 ];
+    if ( e2 >= 0 )
+    {
+        const uint32_t q = log10Pow2( e2 ) - ( e2 > 3 ? 1 : 0 );
+        e10 = static_cast< int32_t >( q );
+        const int32_t k = doublePow5InverseBitCount + pow5Bits( static_cast< int32_t >( q ) ) - 1;
+        const int32_t i = -e2 + static_cast< int32_t >( q ) + k;
+        computeInversePow5( q, multiplier );
+        vr = multiplyShift64( 4 * m2, multiplier, i );
+        vp = multiplyShift64( 4 * m2 + 2, multiplier, i );
+        vm = multiplyShift64( 4 * m2 - 1 - mmShift, multiplier, i );
+        if ( q <= 21 )
+        {
+            // Only one of mp, mv, and mm can be a multiple of 5, if any.
+            if ( mv % 5 == 0 )
+            {
+                vrIsTrailingZeros = isMultipleOfPowerOf5( mv, q );
+            }
+            else if ( acceptBounds )
+            {
+                vmIsTrailingZeros = isMultipleOfPowerOf5( mv - 1 - mmShift, q );
+            }
+            else
+            {
+                vp -= isMultipleOfPowerOf5( mv + 2, q ) ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        const uint32_t q = log10Pow5( -e2 ) - ( -e2 > 1 ? 1 : 0 );
+        e10 = static_cast< int32_t >( q ) + e2;
+        const int32_t i = -e2 - static_cast< int32_t >( q );
+        const int32_t k = pow5Bits( i ) - doublePow5BitCount;
+        const int32_t j = static_cast< int32_t >( q ) - k;
+        computePow5( static_cast< uint32_t >( i ), multiplier );
+        vr = multiplyShift64( 4 * m2, multiplier, j );
+        vp = multiplyShift64( 4 * m2 + 2, multiplier, j );
+        vm = multiplyShift64( 4 * m2 - 1 - mmShift, multiplier, j );
+        if ( q <= 1 )
+        {
+            // mv = 4 * m2, so it always has at least two trailing 0 bits.
+            vrIsTrailingZeros = true;
+            if ( acceptBounds )
+            {
+                // mm = mv - 1 - mmShift, so it has 1 trailing 0 bit iff mmShift == 1.
+                vmIsTrailingZeros = mmShift == 1;
+            }
+            else
+            {
+                // mp = mv + 2, so it always has at least one trailing 0 bit.
+                vp--;
+            }
+        }
+        else if ( q < 63 )
+        {
+            vrIsTrailingZeros = isMultipleOfPowerOf2( mv, q );
+        }
+    }
+
+    // Step 4: Find the shortest decimal representation in the interval of valid representations.
+    int32_t removed = 0;
+    uint64_t output;
+    if ( vmIsTrailingZeros || vrIsTrailingZeros )
+    {
+        // General case, which happens rarely (~0.7%).
+        uint32_t lastRemovedDigit = 0;
+        while ( vp / 10 > vm / 10 )
+        {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = static_cast< uint32_t >( vr % 10 );
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if ( vmIsTrailingZeros )
+        {
+            while ( vm % 10 == 0 )
+            {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = static_cast< uint32_t >( vr % 10 );
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if ( vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0 )
+        {
+            // Round even if the exact number is .....50..0.
+            lastRemovedDigit = 4;
+        }
+        // Take vr + 1 if vr is outside bounds or rounding up is needed.
+        output = vr + ( ( ( vr == vm && ( !acceptBounds || !vmIsTrailingZeros ) )
+                          || lastRemovedDigit >= 5 ) ? 1 : 0 );
+    }
+    else
+    {
+        // Specialized for the common case (~99.3%).
+        bool isRoundUp = false;
+        if ( vp / 100 > vm / 100 )
+        {
+            // Remove two digits at a time.
+            isRoundUp = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while ( vp / 10 > vm / 10 )
+        {
+            isRoundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        // Take vr + 1 if vr is outside bounds or rounding up is needed.
+        output = vr + ( ( vr == vm || isRoundUp ) ? 1 : 0 );
+    }
+
+    significand = output;
+    exponent = e10 + removed;
+}
+
+//! Compute shortest digits of finite, positive double.
+/*!
+ * Computes shortest significant decimal digits and decimal exponent of leading digit, such that
+ * the decimal number parses back to the given double.
+ */
+static void computeShortestDigits( const double value,
+                                   char digits[ 17 ],
+                                   int32_t& numberOfDigits,
+                                   int32_t& exponent )
+{
+    uint64_t bits;
+    std::memcpy( &bits, &value, sizeof( value ) );
+    const uint64_t ieeeMantissa = bits & ( ( static_cast< uint64_t >( 1 ) << 52 ) - 1 );
+    const uint32_t ieeeExponent = static_cast< uint32_t >( ( bits >> 52 ) & 0x7ff );
+
+    uint64_t significand;
+    int32_t significandExponent;
+    computeShortestDecimal( ieeeMantissa, ieeeExponent, significand, significandExponent );
+
+    // Write digits of significand, most significant first.
+    numberOfDigits = decimalLength17( significand );
+    for ( int32_t i = numberOfDigits - 1; i >= 0; i-- )
+    {
+        digits[ i ] = static_cast< char >( '0' + significand % 10 );
+        significand /= 10;
+    }
+    exponent = significandExponent + numberOfDigits - 1;
+}
+
+#else
+
+//! Compute shortest digits of finite, positive double.
+/*!
+ * Computes shortest significant decimal digits and decimal exponent of leading digit, such that
+ * the decimal number parses back to the given double.
+ */
+static void computeShortestDigits( const double value,
+                                   char digits[ 17 ],
+                                   int32_t& numberOfDigits,
+                                   int32_t& exponent )
+{
+    // Find shortest precision for which the value parses back to the same double. Doubles need at
+    // most 17 significant digits.
+    char text[ 32 ];
+    for ( int precision = 15; precision <= 17; precision++ )
+    {
+        std::snprintf( text, sizeof( text ), "%.*e", precision - 1, value );
+        if ( std::strtod( text, 0 ) == value )
+        {
+            break;
+        }
+    }
+
+    // Split scientific notation in digits and exponent, and remove trailing zeros.
+    const char* exponentText = std::strchr( text, 'e' );
+    numberOfDigits = 0;
+    for ( const char* character = text; character < exponentText; character++ )
+    {
+        if ( *character != '.' )
+        {
+            digits[ numberOfDigits++ ] = *character;
+        }
+    }
+    while ( numberOfDigits > 1 && digits[ numberOfDigits - 1 ] == '0' )
+    {
+        numberOfDigits--;
+    }
+    exponent = static_cast< int32_t >( std::atoi( exponentText + 1 ) );
+}
+
+#endif // __SIZEOF_INT128__
+
+//! Format double with shortest round-trip representation.
+std::size_t formatShortestDouble( const double value, char* buffer )
+{
+    if ( value != value )
+    {
+        std::memcpy( buffer, "nan", 3 );
+        return 3;
+    }
+
+    const bool isNegative = std::signbit( value );
+    if ( std::isinf( value ) )
+    {
+        std::memcpy( buffer, isNegative ? "-inf" : "inf", isNegative ? 4 : 3 );
+        return isNegative ? 4 : 3;
+    }
+    if ( value == 0.0 )
+    {
+        return writeDecimal( isNegative, "0", 1, 0, buffer );
+    }
+
+    char digits[ 17 ];
+    int32_t numberOfDigits;
+    int32_t exponent;
+    computeShortestDigits( isNegative ? -value : value, digits, numberOfDigits, exponent );
+
+    return writeDecimal( isNegative, digits, numberOfDigits, exponent, buffer );
+}
+
+//! Write double to stream with shortest round-trip representation.
+void writeShortestDouble( std::ostream& stream, const double value )
+{
+    char buffer[ maximumFormattedDoubleLength ];
+    stream.write( buffer, formatShortestDouble( value, buffer ) );
+}
+
+} // namespace scarab
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Scarab/dragModel.hpp"
+
+namespace scarab
+{
+
+//! Maximum width of altitude buckets [km].
+static const double maximumBucketWidth = 1.0;
+
+//! Get exponential atmosphere table.
+AtmosphereTable getExponentialAtmosphereTable( )
+{
+    // Base altitude [km], base density [kg m^-3] and scale height [km] (Vallado, 2013).
+    const double layers[ ][ 3 ] = { {    0.0, 1.225,     7.249  },
+                                    {   25.0, 3.899e-2,  6.349  },
+                                    {   30.0, 1.774e-2,  6.682  },
+                                    {   40.0, 3.972e-3,  7.554  },
+                                    {   50.0, 1.057e-3,  8.382  },
+                                    {   60.0, 3.206e-4,  7.714  },
+                                    {   70.0, 8.770e-5,  6.549  },
+                                    {   80.0, 1.905e-5,  5.799  },
+                                    {   90.0, 3.396e-6,  5.382  },
+                                    {  100.0, 5.297e-7,  5.877  },
+                                    {  110.0, 9.661e-8,  7.263  },
+                                    {  120.0, 2.438e-8,  9.473  },
+                                    {  130.0, 8.484e-9,  12.636 },
+                                    {  140.0, 3.845e-9,  16.149 },
+                                    {  150.0, 2.070e-9,  22.523 },
+                                    {  180.0, 5.464e-10, 29.740 },
+                                    {  200.0, 2.789e-10, 37.105 },
+                                    {  250.0, 7.248e-11, 45.546 },
+                                    {  300.0, 2.418e-11, 53.628 },
+                                    {  350.0, 9.518e-12, 53.298 },
+                                    {  400.0, 3.725e-12, 58.515 },
+                                    {  450.0, 1.585e-12, 60.828 },
+                                    {  500.0, 6.967e-13, 63.822 },
+                                    {  600.0, 1.454e-13, 71.835 },
+                                    {  700.0, 3.614e-14, 88.667 },
+                                    {  800.0, 1.170e-14, 124.64 },
+                                    {  900.0, 5.245e-15, 181.05 },
+                                    { 1000.0, 3.019e-15, 268.00 } };
+
+    AtmosphereTable atmosphereTable;
+    for ( unsigned int i = 0; i < sizeof( layers ) / sizeof( layers[ 0 ] ); i++ )
+    {
+        atmosphereTable.push_back( AtmosphereLayer( layers[ i ][ 0 ],
+                                                    layers[ i ][ 1 ],
+                                                    layers[ i ][ 2 ] ) );
+    }
+    return atmosphereTable;
+}
+
+//! Read atmosphere table.
+AtmosphereTable readAtmosphereTable( const std::string& filename )
+{
+    std::ifstream file( filename.c_str( ) );
+    if ( !file.is_open( ) )
+    {
+        throw std::runtime_error( "ERROR: Could not open density file \"" + filename + "\"!" );
+    }
+
+    std::vector< double > altitudes;
+    std::vector< double > densities;
+    std::string line;
+    while ( std::getline( file, line ) )
+    {
+        if ( line.empty( ) || line[ 0 ] == '#' )
+        {
+            continue;
+        }
+        std::replace( line.begin( ), line.end( ), ',', ' ' );
+
+        std::istringstream lineStream( line );
+        double altitude = 0.0;
+        double density = 0.0;
+        if ( !( lineStream >> altitude ) )
+        {
+            continue;
+        }
+        if ( !( lineStream >> density ) )
+        {
+            throw std::runtime_error( "ERROR: Invalid line in density file \"" + filename
+                                      + "\": " + line );
+        }
+        if ( !altitudes.empty( ) && !( altitude > altitudes.back( ) ) )
+        {
+            throw std::runtime_error( "ERROR: Altitudes in density file \"" + filename
+                                      + "\" must increase!" );
+        }
+        if ( !( density > 0.0 ) || ( !densities.empty( ) && !( density < densities.back( ) ) ) )
+        {
+            throw std::runtime_error( "ERROR: Densities in density file \"" + filename
+                                      + "\" must be positive and decrease!" );
+        }
+        altitudes.push_back( altitude );
+        densities.push_back( density );
+    }
+
+    if ( altitudes.size( ) < 2 )
+    {
+        throw std::runtime_error( "ERROR: Density file \"" + filename
+                                  + "\" must contain at least two altitudes!" );
+    }
+
+    AtmosphereTable atmosphereTable;
+    for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+    {
+        const unsigned int j = std::min( i, static_cast< unsigned int >( altitudes.size( ) - 2 ) );
+        const double scaleHeight = ( altitudes[ j + 1 ] - altitudes[ j ] )
+                                   / std::log( densities[ j ] / densities[ j + 1 ] );
+        atmosphereTable.push_back( AtmosphereLayer( altitudes[ i ], densities[ i ], scaleHeight ) );
+    }
+    return atmosphereTable;
+}
+
+//! Compute density of piecewise exponential atmosphere.
+double computeAtmosphereDensity( const AtmosphereTable& atmosphereTable, const double altitude )
+{
+    // Find last layer with base altitude below given altitude, or the lowest layer.
+    std::size_t lower = 0;
+    std::size_t upper = atmosphereTable.size( );
+    while ( upper - lower > 1 )
+    {
+        const std::size_t middle = ( lower + upper ) / 2;
+        if ( atmosphereTable[ middle ].baseAltitude <= altitude )
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+
+    const AtmosphereLayer& layer = atmosphereTable[ lower ];
+    return layer.baseDensity * std::exp( -( altitude - layer.baseAltitude ) / layer.scaleHeight );
+}
+
+//! Construct model.
+DragModel::DragModel( const double             aDragCoefficient,
+                      const double             aDragArea,
+                      const double             aMass,
+                      const AtmosphereTable&   anAtmosphereTable,
+                      const double             aCentralBodyRadius,
+                      const double             aRotationRate )
+    : accelerationFactor( 0.5 * aDragCoefficient * aDragArea / aMass * 1000.0 ),
+      atmosphereTable( anAtmosphereTable ),
+      centralBodyRadius( aCentralBodyRadius ),
+      rotationRate( aRotationRate ),
+      bucketWidth( maximumBucketWidth ),
+      minimumAltitude( 0.0 ),
+      altitudeRange( 0.0 )
+{
+    if ( !( aMass > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Mass subject to drag must be positive!" );
+    }
+    if ( atmosphereTable.empty( ) )
+    {
+        throw std::runtime_error( "ERROR: Atmosphere table must contain at least one layer!" );
+    }
+    for ( unsigned int i = 0; i < atmosphereTable.size( ); i++ )
+    {
+        if ( !( atmosphereTable[ i ].scaleHeight > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Scale heights of atmosphere must be positive!" );
+        }
+        if ( i > 0
+             && !( atmosphereTable[ i ].baseAltitude > atmosphereTable[ i - 1 ].baseAltitude ) )
+        {
+            throw std::runtime_error( "ERROR: Base altitudes of atmosphere must increase!" );
+        }
+    }
+
+    // The buckets cover the layers up to the base of the top layer; the buckets are no wider than
+    // the thinnest layer, so that every bucket contains at most one layer base.
+    minimumAltitude = atmosphereTable.front( ).baseAltitude;
+    altitudeRange = atmosphereTable.back( ).baseAltitude - minimumAltitude;
+    for ( unsigned int i = 1; i < atmosphereTable.size( ); i++ )
+    {
+        bucketWidth = std::min( bucketWidth, atmosphereTable[ i ].baseAltitude
+                                             - atmosphereTable[ i - 1 ].baseAltitude );
+    }
+    if ( !( altitudeRange > 0.0 ) )
+    {
+        return;
+    }
+
+    buckets.resize( static_cast< std::size_t >( std::ceil( altitudeRange / bucketWidth ) ) );
+    std::size_t layerIndex = 0;
+    for ( std::size_t i = 0; i < buckets.size( ); i++ )
+    {
+        const double bottom = minimumAltitude + i * bucketWidth;
+        while ( layerIndex + 1 < atmosphereTable.size( )
+                && atmosphereTable[ layerIndex + 1 ].baseAltitude <= bottom )
+        {
+            layerIndex++;
+        }
+
+        DensityBucket& bucket = buckets[ i ];
+        computeCoefficients( atmosphereTable[ layerIndex ], bottom, bucket.lowerCoefficients );
+        bucket.splitHeight = bucketWidth;
+        std::copy( bucket.lowerCoefficients,
+                   bucket.lowerCoefficients + numberOfCoefficients,
+                   bucket.upperCoefficients );
+
+        if ( layerIndex + 1 < atmosphereTable.size( )
+             && atmosphereTable[ layerIndex + 1 ].baseAltitude < bottom + bucketWidth )
+        {
+            const AtmosphereLayer& nextLayer = atmosphereTable[ layerIndex + 1 ];
+            bucket.splitHeight = nextLayer.baseAltitude - bottom;
+            computeCoefficients( nextLayer, nextLayer.baseAltitude, bucket.upperCoefficients );
+        }
+    }
+}
+
+//! Compute Taylor coefficients of exponential profile of layer at given altitude.
+void DragModel::computeCoefficients( const AtmosphereLayer& layer,
+                                     const double altitude,
+                                     double coefficients[ numberOfCoefficients ] ) const
+{
+    // rho( h + dh ) = rho( h ) exp( -dh / H ), with coefficients rho( h ) ( -1 / H )^k / k!.
+    coefficients[ 0 ] = layer.baseDensity
+                        * std::exp( -( altitude - layer.baseAltitude ) / layer.scaleHeight );
+    for ( std::size_t k = 1; k < numberOfCoefficients; k++ )
+    {
+        coefficients[ k ] = -coefficients[ k - 1 ] / ( layer.scaleHeight * k );
+    }
+}
+
+} // namespace scarab
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/accelerationModelRegistry.hpp"
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/encke.hpp"
+#include "Scarab/logger.hpp"
+#include "Scarab/relativeMotion.hpp"
+#include "Scarab/simulator.hpp"
+#include "Scarab/tools.hpp"
+#include "Scarab/trajectoryFile.hpp"
+
+namespace scarab
+{
+
+//! Maximum number of Newton iterations to solve Kepler's equation.
+static const unsigned int maximumNumberOfKeplerIterations = 50;
+
+//! Compute Stumpff functions C( z ) and S( z ).
+static void computeStumpffFunctions( const double z, double& c, double& s )
+{
+    // Use series expansion close to zero, where the closed forms suffer from cancellation.
+    if ( std::fabs( z ) < 1.0e-2 )
+    {
+        c = 1.0 / 2.0 - z * ( 1.0 / 24.0 - z * ( 1.0 / 720.0 - z / 40320.0 ) );
+        s = 1.0 / 6.0 - z * ( 1.0 / 120.0 - z * ( 1.0 / 5040.0 - z / 362880.0 ) );
+    }
+    else if ( z > 0.0 )
+    {
+        const double sqrtZ = std::sqrt( z );
+        c = ( 1.0 - std::cos( sqrtZ ) ) / z;
+        s = ( sqrtZ - std::sin( sqrtZ ) ) / ( z * sqrtZ );
+    }
+    else
+    {
+        const double sqrtMinusZ = std::sqrt( -z );
+        c = ( std::cosh( sqrtMinusZ ) - 1.0 ) / ( -z );
+        s = ( std::sinh( sqrtMinusZ ) - sqrtMinusZ ) / ( -z * sqrtMinusZ );
+    }
+}
+
+//! Propagate Keplerian orbit.
+State propagateKeplerOrbit( const double gravitationalParameter,
+                            const State& initialState,
+                            const double elapsedTime )
+{
+    if ( elapsedTime == 0.0 )
+    {
+        return initialState;
+    }
+
+    const double sqrtMu = std::sqrt( gravitationalParameter );
+    const double r0 = std::sqrt( initialState[ 0 ] * initialState[ 0 ]
+                                 + initialState[ 1 ] * initialState[ 1 ]
+                                 + initialState[ 2 ] * initialState[ 2 ] );
+    const double v0Squared = initialState[ 3 ] * initialState[ 3 ]
+                             + initialState[ 4 ] * initialState[ 4 ]
+                             + initialState[ 5 ] * initialState[ 5 ];
+    const double r0DotV0 = initialState[ 0 ] * initialState[ 3 ]
+                           + initialState[ 1 ] * initialState[ 4 ]
+                           + initialState[ 2 ] * initialState[ 5 ];
+
+    // Reciprocal of semi-major axis; positive for elliptic orbits.
+    const double alpha = 2.0 / r0 - v0Squared / gravitationalParameter;
+
+    // Initial guess of universal anomaly (Vallado, 2013, Algorithm 8).
+    double chi = sqrtMu * elapsedTime / r0;
+    if ( alpha > 1.0e-12 )
+    {
+        chi = sqrtMu * elapsedTime * alpha;
+    }
+    else if ( alpha < -1.0e-12 )
+    {
+        const double sign = elapsedTime > 0.0 ? 1.0 : -1.0;
+        const double semiMajorAxis = 1.0 / alpha;
+        chi = sign * std::sqrt( -semiMajorAxis )
+              * std::log( ( -2.0 * gravitationalParameter * alpha * elapsedTime )
+                          / ( r0DotV0 + sign * std::sqrt( -gravitationalParameter * semiMajorAxis )
+                                        * ( 1.0 - r0 * alpha ) ) );
+    }
+
+    // Solve universal Kepler's equation for universal anomaly with Newton's method.
+    const double a = r0DotV0 / sqrtMu;
+    const double b = 1.0 - alpha * r0;
+    double c = 0.0;
+    double s = 0.0;
+    bool isConverged = false;
+    for ( unsigned int i = 0; i < maximumNumberOfKeplerIterations && !isConverged; i++ )
+    {
+        const double chiSquared = chi * chi;
+        computeStumpffFunctions( alpha * chiSquared, c, s );
+
+        const double function = a * chiSquared * c + b * chiSquared * chi * s + r0 * chi
+                                - sqrtMu * elapsedTime;
+        const double derivative = a * chi * ( 1.0 - alpha * chiSquared * s )
+                                  + b * chiSquared * c + r0;
+        const double correction = function / derivative;
+        chi -= correction;
+        isConverged = std::fabs( correction ) <= 1.0e-13 * std::max( 1.0, std::fabs( chi ) );
+    }
+    if ( !isConverged )
+    {
+        throw std::runtime_error( "ERROR: Kepler's equation did not converge!" );
+    }
+
+    // Compute Lagrange coefficients and propagated state.
+    const double chiSquared = chi * chi;
+    computeStumpffFunctions( alpha * chiSquared, c, s );
+    const double f = 1.0 - chiSquared / r0 * c;
+    const double g = elapsedTime - chiSquared * chi / sqrtMu * s;
+
+    State state;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        state[ i ] = f * initialState[ i ] + g * initialState[ i + 3 ];
+    }
+    const double r = std::sqrt( state[ 0 ] * state[ 0 ]
+                                + state[ 1 ] * state[ 1 ]
+                                + state[ 2 ] * state[ 2 ] );
+    const double fDot = sqrtMu / ( r * r0 ) * ( alpha * chiSquared * chi * s - chi );
+    const double gDot = 1.0 - chiSquared / r * c;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        state[ i + 3 ] = fDot * initialState[ i ] + gDot * initialState[ i + 3 ];
+    }
+
+    return state;
+}
+
+//! Compute Encke function.
+double computeEnckeFunction( const double q )
+{
+    const double onePlusQToThreeHalves = ( 1.0 + q ) * std::sqrt( 1.0 + q );
+    return q * ( 3.0 + q * ( 3.0 + q ) )
+           / ( onePlusQToThreeHalves * ( 1.0 + onePlusQToThreeHalves ) );
+}
+
+//! Construct target trajectory.
+TargetTrajectory::TargetTrajectory( const std::vector< double >& someEpochs,
+                                    const std::vector< State >& someStates,
+                                    const std::vector< State >& someStateDerivatives )
+    : epochs( someEpochs ),
+      states( someStates ),
+      stateDerivatives( someStateDerivatives )
+{
+    if ( epochs.size( ) < 2
+         || states.size( ) != epochs.size( )
+         || stateDerivatives.size( ) != epochs.size( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Target trajectory must contain states and state derivatives at two or more "
+            "epochs!" );
+    }
+}
+
+//! Get state.
+State TargetTrajectory::getState( const double time ) const
+{
+    // Find step containing time, clamped to first and last step.
+    const std::size_t index = std::min(
+        static_cast< std::size_t >(
+            std::max( std::upper_bound( epochs.begin( ), epochs.end( ), time ) - epochs.begin( ),
+                      static_cast< std::ptrdiff_t >( 1 ) ) ),
+        epochs.size( ) - 1 );
+
+    if ( time == epochs[ index ] )
+    {
+        return states[ index ];
+    }
+
+    return interpolateState( time,
+                             epochs[ index - 1 ],
+                             states[ index - 1 ],
+                             stateDerivatives[ index - 1 ],
+                             epochs[ index ],
+                             states[ index ],
+                             stateDerivatives[ index ] );
+}
+
+//! Generate list of acceleration models of target.
+ListOfAccelerationModels generateTargetAccelerationModelList(
+    const SimulatorSettings& settings, const ListOfAccelerationModels& chaserAccelerationModels )
+{
+    const TargetSettings& target = settings.targetSettings;
+    const RadiationPressureSettings& radiation = settings.radiationPressureSettings;
+    const DragSettings& drag = settings.dragSettings;
+
+    // Settings in which the target takes the place of the chaser.
+    const SimulatorSettings targetModelSettings(
+        settings.integratorSettings,
+        ChaserSettings( target.mass ),
+        target,
+        settings.centralGravitySettings,
+        RadiationPressureSettings( radiation.status,
+                                   radiation.radiationPressure,
+                                   radiation.radiationPressureCoefficient,
+                                   radiation.vectorToSource,
+                                   std::isnan( target.radiationPressureArea )
+                                       ? radiation.radiationPressureArea
+                                       : target.radiationPressureArea,
+                                   radiation.shadowModel,
+                                   radiation.centralBodyRadius,
+                                   radiation.sourceRadius,
+                                   radiation.sourceBodyName ),
+        settings.sphericalHarmonicsSettings,
+        DragSettings( drag.status,
+                      drag.dragCoefficient,
+                      std::isnan( target.dragArea ) ? drag.dragArea : target.dragArea,
+                      drag.densityFilename,
+                      drag.atmosphereTable,
+                      drag.centralBodyRadius,
+                      drag.rotationRate ),
+        settings.ephemerisSettings,
+        settings.thirdBodySettings,
+        settings.outputSettings,
+        settings.ensembleSettings,
+        settings.listOfModelNames,
+        settings.eventSettings,
+        settings.relativeMotionSettings,
+        settings.enckeSettings,
+        settings.checkpointSettings,
+        settings.sweepSettings );
+
+    // Models that depend on the spacecraft are created again for the target; all other models are
+    // shared with the chaser, so that, e.g., an interpolation grid is only built once.
+    const AccelerationModelId spacecraftModelIds[ ] = { radiationPressureModelId, dragModelId };
+    ListOfAccelerationModels targetAccelerationModels = chaserAccelerationModels;
+    DataStore data( target.initialState,
+                    settings.integratorSettings.startTime,
+                    settings.centralGravitySettings.gravitationalParameter,
+                    ListOfAccelerationModels( ) );
+    for ( unsigned int i = 0; i < 2; i++ )
+    {
+        const ListOfAccelerationModels::iterator it
+            = targetAccelerationModels.find( spacecraftModelIds[ i ] );
+        if ( it != targetAccelerationModels.end( ) )
+        {
+            it->second = findAccelerationModel( getAccelerationModelName( it->first ) ).factory(
+                targetModelSettings, data );
+        }
+    }
+
+    return targetAccelerationModels;
+}
+
+//! Propagate target trajectory.
+TargetTrajectory propagateTargetTrajectory( const SimulatorSettings& settings,
+                                            const StateDerivativeModel& stateDerivativeModel,
+                                            IntegrationStatistics& statistics )
+{
+    const IntegratorSettings& integratorSettings = settings.integratorSettings;
+    const IntegratorSettings targetIntegratorSettings( settings.targetSettings.initialState,
+                                                       integratorSettings.startTime,
+                                                       integratorSettings.endTime,
+                                                       integratorSettings.initialStep,
+                                                       integratorSettings.integrator,
+                                                       integratorSettings.absoluteTolerance,
+                                                       integratorSettings.relativeTolerance,
+                                                       integratorSettings.maximumStep );
+
+    // Store state after every step; the observer is also called with the initial state.
+    std::vector< double > epochs;
+    std::vector< State > states;
+    State state = targetIntegratorSettings.initialState;
+    statistics = integrateState( targetIntegratorSettings,
+                                 stateDerivativeModel,
+                                 state,
+                                 [ &epochs, &states ]( const State& stepState, const double time )
+                                 {
+                                     epochs.push_back( time );
+                                     states.push_back( stepState );
+                                 } );
+
+    std::vector< State > stateDerivatives( states.size( ) );
+    for ( unsigned int i = 0; i < states.size( ); i++ )
+    {
+        stateDerivativeModel( states[ i ], stateDerivatives[ i ], epochs[ i ] );
+    }
+    statistics.numberOfFunctionEvaluations += states.size( );
+
+    return TargetTrajectory( epochs, states, stateDerivatives );
+}
+
+//! Construct Encke state derivative model.
+EnckeStateDerivativeModel::EnckeStateDerivativeModel(
+    const double aGravitationalParameter,
+    const ListOfAccelerationModels& aListOfAccelerationModels,
+    const ListOfAccelerationModels& aListOfTargetAccelerationModels,
+    const TargetTrajectory& aTargetTrajectory )
+    : gravitationalParameter( aGravitationalParameter ),
+      targetTrajectory( aTargetTrajectory ),
+      isReferenceRectified( false ),
+      referenceEpoch( 0.0 )
+{
+    for ( ListOfAccelerationModels::const_iterator it = aListOfAccelerationModels.begin( );
+          it != aListOfAccelerationModels.end( );
+          it++ )
+    {
+        if ( it->first != centralGravityModelId )
+        {
+            perturbationModels.push_back( it->second );
+        }
+    }
+    for ( ListOfAccelerationModels::const_iterator it = aListOfTargetAccelerationModels.begin( );
+          it != aListOfTargetAccelerationModels.end( );
+          it++ )
+    {
+        if ( it->first != centralGravityModelId )
+        {
+            targetPerturbationModels.push_back( it->second );
+        }
+    }
+    referenceState.fill( 0.0 );
+}
+
+//! Compute deviation derivative.
+void EnckeStateDerivativeModel::operator( )( const State& deviation,
+                                             State& deviationDerivative,
+                                             const double time ) const
+{
+    const State reference = getReferenceState( time );
+
+    State chaserState;
+    for ( unsigned int i = 0; i < chaserState.size( ); i++ )
+    {
+        chaserState[ i ] = reference[ i ] + deviation[ i ];
+    }
+
+    // Difference of central gravitational accelerations of chaser and reference.
+    const double referenceRadiusSquared = reference[ 0 ] * reference[ 0 ]
+                                          + reference[ 1 ] * reference[ 1 ]
+                                          + reference[ 2 ] * reference[ 2 ];
+    const double q = ( deviation[ 0 ] * ( 2.0 * reference[ 0 ] + deviation[ 0 ] )
+                       + deviation[ 1 ] * ( 2.0 * reference[ 1 ] + deviation[ 1 ] )
+                       + deviation[ 2 ] * ( 2.0 * reference[ 2 ] + deviation[ 2 ] ) )
+                     / referenceRadiusSquared;
+    const double f = computeEnckeFunction( q );
+    const double factor = gravitationalParameter
+                          / ( referenceRadiusSquared * std::sqrt( referenceRadiusSquared ) );
+
+    Acceleration acceleration;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        acceleration[ i ] = factor * ( f * chaserState[ i ] - deviation[ i ] );
+    }
+
+    // Perturbing accelerations act on the chaser; if the reference is the target trajectory, the
+    // perturbing accelerations of the target act on the reference.
+    for ( unsigned int j = 0; j < perturbationModels.size( ); j++ )
+    {
+        const Acceleration chaserAcceleration = ( *perturbationModels[ j ] )( chaserState, time );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            acceleration[ i ] += chaserAcceleration[ i ];
+        }
+    }
+
+    if ( !isReferenceRectified )
+    {
+        for ( unsigned int j = 0; j < targetPerturbationModels.size( ); j++ )
+        {
+            const Acceleration referenceAcceleration
+                = ( *targetPerturbationModels[ j ] )( reference, time );
+            for ( unsigned int i = 0; i < 3; i++ )
+            {
+                acceleration[ i ] -= referenceAcceleration[ i ];
+            }
+        }
+    }
+
+    deviationDerivative[ 0 ] = deviation[ 3 ];
+    deviationDerivative[ 1 ] = deviation[ 4 ];
+    deviationDerivative[ 2 ] = deviation[ 5 ];
+    deviationDerivative[ 3 ] = acceleration[ 0 ];
+    deviationDerivative[ 4 ] = acceleration[ 1 ];
+    deviationDerivative[ 5 ] = acceleration[ 2 ];
+}
+
+//! Get reference state.
+State EnckeStateDerivativeModel::getReferenceState( const double time ) const
+{
+    if ( !isReferenceRectified )
+    {
+        return targetTrajectory.getState( time );
+    }
+
+    return propagateKeplerOrbit( gravitationalParameter, referenceState, time - referenceEpoch );
+}
+
+//! Rectify reference.
+void EnckeStateDerivativeModel::rectify( const double epoch, const State& osculatingState )
+{
+    isReferenceRectified = true;
+    referenceEpoch = epoch;
+    referenceState = osculatingState;
+}
+
+//! Propagate with Encke's method.
+EnckeStatistics propagateEncke( const SimulatorSettings& settings,
+                                StateHistorySink& stateHistorySink )
+{
+    const IntegratorSettings& integratorSettings = settings.integratorSettings;
+    const EnckeSettings& enckeSettings = settings.enckeSettings;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( integratorSettings.initialState,
+                    integratorSettings.startTime,
+                    settings.centralGravitySettings.gravitationalParameter,
+                    listOfAccelerationModels );
+    generateAccelerationModelList( settings, data );
+    if ( data.listOfAccelerationModels.find( centralGravityModelId )
+         == data.listOfAccelerationModels.end( ) )
+    {
+        throw std::runtime_error( "ERROR: Encke propagation requires central gravity model!" );
+    }
+
+    // The target is propagated with its own mass and areas.
+    DataStore targetData( settings.targetSettings.initialState,
+                          integratorSettings.startTime,
+                          settings.centralGravitySettings.gravitationalParameter,
+                          generateTargetAccelerationModelList( settings,
+                                                               data.listOfAccelerationModels ) );
+    const StateDerivativeModel targetStateDerivativeModel( targetData );
+
+    EnckeStatistics statistics;
+    const TargetTrajectory targetTrajectory = propagateTargetTrajectory(
+        settings, targetStateDerivativeModel, statistics.targetStatistics );
+    EnckeStateDerivativeModel enckeStateDerivativeModel(
+        settings.centralGravitySettings.gravitationalParameter,
+        data.listOfAccelerationModels,
+        targetData.listOfAccelerationModels,
+        targetTrajectory );
+
+    // Output epochs over the whole propagation; if none are set, the state is written after every
+    // step.
+    const bool isSampled = settings.outputSettings.stateHistoryInterval > 0.0
+                           || !settings.outputSettings.stateHistoryEpochs.empty( );
+    std::vector< double > epochs;
+    if ( isSampled )
+    {
+        epochs = getRelativeMotionEpochs( settings );
+    }
+
+    State deviation;
+    for ( unsigned int i = 0; i < deviation.size( ); i++ )
+    {
+        deviation[ i ] = integratorSettings.initialState[ i ]
+                         - settings.targetSettings.initialState[ i ];
+    }
+
+    // The step size suggested at the end of a segment is carried over to the next segment, so
+    // that the step size controller does not start again from the initial step; after a
+    // rectification, the deviation is reset, so the next segment starts from the initial step.
+    double segmentStartTime = integratorSettings.startTime;
+    double segmentInitialStep = integratorSettings.initialStep;
+    std::size_t epochIndex = 0;
+    bool isFirstSegment = true;
+    while ( isFirstSegment || segmentStartTime < integratorSettings.endTime )
+    {
+        double segmentEndTime = segmentStartTime + enckeSettings.rectificationInterval;
+        if ( segmentEndTime >= integratorSettings.endTime
+             || integratorSettings.endTime - segmentEndTime
+                < 1.0e-9 * enckeSettings.rectificationInterval )
+        {
+            segmentEndTime = integratorSettings.endTime;
+        }
+
+        // The state at the start of a segment was already written at the end of the previous one.
+        std::vector< double > segmentEpochs;
+        while ( epochIndex < epochs.size( ) && epochs[ epochIndex ] <= segmentEndTime )
+        {
+            if ( isFirstSegment || epochs[ epochIndex ] > segmentStartTime )
+            {
+                segmentEpochs.push_back( epochs[ epochIndex ] );
+            }
+            epochIndex++;
+        }
+
+        IntegratorObserver observer;
+        if ( !isSampled || !segmentEpochs.empty( ) )
+        {
+            const EnckeStateDerivativeModel& model = enckeStateDerivativeModel;
+            const bool isStartWritten = isFirstSegment;
+            observer = [ &model, &targetTrajectory, &stateHistorySink,
+                         segmentStartTime, isStartWritten ]( const State& stepDeviation,
+                                                             const double time )
+            {
+                if ( !isStartWritten && time == segmentStartTime )
+                {
+                    return;
+                }
+
+                if ( !model.isRectified( ) )
+                {
+                    stateHistorySink.write( time, stepDeviation );
+                    return;
+                }
+
+                const State reference = model.getReferenceState( time );
+                const State target = targetTrajectory.getState( time );
+                State relativeState;
+                for ( unsigned int i = 0; i < relativeState.size( ); i++ )
+                {
+                    relativeState[ i ] = ( reference[ i ] - target[ i ] ) + stepDeviation[ i ];
+                }
+                stateHistorySink.write( time, relativeState );
+            };
+        }
+
+        const IntegratorSettings segmentSettings( deviation,
+                                                  segmentStartTime,
+                                                  segmentEndTime,
+                                                  segmentInitialStep,
+                                                  integratorSettings.integrator,
+                                                  integratorSettings.absoluteTolerance,
+                                                  integratorSettings.relativeTolerance,
+                                                  integratorSettings.maximumStep );
+        const IntegrationStatistics segmentStatistics
+            = integrateState( segmentSettings,
+                              StateDerivativeFunction( std::cref( enckeStateDerivativeModel ) ),
+                              deviation,
+                              observer,
+                              0.0,
+                              segmentEpochs );
+        accumulateIntegrationStatistics( segmentStatistics, statistics.deviationStatistics );
+        statistics.deviationStatistics.finalTime = segmentStatistics.finalTime;
+        segmentInitialStep = segmentStatistics.nextStepSize > 0.0
+                             ? segmentStatistics.nextStepSize : integratorSettings.initialStep;
+
+        // Rectify reference if deviation has grown too large with respect to it.
+        const State reference = enckeStateDerivativeModel.getReferenceState( segmentEndTime );
+        const double deviationRadius = std::sqrt( deviation[ 0 ] * deviation[ 0 ]
+                                                  + deviation[ 1 ] * deviation[ 1 ]
+                                                  + deviation[ 2 ] * deviation[ 2 ] );
+        const double referenceRadius = std::sqrt( reference[ 0 ] * reference[ 0 ]
+                                                  + reference[ 1 ] * reference[ 1 ]
+                                                  + reference[ 2 ] * reference[ 2 ] );
+        if ( segmentEndTime < integratorSettings.endTime
+             && deviationRadius > enckeSettings.rectificationThreshold * referenceRadius )
+        {
+            State chaserState;
+            for ( unsigned int i = 0; i < chaserState.size( ); i++ )
+            {
+                chaserState[ i ] = reference[ i ] + deviation[ i ];
+            }
+            enckeStateDerivativeModel.rectify( segmentEndTime, chaserState );
+            deviation.fill( 0.0 );
+            segmentInitialStep = integratorSettings.initialStep;
+            statistics.numberOfRectifications++;
+        }
+
+        segmentStartTime = segmentEndTime;
+        isFirstSegment = false;
+    }
+
+    return statistics;
+}
+
+//! Execute Encke propagation.
+TrajectoryMetadata executeEncke( const SimulatorSettings& settings )
+{
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                        Encke propagation                         " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    const State& targetState = settings.targetSettings.initialState;
+    metadata.push_back( TrajectoryMetadataEntry( "target_initial_x",  targetState[ 0 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "target_initial_y",  targetState[ 1 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "target_initial_z",  targetState[ 2 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "target_initial_vx", targetState[ 3 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "target_initial_vy", targetState[ 4 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "target_initial_vz", targetState[ 5 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "rectification_threshold", settings.enckeSettings.rectificationThreshold, "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "rectification_interval", settings.enckeSettings.rectificationInterval, "s" ) );
+
+    // Propagate target and deviation of chaser, and stream relative states to file.
+    logInfo( ) << "Propagating target and deviation of chaser ..." << std::endl;
+    flushLog( );
+    EnckeStatistics statistics;
+    std::size_t numberOfSamples = 0;
+    if ( settings.outputSettings.stateHistoryFormat == binaryStateHistoryFormat )
+    {
+        BinaryStateHistoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize );
+        statistics = propagateEncke( settings, stateHistoryWriter );
+        addIntegrationStatistics( statistics.deviationStatistics, metadata );
+        metadata.push_back( TrajectoryMetadataEntry(
+            "number_of_rectifications",
+            static_cast< double >( statistics.numberOfRectifications ),
+            "-" ) );
+        stateHistoryWriter.close( metadata );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+    }
+    else if ( settings.outputSettings.stateHistoryFormat == chebyshevStateHistoryFormat )
+    {
+        const ChebyshevTrajectorySettings& chebyshevSettings
+            = settings.outputSettings.chebyshevTrajectorySettings;
+        ChebyshevTrajectoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            chebyshevSettings.positionTolerance,
+            chebyshevSettings.velocityTolerance,
+            chebyshevSettings.numberOfCoefficients,
+            settings.outputSettings.stateHistoryChunkSize );
+        statistics = propagateEncke( settings, stateHistoryWriter );
+        stateHistoryWriter.flush( );
+        addIntegrationStatistics( statistics.deviationStatistics, metadata );
+        metadata.push_back( TrajectoryMetadataEntry(
+            "number_of_rectifications",
+            static_cast< double >( statistics.numberOfRectifications ),
+            "-" ) );
+        addChebyshevTrajectoryStatistics( stateHistoryWriter, metadata );
+        stateHistoryWriter.close( metadata );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+    }
+    else
+    {
+        CsvStateHistoryFileWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize,
+            "t,x,y,z,vx,vy,vz",
+            false );
+        statistics = propagateEncke( settings, stateHistoryWriter );
+        stateHistoryWriter.flush( );
+        addIntegrationStatistics( statistics.deviationStatistics, metadata );
+        metadata.push_back( TrajectoryMetadataEntry(
+            "number_of_rectifications",
+            static_cast< double >( statistics.numberOfRectifications ),
+            "-" ) );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+    }
+    logInfo( ) << "Propagated target and deviation of chaser successfully!" << std::endl;
+    logInfo( ) << "State history (" << numberOfSamples << " samples) written to file successfully!"
+               << std::endl;
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "Number of target steps                    "
+               << statistics.targetStatistics.numberOfAcceptedSteps << std::endl;
+    logInfo( ) << "Number of function evaluations            "
+               << statistics.deviationStatistics.numberOfFunctionEvaluations << std::endl;
+    logInfo( ) << "Number of accepted steps                  "
+               << statistics.deviationStatistics.numberOfAcceptedSteps << std::endl;
+    logInfo( ) << "Number of rejected steps                  "
+               << statistics.deviationStatistics.numberOfRejectedSteps << std::endl;
+    logInfo( ) << "Number of rectifications                  "
+               << statistics.numberOfRectifications << std::endl;
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                              Output                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    // Write simulation metadata to file.
+    logDebug( ) << "Writing simulation metadata to file ..." << std::endl;
+    std::ofstream metadataFile( settings.outputSettings.metadataFilename.c_str( ) );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        print( metadataFile, metadata[ i ].name, metadata[ i ].value, metadata[ i ].units );
+    }
+    metadataFile.close( );
+    logInfo( ) << "Simulation metadata written to file successfully!" << std::endl;
+
+    return metadata;
+}
+
+} // namespace scarab
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/doubleFormatting.hpp"
+#include "Scarab/ensemble.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/logger.hpp"
+#include "Scarab/randomNumbers.hpp"
+#include "Scarab/simulator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/threadPool.hpp"
+#include "Scarab/tools.hpp"
+
+namespace scarab
+{
+
+//! Sample initial state of ensemble member.
+State sampleInitialState( const State&              nominalState,
+                          const EnsembleSettings&   settings,
+                          const unsigned int        memberIndex )
+{
+    std::seed_seq seedSequence = { settings.seed, memberIndex };
+    RandomNumberGenerator generator( seedSequence );
+
+    State initialState = nominalState;
+    for ( unsigned int i = 0; i < initialState.size( ); i++ )
+    {
+        initialState[ i ]
+            += settings.initialStateDispersion[ i ] * generateNormalRandomNumber( generator );
+    }
+
+    return initialState;
+}
+
+//! Propagate ensemble member.
+EnsembleMember propagateEnsembleMember( const SimulatorSettings& settings,
+                                        const unsigned int memberIndex )
+{
+    EnsembleMember member;
+    member.index = memberIndex;
+    member.initialState = sampleInitialState( settings.integratorSettings.initialState,
+                                              settings.ensembleSettings,
+                                              memberIndex );
+
+    // Every member owns its data store and models, so that no state is shared between threads.
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( member.initialState,
+                    settings.integratorSettings.startTime,
+                    settings.centralGravitySettings.gravitationalParameter,
+                    listOfAccelerationModels );
+    generateAccelerationModelList( settings, data );
+    StateDerivativeModel stateDerivativeModel( data );
+
+    // Every member has its own event detector, since it tracks the phase and event log of the
+    // member; a member that is terminated by an event stops there.
+    EventDetector eventDetector( settings.eventSettings );
+    EventDetector* const activeEventDetector
+        = settings.eventSettings.listOfEventDefinitions.empty( ) ? 0 : &eventDetector;
+
+    member.finalState = member.initialState;
+    member.statistics = integrateState( settings.integratorSettings,
+                                        stateDerivativeModel,
+                                        member.finalState,
+                                        IntegratorObserver( ),
+                                        0.0,
+                                        std::vector< double >( ),
+                                        activeEventDetector );
+    member.eventLog = eventDetector.getEventLog( );
+
+    return member;
+}
+
+//! Propagate ensemble.
+Ensemble propagateEnsemble( const SimulatorSettings& settings )
+{
+    Ensemble ensemble( settings.ensembleSettings.numberOfSamples );
+
+    ThreadPool threadPool( settings.ensembleSettings.numberOfThreads );
+    for ( unsigned int i = 0; i < ensemble.size( ); i++ )
+    {
+        threadPool.submit( [ &settings, &ensemble, i ]( )
+                           {
+                               ensemble[ i ] = propagateEnsembleMember( settings, i );
+                           } );
+    }
+    threadPool.wait( );
+
+    return ensemble;
+}
+
+//! Execute ensemble.
+TrajectoryMetadata executeEnsemble( const SimulatorSettings& settings )
+{
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                             Ensemble                             " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    logInfo( ) << "Propagating " << settings.ensembleSettings.numberOfSamples
+               << " ensemble members ..." << std::endl;
+    flushLog( );
+    const Ensemble ensemble = propagateEnsemble( settings );
+    logInfo( ) << "Propagated ensemble members successfully!" << std::endl;
+
+    // The final time of the ensemble is the latest final time of its members.
+    IntegrationStatistics statistics;
+    statistics.finalTime = settings.integratorSettings.startTime;
+    unsigned int numberOfTerminatedMembers = 0;
+    for ( unsigned int i = 0; i < ensemble.size( ); i++ )
+    {
+        if ( ensemble[ i ].statistics.finalTime < settings.integratorSettings.endTime )
+        {
+            numberOfTerminatedMembers++;
+        }
+
+        accumulateIntegrationStatistics( ensemble[ i ].statistics, statistics );
+        statistics.finalTime = std::max( statistics.finalTime, ensemble[ i ].statistics.finalTime );
+    }
+    logInfo( ) << std::endl;
+    logInfo( ) << "Number of function evaluations (total)    "
+               << statistics.numberOfFunctionEvaluations << std::endl;
+    logInfo( ) << "Number of accepted steps (total)          "
+               << statistics.numberOfAcceptedSteps << std::endl;
+    logInfo( ) << "Number of rejected steps (total)          "
+               << statistics.numberOfRejectedSteps << std::endl;
+    logInfo( ) << "Number of members terminated by events    " << numberOfTerminatedMembers
+               << std::endl;
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                              Output                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    // Write simulation metadata to file.
+    logDebug( ) << "Writing simulation metadata to file ..." << std::endl;
+    TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_samples", settings.ensembleSettings.numberOfSamples, "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "seed", settings.ensembleSettings.seed, "-" ) );
+    addIntegrationStatistics( statistics, metadata );
+    std::ofstream metadataFile( settings.outputSettings.metadataFilename.c_str( ) );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        print( metadataFile, metadata[ i ].name, metadata[ i ].value, metadata[ i ].units );
+    }
+    metadataFile.close( );
+    logInfo( ) << "Simulation metadata written to file successfully!" << std::endl;
+
+    // Write initial and final states of ensemble members to file.
+    logDebug( ) << "Writing ensemble to file ..." << std::endl;
+    std::ofstream ensembleFile( settings.ensembleSettings.ensembleFilename.c_str( ) );
+    ensembleFile << "member,x0,y0,z0,vx0,vy0,vz0,x,y,z,vx,vy,vz,t" << std::endl;
+    for ( unsigned int i = 0; i < ensemble.size( ); i++ )
+    {
+        ensembleFile << ensemble[ i ].index;
+        for ( unsigned int j = 0; j < ensemble[ i ].initialState.size( ); j++ )
+        {
+            ensembleFile << ",";
+            writeShortestDouble( ensembleFile, ensemble[ i ].initialState[ j ] );
+        }
+        for ( unsigned int j = 0; j < ensemble[ i ].finalState.size( ); j++ )
+        {
+            ensembleFile << ",";
+            writeShortestDouble( ensembleFile, ensemble[ i ].finalState[ j ] );
+        }
+        ensembleFile << ",";
+        writeShortestDouble( ensembleFile, ensemble[ i ].statistics.finalTime );
+        ensembleFile << "\n";
+    }
+    ensembleFile.close( );
+    logInfo( ) << "Ensemble written to file successfully!" << std::endl;
+
+    // Write event logs of all ensemble members to file.
+    if ( !settings.eventSettings.listOfEventDefinitions.empty( )
+         && !settings.eventSettings.eventFilename.empty( ) )
+    {
+        logDebug( ) << "Writing event log to file ..." << std::endl;
+        std::ofstream eventFile( settings.eventSettings.eventFilename.c_str( ) );
+        eventFile << "member,event,t,x,y,z,vx,vy,vz,action,phase" << std::endl;
+        for ( unsigned int i = 0; i < ensemble.size( ); i++ )
+        {
+            const EventLog& eventLog = ensemble[ i ].eventLog;
+            for ( unsigned int j = 0; j < eventLog.size( ); j++ )
+            {
+                eventFile << ensemble[ i ].index << "," << eventLog[ j ].name << ",";
+                writeShortestDouble( eventFile, eventLog[ j ].time );
+                for ( unsigned int k = 0; k < eventLog[ j ].state.size( ); k++ )
+                {
+                    eventFile << ",";
+                    writeShortestDouble( eventFile, eventLog[ j ].state[ k ] );
+                }
+                eventFile << "," << getEventActionName( eventLog[ j ].action )
+                          << "," << eventLog[ j ].phase << "\n";
+            }
+        }
+        eventFile.close( );
+        logInfo( ) << "Event log written to file successfully!" << std::endl;
+    }
+
+    return metadata;
+}
+
+} // namespace scarab
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+#include <rapidjson/document.h>
+
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/internalTools.hpp"
+
+namespace scarab
+{
+
+//! Magic string at start of ephemeris file.
+static const char ephemerisFileMagic[ ] = "SCARABEP";
+
+//! Size of fixed prefix of ephemeris file (magic, version, header length, number of coefficients).
+static const std::size_t ephemerisFilePrefixSize = 24;
+
+//! Alignment of data in ephemeris file [bytes].
+static const std::size_t ephemerisFileAlignment = 64;
+
+//! Segment cache entry.
+/*!
+ * Last segment used for a body of an ephemeris. An identifier of zero marks an empty entry.
+ */
+struct SegmentCacheEntry
+{
+    //! Identifier of ephemeris.
+    std::size_t identifier;
+
+    //! Index of body.
+    std::size_t bodyIndex;
+
+    //! Start time of segment [s].
+    double segmentStart;
+
+    //! End time of segment [s].
+    double segmentEnd;
+
+    //! Factor mapping time in segment to [-1, 1] [s^-1].
+    double timeScale;
+
+    //! Number of coefficients per component.
+    std::size_t numberOfCoefficients;
+
+    //! Pointer to coefficients of segment [km].
+    const double* coefficients;
+};
+
+//! Number of entries in segment cache.
+static const std::size_t segmentCacheSize = 16;
+
+//! Per-thread segment cache, indexed by ephemeris identifier and body index.
+static thread_local SegmentCacheEntry segmentCache[ segmentCacheSize ];
+
+//! Number of ephemerides constructed, used to assign unique identifiers.
+static std::atomic< std::size_t > numberOfEphemerides( 0 );
+
+//! Check that time span and coefficients of body are valid.
+static void checkEphemerisBody( const EphemerisBody& body )
+{
+    if ( !( body.segmentDuration > 0.0 ) || body.numberOfSegments == 0
+         || body.numberOfCoefficients == 0 )
+    {
+        throw std::runtime_error( "ERROR: Ephemeris of body \"" + body.name
+                                  + "\" must contain at least one segment and coefficient!" );
+    }
+}
+
+//! Write Chebyshev ephemeris file.
+void writeChebyshevEphemeris( const std::string& filename,
+                              const std::vector< EphemerisBody >& bodies )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error( "ERROR: Binary ephemeris files require little-endian host!" );
+    }
+
+    // Assemble header, padded such that the data starts at an aligned offset.
+    std::ostringstream header;
+    header << "{\"bodies\":[";
+    char value[ 32 ];
+    std::size_t offset = 0;
+    for ( std::size_t i = 0; i < bodies.size( ); i++ )
+    {
+        checkEphemerisBody( bodies[ i ] );
+
+        header << ( i > 0 ? "," : "" )
+               << "{\"name\":\"" << escapeJsonString( bodies[ i ].name ) << "\"";
+        std::snprintf( value, sizeof( value ), "%.17g", bodies[ i ].gravitationalParameter );
+        header << ",\"gravitational_parameter\":" << value;
+        std::snprintf( value, sizeof( value ), "%.17g", bodies[ i ].startTime );
+        header << ",\"start_time\":" << value;
+        std::snprintf( value, sizeof( value ), "%.17g", bodies[ i ].segmentDuration );
+        header << ",\"segment_duration\":" << value
+               << ",\"number_of_segments\":" << bodies[ i ].numberOfSegments
+               << ",\"number_of_coefficients\":" << bodies[ i ].numberOfCoefficients
+               << ",\"offset\":" << offset << "}";
+
+        offset += 3 * bodies[ i ].numberOfSegments * bodies[ i ].numberOfCoefficients;
+    }
+    header << "]}";
+
+    std::string headerText = header.str( );
+    const std::size_t unpaddedSize = ephemerisFilePrefixSize + headerText.size( );
+    headerText.append( ( ephemerisFileAlignment - unpaddedSize % ephemerisFileAlignment )
+                       % ephemerisFileAlignment, ' ' );
+
+    std::ofstream file( filename.c_str( ), std::ios::binary | std::ios::trunc );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not open ephemeris file \"" + filename + "\"!" );
+    }
+
+    file.write( ephemerisFileMagic, 8 );
+    writeLittleEndian( file, ephemerisFileVersion, 4 );
+    writeLittleEndian( file, headerText.size( ), 4 );
+    writeLittleEndian( file, offset, 8 );
+    file.write( headerText.data( ), headerText.size( ) );
+
+    for ( std::size_t i = 0; i < bodies.size( ); i++ )
+    {
+        file.write( reinterpret_cast< const char* >( bodies[ i ].coefficients ),
+                    3 * bodies[ i ].numberOfSegments * bodies[ i ].numberOfCoefficients
+                    * sizeof( double ) );
+    }
+
+    file.close( );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not write ephemeris file \"" + filename + "\"!" );
+    }
+}
+
+//! Construct ephemeris.
+ChebyshevEphemeris::ChebyshevEphemeris( const std::string& filename )
+    : file( filename.c_str( ), boost::interprocess::read_only ),
+      region( file, boost::interprocess::read_only ),
+      identifier( ++numberOfEphemerides )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error( "ERROR: Binary ephemeris files require little-endian host!" );
+    }
+
+    const unsigned char* bytes = static_cast< const unsigned char* >( region.get_address( ) );
+    const std::size_t fileSize = region.get_size( );
+
+    if ( fileSize < ephemerisFilePrefixSize
+         || std::memcmp( bytes, ephemerisFileMagic, 8 ) != 0 )
+    {
+        throw std::runtime_error( "ERROR: \"" + filename + "\" is not an ephemeris file!" );
+    }
+
+    const boost::uint64_t version = readLittleEndian( bytes + 8, 4 );
+    if ( version != ephemerisFileVersion )
+    {
+        std::ostringstream error;
+        error << "ERROR: Ephemeris file version " << version << " is not supported!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    const std::size_t headerSize = static_cast< std::size_t >( readLittleEndian( bytes + 12, 4 ) );
+    const std::size_t numberOfCoefficients
+        = static_cast< std::size_t >( readLittleEndian( bytes + 16, 8 ) );
+    const std::size_t dataOffset = ephemerisFilePrefixSize + headerSize;
+    if ( fileSize < dataOffset
+         || ( fileSize - dataOffset ) / sizeof( double ) < numberOfCoefficients )
+    {
+        throw std::runtime_error( "ERROR: Ephemeris file \"" + filename + "\" is truncated!" );
+    }
+    const double* data = reinterpret_cast< const double* >( bytes + dataOffset );
+
+    // Parse header.
+    const std::string headerText(
+        reinterpret_cast< const char* >( bytes + ephemerisFilePrefixSize ), headerSize );
+    rapidjson::Document header;
+    header.Parse( headerText.c_str( ) );
+    if ( header.HasParseError( ) || !header.IsObject( ) || !header.HasMember( "bodies" ) )
+    {
+        throw std::runtime_error( "ERROR: Header of ephemeris file \"" + filename
+                                  + "\" is invalid!" );
+    }
+
+    const rapidjson::Value& bodyEntries = header[ "bodies" ];
+    for ( rapidjson::SizeType i = 0; i < bodyEntries.Size( ); i++ )
+    {
+        const rapidjson::Value& entry = bodyEntries[ i ];
+        const std::size_t offset = static_cast< std::size_t >( entry[ "offset" ].GetUint64( ) );
+        const EphemerisBody body(
+            entry[ "name" ].GetString( ),
+            entry[ "gravitational_parameter" ].GetDouble( ),
+            entry[ "start_time" ].GetDouble( ),
+            entry[ "segment_duration" ].GetDouble( ),
+            static_cast< std::size_t >( entry[ "number_of_segments" ].GetUint64( ) ),
+            static_cast< std::size_t >( entry[ "number_of_coefficients" ].GetUint64( ) ),
+            data + offset );
+        checkEphemerisBody( body );
+
+        if ( offset > numberOfCoefficients
+             || ( numberOfCoefficients - offset ) / 3 / body.numberOfSegments
+                < body.numberOfCoefficients )
+        {
+            throw std::runtime_error( "ERROR: Coefficients of body \"" + body.name
+                                      + "\" exceed data of ephemeris file \"" + filename
+                                      + "\"!" );
+        }
+        bodies.push_back( body );
+    }
+}
+
+//! Find body.
+std::size_t ChebyshevEphemeris::findBody( const std::string& bodyName ) const
+{
+    for ( std::size_t i = 0; i < bodies.size( ); i++ )
+    {
+        if ( bodies[ i ].name == bodyName )
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error( "ERROR: Body \"" + bodyName + "\" not found in ephemeris file!" );
+}
+
+//! Get position.
+Position ChebyshevEphemeris::getPosition( const std::size_t bodyIndex, const double time ) const
+{
+    SegmentCacheEntry& segment = segmentCache[ ( identifier * 4 + bodyIndex ) % segmentCacheSize ];
+
+    // Look up segment containing given time, if it is not the segment used last.
+    if ( segment.identifier != identifier || segment.bodyIndex != bodyIndex
+         || !( time >= segment.segmentStart && time < segment.segmentEnd ) )
+    {
+        const EphemerisBody& body = getBody( bodyIndex );
+        if ( !( time >= body.startTime && time <= body.getEndTime( ) ) )
+        {
+            std::ostringstream error;
+            error << "ERROR: Time " << time << " s is outside of ephemeris of body \""
+                  << body.name << "\" [" << body.startTime << "; " << body.getEndTime( )
+                  << "] s!";
+            throw std::runtime_error( error.str( ) );
+        }
+
+        std::size_t segmentIndex
+            = static_cast< std::size_t >( ( time - body.startTime ) / body.segmentDuration );
+        if ( segmentIndex >= body.numberOfSegments )
+        {
+            segmentIndex = body.numberOfSegments - 1;
+        }
+
+        segment.identifier = identifier;
+        segment.bodyIndex = bodyIndex;
+        segment.segmentStart = body.startTime + segmentIndex * body.segmentDuration;
+        segment.segmentEnd = segment.segmentStart + body.segmentDuration;
+        segment.timeScale = 2.0 / body.segmentDuration;
+        segment.numberOfCoefficients = body.numberOfCoefficients;
+        segment.coefficients
+            = body.coefficients + 3 * segmentIndex * body.numberOfCoefficients;
+    }
+
+    // Evaluate Chebyshev series using Clenshaw's recurrence. The recurrences of the three
+    // components are independent and are interleaved, so that they are executed in parallel.
+    const double tau = ( time - segment.segmentStart ) * segment.timeScale - 1.0;
+    const double twoTau = 2.0 * tau;
+    const std::size_t n = segment.numberOfCoefficients;
+    const double* x = segment.coefficients;
+    const double* y = x + n;
+    const double* z = y + n;
+    double bx1 = 0.0;
+    double by1 = 0.0;
+    double bz1 = 0.0;
+    double bx2 = 0.0;
+    double by2 = 0.0;
+    double bz2 = 0.0;
+    for ( std::size_t k = n - 1; k > 0; k-- )
+    {
+        const double bx0 = x[ k ] + twoTau * bx1 - bx2;
+        const double by0 = y[ k ] + twoTau * by1 - by2;
+        const double bz0 = z[ k ] + twoTau * bz1 - bz2;
+        bx2 = bx1;
+        by2 = by1;
+        bz2 = bz1;
+        bx1 = bx0;
+        by1 = by0;
+        bz1 = bz0;
+    }
+
+    Position position;
+    position[ 0 ] = x[ 0 ] + tau * bx1 - bx2;
+    position[ 1 ] = y[ 0 ] + tau * by1 - by2;
+    position[ 2 ] = z[ 0 ] + tau * bz1 - bz2;
+
+    return position;
+}
+
+} // namespace scarab
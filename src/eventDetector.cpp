@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/make_shared.hpp>
+#include <boost/math/tools/toms748_solve.hpp>
+
+#include "Scarab/eventDetector.hpp"
+
+namespace scarab
+{
+
+//! Maximum number of iterations to locate an event.
+static const boost::uintmax_t maximumNumberOfRootFindingIterations = 100;
+
+namespace
+{
+
+//! Event function evaluated on the state interpolated within an integration step.
+class InterpolatedEventFunction
+{
+public:
+
+    //! Construct interpolated event function.
+    /*!
+     * Constructs event function evaluated on the state interpolated within an integration step.
+     *
+     * @param[in] anEventFunction   Event function
+     * @param[in] aStep             Integration step
+     */
+    InterpolatedEventFunction( const EventFunction& anEventFunction,
+                               const IntegrationStep& aStep )
+        : eventFunction( anEventFunction ),
+          step( aStep )
+    { }
+
+    //! Evaluate event function.
+    /*!
+     * Evaluates event function on the state interpolated at the given time.
+     *
+     * @param[in] time  Time within step                                        [s]
+     * @return          Value of event function
+     */
+    double operator( )( const double time ) const
+    {
+        return eventFunction( step.interpolate( time ), time );
+    }
+
+private:
+
+    //! Event function.
+    const EventFunction& eventFunction;
+
+    //! Integration step.
+    const IntegrationStep& step;
+};
+
+} // namespace
+
+//! Check if event function crosses zero in the direction that triggers event.
+static bool isTriggered( const EventDirection direction,
+                         const double startValue,
+                         const double endValue )
+{
+    const bool isRising = startValue < 0.0 && endValue >= 0.0;
+    const bool isFalling = startValue > 0.0 && endValue <= 0.0;
+
+    switch ( direction )
+    {
+        case risingEventDirection:
+            return isRising;
+
+        case fallingEventDirection:
+            return isFalling;
+
+        case anyEventDirection:
+            return isRising || isFalling;
+    }
+
+    return false;
+}
+
+//! Get event action name.
+std::string getEventActionName( const EventAction action )
+{
+    switch ( action )
+    {
+        case logEventAction:
+            return "log";
+
+        case terminateEventAction:
+            return "terminate";
+
+        case switchPhaseEventAction:
+            return "switch_phase";
+    }
+
+    throw std::runtime_error( "ERROR: Event action is not supported!" );
+}
+
+//! Write event log.
+void writeEventLog( std::ostream& stream, const EventLog& eventLog )
+{
+    stream << "event,t,x,y,z,vx,vy,vz,action,phase" << std::endl;
+    stream << std::setprecision( std::numeric_limits< double >::digits10 );
+    for ( unsigned int i = 0; i < eventLog.size( ); i++ )
+    {
+        stream << eventLog[ i ].name << "," << eventLog[ i ].time;
+        for ( unsigned int j = 0; j < eventLog[ i ].state.size( ); j++ )
+        {
+            stream << "," << eventLog[ i ].state[ j ];
+        }
+        stream << "," << getEventActionName( eventLog[ i ].action )
+               << "," << eventLog[ i ].phase << "\n";
+    }
+    stream.flush( );
+}
+
+//! Construct event detector.
+EventDetector::EventDetector( const EventSettings& settings )
+    : listOfEventDefinitions( settings.listOfEventDefinitions ),
+      values( settings.listOfEventDefinitions.size( ), 0.0 ),
+      endValues( settings.listOfEventDefinitions.size( ), 0.0 ),
+      phase( settings.initialPhase ),
+      terminated( false ),
+      terminationTime( std::numeric_limits< double >::quiet_NaN( ) )
+{
+    terminationState.fill( std::numeric_limits< double >::quiet_NaN( ) );
+
+    for ( std::size_t i = 0; i < listOfEventDefinitions.size( ); i++ )
+    {
+        const EventDefinition& definition = listOfEventDefinitions[ i ];
+        switch ( definition.type )
+        {
+            case distanceEventType:
+                listOfEventFunctions.push_back( boost::make_shared< DistanceEventFunction >(
+                    definition.referencePoint, definition.threshold ) );
+                break;
+
+            case stateComponentEventType:
+                if ( definition.stateComponent >= terminationState.size( ) )
+                {
+                    throw std::runtime_error( "ERROR: State component of event \""
+                                              + definition.name + "\" is out of range!" );
+                }
+                listOfEventFunctions.push_back( boost::make_shared< StateComponentEventFunction >(
+                    definition.stateComponent, definition.threshold ) );
+                break;
+        }
+    }
+}
+
+//! Initialize event detector.
+void EventDetector::initialize( const State& state, const double time )
+{
+    for ( std::size_t i = 0; i < listOfEventFunctions.size( ); i++ )
+    {
+        values[ i ] = ( *listOfEventFunctions[ i ] )( state, time );
+    }
+}
+
+//! Detect events within integration step.
+bool EventDetector::detectEvents( const IntegrationStep& step )
+{
+    for ( std::size_t i = 0; i < listOfEventFunctions.size( ); i++ )
+    {
+        endValues[ i ] = ( *listOfEventFunctions[ i ] )( step.endState, step.endTime );
+    }
+
+    // Handle events in chronological order. After an event is handled, the remainder of the step
+    // is searched again, since a phase switch changes which events are active.
+    double time = step.startTime;
+    while ( true )
+    {
+        std::size_t eventIndex = listOfEventFunctions.size( );
+        double eventTime = step.endTime;
+        for ( std::size_t i = 0; i < listOfEventFunctions.size( ); i++ )
+        {
+            const EventDirection direction = listOfEventDefinitions[ i ].direction;
+            if ( !isActive( i ) || !isTriggered( direction, values[ i ], endValues[ i ] ) )
+            {
+                continue;
+            }
+
+            // Locate zero crossing within [time, end time of step]; the upper end of the final
+            // bracket is taken, at which the event function has crossed zero.
+            boost::uintmax_t numberOfIterations = maximumNumberOfRootFindingIterations;
+            const std::pair< double, double > bracket = boost::math::tools::toms748_solve(
+                InterpolatedEventFunction( *listOfEventFunctions[ i ], step ),
+                time,
+                step.endTime,
+                values[ i ],
+                endValues[ i ],
+                boost::math::tools::eps_tolerance< double >( ),
+                numberOfIterations );
+
+            if ( eventIndex == listOfEventFunctions.size( ) || bracket.second < eventTime )
+            {
+                eventIndex = i;
+                eventTime = bracket.second;
+            }
+        }
+
+        if ( eventIndex == listOfEventFunctions.size( ) )
+        {
+            break;
+        }
+
+        const EventDefinition& definition = listOfEventDefinitions[ eventIndex ];
+        const State eventState = ( eventTime == step.endTime )
+                                 ? step.endState : step.interpolate( eventTime );
+        eventLog.push_back(
+            EventOccurrence( definition.name, eventTime, eventState, definition.action, phase ) );
+
+        if ( definition.action == terminateEventAction )
+        {
+            terminated = true;
+            terminationTime = eventTime;
+            terminationState = eventState;
+            return true;
+        }
+        else if ( definition.action == switchPhaseEventAction )
+        {
+            phase = definition.nextPhase;
+        }
+
+        // Continue search from event. The event that was handled is not triggered again within
+        // this step.
+        time = eventTime;
+        for ( std::size_t i = 0; i < listOfEventFunctions.size( ); i++ )
+        {
+            values[ i ] = ( *listOfEventFunctions[ i ] )( eventState, eventTime );
+        }
+        values[ eventIndex ] = endValues[ eventIndex ];
+    }
+
+    values = endValues;
+    return false;
+}
+
+//! Write checkpoint.
+void EventDetector::writeCheckpoint( Checkpoint& checkpoint ) const
+{
+    checkpoint.writeDoubles( values );
+    checkpoint.writeString( phase );
+    checkpoint.writeSize( eventLog.size( ) );
+    for ( std::size_t i = 0; i < eventLog.size( ); i++ )
+    {
+        checkpoint.writeString( eventLog[ i ].name );
+        checkpoint.writeDouble( eventLog[ i ].time );
+        checkpoint.writeState( eventLog[ i ].state );
+        checkpoint.writeSize( eventLog[ i ].action );
+        checkpoint.writeString( eventLog[ i ].phase );
+    }
+}
+
+//! Restore checkpoint.
+void EventDetector::restoreCheckpoint( Checkpoint& checkpoint )
+{
+    const std::vector< double > checkpointValues = checkpoint.readDoubles( );
+    if ( checkpointValues.size( ) != listOfEventDefinitions.size( ) )
+    {
+        throw std::runtime_error( "ERROR: Events in checkpoint do not match event settings!" );
+    }
+    values = checkpointValues;
+    phase = checkpoint.readString( );
+
+    eventLog.clear( );
+    const std::size_t numberOfEvents = checkpoint.readSize( );
+    for ( std::size_t i = 0; i < numberOfEvents; i++ )
+    {
+        const std::string name = checkpoint.readString( );
+        const double time = checkpoint.readDouble( );
+        const State state = checkpoint.readState( );
+        const EventAction action = static_cast< EventAction >( checkpoint.readSize( ) );
+        const std::string eventPhase = checkpoint.readString( );
+        eventLog.push_back( EventOccurrence( name, time, state, action, eventPhase ) );
+    }
+}
+
+//! Check if event is active in current phase.
+bool EventDetector::isActive( const std::size_t eventIndex ) const
+{
+    return listOfEventDefinitions[ eventIndex ].phase.empty( )
+           || listOfEventDefinitions[ eventIndex ].phase == phase;
+}
+
+} // namespace scarab
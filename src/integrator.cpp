@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Scarab/integratorTemplate.hpp"
+
+namespace scarab
+{
+
+//! Accumulate integration statistics.
+void accumulateIntegrationStatistics( const IntegrationStatistics& statistics,
+                                      IntegrationStatistics& totalStatistics )
+{
+    if ( statistics.numberOfAcceptedSteps > 0 )
+    {
+        if ( totalStatistics.numberOfAcceptedSteps == 0 )
+        {
+            totalStatistics.minimumStepSize = statistics.minimumStepSize;
+            totalStatistics.maximumStepSize = statistics.maximumStepSize;
+        }
+        else
+        {
+            totalStatistics.minimumStepSize
+                = std::min( totalStatistics.minimumStepSize, statistics.minimumStepSize );
+            totalStatistics.maximumStepSize
+                = std::max( totalStatistics.maximumStepSize, statistics.maximumStepSize );
+        }
+    }
+
+    totalStatistics.numberOfFunctionEvaluations += statistics.numberOfFunctionEvaluations;
+    totalStatistics.numberOfAcceptedSteps       += statistics.numberOfAcceptedSteps;
+    totalStatistics.numberOfRejectedSteps       += statistics.numberOfRejectedSteps;
+}
+
+//! Interpolate state within integration step.
+State interpolateState( const double time,
+                        const double startTime,
+                        const State& startState,
+                        const State& startStateDerivative,
+                        const double endTime,
+                        const State& endState,
+                        const State& endStateDerivative )
+{
+    const double stepSize = endTime - startTime;
+    const double s = ( time - startTime ) / stepSize;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double s4 = s3 * s;
+    const double s5 = s4 * s;
+
+    // Quintic Hermite basis functions and their derivatives with respect to s, for the position
+    // (p), velocity (v) and acceleration (a) at the start (0) and end (1) of the step.
+    const double hp0 = 1.0 - 10.0 * s3 + 15.0 * s4 - 6.0 * s5;
+    const double hv0 = s - 6.0 * s3 + 8.0 * s4 - 3.0 * s5;
+    const double ha0 = 0.5 * s2 - 1.5 * s3 + 1.5 * s4 - 0.5 * s5;
+    const double ha1 = 0.5 * s3 - s4 + 0.5 * s5;
+    const double hv1 = -4.0 * s3 + 7.0 * s4 - 3.0 * s5;
+    const double hp1 = 1.0 - hp0;
+
+    const double dhp0 = -30.0 * s2 + 60.0 * s3 - 30.0 * s4;
+    const double dhv0 = 1.0 - 18.0 * s2 + 32.0 * s3 - 15.0 * s4;
+    const double dha0 = s - 4.5 * s2 + 6.0 * s3 - 2.5 * s4;
+    const double dha1 = 1.5 * s2 - 4.0 * s3 + 2.5 * s4;
+    const double dhv1 = -12.0 * s2 + 28.0 * s3 - 15.0 * s4;
+    const double dhp1 = -dhp0;
+
+    const double stepSize2 = stepSize * stepSize;
+
+    State state;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        const double p0 = startState[ i ];
+        const double v0 = startStateDerivative[ i ] * stepSize;
+        const double a0 = startStateDerivative[ i + 3 ] * stepSize2;
+        const double p1 = endState[ i ];
+        const double v1 = endStateDerivative[ i ] * stepSize;
+        const double a1 = endStateDerivative[ i + 3 ] * stepSize2;
+
+        state[ i ] = hp0 * p0 + hv0 * v0 + ha0 * a0 + ha1 * a1 + hv1 * v1 + hp1 * p1;
+        state[ i + 3 ] = ( dhp0 * p0 + dhv0 * v0 + dha0 * a0 + dha1 * a1 + dhv1 * v1 + dhp1 * p1 )
+                         / stepSize;
+    }
+
+    return state;
+}
+
+//! Write integrator checkpoint.
+void writeIntegratorCheckpoint( const IntegratorCheckpoint& integratorCheckpoint,
+                                Checkpoint& checkpoint )
+{
+    checkpoint.writeDouble( integratorCheckpoint.time );
+    checkpoint.writeState( integratorCheckpoint.state );
+    checkpoint.writeState( integratorCheckpoint.stateDerivative );
+    checkpoint.writeDouble( integratorCheckpoint.stepSize );
+    checkpoint.writeSize( integratorCheckpoint.numberOfSteps );
+    checkpoint.writeSize( integratorCheckpoint.statistics.numberOfFunctionEvaluations );
+    checkpoint.writeSize( integratorCheckpoint.statistics.numberOfAcceptedSteps );
+    checkpoint.writeSize( integratorCheckpoint.statistics.numberOfRejectedSteps );
+    checkpoint.writeDouble( integratorCheckpoint.statistics.minimumStepSize );
+    checkpoint.writeDouble( integratorCheckpoint.statistics.maximumStepSize );
+    checkpoint.writeDouble( integratorCheckpoint.statistics.finalTime );
+    checkpoint.writeSize( integratorCheckpoint.outputEpochIndex );
+    checkpoint.writeSize( integratorCheckpoint.multistepStateDerivatives.size( ) );
+    for ( std::size_t i = 0; i < integratorCheckpoint.multistepStateDerivatives.size( ); i++ )
+    {
+        checkpoint.writeState( integratorCheckpoint.multistepStateDerivatives[ i ] );
+    }
+}
+
+//! Read integrator checkpoint.
+IntegratorCheckpoint readIntegratorCheckpoint( Checkpoint& checkpoint )
+{
+    IntegratorCheckpoint integratorCheckpoint;
+    integratorCheckpoint.time = checkpoint.readDouble( );
+    integratorCheckpoint.state = checkpoint.readState( );
+    integratorCheckpoint.stateDerivative = checkpoint.readState( );
+    integratorCheckpoint.stepSize = checkpoint.readDouble( );
+    integratorCheckpoint.numberOfSteps = checkpoint.readSize( );
+    integratorCheckpoint.statistics.numberOfFunctionEvaluations = checkpoint.readSize( );
+    integratorCheckpoint.statistics.numberOfAcceptedSteps = checkpoint.readSize( );
+    integratorCheckpoint.statistics.numberOfRejectedSteps = checkpoint.readSize( );
+    integratorCheckpoint.statistics.minimumStepSize = checkpoint.readDouble( );
+    integratorCheckpoint.statistics.maximumStepSize = checkpoint.readDouble( );
+    integratorCheckpoint.statistics.finalTime = checkpoint.readDouble( );
+    integratorCheckpoint.outputEpochIndex = checkpoint.readSize( );
+    const std::size_t historySize = checkpoint.readSize( );
+    for ( std::size_t i = 0; i < historySize; i++ )
+    {
+        integratorCheckpoint.multistepStateDerivatives.push_back( checkpoint.readState( ) );
+    }
+    return integratorCheckpoint;
+}
+
+//! Get numerical integrator type.
+IntegratorType getIntegratorType( const std::string& integratorName )
+{
+    if ( integratorName == "rk4" )
+    {
+        return rungeKutta4Integrator;
+    }
+    else if ( integratorName == "dopri5" )
+    {
+        return dormandPrince5Integrator;
+    }
+    else if ( integratorName == "cash_karp54" )
+    {
+        return cashKarp54Integrator;
+    }
+    else if ( integratorName == "fehlberg78" )
+    {
+        return fehlberg78Integrator;
+    }
+    else if ( integratorName == "bulirsch_stoer" )
+    {
+        return bulirschStoerIntegrator;
+    }
+    else if ( integratorName == "adams_bashforth_moulton" )
+    {
+        return adamsBashforthMoultonIntegrator;
+    }
+
+    throw std::runtime_error( "ERROR: Numerical integrator \"" + integratorName
+                              + "\" is not supported!" );
+}
+
+//! Get numerical integrator name.
+std::string getIntegratorName( const IntegratorType integrator )
+{
+    switch ( integrator )
+    {
+        case rungeKutta4Integrator:
+            return "rk4";
+
+        case dormandPrince5Integrator:
+            return "dopri5";
+
+        case cashKarp54Integrator:
+            return "cash_karp54";
+
+        case fehlberg78Integrator:
+            return "fehlberg78";
+
+        case bulirschStoerIntegrator:
+            return "bulirsch_stoer";
+
+        case adamsBashforthMoultonIntegrator:
+            return "adams_bashforth_moulton";
+    }
+
+    throw std::runtime_error( "ERROR: Numerical integrator type is not supported!" );
+}
+
+//! Integrate state.
+IntegrationStatistics integrateState( const IntegratorSettings& settings,
+                                      const StateDerivativeModel& stateDerivativeModel,
+                                      State& state,
+                                      const IntegratorObserver& observer,
+                                      const double outputInterval,
+                                      const std::vector< double >& outputEpochs,
+                                      EventDetector* eventDetector,
+                                      IntegratorCheckpointHandler* checkpointHandler,
+                                      const IntegratorCheckpoint* initialCheckpoint )
+{
+    return detail::integrateStateWithModel( settings, stateDerivativeModel, state,
+                                            observer, outputInterval, outputEpochs, eventDetector,
+                                            checkpointHandler, initialCheckpoint );
+}
+
+//! Integrate state with state derivative function.
+IntegrationStatistics integrateState( const IntegratorSettings& settings,
+                                      const StateDerivativeFunction& stateDerivativeFunction,
+                                      State& state,
+                                      const IntegratorObserver& observer,
+                                      const double outputInterval,
+                                      const std::vector< double >& outputEpochs,
+                                      EventDetector* eventDetector,
+                                      IntegratorCheckpointHandler* checkpointHandler,
+                                      const IntegratorCheckpoint* initialCheckpoint )
+{
+    return detail::integrateStateWithModel( settings, stateDerivativeFunction, state,
+                                            observer, outputInterval, outputEpochs, eventDetector,
+                                            checkpointHandler, initialCheckpoint );
+}
+
+} // namespace scarab
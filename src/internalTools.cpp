@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include "Scarab/internalTools.hpp"
+
+namespace scarab
+{
+
+//! Check if host is little-endian.
+bool isLittleEndian( )
+{
+    const boost::uint16_t one = 1;
+    return *reinterpret_cast< const unsigned char* >( &one ) == 1;
+}
+
+//! Write unsigned integer to stream as little-endian.
+void writeLittleEndian( std::ostream& stream,
+                        const boost::uint64_t value,
+                        const std::size_t numberOfBytes )
+{
+    for ( std::size_t i = 0; i < numberOfBytes; i++ )
+    {
+        stream.put( static_cast< char >( ( value >> ( 8 * i ) ) & 0xff ) );
+    }
+}
+
+//! Append unsigned integer to buffer as little-endian.
+void writeLittleEndian( std::vector< char >& buffer,
+                        const boost::uint64_t value,
+                        const std::size_t numberOfBytes )
+{
+    for ( std::size_t i = 0; i < numberOfBytes; i++ )
+    {
+        buffer.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xff ) );
+    }
+}
+
+//! Read unsigned integer stored as little-endian.
+boost::uint64_t readLittleEndian( const unsigned char* bytes, const std::size_t numberOfBytes )
+{
+    boost::uint64_t value = 0;
+    for ( std::size_t i = 0; i < numberOfBytes; i++ )
+    {
+        value |= static_cast< boost::uint64_t >( bytes[ i ] ) << ( 8 * i );
+    }
+    return value;
+}
+
+//! Escape string for use in JSON.
+std::string escapeJsonString( const std::string& text )
+{
+    const char* const hexadecimalDigits = "0123456789abcdef";
+
+    std::string escapedText;
+    for ( std::size_t i = 0; i < text.size( ); i++ )
+    {
+        const unsigned char character = static_cast< unsigned char >( text[ i ] );
+        if ( character == '"' || character == '\\' )
+        {
+            escapedText.push_back( '\\' );
+            escapedText.push_back( text[ i ] );
+        }
+        else if ( character < 0x20 )
+        {
+            escapedText += "\\u00";
+            escapedText.push_back( hexadecimalDigits[ character >> 4 ] );
+            escapedText.push_back( hexadecimalDigits[ character & 0xf ] );
+        }
+        else
+        {
+            escapedText.push_back( text[ i ] );
+        }
+    }
+    return escapedText;
+}
+
+//! Construct empty interval lookup table.
+IntervalLookupTable::IntervalLookupTable( )
+    : numberOfIntervals( 0 ),
+      startTime( 0.0 ),
+      inverseBucketWidth( 0.0 )
+{ }
+
+//! Construct interval lookup table.
+IntervalLookupTable::IntervalLookupTable( const double* boundaries,
+                                          const std::size_t aNumberOfIntervals,
+                                          const std::size_t numberOfBucketsPerInterval )
+    : numberOfIntervals( aNumberOfIntervals ),
+      startTime( boundaries[ 0 ] ),
+      inverseBucketWidth( 0.0 ),
+      bucketIntervals( numberOfBucketsPerInterval * aNumberOfIntervals )
+{
+    const std::size_t numberOfBuckets = bucketIntervals.size( );
+    const double bucketWidth = ( boundaries[ numberOfIntervals ] - startTime ) / numberOfBuckets;
+    inverseBucketWidth = 1.0 / bucketWidth;
+    std::size_t interval = 0;
+    for ( std::size_t i = 0; i < numberOfBuckets; i++ )
+    {
+        const double bucketStart = startTime + i * bucketWidth;
+        while ( interval + 1 < numberOfIntervals && bucketStart >= boundaries[ interval + 1 ] )
+        {
+            interval++;
+        }
+        bucketIntervals[ i ] = interval;
+    }
+}
+
+//! Find interval.
+std::size_t IntervalLookupTable::findInterval( const double* boundaries, const double time ) const
+{
+    std::size_t bucket = static_cast< std::size_t >( ( time - startTime ) * inverseBucketWidth );
+    if ( bucket >= bucketIntervals.size( ) )
+    {
+        bucket = bucketIntervals.size( ) - 1;
+    }
+
+    // The bucket index is subject to round-off, so the interval is corrected in both directions.
+    std::size_t interval = bucketIntervals[ bucket ];
+    while ( interval > 0 && time < boundaries[ interval ] )
+    {
+        interval--;
+    }
+    while ( interval + 1 < numberOfIntervals && time >= boundaries[ interval + 1 ] )
+    {
+        interval++;
+    }
+    return interval;
+}
+
+} // namespace scarab
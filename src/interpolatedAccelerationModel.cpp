@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/array.hpp>
+
+#include "Scarab/interpolatedAccelerationModel.hpp"
+
+namespace scarab
+{
+
+//! Number of interpolation nodes per axis.
+static const std::size_t numberOfCellNodes = 4;
+
+//! Compute Chebyshev nodes on the interval [ -1, 1 ].
+static boost::array< double, numberOfCellNodes > computeChebyshevNodes( )
+{
+    const double pi = 3.14159265358979323846;
+    boost::array< double, numberOfCellNodes > nodes;
+    for ( std::size_t k = 0; k < numberOfCellNodes; k++ )
+    {
+        nodes[ k ] = std::cos( ( 2.0 * k + 1.0 ) * pi / ( 2.0 * numberOfCellNodes ) );
+    }
+    return nodes;
+}
+
+//! Compute inverse denominators of Lagrange basis polynomials through Chebyshev nodes.
+static boost::array< double, numberOfCellNodes > computeInverseDenominators(
+    const boost::array< double, numberOfCellNodes >& nodes )
+{
+    boost::array< double, numberOfCellNodes > inverseDenominators;
+    for ( std::size_t k = 0; k < numberOfCellNodes; k++ )
+    {
+        double denominator = 1.0;
+        for ( std::size_t j = 0; j < numberOfCellNodes; j++ )
+        {
+            if ( j != k )
+            {
+                denominator *= nodes[ k ] - nodes[ j ];
+            }
+        }
+        inverseDenominators[ k ] = 1.0 / denominator;
+    }
+    return inverseDenominators;
+}
+
+//! Chebyshev nodes on the interval [ -1, 1 ].
+static const boost::array< double, numberOfCellNodes > chebyshevNodes = computeChebyshevNodes( );
+
+//! Inverse denominators of Lagrange basis polynomials.
+static const boost::array< double, numberOfCellNodes > inverseDenominators
+    = computeInverseDenominators( chebyshevNodes );
+
+//! Compute Lagrange basis polynomials through Chebyshev nodes at point in [ -1, 1 ].
+static void computeLagrangeBasis( const double u, double basis[ numberOfCellNodes ] )
+{
+    double differences[ numberOfCellNodes ];
+    for ( std::size_t k = 0; k < numberOfCellNodes; k++ )
+    {
+        differences[ k ] = u - chebyshevNodes[ k ];
+    }
+    for ( std::size_t k = 0; k < numberOfCellNodes; k++ )
+    {
+        double product = inverseDenominators[ k ];
+        for ( std::size_t j = 0; j < numberOfCellNodes; j++ )
+        {
+            if ( j != k )
+            {
+                product *= differences[ j ];
+            }
+        }
+        basis[ k ] = product;
+    }
+}
+
+//! Construct model.
+InterpolatedAccelerationModel::InterpolatedAccelerationModel(
+    const AccelerationModel3dPtr&   aWrappedModel,
+    const double                    aCellSize,
+    const double                    aTolerance,
+    const std::size_t               aMaximumNumberOfCells,
+    const double                    aRotationRate )
+    : wrappedModel( aWrappedModel ),
+      cellSize( aCellSize ),
+      tolerance( aTolerance ),
+      maximumNumberOfCells( aMaximumNumberOfCells ),
+      rotationRate( aRotationRate )
+{
+    if ( !wrappedModel )
+    {
+        throw std::runtime_error( "ERROR: Interpolated acceleration model needs a wrapped model!" );
+    }
+    if ( !( cellSize > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Interpolation cell size must be positive!" );
+    }
+    if ( !( tolerance > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Interpolation tolerance must be positive!" );
+    }
+}
+
+//! Compute acceleration.
+Acceleration InterpolatedAccelerationModel::operator( )( const State& state,
+                                                         const double time ) const
+{
+    // Rotate position into frame of grid.
+    double cosineAngle = 1.0;
+    double sineAngle = 0.0;
+    if ( rotationRate != 0.0 )
+    {
+        cosineAngle = std::cos( rotationRate * time );
+        sineAngle = std::sin( rotationRate * time );
+    }
+    Position position;
+    position[ 0 ] = cosineAngle * state[ 0 ] + sineAngle * state[ 1 ];
+    position[ 1 ] = -sineAngle * state[ 0 ] + cosineAngle * state[ 1 ];
+    position[ 2 ] = state[ 2 ];
+
+    CellIndex index;
+    index.i = static_cast< long long >( std::floor( position[ 0 ] / cellSize ) );
+    index.j = static_cast< long long >( std::floor( position[ 1 ] / cellSize ) );
+    index.k = static_cast< long long >( std::floor( position[ 2 ] / cellSize ) );
+
+    // Look up cell, or build it on a miss. Cells are never removed, so the cell can be read
+    // outside the lock.
+    const Cell* cell = 0;
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        const Grid::const_iterator iteratorCell = grid.find( index );
+        if ( iteratorCell != grid.end( ) )
+        {
+            if ( iteratorCell->second->isAccepted )
+            {
+                cell = iteratorCell->second.get( );
+                statistics.numberOfHits++;
+            }
+            else
+            {
+                statistics.numberOfMisses++;
+                statistics.numberOfFallbacks++;
+            }
+        }
+        else
+        {
+            statistics.numberOfMisses++;
+            if ( grid.size( ) < maximumNumberOfCells )
+            {
+                std::unique_ptr< Cell > newCell( new Cell );
+                const double errorEstimate = buildCell( index, *newCell );
+                statistics.numberOfCells++;
+                if ( newCell->isAccepted )
+                {
+                    statistics.maximumErrorEstimate
+                        = std::max( statistics.maximumErrorEstimate, errorEstimate );
+                    cell = newCell.get( );
+                }
+                else
+                {
+                    statistics.numberOfRejectedCells++;
+                    statistics.numberOfFallbacks++;
+                }
+                grid[ index ] = std::move( newCell );
+            }
+            else
+            {
+                statistics.numberOfFallbacks++;
+            }
+        }
+    }
+
+    const Acceleration gridAcceleration
+        = cell != 0 ? interpolate( index, *cell, position ) : evaluateWrappedModel( position );
+
+    // Rotate acceleration back into frame of state.
+    Acceleration acceleration;
+    acceleration[ 0 ] = cosineAngle * gridAcceleration[ 0 ] - sineAngle * gridAcceleration[ 1 ];
+    acceleration[ 1 ] = sineAngle * gridAcceleration[ 0 ] + cosineAngle * gridAcceleration[ 1 ];
+    acceleration[ 2 ] = gridAcceleration[ 2 ];
+    return acceleration;
+}
+
+//! Get interpolation statistics.
+InterpolationStatistics InterpolatedAccelerationModel::getStatistics( ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    return statistics;
+}
+
+//! Compute hash of cell index.
+std::size_t InterpolatedAccelerationModel::CellIndexHash::operator( )(
+    const CellIndex& index ) const
+{
+    const unsigned long long hash = static_cast< unsigned long long >( index.i ) * 73856093ULL
+                                    ^ static_cast< unsigned long long >( index.j ) * 19349663ULL
+                                    ^ static_cast< unsigned long long >( index.k ) * 83492791ULL;
+    return static_cast< std::size_t >( hash );
+}
+
+//! Build cell.
+double InterpolatedAccelerationModel::buildCell( const CellIndex& index, Cell& cell ) const
+{
+    static_assert( numberOfNodes == numberOfCellNodes,
+                   "Number of nodes of cells and of interpolation basis must match" );
+
+    Position origin;
+    origin[ 0 ] = index.i * cellSize;
+    origin[ 1 ] = index.j * cellSize;
+    origin[ 2 ] = index.k * cellSize;
+
+    double* nodeAcceleration = cell.nodeAccelerations;
+    Position node;
+    for ( std::size_t a = 0; a < numberOfCellNodes; a++ )
+    {
+        node[ 0 ] = origin[ 0 ] + 0.5 * ( chebyshevNodes[ a ] + 1.0 ) * cellSize;
+        for ( std::size_t b = 0; b < numberOfCellNodes; b++ )
+        {
+            node[ 1 ] = origin[ 1 ] + 0.5 * ( chebyshevNodes[ b ] + 1.0 ) * cellSize;
+            for ( std::size_t c = 0; c < numberOfCellNodes; c++ )
+            {
+                node[ 2 ] = origin[ 2 ] + 0.5 * ( chebyshevNodes[ c ] + 1.0 ) * cellSize;
+                const Acceleration acceleration = evaluateWrappedModel( node );
+                nodeAcceleration[ 0 ] = acceleration[ 0 ];
+                nodeAcceleration[ 1 ] = acceleration[ 1 ];
+                nodeAcceleration[ 2 ] = acceleration[ 2 ];
+                nodeAcceleration += 3;
+            }
+        }
+    }
+
+    // Estimate interpolation error at the centre and the corners of the cell.
+    const double checkPoints[ ][ 3 ] = { { 0.5, 0.5, 0.5 },
+                                         { 0.0, 0.0, 0.0 }, { 1.0, 0.0, 0.0 },
+                                         { 0.0, 1.0, 0.0 }, { 1.0, 1.0, 0.0 },
+                                         { 0.0, 0.0, 1.0 }, { 1.0, 0.0, 1.0 },
+                                         { 0.0, 1.0, 1.0 }, { 1.0, 1.0, 1.0 } };
+    double errorEstimate = 0.0;
+    for ( std::size_t i = 0; i < sizeof( checkPoints ) / sizeof( checkPoints[ 0 ] ); i++ )
+    {
+        Position point;
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            point[ j ] = origin[ j ] + checkPoints[ i ][ j ] * cellSize;
+        }
+        const Acceleration interpolatedAcceleration = interpolate( index, cell, point );
+        const Acceleration acceleration = evaluateWrappedModel( point );
+        double squaredError = 0.0;
+        for ( std::size_t j = 0; j < 3; j++ )
+        {
+            const double error = interpolatedAcceleration[ j ] - acceleration[ j ];
+            squaredError += error * error;
+        }
+        errorEstimate = std::max( errorEstimate, std::sqrt( squaredError ) );
+    }
+
+    cell.isAccepted = errorEstimate <= tolerance;
+    return errorEstimate;
+}
+
+//! Interpolate acceleration in cell.
+Acceleration InterpolatedAccelerationModel::interpolate( const CellIndex& index,
+                                                         const Cell& cell,
+                                                         const Position& position ) const
+{
+    double basisX[ numberOfCellNodes ];
+    double basisY[ numberOfCellNodes ];
+    double basisZ[ numberOfCellNodes ];
+    computeLagrangeBasis( 2.0 * ( position[ 0 ] / cellSize - index.i ) - 1.0, basisX );
+    computeLagrangeBasis( 2.0 * ( position[ 1 ] / cellSize - index.j ) - 1.0, basisY );
+    computeLagrangeBasis( 2.0 * ( position[ 2 ] / cellSize - index.k ) - 1.0, basisZ );
+
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumZ = 0.0;
+    const double* nodeAcceleration = cell.nodeAccelerations;
+    for ( std::size_t a = 0; a < numberOfCellNodes; a++ )
+    {
+        for ( std::size_t b = 0; b < numberOfCellNodes; b++ )
+        {
+            const double weightXY = basisX[ a ] * basisY[ b ];
+            for ( std::size_t c = 0; c < numberOfCellNodes; c++ )
+            {
+                const double weight = weightXY * basisZ[ c ];
+                sumX += weight * nodeAcceleration[ 0 ];
+                sumY += weight * nodeAcceleration[ 1 ];
+                sumZ += weight * nodeAcceleration[ 2 ];
+                nodeAcceleration += 3;
+            }
+        }
+    }
+
+    Acceleration acceleration;
+    acceleration[ 0 ] = sumX;
+    acceleration[ 1 ] = sumY;
+    acceleration[ 2 ] = sumZ;
+    return acceleration;
+}
+
+//! Evaluate wrapped model.
+Acceleration InterpolatedAccelerationModel::evaluateWrappedModel( const Position& position ) const
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = position[ 0 ];
+    state[ 1 ] = position[ 1 ];
+    state[ 2 ] = position[ 2 ];
+    return ( *wrappedModel )( state, 0.0 );
+}
+
+} // namespace scarab
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <sstream>
+#include <stdexcept>
+
+#include "Scarab/interpolatedTrajectory.hpp"
+
+namespace scarab
+{
+
+//! Construct interpolated trajectory from state history.
+InterpolatedTrajectory::InterpolatedTrajectory( const StateHistory& stateHistory )
+    : times( stateHistory.getTimes( ) ),
+      states( stateHistory.size( ) )
+{
+    for ( std::size_t i = 0; i < states.size( ); i++ )
+    {
+        states[ i ] = stateHistory.getState( i );
+    }
+
+    buildLookupTable( );
+}
+
+//! Construct interpolated trajectory from binary trajectory file.
+InterpolatedTrajectory::InterpolatedTrajectory( const TrajectoryFileReader& reader )
+    : times( reader.getColumn( "t" ), reader.getColumn( "t" ) + reader.getNumberOfRows( ) ),
+      states( reader.getNumberOfRows( ) )
+{
+    static const char* const stateColumnNames[ ] = { "x", "y", "z", "vx", "vy", "vz" };
+
+    for ( unsigned int j = 0; j < 6; j++ )
+    {
+        const double* column = reader.getColumn( stateColumnNames[ j ] );
+        for ( std::size_t i = 0; i < states.size( ); i++ )
+        {
+            states[ i ][ j ] = column[ i ];
+        }
+    }
+
+    buildLookupTable( );
+}
+
+//! Find interval.
+std::size_t InterpolatedTrajectory::findInterval( const double time ) const
+{
+    if ( !( time >= getStartTime( ) && time <= getEndTime( ) ) )
+    {
+        std::ostringstream error;
+        error << "ERROR: Time " << time << " s is outside of trajectory [" << getStartTime( )
+              << "; " << getEndTime( ) << "] s!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    return lookupTable.findInterval( &times[ 0 ], time );
+}
+
+//! Find interval, starting from previous interval.
+std::size_t InterpolatedTrajectory::findInterval( const double time,
+                                                  const std::size_t previousInterval ) const
+{
+    const std::size_t lastInterval = times.size( ) - 2;
+    if ( previousInterval <= lastInterval && time >= times[ previousInterval ] )
+    {
+        if ( time < times[ previousInterval + 1 ] )
+        {
+            return previousInterval;
+        }
+        if ( previousInterval == lastInterval )
+        {
+            if ( time <= times[ previousInterval + 1 ] )
+            {
+                return previousInterval;
+            }
+        }
+        else if ( time < times[ previousInterval + 2 ] )
+        {
+            return previousInterval + 1;
+        }
+    }
+
+    return findInterval( time );
+}
+
+//! Get position.
+Position InterpolatedTrajectory::getPosition( const double time ) const
+{
+    const State state = getState( time );
+
+    Position position;
+    for ( unsigned int i = 0; i < position.size( ); i++ )
+    {
+        position[ i ] = state[ i ];
+    }
+    return position;
+}
+
+//! Interpolate state in interval.
+State InterpolatedTrajectory::interpolateState( const double time,
+                                                const std::size_t interval ) const
+{
+    const State& startState = states[ interval ];
+    const State& endState = states[ interval + 1 ];
+    const double stepSize = times[ interval + 1 ] - times[ interval ];
+    const double s = ( time - times[ interval ] ) / stepSize;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    // Cubic Hermite basis functions and their derivatives with respect to s.
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = ( s3 - 2.0 * s2 + s ) * stepSize;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = ( s3 - s2 ) * stepSize;
+    const double dh00 = ( 6.0 * s2 - 6.0 * s ) / stepSize;
+    const double dh10 = 3.0 * s2 - 4.0 * s + 1.0;
+    const double dh01 = -dh00;
+    const double dh11 = 3.0 * s2 - 2.0 * s;
+
+    State state;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        state[ i ] = h00 * startState[ i ] + h10 * startState[ i + 3 ]
+                     + h01 * endState[ i ] + h11 * endState[ i + 3 ];
+        state[ i + 3 ] = dh00 * startState[ i ] + dh10 * startState[ i + 3 ]
+                         + dh01 * endState[ i ] + dh11 * endState[ i + 3 ];
+    }
+    return state;
+}
+
+//! Build interval lookup table.
+void InterpolatedTrajectory::buildLookupTable( )
+{
+    if ( times.size( ) < 2 )
+    {
+        throw std::runtime_error( "ERROR: Trajectory must contain at least two samples!" );
+    }
+
+    for ( std::size_t i = 1; i < times.size( ); i++ )
+    {
+        if ( !( times[ i ] > times[ i - 1 ] ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Samples of trajectory must be in strictly ascending order of time!" );
+        }
+    }
+
+    // One lookup bucket per interval.
+    lookupTable = IntervalLookupTable( &times[ 0 ], times.size( ) - 1, 1 );
+}
+
+} // namespace scarab
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include "Scarab/logger.hpp"
+
+namespace scarab
+{
+
+namespace
+{
+
+//! Size of log buffer beyond which it is written to the log sink [bytes].
+const std::size_t logBufferFlushSize = 8192;
+
+//! Current log level.
+std::atomic< int > currentLogLevel( infoLogLevel );
+
+//! Mutex guarding log sink.
+std::mutex logSinkMutex;
+
+//! Log sink.
+std::ostream* logSink = &std::cout;
+
+class LogBuffer;
+
+//! Log buffers of all threads, guarded by the log sink mutex.
+std::set< LogBuffer* > logBuffers;
+
+//! Log buffer.
+/*!
+ * Stream buffer that collects log messages of a single thread in memory and writes them to the
+ * log sink as one block. All log buffers are registered, so that setLogSink can flush the buffers
+ * of all threads. The log sink mutex is always locked before the mutex of a buffer.
+ */
+class LogBuffer : public std::streambuf
+{
+public:
+
+    //! Construct log buffer and register it.
+    LogBuffer( )
+    {
+        std::lock_guard< std::mutex > lock( logSinkMutex );
+        logBuffers.insert( this );
+    }
+
+    //! Destruct log buffer, writing remaining messages to log sink.
+    ~LogBuffer( )
+    {
+        std::lock_guard< std::mutex > lock( logSinkMutex );
+        writeToLogSink( );
+        logBuffers.erase( this );
+    }
+
+    //! Write buffered messages to log sink.
+    void flush( )
+    {
+        std::lock_guard< std::mutex > lock( logSinkMutex );
+        writeToLogSink( );
+    }
+
+    //! Write buffered messages to log sink; the log sink mutex must be locked by the caller.
+    void writeToLogSink( )
+    {
+        std::lock_guard< std::mutex > lock( bufferMutex );
+        if ( buffer.empty( ) )
+        {
+            return;
+        }
+
+        logSink->write( buffer.data( ), buffer.size( ) );
+        logSink->flush( );
+        buffer.clear( );
+    }
+
+protected:
+
+    //! Append character to buffer.
+    int_type overflow( int_type character )
+    {
+        if ( !traits_type::eq_int_type( character, traits_type::eof( ) ) )
+        {
+            std::lock_guard< std::mutex > lock( bufferMutex );
+            buffer.push_back( traits_type::to_char_type( character ) );
+        }
+        return traits_type::not_eof( character );
+    }
+
+    //! Append characters to buffer.
+    std::streamsize xsputn( const char* characters, std::streamsize numberOfCharacters )
+    {
+        std::lock_guard< std::mutex > lock( bufferMutex );
+        buffer.append( characters, static_cast< std::size_t >( numberOfCharacters ) );
+        return numberOfCharacters;
+    }
+
+    //! Synchronize buffer, e.g., on std::endl; only writes to log sink if buffer is full.
+    int sync( )
+    {
+        bool isFull = false;
+        {
+            std::lock_guard< std::mutex > lock( bufferMutex );
+            isFull = buffer.size( ) > logBufferFlushSize;
+        }
+        if ( isFull )
+        {
+            flush( );
+        }
+        return 0;
+    }
+
+private:
+
+    //! Mutex guarding buffered messages, which are also written by setLogSink from other threads.
+    std::mutex bufferMutex;
+
+    //! Buffered messages.
+    std::string buffer;
+};
+
+//! Log streams of a single thread.
+struct ThreadLog
+{
+public:
+
+    //! Construct log streams; the discarding stream has no buffer, so it is always in fail state.
+    ThreadLog( )
+        : stream( &buffer ),
+          discardingStream( 0 )
+    { }
+
+    //! Log buffer.
+    LogBuffer buffer;
+
+    //! Log stream writing to log buffer.
+    std::ostream stream;
+
+    //! Log stream discarding all output.
+    std::ostream discardingStream;
+
+protected:
+
+private:
+};
+
+//! Log streams of calling thread.
+ThreadLog& getThreadLog( )
+{
+    thread_local ThreadLog threadLog;
+    return threadLog;
+}
+
+} // namespace
+
+//! Get log level.
+LogLevel getLogLevel( const std::string& logLevelName )
+{
+    if ( logLevelName == "quiet" )
+    {
+        return quietLogLevel;
+    }
+    else if ( logLevelName == "info" )
+    {
+        return infoLogLevel;
+    }
+    else if ( logLevelName == "debug" )
+    {
+        return debugLogLevel;
+    }
+
+    throw std::runtime_error( "ERROR: Log level \"" + logLevelName + "\" is not supported!" );
+}
+
+//! Set log level.
+void setLogLevel( const LogLevel level )
+{
+    currentLogLevel = level;
+}
+
+//! Get current log level.
+LogLevel getCurrentLogLevel( )
+{
+    return static_cast< LogLevel >( currentLogLevel.load( ) );
+}
+
+//! Set log sink.
+void setLogSink( std::ostream& sink )
+{
+    std::lock_guard< std::mutex > lock( logSinkMutex );
+    for ( std::set< LogBuffer* >::iterator iterator = logBuffers.begin( );
+          iterator != logBuffers.end( );
+          ++iterator )
+    {
+        ( *iterator )->writeToLogSink( );
+    }
+    logSink = &sink;
+}
+
+//! Get log stream.
+std::ostream& getLogStream( const LogLevel level )
+{
+    ThreadLog& threadLog = getThreadLog( );
+    if ( level == quietLogLevel || level > currentLogLevel.load( ) )
+    {
+        return threadLog.discardingStream;
+    }
+    return threadLog.stream;
+}
+
+//! Flush log.
+void flushLog( )
+{
+    getThreadLog( ).buffer.flush( );
+}
+
+} // namespace scarab
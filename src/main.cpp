@@ -15,40 +15,21 @@
 
 #include <rapidjson/document.h>
 
+#include "Scarab/logger.hpp"
 #include "Scarab/simulator.hpp"
 
 int main( const int numberOfInputs, const char* inputArguments[ ] )
 {
     ///////////////////////////////////////////////////////////////////////////
 
-    std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
-    std::cout << std::endl;
-    std::cout << "                              Scarab                              " << std::endl;
-    std::cout << "         Simulator for close-range removal of Ariane bodies       " << std::endl;
-
-    std::cout << "                              0.0.1                               " << std::endl;
-    std::cout << std::endl;
-    std::cout << "                      Copyright (c) 2014-2015                     " << std::endl;
-    std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
-    std::cout << std::endl;
-
-    ///////////////////////////////////////////////////////////////////////////
-
-    ///////////////////////////////////////////////////////////////////////////
-
-    std::cout << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << "                        Simulator settings                        " << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << std::endl;
-
-    // Check that only one input has been provided (a JSON file).
-    if ( numberOfInputs - 1 != 1 )
+    // Check that only one input has been provided (a JSON file), optionally preceded by the
+    // --resume flag, to resume an interrupted simulation from its checkpoint.
+    const bool isResumed
+        = numberOfInputs - 1 == 2 && std::string( inputArguments[ 1 ] ) == "--resume";
+    if ( numberOfInputs - 1 != 1 && !isResumed )
     {
-        std::cerr << "ERROR: Number of inputs is wrong. Please only provide a JSON input file!"
-                  << std::endl;
+        std::cerr << "ERROR: Number of inputs is wrong. Please only provide a JSON input file, "
+                  << "optionally preceded by --resume!" << std::endl;
         throw;
     }
 
@@ -58,7 +39,7 @@ int main( const int numberOfInputs, const char* inputArguments[ ] )
 
     // Read and store JSON input document (filter out comment lines).
     // TODO: Need to make comment-line filtering more robust.
-    std::ifstream inputFile( inputArguments[ 1 ] );
+    std::ifstream inputFile( inputArguments[ numberOfInputs - 1 ] );
     std::stringstream jsonDocumentBuffer;
     std::string inputLine;
     while ( std::getline( inputFile, inputLine ) )
@@ -78,18 +59,73 @@ int main( const int numberOfInputs, const char* inputArguments[ ] )
     rapidjson::Document config;
     config.Parse( jsonDocumentBuffer.str( ).c_str( ) );
 
-    // Execute simulator.
-    scarab::executeSimulator( config );
+    // Set log level (optional), before anything is logged.
+    if ( config.HasMember( "log_level" ) )
+    {
+        scarab::setLogLevel( scarab::getLogLevel( config[ "log_level" ].GetString( ) ) );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "------------------------------------------------------------------"
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "                              Scarab                              "
+                       << std::endl;
+    scarab::logInfo( ) << "         Simulator for close-range removal of Ariane bodies       "
+                       << std::endl;
+
+    scarab::logInfo( ) << "                              0.0.1                               "
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "                      Copyright (c) 2014-2015                     "
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "------------------------------------------------------------------"
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "******************************************************************"
+                       << std::endl;
+    scarab::logInfo( ) << "                        Simulator settings                        "
+                       << std::endl;
+    scarab::logInfo( ) << "******************************************************************"
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+
+    // Execute simulator. The log is flushed before an error is rethrown, so that the settings
+    // read up to the error are shown.
+    try
+    {
+        scarab::executeSimulator( config, isResumed );
+    }
+    catch ( ... )
+    {
+        scarab::flushLog( );
+        throw;
+    }
 
     ///////////////////////////////////////////////////////////////////////////
 
-    std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
-    std::cout << std::endl;
-    std::cout << "                        Exited successfully!                      " << std::endl;
-    std::cout << std::endl;
-    std::cout << "------------------------------------------------------------------" << std::endl;
-    std::cout << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "------------------------------------------------------------------"
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "                        Exited successfully!                      "
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::logInfo( ) << "------------------------------------------------------------------"
+                       << std::endl;
+    scarab::logInfo( ) << std::endl;
+    scarab::flushLog( );
 
     return EXIT_SUCCESS;
 
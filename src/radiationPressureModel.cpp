@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Scarab/radiationPressureModel.hpp"
+
+namespace scarab
+{
+
+//! Convert position vector of source from [m] to [km].
+static Position convertToKilometers( const Position& vectorToSource )
+{
+    Position position;
+    position[ 0 ] = vectorToSource[ 0 ] / 1000.0;
+    position[ 1 ] = vectorToSource[ 1 ] / 1000.0;
+    position[ 2 ] = vectorToSource[ 2 ] / 1000.0;
+    return position;
+}
+
+//! Compute norm of position vector.
+static double computeNorm( const Position& position )
+{
+    return std::sqrt( position[ 0 ] * position[ 0 ]
+                      + position[ 1 ] * position[ 1 ]
+                      + position[ 2 ] * position[ 2 ] );
+}
+
+//! Compute radiation pressure acceleration factor P C_R A / m in [km s^-2].
+static double computeAccelerationFactor( const double radiationPressure,
+                                         const double radiationPressureCoefficient,
+                                         const double radiationPressureArea,
+                                         const double mass )
+{
+    if ( !( mass > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Mass subject to radiation pressure must be positive!" );
+    }
+    return radiationPressure * radiationPressureCoefficient * radiationPressureArea / mass
+           / 1000.0;
+}
+
+//! Construct model.
+RadiationPressureModel::RadiationPressureModel( const double        aRadiationPressure,
+                                                const double        aRadiationPressureCoefficient,
+                                                const double        aRadiationPressureArea,
+                                                const double        aMass,
+                                                const Position&     aVectorToSource,
+                                                const ShadowModel   aShadowModel,
+                                                const double        aCentralBodyRadius,
+                                                const double        aSourceRadius )
+    : accelerationFactor( computeAccelerationFactor( aRadiationPressure,
+                                                     aRadiationPressureCoefficient,
+                                                     aRadiationPressureArea,
+                                                     aMass ) ),
+      shadowModel( aShadowModel ),
+      centralBodyRadius( aCentralBodyRadius ),
+      sourceRadius( aSourceRadius ),
+      ephemeris( ),
+      sourceBodyIndex( 0 ),
+      sourceGeometry( computeSourceGeometry( convertToKilometers( aVectorToSource ) ) )
+{ }
+
+//! Construct model.
+RadiationPressureModel::RadiationPressureModel( const double aRadiationPressure,
+                                                const double aRadiationPressureCoefficient,
+                                                const double aRadiationPressureArea,
+                                                const double aMass,
+                                                const ChebyshevEphemerisPtr& anEphemeris,
+                                                const std::size_t aSourceBodyIndex,
+                                                const ShadowModel aShadowModel,
+                                                const double aCentralBodyRadius,
+                                                const double aSourceRadius )
+    : accelerationFactor( computeAccelerationFactor( aRadiationPressure,
+                                                     aRadiationPressureCoefficient,
+                                                     aRadiationPressureArea,
+                                                     aMass ) ),
+      shadowModel( aShadowModel ),
+      centralBodyRadius( aCentralBodyRadius ),
+      sourceRadius( aSourceRadius ),
+      ephemeris( anEphemeris ),
+      sourceBodyIndex( aSourceBodyIndex ),
+      sourceGeometry( computeSourceGeometry(
+          anEphemeris->getPosition( aSourceBodyIndex,
+                                    anEphemeris->getBody( aSourceBodyIndex ).startTime ) ) )
+{ }
+
+//! Compute geometry of source.
+RadiationPressureModel::SourceGeometry RadiationPressureModel::computeSourceGeometry(
+    const Position& sourcePosition ) const
+{
+    const double distance = computeNorm( sourcePosition );
+    if ( !( distance > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Vector to source of radiation pressure is zero!" );
+    }
+
+    const double penumbraSine = ( sourceRadius + centralBodyRadius ) / distance;
+    if ( shadowModel != noShadowModel && !( penumbraSine < 1.0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Source of radiation pressure must lie beyond central body for shadow model!" );
+    }
+
+    SourceGeometry geometry;
+    geometry.position = sourcePosition;
+    geometry.direction[ 0 ] = sourcePosition[ 0 ] / distance;
+    geometry.direction[ 1 ] = sourcePosition[ 1 ] / distance;
+    geometry.direction[ 2 ] = sourcePosition[ 2 ] / distance;
+    geometry.penumbraSlope = penumbraSine / std::sqrt( 1.0 - penumbraSine * penumbraSine );
+    geometry.penumbraVertexProjection = centralBodyRadius / penumbraSine;
+    // Beyond the circle along which the penumbra cone touches the central body, the central body
+    // does not block the source. For a cylindrical shadow, the circle lies in the terminator.
+    geometry.shadowBoundaryProjection
+        = shadowModel == conicalShadowModel ? centralBodyRadius * penumbraSine : 0.0;
+    return geometry;
+}
+
+//! Compute conical shadow function.
+double RadiationPressureModel::computeConicalShadowFunction(
+    const State& state, const SourceGeometry& geometry ) const
+{
+    Position position;
+    position[ 0 ] = state[ 0 ];
+    position[ 1 ] = state[ 1 ];
+    position[ 2 ] = state[ 2 ];
+
+    Position positionToSource;
+    positionToSource[ 0 ] = geometry.position[ 0 ] - state[ 0 ];
+    positionToSource[ 1 ] = geometry.position[ 1 ] - state[ 1 ];
+    positionToSource[ 2 ] = geometry.position[ 2 ] - state[ 2 ];
+
+    const double positionNorm = computeNorm( position );
+    const double distanceToSource = computeNorm( positionToSource );
+    if ( positionNorm <= centralBodyRadius )
+    {
+        return 0.0;
+    }
+
+    // Apparent radii of source and central body, and apparent separation between their centres.
+    const double a = std::asin( sourceRadius / distanceToSource );
+    const double b = std::asin( centralBodyRadius / positionNorm );
+    const double cosineC = -( position[ 0 ] * positionToSource[ 0 ]
+                              + position[ 1 ] * positionToSource[ 1 ]
+                              + position[ 2 ] * positionToSource[ 2 ] )
+                           / ( positionNorm * distanceToSource );
+    const double c = std::acos( std::max( -1.0, std::min( 1.0, cosineC ) ) );
+
+    // No occultation.
+    if ( c >= a + b )
+    {
+        return 1.0;
+    }
+
+    // Total occultation (umbra).
+    if ( c <= b - a )
+    {
+        return 0.0;
+    }
+
+    // Annular occultation (antumbra).
+    if ( c <= a - b )
+    {
+        return 1.0 - ( b * b ) / ( a * a );
+    }
+
+    // Partial occultation (penumbra): area of overlap of the two disks.
+    const double x = ( c * c + a * a - b * b ) / ( 2.0 * c );
+    const double y = std::sqrt( std::max( 0.0, a * a - x * x ) );
+    const double occultedArea = a * a * std::acos( std::max( -1.0, std::min( 1.0, x / a ) ) )
+                                + b * b * std::acos( std::max( -1.0,
+                                                               std::min( 1.0, ( c - x ) / b ) ) )
+                                - c * y;
+
+    return 1.0 - occultedArea / ( std::acos( -1.0 ) * a * a );
+}
+
+} // namespace scarab
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+
+#include "Scarab/randomNumbers.hpp"
+
+namespace scarab
+{
+
+//! Generate uniformly distributed random number.
+double generateUniformRandomNumber( RandomNumberGenerator& generator )
+{
+    // 2^-53, so that the 53-bit integer is mapped exactly onto a double in [0, 1).
+    const double scale = 1.0 / 9007199254740992.0;
+    return static_cast< double >( generator( ) >> 11 ) * scale;
+}
+
+//! Generate random index.
+std::size_t generateRandomIndex( RandomNumberGenerator& generator,
+                                 const std::size_t numberOfIndices )
+{
+    typedef RandomNumberGenerator::result_type Output;
+    const Output range = static_cast< Output >( numberOfIndices );
+
+    // The generator has 2^64 outputs, of which the last 2^64 mod range are rejected.
+    const Output largestOutput = RandomNumberGenerator::max( );
+    const Output limit = largestOutput - ( largestOutput % range + 1 ) % range;
+    Output output = generator( );
+    while ( output > limit )
+    {
+        output = generator( );
+    }
+    return static_cast< std::size_t >( output % range );
+}
+
+//! Generate normally distributed random number.
+double generateNormalRandomNumber( RandomNumberGenerator& generator )
+{
+    double u = 0.0;
+    double s = 0.0;
+    do
+    {
+        u = 2.0 * generateUniformRandomNumber( generator ) - 1.0;
+        const double v = 2.0 * generateUniformRandomNumber( generator ) - 1.0;
+        s = u * u + v * v;
+    } while ( s >= 1.0 || s == 0.0 );
+
+    return u * std::sqrt( -2.0 * std::log( s ) / s );
+}
+
+} // namespace scarab
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/logger.hpp"
+#include "Scarab/relativeMotion.hpp"
+#include "Scarab/simulator.hpp"
+#include "Scarab/tools.hpp"
+#include "Scarab/trajectoryFile.hpp"
+
+namespace scarab
+{
+
+//! Compute mean motion of circular orbit.
+double computeMeanMotion( const double gravitationalParameter, const double semiMajorAxis )
+{
+    if ( !( gravitationalParameter > 0.0 ) || !( semiMajorAxis > 0.0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Gravitational parameter and semi-major axis must be positive!" );
+    }
+
+    return std::sqrt( gravitationalParameter / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) );
+}
+
+//! Compute Clohessy-Wiltshire state transition matrix.
+StateTransitionMatrix computeClohessyWiltshireStateTransitionMatrix( const double meanMotion,
+                                                                     const double elapsedTime )
+{
+    const double n = meanMotion;
+    const double nt = meanMotion * elapsedTime;
+    const double s = std::sin( nt );
+    const double c = std::cos( nt );
+
+    StateTransitionMatrix phi;
+    phi.fill( 0.0 );
+
+    // Radial position and velocity.
+    phi[ 0 ]  = 4.0 - 3.0 * c;
+    phi[ 3 ]  = s / n;
+    phi[ 4 ]  = 2.0 * ( 1.0 - c ) / n;
+    phi[ 18 ] = 3.0 * n * s;
+    phi[ 21 ] = c;
+    phi[ 22 ] = 2.0 * s;
+
+    // Along-track position and velocity.
+    phi[ 6 ]  = 6.0 * ( s - nt );
+    phi[ 7 ]  = 1.0;
+    phi[ 9 ]  = -2.0 * ( 1.0 - c ) / n;
+    phi[ 10 ] = ( 4.0 * s - 3.0 * nt ) / n;
+    phi[ 24 ] = -6.0 * n * ( 1.0 - c );
+    phi[ 27 ] = -2.0 * s;
+    phi[ 28 ] = 4.0 * c - 3.0;
+
+    // Cross-track position and velocity, decoupled from in-plane motion.
+    phi[ 14 ] = c;
+    phi[ 17 ] = s / n;
+    phi[ 32 ] = -n * s;
+    phi[ 35 ] = c;
+
+    return phi;
+}
+
+//! Propagate relative state with state transition matrix.
+State propagateRelativeState( const StateTransitionMatrix& stateTransitionMatrix,
+                              const State& initialState )
+{
+    State state;
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        const double* row = &stateTransitionMatrix[ 6 * i ];
+        state[ i ] = row[ 0 ] * initialState[ 0 ] + row[ 1 ] * initialState[ 1 ]
+                     + row[ 2 ] * initialState[ 2 ] + row[ 3 ] * initialState[ 3 ]
+                     + row[ 4 ] * initialState[ 4 ] + row[ 5 ] * initialState[ 5 ];
+    }
+    return state;
+}
+
+//! Propagate relative state with Clohessy-Wiltshire solution.
+State propagateRelativeState( const double meanMotion,
+                              const State& initialState,
+                              const double elapsedTime )
+{
+    return propagateRelativeState(
+        computeClohessyWiltshireStateTransitionMatrix( meanMotion, elapsedTime ), initialState );
+}
+
+//! Get output epochs of relative motion.
+std::vector< double > getRelativeMotionEpochs( const SimulatorSettings& settings )
+{
+    const double startTime = settings.integratorSettings.startTime;
+    const double endTime = settings.integratorSettings.endTime;
+
+    std::vector< double > epochs;
+    if ( !settings.outputSettings.stateHistoryEpochs.empty( ) )
+    {
+        const std::vector< double >& outputEpochs = settings.outputSettings.stateHistoryEpochs;
+        for ( unsigned int i = 0; i < outputEpochs.size( ); i++ )
+        {
+            if ( outputEpochs[ i ] >= startTime && outputEpochs[ i ] <= endTime )
+            {
+                epochs.push_back( outputEpochs[ i ] );
+            }
+        }
+        return epochs;
+    }
+
+    double outputInterval = settings.outputSettings.stateHistoryInterval;
+    if ( !( outputInterval > 0.0 ) )
+    {
+        outputInterval = settings.integratorSettings.initialStep;
+    }
+
+    // Allow for round-off, so that the end time is sampled if it lies on the grid, as done by the
+    // output sampler of the numerical integrator.
+    const std::size_t numberOfEpochs = static_cast< std::size_t >(
+        std::floor( ( endTime - startTime ) / outputInterval * ( 1.0 + 1.0e-12 ) ) ) + 1;
+    epochs.reserve( numberOfEpochs );
+    for ( std::size_t i = 0; i < numberOfEpochs; i++ )
+    {
+        epochs.push_back( std::min( startTime + i * outputInterval, endTime ) );
+    }
+    return epochs;
+}
+
+//! Propagate relative motion.
+std::size_t propagateRelativeMotion( const SimulatorSettings& settings,
+                                     StateHistorySink& stateHistorySink )
+{
+    const double meanMotion
+        = computeMeanMotion( settings.centralGravitySettings.gravitationalParameter,
+                             settings.relativeMotionSettings.targetSemiMajorAxis );
+    const std::vector< double > epochs = getRelativeMotionEpochs( settings );
+
+    for ( unsigned int i = 0; i < epochs.size( ); i++ )
+    {
+        stateHistorySink.write(
+            epochs[ i ],
+            propagateRelativeState( meanMotion,
+                                    settings.integratorSettings.initialState,
+                                    epochs[ i ] - settings.integratorSettings.startTime ) );
+    }
+
+    return epochs.size( );
+}
+
+//! Execute relative motion.
+TrajectoryMetadata executeRelativeMotion( const SimulatorSettings& settings )
+{
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                          Relative motion                         " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    const double meanMotion
+        = computeMeanMotion( settings.centralGravitySettings.gravitationalParameter,
+                             settings.relativeMotionSettings.targetSemiMajorAxis );
+    logInfo( ) << "Mean motion of target                     " << meanMotion << " rad s^-1"
+               << std::endl;
+
+    TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "target_semi_major_axis", settings.relativeMotionSettings.targetSemiMajorAxis, "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "mean_motion", meanMotion, "rad s^-1" ) );
+
+    // Evaluate Clohessy-Wiltshire solution at output epochs and stream relative states to file.
+    logInfo( ) << "Propagating relative motion ..." << std::endl;
+    flushLog( );
+    std::size_t numberOfSamples = 0;
+    if ( settings.outputSettings.stateHistoryFormat == binaryStateHistoryFormat )
+    {
+        BinaryStateHistoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize );
+        numberOfSamples = propagateRelativeMotion( settings, stateHistoryWriter );
+        stateHistoryWriter.close( metadata );
+    }
+    else if ( settings.outputSettings.stateHistoryFormat == chebyshevStateHistoryFormat )
+    {
+        const ChebyshevTrajectorySettings& chebyshevSettings
+            = settings.outputSettings.chebyshevTrajectorySettings;
+        ChebyshevTrajectoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            chebyshevSettings.positionTolerance,
+            chebyshevSettings.velocityTolerance,
+            chebyshevSettings.numberOfCoefficients,
+            settings.outputSettings.stateHistoryChunkSize );
+        numberOfSamples = propagateRelativeMotion( settings, stateHistoryWriter );
+        stateHistoryWriter.flush( );
+        addChebyshevTrajectoryStatistics( stateHistoryWriter, metadata );
+        stateHistoryWriter.close( metadata );
+    }
+    else
+    {
+        CsvStateHistoryFileWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize,
+            "t,x,y,z,vx,vy,vz",
+            false );
+        numberOfSamples = propagateRelativeMotion( settings, stateHistoryWriter );
+        stateHistoryWriter.flush( );
+    }
+    logInfo( ) << "Propagated relative motion successfully!" << std::endl;
+    logInfo( ) << "State history (" << numberOfSamples << " samples) written to file successfully!"
+               << std::endl;
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                              Output                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    // Write simulation metadata to file.
+    logDebug( ) << "Writing simulation metadata to file ..." << std::endl;
+    std::ofstream metadataFile( settings.outputSettings.metadataFilename.c_str( ) );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        print( metadataFile, metadata[ i ].name, metadata[ i ].value, metadata[ i ].units );
+    }
+    metadataFile.close( );
+    logInfo( ) << "Simulation metadata written to file successfully!" << std::endl;
+
+    return metadata;
+}
+
+} // namespace scarab
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/eventManager.hpp"
+#include "Scarab/simulation.hpp"
+#include "Scarab/stateHistorySink.hpp"
+
+namespace scarab
+{
+
+//! Create data store, populated with the acceleration models set in the simulator settings.
+static DataStore createDataStore( const SimulatorSettings& settings )
+{
+    if ( settings.relativeMotionSettings.status
+         || settings.enckeSettings.status
+         || settings.checkpointSettings.status )
+    {
+        throw std::runtime_error(
+            "ERROR: Simulations do not support relative motion, Encke propagation or "
+            "checkpoints!" );
+    }
+
+    DataStore data( settings.integratorSettings.initialState,
+                    settings.integratorSettings.startTime,
+                    settings.centralGravitySettings.gravitationalParameter,
+                    ListOfAccelerationModels( ) );
+    generateAccelerationModelList( settings, data );
+
+    return data;
+}
+
+//! Construct simulation.
+Simulation::Simulation( const SimulatorSettings& aSettings )
+    : settings( aSettings ),
+      data( createDataStore( settings ) ),
+      stateDerivativeModel( data )
+{ }
+
+//! Run simulation.
+SimulationResult Simulation::run( )
+{
+    SimulationResult result;
+    run( settings.integratorSettings.initialState,
+         settings.integratorSettings.startTime,
+         settings.integratorSettings.endTime,
+         result );
+    return result;
+}
+
+//! Run simulation.
+void Simulation::run( const State& initialState,
+                      const double startTime,
+                      const double endTime,
+                      SimulationResult& result )
+{
+    const IntegratorSettings& nominalSettings = settings.integratorSettings;
+    const IntegratorSettings integratorSettings( initialState,
+                                                 startTime,
+                                                 endTime,
+                                                 nominalSettings.initialStep,
+                                                 nominalSettings.integrator,
+                                                 nominalSettings.absoluteTolerance,
+                                                 nominalSettings.relativeTolerance,
+                                                 nominalSettings.maximumStep );
+
+    data.currentState = initialState;
+    data.currentTime = startTime;
+
+    // The state history keeps its memory between runs; it is only reserved on the first run, or
+    // if the run covers a longer time interval than before.
+    result.stateHistory.clear( );
+    const double stepSize = settings.outputSettings.stateHistoryInterval > 0.0
+                            ? settings.outputSettings.stateHistoryInterval
+                            : nominalSettings.initialStep;
+    if ( settings.outputSettings.stateHistoryEpochs.empty( ) )
+    {
+        result.stateHistory.reserve(
+            StateHistory::estimateCapacity( startTime, endTime, stepSize ) );
+    }
+    else
+    {
+        result.stateHistory.reserve( settings.outputSettings.stateHistoryEpochs.size( ) + 1 );
+    }
+    StateHistoryRecorder stateHistoryRecorder( result.stateHistory );
+
+    // The event detector tracks the phase and event log of a single run, so it is created anew.
+    EventDetector eventDetector( settings.eventSettings );
+    EventDetector* const activeEventDetector
+        = settings.eventSettings.listOfEventDefinitions.empty( ) ? 0 : &eventDetector;
+
+    result.finalState = initialState;
+    result.statistics = integrateState( integratorSettings,
+                                        stateDerivativeModel,
+                                        result.finalState,
+                                        EventManager( stateHistoryRecorder ),
+                                        settings.outputSettings.stateHistoryInterval,
+                                        settings.outputSettings.stateHistoryEpochs,
+                                        activeEventDetector );
+    result.eventLog = eventDetector.getEventLog( );
+}
+
+} // namespace scarab
@@ -7,243 +7,2090 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
-#include <iostream>
 #include <limits>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
-#include <boost/numeric/odeint.hpp>
-#include <boost/progress.hpp>
+#include <boost/make_shared.hpp>
 
 #include "Scarab/accelerationModelId.hpp"
 #include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/accelerationModelRegistry.hpp"
 #include "Scarab/chaserSettings.hpp"
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/checkpoint.hpp"
 #include "Scarab/dataStore.hpp"
+#include "Scarab/doubleFormatting.hpp"
+#include "Scarab/dragModel.hpp"
+#include "Scarab/encke.hpp"
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/ensemble.hpp"
+#include "Scarab/eventDetector.hpp"
 #include "Scarab/eventManager.hpp"
+#include "Scarab/integrator.hpp"
 #include "Scarab/integratorSettings.hpp"
+#include "Scarab/interpolatedAccelerationModel.hpp"
+#include "Scarab/internalTools.hpp"
+#include "Scarab/logger.hpp"
 #include "Scarab/outputSettings.hpp"
 #include "Scarab/radiationPressureSettings.hpp"
+#include "Scarab/relativeMotion.hpp"
 #include "Scarab/simulator.hpp"
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
 #include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/sweep.hpp"
 #include "Scarab/targetSettings.hpp"
+#include "Scarab/trajectoryFile.hpp"
 #include "Scarab/tools.hpp"
 #include "Scarab/typedefs.hpp"
 
 namespace scarab
 {
 
+namespace
+{
+
+//! Default rotation rate of central body about z-axis, i.e., of the Earth [rad s^-1].
+const double defaultRotationRate = 7.292115e-5;
+
+//! Simulator checkpoint handler.
+/*!
+ * Integrator checkpoint handler that periodically, in wall-clock time, collects the state of the
+ * integrator, data store, event detector and state history sink in a checkpoint, and hands it to
+ * a background thread that writes it to file, so that the integration is not stalled by the file
+ * system.
+ */
+class SimulatorCheckpointHandler : public IntegratorCheckpointHandler
+{
+public:
+
+    //! Construct checkpoint handler.
+    /*!
+     * Constructs checkpoint handler; the first checkpoint is due one interval after construction.
+     *
+     * @param[in] settings          Checkpoint settings
+     * @param[in] aFingerprint      Fingerprint of simulator settings
+     * @param[in] someData          Data store
+     * @param[in] anEventDetector   Event detector (0 if no events are detected)
+     * @param[in] aStateHistorySink State history sink
+     */
+    SimulatorCheckpointHandler( const CheckpointSettings& settings,
+                                const boost::uint64_t aFingerprint,
+                                const DataStore& someData,
+                                const EventDetector* anEventDetector,
+                                StateHistorySink& aStateHistorySink )
+        : checkpointInterval( settings.checkpointInterval ),
+          fingerprint( aFingerprint ),
+          data( someData ),
+          eventDetector( anEventDetector ),
+          stateHistorySink( aStateHistorySink ),
+          writer( settings.checkpointFilename ),
+          lastCheckpointTime( std::chrono::steady_clock::now( ) )
+    { }
+
+    //! Check if checkpoint is due.
+    bool isCheckpointDue( )
+    {
+        const std::chrono::duration< double > elapsedTime
+            = std::chrono::steady_clock::now( ) - lastCheckpointTime;
+        return elapsedTime.count( ) >= checkpointInterval;
+    }
+
+    //! Write checkpoint.
+    void writeCheckpoint( const IntegratorCheckpoint& integratorCheckpoint )
+    {
+        Checkpoint checkpoint;
+        checkpoint.writeSize( fingerprint );
+        writeIntegratorCheckpoint( integratorCheckpoint, checkpoint );
+        checkpoint.writeState( data.currentState );
+        checkpoint.writeDouble( data.currentTime );
+        if ( eventDetector != 0 )
+        {
+            eventDetector->writeCheckpoint( checkpoint );
+        }
+        stateHistorySink.writeCheckpoint( checkpoint );
+
+        writer.submit( checkpoint );
+        lastCheckpointTime = std::chrono::steady_clock::now( );
+    }
+
+    //! Wait for last checkpoint to be written.
+    void wait( ) { writer.wait( ); }
+
+    //! Get number of checkpoints written.
+    std::size_t getNumberOfCheckpointsWritten( ) const
+    {
+        return writer.getNumberOfCheckpointsWritten( );
+    }
+
+protected:
+
+private:
+
+    //! Wall-clock time between checkpoints [s].
+    const double checkpointInterval;
+
+    //! Fingerprint of simulator settings.
+    const boost::uint64_t fingerprint;
+
+    //! Data store.
+    const DataStore& data;
+
+    //! Event detector (0 if no events are detected).
+    const EventDetector* eventDetector;
+
+    //! State history sink.
+    StateHistorySink& stateHistorySink;
+
+    //! Asynchronous checkpoint file writer.
+    AsyncCheckpointWriter writer;
+
+    //! Wall-clock time of last checkpoint.
+    std::chrono::steady_clock::time_point lastCheckpointTime;
+};
+
+} // namespace
+
+//! Integrate trajectory and pass state history to sink.
+/*!
+ * If checkpoints are on, checkpoints are written during integration and the trajectory is resumed
+ * from the checkpoint file, if requested. The checkpoint file is removed once the integration is
+ * completed.
+ */
+static IntegrationStatistics integrateTrajectory(
+    const SimulatorSettings& settings,
+    const StateDerivativeModel& stateDerivativeModel,
+    DataStore& data,
+    StateHistorySink& stateHistorySink,
+    EventDetector* eventDetector,
+    const bool isResumed )
+{
+    State state = settings.integratorSettings.initialState;
+    if ( !settings.checkpointSettings.status )
+    {
+        return integrateState( settings.integratorSettings,
+                               stateDerivativeModel,
+                               state,
+                               EventManager( stateHistorySink ),
+                               settings.outputSettings.stateHistoryInterval,
+                               settings.outputSettings.stateHistoryEpochs,
+                               eventDetector );
+    }
+
+    // Restore the simulation from the checkpoint, in the order in which it was written.
+    const boost::uint64_t fingerprint = getCheckpointFingerprint( settings );
+    IntegratorCheckpoint initialCheckpoint;
+    if ( isResumed )
+    {
+        Checkpoint checkpoint
+            = readCheckpointFile( settings.checkpointSettings.checkpointFilename );
+        if ( checkpoint.readSize( ) != fingerprint )
+        {
+            throw std::runtime_error( "ERROR: Checkpoint does not match simulator settings!" );
+        }
+        initialCheckpoint = readIntegratorCheckpoint( checkpoint );
+        data.currentState = checkpoint.readState( );
+        data.currentTime = checkpoint.readDouble( );
+        if ( eventDetector != 0 )
+        {
+            eventDetector->restoreCheckpoint( checkpoint );
+        }
+        stateHistorySink.restoreCheckpoint( checkpoint );
+        if ( !checkpoint.isAtEnd( ) )
+        {
+            throw std::runtime_error( "ERROR: Checkpoint does not match simulator settings!" );
+        }
+        logInfo( ) << "Resumed simulation from checkpoint at     " << initialCheckpoint.time
+                   << " s" << std::endl;
+    }
+
+    SimulatorCheckpointHandler checkpointHandler(
+        settings.checkpointSettings, fingerprint, data, eventDetector, stateHistorySink );
+    const IntegrationStatistics statistics
+        = integrateState( settings.integratorSettings,
+                          stateDerivativeModel,
+                          state,
+                          EventManager( stateHistorySink ),
+                          settings.outputSettings.stateHistoryInterval,
+                          settings.outputSettings.stateHistoryEpochs,
+                          eventDetector,
+                          &checkpointHandler,
+                          isResumed ? &initialCheckpoint : 0 );
+
+    // The checkpoint file is removed before the output is finalized, since a binary state history
+    // writer removes its spill files, from which a later resume would start.
+    checkpointHandler.wait( );
+    std::remove( settings.checkpointSettings.checkpointFilename.c_str( ) );
+    logInfo( ) << "Number of checkpoints written             "
+               << checkpointHandler.getNumberOfCheckpointsWritten( ) << std::endl;
+
+    return statistics;
+}
+
+//! Get interpolation statistics of gravity field, if it is interpolated.
+static bool getInterpolationStatistics( const DataStore& data,
+                                        InterpolationStatistics& statistics )
+{
+    const ListOfAccelerationModels::const_iterator iteratorModel
+        = data.listOfAccelerationModels.find( sphericalHarmonicsGravityModelId );
+    if ( iteratorModel == data.listOfAccelerationModels.end( ) )
+    {
+        return false;
+    }
+
+    const InterpolatedAccelerationModelPtr interpolatedModel
+        = boost::dynamic_pointer_cast< InterpolatedAccelerationModel >( iteratorModel->second );
+    if ( !interpolatedModel )
+    {
+        return false;
+    }
+
+    statistics = interpolatedModel->getStatistics( );
+    return true;
+}
+
+//! Add interpolation statistics of gravity field to simulation metadata, if it is interpolated.
+static void addInterpolationStatistics( const DataStore& data, TrajectoryMetadata& metadata )
+{
+    InterpolationStatistics statistics;
+    if ( !getInterpolationStatistics( data, statistics ) )
+    {
+        return;
+    }
+
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_interpolation_hits", static_cast< double >( statistics.numberOfHits ), "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_interpolation_misses",
+        static_cast< double >( statistics.numberOfMisses ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_interpolation_fallbacks",
+        static_cast< double >( statistics.numberOfFallbacks ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_interpolation_cells", static_cast< double >( statistics.numberOfCells ), "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_rejected_interpolation_cells",
+        static_cast< double >( statistics.numberOfRejectedCells ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "maximum_interpolation_error_estimate", statistics.maximumErrorEstimate, "km s^-2" ) );
+}
+
+//! Write run summary to summary file, if set in the output settings.
+static void writeRunSummaryFile( const SimulatorSettings& settings,
+                                 const std::string& mode,
+                                 const TrajectoryMetadata& metadata,
+                                 const EventLog& eventLog,
+                                 const std::chrono::steady_clock::time_point& startTime )
+{
+    if ( settings.outputSettings.summaryFilename.empty( ) )
+    {
+        return;
+    }
+
+    const double wallClockTime = std::chrono::duration< double >(
+        std::chrono::steady_clock::now( ) - startTime ).count( );
+
+    logDebug( ) << "Writing run summary to file ..." << std::endl;
+    std::ofstream summaryFile( settings.outputSettings.summaryFilename.c_str( ) );
+    writeRunSummary( summaryFile, mode, metadata, eventLog, wallClockTime );
+    summaryFile.close( );
+    logInfo( ) << "Run summary written to file successfully!" << std::endl;
+}
+
 //! Execute simulator.
-void executeSimulator( const rapidjson::Document& config )
+void executeSimulator( const rapidjson::Document& config, const bool isResumed )
 {
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+
     // Verify simulator settings. Exception is thrown if any of the parameters are missing.
     const SimulatorSettings settings = checkSimulatorSettings( config );
 
-    std::cout << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << "                             Simulator                            " << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << std::endl;
+    // Resume from checkpoint file, if requested and if a checkpoint has been written; otherwise,
+    // the simulation starts from the start time.
+    if ( isResumed && !settings.checkpointSettings.status )
+    {
+        throw std::runtime_error( "ERROR: Resuming a simulation requires checkpoints!" );
+    }
+    bool isCheckpointFound = false;
+    if ( isResumed )
+    {
+        std::ifstream checkpointFile( settings.checkpointSettings.checkpointFilename.c_str( ) );
+        isCheckpointFound = checkpointFile.good( );
+        if ( !isCheckpointFound )
+        {
+            logInfo( ) << "No checkpoint found, simulation starts from start time." << std::endl;
+        }
+    }
+
+    // Execute parameter sweep instead of single trajectory, if requested.
+    if ( settings.sweepSettings.status )
+    {
+        const TrajectoryMetadata metadata = executeSweep( settings );
+        writeRunSummaryFile( settings, "sweep", metadata, EventLog( ), startTime );
+        return;
+    }
+
+    // Execute Monte Carlo ensemble instead of single trajectory, if requested.
+    if ( settings.ensembleSettings.status )
+    {
+        const TrajectoryMetadata metadata = executeEnsemble( settings );
+        writeRunSummaryFile( settings, "ensemble", metadata, EventLog( ), startTime );
+        return;
+    }
+
+    // Propagate relative motion analytically instead of integrating trajectory, if requested.
+    if ( settings.relativeMotionSettings.status )
+    {
+        const TrajectoryMetadata metadata = executeRelativeMotion( settings );
+        writeRunSummaryFile( settings, "relative_motion", metadata, EventLog( ), startTime );
+        return;
+    }
+
+    // Integrate deviation of chaser from target instead of absolute trajectory, if requested.
+    if ( settings.enckeSettings.status )
+    {
+        const TrajectoryMetadata metadata = executeEncke( settings );
+        writeRunSummaryFile( settings, "encke", metadata, EventLog( ), startTime );
+        return;
+    }
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                             Simulator                            " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
 
     // Create data store with all simulation data.
-    std::cout << "Creating data store with simulation data ..." << std::endl;
+    logDebug( ) << "Creating data store with simulation data ..." << std::endl;
     // @TODO: Need to figure out a way to remove this line.
     ListOfAccelerationModels listOfAccelerationModels;
     DataStore data( settings.integratorSettings.initialState,
                     settings.integratorSettings.startTime,
                     settings.centralGravitySettings.gravitationalParameter,
                     listOfAccelerationModels );
-    std::cout << "Created data store successfully!" << std::endl;
+    logDebug( ) << "Created data store successfully!" << std::endl;
 
     // Create and populate list of models.
-    std::cout << "Creating and populating list of models ..." << std::endl;
-    generateAccelerationModelList( data );
-    std::cout << "Created limitsst of models successfully!" << std::endl;
+    logDebug( ) << "Creating and populating list of models ..." << std::endl;
+    generateAccelerationModelList( settings, data );
+    logDebug( ) << "Created list of models successfully!" << std::endl;
 
     // Create state derivative model.
-    std::cout << "Creating state derivative model ..." << std::endl;
+    logDebug( ) << "Creating state derivative model ..." << std::endl;
     StateDerivativeModel stateDerivativeModel( data );
-    std::cout << "Created state derivative model successfully!" << std::endl;
-
-    // Set up numerical integrator and execute integration.
-    std::cout << "Set up and execute numerical integrator ..." << std::endl;
-    State initialState = settings.integratorSettings.initialState; // @todo Fails to compile
-                                                                   // without this.
-    StateHistory stateHistory;
-    stateHistory[ settings.integratorSettings.startTime ] = initialState;
-    boost::progress_display showProgress( );
-    boost::numeric::odeint::integrate( stateDerivativeModel,
-                                       initialState,
-                                       settings.integratorSettings.startTime,
-                                       settings.integratorSettings.endTime,
-                                       settings.integratorSettings.initialStep,
-                                       EventManager( stateHistory ) );
-    std::cout << "Executed numerical integrator successfully!" << std::endl;
-
-    std::cout << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << "                              Output                              " << std::endl;
-    std::cout << "******************************************************************" << std::endl;
-    std::cout << std::endl;
+    logDebug( ) << "Created state derivative model successfully!" << std::endl;
+
+    // Set up numerical integrator and execute integration. The state history is streamed to file
+    // in chunks during integration, so that memory use does not grow with the duration of the
+    // simulation.
+    logInfo( ) << "Set up and execute numerical integrator ..." << std::endl;
+    flushLog( );
+    EventDetector eventDetector( settings.eventSettings );
+    EventDetector* const activeEventDetector
+        = settings.eventSettings.listOfEventDefinitions.empty( ) ? 0 : &eventDetector;
+    TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    IntegrationStatistics statistics;
+    std::size_t numberOfSamples = 0;
+    if ( settings.outputSettings.stateHistoryFormat == binaryStateHistoryFormat )
+    {
+        BinaryStateHistoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize,
+            isCheckpointFound );
+        statistics = integrateTrajectory( settings, stateDerivativeModel, data,
+                                          stateHistoryWriter, activeEventDetector,
+                                          isCheckpointFound );
+        addIntegrationStatistics( statistics, metadata );
+        addAccelerationModelTimings( stateDerivativeModel, metadata );
+        addInterpolationStatistics( data, metadata );
+        stateHistoryWriter.close( metadata );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+    }
+    else if ( settings.outputSettings.stateHistoryFormat == chebyshevStateHistoryFormat )
+    {
+        const ChebyshevTrajectorySettings& chebyshevSettings
+            = settings.outputSettings.chebyshevTrajectorySettings;
+        ChebyshevTrajectoryWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            chebyshevSettings.positionTolerance,
+            chebyshevSettings.velocityTolerance,
+            chebyshevSettings.numberOfCoefficients,
+            settings.outputSettings.stateHistoryChunkSize );
+        statistics = integrateTrajectory( settings, stateDerivativeModel, data,
+                                          stateHistoryWriter, activeEventDetector,
+                                          isCheckpointFound );
+        stateHistoryWriter.flush( );
+        addIntegrationStatistics( statistics, metadata );
+        addAccelerationModelTimings( stateDerivativeModel, metadata );
+        addInterpolationStatistics( data, metadata );
+        addChebyshevTrajectoryStatistics( stateHistoryWriter, metadata );
+        stateHistoryWriter.close( metadata );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+        logInfo( ) << "State history compressed into " << stateHistoryWriter.getNumberOfSegments( )
+                   << " Chebyshev segments" << std::endl;
+    }
+    else
+    {
+        // A resumed simulation truncates the output file to the position stored in the
+        // checkpoint, and continues writing from there.
+        CsvStateHistoryFileWriter stateHistoryWriter(
+            settings.outputSettings.stateHistoryFilename,
+            settings.outputSettings.stateHistoryChunkSize,
+            "t,x,y,z,vx,vy,vz",
+            isCheckpointFound );
+        statistics = integrateTrajectory( settings, stateDerivativeModel, data,
+                                          stateHistoryWriter, activeEventDetector,
+                                          isCheckpointFound );
+        addIntegrationStatistics( statistics, metadata );
+        addAccelerationModelTimings( stateDerivativeModel, metadata );
+        addInterpolationStatistics( data, metadata );
+        stateHistoryWriter.flush( );
+        numberOfSamples = stateHistoryWriter.getNumberOfSamples( );
+    }
+    logInfo( ) << "Executed numerical integrator successfully!" << std::endl;
+    logInfo( ) << "State history (" << numberOfSamples << " samples) written to file successfully!"
+               << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Number of function evaluations            "
+               << statistics.numberOfFunctionEvaluations << std::endl;
+    logInfo( ) << "Number of accepted steps                  "
+               << statistics.numberOfAcceptedSteps << std::endl;
+    logInfo( ) << "Number of rejected steps                  "
+               << statistics.numberOfRejectedSteps << std::endl;
+    logInfo( ) << "Minimum step size                         " << statistics.minimumStepSize
+               << " s" << std::endl;
+    logInfo( ) << "Maximum step size                         " << statistics.maximumStepSize
+               << " s" << std::endl;
+    logInfo( ) << "Final time                                " << statistics.finalTime << " s"
+               << std::endl;
+
+    InterpolationStatistics interpolationStatistics;
+    if ( getInterpolationStatistics( data, interpolationStatistics ) )
+    {
+        logInfo( ) << std::endl;
+        logInfo( ) << "Number of interpolation hits              "
+                   << interpolationStatistics.numberOfHits << std::endl;
+        logInfo( ) << "Number of interpolation misses            "
+                   << interpolationStatistics.numberOfMisses << std::endl;
+        logInfo( ) << "Number of interpolation fallbacks         "
+                   << interpolationStatistics.numberOfFallbacks << std::endl;
+        logInfo( ) << "Number of interpolation cells (rejected)  "
+                   << interpolationStatistics.numberOfCells << " ("
+                   << interpolationStatistics.numberOfRejectedCells << ")" << std::endl;
+        logInfo( ) << "Maximum interpolation error estimate      "
+                   << interpolationStatistics.maximumErrorEstimate << " km s^-2" << std::endl;
+    }
+
+    const EventLog& eventLog = eventDetector.getEventLog( );
+    if ( activeEventDetector != 0 )
+    {
+        logInfo( ) << std::endl;
+        logInfo( ) << "Events                                    " << eventLog.size( ) << std::endl;
+        for ( unsigned int i = 0; i < eventLog.size( ); i++ )
+        {
+            logInfo( ) << "                                          " << eventLog[ i ].name
+                       << " at " << eventLog[ i ].time << " s ("
+                       << getEventActionName( eventLog[ i ].action ) << ")" << std::endl;
+        }
+    }
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                              Output                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
 
     // Write simulation metadata to file.
-    std::cout << "Writing simulation metadata to file ..." << std::endl;
+    logDebug( ) << "Writing simulation metadata to file ..." << std::endl;
     std::ofstream metadataFile( settings.outputSettings.metadataFilename.c_str( ) );
-    print( metadataFile, "gravitational_parameter", data.gravitationalParameter, "km^3 s^-2" );
-    print( metadataFile, "initial_x",               initialState[ 0 ], "km" );
-    print( metadataFile, "initial_y",               initialState[ 1 ], "km" );
-    print( metadataFile, "initial_z",               initialState[ 2 ], "km" );
-    print( metadataFile, "initial_vx",              initialState[ 3 ], "km s^-1" );
-    print( metadataFile, "initial_vy",              initialState[ 4 ], "km s^-1" );
-    print( metadataFile, "initial_vz",              initialState[ 5 ], "km s^-1" );
-    print( metadataFile, "start_time",              settings.integratorSettings.startTime,   "s" );
-    print( metadataFile, "end_time",                settings.integratorSettings.endTime,     "s" );
-    print( metadataFile, "initial_step",            settings.integratorSettings.initialStep, "s" );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        print( metadataFile, metadata[ i ].name, metadata[ i ].value, metadata[ i ].units );
+    }
     metadataFile.close( );
-    std::cout << "Simulation metadata written to file successfully!" << std::endl;
+    logInfo( ) << "Simulation metadata written to file successfully!" << std::endl;
+
+    // Write event log to file.
+    if ( activeEventDetector != 0 && !settings.eventSettings.eventFilename.empty( ) )
+    {
+        logDebug( ) << "Writing event log to file ..." << std::endl;
+        std::ofstream eventFile( settings.eventSettings.eventFilename.c_str( ) );
+        writeEventLog( eventFile, eventLog );
+        eventFile.close( );
+        logInfo( ) << "Event log written to file successfully!" << std::endl;
+    }
+
+    writeRunSummaryFile( settings, "trajectory", metadata, eventLog, startTime );
+}
+
+//! Check event definition.
+static EventDefinition checkEventDefinition( const rapidjson::Value& event )
+{
+    const std::string name = event[ "name" ].GetString( );
+
+    const std::string typeName = event[ "type" ].GetString( );
+    EventType type = distanceEventType;
+    Position referencePoint;
+    referencePoint.fill( 0.0 );
+    unsigned int stateComponent = 0;
+    if ( typeName == "distance" )
+    {
+        if ( event.HasMember( "reference_point" ) )
+        {
+            for ( unsigned int i = 0; i < referencePoint.size( ); i++ )
+            {
+                referencePoint[ i ] = event[ "reference_point" ][ i ].GetDouble( );
+            }
+        }
+    }
+    else if ( typeName == "state_component" )
+    {
+        type = stateComponentEventType;
+        stateComponent = event[ "component" ].GetUint( );
+        if ( stateComponent > 5 )
+        {
+            throw std::runtime_error( "ERROR: State component of event \"" + name
+                                      + "\" must be in the range 0-5!" );
+        }
+    }
+    else
+    {
+        throw std::runtime_error( "ERROR: Event type \"" + typeName + "\" is not supported!" );
+    }
 
-    // Write simulation data to file.
-    std::cout << "Writing state history to file ..." << std::endl;
-    const std::string outputFileHeader = "t,x,y,z,vx,vy,vz";
-    std::ofstream outputFile( settings.outputSettings.stateHistoryFilename.c_str( ) );
-    print( outputFile, stateHistory, outputFileHeader );
-    outputFile.close( );
-    std::cout << "State history written to file successfully!" << std::endl;
+    const double threshold = event[ "threshold" ].GetDouble( );
+
+    EventDirection direction = anyEventDirection;
+    if ( event.HasMember( "direction" ) )
+    {
+        const std::string directionName = event[ "direction" ].GetString( );
+        if ( directionName == "rising" )
+        {
+            direction = risingEventDirection;
+        }
+        else if ( directionName == "falling" )
+        {
+            direction = fallingEventDirection;
+        }
+        else if ( directionName != "any" )
+        {
+            throw std::runtime_error( "ERROR: Event direction \"" + directionName
+                                      + "\" is not supported!" );
+        }
+    }
+
+    EventAction action = logEventAction;
+    std::string nextPhase = "";
+    if ( event.HasMember( "action" ) )
+    {
+        const std::string actionName = event[ "action" ].GetString( );
+        if ( actionName == "terminate" )
+        {
+            action = terminateEventAction;
+        }
+        else if ( actionName == "switch_phase" )
+        {
+            action = switchPhaseEventAction;
+            nextPhase = event[ "next_phase" ].GetString( );
+        }
+        else if ( actionName != "log" )
+        {
+            throw std::runtime_error( "ERROR: Event action \"" + actionName
+                                      + "\" is not supported!" );
+        }
+    }
+
+    std::string phase = "";
+    if ( event.HasMember( "phase" ) )
+    {
+        phase = event[ "phase" ].GetString( );
+    }
+
+    return EventDefinition( name,
+                            type,
+                            threshold,
+                            referencePoint,
+                            stateComponent,
+                            direction,
+                            action,
+                            phase,
+                            nextPhase );
+}
+
+//! Check sweep parameter definition.
+static SweepParameterDefinition checkSweepParameterDefinition( const rapidjson::Value& parameter,
+                                                               const SweepMethod method )
+{
+    const std::string name = parameter[ "name" ].GetString( );
+    const SweepParameter sweepParameter = getSweepParameter( name );
+
+    // Grid parameters are given as an explicit list of values, or as a number of equally spaced
+    // points between a minimum and a maximum, which is expanded here.
+    std::vector< double > values;
+    double minimum = std::numeric_limits< double >::signaling_NaN( );
+    double maximum = std::numeric_limits< double >::signaling_NaN( );
+    if ( method == gridSweepMethod && parameter.HasMember( "values" ) )
+    {
+        const rapidjson::Value& valueList = parameter[ "values" ];
+        for ( rapidjson::SizeType i = 0; i < valueList.Size( ); i++ )
+        {
+            values.push_back( valueList[ i ].GetDouble( ) );
+        }
+        if ( values.empty( ) )
+        {
+            throw std::runtime_error( "ERROR: List of values of sweep parameter \"" + name
+                                      + "\" must not be empty!" );
+        }
+    }
+    else
+    {
+        minimum = parameter[ "minimum" ].GetDouble( );
+        maximum = parameter[ "maximum" ].GetDouble( );
+        if ( !( maximum > minimum ) )
+        {
+            throw std::runtime_error( "ERROR: Maximum of sweep parameter \"" + name
+                                      + "\" must be greater than minimum!" );
+        }
+
+        if ( method == gridSweepMethod )
+        {
+            const unsigned int numberOfPoints = parameter[ "number_of_points" ].GetUint( );
+            if ( numberOfPoints < 2 )
+            {
+                throw std::runtime_error( "ERROR: Number of points of sweep parameter \"" + name
+                                          + "\" must be at least 2!" );
+            }
+            for ( unsigned int i = 0; i < numberOfPoints; i++ )
+            {
+                values.push_back( minimum + i * ( maximum - minimum ) / ( numberOfPoints - 1 ) );
+            }
+        }
+    }
+
+    return SweepParameterDefinition( sweepParameter, values, minimum, maximum );
 }
 
 //! Check simulator settings.
 SimulatorSettings checkSimulatorSettings( const rapidjson::Document& config )
 {
     // Search for and store numerical integrator settings.
-    std::cout << std::endl;
-    std::cout << "Numerical integration settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Numerical integration settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
 
     State initialState;
     for ( unsigned int i = 0; i < initialState.size( ); i++ )
     {
         initialState[ i ] = find( config, "initial_state" )->value[ i ].GetDouble( );
     }
-    std::cout << "Initial state                             [";
+    logInfo( ) << "Initial state                             [";
     for ( unsigned int i = 0; i < initialState.size( ) - 1; i++ )
     {
-        std::cout << initialState[ i ] << "; ";
+        logInfo( ) << initialState[ i ] << "; ";
     }
-    std::cout << initialState[ initialState.size( ) - 1 ] << "]" << std::endl;
+    logInfo( ) << initialState[ initialState.size( ) - 1 ] << "]" << std::endl;
 
     const double startTime      = find( config, "start_time" )->value.GetDouble( );
-    std::cout << "Start time                                " << startTime << " s" << std::endl;
+    logInfo( ) << "Start time                                " << startTime << " s" << std::endl;
     const double endTime        = find( config, "end_time" )->value.GetDouble( );
-    std::cout << "End time                                  " << endTime << " s" << std::endl;
+    logInfo( ) << "End time                                  " << endTime << " s" << std::endl;
     const double initialStep    = find( config, "initial_step" )->value.GetDouble( );
-    std::cout << "Initial step                              " << initialStep << " s" << std::endl;
+    logInfo( ) << "Initial step                              " << initialStep << " s" << std::endl;
+
+    // The integrator, tolerances and maximum step are optional. The defaults match the adaptive
+    // Dormand-Prince integrator used by boost::numeric::odeint::integrate( ).
+    std::string integratorName = "dopri5";
+    const ConfigIterator integratorIterator = config.FindMember( "integrator" );
+    if ( integratorIterator != config.MemberEnd( ) )
+    {
+        integratorName = integratorIterator->value.GetString( );
+    }
+    const IntegratorType integrator = getIntegratorType( integratorName );
+    logInfo( ) << "Integrator                                " << integratorName << std::endl;
+    double absoluteTolerance = 1.0e-6;
+    if ( config.HasMember( "absolute_tolerance" ) )
+    {
+        absoluteTolerance = config[ "absolute_tolerance" ].GetDouble( );
+    }
+    logInfo( ) << "Absolute tolerance                        " << absoluteTolerance << std::endl;
+    double relativeTolerance = 1.0e-6;
+    if ( config.HasMember( "relative_tolerance" ) )
+    {
+        relativeTolerance = config[ "relative_tolerance" ].GetDouble( );
+    }
+    logInfo( ) << "Relative tolerance                        " << relativeTolerance << std::endl;
+    double maximumStep = std::fabs( endTime - startTime );
+    if ( config.HasMember( "maximum_step" ) )
+    {
+        maximumStep = config[ "maximum_step" ].GetDouble( );
+    }
+    logInfo( ) << "Maximum step                              " << maximumStep << " s" << std::endl;
+    if ( !( initialStep > 0.0 ) || !( maximumStep > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Initial and maximum step must be positive!" );
+    }
+    if ( !( absoluteTolerance >= 0.0 ) || !( relativeTolerance >= 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Integrator tolerances must not be negative!" );
+    }
 
-    const IntegratorSettings integratorSettings( initialState, startTime, endTime, initialStep );
+    const IntegratorSettings integratorSettings( initialState,
+                                                 startTime,
+                                                 endTime,
+                                                 initialStep,
+                                                 integrator,
+                                                 absoluteTolerance,
+                                                 relativeTolerance,
+                                                 maximumStep );
 
     // Search for and store chaser settings.
-    std::cout << std::endl;
-    std::cout << "Chaser settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Chaser settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
     const double chaserMass     = find( config, "chaser" )->value[ "mass" ].GetDouble( );
-    std::cout << "Mass                                      " << chaserMass << " kg" << std::endl;
+    logInfo( ) << "Mass                                      " << chaserMass << " kg" << std::endl;
 
     const ChaserSettings chaserSettings( chaserMass );
 
     // Search for and store target properties.
-    std::cout << std::endl;
-    std::cout << "Target settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
-    const double targetMass     = find( config, "target" )->value[ "mass" ].GetDouble( );
-    std::cout << "Mass                                      " << targetMass << " kg" << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Target settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+    const ConfigIterator targetIterator = find( config, "target" );
+    const double targetMass     = targetIterator->value[ "mass" ].GetDouble( );
+    logInfo( ) << "Mass                                      " << targetMass << " kg" << std::endl;
+
+    // The initial state of the target is optional; it is only needed for Encke propagation.
+    State targetInitialState;
+    targetInitialState.fill( std::numeric_limits< double >::signaling_NaN( ) );
+    const bool isTargetInitialStateSet = targetIterator->value.HasMember( "initial_state" );
+    if ( isTargetInitialStateSet )
+    {
+        for ( unsigned int i = 0; i < targetInitialState.size( ); i++ )
+        {
+            targetInitialState[ i ] = targetIterator->value[ "initial_state" ][ i ].GetDouble( );
+        }
+        logInfo( ) << "Initial state                             [";
+        for ( unsigned int i = 0; i < targetInitialState.size( ) - 1; i++ )
+        {
+            logInfo( ) << targetInitialState[ i ] << "; ";
+        }
+        logInfo( ) << targetInitialState[ targetInitialState.size( ) - 1 ] << "]" << std::endl;
+    }
+
+    // The areas of the target are optional; they are only used by Encke propagation, in which the
+    // drag and radiation pressure models of the target are built with the target mass and areas.
+    // If not set, the areas of the chaser are used.
+    double targetDragArea = std::numeric_limits< double >::signaling_NaN( );
+    if ( targetIterator->value.HasMember( "drag_area" ) )
+    {
+        targetDragArea = targetIterator->value[ "drag_area" ].GetDouble( );
+        logInfo( ) << "Drag area                                 " << targetDragArea << " m^2"
+                   << std::endl;
+        if ( !( targetDragArea >= 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Target drag area must be non-negative!" );
+        }
+    }
+
+    double targetRadiationPressureArea = std::numeric_limits< double >::signaling_NaN( );
+    if ( targetIterator->value.HasMember( "radiation_pressure_area" ) )
+    {
+        targetRadiationPressureArea
+            = targetIterator->value[ "radiation_pressure_area" ].GetDouble( );
+        logInfo( ) << "Radiation pressure area                   " << targetRadiationPressureArea
+                   << " m^2" << std::endl;
+        if ( !( targetRadiationPressureArea >= 0.0 ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Target radiation pressure area must be non-negative!" );
+        }
+    }
+
+    const TargetSettings targetSettings( targetMass,
+                                         targetDragArea,
+                                         targetRadiationPressureArea,
+                                         targetInitialState );
 
-    const TargetSettings targetSettings( targetMass );
+    // Search for and store list of acceleration models. An error is thrown if a model is not
+    // available in the acceleration model registry.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Acceleration models" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    ListOfModelNames listOfModelNames;
+    const ConfigIterator modelsIterator = find( config, "models" );
+    for ( rapidjson::SizeType i = 0; i < modelsIterator->value.Size( ); i++ )
+    {
+        const std::string modelName = modelsIterator->value[ i ].GetString( );
+        findAccelerationModel( modelName );
+        listOfModelNames.push_back( modelName );
+        logInfo( ) << "                                          " << modelName << std::endl;
+    }
 
     // Search for and store central gravity model settings.
-    std::cout << std::endl;
-    std::cout << "Central gravity settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Central gravity settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
 
-    std::cout << "Status                                    ON" << std::endl;
+    const bool centralGravityStatus
+        = std::find( listOfModelNames.begin( ), listOfModelNames.end( ), "central_gravity" )
+          != listOfModelNames.end( );
+    logInfo( ) << "Status                                    "
+               << ( centralGravityStatus ? "ON" : "OFF" ) << std::endl;
     const double gravitationalParameter
         = find( config, "gravitational_parameter" )->value.GetDouble( );
-    std::cout << "Gravitational parameter                   "
-              << gravitationalParameter << " km^3 s^-2" << std::endl;
+    logInfo( ) << "Gravitational parameter                   "
+               << gravitationalParameter << " km^3 s^-2" << std::endl;
+
+    const CentralGravitySettings centralGravitySettings( centralGravityStatus,
+                                                         gravitationalParameter );
+
+    // Search for and store ephemeris settings. The ephemeris block is optional; if it is missing,
+    // or the ephemeris file is empty, no ephemeris is available to the acceleration models. The
+    // ephemeris file is mapped once here and shared by all models, also for ensembles.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Ephemeris settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator ephemerisIterator = config.FindMember( "ephemeris" );
+    std::string ephemerisFilename = "";
+    ChebyshevEphemerisPtr ephemeris;
+    if ( ephemerisIterator != config.MemberEnd( ) )
+    {
+        ephemerisFilename = ephemerisIterator->value[ "file" ].GetString( );
+    }
+    if ( !ephemerisFilename.empty( ) )
+    {
+        ephemeris = boost::make_shared< ChebyshevEphemeris >( ephemerisFilename );
+    }
+    logInfo( ) << "Ephemeris file                            "
+               << ( ephemerisFilename.empty( ) ? "(none)" : ephemerisFilename ) << std::endl;
+    if ( ephemeris )
+    {
+        for ( std::size_t i = 0; i < ephemeris->getNumberOfBodies( ); i++ )
+        {
+            const EphemerisBody& body = ephemeris->getBody( i );
+            logInfo( ) << "Body                                      " << body.name << " ["
+                       << body.startTime << "; " << body.getEndTime( ) << "] s" << std::endl;
+        }
+    }
 
-    const CentralGravitySettings centralGravitySettings( true, gravitationalParameter );
+    const EphemerisSettings ephemerisSettings( ephemerisFilename, ephemeris );
 
     // Search for and store radiation pressure model settings.
-    std::cout << std::endl;
-    std::cout << "Radiation pressure settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
+    logInfo( ) << std::endl;
+    logInfo( ) << "Radiation pressure settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
 
     ConfigIterator radiationPressureIterator = find( config, "radiation_pressure" );
     const bool radiationPressureStatus   = radiationPressureIterator->value[ "status" ].GetBool( );
     double  radiationPressure            = std::numeric_limits< double >::signaling_NaN( );
     double  radiationPressureCoefficient = std::numeric_limits< double >::signaling_NaN( );
     double  radiationPressureArea        = std::numeric_limits< double >::signaling_NaN( );
+    ShadowModel shadowModel              = conicalShadowModel;
+    double  centralBodyRadius            = 6378.1363;
+    double  sourceRadius                 = 695700.0;
+    std::string sourceBodyName           = "";
     Position vectorToSource;
     vectorToSource[ 0 ] = std::numeric_limits< double >::signaling_NaN( );
     vectorToSource[ 1 ] = std::numeric_limits< double >::signaling_NaN( );
     vectorToSource[ 2 ] = std::numeric_limits< double >::signaling_NaN( );
 
-    std::cout << "Status                                    ";
+    logInfo( ) << "Status                                    ";
     if ( radiationPressureStatus == true )
     {
-        std::cout << "ON" << std::endl;
+        logInfo( ) << "ON" << std::endl;
         radiationPressure = radiationPressureIterator->value[ "radiation_pressure" ].GetDouble( );
-        std::cout << "Radiation pressure                        "
-                  << radiationPressure << " N m^-2" << std::endl;
+        logInfo( ) << "Radiation pressure                        "
+                   << radiationPressure << " N m^-2" << std::endl;
         radiationPressureCoefficient
             = radiationPressureIterator->value[ "radiation_pressure_coefficient" ].GetDouble( );
-        std::cout << "Radiation pressure coefficient            "
-                  << radiationPressureCoefficient << std::endl;
+        logInfo( ) << "Radiation pressure coefficient            "
+                   << radiationPressureCoefficient << std::endl;
         radiationPressureArea
             = radiationPressureIterator->value[ "radiation_pressure_area" ].GetDouble( );
-        std::cout << "Radiation pressure area                   "
-                  << radiationPressureArea << " m^2" << std::endl;
+        logInfo( ) << "Radiation pressure area                   "
+                   << radiationPressureArea << " m^2" << std::endl;
+
+        // The position of the source is taken from the ephemeris if a source body is set, and is
+        // fixed otherwise. An empty source body is the same as none.
+        if ( radiationPressureIterator->value.HasMember( "source_body" ) )
+        {
+            sourceBodyName = radiationPressureIterator->value[ "source_body" ].GetString( );
+        }
+        if ( !sourceBodyName.empty( ) )
+        {
+            if ( !ephemeris )
+            {
+                throw std::runtime_error(
+                    "ERROR: Source body of radiation pressure requires an ephemeris file!" );
+            }
+            ephemeris->findBody( sourceBodyName );
+            logInfo( ) << "Source body                               "
+                       << sourceBodyName << std::endl;
+        }
+        else
+        {
+            for ( unsigned int i = 0; i < vectorToSource.size( ); i++ )
+            {
+                vectorToSource[ i ]
+                    = radiationPressureIterator->value[ "vector_to_source" ][ i ].GetDouble( );
+            }
+            logInfo( ) << "Vector to source                          [";
+            for ( unsigned int i = 0; i < vectorToSource.size( ) - 1; i++ )
+            {
+                logInfo( ) << vectorToSource[ i ] << "; ";
+            }
+            logInfo( ) << vectorToSource[ vectorToSource.size( ) - 1 ] << "] m" << std::endl;
+        }
 
-        for ( unsigned int i = 0; i < vectorToSource.size( ); i++ )
+        if ( radiationPressureIterator->value.HasMember( "shadow_model" ) )
+        {
+            const std::string shadowModelName
+                = radiationPressureIterator->value[ "shadow_model" ].GetString( );
+            if ( shadowModelName == "none" )
+            {
+                shadowModel = noShadowModel;
+            }
+            else if ( shadowModelName == "cylindrical" )
+            {
+                shadowModel = cylindricalShadowModel;
+            }
+            else if ( !shadowModelName.empty( ) && shadowModelName != "conical" )
+            {
+                throw std::runtime_error( "ERROR: Shadow model \"" + shadowModelName
+                                          + "\" is not supported!" );
+            }
+        }
+        logInfo( ) << "Shadow model                              "
+                   << ( shadowModel == noShadowModel ? "none"
+                       : ( shadowModel == cylindricalShadowModel ? "cylindrical" : "conical" ) )
+                  << std::endl;
+        if ( radiationPressureIterator->value.HasMember( "central_body_radius" ) )
+        {
+            centralBodyRadius
+                = radiationPressureIterator->value[ "central_body_radius" ].GetDouble( );
+        }
+        logInfo( ) << "Central body radius                       "
+                   << centralBodyRadius << " km" << std::endl;
+        if ( radiationPressureIterator->value.HasMember( "source_radius" ) )
         {
-            vectorToSource[ i ]
-                = radiationPressureIterator->value[ "vector_to_source" ][ i ].GetDouble( );
+            sourceRadius = radiationPressureIterator->value[ "source_radius" ].GetDouble( );
         }
-        std::cout << "Vector to source                          [";
-        for ( unsigned int i = 0; i < vectorToSource.size( ) - 1; i++ )
+        logInfo( ) << "Source radius                             "
+                   << sourceRadius << " km" << std::endl;
+
+        // The radiation pressure model is added to the list of acceleration models if it is not
+        // listed already.
+        if ( std::find( listOfModelNames.begin( ), listOfModelNames.end( ), "radiation_pressure" )
+             == listOfModelNames.end( ) )
         {
-            std::cout << vectorToSource[ i ] << "; ";
+            listOfModelNames.push_back( "radiation_pressure" );
         }
-        std::cout << vectorToSource[ vectorToSource.size( ) - 1 ] << "]" << std::endl;
     }
     else
     {
-        std::cout << "OFF" << std::endl;
+        logInfo( ) << "OFF" << std::endl;
+
+        if ( std::find( listOfModelNames.begin( ), listOfModelNames.end( ), "radiation_pressure" )
+             != listOfModelNames.end( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Radiation pressure model is listed, but its status is off!" );
+        }
     }
 
     const RadiationPressureSettings radiationPressureSettings( radiationPressureStatus,
                                                                radiationPressure,
                                                                radiationPressureCoefficient,
                                                                vectorToSource,
-                                                               radiationPressureArea );
+                                                               radiationPressureArea,
+                                                               shadowModel,
+                                                               centralBodyRadius,
+                                                               sourceRadius,
+                                                               sourceBodyName );
 
-    // Search for and store output file names.
-    std::cout << std::endl;
-    std::cout << "Output settings" << std::endl;
-    std::cout << "------------------------------------------" << std::endl;
+    // Search for and store spherical harmonics gravity model settings. The spherical harmonics
+    // block is optional; if it is missing, the model is off.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Spherical harmonics settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
 
-    ConfigIterator outputIterator = find( config, "output" );
-    const std::string metadataFilename = outputIterator->value[ "metadata_file" ].GetString( );
-    std::cout << "Simulation metadata file                  " << metadataFilename << std::endl;
-    const std::string stateHistoryFilename
-        = outputIterator->value[ "state_history_file" ].GetString( );
-    std::cout << "State history file                        " << stateHistoryFilename << std::endl;
+    const ConfigIterator sphericalHarmonicsIterator = config.FindMember( "spherical_harmonics" );
+    bool sphericalHarmonicsStatus = false;
+    if ( sphericalHarmonicsIterator != config.MemberEnd( ) )
+    {
+        sphericalHarmonicsStatus = sphericalHarmonicsIterator->value[ "status" ].GetBool( );
+    }
+    std::string coefficientFilename = "";
+    SphericalHarmonicsCoefficients coefficients( 0, 0 );
+    double referenceRadius = 6378.1363;
+    double rotationRate = defaultRotationRate;
+    bool interpolationStatus = false;
+    double interpolationCellSize = 0.0;
+    double interpolationTolerance = 0.0;
+    std::size_t maximumNumberOfCells = 10000;
+
+    logInfo( ) << "Status                                    ";
+    if ( sphericalHarmonicsStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        coefficientFilename
+            = sphericalHarmonicsIterator->value[ "coefficient_file" ].GetString( );
+        logInfo( ) << "Coefficient file                          "
+                   << coefficientFilename << std::endl;
+        const unsigned int degree = sphericalHarmonicsIterator->value[ "degree" ].GetUint( );
+        logInfo( ) << "Degree                                    " << degree << std::endl;
+        unsigned int order = degree;
+        if ( sphericalHarmonicsIterator->value.HasMember( "order" ) )
+        {
+            order = sphericalHarmonicsIterator->value[ "order" ].GetUint( );
+        }
+        logInfo( ) << "Order                                     " << order << std::endl;
+        if ( sphericalHarmonicsIterator->value.HasMember( "reference_radius" ) )
+        {
+            referenceRadius = sphericalHarmonicsIterator->value[ "reference_radius" ].GetDouble( );
+        }
+        logInfo( ) << "Reference radius                          "
+                   << referenceRadius << " km" << std::endl;
+        if ( sphericalHarmonicsIterator->value.HasMember( "rotation_rate" ) )
+        {
+            rotationRate = sphericalHarmonicsIterator->value[ "rotation_rate" ].GetDouble( );
+        }
+        logInfo( ) << "Rotation rate                             "
+                   << rotationRate << " rad s^-1" << std::endl;
+        if ( !( referenceRadius > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Reference radius must be positive!" );
+        }
+
+        // The interpolation grid is optional; if it is missing, the model is evaluated directly.
+        const ConfigIterator interpolationIterator
+            = sphericalHarmonicsIterator->value.FindMember( "interpolation" );
+        if ( interpolationIterator != sphericalHarmonicsIterator->value.MemberEnd( ) )
+        {
+            interpolationStatus = interpolationIterator->value[ "status" ].GetBool( );
+        }
+        logInfo( ) << "Interpolation                             "
+                   << ( interpolationStatus ? "ON" : "OFF" ) << std::endl;
+        if ( interpolationStatus == true )
+        {
+            interpolationCellSize = interpolationIterator->value[ "cell_size" ].GetDouble( );
+            logInfo( ) << "Interpolation cell size                   "
+                       << interpolationCellSize << " km" << std::endl;
+            interpolationTolerance = interpolationIterator->value[ "tolerance" ].GetDouble( );
+            logInfo( ) << "Interpolation tolerance                   "
+                       << interpolationTolerance << " km s^-2" << std::endl;
+            if ( interpolationIterator->value.HasMember( "maximum_number_of_cells" ) )
+            {
+                maximumNumberOfCells
+                    = interpolationIterator->value[ "maximum_number_of_cells" ].GetUint( );
+            }
+            logInfo( ) << "Maximum number of interpolation cells     "
+                       << maximumNumberOfCells << std::endl;
+            if ( !( interpolationCellSize > 0.0 ) || !( interpolationTolerance > 0.0 ) )
+            {
+                throw std::runtime_error(
+                    "ERROR: Interpolation cell size and tolerance must be positive!" );
+            }
+        }
 
-    const OutputSettings outputSettings( metadataFilename, stateHistoryFilename );
+        coefficients = readSphericalHarmonicsCoefficients( coefficientFilename, degree, order );
 
-    return SimulatorSettings( integratorSettings,
-                              chaserSettings,
-                              targetSettings,
-                              centralGravitySettings,
-                              radiationPressureSettings,
-                              outputSettings );
+        // The spherical harmonics gravity model is added to the list of acceleration models if it
+        // is not listed already.
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "spherical_harmonics_gravity" ) == listOfModelNames.end( ) )
+        {
+            listOfModelNames.push_back( "spherical_harmonics_gravity" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "spherical_harmonics_gravity" ) != listOfModelNames.end( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Spherical harmonics gravity model is listed, but its status is off!" );
+        }
+    }
+
+    const GravityInterpolationSettings interpolationSettings( interpolationStatus,
+                                                              interpolationCellSize,
+                                                              interpolationTolerance,
+                                                              maximumNumberOfCells );
+    const SphericalHarmonicsSettings sphericalHarmonicsSettings( sphericalHarmonicsStatus,
+                                                                 coefficientFilename,
+                                                                 coefficients,
+                                                                 referenceRadius,
+                                                                 rotationRate,
+                                                                 interpolationSettings );
+
+    // Search for and store drag model settings. The drag block is optional; if it is missing, the
+    // model is off.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Drag settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator dragIterator = config.FindMember( "drag" );
+    bool dragStatus = false;
+    if ( dragIterator != config.MemberEnd( ) )
+    {
+        dragStatus = dragIterator->value[ "status" ].GetBool( );
+    }
+    double dragCoefficient = std::numeric_limits< double >::signaling_NaN( );
+    double dragArea = std::numeric_limits< double >::signaling_NaN( );
+    std::string densityFilename = "";
+    AtmosphereTable atmosphereTable;
+    double dragCentralBodyRadius = 6378.1363;
+    double dragRotationRate = defaultRotationRate;
+
+    logInfo( ) << "Status                                    ";
+    if ( dragStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        dragCoefficient = dragIterator->value[ "drag_coefficient" ].GetDouble( );
+        logInfo( ) << "Drag coefficient                          " << dragCoefficient << std::endl;
+        dragArea = dragIterator->value[ "drag_area" ].GetDouble( );
+        logInfo( ) << "Drag area                                 "
+                   << dragArea << " m^2" << std::endl;
+        if ( dragIterator->value.HasMember( "density_file" ) )
+        {
+            densityFilename = dragIterator->value[ "density_file" ].GetString( );
+        }
+        logInfo( ) << "Density file                              "
+                   << ( densityFilename.empty( ) ? "(exponential atmosphere)" : densityFilename )
+                   << std::endl;
+        if ( dragIterator->value.HasMember( "central_body_radius" ) )
+        {
+            dragCentralBodyRadius = dragIterator->value[ "central_body_radius" ].GetDouble( );
+        }
+        logInfo( ) << "Central body radius                       "
+                   << dragCentralBodyRadius << " km" << std::endl;
+        if ( dragIterator->value.HasMember( "rotation_rate" ) )
+        {
+            dragRotationRate = dragIterator->value[ "rotation_rate" ].GetDouble( );
+        }
+        logInfo( ) << "Rotation rate                             "
+                   << dragRotationRate << " rad s^-1" << std::endl;
+
+        atmosphereTable = densityFilename.empty( ) ? getExponentialAtmosphereTable( )
+                                                   : readAtmosphereTable( densityFilename );
+
+        // The drag model is added to the list of acceleration models if it is not listed already.
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "atmospheric_drag" ) == listOfModelNames.end( ) )
+        {
+            listOfModelNames.push_back( "atmospheric_drag" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "atmospheric_drag" ) != listOfModelNames.end( ) )
+        {
+            throw std::runtime_error( "ERROR: Drag model is listed, but its status is off!" );
+        }
+    }
+
+    const DragSettings dragSettings( dragStatus,
+                                     dragCoefficient,
+                                     dragArea,
+                                     densityFilename,
+                                     atmosphereTable,
+                                     dragCentralBodyRadius,
+                                     dragRotationRate );
+
+    // Search for and store third-body gravity model settings. The third-body block is optional;
+    // if it is missing, the model is off.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Third-body gravity settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator thirdBodyIterator = config.FindMember( "third_body_gravity" );
+    bool thirdBodyStatus = false;
+    if ( thirdBodyIterator != config.MemberEnd( ) )
+    {
+        thirdBodyStatus = thirdBodyIterator->value[ "status" ].GetBool( );
+    }
+    std::vector< std::string > thirdBodyNames;
+
+    logInfo( ) << "Status                                    ";
+    if ( thirdBodyStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        if ( !ephemeris )
+        {
+            throw std::runtime_error(
+                "ERROR: Third-body gravity model requires an ephemeris file!" );
+        }
+
+        const rapidjson::Value& bodies = thirdBodyIterator->value[ "bodies" ];
+        for ( rapidjson::SizeType i = 0; i < bodies.Size( ); i++ )
+        {
+            const std::string bodyName = bodies[ i ].GetString( );
+            const EphemerisBody& body = ephemeris->getBody( ephemeris->findBody( bodyName ) );
+            thirdBodyNames.push_back( bodyName );
+            logInfo( ) << "Body                                      " << bodyName << " ("
+                       << body.gravitationalParameter << " km^3 s^-2)" << std::endl;
+        }
+
+        // The third-body gravity model is added to the list of acceleration models if it is not
+        // listed already.
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "third_body_gravity" ) == listOfModelNames.end( ) )
+        {
+            listOfModelNames.push_back( "third_body_gravity" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+
+        if ( std::find( listOfModelNames.begin( ),
+                        listOfModelNames.end( ),
+                        "third_body_gravity" ) != listOfModelNames.end( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Third-body gravity model is listed, but its status is off!" );
+        }
+    }
+
+    const ThirdBodySettings thirdBodySettings( thirdBodyStatus, thirdBodyNames );
+
+    // Search for and store output file names.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Output settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    ConfigIterator outputIterator = find( config, "output" );
+    const std::string metadataFilename = outputIterator->value[ "metadata_file" ].GetString( );
+    logInfo( ) << "Simulation metadata file                  " << metadataFilename << std::endl;
+    const std::string stateHistoryFilename
+        = outputIterator->value[ "state_history_file" ].GetString( );
+    logInfo( ) << "State history file                        " << stateHistoryFilename << std::endl;
+    std::size_t stateHistoryChunkSize = 1024;
+    if ( outputIterator->value.HasMember( "state_history_chunk_size" ) )
+    {
+        stateHistoryChunkSize = outputIterator->value[ "state_history_chunk_size" ].GetUint( );
+    }
+    if ( stateHistoryChunkSize == 0 )
+    {
+        throw std::runtime_error( "ERROR: State history chunk size must be positive!" );
+    }
+    logInfo( ) << "State history chunk size                  " << stateHistoryChunkSize
+               << " samples" << std::endl;
+    StateHistoryFormat stateHistoryFormat = csvStateHistoryFormat;
+    std::string stateHistoryFormatName = "csv";
+    if ( outputIterator->value.HasMember( "format" ) )
+    {
+        stateHistoryFormatName = outputIterator->value[ "format" ].GetString( );
+    }
+    if ( stateHistoryFormatName == "binary" )
+    {
+        stateHistoryFormat = binaryStateHistoryFormat;
+    }
+    else if ( stateHistoryFormatName == "chebyshev" )
+    {
+        stateHistoryFormat = chebyshevStateHistoryFormat;
+    }
+    else if ( stateHistoryFormatName != "csv" )
+    {
+        throw std::runtime_error( "ERROR: State history format \"" + stateHistoryFormatName
+                                  + "\" is not supported!" );
+    }
+    logInfo( ) << "State history format                      " << stateHistoryFormatName
+               << std::endl;
+
+    // The tolerances of the Chebyshev fit are only required if the state history is compressed.
+    double chebyshevPositionTolerance = 0.0;
+    double chebyshevVelocityTolerance = 0.0;
+    std::size_t chebyshevNumberOfCoefficients = 12;
+    if ( stateHistoryFormat == chebyshevStateHistoryFormat )
+    {
+        chebyshevPositionTolerance
+            = outputIterator->value[ "chebyshev_position_tolerance" ].GetDouble( );
+        if ( !( chebyshevPositionTolerance > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Chebyshev position tolerance must be positive!" );
+        }
+        logInfo( ) << "Chebyshev position tolerance              " << chebyshevPositionTolerance
+                   << " km" << std::endl;
+
+        chebyshevVelocityTolerance = 1.0e-3 * chebyshevPositionTolerance;
+        if ( outputIterator->value.HasMember( "chebyshev_velocity_tolerance" ) )
+        {
+            chebyshevVelocityTolerance
+                = outputIterator->value[ "chebyshev_velocity_tolerance" ].GetDouble( );
+        }
+        if ( !( chebyshevVelocityTolerance > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Chebyshev velocity tolerance must be positive!" );
+        }
+        logInfo( ) << "Chebyshev velocity tolerance              " << chebyshevVelocityTolerance
+                   << " km s^-1" << std::endl;
+
+        if ( outputIterator->value.HasMember( "chebyshev_number_of_coefficients" ) )
+        {
+            chebyshevNumberOfCoefficients
+                = outputIterator->value[ "chebyshev_number_of_coefficients" ].GetUint( );
+        }
+        if ( chebyshevNumberOfCoefficients < 2
+             || chebyshevNumberOfCoefficients > maximumNumberOfChebyshevCoefficients )
+        {
+            std::ostringstream error;
+            error << "ERROR: Number of Chebyshev coefficients must be in the range 2-"
+                  << maximumNumberOfChebyshevCoefficients << "!";
+            throw std::runtime_error( error.str( ) );
+        }
+        logInfo( ) << "Chebyshev number of coefficients          " << chebyshevNumberOfCoefficients
+                   << std::endl;
+    }
+
+    // The state history is sampled at every integration step, unless a time interval or a list of
+    // epochs is set, in which case the states are interpolated within the integration steps.
+    double stateHistoryInterval = 0.0;
+    if ( outputIterator->value.HasMember( "state_history_interval" ) )
+    {
+        stateHistoryInterval = outputIterator->value[ "state_history_interval" ].GetDouble( );
+        if ( !( stateHistoryInterval > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: State history interval must be positive!" );
+        }
+    }
+    std::vector< double > stateHistoryEpochs;
+    if ( outputIterator->value.HasMember( "state_history_epochs" ) )
+    {
+        const rapidjson::Value& epochs = outputIterator->value[ "state_history_epochs" ];
+        for ( rapidjson::SizeType i = 0; i < epochs.Size( ); i++ )
+        {
+            stateHistoryEpochs.push_back( epochs[ i ].GetDouble( ) );
+            if ( i > 0 && !( stateHistoryEpochs[ i ] > stateHistoryEpochs[ i - 1 ] ) )
+            {
+                throw std::runtime_error(
+                    "ERROR: State history epochs must be in strictly ascending order!" );
+            }
+        }
+        if ( stateHistoryEpochs.empty( ) )
+        {
+            throw std::runtime_error( "ERROR: List of state history epochs must not be empty!" );
+        }
+    }
+    if ( stateHistoryInterval > 0.0 && !stateHistoryEpochs.empty( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: State history interval and epochs cannot be set at the same time!" );
+    }
+    logInfo( ) << "State history sampling                    ";
+    if ( stateHistoryInterval > 0.0 )
+    {
+        logInfo( ) << "every " << stateHistoryInterval << " s" << std::endl;
+    }
+    else if ( !stateHistoryEpochs.empty( ) )
+    {
+        logInfo( ) << stateHistoryEpochs.size( ) << " epochs" << std::endl;
+    }
+    else
+    {
+        logInfo( ) << "every step" << std::endl;
+    }
+
+    // The JSON run summary is optional; it is intended for programs that run the simulator and
+    // parse its results, e.g., with the log level set to quiet.
+    std::string summaryFilename = "";
+    if ( outputIterator->value.HasMember( "summary_file" ) )
+    {
+        summaryFilename = outputIterator->value[ "summary_file" ].GetString( );
+        logInfo( ) << "Run summary file                          " << summaryFilename
+                   << std::endl;
+    }
+
+    const OutputSettings outputSettings( metadataFilename,
+                                         stateHistoryFilename,
+                                         stateHistoryChunkSize,
+                                         stateHistoryFormat,
+                                         stateHistoryInterval,
+                                         stateHistoryEpochs,
+                                         ChebyshevTrajectorySettings(
+                                             chebyshevPositionTolerance,
+                                             chebyshevVelocityTolerance,
+                                             chebyshevNumberOfCoefficients ),
+                                         summaryFilename );
+
+    // Search for and store ensemble settings. The ensemble block is optional; if it is missing,
+    // a single trajectory is simulated.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Ensemble settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator ensembleIterator = config.FindMember( "ensemble" );
+    bool ensembleStatus = false;
+    if ( ensembleIterator != config.MemberEnd( ) )
+    {
+        ensembleStatus = ensembleIterator->value[ "status" ].GetBool( );
+    }
+    unsigned int numberOfSamples = 0;
+    unsigned int numberOfThreads = 0;
+    unsigned int seed = 0;
+    State initialStateDispersion;
+    initialStateDispersion.fill( 0.0 );
+    std::string ensembleFilename = "";
+
+    logInfo( ) << "Status                                    ";
+    if ( ensembleStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        numberOfSamples = ensembleIterator->value[ "number_of_samples" ].GetUint( );
+        logInfo( ) << "Number of samples                         " << numberOfSamples << std::endl;
+        numberOfThreads = ensembleIterator->value[ "number_of_threads" ].GetUint( );
+        logInfo( ) << "Number of threads                         " << numberOfThreads << std::endl;
+        seed = ensembleIterator->value[ "seed" ].GetUint( );
+        logInfo( ) << "Seed                                      " << seed << std::endl;
+
+        for ( unsigned int i = 0; i < initialStateDispersion.size( ); i++ )
+        {
+            initialStateDispersion[ i ]
+                = ensembleIterator->value[ "initial_state_dispersion" ][ i ].GetDouble( );
+        }
+        logInfo( ) << "Initial state dispersion                  [";
+        for ( unsigned int i = 0; i < initialStateDispersion.size( ) - 1; i++ )
+        {
+            logInfo( ) << initialStateDispersion[ i ] << "; ";
+        }
+        logInfo( ) << initialStateDispersion[ initialStateDispersion.size( ) - 1 ] << "]"
+                   << std::endl;
+
+        ensembleFilename = ensembleIterator->value[ "ensemble_file" ].GetString( );
+        logInfo( ) << "Ensemble file                             " << ensembleFilename << std::endl;
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+    }
+
+    const EnsembleSettings ensembleSettings( ensembleStatus,
+                                             numberOfSamples,
+                                             numberOfThreads,
+                                             seed,
+                                             initialStateDispersion,
+                                             ensembleFilename );
+
+    // Search for and store event settings. The events block is optional; if it is missing, no
+    // events are detected.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Event settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    std::string initialPhase = "";
+    std::string eventFilename = "";
+    ListOfEventDefinitions listOfEventDefinitions;
+    const ConfigIterator eventsIterator = config.FindMember( "events" );
+    if ( eventsIterator != config.MemberEnd( ) )
+    {
+        if ( eventsIterator->value.HasMember( "initial_phase" ) )
+        {
+            initialPhase = eventsIterator->value[ "initial_phase" ].GetString( );
+        }
+        if ( eventsIterator->value.HasMember( "event_file" ) )
+        {
+            eventFilename = eventsIterator->value[ "event_file" ].GetString( );
+        }
+
+        const rapidjson::Value& eventList = eventsIterator->value[ "list" ];
+        for ( rapidjson::SizeType i = 0; i < eventList.Size( ); i++ )
+        {
+            listOfEventDefinitions.push_back( checkEventDefinition( eventList[ i ] ) );
+        }
+    }
+
+    logInfo( ) << "Number of events                          " << listOfEventDefinitions.size( )
+               << std::endl;
+    for ( unsigned int i = 0; i < listOfEventDefinitions.size( ); i++ )
+    {
+        logInfo( ) << "                                          "
+                   << listOfEventDefinitions[ i ].name << std::endl;
+    }
+    if ( !listOfEventDefinitions.empty( ) )
+    {
+        logInfo( ) << "Initial phase                             " << initialPhase << std::endl;
+        logInfo( ) << "Event file                                " << eventFilename << std::endl;
+    }
+
+    const EventSettings eventSettings( initialPhase, eventFilename, listOfEventDefinitions );
+
+    // Search for and store relative motion settings. The relative motion block is optional; if it
+    // is missing, the trajectory is integrated numerically.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Relative motion settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator relativeMotionIterator = config.FindMember( "relative_motion" );
+    bool relativeMotionStatus = false;
+    if ( relativeMotionIterator != config.MemberEnd( ) )
+    {
+        relativeMotionStatus = relativeMotionIterator->value[ "status" ].GetBool( );
+    }
+    double targetSemiMajorAxis = std::numeric_limits< double >::signaling_NaN( );
+
+    logInfo( ) << "Status                                    ";
+    if ( relativeMotionStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        targetSemiMajorAxis
+            = relativeMotionIterator->value[ "target_semi_major_axis" ].GetDouble( );
+        logInfo( ) << "Target semi-major axis                    "
+                   << targetSemiMajorAxis << " km" << std::endl;
+        if ( !( targetSemiMajorAxis > 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Target semi-major axis must be positive!" );
+        }
+        if ( ensembleStatus || !listOfEventDefinitions.empty( ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Relative motion cannot be combined with ensembles or events!" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+    }
+
+    const RelativeMotionSettings relativeMotionSettings( relativeMotionStatus,
+                                                         targetSemiMajorAxis );
+
+    // Search for and store Encke settings. The Encke block is optional; if it is missing, the
+    // absolute trajectory of the chaser is integrated.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Encke settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator enckeIterator = config.FindMember( "encke" );
+    bool enckeStatus = false;
+    if ( enckeIterator != config.MemberEnd( ) )
+    {
+        enckeStatus = enckeIterator->value[ "status" ].GetBool( );
+    }
+    double rectificationThreshold = 0.01;
+    double rectificationInterval = std::fabs( endTime - startTime ) / 10.0;
+
+    logInfo( ) << "Status                                    ";
+    if ( enckeStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        if ( enckeIterator->value.HasMember( "rectification_threshold" ) )
+        {
+            rectificationThreshold
+                = enckeIterator->value[ "rectification_threshold" ].GetDouble( );
+        }
+        if ( enckeIterator->value.HasMember( "rectification_interval" ) )
+        {
+            rectificationInterval = enckeIterator->value[ "rectification_interval" ].GetDouble( );
+        }
+        logInfo( ) << "Rectification threshold                   "
+                   << rectificationThreshold << std::endl;
+        logInfo( ) << "Rectification interval                    "
+                   << rectificationInterval << " s" << std::endl;
+        if ( !( rectificationThreshold > 0.0 ) || !( rectificationInterval > 0.0 ) )
+        {
+            throw std::runtime_error(
+                "ERROR: Rectification threshold and interval must be positive!" );
+        }
+        if ( !isTargetInitialStateSet )
+        {
+            throw std::runtime_error( "ERROR: Encke propagation requires target initial state!" );
+        }
+        if ( !centralGravityStatus )
+        {
+            throw std::runtime_error( "ERROR: Encke propagation requires central gravity model!" );
+        }
+        if ( ensembleStatus || !listOfEventDefinitions.empty( ) || relativeMotionStatus )
+        {
+            throw std::runtime_error(
+                "ERROR: Encke propagation cannot be combined with ensembles, events or relative "
+                "motion!" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+    }
+
+    const EnckeSettings enckeSettings( enckeStatus,
+                                       rectificationThreshold,
+                                       rectificationInterval );
+
+    // Search for and store checkpoint settings. The checkpoint block is optional; if it is
+    // missing, no checkpoints are written and the simulation cannot be resumed.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Checkpoint settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator checkpointIterator = config.FindMember( "checkpoint" );
+    bool checkpointStatus = false;
+    if ( checkpointIterator != config.MemberEnd( ) )
+    {
+        checkpointStatus = checkpointIterator->value[ "status" ].GetBool( );
+    }
+    std::string checkpointFilename = "";
+    double checkpointInterval = 600.0;
+
+    logInfo( ) << "Status                                    ";
+    if ( checkpointStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        checkpointFilename = checkpointIterator->value[ "checkpoint_file" ].GetString( );
+        if ( checkpointIterator->value.HasMember( "interval" ) )
+        {
+            checkpointInterval = checkpointIterator->value[ "interval" ].GetDouble( );
+        }
+        logInfo( ) << "Checkpoint file                           " << checkpointFilename
+                   << std::endl;
+        logInfo( ) << "Checkpoint interval (wall-clock)          " << checkpointInterval << " s"
+                   << std::endl;
+        if ( !( checkpointInterval >= 0.0 ) )
+        {
+            throw std::runtime_error( "ERROR: Checkpoint interval must be non-negative!" );
+        }
+        if ( integrator == bulirschStoerIntegrator )
+        {
+            throw std::runtime_error(
+                "ERROR: Checkpoints are not supported for the bulirsch_stoer integrator!" );
+        }
+        if ( ensembleStatus || relativeMotionStatus || enckeStatus )
+        {
+            throw std::runtime_error(
+                "ERROR: Checkpoints cannot be combined with ensembles, relative motion or "
+                "Encke propagation!" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+    }
+
+    const CheckpointSettings checkpointSettings( checkpointStatus,
+                                                 checkpointFilename,
+                                                 checkpointInterval );
+
+    // Search for and store parameter sweep settings. The sweep block is optional; if it is
+    // missing, a single trajectory is simulated.
+    logInfo( ) << std::endl;
+    logInfo( ) << "Sweep settings" << std::endl;
+    logInfo( ) << "------------------------------------------" << std::endl;
+
+    const ConfigIterator sweepIterator = config.FindMember( "sweep" );
+    bool sweepStatus = false;
+    if ( sweepIterator != config.MemberEnd( ) )
+    {
+        sweepStatus = sweepIterator->value[ "status" ].GetBool( );
+    }
+    SweepMethod sweepMethod = gridSweepMethod;
+    unsigned int sweepNumberOfSamples = 0;
+    unsigned int sweepNumberOfThreads = 0;
+    unsigned int sweepSeed = 0;
+    ListOfSweepParameterDefinitions listOfSweepParameterDefinitions;
+    std::string sweepFilename = "";
+
+    logInfo( ) << "Status                                    ";
+    if ( sweepStatus == true )
+    {
+        logInfo( ) << "ON" << std::endl;
+        const std::string sweepMethodName = sweepIterator->value[ "method" ].GetString( );
+        if ( sweepMethodName == "latin_hypercube" )
+        {
+            sweepMethod = latinHypercubeSweepMethod;
+        }
+        else if ( sweepMethodName != "grid" )
+        {
+            throw std::runtime_error( "ERROR: Sweep method \"" + sweepMethodName
+                                      + "\" is not supported!" );
+        }
+        logInfo( ) << "Method                                    " << sweepMethodName << std::endl;
+
+        if ( sweepMethod == latinHypercubeSweepMethod )
+        {
+            sweepNumberOfSamples = sweepIterator->value[ "number_of_samples" ].GetUint( );
+            logInfo( ) << "Number of samples                         " << sweepNumberOfSamples
+                       << std::endl;
+            if ( sweepNumberOfSamples == 0 )
+            {
+                throw std::runtime_error( "ERROR: Number of sweep samples must be positive!" );
+            }
+            sweepSeed = sweepIterator->value[ "seed" ].GetUint( );
+            logInfo( ) << "Seed                                      " << sweepSeed << std::endl;
+        }
+
+        if ( sweepIterator->value.HasMember( "number_of_threads" ) )
+        {
+            sweepNumberOfThreads = sweepIterator->value[ "number_of_threads" ].GetUint( );
+        }
+        logInfo( ) << "Number of threads                         " << sweepNumberOfThreads
+                   << std::endl;
+
+        const rapidjson::Value& parameterList = sweepIterator->value[ "parameters" ];
+        for ( rapidjson::SizeType i = 0; i < parameterList.Size( ); i++ )
+        {
+            const SweepParameterDefinition definition
+                = checkSweepParameterDefinition( parameterList[ i ], sweepMethod );
+            for ( unsigned int j = 0; j < listOfSweepParameterDefinitions.size( ); j++ )
+            {
+                if ( listOfSweepParameterDefinitions[ j ].parameter == definition.parameter )
+                {
+                    throw std::runtime_error( "ERROR: Sweep parameter \""
+                                              + getSweepParameterName( definition.parameter )
+                                              + "\" is defined more than once!" );
+                }
+            }
+            listOfSweepParameterDefinitions.push_back( definition );
+        }
+        if ( listOfSweepParameterDefinitions.empty( ) )
+        {
+            throw std::runtime_error( "ERROR: List of sweep parameters must not be empty!" );
+        }
+        logInfo( ) << "Number of parameters                      "
+                   << listOfSweepParameterDefinitions.size( ) << std::endl;
+        for ( unsigned int i = 0; i < listOfSweepParameterDefinitions.size( ); i++ )
+        {
+            logInfo( ) << "                                          "
+                       << getSweepParameterName( listOfSweepParameterDefinitions[ i ].parameter )
+                       << std::endl;
+        }
+
+        sweepFilename = sweepIterator->value[ "sweep_file" ].GetString( );
+        logInfo( ) << "Sweep file                                " << sweepFilename << std::endl;
+
+        if ( ensembleStatus || relativeMotionStatus || enckeStatus || checkpointStatus )
+        {
+            throw std::runtime_error(
+                "ERROR: Sweeps cannot be combined with ensembles, relative motion, Encke "
+                "propagation or checkpoints!" );
+        }
+    }
+    else
+    {
+        logInfo( ) << "OFF" << std::endl;
+    }
+
+    const SweepSettings sweepSettings( sweepStatus,
+                                       sweepMethod,
+                                       sweepNumberOfSamples,
+                                       sweepNumberOfThreads,
+                                       sweepSeed,
+                                       listOfSweepParameterDefinitions,
+                                       sweepFilename );
+
+    return SimulatorSettings( integratorSettings,
+                              chaserSettings,
+                              targetSettings,
+                              centralGravitySettings,
+                              radiationPressureSettings,
+                              sphericalHarmonicsSettings,
+                              dragSettings,
+                              ephemerisSettings,
+                              thirdBodySettings,
+                              outputSettings,
+                              ensembleSettings,
+                              listOfModelNames,
+                              eventSettings,
+                              relativeMotionSettings,
+                              enckeSettings,
+                              checkpointSettings,
+                              sweepSettings );
+}
+
+//! Get simulation metadata.
+TrajectoryMetadata getSimulationMetadata( const SimulatorSettings& settings )
+{
+    const State& initialState = settings.integratorSettings.initialState;
+
+    TrajectoryMetadata metadata;
+    metadata.push_back( TrajectoryMetadataEntry(
+        "gravitational_parameter",
+        settings.centralGravitySettings.gravitationalParameter,
+        "km^3 s^-2" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_x", initialState[ 0 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_y", initialState[ 1 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_z", initialState[ 2 ], "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_vx", initialState[ 3 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_vy", initialState[ 4 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "initial_vz", initialState[ 5 ], "km s^-1" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "start_time", settings.integratorSettings.startTime, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "end_time", settings.integratorSettings.endTime, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "initial_step", settings.integratorSettings.initialStep, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "absolute_tolerance", settings.integratorSettings.absoluteTolerance, "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "relative_tolerance", settings.integratorSettings.relativeTolerance, "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "maximum_step", settings.integratorSettings.maximumStep, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "state_history_interval", settings.outputSettings.stateHistoryInterval, "s" ) );
+
+    return metadata;
+}
+
+//! Get checkpoint fingerprint of simulator settings.
+boost::uint64_t getCheckpointFingerprint( const SimulatorSettings& settings )
+{
+    Checkpoint fingerprint;
+
+    const TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        fingerprint.writeString( metadata[ i ].name );
+        fingerprint.writeDouble( metadata[ i ].value );
+    }
+    fingerprint.writeString( getIntegratorName( settings.integratorSettings.integrator ) );
+    fingerprint.writeDouble( settings.chaserSettings.mass );
+    for ( unsigned int i = 0; i < settings.listOfModelNames.size( ); i++ )
+    {
+        fingerprint.writeString( settings.listOfModelNames[ i ] );
+    }
+
+    const OutputSettings& output = settings.outputSettings;
+    fingerprint.writeSize( output.stateHistoryFormat );
+    fingerprint.writeDoubles( output.stateHistoryEpochs );
+    fingerprint.writeDouble( output.chebyshevTrajectorySettings.positionTolerance );
+    fingerprint.writeDouble( output.chebyshevTrajectorySettings.velocityTolerance );
+    fingerprint.writeSize( output.chebyshevTrajectorySettings.numberOfCoefficients );
+
+    const RadiationPressureSettings& radiationPressure = settings.radiationPressureSettings;
+    fingerprint.writeSize( radiationPressure.status );
+    fingerprint.writeDouble( radiationPressure.radiationPressure );
+    fingerprint.writeDouble( radiationPressure.radiationPressureCoefficient );
+    fingerprint.writeDouble( radiationPressure.vectorToSource[ 0 ] );
+    fingerprint.writeDouble( radiationPressure.vectorToSource[ 1 ] );
+    fingerprint.writeDouble( radiationPressure.vectorToSource[ 2 ] );
+    fingerprint.writeDouble( radiationPressure.radiationPressureArea );
+    fingerprint.writeSize( radiationPressure.shadowModel );
+    fingerprint.writeDouble( radiationPressure.centralBodyRadius );
+    fingerprint.writeDouble( radiationPressure.sourceRadius );
+    fingerprint.writeString( radiationPressure.sourceBodyName );
+
+    const SphericalHarmonicsSettings& sphericalHarmonics = settings.sphericalHarmonicsSettings;
+    fingerprint.writeSize( sphericalHarmonics.status );
+    fingerprint.writeSize( sphericalHarmonics.coefficients.degree );
+    fingerprint.writeSize( sphericalHarmonics.coefficients.order );
+    fingerprint.writeDoubles( sphericalHarmonics.coefficients.cosineCoefficients );
+    fingerprint.writeDoubles( sphericalHarmonics.coefficients.sineCoefficients );
+    fingerprint.writeDouble( sphericalHarmonics.referenceRadius );
+    fingerprint.writeDouble( sphericalHarmonics.rotationRate );
+    fingerprint.writeSize( sphericalHarmonics.interpolationSettings.status );
+    fingerprint.writeDouble( sphericalHarmonics.interpolationSettings.cellSize );
+    fingerprint.writeDouble( sphericalHarmonics.interpolationSettings.tolerance );
+    fingerprint.writeSize( sphericalHarmonics.interpolationSettings.maximumNumberOfCells );
+
+    const DragSettings& drag = settings.dragSettings;
+    fingerprint.writeSize( drag.status );
+    fingerprint.writeDouble( drag.dragCoefficient );
+    fingerprint.writeDouble( drag.dragArea );
+    fingerprint.writeSize( drag.atmosphereTable.size( ) );
+    for ( unsigned int i = 0; i < drag.atmosphereTable.size( ); i++ )
+    {
+        fingerprint.writeDouble( drag.atmosphereTable[ i ].baseAltitude );
+        fingerprint.writeDouble( drag.atmosphereTable[ i ].baseDensity );
+        fingerprint.writeDouble( drag.atmosphereTable[ i ].scaleHeight );
+    }
+    fingerprint.writeDouble( drag.centralBodyRadius );
+    fingerprint.writeDouble( drag.rotationRate );
+
+    // The ephemeris is identified by its bodies and coefficients, not by its filename, so that a
+    // regenerated ephemeris file is detected.
+    const ChebyshevEphemerisPtr ephemeris = settings.ephemerisSettings.ephemeris;
+    fingerprint.writeSize( ephemeris ? ephemeris->getNumberOfBodies( ) : 0 );
+    for ( std::size_t i = 0; ephemeris && i < ephemeris->getNumberOfBodies( ); i++ )
+    {
+        const EphemerisBody& body = ephemeris->getBody( i );
+        fingerprint.writeString( body.name );
+        fingerprint.writeDouble( body.gravitationalParameter );
+        fingerprint.writeDouble( body.startTime );
+        fingerprint.writeDouble( body.segmentDuration );
+        fingerprint.writeSize( body.numberOfSegments );
+        fingerprint.writeSize( body.numberOfCoefficients );
+        fingerprint.writeDoubles( std::vector< double >(
+            body.coefficients,
+            body.coefficients + 3 * body.numberOfSegments * body.numberOfCoefficients ) );
+    }
+
+    const ThirdBodySettings& thirdBody = settings.thirdBodySettings;
+    fingerprint.writeSize( thirdBody.status );
+    for ( unsigned int i = 0; i < thirdBody.bodyNames.size( ); i++ )
+    {
+        fingerprint.writeString( thirdBody.bodyNames[ i ] );
+    }
+
+    const EventSettings& events = settings.eventSettings;
+    fingerprint.writeString( events.initialPhase );
+    fingerprint.writeSize( events.listOfEventDefinitions.size( ) );
+    for ( unsigned int i = 0; i < events.listOfEventDefinitions.size( ); i++ )
+    {
+        const EventDefinition& event = events.listOfEventDefinitions[ i ];
+        fingerprint.writeString( event.name );
+        fingerprint.writeSize( event.type );
+        fingerprint.writeDouble( event.threshold );
+        fingerprint.writeDouble( event.referencePoint[ 0 ] );
+        fingerprint.writeDouble( event.referencePoint[ 1 ] );
+        fingerprint.writeDouble( event.referencePoint[ 2 ] );
+        fingerprint.writeSize( event.stateComponent );
+        fingerprint.writeSize( event.direction );
+        fingerprint.writeSize( event.action );
+        fingerprint.writeString( event.phase );
+        fingerprint.writeString( event.nextPhase );
+    }
+
+    return computeChecksum( fingerprint.getData( ) );
+}
+
+//! Add integration statistics to simulation metadata.
+void addIntegrationStatistics( const IntegrationStatistics& statistics,
+                               TrajectoryMetadata& metadata )
+{
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_function_evaluations",
+        static_cast< double >( statistics.numberOfFunctionEvaluations ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_accepted_steps",
+        static_cast< double >( statistics.numberOfAcceptedSteps ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_rejected_steps",
+        static_cast< double >( statistics.numberOfRejectedSteps ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "minimum_step_size", statistics.minimumStepSize, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "maximum_step_size", statistics.maximumStepSize, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "final_time", statistics.finalTime, "s" ) );
+}
+
+//! Add acceleration model timings to simulation metadata.
+#ifdef SCARAB_INSTRUMENTATION
+void addAccelerationModelTimings( const StateDerivativeModel& stateDerivativeModel,
+                                  TrajectoryMetadata& metadata )
+{
+    for ( unsigned int i = 0; i < stateDerivativeModel.getNumberOfAccelerationModels( ); i++ )
+    {
+        metadata.push_back( TrajectoryMetadataEntry(
+            getAccelerationModelName( stateDerivativeModel.getAccelerationModelId( i ) ) + "_time",
+            stateDerivativeModel.getAccelerationModelTime( i ),
+            "s" ) );
+    }
+}
+#else
+void addAccelerationModelTimings( const StateDerivativeModel& /* stateDerivativeModel */,
+                                  TrajectoryMetadata& /* metadata */ )
+{ }
+#endif
+
+//! Add Chebyshev trajectory statistics to simulation metadata.
+void addChebyshevTrajectoryStatistics( const ChebyshevTrajectoryWriter& writer,
+                                       TrajectoryMetadata& metadata )
+{
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_chebyshev_segments",
+        static_cast< double >( writer.getNumberOfSegments( ) ),
+        "-" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "chebyshev_maximum_position_error", writer.getMaximumPositionError( ), "km" ) );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "chebyshev_maximum_velocity_error", writer.getMaximumVelocityError( ), "km s^-1" ) );
+}
+
+//! Write string to stream as JSON string.
+static void writeJsonString( std::ostream& stream, const std::string& value )
+{
+    stream << '"' << escapeJsonString( value ) << '"';
+}
+
+//! Write double to stream as JSON number, with shortest round-trip representation.
+static void writeJsonNumber( std::ostream& stream, const double value )
+{
+    // JSON has no representation of infinity and NaN.
+    if ( !std::isfinite( value ) )
+    {
+        stream << "null";
+        return;
+    }
+
+    char buffer[ maximumFormattedDoubleLength ];
+    stream.write( buffer, formatShortestDouble( value, buffer ) );
+}
+
+//! Write run summary.
+void writeRunSummary( std::ostream& stream,
+                      const std::string& mode,
+                      const TrajectoryMetadata& metadata,
+                      const EventLog& eventLog,
+                      const double wallClockTime )
+{
+    stream << "{\n";
+    stream << "    \"status\": \"success\",\n";
+    stream << "    \"mode\": ";
+    writeJsonString( stream, mode );
+    stream << ",\n";
+    stream << "    \"wall_clock_time\": ";
+    writeJsonNumber( stream, wallClockTime );
+    stream << ",\n";
+
+    stream << "    \"metadata\": {";
+    for ( std::size_t i = 0; i < metadata.size( ); i++ )
+    {
+        stream << ( i == 0 ? "\n" : ",\n" ) << "        ";
+        writeJsonString( stream, metadata[ i ].name );
+        stream << ": { \"value\": ";
+        writeJsonNumber( stream, metadata[ i ].value );
+        stream << ", \"units\": ";
+        writeJsonString( stream, metadata[ i ].units );
+        stream << " }";
+    }
+    stream << ( metadata.empty( ) ? "},\n" : "\n    },\n" );
+
+    stream << "    \"events\": [";
+    for ( std::size_t i = 0; i < eventLog.size( ); i++ )
+    {
+        stream << ( i == 0 ? "\n" : ",\n" ) << "        { \"name\": ";
+        writeJsonString( stream, eventLog[ i ].name );
+        stream << ", \"time\": ";
+        writeJsonNumber( stream, eventLog[ i ].time );
+        stream << ", \"state\": [";
+        for ( std::size_t j = 0; j < eventLog[ i ].state.size( ); j++ )
+        {
+            stream << ( j == 0 ? "" : ", " );
+            writeJsonNumber( stream, eventLog[ i ].state[ j ] );
+        }
+        stream << "], \"action\": ";
+        writeJsonString( stream, getEventActionName( eventLog[ i ].action ) );
+        stream << ", \"phase\": ";
+        writeJsonString( stream, eventLog[ i ].phase );
+        stream << " }";
+    }
+    stream << ( eventLog.empty( ) ? "]\n" : "\n    ]\n" );
+    stream << "}" << std::endl;
 }
 
-} // namespace scarab
\ No newline at end of file
+} // namespace scarab
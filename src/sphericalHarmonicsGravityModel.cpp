@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
+
+namespace scarab
+{
+
+//! Parse number, accepting Fortran exponents.
+static bool parseNumber( std::string token, double& number )
+{
+    std::replace( token.begin( ), token.end( ), 'D', 'E' );
+    std::replace( token.begin( ), token.end( ), 'd', 'e' );
+
+    const char* begin = token.c_str( );
+    char* end = 0;
+    number = std::strtod( begin, &end );
+    return end != begin && *end == '\0';
+}
+
+//! Read spherical harmonics coefficients.
+SphericalHarmonicsCoefficients readSphericalHarmonicsCoefficients( const std::string& filename,
+                                                                   const unsigned int degree,
+                                                                   const unsigned int order )
+{
+    if ( order > degree )
+    {
+        throw std::runtime_error( "ERROR: Spherical harmonics order must not exceed degree!" );
+    }
+
+    std::ifstream file( filename.c_str( ) );
+    if ( !file.is_open( ) )
+    {
+        throw std::runtime_error( "ERROR: Could not open coefficient file \"" + filename + "\"!" );
+    }
+
+    SphericalHarmonicsCoefficients coefficients( degree, order );
+    unsigned int maximumDegreeRead = 0;
+    std::string line;
+    while ( std::getline( file, line ) )
+    {
+        if ( line.empty( ) || line[ 0 ] == '#' )
+        {
+            continue;
+        }
+        std::replace( line.begin( ), line.end( ), ',', ' ' );
+
+        std::istringstream lineStream( line );
+        std::string token;
+        if ( !( lineStream >> token ) )
+        {
+            continue;
+        }
+        if ( token == "gfc" || token == "gfct" )
+        {
+            lineStream >> token;
+        }
+
+        // Skip header lines, which do not start with a number.
+        double values[ 4 ];
+        if ( !parseNumber( token, values[ 0 ] ) )
+        {
+            continue;
+        }
+        for ( unsigned int i = 1; i < 4; i++ )
+        {
+            if ( !( lineStream >> token ) || !parseNumber( token, values[ i ] ) )
+            {
+                throw std::runtime_error( "ERROR: Invalid line in coefficient file \"" + filename
+                                          + "\": " + line );
+            }
+        }
+
+        const unsigned int n = static_cast< unsigned int >( values[ 0 ] );
+        const unsigned int m = static_cast< unsigned int >( values[ 1 ] );
+        if ( m > n )
+        {
+            throw std::runtime_error( "ERROR: Invalid line in coefficient file \"" + filename
+                                      + "\": " + line );
+        }
+        maximumDegreeRead = std::max( maximumDegreeRead, n );
+        if ( n <= degree && m <= order )
+        {
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            coefficients.cosineCoefficients[ index ] = values[ 2 ];
+            coefficients.sineCoefficients[ index ] = values[ 3 ];
+        }
+    }
+
+    if ( maximumDegreeRead < degree )
+    {
+        std::ostringstream error;
+        error << "ERROR: Coefficient file \"" << filename << "\" only contains coefficients up to "
+              << "degree " << maximumDegreeRead << "!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    return coefficients;
+}
+
+//! Construct model.
+SphericalHarmonicsGravityModel::SphericalHarmonicsGravityModel(
+    const double                            aGravitationalParameter,
+    const double                            aReferenceRadius,
+    const SphericalHarmonicsCoefficients&   someCoefficients,
+    const double                            aRotationRate )
+    : gravitationalParameter( aGravitationalParameter ),
+      referenceRadius( aReferenceRadius ),
+      coefficients( someCoefficients ),
+      rotationRate( aRotationRate )
+{
+    if ( coefficients.order > coefficients.degree
+         || coefficients.cosineCoefficients.size( )
+            != SphericalHarmonicsCoefficients::getIndex( coefficients.degree,
+                                                         coefficients.degree ) + 1
+         || coefficients.sineCoefficients.size( ) != coefficients.cosineCoefficients.size( ) )
+    {
+        throw std::runtime_error( "ERROR: Inconsistent spherical harmonics coefficients!" );
+    }
+
+    // The acceleration of degree n requires the harmonics of degree n + 1.
+    const unsigned int maximumDegree = coefficients.degree + 1;
+    const std::size_t numberOfHarmonics
+        = SphericalHarmonicsCoefficients::getIndex( maximumDegree, maximumDegree ) + 1;
+
+    // Factors of sectoral recursion V_mm = f_m ( x V_m-1,m-1 - y W_m-1,m-1 ) R / r^2.
+    sectoralFactors.assign( maximumDegree + 1, 0.0 );
+    for ( unsigned int m = 1; m <= maximumDegree; m++ )
+    {
+        sectoralFactors[ m ] = ( m == 1 ) ? std::sqrt( 3.0 )
+                                          : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+
+    // Factors of column recursion V_nm = a_nm z R / r^2 V_n-1,m - b_nm R^2 / r^2 V_n-2,m.
+    firstColumnFactors.assign( numberOfHarmonics, 0.0 );
+    secondColumnFactors.assign( numberOfHarmonics, 0.0 );
+    for ( unsigned int n = 1; n <= maximumDegree; n++ )
+    {
+        const double n_ = n;
+        for ( unsigned int m = 0; m < n; m++ )
+        {
+            const double m_ = m;
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            firstColumnFactors[ index ] = std::sqrt( ( 2.0 * n_ + 1.0 ) * ( 2.0 * n_ - 1.0 )
+                                                     / ( ( n_ - m_ ) * ( n_ + m_ ) ) );
+            if ( n >= m + 2 )
+            {
+                secondColumnFactors[ index ]
+                    = std::sqrt( ( 2.0 * n_ + 1.0 ) * ( n_ + m_ - 1.0 ) * ( n_ - m_ - 1.0 )
+                                 / ( ( 2.0 * n_ - 3.0 ) * ( n_ - m_ ) * ( n_ + m_ ) ) );
+            }
+        }
+    }
+
+    // Factors relating the normalized harmonics of degree n + 1 to the normalized coefficients of
+    // degree n in the acceleration.
+    const std::size_t numberOfCoefficients = coefficients.cosineCoefficients.size( );
+    upperOrderFactors.assign( numberOfCoefficients, 0.0 );
+    lowerOrderFactors.assign( numberOfCoefficients, 0.0 );
+    sameOrderFactors.assign( numberOfCoefficients, 0.0 );
+    for ( unsigned int n = 0; n <= coefficients.degree; n++ )
+    {
+        const double n_ = n;
+        const double degreeRatio = ( 2.0 * n_ + 1.0 ) / ( 2.0 * n_ + 3.0 );
+        for ( unsigned int m = 0; m <= n; m++ )
+        {
+            const double m_ = m;
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            upperOrderFactors[ index ] = std::sqrt( ( m == 0 ? 0.5 : 1.0 ) * degreeRatio
+                                                    * ( n_ + m_ + 2.0 ) * ( n_ + m_ + 1.0 ) );
+            if ( m > 0 )
+            {
+                lowerOrderFactors[ index ] = std::sqrt( ( m == 1 ? 2.0 : 1.0 ) * degreeRatio
+                                                        * ( n_ - m_ + 2.0 ) * ( n_ - m_ + 1.0 ) );
+            }
+            sameOrderFactors[ index ]
+                = std::sqrt( degreeRatio * ( n_ - m_ + 1.0 ) * ( n_ + m_ + 1.0 ) );
+        }
+    }
+}
+
+//! Compute acceleration.
+Acceleration SphericalHarmonicsGravityModel::operator( )( const State& state,
+                                                          const double time ) const
+{
+    Acceleration acceleration;
+    acceleration[ 0 ] = 0.0;
+    acceleration[ 1 ] = 0.0;
+    acceleration[ 2 ] = 0.0;
+    if ( coefficients.degree < 2 )
+    {
+        return acceleration;
+    }
+
+    // Rotate position into body-fixed frame.
+    double cosineAngle = 1.0;
+    double sineAngle = 0.0;
+    if ( rotationRate != 0.0 )
+    {
+        cosineAngle = std::cos( rotationRate * time );
+        sineAngle = std::sin( rotationRate * time );
+    }
+    const double x = cosineAngle * state[ 0 ] + sineAngle * state[ 1 ];
+    const double y = -sineAngle * state[ 0 ] + cosineAngle * state[ 1 ];
+    const double z = state[ 2 ];
+
+    // Work buffers for the harmonics, allocated once per thread.
+    const unsigned int maximumDegree = coefficients.degree + 1;
+    const std::size_t numberOfHarmonics
+        = SphericalHarmonicsCoefficients::getIndex( maximumDegree, maximumDegree ) + 1;
+    static thread_local std::vector< double > v;
+    static thread_local std::vector< double > w;
+    if ( v.size( ) < numberOfHarmonics )
+    {
+        v.resize( numberOfHarmonics );
+        w.resize( numberOfHarmonics );
+    }
+
+    const double radiusSquared = x * x + y * y + z * z;
+    const double radiusRatio = referenceRadius / radiusSquared;
+    const double x0 = x * radiusRatio;
+    const double y0 = y * radiusRatio;
+    const double z0 = z * radiusRatio;
+    const double rho = referenceRadius * radiusRatio;
+
+    // Compute normalized harmonics, column by column.
+    std::size_t sectoralIndex = 0;
+    v[ 0 ] = referenceRadius / std::sqrt( radiusSquared );
+    w[ 0 ] = 0.0;
+    for ( unsigned int m = 0; m <= maximumDegree; m++ )
+    {
+        if ( m > 0 )
+        {
+            const std::size_t previousIndex = sectoralIndex;
+            sectoralIndex += m + 1;
+            v[ sectoralIndex ] = sectoralFactors[ m ]
+                                 * ( x0 * v[ previousIndex ] - y0 * w[ previousIndex ] );
+            w[ sectoralIndex ] = sectoralFactors[ m ]
+                                 * ( x0 * w[ previousIndex ] + y0 * v[ previousIndex ] );
+        }
+
+        if ( m < maximumDegree )
+        {
+            const std::size_t index = sectoralIndex + m + 1;
+            v[ index ] = firstColumnFactors[ index ] * z0 * v[ sectoralIndex ];
+            w[ index ] = firstColumnFactors[ index ] * z0 * w[ sectoralIndex ];
+        }
+
+        std::size_t twoBackIndex = sectoralIndex;
+        std::size_t oneBackIndex = sectoralIndex + m + 1;
+        for ( unsigned int n = m + 2; n <= maximumDegree; n++ )
+        {
+            const std::size_t index = oneBackIndex + n;
+            v[ index ] = firstColumnFactors[ index ] * z0 * v[ oneBackIndex ]
+                         - secondColumnFactors[ index ] * rho * v[ twoBackIndex ];
+            w[ index ] = firstColumnFactors[ index ] * z0 * w[ oneBackIndex ]
+                         - secondColumnFactors[ index ] * rho * w[ twoBackIndex ];
+            twoBackIndex = oneBackIndex;
+            oneBackIndex = index;
+        }
+    }
+
+    // Sum accelerations of degrees 2 and higher.
+    double ax = 0.0;
+    double ay = 0.0;
+    double az = 0.0;
+    for ( unsigned int n = 2; n <= coefficients.degree; n++ )
+    {
+        const std::size_t rowIndex = SphericalHarmonicsCoefficients::getIndex( n, 0 );
+        const std::size_t nextRowIndex = SphericalHarmonicsCoefficients::getIndex( n + 1, 0 );
+
+        const double c0 = coefficients.cosineCoefficients[ rowIndex ];
+        ax -= c0 * upperOrderFactors[ rowIndex ] * v[ nextRowIndex + 1 ];
+        ay -= c0 * upperOrderFactors[ rowIndex ] * w[ nextRowIndex + 1 ];
+        az -= c0 * sameOrderFactors[ rowIndex ] * v[ nextRowIndex ];
+
+        const unsigned int maximumOrder = std::min( n, coefficients.order );
+        for ( unsigned int m = 1; m <= maximumOrder; m++ )
+        {
+            const std::size_t index = rowIndex + m;
+            const std::size_t upper = nextRowIndex + m + 1;
+            const std::size_t same = nextRowIndex + m;
+            const std::size_t lower = nextRowIndex + m - 1;
+            const double c = coefficients.cosineCoefficients[ index ];
+            const double s = coefficients.sineCoefficients[ index ];
+
+            ax += 0.5 * ( upperOrderFactors[ index ] * ( -c * v[ upper ] - s * w[ upper ] )
+                          + lowerOrderFactors[ index ] * ( c * v[ lower ] + s * w[ lower ] ) );
+            ay += 0.5 * ( upperOrderFactors[ index ] * ( -c * w[ upper ] + s * v[ upper ] )
+                          + lowerOrderFactors[ index ] * ( -c * w[ lower ] + s * v[ lower ] ) );
+            az += sameOrderFactors[ index ] * ( -c * v[ same ] - s * w[ same ] );
+        }
+    }
+
+    // Scale and rotate acceleration back from body-fixed frame.
+    const double factor = gravitationalParameter / ( referenceRadius * referenceRadius );
+    acceleration[ 0 ] = factor * ( cosineAngle * ax - sineAngle * ay );
+    acceleration[ 1 ] = factor * ( sineAngle * ax + cosineAngle * ay );
+    acceleration[ 2 ] = factor * az;
+
+    return acceleration;
+}
+
+} // namespace scarab
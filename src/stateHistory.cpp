@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Scarab/stateHistory.hpp"
+
+namespace scarab
+{
+
+const std::size_t StateHistory::numberOfComponents;
+const std::size_t StateHistory::maximumEstimatedCapacity;
+
+//! Estimate capacity.
+std::size_t StateHistory::estimateCapacity( const double startTime,
+                                            const double endTime,
+                                            const double stepSize )
+{
+    if ( !( stepSize > 0.0 ) || !( endTime > startTime ) )
+    {
+        return 1;
+    }
+
+    const double numberOfSteps = std::ceil( ( endTime - startTime ) / stepSize );
+    if ( !( numberOfSteps < static_cast< double >( maximumEstimatedCapacity ) ) )
+    {
+        return maximumEstimatedCapacity;
+    }
+
+    return static_cast< std::size_t >( numberOfSteps ) + 1;
+}
+
+//! Reserve capacity.
+void StateHistory::reserve( const std::size_t aCapacity )
+{
+    times.reserve( aCapacity );
+    for ( std::size_t i = 0; i < numberOfComponents; i++ )
+    {
+        components[ i ].reserve( aCapacity );
+    }
+}
+
+//! Clear state history.
+void StateHistory::clear( )
+{
+    times.clear( );
+    for ( std::size_t i = 0; i < numberOfComponents; i++ )
+    {
+        components[ i ].clear( );
+    }
+}
+
+//! Find sample at or before time.
+std::size_t StateHistory::findIndex( const double time ) const
+{
+    const std::vector< double >::const_iterator next
+        = std::upper_bound( times.begin( ), times.end( ), time );
+    if ( next == times.begin( ) )
+    {
+        return times.size( );
+    }
+
+    return static_cast< std::size_t >( next - times.begin( ) ) - 1;
+}
+
+//! Find sample at time.
+std::size_t StateHistory::find( const double time ) const
+{
+    const std::size_t index = findIndex( time );
+    if ( index < times.size( ) && times[ index ] == time )
+    {
+        return index;
+    }
+
+    return times.size( );
+}
+
+} // namespace scarab
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "Scarab/doubleFormatting.hpp"
+#include "Scarab/stateHistorySink.hpp"
+
+namespace scarab
+{
+
+//! Number of values per sample (epoch and state).
+static const std::size_t numberOfValuesPerSample = 7;
+
+//! Construct streaming writer.
+StreamingStateHistoryWriter::StreamingStateHistoryWriter( std::ostream& aStream,
+                                                          const std::size_t aChunkSize,
+                                                          const std::string& streamHeader )
+    : stream( aStream ),
+      chunkSize( aChunkSize ),
+      buffer( aChunkSize * numberOfValuesPerSample ),
+      numberOfBufferedSamples( 0 ),
+      numberOfSamples( 0 ),
+      text( aChunkSize * numberOfValuesPerSample * ( maximumFormattedDoubleLength + 1 ) )
+{
+    if ( chunkSize == 0 )
+    {
+        throw std::runtime_error( "ERROR: Chunk size of state history writer must be positive!" );
+    }
+
+    stream << streamHeader << std::endl;
+}
+
+//! Destruct streaming writer.
+StreamingStateHistoryWriter::~StreamingStateHistoryWriter( )
+{
+    writeChunk( );
+    stream.flush( );
+}
+
+//! Write sample.
+void StreamingStateHistoryWriter::write( const double time, const State& state )
+{
+    double* sample = &buffer[ numberOfBufferedSamples * numberOfValuesPerSample ];
+    sample[ 0 ] = time;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        sample[ i + 1 ] = state[ i ];
+    }
+
+    numberOfBufferedSamples++;
+    numberOfSamples++;
+
+    if ( numberOfBufferedSamples == chunkSize )
+    {
+        writeChunk( );
+    }
+}
+
+//! Flush sink.
+void StreamingStateHistoryWriter::flush( )
+{
+    writeChunk( );
+    stream.flush( );
+}
+
+//! Write checkpoint.
+void StreamingStateHistoryWriter::writeCheckpoint( Checkpoint& checkpoint )
+{
+    flush( );
+    const std::streamoff position = stream.tellp( );
+    if ( !stream || position < 0 )
+    {
+        throw std::runtime_error( "ERROR: Could not get position in state history stream!" );
+    }
+
+    checkpoint.writeSize( numberOfSamples );
+    checkpoint.writeSize( static_cast< boost::uint64_t >( position ) );
+}
+
+//! Restore checkpoint.
+void StreamingStateHistoryWriter::restoreCheckpoint( Checkpoint& checkpoint )
+{
+    numberOfSamples = checkpoint.readSize( );
+    const boost::uint64_t position = checkpoint.readSize( );
+
+    numberOfBufferedSamples = 0;
+    stream.seekp( static_cast< std::streamoff >( position ) );
+    if ( !stream )
+    {
+        throw std::runtime_error( "ERROR: Could not restore position in state history stream!" );
+    }
+}
+
+//! Write buffered samples to stream.
+void StreamingStateHistoryWriter::writeChunk( )
+{
+    if ( numberOfBufferedSamples == 0 )
+    {
+        return;
+    }
+
+    // Format chunk into text buffer, which is large enough to hold a full chunk.
+    char* position = &text[ 0 ];
+    for ( std::size_t i = 0; i < numberOfBufferedSamples; i++ )
+    {
+        const double* sample = &buffer[ i * numberOfValuesPerSample ];
+        for ( std::size_t j = 0; j < numberOfValuesPerSample; j++ )
+        {
+            position += formatShortestDouble( sample[ j ], position );
+            *position++ = j < numberOfValuesPerSample - 1 ? ',' : '\n';
+        }
+    }
+
+    stream.write( &text[ 0 ], position - &text[ 0 ] );
+    numberOfBufferedSamples = 0;
+}
+
+//! Construct CSV file writer.
+CsvStateHistoryFileWriter::CsvStateHistoryFileWriter( const std::string& aFilename,
+                                                      const std::size_t aChunkSize,
+                                                      const std::string& fileHeader,
+                                                      const bool isResumed )
+    : filename( aFilename ),
+      file( aFilename.c_str( ),
+            isResumed ? std::ios::in | std::ios::out : std::ios::out | std::ios::trunc ),
+      writer( file, aChunkSize, fileHeader )
+{
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not open state history file \"" + filename
+                                  + "\"!" );
+    }
+}
+
+//! Restore checkpoint.
+void CsvStateHistoryFileWriter::restoreCheckpoint( Checkpoint& checkpoint )
+{
+    writer.restoreCheckpoint( checkpoint );
+    file.flush( );
+    const std::streamoff position = file.tellp( );
+
+    boost::system::error_code error;
+    boost::filesystem::resize_file( filename, static_cast< boost::uintmax_t >( position ), error );
+    if ( !file || position < 0 || error )
+    {
+        throw std::runtime_error( "ERROR: Could not truncate state history file \"" + filename
+                                  + "\"!" );
+    }
+}
+
+} // namespace scarab
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/doubleFormatting.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/logger.hpp"
+#include "Scarab/randomNumbers.hpp"
+#include "Scarab/simulator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/sweep.hpp"
+#include "Scarab/threadPool.hpp"
+#include "Scarab/tools.hpp"
+
+namespace scarab
+{
+
+//! Name of sweep parameter.
+struct SweepParameterName
+{
+    //! Name, as used in the JSON input file and the sweep output file.
+    const char* name;
+
+    //! Sweep parameter.
+    SweepParameter parameter;
+};
+
+//! Names of all sweep parameters.
+static const SweepParameterName sweepParameterNames[ ]
+    = { { "initial_x", initialXSweepParameter },
+        { "initial_y", initialYSweepParameter },
+        { "initial_z", initialZSweepParameter },
+        { "initial_vx", initialVxSweepParameter },
+        { "initial_vy", initialVySweepParameter },
+        { "initial_vz", initialVzSweepParameter },
+        { "start_time", startTimeSweepParameter },
+        { "end_time", endTimeSweepParameter },
+        { "initial_step", initialStepSweepParameter },
+        { "absolute_tolerance", absoluteToleranceSweepParameter },
+        { "relative_tolerance", relativeToleranceSweepParameter },
+        { "maximum_step", maximumStepSweepParameter },
+        { "gravitational_parameter", gravitationalParameterSweepParameter },
+        { "chaser_mass", chaserMassSweepParameter },
+        { "target_mass", targetMassSweepParameter },
+        { "radiation_pressure", radiationPressureSweepParameter },
+        { "radiation_pressure_coefficient", radiationPressureCoefficientSweepParameter },
+        { "radiation_pressure_area", radiationPressureAreaSweepParameter },
+        { "drag_coefficient", dragCoefficientSweepParameter },
+        { "drag_area", dragAreaSweepParameter } };
+
+//! Number of sweep parameters.
+static const std::size_t numberOfSweepParameters
+    = sizeof( sweepParameterNames ) / sizeof( sweepParameterNames[ 0 ] );
+
+//! Get sweep parameter.
+SweepParameter getSweepParameter( const std::string& parameterName )
+{
+    for ( std::size_t i = 0; i < numberOfSweepParameters; i++ )
+    {
+        if ( parameterName == sweepParameterNames[ i ].name )
+        {
+            return sweepParameterNames[ i ].parameter;
+        }
+    }
+
+    throw std::runtime_error( "ERROR: Sweep parameter \"" + parameterName
+                              + "\" is not supported!" );
+}
+
+//! Get sweep parameter name.
+std::string getSweepParameterName( const SweepParameter parameter )
+{
+    for ( std::size_t i = 0; i < numberOfSweepParameters; i++ )
+    {
+        if ( parameter == sweepParameterNames[ i ].parameter )
+        {
+            return sweepParameterNames[ i ].name;
+        }
+    }
+
+    throw std::runtime_error( "ERROR: Sweep parameter is not supported!" );
+}
+
+//! Expand sweep.
+std::vector< SweepPoint > expandSweep( const SweepSettings& settings )
+{
+    const ListOfSweepParameterDefinitions& definitions = settings.listOfParameterDefinitions;
+    std::vector< SweepPoint > points;
+
+    if ( settings.method == gridSweepMethod )
+    {
+        std::size_t numberOfPoints = definitions.empty( ) ? 0 : 1;
+        for ( std::size_t i = 0; i < definitions.size( ); i++ )
+        {
+            numberOfPoints *= definitions[ i ].values.size( );
+        }
+
+        // Decompose the run index into one grid index per parameter, last parameter fastest.
+        points.resize( numberOfPoints, SweepPoint( definitions.size( ) ) );
+        for ( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            std::size_t remainder = i;
+            for ( std::size_t j = definitions.size( ); j > 0; j-- )
+            {
+                const std::vector< double >& values = definitions[ j - 1 ].values;
+                points[ i ][ j - 1 ] = values[ remainder % values.size( ) ];
+                remainder /= values.size( );
+            }
+        }
+
+        return points;
+    }
+
+    // Every parameter has its own random stream, seeded by the sweep seed and the parameter
+    // index, so the sample of a parameter does not depend on the other parameters.
+    const std::size_t numberOfSamples = settings.numberOfSamples;
+    points.resize( numberOfSamples, SweepPoint( definitions.size( ) ) );
+    std::vector< std::size_t > strata( numberOfSamples );
+    for ( std::size_t j = 0; j < definitions.size( ); j++ )
+    {
+        std::seed_seq seedSequence = { settings.seed, static_cast< unsigned int >( j ) };
+        RandomNumberGenerator generator( seedSequence );
+
+        // Fisher-Yates shuffle, since std::shuffle differs between standard libraries.
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            strata[ i ] = i;
+        }
+        for ( std::size_t i = numberOfSamples; i > 1; i-- )
+        {
+            std::swap( strata[ i - 1 ], strata[ generateRandomIndex( generator, i ) ] );
+        }
+
+        const double range = definitions[ j ].maximum - definitions[ j ].minimum;
+        for ( std::size_t i = 0; i < numberOfSamples; i++ )
+        {
+            const double fraction
+                = ( strata[ i ] + generateUniformRandomNumber( generator ) ) / numberOfSamples;
+            points[ i ][ j ] = definitions[ j ].minimum + fraction * range;
+        }
+    }
+
+    return points;
+}
+
+//! Get simulator settings of sweep run.
+SimulatorSettings getSweepRunSettings( const SimulatorSettings& settings,
+                                       const SweepPoint& point )
+{
+    const ListOfSweepParameterDefinitions& definitions
+        = settings.sweepSettings.listOfParameterDefinitions;
+    if ( point.size( ) != definitions.size( ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Number of sweep parameter values does not match sweep settings!" );
+    }
+
+    const IntegratorSettings& integrator = settings.integratorSettings;
+    State initialState = integrator.initialState;
+    double startTime = integrator.startTime;
+    double endTime = integrator.endTime;
+    double initialStep = integrator.initialStep;
+    double absoluteTolerance = integrator.absoluteTolerance;
+    double relativeTolerance = integrator.relativeTolerance;
+    double maximumStep = integrator.maximumStep;
+    double gravitationalParameter = settings.centralGravitySettings.gravitationalParameter;
+    double chaserMass = settings.chaserSettings.mass;
+    double targetMass = settings.targetSettings.mass;
+    const RadiationPressureSettings& radiation = settings.radiationPressureSettings;
+    double radiationPressure = radiation.radiationPressure;
+    double radiationPressureCoefficient = radiation.radiationPressureCoefficient;
+    double radiationPressureArea = radiation.radiationPressureArea;
+    const DragSettings& drag = settings.dragSettings;
+    double dragCoefficient = drag.dragCoefficient;
+    double dragArea = drag.dragArea;
+
+    for ( std::size_t i = 0; i < definitions.size( ); i++ )
+    {
+        const double value = point[ i ];
+        switch ( definitions[ i ].parameter )
+        {
+            case initialXSweepParameter:
+            case initialYSweepParameter:
+            case initialZSweepParameter:
+            case initialVxSweepParameter:
+            case initialVySweepParameter:
+            case initialVzSweepParameter:
+                initialState[ definitions[ i ].parameter - initialXSweepParameter ] = value;
+                break;
+
+            case startTimeSweepParameter:
+                startTime = value;
+                break;
+
+            case endTimeSweepParameter:
+                endTime = value;
+                break;
+
+            case initialStepSweepParameter:
+                initialStep = value;
+                break;
+
+            case absoluteToleranceSweepParameter:
+                absoluteTolerance = value;
+                break;
+
+            case relativeToleranceSweepParameter:
+                relativeTolerance = value;
+                break;
+
+            case maximumStepSweepParameter:
+                maximumStep = value;
+                break;
+
+            case gravitationalParameterSweepParameter:
+                gravitationalParameter = value;
+                break;
+
+            case chaserMassSweepParameter:
+                chaserMass = value;
+                break;
+
+            case targetMassSweepParameter:
+                targetMass = value;
+                break;
+
+            case radiationPressureSweepParameter:
+                radiationPressure = value;
+                break;
+
+            case radiationPressureCoefficientSweepParameter:
+                radiationPressureCoefficient = value;
+                break;
+
+            case radiationPressureAreaSweepParameter:
+                radiationPressureArea = value;
+                break;
+
+            case dragCoefficientSweepParameter:
+                dragCoefficient = value;
+                break;
+
+            case dragAreaSweepParameter:
+                dragArea = value;
+                break;
+        }
+    }
+
+    // The nominal settings are checked when they are read, but the swept values are not.
+    if ( endTime < startTime )
+    {
+        throw std::runtime_error( "ERROR: End time of sweep run must not be before start time!" );
+    }
+    if ( !( initialStep > 0.0 ) || !( maximumStep > 0.0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Initial and maximum step of sweep run must be positive!" );
+    }
+    if ( !( absoluteTolerance >= 0.0 ) || !( relativeTolerance >= 0.0 ) )
+    {
+        throw std::runtime_error(
+            "ERROR: Integrator tolerances of sweep run must not be negative!" );
+    }
+    if ( !( chaserMass > 0.0 ) || !( targetMass > 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Chaser and target mass of sweep run must be positive!" );
+    }
+    if ( !( radiationPressure >= 0.0 ) || !( radiationPressureCoefficient >= 0.0 )
+         || !( radiationPressureArea >= 0.0 ) || !( dragCoefficient >= 0.0 )
+         || !( dragArea >= 0.0 ) )
+    {
+        throw std::runtime_error( "ERROR: Radiation pressure, drag coefficients and areas of sweep "
+                                  "run must not be negative!" );
+    }
+
+    return SimulatorSettings( IntegratorSettings( initialState,
+                                                  startTime,
+                                                  endTime,
+                                                  initialStep,
+                                                  integrator.integrator,
+                                                  absoluteTolerance,
+                                                  relativeTolerance,
+                                                  maximumStep ),
+                              ChaserSettings( chaserMass ),
+                              TargetSettings( targetMass,
+                                              settings.targetSettings.dragArea,
+                                              settings.targetSettings.radiationPressureArea,
+                                              settings.targetSettings.initialState ),
+                              CentralGravitySettings( settings.centralGravitySettings.status,
+                                                      gravitationalParameter ),
+                              RadiationPressureSettings( radiation.status,
+                                                         radiationPressure,
+                                                         radiationPressureCoefficient,
+                                                         radiation.vectorToSource,
+                                                         radiationPressureArea,
+                                                         radiation.shadowModel,
+                                                         radiation.centralBodyRadius,
+                                                         radiation.sourceRadius,
+                                                         radiation.sourceBodyName ),
+                              settings.sphericalHarmonicsSettings,
+                              DragSettings( drag.status,
+                                            dragCoefficient,
+                                            dragArea,
+                                            drag.densityFilename,
+                                            drag.atmosphereTable,
+                                            drag.centralBodyRadius,
+                                            drag.rotationRate ),
+                              settings.ephemerisSettings,
+                              settings.thirdBodySettings,
+                              settings.outputSettings,
+                              settings.ensembleSettings,
+                              settings.listOfModelNames,
+                              settings.eventSettings,
+                              settings.relativeMotionSettings,
+                              settings.enckeSettings,
+                              settings.checkpointSettings,
+                              settings.sweepSettings );
+}
+
+//! Propagate sweep run.
+SweepRun propagateSweepRun( const SimulatorSettings& settings,
+                            const SweepPoint& point,
+                            const unsigned int runIndex )
+{
+    const SimulatorSettings runSettings = getSweepRunSettings( settings, point );
+
+    SweepRun run;
+    run.index = runIndex;
+    run.point = point;
+
+    // Every run owns its data store and models, so that no state is shared between threads.
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( runSettings.integratorSettings.initialState,
+                    runSettings.integratorSettings.startTime,
+                    runSettings.centralGravitySettings.gravitationalParameter,
+                    listOfAccelerationModels );
+    generateAccelerationModelList( runSettings, data );
+    StateDerivativeModel stateDerivativeModel( data );
+
+    EventDetector eventDetector( runSettings.eventSettings );
+    EventDetector* const activeEventDetector
+        = runSettings.eventSettings.listOfEventDefinitions.empty( ) ? 0 : &eventDetector;
+
+    run.finalState = runSettings.integratorSettings.initialState;
+    run.statistics = integrateState( runSettings.integratorSettings,
+                                     stateDerivativeModel,
+                                     run.finalState,
+                                     IntegratorObserver( ),
+                                     0.0,
+                                     std::vector< double >( ),
+                                     activeEventDetector );
+    run.eventLog = eventDetector.getEventLog( );
+
+    return run;
+}
+
+//! Propagate sweep.
+Sweep propagateSweep( const SimulatorSettings& settings )
+{
+    const std::vector< SweepPoint > points = expandSweep( settings.sweepSettings );
+    Sweep sweep( points.size( ) );
+
+    // The settings of all runs are checked before any run is propagated.
+    for ( unsigned int i = 0; i < points.size( ); i++ )
+    {
+        getSweepRunSettings( settings, points[ i ] );
+    }
+
+    ThreadPool threadPool( settings.sweepSettings.numberOfThreads );
+    for ( unsigned int i = 0; i < sweep.size( ); i++ )
+    {
+        threadPool.submit( [ &settings, &points, &sweep, i ]( )
+                           {
+                               sweep[ i ] = propagateSweepRun( settings, points[ i ], i );
+                           } );
+    }
+    threadPool.wait( );
+
+    return sweep;
+}
+
+//! Execute sweep.
+TrajectoryMetadata executeSweep( const SimulatorSettings& settings )
+{
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                               Sweep                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    logInfo( ) << "Propagating sweep ..." << std::endl;
+    flushLog( );
+    const Sweep sweep = propagateSweep( settings );
+    logInfo( ) << "Propagated " << sweep.size( ) << " sweep runs successfully!" << std::endl;
+
+    // The final time of the sweep is the latest final time of its runs.
+    IntegrationStatistics statistics;
+    statistics.finalTime = settings.integratorSettings.startTime;
+    unsigned int numberOfTerminatedRuns = 0;
+    for ( unsigned int i = 0; i < sweep.size( ); i++ )
+    {
+        const SweepRun& run = sweep[ i ];
+        if ( !run.eventLog.empty( ) && run.eventLog.back( ).action == terminateEventAction )
+        {
+            numberOfTerminatedRuns++;
+        }
+
+        accumulateIntegrationStatistics( run.statistics, statistics );
+        statistics.finalTime = std::max( statistics.finalTime, run.statistics.finalTime );
+    }
+    logInfo( ) << std::endl;
+    logInfo( ) << "Number of function evaluations (total)    "
+               << statistics.numberOfFunctionEvaluations << std::endl;
+    logInfo( ) << "Number of accepted steps (total)          "
+               << statistics.numberOfAcceptedSteps << std::endl;
+    logInfo( ) << "Number of rejected steps (total)          "
+               << statistics.numberOfRejectedSteps << std::endl;
+    logInfo( ) << "Number of runs terminated by events       " << numberOfTerminatedRuns
+               << std::endl;
+
+    logInfo( ) << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << "                              Output                              " << std::endl;
+    logInfo( ) << "******************************************************************" << std::endl;
+    logInfo( ) << std::endl;
+
+    // Write simulation metadata of nominal settings to file.
+    logDebug( ) << "Writing simulation metadata to file ..." << std::endl;
+    TrajectoryMetadata metadata = getSimulationMetadata( settings );
+    metadata.push_back( TrajectoryMetadataEntry(
+        "number_of_runs", static_cast< double >( sweep.size( ) ), "-" ) );
+    addIntegrationStatistics( statistics, metadata );
+    std::ofstream metadataFile( settings.outputSettings.metadataFilename.c_str( ) );
+    for ( unsigned int i = 0; i < metadata.size( ); i++ )
+    {
+        print( metadataFile, metadata[ i ].name, metadata[ i ].value, metadata[ i ].units );
+    }
+    metadataFile.close( );
+    logInfo( ) << "Simulation metadata written to file successfully!" << std::endl;
+
+    // Write parameter values and final states of all runs to file.
+    const ListOfSweepParameterDefinitions& definitions
+        = settings.sweepSettings.listOfParameterDefinitions;
+    logDebug( ) << "Writing sweep to file ..." << std::endl;
+    std::ofstream sweepFile( settings.sweepSettings.sweepFilename.c_str( ) );
+    sweepFile << "run";
+    for ( unsigned int i = 0; i < definitions.size( ); i++ )
+    {
+        sweepFile << "," << getSweepParameterName( definitions[ i ].parameter );
+    }
+    sweepFile << ",x,y,z,vx,vy,vz,t,number_of_function_evaluations,number_of_accepted_steps,"
+              << "number_of_rejected_steps" << std::endl;
+    for ( unsigned int i = 0; i < sweep.size( ); i++ )
+    {
+        const SweepRun& run = sweep[ i ];
+        sweepFile << run.index;
+        for ( unsigned int j = 0; j < run.point.size( ); j++ )
+        {
+            sweepFile << ",";
+            writeShortestDouble( sweepFile, run.point[ j ] );
+        }
+        for ( unsigned int j = 0; j < run.finalState.size( ); j++ )
+        {
+            sweepFile << ",";
+            writeShortestDouble( sweepFile, run.finalState[ j ] );
+        }
+        sweepFile << ",";
+        writeShortestDouble( sweepFile, run.statistics.finalTime );
+        sweepFile << "," << run.statistics.numberOfFunctionEvaluations
+                  << "," << run.statistics.numberOfAcceptedSteps
+                  << "," << run.statistics.numberOfRejectedSteps << "\n";
+    }
+    sweepFile.close( );
+    logInfo( ) << "Sweep written to file successfully!" << std::endl;
+
+    // Write event logs of all runs to file.
+    if ( !settings.eventSettings.listOfEventDefinitions.empty( )
+         && !settings.eventSettings.eventFilename.empty( ) )
+    {
+        logDebug( ) << "Writing event log to file ..." << std::endl;
+        std::ofstream eventFile( settings.eventSettings.eventFilename.c_str( ) );
+        eventFile << "run,event,t,x,y,z,vx,vy,vz,action,phase" << std::endl;
+        for ( unsigned int i = 0; i < sweep.size( ); i++ )
+        {
+            const EventLog& eventLog = sweep[ i ].eventLog;
+            for ( unsigned int j = 0; j < eventLog.size( ); j++ )
+            {
+                eventFile << sweep[ i ].index << "," << eventLog[ j ].name << ",";
+                writeShortestDouble( eventFile, eventLog[ j ].time );
+                for ( unsigned int k = 0; k < eventLog[ j ].state.size( ); k++ )
+                {
+                    eventFile << ",";
+                    writeShortestDouble( eventFile, eventLog[ j ].state[ k ] );
+                }
+                eventFile << "," << getEventActionName( eventLog[ j ].action )
+                          << "," << eventLog[ j ].phase << "\n";
+            }
+        }
+        eventFile.close( );
+        logInfo( ) << "Event log written to file successfully!" << std::endl;
+    }
+
+    return metadata;
+}
+
+} // namespace scarab
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include "Scarab/threadPool.hpp"
+
+namespace scarab
+{
+
+//! Construct thread pool.
+ThreadPool::ThreadPool( const unsigned int aNumberOfThreads )
+    : numberOfQueuedTasks( 0 ),
+      numberOfPendingTasks( 0 ),
+      nextQueue( 0 ),
+      isStopping( false )
+{
+    unsigned int numberOfThreads = aNumberOfThreads;
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = std::thread::hardware_concurrency( );
+    }
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = 1;
+    }
+
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        queues.push_back( std::unique_ptr< TaskQueue >( new TaskQueue ) );
+    }
+
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        workers.push_back( std::thread( &ThreadPool::run, this, i ) );
+    }
+}
+
+//! Destruct thread pool.
+ThreadPool::~ThreadPool( )
+{
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        tasksCompleted.wait( lock, [ this ]( ) { return numberOfPendingTasks == 0; } );
+        isStopping = true;
+    }
+    taskSubmitted.notify_all( );
+
+    for ( unsigned int i = 0; i < workers.size( ); i++ )
+    {
+        workers[ i ].join( );
+    }
+}
+
+//! Submit task.
+void ThreadPool::submit( const Task& task )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+
+        TaskQueue& queue = *queues[ nextQueue ];
+        nextQueue = ( nextQueue + 1 ) % queues.size( );
+
+        {
+            std::lock_guard< std::mutex > queueLock( queue.mutex );
+            queue.tasks.push_back( task );
+        }
+
+        numberOfQueuedTasks++;
+        numberOfPendingTasks++;
+    }
+    taskSubmitted.notify_one( );
+}
+
+//! Wait for tasks.
+void ThreadPool::wait( )
+{
+    std::exception_ptr caughtError;
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        tasksCompleted.wait( lock, [ this ]( ) { return numberOfPendingTasks == 0; } );
+        caughtError = error;
+        error = std::exception_ptr( );
+    }
+
+    if ( caughtError )
+    {
+        std::rethrow_exception( caughtError );
+    }
+}
+
+//! Run worker thread.
+void ThreadPool::run( const unsigned int index )
+{
+    while ( true )
+    {
+        Task task;
+        if ( take( index, task ) )
+        {
+            try
+            {
+                task( );
+            }
+            catch ( ... )
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+                if ( !error )
+                {
+                    error = std::current_exception( );
+                }
+            }
+
+            bool isLastTask = false;
+            {
+                std::lock_guard< std::mutex > lock( mutex );
+                numberOfPendingTasks--;
+                isLastTask = ( numberOfPendingTasks == 0 );
+            }
+            if ( isLastTask )
+            {
+                tasksCompleted.notify_all( );
+            }
+            continue;
+        }
+
+        std::unique_lock< std::mutex > lock( mutex );
+        taskSubmitted.wait( lock,
+                            [ this ]( ) { return isStopping || numberOfQueuedTasks > 0; } );
+        if ( isStopping && numberOfQueuedTasks == 0 )
+        {
+            return;
+        }
+    }
+}
+
+//! Take task.
+bool ThreadPool::take( const unsigned int index, Task& task )
+{
+    bool isTaken = false;
+
+    // Take most recently submitted task from own queue.
+    {
+        std::lock_guard< std::mutex > lock( queues[ index ]->mutex );
+        if ( !queues[ index ]->tasks.empty( ) )
+        {
+            task = queues[ index ]->tasks.back( );
+            queues[ index ]->tasks.pop_back( );
+            isTaken = true;
+        }
+    }
+
+    // Steal oldest task from the queues of the other workers.
+    for ( unsigned int i = 1; i < queues.size( ) && !isTaken; i++ )
+    {
+        TaskQueue& victim = *queues[ ( index + i ) % queues.size( ) ];
+        std::lock_guard< std::mutex > lock( victim.mutex );
+        if ( !victim.tasks.empty( ) )
+        {
+            task = victim.tasks.front( );
+            victim.tasks.pop_front( );
+            isTaken = true;
+        }
+    }
+
+    if ( isTaken )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        numberOfQueuedTasks--;
+    }
+
+    return isTaken;
+}
+
+} // namespace scarab
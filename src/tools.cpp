@@ -30,25 +30,31 @@ ConfigIterator find( const rapidjson::Document& config, const std::string& param
 
 //! Print state history to stream.
 void print( std::ostream& stream,
-            const StateHistory stateHistory,
+            const StateHistory& stateHistory,
             const std::string& streamHeader,
             const int precision )
 {
     stream << streamHeader << std::endl;
 
-    for ( StateHistory::const_iterator it = stateHistory.begin( );
-          it != stateHistory.end( );
-          it++ )
+    const std::size_t numberOfComponents = StateHistory::numberOfComponents;
+    boost::array< const double*, StateHistory::numberOfComponents > components;
+    for ( std::size_t j = 0; j < numberOfComponents; j++ )
     {
-        stream << std::setprecision( precision )
-               << it->first       << ",";
+        components[ j ] = stateHistory.getComponent( j );
+    }
+
+    stream << std::setprecision( precision );
+    for ( std::size_t i = 0; i < stateHistory.size( ); i++ )
+    {
+        stream << stateHistory.getTime( i ) << ",";
 
-        for ( unsigned int i = 0; i < it->second.size( ) - 1; i++ )
+        for ( std::size_t j = 0; j < numberOfComponents - 1; j++ )
         {
-            stream << it->second[ i ] << ",";
+            stream << components[ j ][ i ] << ",";
         }
-        stream << it->second[ it->second.size( ) - 1 ] << std::endl;
+        stream << components[ numberOfComponents - 1 ][ i ] << "\n";
     }
+    stream.flush( );
 }
 
 } // namespace scarab
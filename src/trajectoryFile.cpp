@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+
+#include <rapidjson/document.h>
+
+#include "Scarab/internalTools.hpp"
+#include "Scarab/trajectoryFile.hpp"
+
+namespace scarab
+{
+
+//! Magic string at start of trajectory file.
+static const char trajectoryFileMagic[ ] = "SCARABTR";
+
+//! Size of fixed prefix of trajectory file (magic, version, header length, number of rows).
+static const std::size_t trajectoryFilePrefixSize = 24;
+
+//! Alignment of data in trajectory file [bytes].
+static const std::size_t trajectoryFileAlignment = 64;
+
+//! Number of columns in trajectory file.
+static const std::size_t numberOfColumns = 7;
+
+//! Names of columns in trajectory file.
+static const char* const columnNames[ numberOfColumns ] = { "t", "x", "y", "z", "vx", "vy", "vz" };
+
+//! Units of columns in trajectory file.
+static const char* const columnUnits[ numberOfColumns ]
+    = { "s", "km", "km", "km", "km s^-1", "km s^-1", "km s^-1" };
+
+//! Construct binary writer.
+BinaryStateHistoryWriter::BinaryStateHistoryWriter( const std::string& aFilename,
+                                                    const std::size_t aChunkSize,
+                                                    const bool isResumed )
+    : filename( aFilename ),
+      chunkSize( aChunkSize ),
+      buffer( aChunkSize * numberOfColumns ),
+      numberOfBufferedSamples( 0 ),
+      numberOfSamples( 0 ),
+      isClosed( false )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error( "ERROR: Binary trajectory files require little-endian host!" );
+    }
+
+    if ( chunkSize == 0 )
+    {
+        throw std::runtime_error( "ERROR: Chunk size of state history writer must be positive!" );
+    }
+
+    // Opening the spill files for reading and writing fails if they do not exist, and does not
+    // truncate them.
+    const std::ios::openmode mode
+        = isResumed ? std::ios::binary | std::ios::in | std::ios::out
+                    : std::ios::binary | std::ios::trunc;
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        spillFiles[ i ].open( getSpillFilename( i ).c_str( ), mode );
+        if ( !spillFiles[ i ] )
+        {
+            throw std::runtime_error( "ERROR: Could not open spill file for \"" + filename
+                                      + "\"!" );
+        }
+    }
+}
+
+//! Destruct binary writer.
+BinaryStateHistoryWriter::~BinaryStateHistoryWriter( )
+{
+    if ( !isClosed )
+    {
+        try
+        {
+            close( TrajectoryMetadata( ) );
+        }
+        catch ( ... ) { }
+    }
+}
+
+//! Write sample.
+void BinaryStateHistoryWriter::write( const double time, const State& state )
+{
+    if ( isClosed )
+    {
+        throw std::runtime_error( "ERROR: Binary state history writer is closed!" );
+    }
+
+    buffer[ numberOfBufferedSamples ] = time;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        buffer[ ( i + 1 ) * chunkSize + numberOfBufferedSamples ] = state[ i ];
+    }
+
+    numberOfBufferedSamples++;
+    numberOfSamples++;
+
+    if ( numberOfBufferedSamples == chunkSize )
+    {
+        writeChunk( );
+    }
+}
+
+//! Flush sink.
+void BinaryStateHistoryWriter::flush( )
+{
+    writeChunk( );
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        spillFiles[ i ].flush( );
+    }
+}
+
+//! Close writer.
+void BinaryStateHistoryWriter::close( const TrajectoryMetadata& metadata )
+{
+    if ( isClosed )
+    {
+        return;
+    }
+
+    writeChunk( );
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        spillFiles[ i ].close( );
+    }
+    isClosed = true;
+
+    // Assemble header, padded such that the data starts at an aligned offset.
+    std::ostringstream header;
+    header << "{\"columns\":[";
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        header << ( i > 0 ? "," : "" )
+               << "{\"name\":\"" << columnNames[ i ] << "\",\"units\":\"" << columnUnits[ i ]
+               << "\"}";
+    }
+    header << "],\"metadata\":[";
+    char value[ 32 ];
+    for ( std::size_t i = 0; i < metadata.size( ); i++ )
+    {
+        std::snprintf( value, sizeof( value ), "%.17g", metadata[ i ].value );
+        header << ( i > 0 ? "," : "" )
+               << "{\"name\":\"" << escapeJsonString( metadata[ i ].name )
+               << "\",\"value\":" << value
+               << ",\"units\":\"" << escapeJsonString( metadata[ i ].units ) << "\"}";
+    }
+    header << "]}";
+
+    std::string headerText = header.str( );
+    const std::size_t unpaddedSize = trajectoryFilePrefixSize + headerText.size( );
+    headerText.append( ( trajectoryFileAlignment - unpaddedSize % trajectoryFileAlignment )
+                       % trajectoryFileAlignment, ' ' );
+
+    std::ofstream file( filename.c_str( ), std::ios::binary | std::ios::trunc );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not open trajectory file \"" + filename + "\"!" );
+    }
+
+    file.write( trajectoryFileMagic, 8 );
+    writeLittleEndian( file, trajectoryFileVersion, 4 );
+    writeLittleEndian( file, headerText.size( ), 4 );
+    writeLittleEndian( file, numberOfSamples, 8 );
+    file.write( headerText.data( ), headerText.size( ) );
+
+    // Concatenate columns from spill files.
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        {
+            std::ifstream spillFile( getSpillFilename( i ).c_str( ), std::ios::binary );
+            if ( numberOfSamples > 0 )
+            {
+                file << spillFile.rdbuf( );
+            }
+        }
+        std::remove( getSpillFilename( i ).c_str( ) );
+    }
+
+    file.close( );
+    if ( !file )
+    {
+        throw std::runtime_error( "ERROR: Could not write trajectory file \"" + filename + "\"!" );
+    }
+}
+
+//! Write checkpoint.
+void BinaryStateHistoryWriter::writeCheckpoint( Checkpoint& checkpoint )
+{
+    flush( );
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        if ( !spillFiles[ i ] )
+        {
+            throw std::runtime_error( "ERROR: Could not write spill file for \"" + filename
+                                      + "\"!" );
+        }
+    }
+
+    checkpoint.writeSize( numberOfSamples );
+}
+
+//! Restore checkpoint.
+void BinaryStateHistoryWriter::restoreCheckpoint( Checkpoint& checkpoint )
+{
+    numberOfSamples = checkpoint.readSize( );
+    numberOfBufferedSamples = 0;
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        spillFiles[ i ].seekp(
+            static_cast< std::streamoff >( numberOfSamples * sizeof( double ) ) );
+        if ( !spillFiles[ i ] )
+        {
+            throw std::runtime_error( "ERROR: Could not restore spill file for \"" + filename
+                                      + "\"!" );
+        }
+    }
+}
+
+//! Write buffered samples to spill files.
+void BinaryStateHistoryWriter::writeChunk( )
+{
+    if ( numberOfBufferedSamples == 0 )
+    {
+        return;
+    }
+
+    for ( std::size_t i = 0; i < numberOfColumns; i++ )
+    {
+        spillFiles[ i ].write( reinterpret_cast< const char* >( &buffer[ i * chunkSize ] ),
+                               numberOfBufferedSamples * sizeof( double ) );
+    }
+    numberOfBufferedSamples = 0;
+}
+
+//! Get spill filename of column.
+std::string BinaryStateHistoryWriter::getSpillFilename( const std::size_t column ) const
+{
+    return filename + "." + columnNames[ column ] + ".tmp";
+}
+
+//! Construct reader.
+TrajectoryFileReader::TrajectoryFileReader( const std::string& filename )
+    : file( filename.c_str( ), boost::interprocess::read_only ),
+      region( file, boost::interprocess::read_only ),
+      numberOfRows( 0 ),
+      data( 0 )
+{
+    if ( !isLittleEndian( ) )
+    {
+        throw std::runtime_error( "ERROR: Binary trajectory files require little-endian host!" );
+    }
+
+    const unsigned char* bytes = static_cast< const unsigned char* >( region.get_address( ) );
+    const std::size_t fileSize = region.get_size( );
+
+    if ( fileSize < trajectoryFilePrefixSize
+         || std::memcmp( bytes, trajectoryFileMagic, 8 ) != 0 )
+    {
+        throw std::runtime_error( "ERROR: \"" + filename + "\" is not a trajectory file!" );
+    }
+
+    const boost::uint64_t version = readLittleEndian( bytes + 8, 4 );
+    if ( version != trajectoryFileVersion )
+    {
+        std::ostringstream error;
+        error << "ERROR: Trajectory file version " << version << " is not supported!";
+        throw std::runtime_error( error.str( ) );
+    }
+
+    const std::size_t headerSize = static_cast< std::size_t >( readLittleEndian( bytes + 12, 4 ) );
+    numberOfRows = static_cast< std::size_t >( readLittleEndian( bytes + 16, 8 ) );
+    if ( fileSize < trajectoryFilePrefixSize + headerSize )
+    {
+        throw std::runtime_error( "ERROR: Header of trajectory file \"" + filename
+                                  + "\" is truncated!" );
+    }
+
+    // Parse header.
+    const std::string headerText(
+        reinterpret_cast< const char* >( bytes + trajectoryFilePrefixSize ), headerSize );
+    rapidjson::Document header;
+    header.Parse( headerText.c_str( ) );
+    if ( header.HasParseError( ) || !header.IsObject( )
+         || !header.HasMember( "columns" ) || !header.HasMember( "metadata" ) )
+    {
+        throw std::runtime_error( "ERROR: Header of trajectory file \"" + filename
+                                  + "\" is invalid!" );
+    }
+
+    const rapidjson::Value& columns = header[ "columns" ];
+    for ( rapidjson::SizeType i = 0; i < columns.Size( ); i++ )
+    {
+        columnNames.push_back( columns[ i ][ "name" ].GetString( ) );
+        columnUnits.push_back( columns[ i ][ "units" ].GetString( ) );
+    }
+
+    const rapidjson::Value& metadataEntries = header[ "metadata" ];
+    for ( rapidjson::SizeType i = 0; i < metadataEntries.Size( ); i++ )
+    {
+        const rapidjson::Value& entry = metadataEntries[ i ];
+        metadata.push_back( TrajectoryMetadataEntry( entry[ "name" ].GetString( ),
+                                                     entry[ "value" ].GetDouble( ),
+                                                     entry[ "units" ].GetString( ) ) );
+    }
+
+    const std::size_t dataOffset = trajectoryFilePrefixSize + headerSize;
+    if ( fileSize < dataOffset + columnNames.size( ) * numberOfRows * sizeof( double ) )
+    {
+        throw std::runtime_error( "ERROR: Data of trajectory file \"" + filename
+                                  + "\" is truncated!" );
+    }
+    data = reinterpret_cast< const double* >( bytes + dataOffset );
+}
+
+//! Get column.
+const double* TrajectoryFileReader::getColumn( const std::size_t column ) const
+{
+    if ( column >= columnNames.size( ) )
+    {
+        throw std::runtime_error( "ERROR: Column index out of range for trajectory file!" );
+    }
+    return data + column * numberOfRows;
+}
+
+//! Get column.
+const double* TrajectoryFileReader::getColumn( const std::string& columnName ) const
+{
+    for ( std::size_t i = 0; i < columnNames.size( ); i++ )
+    {
+        if ( columnNames[ i ] == columnName )
+        {
+            return getColumn( i );
+        }
+    }
+    throw std::runtime_error( "ERROR: Column \"" + columnName
+                              + "\" not found in trajectory file!" );
+}
+
+//! Get state.
+State TrajectoryFileReader::getState( const std::size_t row ) const
+{
+    static const char* const stateColumnNames[ ] = { "x", "y", "z", "vx", "vy", "vz" };
+
+    State state;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        state[ i ] = getColumn( stateColumnNames[ i ] )[ row ];
+    }
+    return state;
+}
+
+} // namespace scarab
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef SCARAB_SIMULATOR_TEST_SETTINGS_HPP
+#define SCARAB_SIMULATOR_TEST_SETTINGS_HPP
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Scarab/simulatorSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get initial state on low Earth orbit used by default in simulator test settings.
+inline State getTestInitialState( )
+{
+    State state;
+    state[ 0 ] = 7000.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.0;
+    state[ 4 ] = 7.5;
+    state[ 5 ] = 1.0;
+    return state;
+}
+
+//! Create output settings for CSV output without files, at given state history interval.
+inline boost::shared_ptr< const OutputSettings > createTestOutputSettings(
+    const double stateHistoryInterval )
+{
+    return boost::make_shared< OutputSettings >( "",
+                                                 "",
+                                                 1,
+                                                 csvStateHistoryFormat,
+                                                 stateHistoryInterval,
+                                                 std::vector< double >( ),
+                                                 ChebyshevTrajectorySettings( 0.0, 0.0, 0 ),
+                                                 "" );
+}
+
+//! Simulator test settings.
+/*!
+ * Settings of a short run in low Earth orbit under central gravity only, with all other models
+ * and modes switched off and no output files. The settings are held by pointer, since the
+ * settings structs cannot be assigned, so that a test only replaces the settings it needs before
+ * creating the simulator settings, e.g.:
+ *
+ *     SimulatorTestSettings testSettings;
+ *     testSettings.enckeSettings = boost::make_shared< EnckeSettings >( true, 0.01, 60.0 );
+ *     const SimulatorSettings settings = testSettings.create( );
+ */
+struct SimulatorTestSettings
+{
+public:
+
+    //! Construct default simulator test settings.
+    SimulatorTestSettings( )
+    {
+        const State initialState = getTestInitialState( );
+
+        Position vectorToSource;
+        vectorToSource.fill( 0.0 );
+
+        integratorSettings = boost::make_shared< IntegratorSettings >( initialState,
+                                                                       0.0,
+                                                                       600.0,
+                                                                       10.0,
+                                                                       dormandPrince5Integrator,
+                                                                       1.0e-6,
+                                                                       1.0e-6,
+                                                                       600.0 );
+        chaserSettings = boost::make_shared< ChaserSettings >( 100.0 );
+        targetSettings = boost::make_shared< TargetSettings >(
+            1000.0,
+            std::numeric_limits< double >::signaling_NaN( ),
+            std::numeric_limits< double >::signaling_NaN( ),
+            initialState );
+        centralGravitySettings = boost::make_shared< CentralGravitySettings >( true, 398600.4418 );
+        radiationPressureSettings = boost::make_shared< RadiationPressureSettings >(
+            false, 0.0, 0.0, vectorToSource, 0.0, noShadowModel, 0.0, 0.0, "" );
+        sphericalHarmonicsSettings = boost::make_shared< SphericalHarmonicsSettings >(
+            false,
+            "",
+            SphericalHarmonicsCoefficients( 0, 0 ),
+            0.0,
+            0.0,
+            GravityInterpolationSettings( false, 0.0, 0.0, 0 ) );
+        dragSettings = boost::make_shared< DragSettings >(
+            false, 0.0, 0.0, "", AtmosphereTable( ), 0.0, 0.0 );
+        ephemerisSettings = boost::make_shared< EphemerisSettings >( "", ChebyshevEphemerisPtr( ) );
+        thirdBodySettings = boost::make_shared< ThirdBodySettings >(
+            false, std::vector< std::string >( ) );
+        outputSettings = createTestOutputSettings( 0.0 );
+        ensembleSettings = boost::make_shared< EnsembleSettings >(
+            false, 0, 0, 0, initialState, "" );
+        listOfModelNames.push_back( "central_gravity" );
+        eventSettings = boost::make_shared< EventSettings >( "", "", ListOfEventDefinitions( ) );
+        relativeMotionSettings = boost::make_shared< RelativeMotionSettings >( false, 0.0 );
+        enckeSettings = boost::make_shared< EnckeSettings >( false, 0.0, 0.0 );
+        checkpointSettings = boost::make_shared< CheckpointSettings >( false, "", 0.0 );
+        sweepSettings = boost::make_shared< SweepSettings >( false,
+                                                             gridSweepMethod,
+                                                             0,
+                                                             1,
+                                                             0,
+                                                             ListOfSweepParameterDefinitions( ),
+                                                             "" );
+    }
+
+    //! Create simulator settings.
+    SimulatorSettings create( ) const
+    {
+        return SimulatorSettings( *integratorSettings,
+                                  *chaserSettings,
+                                  *targetSettings,
+                                  *centralGravitySettings,
+                                  *radiationPressureSettings,
+                                  *sphericalHarmonicsSettings,
+                                  *dragSettings,
+                                  *ephemerisSettings,
+                                  *thirdBodySettings,
+                                  *outputSettings,
+                                  *ensembleSettings,
+                                  listOfModelNames,
+                                  *eventSettings,
+                                  *relativeMotionSettings,
+                                  *enckeSettings,
+                                  *checkpointSettings,
+                                  *sweepSettings );
+    }
+
+    //! Numerical integrator settings.
+    boost::shared_ptr< const IntegratorSettings > integratorSettings;
+
+    //! Chaser settings.
+    boost::shared_ptr< const ChaserSettings > chaserSettings;
+
+    //! Target settings.
+    boost::shared_ptr< const TargetSettings > targetSettings;
+
+    //! Central gravity model settings.
+    boost::shared_ptr< const CentralGravitySettings > centralGravitySettings;
+
+    //! Radiation pressure model settings.
+    boost::shared_ptr< const RadiationPressureSettings > radiationPressureSettings;
+
+    //! Spherical harmonics gravity model settings.
+    boost::shared_ptr< const SphericalHarmonicsSettings > sphericalHarmonicsSettings;
+
+    //! Drag model settings.
+    boost::shared_ptr< const DragSettings > dragSettings;
+
+    //! Ephemeris settings.
+    boost::shared_ptr< const EphemerisSettings > ephemerisSettings;
+
+    //! Third-body gravity model settings.
+    boost::shared_ptr< const ThirdBodySettings > thirdBodySettings;
+
+    //! Output settings.
+    boost::shared_ptr< const OutputSettings > outputSettings;
+
+    //! Ensemble settings.
+    boost::shared_ptr< const EnsembleSettings > ensembleSettings;
+
+    //! List of acceleration model names.
+    ListOfModelNames listOfModelNames;
+
+    //! Event settings.
+    boost::shared_ptr< const EventSettings > eventSettings;
+
+    //! Relative motion settings.
+    boost::shared_ptr< const RelativeMotionSettings > relativeMotionSettings;
+
+    //! Encke settings.
+    boost::shared_ptr< const EnckeSettings > enckeSettings;
+
+    //! Checkpoint settings.
+    boost::shared_ptr< const CheckpointSettings > checkpointSettings;
+
+    //! Parameter sweep settings.
+    boost::shared_ptr< const SweepSettings > sweepSettings;
+
+protected:
+
+private:
+};
+
+} // namespace tests
+} // namespace scarab
+
+#endif // SCARAB_SIMULATOR_TEST_SETTINGS_HPP
@@ -21,8 +21,12 @@ namespace tests
 
 TEST_CASE( "Test definition acceleration model IDs", "[acceleration_models]" )
 {
-    REQUIRE( centralGravityModelId        == 0 );
-    REQUIRE( radiationPressureModelId     == 1 );
+    REQUIRE( centralGravityModelId              == 0 );
+    REQUIRE( radiationPressureModelId           == 1 );
+    REQUIRE( sphericalHarmonicsGravityModelId   == 2 );
+    REQUIRE( dragModelId                        == 3 );
+    REQUIRE( thirdBodyGravityModelId            == 4 );
+    REQUIRE( numberOfAccelerationModelIds       == 5 );
 }
 
 TEST_CASE( "Test definition of acceleration model list typedef",
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/accelerationModelRegistry.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/simulatorSettings.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create simulator settings with given list of acceleration models.
+SimulatorSettings createRegistryTestSettings( const ListOfModelNames& listOfModelNames )
+{
+    SimulatorTestSettings testSettings;
+    testSettings.listOfModelNames = listOfModelNames;
+    return testSettings.create( );
+}
+
+TEST_CASE( "Test acceleration model registry", "[acceleration_models]" )
+{
+    REQUIRE( findAccelerationModel( "central_gravity" ).id == centralGravityModelId );
+    REQUIRE( findAccelerationModel( "radiation_pressure" ).id == radiationPressureModelId );
+    REQUIRE( findAccelerationModel( "spherical_harmonics_gravity" ).id
+             == sphericalHarmonicsGravityModelId );
+    REQUIRE( findAccelerationModel( "atmospheric_drag" ).id == dragModelId );
+    REQUIRE( findAccelerationModel( "third_body_gravity" ).id == thirdBodyGravityModelId );
+    REQUIRE_THROWS_AS( findAccelerationModel( "unknown_model" ), std::runtime_error );
+
+    REQUIRE( getAccelerationModelName( centralGravityModelId ) == "central_gravity" );
+    REQUIRE( getAccelerationModelName( thirdBodyGravityModelId ) == "third_body_gravity" );
+    REQUIRE( getAccelerationModelName( findAccelerationModel( "atmospheric_drag" ).id )
+             == "atmospheric_drag" );
+}
+
+TEST_CASE( "Test generation of acceleration model list from model names",
+           "[acceleration_models]" )
+{
+    ListOfModelNames listOfModelNames;
+    listOfModelNames.push_back( "central_gravity" );
+    const SimulatorSettings settings = createRegistryTestSettings( listOfModelNames );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( settings.integratorSettings.initialState, 0.0, 398600.4418,
+                    listOfAccelerationModels );
+    generateAccelerationModelList( settings, data );
+
+    REQUIRE( data.listOfAccelerationModels.size( ) == 1 );
+    REQUIRE( data.listOfAccelerationModels.count( centralGravityModelId ) == 1 );
+
+    // Models listed more than once are rejected.
+    listOfModelNames.push_back( "central_gravity" );
+    ListOfAccelerationModels otherListOfAccelerationModels;
+    DataStore otherData( settings.integratorSettings.initialState, 0.0, 398600.4418,
+                         otherListOfAccelerationModels );
+    REQUIRE_THROWS_AS(
+        generateAccelerationModelList( createRegistryTestSettings( listOfModelNames ), otherData ),
+        std::runtime_error );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+/*!
+ * Tests that count heap allocations. They are built as a separate test executable, since counting
+ * requires replacing the global allocation functions, which would otherwise apply to every test.
+ */
+
+#define CATCH_CONFIG_MAIN
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <boost/make_shared.hpp>
+#include <boost/numeric/odeint.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Number of heap allocations made by allocation test executable.
+std::atomic< std::size_t > numberOfHeapAllocations( 0 );
+
+} // namespace tests
+} // namespace scarab
+
+//! Count heap allocations, to verify that the right-hand-side evaluations are allocation-free.
+/*!
+ * The replacement allocation functions are not inlined, so that the compiler does not pair
+ * malloc() and free() with operator new and operator delete across call sites.
+ */
+#ifdef __GNUC__
+__attribute__( ( noinline ) )
+#endif
+void* operator new( std::size_t size )
+{
+    scarab::tests::numberOfHeapAllocations++;
+    void* memory = std::malloc( size == 0 ? 1 : size );
+    if ( memory == 0 )
+    {
+        throw std::bad_alloc( );
+    }
+    return memory;
+}
+
+//! Release memory allocated by counting operator new.
+#ifdef __GNUC__
+__attribute__( ( noinline ) )
+#endif
+void operator delete( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Observer that counts integration steps without allocating memory.
+struct StepCounter
+{
+    StepCounter( std::size_t& aNumberOfSteps )
+        : numberOfSteps( aNumberOfSteps )
+    { }
+
+    void operator( )( const State& /* state */, const double /* time */ )
+    {
+        numberOfSteps++;
+    }
+
+    std::size_t& numberOfSteps;
+};
+
+TEST_CASE( "Test state derivative model does not allocate during integration",
+           "[simulator],[state_derivative_model]" )
+{
+    State initialState;
+    initialState[ 0 ] = 7000.0;
+    initialState[ 1 ] = 0.0;
+    initialState[ 2 ] = 0.0;
+    initialState[ 3 ] = 0.0;
+    initialState[ 4 ] = 7.5;
+    initialState[ 5 ] = 1.0;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    StateDerivativeModel stateDerivativeModel( data );
+
+    const long useCount = data.listOfAccelerationModels[ centralGravityModelId ].use_count( );
+
+    State state = initialState;
+    std::size_t numberOfSteps = 0;
+    const std::size_t numberOfAllocationsBefore = numberOfHeapAllocations;
+    boost::numeric::odeint::integrate( stateDerivativeModel,
+                                       state,
+                                       0.0,
+                                       6000.0,
+                                       10.0,
+                                       StepCounter( numberOfSteps ) );
+    const std::size_t numberOfAllocationsAfter = numberOfHeapAllocations;
+
+    REQUIRE( numberOfSteps > 10 );
+    REQUIRE( numberOfAllocationsAfter == numberOfAllocationsBefore );
+    REQUIRE( data.listOfAccelerationModels[ centralGravityModelId ].use_count( ) == useCount );
+}
+
+} // namespace tests
+} // namespace scarab
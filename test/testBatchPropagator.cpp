@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/numeric/odeint.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/batchPropagator.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create initial states on a set of low Earth orbits with varying inclination.
+std::vector< State > createBatchTestStates( const unsigned int numberOfStates )
+{
+    std::vector< State > states( numberOfStates );
+    for ( unsigned int i = 0; i < numberOfStates; i++ )
+    {
+        const double inclination = 0.01 * i;
+        states[ i ][ 0 ] = 7000.0 + i;
+        states[ i ][ 1 ] = 0.0;
+        states[ i ][ 2 ] = 0.0;
+        states[ i ][ 3 ] = 0.0;
+        states[ i ][ 4 ] = 7.5 * std::cos( inclination );
+        states[ i ][ 5 ] = 7.5 * std::sin( inclination );
+    }
+    return states;
+}
+
+TEST_CASE( "Test batch of states structure-of-arrays layout", "[batch]" )
+{
+    BatchState batch( 5 );
+    REQUIRE( batch.size( ) == 5 );
+    REQUIRE( batch.paddedSize( ) == 8 );
+
+    State state;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        state[ i ] = i + 1.0;
+    }
+    batch.setState( 3, state );
+
+    REQUIRE( batch.getState( 3 ) == state );
+    REQUIRE( batch[ 2 ][ 3 ] == 3.0 );
+    REQUIRE( reinterpret_cast< std::size_t >( batch[ 0 ] ) % 64 == 0 );
+    REQUIRE( reinterpret_cast< std::size_t >( batch[ 5 ] ) % 64 == 0 );
+
+    const BatchState copy( batch );
+    REQUIRE( copy.getState( 3 ) == state );
+    REQUIRE( reinterpret_cast< std::size_t >( copy[ 0 ] ) % 64 == 0 );
+}
+
+TEST_CASE( "Test fixed-step batch propagation against odeint", "[batch]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const std::vector< State > initialStates = createBatchTestStates( 11 );
+
+    BatchState batch( initialStates.size( ) );
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        batch.setState( i, initialStates[ i ] );
+    }
+
+    ListOfBatchAccelerationModels models;
+    models.push_back( boost::make_shared< BatchCentralGravityModel >( gravitationalParameter ) );
+    BatchPropagator propagator( models, batch.size( ) );
+    const BatchPropagationStatistics statistics
+        = propagator.propagateFixedStep( batch, 0.0, 1000.0, 10.0 );
+
+    REQUIRE( statistics.numberOfBatchSteps == 100 );
+
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        ListOfAccelerationModels listOfAccelerationModels;
+        DataStore data( initialStates[ i ], 0.0, gravitationalParameter, listOfAccelerationModels );
+        data.listOfAccelerationModels[ centralGravityModelId ]
+            = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+        StateDerivativeModel stateDerivativeModel( data );
+
+        State state = initialStates[ i ];
+        boost::numeric::odeint::integrate_const(
+            boost::numeric::odeint::runge_kutta4< State >( ),
+            stateDerivativeModel, state, 0.0, 1000.0, 10.0 );
+
+        const State batchState = batch.getState( i );
+        for ( unsigned int j = 0; j < state.size( ); j++ )
+        {
+            REQUIRE( batchState[ j ] == Approx( state[ j ] ).epsilon( 1.0e-10 ) );
+        }
+    }
+}
+
+TEST_CASE( "Test adaptive batch propagation with lane-wise error control", "[batch]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    std::vector< State > initialStates = createBatchTestStates( 9 );
+
+    // Make one lane much harder to integrate (eccentric orbit), so lanes need different steps.
+    initialStates[ 4 ][ 4 ] = 9.5;
+
+    BatchState batch( initialStates.size( ) );
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        batch.setState( i, initialStates[ i ] );
+    }
+
+    ListOfBatchAccelerationModels models;
+    models.push_back( boost::make_shared< BatchCentralGravityModel >( gravitationalParameter ) );
+    BatchPropagator propagator( models, batch.size( ) );
+    const BatchPropagationStatistics statistics
+        = propagator.propagateAdaptive( batch, 0.0, 6000.0, 10.0, 1.0e-12, 1.0e-12 );
+
+    REQUIRE( statistics.numberOfAcceptedSteps > 0 );
+
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        // Reference solution with tight tolerances.
+        ListOfAccelerationModels listOfAccelerationModels;
+        DataStore data( initialStates[ i ], 0.0, gravitationalParameter, listOfAccelerationModels );
+        data.listOfAccelerationModels[ centralGravityModelId ]
+            = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+        StateDerivativeModel stateDerivativeModel( data );
+
+        State state = initialStates[ i ];
+        boost::numeric::odeint::integrate_adaptive(
+            boost::numeric::odeint::make_controlled(
+                1.0e-14, 1.0e-14, boost::numeric::odeint::runge_kutta_dopri5< State >( ) ),
+            stateDerivativeModel, state, 0.0, 6000.0, 10.0 );
+
+        const State batchState = batch.getState( i );
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            REQUIRE( std::fabs( batchState[ j ] - state[ j ] ) < 1.0e-6 );
+        }
+        for ( unsigned int j = 3; j < 6; j++ )
+        {
+            REQUIRE( std::fabs( batchState[ j ] - state[ j ] ) < 1.0e-9 );
+        }
+    }
+}
+
+TEST_CASE( "Test batch propagation with invalid inputs", "[batch]" )
+{
+    BatchState batch( 3 );
+    const std::vector< State > initialStates = createBatchTestStates( batch.size( ) );
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        batch.setState( i, initialStates[ i ] );
+    }
+
+    ListOfBatchAccelerationModels models;
+    models.push_back( boost::make_shared< BatchCentralGravityModel >( 398600.4418 ) );
+    BatchPropagator propagator( models, batch.size( ) );
+
+    SECTION( "Fixed step" )
+    {
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( batch, 0.0, 100.0, 0.0 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( batch, 0.0, 100.0, -10.0 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( batch, 100.0, 100.0, 10.0 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( batch, 100.0, 0.0, 10.0 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( batch, 1.0e10, 1.0e10 + 1.0, 1.0e-9 ),
+                           std::runtime_error );
+    }
+
+    SECTION( "Adaptive step" )
+    {
+        REQUIRE_THROWS_AS( propagator.propagateAdaptive( batch, 0.0, 100.0, 0.0, 1.0e-9, 1.0e-9 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS(
+            propagator.propagateAdaptive( batch, 100.0, 100.0, 10.0, 1.0e-9, 1.0e-9 ),
+            std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateAdaptive( batch, 100.0, 0.0, 10.0, 1.0e-9, 1.0e-9 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateAdaptive( batch, 0.0, 100.0, 10.0, 0.0, 1.0e-9 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( propagator.propagateAdaptive( batch, 0.0, 100.0, 10.0, 1.0e-9, -1.0 ),
+                           std::runtime_error );
+    }
+
+    SECTION( "Mismatching batch size" )
+    {
+        BatchState largerBatch( 9 );
+        REQUIRE_THROWS_AS( propagator.propagateFixedStep( largerBatch, 0.0, 100.0, 10.0 ),
+                           std::runtime_error );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state on inclined circular test orbit at given time.
+State getChebyshevTestOrbitState( const double time )
+{
+    const double radius = 7000.0;
+    const double meanMotion = std::sqrt( 398600.4418 / ( radius * radius * radius ) );
+    const double inclination = 0.9;
+    const double angle = meanMotion * time;
+
+    State state;
+    state[ 0 ] = radius * std::cos( angle );
+    state[ 1 ] = radius * std::sin( angle ) * std::cos( inclination );
+    state[ 2 ] = radius * std::sin( angle ) * std::sin( inclination );
+    state[ 3 ] = -radius * meanMotion * std::sin( angle );
+    state[ 4 ] = radius * meanMotion * std::cos( angle ) * std::cos( inclination );
+    state[ 5 ] = radius * meanMotion * std::cos( angle ) * std::sin( inclination );
+    return state;
+}
+
+TEST_CASE( "Test Chebyshev trajectory round trip", "[output],[chebyshev_trajectory]" )
+{
+    const std::string filename = "testChebyshevTrajectory.bin";
+    const double positionTolerance = 1.0e-6;
+    const double velocityTolerance = 1.0e-9;
+
+    TrajectoryMetadata metadata;
+    metadata.push_back( TrajectoryMetadataEntry( "start_time", 0.0, "s" ) );
+
+    // Sample two revolutions every 10 s.
+    const unsigned int numberOfSamples = 1171;
+    std::size_t numberOfSegments = 0;
+    {
+        ChebyshevTrajectoryWriter writer(
+            filename, positionTolerance, velocityTolerance, 14, 1024 );
+        for ( unsigned int i = 0; i < numberOfSamples; i++ )
+        {
+            writer.write( 10.0 * i, getChebyshevTestOrbitState( 10.0 * i ) );
+        }
+        writer.close( metadata );
+        numberOfSegments = writer.getNumberOfSegments( );
+
+        REQUIRE( writer.getNumberOfSamples( ) == numberOfSamples );
+        REQUIRE( writer.getMaximumPositionError( ) <= positionTolerance );
+        REQUIRE( writer.getMaximumVelocityError( ) <= velocityTolerance );
+        REQUIRE_THROWS( writer.write( 1.0e5, getChebyshevTestOrbitState( 1.0e5 ) ) );
+    }
+
+    // The coefficients take far less space than the samples.
+    REQUIRE( numberOfSegments > 1 );
+    REQUIRE( numberOfSegments < numberOfSamples / 20 );
+    std::ifstream file( filename.c_str( ), std::ios::binary | std::ios::ate );
+    REQUIRE( static_cast< std::size_t >( file.tellg( ) )
+             < numberOfSamples * 7 * sizeof( double ) / 10 );
+    file.close( );
+
+    {
+        const ChebyshevTrajectory trajectory( filename );
+
+        REQUIRE( trajectory.getNumberOfSegments( ) == numberOfSegments );
+        REQUIRE( trajectory.getNumberOfCoefficients( ) == 14 );
+        REQUIRE( trajectory.getStartTime( ) == 0.0 );
+        REQUIRE( trajectory.getEndTime( ) == 10.0 * ( numberOfSamples - 1 ) );
+        REQUIRE( trajectory.getPositionTolerance( ) == positionTolerance );
+        REQUIRE( trajectory.getVelocityTolerance( ) == velocityTolerance );
+        REQUIRE( trajectory.getMetadata( ).size( ) == 1 );
+        REQUIRE( trajectory.getMetadata( )[ 0 ].name == "start_time" );
+
+        // States in between samples are reproduced to about the tolerances.
+        for ( unsigned int i = 0; i < 10 * ( numberOfSamples - 1 ); i++ )
+        {
+            const double time = 1.0 * i + 0.5;
+            const State state = trajectory.getState( time );
+            const State expectedState = getChebyshevTestOrbitState( time );
+            for ( unsigned int j = 0; j < 3; j++ )
+            {
+                REQUIRE( state[ j ] == Approx( expectedState[ j ] ).margin( 2.0e-6 ) );
+                REQUIRE( state[ j + 3 ] == Approx( expectedState[ j + 3 ] ).margin( 2.0e-9 ) );
+            }
+
+            const Position position = trajectory.getPosition( time );
+            REQUIRE( position[ 0 ] == state[ 0 ] );
+        }
+
+        // Segments are found in order and cover the whole time span.
+        std::size_t previousSegment = 0;
+        for ( unsigned int i = 0; i < numberOfSamples; i++ )
+        {
+            const std::size_t segment = trajectory.findSegment( 10.0 * i );
+            REQUIRE( ( segment == previousSegment || segment == previousSegment + 1 ) );
+            previousSegment = segment;
+        }
+        REQUIRE( trajectory.findSegment( 0.0 ) == 0 );
+        REQUIRE( trajectory.findSegment( trajectory.getEndTime( ) ) == numberOfSegments - 1 );
+
+        REQUIRE_THROWS( trajectory.getState( -1.0 ) );
+        REQUIRE_THROWS( trajectory.getState( trajectory.getEndTime( ) + 1.0 ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test Chebyshev trajectory with discontinuity", "[output],[chebyshev_trajectory]" )
+{
+    const std::string filename = "testChebyshevTrajectoryDiscontinuity.bin";
+
+    // Impulsive manoeuvre at t = 1000 s, modelled as a jump in the velocity.
+    State velocityIncrement;
+    velocityIncrement.fill( 0.0 );
+    velocityIncrement[ 4 ] = 0.01;
+    {
+        ChebyshevTrajectoryWriter writer( filename, 1.0e-6, 1.0e-9, 12, 1024 );
+        for ( unsigned int i = 0; i <= 100; i++ )
+        {
+            writer.write( 10.0 * i, getChebyshevTestOrbitState( 10.0 * i ) );
+        }
+
+        // Repeated samples are skipped.
+        writer.write( 1000.0, getChebyshevTestOrbitState( 1000.0 ) );
+
+        State state = getChebyshevTestOrbitState( 1000.0 );
+        for ( unsigned int j = 0; j < state.size( ); j++ )
+        {
+            state[ j ] += velocityIncrement[ j ];
+        }
+        writer.write( 1000.0, state );
+        writer.write( 1010.0, state );
+        writer.write( 1020.0, state );
+        REQUIRE_THROWS( writer.write( 1015.0, state ) );
+        REQUIRE( writer.getNumberOfSamples( ) == 104 );
+        writer.close( TrajectoryMetadata( ) );
+    }
+
+    {
+        const ChebyshevTrajectory trajectory( filename );
+        const std::size_t segment = trajectory.findSegment( 1000.0 );
+        REQUIRE( segment > 0 );
+        REQUIRE( trajectory.findSegment( 999.0 ) == segment - 1 );
+
+        // The state at the manoeuvre is the state after the manoeuvre.
+        REQUIRE( trajectory.getState( 1000.0 )[ 4 ]
+                 == Approx( getChebyshevTestOrbitState( 1000.0 )[ 4 ] + 0.01 ).margin( 1.0e-9 ) );
+        REQUIRE( trajectory.getState( 999.9 )[ 4 ]
+                 == Approx( getChebyshevTestOrbitState( 999.9 )[ 4 ] ).margin( 1.0e-8 ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test Chebyshev trajectory errors", "[output],[chebyshev_trajectory]" )
+{
+    const std::string filename = "testChebyshevTrajectoryErrors.bin";
+
+    REQUIRE_THROWS( ChebyshevTrajectoryWriter( filename, 0.0, 1.0e-9, 12, 1024 ) );
+    REQUIRE_THROWS( ChebyshevTrajectoryWriter( filename, 1.0e-6, -1.0, 12, 1024 ) );
+    REQUIRE_THROWS( ChebyshevTrajectoryWriter( filename, 1.0e-6, 1.0e-9, 1, 1024 ) );
+    REQUIRE_THROWS( ChebyshevTrajectoryWriter(
+        filename, 1.0e-6, 1.0e-9, maximumNumberOfChebyshevCoefficients + 1, 1024 ) );
+    REQUIRE_THROWS( ChebyshevTrajectoryWriter( filename, 1.0e-6, 1.0e-9, 12, 1 ) );
+
+    // A trajectory with a single sample has no segments and cannot be evaluated.
+    {
+        ChebyshevTrajectoryWriter writer( filename, 1.0e-6, 1.0e-9, 12, 1024 );
+        writer.write( 0.0, getChebyshevTestOrbitState( 0.0 ) );
+        writer.close( TrajectoryMetadata( ) );
+        REQUIRE( writer.getNumberOfSegments( ) == 0 );
+    }
+    REQUIRE_THROWS( ChebyshevTrajectory( filename ) );
+
+    // A segment between two samples that is not within tolerance is not written.
+    {
+        ChebyshevTrajectoryWriter writer( filename, 1.0e-6, 1.0e-9, 2, 1024 );
+        writer.write( 0.0, getChebyshevTestOrbitState( 0.0 ) );
+        REQUIRE_THROWS_AS( writer.write( 10.0, getChebyshevTestOrbitState( 10.0 ) ),
+                           std::runtime_error );
+    }
+
+    // Binary trajectory files are not Chebyshev trajectory files.
+    {
+        BinaryStateHistoryWriter writer( filename, 16 );
+        writer.write( 0.0, getChebyshevTestOrbitState( 0.0 ) );
+        writer.close( TrajectoryMetadata( ) );
+    }
+    REQUIRE_THROWS( ChebyshevTrajectory( filename ) );
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
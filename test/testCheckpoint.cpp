@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/chebyshevTrajectory.hpp"
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistorySink.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state of low Earth orbit for checkpoint tests.
+State getCheckpointTestState( )
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 7000.0;
+    state[ 4 ] = 7.6;
+    state[ 5 ] = 0.3;
+    return state;
+}
+
+//! Integrator checkpoint handler that requests a checkpoint every step and keeps all of them.
+class CheckpointRecorder : public IntegratorCheckpointHandler
+{
+public:
+
+    bool isCheckpointDue( ) { return true; }
+
+    void writeCheckpoint( const IntegratorCheckpoint& integratorCheckpoint )
+    {
+        // Round-trip through serialized checkpoint, as when written to file.
+        Checkpoint checkpoint;
+        writeIntegratorCheckpoint( integratorCheckpoint, checkpoint );
+        Checkpoint restoredCheckpoint( checkpoint.getData( ) );
+        listOfCheckpoints.push_back( readIntegratorCheckpoint( restoredCheckpoint ) );
+        REQUIRE( restoredCheckpoint.isAtEnd( ) );
+    }
+
+    std::vector< IntegratorCheckpoint > listOfCheckpoints;
+};
+
+//! Observer that records all samples.
+struct SampleRecorder
+{
+    SampleRecorder( std::vector< double >& aListOfTimes, std::vector< State >& aListOfStates )
+        : listOfTimes( aListOfTimes ),
+          listOfStates( aListOfStates )
+    { }
+
+    void operator( )( const State& state, const double time )
+    {
+        listOfTimes.push_back( time );
+        listOfStates.push_back( state );
+    }
+
+    std::vector< double >& listOfTimes;
+    std::vector< State >& listOfStates;
+};
+
+TEST_CASE( "Test checkpoint values", "[checkpoint]" )
+{
+    const State state = getCheckpointTestState( );
+    std::vector< double > values;
+    values.push_back( 1.0 / 3.0 );
+    values.push_back( -0.0 );
+    values.push_back( std::numeric_limits< double >::denorm_min( ) );
+
+    Checkpoint checkpoint;
+    checkpoint.writeSize( 123456789012ULL );
+    checkpoint.writeDouble( std::acos( -1.0 ) );
+    checkpoint.writeString( "phase" );
+    checkpoint.writeState( state );
+    checkpoint.writeDoubles( values );
+
+    Checkpoint restoredCheckpoint( checkpoint.getData( ) );
+    REQUIRE( restoredCheckpoint.readSize( ) == 123456789012ULL );
+    REQUIRE( restoredCheckpoint.readDouble( ) == std::acos( -1.0 ) );
+    REQUIRE( restoredCheckpoint.readString( ) == "phase" );
+    REQUIRE( restoredCheckpoint.readState( ) == state );
+    const std::vector< double > restoredValues = restoredCheckpoint.readDoubles( );
+    REQUIRE( restoredValues == values );
+    REQUIRE( std::signbit( restoredValues[ 1 ] ) );
+    REQUIRE( restoredCheckpoint.isAtEnd( ) );
+
+    // Reading beyond the end of the checkpoint is an error.
+    REQUIRE_THROWS( restoredCheckpoint.readDouble( ) );
+}
+
+TEST_CASE( "Test checkpoint file", "[checkpoint]" )
+{
+    const std::string filename = "testCheckpoint.bin";
+
+    Checkpoint checkpoint;
+    checkpoint.writeString( "fingerprint" );
+    checkpoint.writeState( getCheckpointTestState( ) );
+    writeCheckpointFile( filename, checkpoint );
+
+    SECTION( "Test checkpoint is restored" )
+    {
+        Checkpoint restoredCheckpoint = readCheckpointFile( filename );
+        REQUIRE( restoredCheckpoint.getData( ) == checkpoint.getData( ) );
+        REQUIRE( restoredCheckpoint.readString( ) == "fingerprint" );
+        REQUIRE( restoredCheckpoint.readState( ) == getCheckpointTestState( ) );
+    }
+
+    SECTION( "Test corrupt checkpoint is rejected" )
+    {
+        {
+            std::fstream file( filename.c_str( ), std::ios::in | std::ios::out | std::ios::binary );
+            file.seekp( -1, std::ios::end );
+            file.put( 'x' );
+        }
+        REQUIRE_THROWS( readCheckpointFile( filename ) );
+    }
+
+    SECTION( "Test truncated checkpoint is rejected" )
+    {
+        std::ifstream file( filename.c_str( ), std::ios::binary );
+        std::ostringstream contents;
+        contents << file.rdbuf( );
+        file.close( );
+
+        std::ofstream truncatedFile( filename.c_str( ), std::ios::binary | std::ios::trunc );
+        truncatedFile << contents.str( ).substr( 0, contents.str( ).size( ) - 8 );
+        truncatedFile.close( );
+        REQUIRE_THROWS( readCheckpointFile( filename ) );
+    }
+
+    SECTION( "Test file that is not a checkpoint is rejected" )
+    {
+        std::ofstream file( filename.c_str( ), std::ios::trunc );
+        file << "t,x,y,z,vx,vy,vz" << std::endl;
+        file.close( );
+        REQUIRE_THROWS( readCheckpointFile( filename ) );
+    }
+
+    std::remove( filename.c_str( ) );
+    REQUIRE_THROWS( readCheckpointFile( filename ) );
+}
+
+TEST_CASE( "Test asynchronous checkpoint writer", "[checkpoint]" )
+{
+    const std::string filename = "testAsyncCheckpoint.bin";
+
+    {
+        AsyncCheckpointWriter writer( filename );
+        for ( unsigned int i = 0; i < 10; i++ )
+        {
+            Checkpoint checkpoint;
+            checkpoint.writeSize( i );
+            writer.submit( checkpoint );
+        }
+        writer.wait( );
+
+        // Checkpoints that are superseded before they are written are dropped.
+        REQUIRE( writer.getNumberOfCheckpointsWritten( ) >= 1 );
+        REQUIRE( writer.getNumberOfCheckpointsWritten( ) <= 10 );
+        Checkpoint checkpoint = readCheckpointFile( filename );
+        REQUIRE( checkpoint.readSize( ) == 9 );
+    }
+
+    {
+        AsyncCheckpointWriter writer( "nonexistent/directory/checkpoint.bin" );
+        Checkpoint checkpoint;
+        checkpoint.writeSize( 0 );
+        writer.submit( checkpoint );
+        REQUIRE_THROWS( writer.wait( ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test integrator resumed from checkpoint", "[checkpoint],[integrator]" )
+{
+    const State initialState = getCheckpointTestState( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorType integrators[ ] = { rungeKutta4Integrator,
+                                            dormandPrince5Integrator,
+                                            fehlberg78Integrator,
+                                            adamsBashforthMoultonIntegrator };
+    for ( unsigned int i = 0; i < 4; i++ )
+    {
+        INFO( "Integrator: " << getIntegratorName( integrators[ i ] ) );
+
+        const IntegratorSettings settings(
+            initialState, 0.0, 3000.0, 10.0, integrators[ i ], 1.0e-10, 1.0e-10, 60.0 );
+
+        // Uninterrupted integration, with a checkpoint after every step.
+        State state = initialState;
+        std::vector< double > listOfTimes;
+        std::vector< State > listOfStates;
+        CheckpointRecorder recorder;
+        const IntegrationStatistics statistics
+            = integrateState( settings, stateDerivativeModel, state,
+                              SampleRecorder( listOfTimes, listOfStates ), 25.0,
+                              std::vector< double >( ), 0, &recorder );
+        REQUIRE( recorder.listOfCheckpoints.size( ) > 10 );
+
+        // Integration resumed from a checkpoint halfway yields exactly the same samples, final
+        // state and statistics.
+        const IntegratorCheckpoint& checkpoint
+            = recorder.listOfCheckpoints[ recorder.listOfCheckpoints.size( ) / 2 ];
+        State resumedState = initialState;
+        std::vector< double > listOfResumedTimes;
+        std::vector< State > listOfResumedStates;
+        const IntegrationStatistics resumedStatistics
+            = integrateState( settings, stateDerivativeModel, resumedState,
+                              SampleRecorder( listOfResumedTimes, listOfResumedStates ), 25.0,
+                              std::vector< double >( ), 0, 0, &checkpoint );
+
+        REQUIRE( resumedState == state );
+        REQUIRE( resumedStatistics.numberOfFunctionEvaluations
+                 == statistics.numberOfFunctionEvaluations );
+        REQUIRE( resumedStatistics.numberOfAcceptedSteps == statistics.numberOfAcceptedSteps );
+        REQUIRE( resumedStatistics.numberOfRejectedSteps == statistics.numberOfRejectedSteps );
+        REQUIRE( resumedStatistics.minimumStepSize == statistics.minimumStepSize );
+        REQUIRE( resumedStatistics.maximumStepSize == statistics.maximumStepSize );
+        REQUIRE( resumedStatistics.finalTime == statistics.finalTime );
+
+        REQUIRE( !listOfResumedTimes.empty( ) );
+        const std::size_t offset = listOfTimes.size( ) - listOfResumedTimes.size( );
+        REQUIRE( listOfResumedTimes.front( ) > checkpoint.time );
+        for ( std::size_t j = 0; j < listOfResumedTimes.size( ); j++ )
+        {
+            REQUIRE( listOfResumedTimes[ j ] == listOfTimes[ offset + j ] );
+            REQUIRE( listOfResumedStates[ j ] == listOfStates[ offset + j ] );
+        }
+    }
+
+    // Checkpoints are not supported for the Bulirsch-Stoer integrator.
+    const IntegratorSettings settings(
+        initialState, 0.0, 3000.0, 10.0, bulirschStoerIntegrator, 1.0e-10, 1.0e-10, 60.0 );
+    State state = initialState;
+    CheckpointRecorder recorder;
+    REQUIRE_THROWS( integrateState( settings, stateDerivativeModel, state, IntegratorObserver( ),
+                                    0.0, std::vector< double >( ), 0, &recorder ) );
+}
+
+TEST_CASE( "Test state history sinks resumed from checkpoint", "[checkpoint]" )
+{
+    const std::string header = "t,x,y,z,vx,vy,vz";
+    State state = getCheckpointTestState( );
+
+    SECTION( "Test streaming state history writer" )
+    {
+        std::ostringstream expected;
+        {
+            StreamingStateHistoryWriter writer( expected, 4, header );
+            for ( unsigned int i = 0; i < 20; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+            }
+        }
+
+        // Samples written after the checkpoint are overwritten when resumed.
+        std::stringstream stream;
+        Checkpoint checkpoint;
+        {
+            StreamingStateHistoryWriter writer( stream, 4, header );
+            for ( unsigned int i = 0; i < 15; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+                if ( i == 9 )
+                {
+                    writer.writeCheckpoint( checkpoint );
+                }
+            }
+        }
+
+        Checkpoint restoredCheckpoint( checkpoint.getData( ) );
+        stream.seekp( 0 );
+        {
+            StreamingStateHistoryWriter writer( stream, 4, header );
+            writer.restoreCheckpoint( restoredCheckpoint );
+            REQUIRE( writer.getNumberOfSamples( ) == 10 );
+            for ( unsigned int i = 10; i < 20; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+            }
+            REQUIRE( writer.getNumberOfSamples( ) == 20 );
+        }
+        REQUIRE( stream.str( ) == expected.str( ) );
+    }
+
+    SECTION( "Test CSV state history file writer" )
+    {
+        const std::string filename = "testCheckpointStateHistory.csv";
+
+        std::ostringstream expected;
+        {
+            StreamingStateHistoryWriter writer( expected, 4, header );
+            for ( unsigned int i = 0; i < 12; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+            }
+        }
+
+        // The interrupted simulation writes more samples after the checkpoint than the resumed
+        // one, e.g., since an event terminates the resumed simulation earlier; they are removed.
+        Checkpoint checkpoint;
+        {
+            CsvStateHistoryFileWriter writer( filename, 4, header, false );
+            for ( unsigned int i = 0; i < 20; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+                if ( i == 9 )
+                {
+                    writer.writeCheckpoint( checkpoint );
+                }
+            }
+            writer.flush( );
+        }
+
+        Checkpoint restoredCheckpoint( checkpoint.getData( ) );
+        {
+            CsvStateHistoryFileWriter writer( filename, 4, header, true );
+            writer.restoreCheckpoint( restoredCheckpoint );
+            for ( unsigned int i = 10; i < 12; i++ )
+            {
+                state[ 0 ] = 7000.0 + i / 3.0;
+                writer.write( 10.0 * i, state );
+            }
+            writer.flush( );
+            REQUIRE( writer.getNumberOfSamples( ) == 12 );
+        }
+
+        std::ifstream file( filename.c_str( ) );
+        std::ostringstream contents;
+        contents << file.rdbuf( );
+        file.close( );
+        REQUIRE( contents.str( ) == expected.str( ) );
+        std::remove( filename.c_str( ) );
+    }
+
+    SECTION( "Test Chebyshev trajectory writer" )
+    {
+        const std::string filename = "testCheckpointChebyshevTrajectory.bin";
+        const double period = 2.0 * std::acos( -1.0 ) * std::sqrt( 7000.0 * 7000.0 * 7000.0
+                                                                  / 398600.4418 );
+
+        // Samples of a circular orbit.
+        std::vector< double > listOfTimes;
+        std::vector< State > listOfStates;
+        for ( unsigned int i = 0; i <= 100; i++ )
+        {
+            const double time = 0.01 * period * i;
+            const double angle = 2.0 * std::acos( -1.0 ) * time / period;
+            const double speed = 2.0 * std::acos( -1.0 ) * 7000.0 / period;
+            state.fill( 0.0 );
+            state[ 0 ] = 7000.0 * std::cos( angle );
+            state[ 1 ] = 7000.0 * std::sin( angle );
+            state[ 3 ] = -speed * std::sin( angle );
+            state[ 4 ] = speed * std::cos( angle );
+            listOfTimes.push_back( time );
+            listOfStates.push_back( state );
+        }
+
+        ChebyshevTrajectoryWriter writer( filename, 1.0e-6, 1.0e-9, 12, 50 );
+        Checkpoint checkpoint;
+        for ( unsigned int i = 0; i < listOfTimes.size( ); i++ )
+        {
+            writer.write( listOfTimes[ i ], listOfStates[ i ] );
+            if ( i == 37 )
+            {
+                writer.writeCheckpoint( checkpoint );
+            }
+        }
+        writer.flush( );
+
+        Checkpoint restoredCheckpoint( checkpoint.getData( ) );
+        ChebyshevTrajectoryWriter resumedWriter( filename, 1.0e-6, 1.0e-9, 12, 50 );
+        resumedWriter.restoreCheckpoint( restoredCheckpoint );
+        REQUIRE( restoredCheckpoint.isAtEnd( ) );
+        for ( unsigned int i = 38; i < listOfTimes.size( ); i++ )
+        {
+            resumedWriter.write( listOfTimes[ i ], listOfStates[ i ] );
+        }
+        resumedWriter.flush( );
+
+        REQUIRE( resumedWriter.getNumberOfSamples( ) == writer.getNumberOfSamples( ) );
+        REQUIRE( resumedWriter.getNumberOfSegments( ) == writer.getNumberOfSegments( ) );
+        REQUIRE( resumedWriter.getMaximumPositionError( ) == writer.getMaximumPositionError( ) );
+        REQUIRE( resumedWriter.getMaximumVelocityError( ) == writer.getMaximumVelocityError( ) );
+
+        writer.close( TrajectoryMetadata( ) );
+        std::ifstream file( filename.c_str( ), std::ios::binary );
+        std::ostringstream contents;
+        contents << file.rdbuf( );
+        file.close( );
+
+        resumedWriter.close( TrajectoryMetadata( ) );
+        std::ifstream resumedFile( filename.c_str( ), std::ios::binary );
+        std::ostringstream resumedContents;
+        resumedContents << resumedFile.rdbuf( );
+        resumedFile.close( );
+
+        REQUIRE( resumedContents.str( ) == contents.str( ) );
+        std::remove( filename.c_str( ) );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch.hpp>
+
+#include "Scarab/checkpointSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test checkpoint settings struct", "[simulator],[settings],[checkpoint]" )
+{
+    const CheckpointSettings settings( true, "checkpoint.bin", 600.0 );
+
+    REQUIRE( settings.status                == true );
+    REQUIRE( settings.checkpointFilename    == "checkpoint.bin" );
+    REQUIRE( settings.checkpointInterval    == 600.0 );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/numeric/odeint.hpp>
+
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/composedStateDerivativeModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/integratorTemplate.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Uniform acceleration model, not derived from AccelerationModel.
+class UniformAccelerationModel
+{
+public:
+
+    UniformAccelerationModel( const Acceleration& anAcceleration )
+        : acceleration( anAcceleration )
+    { }
+
+    Acceleration operator( )( const State& /* state */, const double /* time */ ) const
+    {
+        return acceleration;
+    }
+
+private:
+
+    Acceleration acceleration;
+};
+
+TEST_CASE( "Test composed state derivative model class",
+           "[simulator],[composed_state_derivative_model]" )
+{
+    State state;
+    state[ 0 ] = 7000.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.1;
+    state[ 4 ] = 7.5;
+    state[ 5 ] = -0.2;
+
+    Acceleration uniformAcceleration;
+    uniformAcceleration[ 0 ] = 1.0e-6;
+    uniformAcceleration[ 1 ] = 2.0e-6;
+    uniformAcceleration[ 2 ] = 3.0e-6;
+
+    const double gravitationalParameter = 398600.4418;
+
+    SECTION( "Test single model" )
+    {
+        const CentralGravityModel centralGravityModel( gravitationalParameter );
+        const ComposedStateDerivativeModel< CentralGravityModel >
+            stateDerivativeModel( centralGravityModel );
+        State stateDerivative;
+        stateDerivativeModel( state, stateDerivative, 0.0 );
+
+        REQUIRE( stateDerivative[ 0 ] == state[ 3 ] );
+        REQUIRE( stateDerivative[ 1 ] == state[ 4 ] );
+        REQUIRE( stateDerivative[ 2 ] == state[ 5 ] );
+        REQUIRE( stateDerivative[ 3 ] == Approx( -gravitationalParameter / ( 7000.0 * 7000.0 ) ) );
+        REQUIRE( stateDerivative[ 4 ] == 0.0 );
+        REQUIRE( stateDerivative[ 5 ] == 0.0 );
+    }
+
+    SECTION( "Test sum of models" )
+    {
+        State stateDerivative;
+        makeComposedStateDerivativeModel( CentralGravityModel( gravitationalParameter ),
+                                          UniformAccelerationModel( uniformAcceleration ) )(
+            state, stateDerivative, 0.0 );
+
+        REQUIRE( stateDerivative[ 3 ]
+                 == Approx( -gravitationalParameter / ( 7000.0 * 7000.0 ) + 1.0e-6 ) );
+        REQUIRE( stateDerivative[ 4 ] == Approx( 2.0e-6 ) );
+        REQUIRE( stateDerivative[ 5 ] == Approx( 3.0e-6 ) );
+    }
+}
+
+TEST_CASE( "Test composed state derivative model matches runtime-polymorphic model",
+           "[simulator],[composed_state_derivative_model]" )
+{
+    State initialState;
+    initialState[ 0 ] = 7000.0;
+    initialState[ 1 ] = 0.0;
+    initialState[ 2 ] = 0.0;
+    initialState[ 3 ] = 0.0;
+    initialState[ 4 ] = 7.5;
+    initialState[ 5 ] = 1.0;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel runtimeModel( data );
+
+    const CentralGravityModel centralGravityModel( data.gravitationalParameter );
+    const ComposedStateDerivativeModel< CentralGravityModel > composedModel( centralGravityModel );
+
+    State runtimeState = initialState;
+    boost::numeric::odeint::integrate_const(
+        boost::numeric::odeint::runge_kutta4< State >( ),
+        runtimeModel, runtimeState, 0.0, 6000.0, 10.0 );
+
+    State composedState = initialState;
+    boost::numeric::odeint::integrate_const(
+        boost::numeric::odeint::runge_kutta4< State >( ),
+        composedModel, composedState, 0.0, 6000.0, 10.0 );
+
+    for ( unsigned int i = 0; i < initialState.size( ); i++ )
+    {
+        REQUIRE( composedState[ i ] == Approx( runtimeState[ i ] ).epsilon( 1.0e-12 ) );
+    }
+}
+
+TEST_CASE( "Test integration of composed state derivative model",
+           "[simulator],[composed_state_derivative_model]" )
+{
+    State initialState;
+    initialState[ 0 ] = 7000.0;
+    initialState[ 1 ] = 0.0;
+    initialState[ 2 ] = 0.0;
+    initialState[ 3 ] = 0.0;
+    initialState[ 4 ] = 7.5;
+    initialState[ 5 ] = 1.0;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel runtimeModel( data );
+
+    const ComposedStateDerivativeModel< CentralGravityModel > composedModel(
+        CentralGravityModel( data.gravitationalParameter ) );
+
+    const IntegratorSettings settings(
+        initialState, 0.0, 6000.0, 10.0, dormandPrince5Integrator, 1.0e-10, 1.0e-10, 600.0 );
+
+    State runtimeState = initialState;
+    const IntegrationStatistics runtimeStatistics
+        = integrateState( settings, runtimeModel, runtimeState );
+
+    State composedState = initialState;
+    const IntegrationStatistics composedStatistics
+        = integrateState( settings, composedModel, composedState );
+
+    REQUIRE( composedStatistics.numberOfAcceptedSteps == runtimeStatistics.numberOfAcceptedSteps );
+    REQUIRE( composedStatistics.numberOfFunctionEvaluations
+             == runtimeStatistics.numberOfFunctionEvaluations );
+    for ( unsigned int i = 0; i < initialState.size( ); i++ )
+    {
+        REQUIRE( composedState[ i ] == Approx( runtimeState[ i ] ).epsilon( 1.0e-12 ) );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
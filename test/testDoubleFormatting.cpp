@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <boost/cstdint.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/doubleFormatting.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Format double and return string.
+std::string formatShortestDoubleToString( const double value )
+{
+    char buffer[ maximumFormattedDoubleLength ];
+    const std::size_t length = formatShortestDouble( value, buffer );
+    return std::string( buffer, length );
+}
+
+TEST_CASE( "Test formatting of doubles with shortest round-trip representation",
+           "[output],[double_formatting]" )
+{
+    SECTION( "Test fixed and scientific notation" )
+    {
+        REQUIRE( formatShortestDoubleToString( 0.0 ) == "0" );
+        REQUIRE( formatShortestDoubleToString( -0.0 ) == "-0" );
+        REQUIRE( formatShortestDoubleToString( 1.0 ) == "1" );
+        REQUIRE( formatShortestDoubleToString( 7000.0 ) == "7000" );
+        REQUIRE( formatShortestDoubleToString( -1234.5 ) == "-1234.5" );
+        REQUIRE( formatShortestDoubleToString( 0.1 ) == "0.1" );
+        REQUIRE( formatShortestDoubleToString( 0.3 ) == "0.3" );
+        REQUIRE( formatShortestDoubleToString( 1.0 / 3.0 ) == "0.3333333333333333" );
+        REQUIRE( formatShortestDoubleToString( 1.0e-4 ) == "0.0001" );
+        REQUIRE( formatShortestDoubleToString( 1.0e-5 ) == "1e-05" );
+        REQUIRE( formatShortestDoubleToString( 1.0e16 ) == "10000000000000000" );
+        REQUIRE( formatShortestDoubleToString( 1.0e17 ) == "1e+17" );
+        REQUIRE( formatShortestDoubleToString( 1.0e22 ) == "1e+22" );
+        REQUIRE( formatShortestDoubleToString( 6999.5932688579 ) == "6999.5932688579" );
+    }
+
+    SECTION( "Test extreme values" )
+    {
+        REQUIRE( formatShortestDoubleToString( std::numeric_limits< double >::max( ) )
+                 == "1.7976931348623157e+308" );
+        REQUIRE( formatShortestDoubleToString( std::numeric_limits< double >::min( ) )
+                 == "2.2250738585072014e-308" );
+        REQUIRE( formatShortestDoubleToString( std::numeric_limits< double >::denorm_min( ) )
+                 == "5e-324" );
+        REQUIRE( formatShortestDoubleToString( std::numeric_limits< double >::infinity( ) )
+                 == "inf" );
+        REQUIRE( formatShortestDoubleToString( -std::numeric_limits< double >::infinity( ) )
+                 == "-inf" );
+        REQUIRE( formatShortestDoubleToString( std::numeric_limits< double >::quiet_NaN( ) )
+                 == "nan" );
+    }
+
+    SECTION( "Test round trip of arbitrary bit patterns" )
+    {
+        // Linear congruential generator, so that the test is reproducible.
+        boost::uint64_t bits = 12345;
+        for ( unsigned int i = 0; i < 100000; i++ )
+        {
+            bits = bits * 6364136223846793005u + 1442695040888963407u;
+            double value;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            if ( value != value || value - value != 0.0 )
+            {
+                continue;
+            }
+
+            const std::string text = formatShortestDoubleToString( value );
+            REQUIRE( text.size( ) <= maximumFormattedDoubleLength );
+            REQUIRE( std::strtod( text.c_str( ), 0 ) == value );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/dragModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test exponential atmosphere table", "[acceleration_models]" )
+{
+    const AtmosphereTable atmosphereTable = getExponentialAtmosphereTable( );
+    REQUIRE( atmosphereTable.size( ) == 28 );
+    REQUIRE( atmosphereTable.front( ).baseAltitude == 0.0 );
+    REQUIRE( atmosphereTable.back( ).baseAltitude == 1000.0 );
+
+    // Density at layer bases, within layers and above the top layer.
+    REQUIRE( computeAtmosphereDensity( atmosphereTable, 0.0 ) == 1.225 );
+    REQUIRE( computeAtmosphereDensity( atmosphereTable, 400.0 ) == 3.725e-12 );
+    REQUIRE( computeAtmosphereDensity( atmosphereTable, 420.0 )
+             == Approx( 3.725e-12 * std::exp( -20.0 / 58.515 ) ) );
+    REQUIRE( computeAtmosphereDensity( atmosphereTable, 1200.0 )
+             == Approx( 3.019e-15 * std::exp( -200.0 / 268.0 ) ) );
+}
+
+TEST_CASE( "Test density lookup in altitude buckets", "[acceleration_models]" )
+{
+    SECTION( "Exponential atmosphere" )
+    {
+        const AtmosphereTable atmosphereTable = getExponentialAtmosphereTable( );
+        const DragModel model( 2.2, 10.0, 1000.0, atmosphereTable, 6378.1363, 0.0 );
+        for ( double altitude = -10.0; altitude < 1100.0; altitude += 0.137 )
+        {
+            REQUIRE( model.computeDensity( altitude )
+                     == Approx( computeAtmosphereDensity( atmosphereTable, altitude ) )
+                            .epsilon( 1.0e-7 ) );
+        }
+        for ( unsigned int i = 0; i < atmosphereTable.size( ); i++ )
+        {
+            REQUIRE( model.computeDensity( atmosphereTable[ i ].baseAltitude )
+                     == Approx( atmosphereTable[ i ].baseDensity ).epsilon( 1.0e-12 ) );
+        }
+    }
+
+    SECTION( "Layer bases within buckets" )
+    {
+        AtmosphereTable atmosphereTable;
+        atmosphereTable.push_back( AtmosphereLayer( 100.0, 5.0e-7, 6.0 ) );
+        atmosphereTable.push_back( AtmosphereLayer( 100.75, 4.4e-7, 7.0 ) );
+        atmosphereTable.push_back( AtmosphereLayer( 102.6, 3.4e-7, 8.0 ) );
+        atmosphereTable.push_back( AtmosphereLayer( 105.3, 2.4e-7, 9.0 ) );
+        const DragModel model( 2.2, 10.0, 1000.0, atmosphereTable, 6378.1363, 0.0 );
+        for ( double altitude = 99.0; altitude < 107.0; altitude += 0.01 )
+        {
+            REQUIRE( model.computeDensity( altitude )
+                     == Approx( computeAtmosphereDensity( atmosphereTable, altitude ) )
+                            .epsilon( 1.0e-7 ) );
+        }
+    }
+}
+
+TEST_CASE( "Test drag acceleration", "[acceleration_models]" )
+{
+    const AtmosphereTable atmosphereTable = getExponentialAtmosphereTable( );
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 6378.1363 + 400.0;
+    state[ 4 ] = 7.7;
+    state[ 5 ] = 0.5;
+    const double density = 3.725e-12;
+
+    SECTION( "Non-rotating atmosphere" )
+    {
+        // Acceleration of 1/2 * rho * 2.2 * 10 m^2 / 1000 kg * v^2, opposite to velocity.
+        const DragModel model( 2.2, 10.0, 1000.0, atmosphereTable, 6378.1363, 0.0 );
+        const Acceleration acceleration = model( state, 0.0 );
+        const double speed = std::sqrt( 7.7 * 7.7 + 0.5 * 0.5 );
+        const double magnitude = 0.5 * density * 2.2 * 10.0 / 1000.0 * speed * speed * 1.0e3;
+        REQUIRE( acceleration[ 0 ] == 0.0 );
+        REQUIRE( acceleration[ 1 ] == Approx( -magnitude * 7.7 / speed ).epsilon( 1.0e-7 ) );
+        REQUIRE( acceleration[ 2 ] == Approx( -magnitude * 0.5 / speed ).epsilon( 1.0e-7 ) );
+    }
+
+    SECTION( "Rotating atmosphere" )
+    {
+        // Velocity with respect to atmosphere is reduced by omega x r along the y-axis.
+        const double rotationRate = 7.292115e-5;
+        const DragModel model( 2.2, 10.0, 1000.0, atmosphereTable, 6378.1363, rotationRate );
+        const Acceleration acceleration = model( state, 0.0 );
+        const double vy = 7.7 - rotationRate * state[ 0 ];
+        const double speed = std::sqrt( vy * vy + 0.5 * 0.5 );
+        const double factor = -0.5 * density * 2.2 * 10.0 / 1000.0 * speed * 1.0e3;
+        REQUIRE( acceleration[ 0 ] == 0.0 );
+        REQUIRE( acceleration[ 1 ] == Approx( factor * vy ).epsilon( 1.0e-7 ) );
+        REQUIRE( acceleration[ 2 ] == Approx( factor * 0.5 ).epsilon( 1.0e-7 ) );
+    }
+
+    SECTION( "Invalid parameters" )
+    {
+        REQUIRE_THROWS_AS( DragModel( 2.2, 10.0, 0.0, atmosphereTable, 6378.1363, 0.0 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( DragModel( 2.2, 10.0, 1000.0, AtmosphereTable( ), 6378.1363, 0.0 ),
+                           std::runtime_error );
+    }
+}
+
+TEST_CASE( "Test reading atmosphere table", "[acceleration_models]" )
+{
+    const std::string filename = "testAtmosphereTable.csv";
+    {
+        std::ofstream file( filename.c_str( ) );
+        file << "# altitude [km], density [kg m^-3]" << std::endl;
+        file << "300, 2.418e-11" << std::endl;
+        file << std::endl;
+        file << "350 9.518e-12" << std::endl;
+        file << "400 3.725e-12" << std::endl;
+    }
+
+    SECTION( "Piecewise exponential interpolation" )
+    {
+        const AtmosphereTable atmosphereTable = readAtmosphereTable( filename );
+        REQUIRE( atmosphereTable.size( ) == 3 );
+        REQUIRE( atmosphereTable[ 0 ].scaleHeight
+                 == Approx( 50.0 / std::log( 2.418e-11 / 9.518e-12 ) ) );
+        REQUIRE( atmosphereTable[ 2 ].scaleHeight == atmosphereTable[ 1 ].scaleHeight );
+        REQUIRE( computeAtmosphereDensity( atmosphereTable, 350.0 ) == 9.518e-12 );
+        REQUIRE( computeAtmosphereDensity( atmosphereTable, 400.0 ) == 3.725e-12 );
+        REQUIRE( computeAtmosphereDensity( atmosphereTable, 375.0 )
+                 == Approx( std::sqrt( 9.518e-12 * 3.725e-12 ) ) );
+    }
+
+    SECTION( "Errors" )
+    {
+        {
+            std::ofstream file( filename.c_str( ), std::ios::app );
+            file << "390 1.0e-12" << std::endl;
+        }
+        REQUIRE_THROWS_AS( readAtmosphereTable( filename ), std::runtime_error );
+        REQUIRE_THROWS_AS( readAtmosphereTable( "nonexistent.csv" ), std::runtime_error );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/encke.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistorySink.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state of target on eccentric low Earth orbit.
+State getEnckeTargetState( )
+{
+    State state;
+    state[ 0 ] = 7000.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.0;
+    state[ 4 ] = 7.8;
+    state[ 5 ] = 1.0;
+    return state;
+}
+
+//! Create simulator settings for Encke propagation of chaser about target.
+SimulatorSettings createEnckeTestSettings( const State& chaserState,
+                                           const double absoluteTolerance,
+                                           const double relativeTolerance,
+                                           const double rectificationThreshold,
+                                           const double rectificationInterval )
+{
+    SimulatorTestSettings testSettings;
+    testSettings.integratorSettings = boost::make_shared< IntegratorSettings >(
+        chaserState,
+        0.0,
+        12000.0,
+        10.0,
+        dormandPrince5Integrator,
+        absoluteTolerance,
+        relativeTolerance,
+        12000.0 );
+    testSettings.targetSettings = boost::make_shared< TargetSettings >(
+        1000.0,
+        std::numeric_limits< double >::signaling_NaN( ),
+        std::numeric_limits< double >::signaling_NaN( ),
+        getEnckeTargetState( ) );
+    testSettings.outputSettings = createTestOutputSettings( 1000.0 );
+    testSettings.enckeSettings = boost::make_shared< EnckeSettings >(
+        true, rectificationThreshold, rectificationInterval );
+    return testSettings.create( );
+}
+
+//! Integrate two-body trajectory and return state at end time.
+State integrateTwoBodyState( const State& initialState,
+                             const double endTime,
+                             const double tolerance,
+                             IntegrationStatistics& statistics )
+{
+    ListOfAccelerationModels listOfAccelerationModels;
+    listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( 398600.4418 );
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    StateDerivativeModel stateDerivativeModel( data );
+
+    State state = initialState;
+    statistics = integrateState( IntegratorSettings( initialState,
+                                                     0.0,
+                                                     endTime,
+                                                     10.0,
+                                                     dormandPrince5Integrator,
+                                                     tolerance,
+                                                     tolerance,
+                                                     endTime ),
+                                 stateDerivativeModel,
+                                 state );
+    return state;
+}
+
+//! Integrate trajectory with acceleration models of chaser and return state at end time.
+State integrateChaserState( const SimulatorSettings& settings,
+                            const State& initialState,
+                            const double tolerance )
+{
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState,
+                    settings.integratorSettings.startTime,
+                    settings.centralGravitySettings.gravitationalParameter,
+                    listOfAccelerationModels );
+    generateAccelerationModelList( settings, data );
+    StateDerivativeModel stateDerivativeModel( data );
+
+    State state = initialState;
+    integrateState( IntegratorSettings( initialState,
+                                        settings.integratorSettings.startTime,
+                                        settings.integratorSettings.endTime,
+                                        10.0,
+                                        dormandPrince5Integrator,
+                                        tolerance,
+                                        tolerance,
+                                        settings.integratorSettings.endTime ),
+                    stateDerivativeModel,
+                    state );
+    return state;
+}
+
+TEST_CASE( "Test Keplerian orbit propagation", "[encke]" )
+{
+    const State initialState = getEnckeTargetState( );
+    IntegrationStatistics statistics;
+
+    SECTION( "Zero elapsed time" )
+    {
+        const State state = propagateKeplerOrbit( 398600.4418, initialState, 0.0 );
+        for ( unsigned int i = 0; i < state.size( ); i++ )
+        {
+            REQUIRE( state[ i ] == initialState[ i ] );
+        }
+    }
+
+    SECTION( "Elliptic orbit against numerical integration" )
+    {
+        const State state = propagateKeplerOrbit( 398600.4418, initialState, 7000.0 );
+        const State expectedState = integrateTwoBodyState( initialState, 7000.0, 1.0e-13,
+                                                           statistics );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::fabs( state[ i ] - expectedState[ i ] ) < 1.0e-6 );
+            REQUIRE( std::fabs( state[ i + 3 ] - expectedState[ i + 3 ] ) < 1.0e-9 );
+        }
+    }
+
+    SECTION( "Hyperbolic orbit forward and backward" )
+    {
+        State hyperbolicState = initialState;
+        hyperbolicState[ 4 ] = 12.0;
+        const State state = propagateKeplerOrbit( 398600.4418, hyperbolicState, 3000.0 );
+        const State expectedState = integrateTwoBodyState( hyperbolicState, 3000.0, 1.0e-13,
+                                                           statistics );
+        const State backwardState = propagateKeplerOrbit( 398600.4418, state, -3000.0 );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::fabs( state[ i ] - expectedState[ i ] ) < 1.0e-6 );
+            REQUIRE( std::fabs( backwardState[ i ] - hyperbolicState[ i ] ) < 1.0e-7 );
+            REQUIRE( std::fabs( backwardState[ i + 3 ] - hyperbolicState[ i + 3 ] ) < 1.0e-10 );
+        }
+    }
+}
+
+TEST_CASE( "Test Encke function", "[encke]" )
+{
+    REQUIRE( computeEnckeFunction( 0.0 ) == 0.0 );
+    REQUIRE( computeEnckeFunction( 0.5 ) == Approx( 1.0 - std::pow( 1.5, -1.5 ) ) );
+    REQUIRE( computeEnckeFunction( -0.3 ) == Approx( 1.0 - std::pow( 0.7, -1.5 ) ) );
+
+    // For small q, f( q ) = 3/2 q to first order, without cancellation.
+    REQUIRE( computeEnckeFunction( 1.0e-12 ) == Approx( 1.5e-12 ).epsilon( 1.0e-10 ) );
+}
+
+TEST_CASE( "Test Encke propagation of chaser close to target", "[encke]" )
+{
+    // Chaser at metre-level separation from the target.
+    const State targetState = getEnckeTargetState( );
+    State chaserState = targetState;
+    chaserState[ 0 ] += 1.0e-3;
+    chaserState[ 1 ] -= 2.0e-3;
+    chaserState[ 5 ] += 1.0e-6;
+
+    const SimulatorSettings settings
+        = createEnckeTestSettings( chaserState, 1.0e-9, 1.0e-9, 0.01, 12000.0 );
+    StateHistory stateHistory;
+    StateHistoryRecorder recorder( stateHistory );
+    const EnckeStatistics statistics = propagateEncke( settings, recorder );
+
+    REQUIRE( statistics.numberOfRectifications == 0 );
+    REQUIRE( stateHistory.size( ) == 13 );
+    REQUIRE( stateHistory.getTime( 0 ) == 0.0 );
+    REQUIRE( stateHistory.getTime( stateHistory.size( ) - 1 ) == 12000.0 );
+
+    // Compare with difference of accurately integrated absolute states.
+    IntegrationStatistics chaserStatistics;
+    IntegrationStatistics targetStatistics;
+    const State finalChaserState
+        = integrateTwoBodyState( chaserState, 12000.0, 1.0e-14, chaserStatistics );
+    const State finalTargetState
+        = integrateTwoBodyState( targetState, 12000.0, 1.0e-14, targetStatistics );
+    const State relativeState = stateHistory.getState( stateHistory.size( ) - 1 );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        REQUIRE( std::fabs( relativeState[ i ] - ( finalChaserState[ i ] - finalTargetState[ i ] ) )
+                 < 1.0e-6 );
+    }
+
+    // The deviation is integrated with far fewer steps than the absolute chaser trajectory at the
+    // same tolerances.
+    integrateTwoBodyState( chaserState, 12000.0, 1.0e-9, chaserStatistics );
+    REQUIRE( statistics.deviationStatistics.numberOfAcceptedSteps * 2
+             < chaserStatistics.numberOfAcceptedSteps );
+}
+
+TEST_CASE( "Test Encke propagation with rectification", "[encke]" )
+{
+    // Chaser drifting away from the target, so that the reference is rectified.
+    const State targetState = getEnckeTargetState( );
+    State chaserState = targetState;
+    chaserState[ 0 ] += 10.0;
+    chaserState[ 4 ] += 0.05;
+
+    const SimulatorSettings settings
+        = createEnckeTestSettings( chaserState, 1.0e-10, 1.0e-10, 0.005, 1000.0 );
+    StateHistory stateHistory;
+    StateHistoryRecorder recorder( stateHistory );
+    const EnckeStatistics statistics = propagateEncke( settings, recorder );
+
+    REQUIRE( statistics.numberOfRectifications > 0 );
+    REQUIRE( stateHistory.size( ) == 13 );
+
+    IntegrationStatistics chaserStatistics;
+    IntegrationStatistics targetStatistics;
+    const State finalChaserState
+        = integrateTwoBodyState( chaserState, 12000.0, 1.0e-14, chaserStatistics );
+    const State finalTargetState
+        = integrateTwoBodyState( targetState, 12000.0, 1.0e-14, targetStatistics );
+    const State relativeState = stateHistory.getState( stateHistory.size( ) - 1 );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        REQUIRE( std::fabs( relativeState[ i ] - ( finalChaserState[ i ] - finalTargetState[ i ] ) )
+                 < 1.0e-4 );
+    }
+}
+
+TEST_CASE( "Test Encke propagation of spacecraft with different masses and areas", "[encke]" )
+{
+    // Chaser with ten times the area and a tenth of the mass of the target, so that radiation
+    // pressure accelerates it a hundred times more strongly.
+    const State targetState = getEnckeTargetState( );
+    State chaserState = targetState;
+    chaserState[ 0 ] += 1.0e-3;
+    chaserState[ 4 ] += 1.0e-6;
+
+    Position vectorToSource;
+    vectorToSource[ 0 ] = 1.496e11;
+    vectorToSource[ 1 ] = 0.0;
+    vectorToSource[ 2 ] = 0.0;
+
+    SimulatorTestSettings testSettings;
+    testSettings.integratorSettings = boost::make_shared< IntegratorSettings >(
+        chaserState, 0.0, 12000.0, 10.0, dormandPrince5Integrator, 1.0e-10, 1.0e-10, 12000.0 );
+    testSettings.chaserSettings = boost::make_shared< ChaserSettings >( 100.0 );
+    testSettings.targetSettings = boost::make_shared< TargetSettings >(
+        1000.0, std::numeric_limits< double >::signaling_NaN( ), 1.0, targetState );
+    testSettings.radiationPressureSettings = boost::make_shared< RadiationPressureSettings >(
+        true, 4.56e-6, 1.5, vectorToSource, 10.0, noShadowModel, 6378.0, 696000.0, "" );
+    testSettings.listOfModelNames.push_back( "radiation_pressure" );
+    testSettings.outputSettings = createTestOutputSettings( 1000.0 );
+    testSettings.enckeSettings = boost::make_shared< EnckeSettings >( true, 0.01, 12000.0 );
+    const SimulatorSettings settings = testSettings.create( );
+
+    StateHistory stateHistory;
+    StateHistoryRecorder recorder( stateHistory );
+    const EnckeStatistics statistics = propagateEncke( settings, recorder );
+    REQUIRE( statistics.numberOfRectifications == 0 );
+
+    // Propagate target as chaser, with the mass and area of the target.
+    testSettings.chaserSettings = boost::make_shared< ChaserSettings >( 1000.0 );
+    testSettings.radiationPressureSettings = boost::make_shared< RadiationPressureSettings >(
+        true, 4.56e-6, 1.5, vectorToSource, 1.0, noShadowModel, 6378.0, 696000.0, "" );
+    const SimulatorSettings targetAsChaserSettings = testSettings.create( );
+
+    const State finalChaserState = integrateChaserState( settings, chaserState, 1.0e-14 );
+    const State finalTargetState
+        = integrateChaserState( targetAsChaserSettings, targetState, 1.0e-14 );
+    const State relativeState = stateHistory.getState( stateHistory.size( ) - 1 );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        REQUIRE( std::fabs( relativeState[ i ] - ( finalChaserState[ i ] - finalTargetState[ i ] ) )
+                 < 1.0e-6 );
+    }
+
+    // The differential radiation pressure acceleration moves the chaser away from the target by
+    // far more than the tolerance above.
+    const State finalSameChaserState = integrateChaserState( settings, targetState, 1.0e-14 );
+    double differentialDisplacement = 0.0;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        differentialDisplacement += ( finalSameChaserState[ i ] - finalTargetState[ i ] )
+                                    * ( finalSameChaserState[ i ] - finalTargetState[ i ] );
+    }
+    REQUIRE( std::sqrt( differentialDisplacement ) > 1.0e-3 );
+}
+
+TEST_CASE( "Test Encke propagation to state history file that cannot be opened", "[encke]" )
+{
+    // The test settings have no output files, so the state history file cannot be opened.
+    const SimulatorSettings settings
+        = createEnckeTestSettings( getEnckeTargetState( ), 1.0e-9, 1.0e-9, 0.01, 12000.0 );
+    REQUIRE_THROWS_AS( executeEncke( settings ), std::runtime_error );
+}
+
+} // namespace tests
+} // namespace scarab
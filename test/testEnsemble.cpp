@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/ensemble.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create simulator settings for a short ensemble run in low Earth orbit.
+SimulatorSettings createEnsembleTestSettings( const unsigned int numberOfThreads )
+{
+    State initialStateDispersion;
+    initialStateDispersion.fill( 1.0e-3 );
+
+    SimulatorTestSettings testSettings;
+    testSettings.ensembleSettings = boost::make_shared< EnsembleSettings >(
+        true, 20, numberOfThreads, 42, initialStateDispersion, "" );
+    return testSettings.create( );
+}
+
+TEST_CASE( "Test sampling of ensemble initial states", "[ensemble]" )
+{
+    const SimulatorSettings settings = createEnsembleTestSettings( 1 );
+    const State& nominalState = settings.integratorSettings.initialState;
+
+    const State firstSample = sampleInitialState( nominalState, settings.ensembleSettings, 0 );
+    const State secondSample = sampleInitialState( nominalState, settings.ensembleSettings, 1 );
+
+    REQUIRE( firstSample == sampleInitialState( nominalState, settings.ensembleSettings, 0 ) );
+    REQUIRE( firstSample != secondSample );
+    REQUIRE( firstSample != nominalState );
+
+    for ( unsigned int i = 0; i < firstSample.size( ); i++ )
+    {
+        REQUIRE( std::fabs( firstSample[ i ] - nominalState[ i ] ) < 1.0e-2 );
+    }
+}
+
+TEST_CASE( "Test ensemble is independent of number of threads", "[ensemble]" )
+{
+    const Ensemble serialEnsemble = propagateEnsemble( createEnsembleTestSettings( 1 ) );
+    const Ensemble parallelEnsemble = propagateEnsemble( createEnsembleTestSettings( 4 ) );
+
+    REQUIRE( serialEnsemble.size( ) == 20 );
+    REQUIRE( parallelEnsemble.size( ) == serialEnsemble.size( ) );
+
+    for ( unsigned int i = 0; i < serialEnsemble.size( ); i++ )
+    {
+        REQUIRE( serialEnsemble[ i ].index == i );
+        REQUIRE( parallelEnsemble[ i ].index == i );
+        REQUIRE( parallelEnsemble[ i ].initialState == serialEnsemble[ i ].initialState );
+        REQUIRE( parallelEnsemble[ i ].finalState == serialEnsemble[ i ].finalState );
+        REQUIRE( serialEnsemble[ i ].finalState != serialEnsemble[ i ].initialState );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch.hpp>
+
+#include "Scarab/ensembleSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test ensemble settings struct", "[simulator],[settings],[ensemble]" )
+{
+    State initialStateDispersion;
+    initialStateDispersion.fill( 0.1 );
+
+    const EnsembleSettings settings( true, 100, 4, 42, initialStateDispersion, "ensemble.csv" );
+
+    REQUIRE( settings.status                    == true );
+    REQUIRE( settings.numberOfSamples           == 100 );
+    REQUIRE( settings.numberOfThreads           == 4 );
+    REQUIRE( settings.seed                      == 42 );
+    REQUIRE( settings.initialStateDispersion    == initialStateDispersion );
+    REQUIRE( settings.ensembleFilename          == "ensemble.csv" );
+}
+
+} // namespace tests
+} // namespace scarab
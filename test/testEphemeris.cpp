@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "Scarab/ephemeris.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Evaluate Chebyshev series directly, using T_k( cos theta ) = cos( k theta ).
+double evaluateChebyshevSeries( const double* coefficients,
+                                const std::size_t numberOfCoefficients,
+                                const double tau )
+{
+    const double theta = std::acos( tau );
+    double value = 0.0;
+    for ( std::size_t k = 0; k < numberOfCoefficients; k++ )
+    {
+        value += coefficients[ k ] * std::cos( k * theta );
+    }
+    return value;
+}
+
+//! Compute expected position of body by direct evaluation of the segment containing given time.
+Position computeExpectedEphemerisPosition( const EphemerisBody& body, const double time )
+{
+    std::size_t segment
+        = static_cast< std::size_t >( ( time - body.startTime ) / body.segmentDuration );
+    if ( segment >= body.numberOfSegments )
+    {
+        segment = body.numberOfSegments - 1;
+    }
+    const double tau
+        = 2.0 * ( time - body.startTime - segment * body.segmentDuration ) / body.segmentDuration
+          - 1.0;
+
+    Position position;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        position[ i ] = evaluateChebyshevSeries(
+            body.coefficients + ( 3 * segment + i ) * body.numberOfCoefficients,
+            body.numberOfCoefficients,
+            tau );
+    }
+    return position;
+}
+
+TEST_CASE( "Test Chebyshev ephemeris file round trip", "[ephemeris]" )
+{
+    const std::string filename = "testEphemeris.bin";
+
+    // Two bodies with different time spans, segment durations and numbers of coefficients.
+    std::mt19937 generator( 17 );
+    std::uniform_real_distribution< double > distribution( -1.0e5, 1.0e5 );
+    std::vector< double > sunCoefficients( 4 * 3 * 12 );
+    std::vector< double > moonCoefficients( 10 * 3 * 9 );
+    for ( std::size_t i = 0; i < sunCoefficients.size( ); i++ )
+    {
+        sunCoefficients[ i ] = distribution( generator );
+    }
+    for ( std::size_t i = 0; i < moonCoefficients.size( ); i++ )
+    {
+        moonCoefficients[ i ] = distribution( generator );
+    }
+
+    std::vector< EphemerisBody > bodies;
+    bodies.push_back( EphemerisBody(
+        "sun", 1.32712440018e11, -1000.0, 86400.0, 4, 12, &sunCoefficients[ 0 ] ) );
+    bodies.push_back( EphemerisBody(
+        "moon", 4902.800066, 0.0, 21600.0, 10, 9, &moonCoefficients[ 0 ] ) );
+    writeChebyshevEphemeris( filename, bodies );
+
+    {
+        const ChebyshevEphemeris ephemeris( filename );
+        REQUIRE( ephemeris.getNumberOfBodies( ) == 2 );
+        REQUIRE( ephemeris.findBody( "sun" ) == 0 );
+        REQUIRE( ephemeris.findBody( "moon" ) == 1 );
+        REQUIRE_THROWS_AS( ephemeris.findBody( "mars" ), std::runtime_error );
+
+        const EphemerisBody& moon = ephemeris.getBody( 1 );
+        REQUIRE( moon.gravitationalParameter == 4902.800066 );
+        REQUIRE( moon.startTime == 0.0 );
+        REQUIRE( moon.segmentDuration == 21600.0 );
+        REQUIRE( moon.numberOfSegments == 10 );
+        REQUIRE( moon.numberOfCoefficients == 9 );
+        REQUIRE( moon.getEndTime( ) == 216000.0 );
+        REQUIRE( moon.coefficients[ 5 ] == moonCoefficients[ 5 ] );
+
+        // Positions of both bodies, interleaved and moving back and forth between segments, so that
+        // cached segments are both reused and replaced. The tolerance is set with respect to the
+        // size of the coefficients, since the series suffer from cancellation.
+        const double times[ ] = { 0.0, 100.0, 21599.0, 21600.0, 50000.0, 10.0, 216000.0, 86000.0 };
+        for ( unsigned int i = 0; i < sizeof( times ) / sizeof( times[ 0 ] ); i++ )
+        {
+            for ( std::size_t j = 0; j < 2; j++ )
+            {
+                const Position position = ephemeris.getPosition( j, times[ i ] );
+                const Position expectedPosition
+                    = computeExpectedEphemerisPosition( ephemeris.getBody( j ), times[ i ] );
+                for ( unsigned int k = 0; k < 3; k++ )
+                {
+                    REQUIRE( position[ k ] == Approx( expectedPosition[ k ] ).margin( 1.0e-6 ) );
+                }
+            }
+        }
+
+        // Times outside of the time span of a body are rejected.
+        REQUIRE_THROWS_AS( ephemeris.getPosition( 1, -1.0 ), std::runtime_error );
+        REQUIRE_THROWS_AS( ephemeris.getPosition( 1, 216001.0 ), std::runtime_error );
+        REQUIRE_THROWS_AS( ephemeris.getPosition( 0, -1001.0 ), std::runtime_error );
+        REQUIRE_THROWS( ephemeris.getPosition( 2, 0.0 ) );
+
+        // A second ephemeris mapped from the same file does not share cached segments with the
+        // first, even though it has the same bodies.
+        const ChebyshevEphemeris otherEphemeris( filename );
+        const Position position = otherEphemeris.getPosition( 1, 200000.0 );
+        const Position expectedPosition
+            = computeExpectedEphemerisPosition( otherEphemeris.getBody( 1 ), 200000.0 );
+        REQUIRE( position[ 0 ] == Approx( expectedPosition[ 0 ] ).margin( 1.0e-6 ) );
+        REQUIRE( ephemeris.getPosition( 1, 100.0 )[ 0 ]
+                 == Approx( computeExpectedEphemerisPosition( moon, 100.0 )[ 0 ] )
+                        .margin( 1.0e-6 ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test rejection of invalid ephemeris files", "[ephemeris]" )
+{
+    const std::string filename = "testInvalidEphemeris.bin";
+    {
+        std::ofstream file( filename.c_str( ), std::ios::binary );
+        file << "SCARABTR not an ephemeris file";
+    }
+    REQUIRE_THROWS_AS( ChebyshevEphemeris( filename ), std::runtime_error );
+
+    // Bodies without segments or coefficients cannot be written.
+    std::vector< EphemerisBody > bodies;
+    bodies.push_back( EphemerisBody( "sun", 1.32712440018e11, 0.0, 86400.0, 0, 12, 0 ) );
+    REQUIRE_THROWS_AS( writeChebyshevEphemeris( filename, bodies ), std::runtime_error );
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/eventDetector.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state moving radially inwards along the x-axis at 1 km/s, starting at 7000 km.
+State getRadialMotionState( )
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 7000.0;
+    state[ 3 ] = -1.0;
+    return state;
+}
+
+//! Get event definition with origin as reference point.
+EventDefinition getDistanceEvent( const std::string& name,
+                                  const double threshold,
+                                  const EventAction action,
+                                  const std::string& phase = "",
+                                  const std::string& nextPhase = "" )
+{
+    Position origin;
+    origin.fill( 0.0 );
+    return EventDefinition( name,
+                            distanceEventType,
+                            threshold,
+                            origin,
+                            0,
+                            anyEventDirection,
+                            action,
+                            phase,
+                            nextPhase );
+}
+
+TEST_CASE( "Test event function values", "[event-detector]" )
+{
+    Position referencePoint;
+    referencePoint[ 0 ] = 3.0;
+    referencePoint[ 1 ] = 0.0;
+    referencePoint[ 2 ] = 0.0;
+    State state;
+    state.fill( 0.0 );
+    state[ 1 ] = 4.0;
+    state[ 4 ] = 2.5;
+
+    REQUIRE( DistanceEventFunction( referencePoint, 1.0 )( state, 0.0 ) == Approx( 4.0 ) );
+    REQUIRE( StateComponentEventFunction( 4, 1.0 )( state, 0.0 ) == Approx( 1.5 ) );
+}
+
+TEST_CASE( "Test terminating event", "[event-detector]" )
+{
+    const State initialState = getRadialMotionState( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorSettings integratorSettings(
+        initialState, 0.0, 2000.0, 10.0, dormandPrince5Integrator, 1.0e-10, 1.0e-10, 100.0 );
+
+    ListOfEventDefinitions listOfEventDefinitions;
+    listOfEventDefinitions.push_back(
+        getDistanceEvent( "approach", 6500.0, terminateEventAction ) );
+    EventDetector eventDetector( EventSettings( "", "", listOfEventDefinitions ) );
+
+    State state = initialState;
+    const IntegrationStatistics statistics = integrateState(
+        integratorSettings, stateDerivativeModel, state, IntegratorObserver( ), 0.0,
+        std::vector< double >( ), &eventDetector );
+
+    // Integration stops at the event, instead of at the end time.
+    REQUIRE( eventDetector.isTerminated( ) );
+    REQUIRE( eventDetector.getTerminationTime( ) == Approx( 500.0 ).epsilon( 1.0e-12 ) );
+    REQUIRE( statistics.finalTime == eventDetector.getTerminationTime( ) );
+    REQUIRE( state[ 0 ] == Approx( 6500.0 ).epsilon( 1.0e-12 ) );
+    REQUIRE( state[ 3 ] == Approx( -1.0 ).epsilon( 1.0e-12 ) );
+
+    const EventLog& eventLog = eventDetector.getEventLog( );
+    REQUIRE( eventLog.size( ) == 1 );
+    REQUIRE( eventLog[ 0 ].name == "approach" );
+    REQUIRE( eventLog[ 0 ].action == terminateEventAction );
+
+    std::ostringstream stream;
+    writeEventLog( stream, eventLog );
+    REQUIRE( stream.str( ).find( "event,t,x,y,z,vx,vy,vz,action,phase\napproach,500" ) == 0 );
+}
+
+TEST_CASE( "Test event direction", "[event-detector]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    State initialState;
+    initialState.fill( 0.0 );
+    initialState[ 0 ] = 7000.0;
+    initialState[ 4 ] = std::sqrt( gravitationalParameter / 7000.0 );
+    const double period = 2.0 * std::acos( -1.0 )
+                          * std::sqrt( 7000.0 * 7000.0 * 7000.0 / gravitationalParameter );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, gravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorSettings integratorSettings( initialState,
+                                                 0.0,
+                                                 1.5 * period,
+                                                 10.0,
+                                                 dormandPrince5Integrator,
+                                                 1.0e-10,
+                                                 1.0e-10,
+                                                 60.0 );
+
+    // The y-coordinate crosses zero falling after half a period and rising after a full period.
+    Position origin;
+    origin.fill( 0.0 );
+    ListOfEventDefinitions listOfEventDefinitions;
+    listOfEventDefinitions.push_back( EventDefinition(
+        "ascending", stateComponentEventType, 0.0, origin, 1, risingEventDirection,
+        logEventAction, "", "" ) );
+    listOfEventDefinitions.push_back( EventDefinition(
+        "descending", stateComponentEventType, 0.0, origin, 1, fallingEventDirection,
+        logEventAction, "", "" ) );
+    EventDetector eventDetector( EventSettings( "", "", listOfEventDefinitions ) );
+
+    State state = initialState;
+    const IntegrationStatistics statistics = integrateState(
+        integratorSettings, stateDerivativeModel, state, IntegratorObserver( ), 0.0,
+        std::vector< double >( ), &eventDetector );
+
+    REQUIRE( !eventDetector.isTerminated( ) );
+    REQUIRE( statistics.finalTime == 1.5 * period );
+
+    const EventLog& eventLog = eventDetector.getEventLog( );
+    REQUIRE( eventLog.size( ) == 2 );
+    REQUIRE( eventLog[ 0 ].name == "descending" );
+    REQUIRE( std::fabs( eventLog[ 0 ].time - 0.5 * period ) < 1.0e-3 );
+    REQUIRE( std::fabs( eventLog[ 0 ].state[ 1 ] ) < 1.0e-6 );
+    REQUIRE( eventLog[ 1 ].name == "ascending" );
+    REQUIRE( std::fabs( eventLog[ 1 ].time - period ) < 1.0e-3 );
+    REQUIRE( std::fabs( eventLog[ 1 ].state[ 1 ] ) < 1.0e-6 );
+}
+
+TEST_CASE( "Test phase switching", "[event-detector]" )
+{
+    const State initialState = getRadialMotionState( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, 398600.4418, listOfAccelerationModels );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    // A single step covers all events, so that the events are handled within one step.
+    const IntegratorSettings integratorSettings(
+        initialState, 0.0, 2000.0, 2000.0, rungeKutta4Integrator, 1.0e-10, 1.0e-10, 2000.0 );
+
+    ListOfEventDefinitions listOfEventDefinitions;
+    listOfEventDefinitions.push_back(
+        getDistanceEvent( "switch", 6800.0, switchPhaseEventAction, "coast", "approach" ) );
+    listOfEventDefinitions.push_back(
+        getDistanceEvent( "coast_only", 6700.0, logEventAction, "coast" ) );
+    listOfEventDefinitions.push_back(
+        getDistanceEvent( "stop", 6600.0, terminateEventAction, "approach" ) );
+    EventDetector eventDetector( EventSettings( "coast", "", listOfEventDefinitions ) );
+
+    State state = initialState;
+    integrateState( integratorSettings, stateDerivativeModel, state, IntegratorObserver( ), 0.0,
+                    std::vector< double >( ), &eventDetector );
+
+    // The event that is only active while coasting is not triggered after the phase switch.
+    REQUIRE( eventDetector.getPhase( ) == "approach" );
+    REQUIRE( eventDetector.isTerminated( ) );
+    REQUIRE( eventDetector.getTerminationTime( ) == Approx( 400.0 ).epsilon( 1.0e-12 ) );
+
+    const EventLog& eventLog = eventDetector.getEventLog( );
+    REQUIRE( eventLog.size( ) == 2 );
+    REQUIRE( eventLog[ 0 ].name == "switch" );
+    REQUIRE( eventLog[ 0 ].time == Approx( 200.0 ).epsilon( 1.0e-12 ) );
+    REQUIRE( eventLog[ 0 ].phase == "coast" );
+    REQUIRE( eventLog[ 1 ].name == "stop" );
+    REQUIRE( eventLog[ 1 ].phase == "approach" );
+}
+
+TEST_CASE( "Test event with invalid state component", "[event-detector]" )
+{
+    Position origin;
+    origin.fill( 0.0 );
+    ListOfEventDefinitions listOfEventDefinitions;
+    listOfEventDefinitions.push_back( EventDefinition(
+        "invalid", stateComponentEventType, 0.0, origin, 6, anyEventDirection,
+        logEventAction, "", "" ) );
+
+    REQUIRE_THROWS_AS( EventDetector( EventSettings( "", "", listOfEventDefinitions ) ),
+                       std::runtime_error );
+}
+
+} // namespace tests
+} // namespace scarab
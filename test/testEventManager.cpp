@@ -9,16 +9,28 @@
 
 #include <catch.hpp>
 
+#include "Scarab/eventManager.hpp"
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/typedefs.hpp"
+
 namespace scarab
 {
 namespace tests
 {
 
-// @todo: write up test suite.
-
-TEST_CASE( "Test event manager class", "[simulator],[settings]" )
+TEST_CASE( "Test event manager class", "[simulator],[event_manager]" )
 {
-    REQUIRE( false );
+    State state;
+    state.fill( 3.0 );
+
+    StateHistory stateHistory;
+    StateHistoryRecorder recorder( stateHistory );
+    EventManager eventManager( recorder );
+    eventManager( state, 10.0 );
+
+    REQUIRE( stateHistory.size( ) == 1 );
+    REQUIRE( stateHistory.getTime( 0 ) == 10.0 );
+    REQUIRE( stateHistory.getState( 0 ) == state );
 }
 
 } // namespace tests
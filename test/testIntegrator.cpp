@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Gravitational parameter of Earth [km^3 s^-2].
+const double earthGravitationalParameter = 398600.4418;
+
+//! Get circular orbit in low Earth orbit.
+State getCircularOrbitState( )
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 7000.0;
+    state[ 4 ] = std::sqrt( earthGravitationalParameter / 7000.0 );
+    return state;
+}
+
+//! Get orbital period of circular orbit in low Earth orbit [s].
+double getCircularOrbitPeriod( )
+{
+    return 2.0 * std::acos( -1.0 )
+           * std::sqrt( 7000.0 * 7000.0 * 7000.0 / earthGravitationalParameter );
+}
+
+//! Observer that records the times of all samples.
+struct TimeRecorder
+{
+    TimeRecorder( std::vector< double >& aListOfTimes )
+        : listOfTimes( aListOfTimes )
+    { }
+
+    void operator( )( const State& /* state */, const double time )
+    {
+        listOfTimes.push_back( time );
+    }
+
+    std::vector< double >& listOfTimes;
+};
+
+TEST_CASE( "Test integrator names", "[integrator]" )
+{
+    const IntegratorType integrators[ ] = { rungeKutta4Integrator,
+                                            dormandPrince5Integrator,
+                                            cashKarp54Integrator,
+                                            fehlberg78Integrator,
+                                            bulirschStoerIntegrator,
+                                            adamsBashforthMoultonIntegrator };
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        REQUIRE( getIntegratorType( getIntegratorName( integrators[ i ] ) ) == integrators[ i ] );
+    }
+
+    REQUIRE( getIntegratorType( "dopri5" ) == dormandPrince5Integrator );
+    REQUIRE_THROWS_AS( getIntegratorType( "euler" ), std::runtime_error );
+}
+
+TEST_CASE( "Test integrators over one orbital period", "[integrator]" )
+{
+    const State initialState = getCircularOrbitState( );
+    const double period = getCircularOrbitPeriod( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, earthGravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorType integrators[ ] = { rungeKutta4Integrator,
+                                            dormandPrince5Integrator,
+                                            cashKarp54Integrator,
+                                            fehlberg78Integrator,
+                                            bulirschStoerIntegrator,
+                                            adamsBashforthMoultonIntegrator };
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        const double maximumStep = 60.0;
+        const IntegratorSettings settings( initialState,
+                                           0.0,
+                                           period,
+                                           10.0,
+                                           integrators[ i ],
+                                           1.0e-10,
+                                           1.0e-10,
+                                           maximumStep );
+
+        State state = initialState;
+        std::vector< double > listOfTimes;
+        const IntegrationStatistics statistics
+            = integrateState( settings, stateDerivativeModel, state, TimeRecorder( listOfTimes ) );
+
+        INFO( "Integrator: " << getIntegratorName( integrators[ i ] ) );
+
+        // After one orbital period, the initial state is recovered.
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            REQUIRE( std::fabs( state[ j ] - initialState[ j ] ) < 1.0e-3 );
+            REQUIRE( std::fabs( state[ j + 3 ] - initialState[ j + 3 ] ) < 1.0e-6 );
+        }
+
+        // The observer is called for the initial state and after every accepted step, the last
+        // step ends exactly at the end time and no step exceeds the maximum step.
+        REQUIRE( listOfTimes.size( ) == statistics.numberOfAcceptedSteps + 1 );
+        REQUIRE( listOfTimes.front( ) == 0.0 );
+        REQUIRE( listOfTimes.back( ) == period );
+        for ( unsigned int j = 1; j < listOfTimes.size( ); j++ )
+        {
+            REQUIRE( listOfTimes[ j ] > listOfTimes[ j - 1 ] );
+            REQUIRE( listOfTimes[ j ] - listOfTimes[ j - 1 ] <= maximumStep * ( 1.0 + 1.0e-12 ) );
+        }
+
+        REQUIRE( statistics.numberOfFunctionEvaluations >= statistics.numberOfAcceptedSteps );
+    }
+}
+
+TEST_CASE( "Test integration statistics", "[integrator]" )
+{
+    const State initialState = getCircularOrbitState( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, earthGravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    SECTION( "Fixed-step Runge-Kutta method takes four function evaluations per step" )
+    {
+        const IntegratorSettings settings( initialState,
+                                           0.0,
+                                           1000.0,
+                                           30.0,
+                                           rungeKutta4Integrator,
+                                           1.0e-6,
+                                           1.0e-6,
+                                           1000.0 );
+        State state = initialState;
+        const IntegrationStatistics statistics
+            = integrateState( settings, stateDerivativeModel, state );
+
+        REQUIRE( statistics.numberOfAcceptedSteps == 34 );
+        REQUIRE( statistics.numberOfRejectedSteps == 0 );
+        REQUIRE( statistics.numberOfFunctionEvaluations == 4 * 34 );
+        REQUIRE( statistics.minimumStepSize == Approx( 1000.0 / 34 ) );
+        REQUIRE( statistics.maximumStepSize == Approx( 1000.0 / 34 ) );
+    }
+
+    SECTION( "Adams-Bashforth-Moulton method takes two function evaluations per step" )
+    {
+        const IntegratorSettings settings( initialState,
+                                           0.0,
+                                           6000.0,
+                                           10.0,
+                                           adamsBashforthMoultonIntegrator,
+                                           1.0e-6,
+                                           1.0e-6,
+                                           6000.0 );
+        State state = initialState;
+        const IntegrationStatistics statistics
+            = integrateState( settings, stateDerivativeModel, state );
+
+        // The first steps are taken with a Runge-Kutta method, to build up the history of the
+        // multistep method.
+        REQUIRE( statistics.numberOfAcceptedSteps == 600 );
+        REQUIRE( statistics.numberOfFunctionEvaluations > 2 * 600 );
+        REQUIRE( statistics.numberOfFunctionEvaluations <= 2 * 600 + 4 * 5 );
+    }
+
+    SECTION( "Tighter tolerances take more steps" )
+    {
+        State state = initialState;
+        const IntegrationStatistics looseStatistics = integrateState(
+            IntegratorSettings( initialState, 0.0, 6000.0, 10.0, dormandPrince5Integrator,
+                                1.0e-6, 1.0e-6, 6000.0 ),
+            stateDerivativeModel, state );
+
+        state = initialState;
+        const IntegrationStatistics tightStatistics = integrateState(
+            IntegratorSettings( initialState, 0.0, 6000.0, 10.0, dormandPrince5Integrator,
+                                1.0e-12, 1.0e-12, 6000.0 ),
+            stateDerivativeModel, state );
+
+        REQUIRE( tightStatistics.numberOfAcceptedSteps > looseStatistics.numberOfAcceptedSteps );
+        REQUIRE( tightStatistics.numberOfFunctionEvaluations
+                 > looseStatistics.numberOfFunctionEvaluations );
+        REQUIRE( tightStatistics.minimumStepSize > 0.0 );
+        REQUIRE( tightStatistics.minimumStepSize <= tightStatistics.maximumStepSize );
+        REQUIRE( tightStatistics.maximumStepSize < looseStatistics.maximumStepSize );
+        REQUIRE( looseStatistics.maximumStepSize <= 6000.0 );
+    }
+
+    SECTION( "Integration continued with suggested step size does not start again" )
+    {
+        const double startTime = 0.0;
+        const double splitTime = 3000.0;
+        const double endTime = 6000.0;
+
+        State state = initialState;
+        const IntegrationStatistics fixedStatistics = integrateState(
+            IntegratorSettings( initialState, startTime, endTime, 30.0, rungeKutta4Integrator,
+                                1.0e-10, 1.0e-10, endTime ),
+            stateDerivativeModel, state );
+        REQUIRE( fixedStatistics.nextStepSize == 0.0 );
+
+        state = initialState;
+        const IntegrationStatistics statistics = integrateState(
+            IntegratorSettings( initialState, startTime, endTime, 10.0, dormandPrince5Integrator,
+                                1.0e-10, 1.0e-10, endTime ),
+            stateDerivativeModel, state );
+
+        state = initialState;
+        const IntegrationStatistics firstStatistics = integrateState(
+            IntegratorSettings( initialState, startTime, splitTime, 10.0,
+                                dormandPrince5Integrator, 1.0e-10, 1.0e-10, endTime ),
+            stateDerivativeModel, state );
+        REQUIRE( firstStatistics.nextStepSize >= firstStatistics.minimumStepSize );
+
+        const State splitState = state;
+        const IntegrationStatistics continuedStatistics = integrateState(
+            IntegratorSettings( splitState, splitTime, endTime, firstStatistics.nextStepSize,
+                                dormandPrince5Integrator, 1.0e-10, 1.0e-10, endTime ),
+            stateDerivativeModel, state );
+
+        state = splitState;
+        const IntegrationStatistics restartedStatistics = integrateState(
+            IntegratorSettings( splitState, splitTime, endTime, 10.0,
+                                dormandPrince5Integrator, 1.0e-10, 1.0e-10, endTime ),
+            stateDerivativeModel, state );
+
+        REQUIRE( firstStatistics.numberOfAcceptedSteps + continuedStatistics.numberOfAcceptedSteps
+                 <= statistics.numberOfAcceptedSteps + 2 );
+        REQUIRE( continuedStatistics.numberOfAcceptedSteps
+                 < restartedStatistics.numberOfAcceptedSteps );
+    }
+
+    SECTION( "Statistics of multiple integrations are accumulated" )
+    {
+        State state = initialState;
+        const IntegrationStatistics fixedStatistics = integrateState(
+            IntegratorSettings( initialState, 0.0, 1000.0, 30.0, rungeKutta4Integrator,
+                                1.0e-6, 1.0e-6, 1000.0 ),
+            stateDerivativeModel, state );
+
+        state = initialState;
+        const IntegrationStatistics adaptiveStatistics = integrateState(
+            IntegratorSettings( initialState, 0.0, 6000.0, 10.0, dormandPrince5Integrator,
+                                1.0e-10, 1.0e-10, 6000.0 ),
+            stateDerivativeModel, state );
+
+        IntegrationStatistics totalStatistics;
+        accumulateIntegrationStatistics( IntegrationStatistics( ), totalStatistics );
+        accumulateIntegrationStatistics( fixedStatistics, totalStatistics );
+        accumulateIntegrationStatistics( adaptiveStatistics, totalStatistics );
+
+        REQUIRE( totalStatistics.numberOfFunctionEvaluations
+                 == fixedStatistics.numberOfFunctionEvaluations
+                    + adaptiveStatistics.numberOfFunctionEvaluations );
+        REQUIRE( totalStatistics.numberOfAcceptedSteps
+                 == fixedStatistics.numberOfAcceptedSteps
+                    + adaptiveStatistics.numberOfAcceptedSteps );
+        REQUIRE( totalStatistics.numberOfRejectedSteps
+                 == fixedStatistics.numberOfRejectedSteps
+                    + adaptiveStatistics.numberOfRejectedSteps );
+        REQUIRE( totalStatistics.minimumStepSize
+                 == std::min( fixedStatistics.minimumStepSize,
+                              adaptiveStatistics.minimumStepSize ) );
+        REQUIRE( totalStatistics.maximumStepSize
+                 == std::max( fixedStatistics.maximumStepSize,
+                              adaptiveStatistics.maximumStepSize ) );
+    }
+}
+
+TEST_CASE( "Test interpolation of state within integration step", "[integrator]" )
+{
+    // The interpolant is exact for positions that are quintic polynomials in time.
+    const double coefficients[ 3 ][ 6 ] = { { 7000.0, 0.5, -0.01, 2.0e-4, -3.0e-6, 1.0e-8 },
+                                            { -20.0, 7.5, 0.02, -1.0e-4, 5.0e-6, -2.0e-8 },
+                                            { 3.0, 1.0, -0.005, 3.0e-5, 1.0e-6, 4.0e-9 } };
+
+    struct QuinticMotion
+    {
+        static State getState( const double coefficients[ 3 ][ 6 ], const double time )
+        {
+            State state;
+            for ( unsigned int i = 0; i < 3; i++ )
+            {
+                const double* c = coefficients[ i ];
+                state[ i ] = c[ 0 ] + time * ( c[ 1 ] + time * ( c[ 2 ] + time * (
+                    c[ 3 ] + time * ( c[ 4 ] + time * c[ 5 ] ) ) ) );
+                state[ i + 3 ] = c[ 1 ] + time * ( 2.0 * c[ 2 ] + time * ( 3.0 * c[ 3 ] + time * (
+                    4.0 * c[ 4 ] + time * 5.0 * c[ 5 ] ) ) );
+            }
+            return state;
+        }
+
+        static State getStateDerivative( const double coefficients[ 3 ][ 6 ], const double time )
+        {
+            const State state = getState( coefficients, time );
+            State stateDerivative;
+            for ( unsigned int i = 0; i < 3; i++ )
+            {
+                const double* c = coefficients[ i ];
+                stateDerivative[ i ] = state[ i + 3 ];
+                stateDerivative[ i + 3 ] = 2.0 * c[ 2 ] + time * ( 6.0 * c[ 3 ] + time * (
+                    12.0 * c[ 4 ] + time * 20.0 * c[ 5 ] ) );
+            }
+            return stateDerivative;
+        }
+    };
+
+    const double startTime = 10.0;
+    const double endTime = 70.0;
+    for ( double time = startTime; time <= endTime; time += 7.5 )
+    {
+        const State state = interpolateState(
+            time,
+            startTime,
+            QuinticMotion::getState( coefficients, startTime ),
+            QuinticMotion::getStateDerivative( coefficients, startTime ),
+            endTime,
+            QuinticMotion::getState( coefficients, endTime ),
+            QuinticMotion::getStateDerivative( coefficients, endTime ) );
+        const State expectedState = QuinticMotion::getState( coefficients, time );
+
+        for ( unsigned int i = 0; i < state.size( ); i++ )
+        {
+            REQUIRE( state[ i ] == Approx( expectedState[ i ] ).epsilon( 1.0e-12 ) );
+        }
+    }
+}
+
+TEST_CASE( "Test dense output at fixed output interval", "[integrator]" )
+{
+    const State initialState = getCircularOrbitState( );
+    const double period = getCircularOrbitPeriod( );
+    const double meanMotion = 2.0 * std::acos( -1.0 ) / period;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, earthGravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorType integrators[ ] = { rungeKutta4Integrator,
+                                            dormandPrince5Integrator,
+                                            cashKarp54Integrator,
+                                            fehlberg78Integrator,
+                                            bulirschStoerIntegrator,
+                                            adamsBashforthMoultonIntegrator };
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        INFO( "Integrator: " << getIntegratorName( integrators[ i ] ) );
+
+        const IntegratorSettings settings( initialState,
+                                           0.0,
+                                           period,
+                                           10.0,
+                                           integrators[ i ],
+                                           1.0e-10,
+                                           1.0e-10,
+                                           300.0 );
+
+        // Output interval that does not divide the orbital period: the end time is not sampled.
+        const double outputInterval = 45.0;
+        State state = initialState;
+        std::vector< double > listOfTimes;
+        std::vector< State > listOfStates;
+        const IntegrationStatistics sampledStatistics = integrateState(
+            settings,
+            stateDerivativeModel,
+            state,
+            [ &listOfTimes, &listOfStates ]( const State& sampledState, const double time )
+            {
+                listOfTimes.push_back( time );
+                listOfStates.push_back( sampledState );
+            },
+            outputInterval );
+        const State sampledFinalState = state;
+
+        REQUIRE( listOfTimes.size( ) == static_cast< std::size_t >( period / outputInterval ) + 1 );
+        for ( unsigned int j = 0; j < listOfTimes.size( ); j++ )
+        {
+            REQUIRE( listOfTimes[ j ] == j * outputInterval );
+
+            const double angle = meanMotion * listOfTimes[ j ];
+            REQUIRE( std::fabs( listOfStates[ j ][ 0 ] - 7000.0 * std::cos( angle ) ) < 1.0e-3 );
+            REQUIRE( std::fabs( listOfStates[ j ][ 1 ] - 7000.0 * std::sin( angle ) ) < 1.0e-3 );
+            REQUIRE( std::fabs( listOfStates[ j ][ 3 ] + initialState[ 4 ] * std::sin( angle ) )
+                     < 1.0e-5 );
+            REQUIRE( std::fabs( listOfStates[ j ][ 4 ] - initialState[ 4 ] * std::cos( angle ) )
+                     < 1.0e-5 );
+        }
+
+        // Sampling does not change the steps taken by the integrator.
+        state = initialState;
+        const IntegrationStatistics statistics
+            = integrateState( settings, stateDerivativeModel, state );
+        REQUIRE( sampledFinalState == state );
+        REQUIRE( sampledStatistics.numberOfAcceptedSteps == statistics.numberOfAcceptedSteps );
+        REQUIRE( sampledStatistics.numberOfRejectedSteps == statistics.numberOfRejectedSteps );
+    }
+}
+
+TEST_CASE( "Test dense output at list of output epochs", "[integrator]" )
+{
+    const State initialState = getCircularOrbitState( );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, earthGravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    const IntegratorSettings settings( initialState,
+                                       100.0,
+                                       1000.0,
+                                       10.0,
+                                       dormandPrince5Integrator,
+                                       1.0e-10,
+                                       1.0e-10,
+                                       900.0 );
+
+    // Epochs outside the integration interval are skipped; epochs at the start and end time
+    // return the initial and final state.
+    std::vector< double > outputEpochs;
+    outputEpochs.push_back( 0.0 );
+    outputEpochs.push_back( 100.0 );
+    outputEpochs.push_back( 123.456 );
+    outputEpochs.push_back( 500.0 );
+    outputEpochs.push_back( 1000.0 );
+    outputEpochs.push_back( 1500.0 );
+
+    State state = initialState;
+    std::vector< double > listOfTimes;
+    std::vector< State > listOfStates;
+    integrateState( settings,
+                    stateDerivativeModel,
+                    state,
+                    [ &listOfTimes, &listOfStates ]( const State& sampledState, const double time )
+                    {
+                        listOfTimes.push_back( time );
+                        listOfStates.push_back( sampledState );
+                    },
+                    0.0,
+                    outputEpochs );
+
+    REQUIRE( listOfTimes.size( ) == 4 );
+    REQUIRE( listOfTimes[ 0 ] == 100.0 );
+    REQUIRE( listOfTimes[ 1 ] == 123.456 );
+    REQUIRE( listOfTimes[ 2 ] == 500.0 );
+    REQUIRE( listOfTimes[ 3 ] == 1000.0 );
+    REQUIRE( listOfStates.front( ) == initialState );
+    REQUIRE( listOfStates.back( ) == state );
+}
+
+} // namespace tests
+} // namespace scarab
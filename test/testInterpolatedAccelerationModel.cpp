@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/interpolatedAccelerationModel.hpp"
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create spherical harmonics gravity model of degree and order 8 with fixed random coefficients.
+AccelerationModel3dPtr createInterpolationTestModel( const double rotationRate )
+{
+    SphericalHarmonicsCoefficients coefficients( 8, 8 );
+    std::mt19937 generator( 3 );
+    std::uniform_real_distribution< double > distribution( -1.0e-6, 1.0e-6 );
+    for ( unsigned int n = 2; n <= coefficients.degree; n++ )
+    {
+        for ( unsigned int m = 0; m <= n; m++ )
+        {
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            coefficients.cosineCoefficients[ index ] = distribution( generator );
+            coefficients.sineCoefficients[ index ] = m == 0 ? 0.0 : distribution( generator );
+        }
+    }
+    coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 0 ) ]
+        = -4.84165e-4;
+    return boost::make_shared< SphericalHarmonicsGravityModel >(
+        398600.4418, 6378.1363, coefficients, rotationRate );
+}
+
+//! Get state at position in proximity region, at given offset [km] from a reference point.
+State getProximityState( const double offsetX, const double offsetY, const double offsetZ )
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 4000.0 + offsetX;
+    state[ 1 ] = -3000.0 + offsetY;
+    state[ 2 ] = 4500.0 + offsetZ;
+    return state;
+}
+
+TEST_CASE( "Test interpolated acceleration model against wrapped model", "[interpolation]" )
+{
+    const AccelerationModel3dPtr wrappedModel = createInterpolationTestModel( 0.0 );
+    const double tolerance = 1.0e-13;
+    const InterpolatedAccelerationModel model( wrappedModel, 1.0, tolerance, 1000 );
+
+    std::mt19937 generator( 11 );
+    std::uniform_real_distribution< double > distribution( -2.0, 2.0 );
+    for ( unsigned int i = 0; i < 500; i++ )
+    {
+        const State state = getProximityState(
+            distribution( generator ), distribution( generator ), distribution( generator ) );
+        const Acceleration acceleration = model( state, 0.0 );
+        const Acceleration expectedAcceleration = ( *wrappedModel )( state, 0.0 );
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            REQUIRE( std::fabs( acceleration[ j ] - expectedAcceleration[ j ] ) < tolerance );
+        }
+    }
+
+    // The region of 4 km x 4 km x 4 km visited spans at most 5 x 5 x 5 cells of 1 km.
+    const InterpolationStatistics statistics = model.getStatistics( );
+    REQUIRE( statistics.numberOfHits + statistics.numberOfMisses == 500 );
+    REQUIRE( statistics.numberOfMisses == statistics.numberOfCells );
+    REQUIRE( statistics.numberOfCells <= 125 );
+    REQUIRE( statistics.numberOfHits > 300 );
+    REQUIRE( statistics.numberOfFallbacks == 0 );
+    REQUIRE( statistics.numberOfRejectedCells == 0 );
+    REQUIRE( statistics.maximumErrorEstimate > 0.0 );
+    REQUIRE( statistics.maximumErrorEstimate <= tolerance );
+}
+
+TEST_CASE( "Test interpolated acceleration model counters", "[interpolation]" )
+{
+    const AccelerationModel3dPtr wrappedModel = createInterpolationTestModel( 0.0 );
+    const State state = getProximityState( 0.3, 0.3, 0.3 );
+    const State otherState = getProximityState( 0.7, 0.6, 0.5 );
+
+    SECTION( "Miss builds cell and subsequent calls in cell hit" )
+    {
+        const InterpolatedAccelerationModel model( wrappedModel, 1.0, 1.0e-13, 1000 );
+        model( state, 0.0 );
+        REQUIRE( model.getStatistics( ).numberOfMisses == 1 );
+        REQUIRE( model.getStatistics( ).numberOfHits == 0 );
+        model( otherState, 0.0 );
+        model( state, 0.0 );
+        REQUIRE( model.getStatistics( ).numberOfMisses == 1 );
+        REQUIRE( model.getStatistics( ).numberOfHits == 2 );
+        REQUIRE( model.getStatistics( ).numberOfCells == 1 );
+    }
+
+    SECTION( "Cells with error estimate above tolerance are rejected" )
+    {
+        const InterpolatedAccelerationModel model( wrappedModel, 1.0, 1.0e-30, 1000 );
+        const Acceleration acceleration = model( state, 0.0 );
+        model( otherState, 0.0 );
+        const InterpolationStatistics statistics = model.getStatistics( );
+        REQUIRE( statistics.numberOfHits == 0 );
+        REQUIRE( statistics.numberOfMisses == 2 );
+        REQUIRE( statistics.numberOfFallbacks == 2 );
+        REQUIRE( statistics.numberOfCells == 1 );
+        REQUIRE( statistics.numberOfRejectedCells == 1 );
+
+        const Acceleration expectedAcceleration = ( *wrappedModel )( state, 0.0 );
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            REQUIRE( acceleration[ j ] == expectedAcceleration[ j ] );
+        }
+    }
+
+    SECTION( "Wrapped model is evaluated directly if grid is full" )
+    {
+        const InterpolatedAccelerationModel model( wrappedModel, 1.0, 1.0e-13, 0 );
+        model( state, 0.0 );
+        model( otherState, 0.0 );
+        const InterpolationStatistics statistics = model.getStatistics( );
+        REQUIRE( statistics.numberOfMisses == 2 );
+        REQUIRE( statistics.numberOfFallbacks == 2 );
+        REQUIRE( statistics.numberOfCells == 0 );
+    }
+}
+
+TEST_CASE( "Test interpolated acceleration model in rotating frame", "[interpolation]" )
+{
+    const double rotationRate = 7.292115e-5;
+    const AccelerationModel3dPtr wrappedModel = createInterpolationTestModel( rotationRate );
+    const double tolerance = 1.0e-13;
+    const InterpolatedAccelerationModel model( wrappedModel, 1.0, tolerance, 1000, rotationRate );
+
+    const double times[ ] = { 0.0, 1000.0, 20000.0 };
+    for ( unsigned int i = 0; i < sizeof( times ) / sizeof( times[ 0 ] ); i++ )
+    {
+        const State state = getProximityState( 0.25, -0.5, 0.75 );
+        const Acceleration acceleration = model( state, times[ i ] );
+        const Acceleration expectedAcceleration = ( *wrappedModel )( state, times[ i ] );
+        for ( unsigned int j = 0; j < 3; j++ )
+        {
+            REQUIRE( std::fabs( acceleration[ j ] - expectedAcceleration[ j ] ) < tolerance );
+        }
+    }
+}
+
+TEST_CASE( "Test interpolated acceleration model with invalid parameters", "[interpolation]" )
+{
+    const AccelerationModel3dPtr wrappedModel = createInterpolationTestModel( 0.0 );
+    REQUIRE_THROWS_AS( InterpolatedAccelerationModel( wrappedModel, 0.0, 1.0e-13, 1000 ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS( InterpolatedAccelerationModel( wrappedModel, 1.0, -1.0, 1000 ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS(
+        InterpolatedAccelerationModel( AccelerationModel3dPtr( ), 1.0, 1.0e-13, 1000 ),
+        std::runtime_error );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/interpolatedTrajectory.hpp"
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state on circular test orbit at given time.
+State getInterpolatedTrajectoryTestState( const double time )
+{
+    const double radius = 7000.0;
+    const double meanMotion = std::sqrt( 398600.4418 / ( radius * radius * radius ) );
+    const double angle = meanMotion * time;
+
+    State state;
+    state[ 0 ] = radius * std::cos( angle );
+    state[ 1 ] = radius * std::sin( angle );
+    state[ 2 ] = 0.0;
+    state[ 3 ] = -radius * meanMotion * std::sin( angle );
+    state[ 4 ] = radius * meanMotion * std::cos( angle );
+    state[ 5 ] = 0.0;
+    return state;
+}
+
+TEST_CASE( "Test interpolated trajectory", "[output],[interpolated_trajectory]" )
+{
+    // Sample orbit at irregular epochs, as taken by an adaptive integrator.
+    StateHistory stateHistory;
+    double time = 0.0;
+    for ( unsigned int i = 0; i < 200; i++ )
+    {
+        stateHistory.append( time, getInterpolatedTrajectoryTestState( time ) );
+        time += 5.0 + 10.0 * ( i % 3 );
+    }
+
+    const InterpolatedTrajectory trajectory( stateHistory );
+    REQUIRE( trajectory.getNumberOfSamples( ) == 200 );
+    REQUIRE( trajectory.getStartTime( ) == 0.0 );
+    REQUIRE( trajectory.getEndTime( ) == stateHistory.getTime( stateHistory.size( ) - 1 ) );
+
+    SECTION( "Samples are reproduced exactly" )
+    {
+        for ( unsigned int i = 0; i < stateHistory.size( ); i++ )
+        {
+            const State state = trajectory.getState( stateHistory.getTime( i ) );
+            const State sample = stateHistory.getState( i );
+            for ( unsigned int j = 0; j < state.size( ); j++ )
+            {
+                REQUIRE( state[ j ] == Approx( sample[ j ] ).margin( 1.0e-12 ) );
+            }
+        }
+    }
+
+    SECTION( "States in between samples are interpolated" )
+    {
+        TrajectoryCursor cursor( trajectory );
+        for ( double queryTime = 0.0; queryTime <= trajectory.getEndTime( ); queryTime += 0.7 )
+        {
+            const State state = trajectory.getState( queryTime );
+            const State expectedState = getInterpolatedTrajectoryTestState( queryTime );
+            for ( unsigned int j = 0; j < 3; j++ )
+            {
+                REQUIRE( state[ j ] == Approx( expectedState[ j ] ).margin( 1.0e-5 ) );
+                REQUIRE( state[ j + 3 ] == Approx( expectedState[ j + 3 ] ).margin( 5.0e-6 ) );
+            }
+
+            // Cursor gives the same result for monotone queries.
+            const State cursorState = cursor.getState( queryTime );
+            for ( unsigned int j = 0; j < state.size( ); j++ )
+            {
+                REQUIRE( cursorState[ j ] == state[ j ] );
+            }
+
+            REQUIRE( trajectory.getPosition( queryTime )[ 1 ] == state[ 1 ] );
+        }
+
+        // Cursor also handles queries that jump backwards.
+        REQUIRE( cursor.getState( 100.0 )[ 0 ] == trajectory.getState( 100.0 )[ 0 ] );
+        REQUIRE( cursor.getState( trajectory.getEndTime( ) )[ 0 ]
+                 == trajectory.getState( trajectory.getEndTime( ) )[ 0 ] );
+    }
+
+    SECTION( "Epochs outside of trajectory are rejected" )
+    {
+        TrajectoryCursor cursor( trajectory );
+        REQUIRE_THROWS( trajectory.getState( -1.0 ) );
+        REQUIRE_THROWS( trajectory.getState( trajectory.getEndTime( ) + 1.0 ) );
+        REQUIRE_THROWS( cursor.getState( trajectory.getEndTime( ) + 1.0 ) );
+    }
+
+    StateHistory singleSample;
+    singleSample.append( 0.0, getInterpolatedTrajectoryTestState( 0.0 ) );
+    REQUIRE_THROWS( InterpolatedTrajectory( singleSample ) );
+}
+
+TEST_CASE( "Test interpolated trajectory from binary trajectory file",
+           "[output],[interpolated_trajectory]" )
+{
+    const std::string filename = "testInterpolatedTrajectory.bin";
+
+    {
+        BinaryStateHistoryWriter writer( filename, 4 );
+        for ( unsigned int i = 0; i <= 6; i++ )
+        {
+            writer.write( 10.0 * i, getInterpolatedTrajectoryTestState( 10.0 * i ) );
+        }
+        writer.close( TrajectoryMetadata( ) );
+    }
+
+    {
+        const TrajectoryFileReader reader( filename );
+        const InterpolatedTrajectory trajectory( reader );
+        REQUIRE( trajectory.getNumberOfSamples( ) == 7 );
+
+        REQUIRE( trajectory.getState( 25.0 )[ 0 ]
+                 == Approx( getInterpolatedTrajectoryTestState( 25.0 )[ 0 ] ).margin( 1.0e-5 ) );
+        REQUIRE( trajectory.getState( 50.0 ) == getInterpolatedTrajectoryTestState( 50.0 ) );
+        REQUIRE( trajectory.findInterval( 50.0 ) == 5 );
+        REQUIRE( trajectory.findInterval( 60.0 ) == 5 );
+
+        TrajectoryCursor cursor( trajectory );
+        REQUIRE( cursor.getState( 45.0 ) == trajectory.getState( 45.0 ) );
+        REQUIRE( cursor.getState( 60.0 ) == getInterpolatedTrajectoryTestState( 60.0 ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test interpolated trajectory rejects samples not in strictly ascending order",
+           "[output],[interpolated_trajectory]" )
+{
+    const std::string filename = "testInterpolatedTrajectoryRepeatedEpoch.bin";
+
+    // Impulsive manoeuvre at t = 50 s is stored as two samples with the same epoch, which would
+    // give an interval of zero length.
+    {
+        BinaryStateHistoryWriter writer( filename, 4 );
+        for ( unsigned int i = 0; i <= 5; i++ )
+        {
+            writer.write( 10.0 * i, getInterpolatedTrajectoryTestState( 10.0 * i ) );
+        }
+        State state = getInterpolatedTrajectoryTestState( 50.0 );
+        state[ 5 ] = 0.1;
+        writer.write( 50.0, state );
+        writer.close( TrajectoryMetadata( ) );
+    }
+
+    {
+        const TrajectoryFileReader reader( filename );
+        REQUIRE_THROWS_AS( InterpolatedTrajectory( reader ), std::runtime_error );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
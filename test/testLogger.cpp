@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/logger.hpp"
+#include "Scarab/threadPool.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test log levels", "[logger]" )
+{
+    REQUIRE( getLogLevel( "quiet" ) == quietLogLevel );
+    REQUIRE( getLogLevel( "info" ) == infoLogLevel );
+    REQUIRE( getLogLevel( "debug" ) == debugLogLevel );
+    REQUIRE_THROWS( getLogLevel( "verbose" ) );
+
+    std::ostringstream sink;
+    setLogSink( sink );
+
+    setLogLevel( infoLogLevel );
+    logInfo( ) << "info" << std::endl;
+    logDebug( ) << "debug" << std::endl;
+    flushLog( );
+    REQUIRE( sink.str( ) == "info\n" );
+
+    setLogLevel( debugLogLevel );
+    logDebug( ) << "debug" << std::endl;
+    flushLog( );
+    REQUIRE( sink.str( ) == "info\ndebug\n" );
+
+    setLogLevel( quietLogLevel );
+    logInfo( ) << "info" << std::endl;
+    flushLog( );
+    REQUIRE( sink.str( ) == "info\ndebug\n" );
+
+    setLogLevel( infoLogLevel );
+    setLogSink( std::cout );
+}
+
+TEST_CASE( "Test log is buffered until flushed", "[logger]" )
+{
+    std::ostringstream sink;
+    setLogSink( sink );
+
+    logInfo( ) << "first line" << std::endl;
+    logInfo( ) << "second line" << std::endl;
+    REQUIRE( sink.str( ).empty( ) );
+
+    flushLog( );
+    REQUIRE( sink.str( ) == "first line\nsecond line\n" );
+
+    setLogSink( std::cout );
+}
+
+TEST_CASE( "Test log sink change flushes all threads", "[logger]" )
+{
+    std::ostringstream firstSink;
+    setLogSink( firstSink );
+
+    std::ostringstream secondSink;
+    {
+        // The worker thread is still alive when the sink is changed.
+        ThreadPool threadPool( 1 );
+        threadPool.submit( [ ]( ) { logInfo( ) << "worker line" << std::endl; } );
+        threadPool.wait( );
+        REQUIRE( firstSink.str( ).empty( ) );
+
+        setLogSink( secondSink );
+        REQUIRE( firstSink.str( ) == "worker line\n" );
+    }
+    REQUIRE( secondSink.str( ).empty( ) );
+
+    setLogSink( std::cout );
+}
+
+TEST_CASE( "Test log of multiple threads", "[logger]" )
+{
+    std::ostringstream sink;
+    setLogSink( sink );
+
+    const unsigned int numberOfTasks = 100;
+    {
+        // The log buffers of the worker threads are flushed when the threads exit.
+        ThreadPool threadPool( 4 );
+        for ( unsigned int i = 0; i < numberOfTasks; i++ )
+        {
+            threadPool.submit( [ i ]( )
+                               {
+                                   logInfo( ) << "task " << i << " started" << std::endl;
+                                   logInfo( ) << "task " << i << " completed" << std::endl;
+                               } );
+        }
+        threadPool.wait( );
+    }
+
+    // Lines of different threads are not interleaved, and every task logs both lines in order.
+    std::istringstream log( sink.str( ) );
+    std::string line;
+    unsigned int numberOfLines = 0;
+    while ( std::getline( log, line ) )
+    {
+        std::istringstream words( line );
+        std::string task;
+        unsigned int index = 0;
+        std::string status;
+        words >> task >> index >> status;
+        REQUIRE( task == "task" );
+        REQUIRE( index < numberOfTasks );
+        REQUIRE( status == "started" );
+
+        REQUIRE( std::getline( log, line ) );
+        std::ostringstream expectedLine;
+        expectedLine << "task " << index << " completed";
+        REQUIRE( line == expectedLine.str( ) );
+        numberOfLines += 2;
+    }
+    REQUIRE( numberOfLines == 2 * numberOfTasks );
+
+    setLogSink( std::cout );
+}
+
+} // namespace tests
+} // namespace scarab
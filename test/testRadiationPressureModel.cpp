@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/radiationPressureModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Radius of Earth [km].
+const double earthRadius = 6378.1363;
+
+//! Radius of Sun [km].
+const double sunRadius = 695700.0;
+
+//! Get position vector of Sun along the x-axis, at 1 AU [m].
+Position getVectorToSun( )
+{
+    Position vectorToSun;
+    vectorToSun[ 0 ] = 1.495978707e11;
+    vectorToSun[ 1 ] = 0.0;
+    vectorToSun[ 2 ] = 0.0;
+    return vectorToSun;
+}
+
+//! Get state at given position, at rest.
+State getStateAtPosition( const double x, const double y, const double z )
+{
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = x;
+    state[ 1 ] = y;
+    state[ 2 ] = z;
+    return state;
+}
+
+TEST_CASE( "Test radiation pressure acceleration", "[acceleration_models]" )
+{
+    // Acceleration of 4.56e-6 N m^-2 * 1.5 * 10 m^2 / 100 kg = 6.84e-7 m s^-2, away from Sun.
+    const RadiationPressureModel model(
+        4.56e-6, 1.5, 10.0, 100.0, getVectorToSun( ), conicalShadowModel, earthRadius, sunRadius );
+
+    const Acceleration acceleration = model( getStateAtPosition( 0.0, 7000.0, 0.0 ), 0.0 );
+    REQUIRE( acceleration[ 0 ] == Approx( -6.84e-10 ).epsilon( 1.0e-6 ) );
+    REQUIRE( acceleration[ 1 ] == Approx( 6.84e-10 * 7.0e3 / 1.495978707e8 ).epsilon( 1.0e-6 ) );
+    REQUIRE( acceleration[ 2 ] == 0.0 );
+
+    // Without shadow, the acceleration is the same behind the central body.
+    const RadiationPressureModel unshadowedModel(
+        4.56e-6, 1.5, 10.0, 100.0, getVectorToSun( ), noShadowModel, earthRadius, sunRadius );
+    const Acceleration unshadowedAcceleration
+        = unshadowedModel( getStateAtPosition( -7000.0, 0.0, 0.0 ), 0.0 );
+    REQUIRE( unshadowedAcceleration[ 0 ] == Approx( -6.84e-10 ).epsilon( 1.0e-6 ) );
+}
+
+TEST_CASE( "Test cylindrical shadow", "[acceleration_models]" )
+{
+    const RadiationPressureModel model( 4.56e-6,
+                                        1.5,
+                                        10.0,
+                                        100.0,
+                                        getVectorToSun( ),
+                                        cylindricalShadowModel,
+                                        earthRadius,
+                                        sunRadius );
+
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( 7000.0, 0.0, 0.0 ) ) == 1.0 );
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( 0.0, 7000.0, 0.0 ) ) == 1.0 );
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( -7000.0, 0.0, 0.0 ) ) == 0.0 );
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( -7000.0, 6000.0, 0.0 ) ) == 0.0 );
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( -7000.0, 0.0, 6400.0 ) ) == 1.0 );
+
+    const Acceleration acceleration = model( getStateAtPosition( -7000.0, 0.0, 0.0 ), 0.0 );
+    REQUIRE( acceleration[ 0 ] == 0.0 );
+    REQUIRE( acceleration[ 1 ] == 0.0 );
+    REQUIRE( acceleration[ 2 ] == 0.0 );
+}
+
+TEST_CASE( "Test conical shadow", "[acceleration_models]" )
+{
+    const RadiationPressureModel model( 4.56e-6,
+                                        1.5,
+                                        10.0,
+                                        100.0,
+                                        getVectorToSun( ),
+                                        conicalShadowModel,
+                                        earthRadius,
+                                        sunRadius );
+
+    // Illuminated side and umbra.
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( 7000.0, 0.0, 0.0 ) ) == 1.0 );
+    REQUIRE( model.computeShadowFunction( getStateAtPosition( -7000.0, 0.0, 0.0 ) ) == 0.0 );
+
+    // At the edge of the shadow cylinder, about half of the Sun is hidden.
+    const double penumbraShadowFunction
+        = model.computeShadowFunction( getStateAtPosition( -7000.0, earthRadius, 0.0 ) );
+    REQUIRE( penumbraShadowFunction > 0.4 );
+    REQUIRE( penumbraShadowFunction < 0.6 );
+
+    // The shadow function decreases monotonically across the penumbra, from 1 at the outer edge
+    // of the penumbra cone, which is handled by the prefilter, to 0 in the umbra.
+    double previousShadowFunction = 1.0;
+    for ( double distanceToAxis = earthRadius + 60.0;
+          distanceToAxis > earthRadius - 60.0;
+          distanceToAxis -= 1.0 )
+    {
+        const double shadowFunction
+            = model.computeShadowFunction( getStateAtPosition( -7000.0, distanceToAxis, 0.0 ) );
+        REQUIRE( shadowFunction >= 0.0 );
+        REQUIRE( shadowFunction <= 1.0 );
+        REQUIRE( shadowFunction <= previousShadowFunction + 1.0e-12 );
+        REQUIRE( previousShadowFunction - shadowFunction < 0.05 );
+        previousShadowFunction = shadowFunction;
+    }
+    REQUIRE( previousShadowFunction == 0.0 );
+}
+
+TEST_CASE( "Test radiation pressure model with invalid parameters", "[acceleration_models]" )
+{
+    Position origin;
+    origin.fill( 0.0 );
+    REQUIRE_THROWS_AS( RadiationPressureModel( 4.56e-6, 1.5, 10.0, 100.0, origin,
+                                               conicalShadowModel, earthRadius, sunRadius ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS( RadiationPressureModel( 4.56e-6, 1.5, 10.0, 0.0, getVectorToSun( ),
+                                               conicalShadowModel, earthRadius, sunRadius ),
+                       std::runtime_error );
+}
+
+TEST_CASE( "Test radiation pressure with source from ephemeris", "[acceleration_models]" )
+{
+    const std::string filename = "testRadiationPressureEphemeris.bin";
+
+    // Sun moving linearly from (1 AU, -1 AU, 0) at t = 0 s to (1 AU, 1 AU, 0) at t = 2 s.
+    std::vector< double > sunCoefficients( 3 * 2, 0.0 );
+    sunCoefficients[ 0 ] = 1.495978707e8;
+    sunCoefficients[ 3 ] = 1.495978707e8;
+    std::vector< EphemerisBody > bodies;
+    bodies.push_back( EphemerisBody(
+        "sun", 1.32712440018e11, 0.0, 2.0, 1, 2, &sunCoefficients[ 0 ] ) );
+    writeChebyshevEphemeris( filename, bodies );
+
+    const ChebyshevEphemerisPtr ephemeris = boost::make_shared< ChebyshevEphemeris >( filename );
+    const RadiationPressureModel model(
+        4.56e-6, 1.5, 10.0, 100.0, ephemeris, 0, conicalShadowModel, earthRadius, sunRadius );
+
+    // The acceleration matches that of a source fixed at the position of the Sun at each time.
+    Position vectorToSunAtEnd = getVectorToSun( );
+    vectorToSunAtEnd[ 1 ] = vectorToSunAtEnd[ 0 ];
+    const RadiationPressureModel modelAtMiddle(
+        4.56e-6, 1.5, 10.0, 100.0, getVectorToSun( ), conicalShadowModel, earthRadius, sunRadius );
+    const RadiationPressureModel modelAtEnd(
+        4.56e-6, 1.5, 10.0, 100.0, vectorToSunAtEnd, conicalShadowModel, earthRadius, sunRadius );
+
+    const State state = getStateAtPosition( 0.0, 7000.0, 0.0 );
+    const Acceleration accelerationAtMiddle = model( state, 1.0 );
+    const Acceleration accelerationAtEnd = model( state, 2.0 );
+    const Acceleration expectedAccelerationAtMiddle = modelAtMiddle( state, 1.0 );
+    const Acceleration expectedAccelerationAtEnd = modelAtEnd( state, 2.0 );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        REQUIRE( accelerationAtMiddle[ i ]
+                 == Approx( expectedAccelerationAtMiddle[ i ] ).margin( 1.0e-20 ) );
+        REQUIRE( accelerationAtEnd[ i ]
+                 == Approx( expectedAccelerationAtEnd[ i ] ).margin( 1.0e-20 ) );
+    }
+
+    // Behind the central body with respect to the Sun at t = 2 s, the spacecraft is in umbra.
+    const State shadowedState = getStateAtPosition( -5000.0, -5000.0, 0.0 );
+    REQUIRE( model( shadowedState, 2.0 )[ 0 ] == 0.0 );
+    REQUIRE( model( shadowedState, 0.0 )[ 0 ] != 0.0 );
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
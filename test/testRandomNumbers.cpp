@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "Scarab/randomNumbers.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test random numbers are independent of standard library", "[random_numbers]" )
+{
+    // Reference values only depend on the output of the generator, which is specified by the C++
+    // standard.
+    RandomNumberGenerator generator( 42 );
+    REQUIRE( generateUniformRandomNumber( generator ) == 0.75515553295453897 );
+    REQUIRE( generateUniformRandomNumber( generator ) == 0.63903139385469743 );
+    REQUIRE( generateUniformRandomNumber( generator ) == 0.7521452007480266 );
+    REQUIRE( generateNormalRandomNumber( generator )
+             == Approx( -0.86154825632147014 ).epsilon( 1.0e-14 ) );
+    REQUIRE( generateNormalRandomNumber( generator )
+             == Approx( -0.79390030430856862 ).epsilon( 1.0e-14 ) );
+    REQUIRE( generateNormalRandomNumber( generator )
+             == Approx( -0.0085374179416333323 ).epsilon( 1.0e-14 ) );
+}
+
+TEST_CASE( "Test distribution of random numbers", "[random_numbers]" )
+{
+    RandomNumberGenerator generator( 1 );
+    const unsigned int numberOfSamples = 100000;
+
+    const std::size_t numberOfIndices = 10;
+    std::vector< unsigned int > indexCounts( numberOfIndices, 0 );
+    double uniformSum = 0.0;
+    double normalSum = 0.0;
+    double normalSquareSum = 0.0;
+    for ( unsigned int i = 0; i < numberOfSamples; i++ )
+    {
+        const double uniform = generateUniformRandomNumber( generator );
+        REQUIRE( uniform >= 0.0 );
+        REQUIRE( uniform < 1.0 );
+        uniformSum += uniform;
+
+        const double normal = generateNormalRandomNumber( generator );
+        normalSum += normal;
+        normalSquareSum += normal * normal;
+
+        const std::size_t index = generateRandomIndex( generator, numberOfIndices );
+        REQUIRE( index < numberOfIndices );
+        indexCounts[ index ]++;
+    }
+
+    REQUIRE( uniformSum / numberOfSamples == Approx( 0.5 ).margin( 0.01 ) );
+    REQUIRE( normalSum / numberOfSamples == Approx( 0.0 ).margin( 0.01 ) );
+    REQUIRE( normalSquareSum / numberOfSamples == Approx( 1.0 ).margin( 0.02 ) );
+    for ( std::size_t i = 0; i < numberOfIndices; i++ )
+    {
+        REQUIRE( static_cast< double >( indexCounts[ i ] ) / numberOfSamples
+                 == Approx( 0.1 ).margin( 0.005 ) );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/integrator.hpp"
+#include "Scarab/relativeMotion.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+#include "Scarab/stateHistorySink.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create simulator settings for relative motion about target in low Earth orbit.
+SimulatorSettings createRelativeMotionTestSettings( const double stateHistoryInterval )
+{
+    State initialState;
+    initialState[ 0 ] = 0.1;
+    initialState[ 1 ] = -0.2;
+    initialState[ 2 ] = 0.05;
+    initialState[ 3 ] = 0.0;
+    initialState[ 4 ] = -2.0e-4;
+    initialState[ 5 ] = 1.0e-5;
+
+    SimulatorTestSettings testSettings;
+    testSettings.integratorSettings = boost::make_shared< IntegratorSettings >(
+        initialState, 100.0, 1100.0, 300.0, dormandPrince5Integrator, 1.0e-6, 1.0e-6, 1000.0 );
+    testSettings.outputSettings = createTestOutputSettings( stateHistoryInterval );
+    testSettings.listOfModelNames.clear( );
+    testSettings.relativeMotionSettings = boost::make_shared< RelativeMotionSettings >( true,
+                                                                                       7000.0 );
+    return testSettings.create( );
+}
+
+TEST_CASE( "Test Clohessy-Wiltshire state transition matrix", "[relative_motion]" )
+{
+    const double meanMotion = computeMeanMotion( 398600.4418, 7000.0 );
+    REQUIRE( meanMotion == Approx( std::sqrt( 398600.4418 / 343.0e9 ) ) );
+
+    // At zero elapsed time, the state transition matrix is the identity matrix.
+    const StateTransitionMatrix identity
+        = computeClohessyWiltshireStateTransitionMatrix( meanMotion, 0.0 );
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        for ( unsigned int j = 0; j < 6; j++ )
+        {
+            REQUIRE( identity[ 6 * i + j ] == ( i == j ? 1.0 : 0.0 ) );
+        }
+    }
+
+    // An along-track offset is an equilibrium.
+    State alongTrackOffset;
+    alongTrackOffset.fill( 0.0 );
+    alongTrackOffset[ 1 ] = 1.0;
+    const State propagatedAlongTrackOffset
+        = propagateRelativeState( meanMotion, alongTrackOffset, 1234.0 );
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        REQUIRE( std::fabs( propagatedAlongTrackOffset[ i ] - alongTrackOffset[ i ] ) < 1.0e-15 );
+    }
+
+    // A radial offset without along-track velocity drifts along-track by 12 pi times the offset
+    // per orbit, and returns to the same radial offset.
+    const double period = 2.0 * std::acos( -1.0 ) / meanMotion;
+    State radialOffset;
+    radialOffset.fill( 0.0 );
+    radialOffset[ 0 ] = 1.0;
+    const State propagatedRadialOffset = propagateRelativeState( meanMotion, radialOffset, period );
+    REQUIRE( propagatedRadialOffset[ 0 ] == Approx( 1.0 ) );
+    REQUIRE( propagatedRadialOffset[ 1 ] == Approx( -12.0 * std::acos( -1.0 ) ) );
+
+    // Composing two state transition matrices gives the state transition matrix of the sum.
+    const State initialState
+        = createRelativeMotionTestSettings( 0.0 ).integratorSettings.initialState;
+    const State composedState = propagateRelativeState(
+        meanMotion, propagateRelativeState( meanMotion, initialState, 400.0 ), 700.0 );
+    const State directState = propagateRelativeState( meanMotion, initialState, 1100.0 );
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        REQUIRE( std::fabs( composedState[ i ] - directState[ i ] ) < 1.0e-12 );
+    }
+}
+
+//! Convert relative state in Hill frame of target on circular orbit in xy-plane to inertial state.
+State convertHillToInertialState( const State& relativeState,
+                                  const double semiMajorAxis,
+                                  const double meanMotion,
+                                  const double time )
+{
+    const double c = std::cos( meanMotion * time );
+    const double s = std::sin( meanMotion * time );
+
+    // Position and velocity in rotating frame, including motion of the target.
+    const double x = semiMajorAxis + relativeState[ 0 ];
+    const double y = relativeState[ 1 ];
+    const double vx = relativeState[ 3 ] - meanMotion * relativeState[ 1 ];
+    const double vy = relativeState[ 4 ] + meanMotion * ( semiMajorAxis + relativeState[ 0 ] );
+
+    State inertialState;
+    inertialState[ 0 ] = c * x - s * y;
+    inertialState[ 1 ] = s * x + c * y;
+    inertialState[ 2 ] = relativeState[ 2 ];
+    inertialState[ 3 ] = c * vx - s * vy;
+    inertialState[ 4 ] = s * vx + c * vy;
+    inertialState[ 5 ] = relativeState[ 5 ];
+    return inertialState;
+}
+
+TEST_CASE( "Test Clohessy-Wiltshire solution against numerical integration", "[relative_motion]" )
+{
+    const double gravitationalParameter = 398600.4418;
+    const double semiMajorAxis = 7000.0;
+    const double meanMotion = computeMeanMotion( gravitationalParameter, semiMajorAxis );
+    const double endTime = 1000.0;
+
+    const State initialRelativeState
+        = createRelativeMotionTestSettings( 0.0 ).integratorSettings.initialState;
+    const State initialState
+        = convertHillToInertialState( initialRelativeState, semiMajorAxis, meanMotion, 0.0 );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( initialState, 0.0, gravitationalParameter, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    State state = initialState;
+    integrateState( IntegratorSettings( initialState,
+                                        0.0,
+                                        endTime,
+                                        10.0,
+                                        dormandPrince5Integrator,
+                                        1.0e-12,
+                                        1.0e-12,
+                                        60.0 ),
+                    stateDerivativeModel,
+                    state );
+
+    // For a separation of a few hundred metres, the linearization error is well below a metre.
+    const State expectedState = convertHillToInertialState(
+        propagateRelativeState( meanMotion, initialRelativeState, endTime ),
+        semiMajorAxis,
+        meanMotion,
+        endTime );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        REQUIRE( std::fabs( state[ i ] - expectedState[ i ] ) < 1.0e-4 );
+        REQUIRE( std::fabs( state[ i + 3 ] - expectedState[ i + 3 ] ) < 1.0e-7 );
+    }
+}
+
+TEST_CASE( "Test relative motion output epochs", "[relative_motion]" )
+{
+    // Without an output interval, the initial step is used as output interval.
+    const std::vector< double > defaultEpochs
+        = getRelativeMotionEpochs( createRelativeMotionTestSettings( 0.0 ) );
+    REQUIRE( defaultEpochs.size( ) == 4 );
+    REQUIRE( defaultEpochs.front( ) == 100.0 );
+    REQUIRE( defaultEpochs.back( ) == 1000.0 );
+
+    const SimulatorSettings settings = createRelativeMotionTestSettings( 250.0 );
+    StateHistory stateHistory;
+    StateHistoryRecorder stateHistoryRecorder( stateHistory );
+    REQUIRE( propagateRelativeMotion( settings, stateHistoryRecorder ) == 5 );
+    REQUIRE( stateHistory.size( ) == 5 );
+    REQUIRE( stateHistory.getTime( 0 ) == 100.0 );
+    REQUIRE( stateHistory.getTime( stateHistory.size( ) - 1 ) == 1100.0 );
+
+    // The relative state at the start time is the initial state.
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        REQUIRE( stateHistory.getState( 0 )[ i ]
+                 == Approx( settings.integratorSettings.initialState[ i ] ) );
+    }
+}
+
+TEST_CASE( "Test relative motion to state history file that cannot be opened",
+           "[relative_motion]" )
+{
+    // The test settings have no output files, so the state history file cannot be opened.
+    REQUIRE_THROWS_AS( executeRelativeMotion( createRelativeMotionTestSettings( 250.0 ) ),
+                       std::runtime_error );
+}
+
+} // namespace tests
+} // namespace scarab
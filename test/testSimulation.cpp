@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/accelerationModelListGenerator.hpp"
+#include "Scarab/simulation.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create simulator settings for a short run in low Earth orbit.
+SimulatorSettings createSimulationTestSettings( const bool isEnckeOn )
+{
+    SimulatorTestSettings testSettings;
+    testSettings.outputSettings = createTestOutputSettings( 60.0 );
+    testSettings.enckeSettings = boost::make_shared< EnckeSettings >( isEnckeOn, 0.01, 60.0 );
+    return testSettings.create( );
+}
+
+TEST_CASE( "Test simulation run", "[simulation]" )
+{
+    Simulation simulation( createSimulationTestSettings( false ) );
+    const SimulationResult result = simulation.run( );
+
+    // The state history is sampled every 60 s, including the start and end time.
+    REQUIRE( result.stateHistory.size( ) == 11 );
+    REQUIRE( result.stateHistory.getTime( 0 ) == 0.0 );
+    REQUIRE( result.stateHistory.getTime( 10 ) == Approx( 600.0 ) );
+    REQUIRE( result.stateHistory.getState( 0 )
+             == simulation.getSettings( ).integratorSettings.initialState );
+    REQUIRE( result.stateHistory.getState( 10 ) == result.finalState );
+    REQUIRE( result.statistics.finalTime == Approx( 600.0 ) );
+    REQUIRE( result.statistics.numberOfAcceptedSteps > 0 );
+    REQUIRE( result.eventLog.empty( ) );
+
+    // The result is the same as that of a separate integration with the same settings.
+    State finalState = simulation.getSettings( ).integratorSettings.initialState;
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( finalState, 0.0, 398600.4418, listOfAccelerationModels );
+    generateAccelerationModelList( simulation.getSettings( ), data );
+    const StateDerivativeModel stateDerivativeModel( data );
+    integrateState( simulation.getSettings( ).integratorSettings,
+                    stateDerivativeModel,
+                    finalState );
+    REQUIRE( result.finalState == finalState );
+}
+
+TEST_CASE( "Test repeated simulation runs", "[simulation]" )
+{
+    Simulation simulation( createSimulationTestSettings( false ) );
+    const SimulationResult nominalResult = simulation.run( );
+
+    State initialState = simulation.getSettings( ).integratorSettings.initialState;
+    initialState[ 0 ] += 10.0;
+
+    SimulationResult result;
+    simulation.run( initialState, 0.0, 300.0, result );
+    REQUIRE( result.stateHistory.size( ) == 6 );
+    REQUIRE( result.statistics.finalTime == Approx( 300.0 ) );
+    REQUIRE( result.stateHistory.getState( 0 ) == initialState );
+
+    // A shorter run reuses the memory reserved for the state history.
+    const std::size_t capacity = result.stateHistory.capacity( );
+    const double* const times = result.stateHistory.getTimes( ).data( );
+    simulation.run( initialState, 0.0, 120.0, result );
+    REQUIRE( result.stateHistory.size( ) == 3 );
+    REQUIRE( result.stateHistory.capacity( ) == capacity );
+    REQUIRE( result.stateHistory.getTimes( ).data( ) == times );
+
+    // Runs do not affect each other.
+    simulation.run( simulation.getSettings( ).integratorSettings.initialState, 0.0, 600.0, result );
+    REQUIRE( result.finalState == nominalResult.finalState );
+    REQUIRE( result.statistics.numberOfFunctionEvaluations
+             == nominalResult.statistics.numberOfFunctionEvaluations );
+}
+
+TEST_CASE( "Test simulation rejects Encke settings", "[simulation]" )
+{
+    REQUIRE_THROWS( Simulation( createSimulationTestSettings( true ) ) );
+}
+
+} // namespace tests
+} // namespace scarab
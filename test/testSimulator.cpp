@@ -7,8 +7,26 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
 #include <catch.hpp>
 
+#include <rapidjson/document.h>
+
+#include "Scarab/checkpoint.hpp"
+#include "Scarab/logger.hpp"
+#include "Scarab/simulator.hpp"
+
+#include "simulatorTestSettings.hpp"
+
 namespace scarab
 {
 namespace tests
@@ -26,5 +44,204 @@ TEST_CASE( "Test method to verify simulator settings", "[simulator]" )
     REQUIRE( false );
 }
 
+TEST_CASE( "Test run summary", "[simulator]" )
+{
+    TrajectoryMetadata metadata;
+    metadata.push_back( TrajectoryMetadataEntry( "end_time", 600.0, "s" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "absolute_tolerance", 1.0e-12, "-" ) );
+
+    State state;
+    state.fill( 0.5 );
+    state[ 5 ] = std::numeric_limits< double >::quiet_NaN( );
+    EventLog eventLog;
+    eventLog.push_back( EventOccurrence( "\"apogee\"", 300.25, state, logEventAction, "" ) );
+
+    std::ostringstream summary;
+    writeRunSummary( summary, "trajectory", metadata, eventLog, 1.5 );
+    REQUIRE( summary.str( )
+             == "{\n"
+                "    \"status\": \"success\",\n"
+                "    \"mode\": \"trajectory\",\n"
+                "    \"wall_clock_time\": 1.5,\n"
+                "    \"metadata\": {\n"
+                "        \"end_time\": { \"value\": 600, \"units\": \"s\" },\n"
+                "        \"absolute_tolerance\": { \"value\": 1e-12, \"units\": \"-\" }\n"
+                "    },\n"
+                "    \"events\": [\n"
+                "        { \"name\": \"\\\"apogee\\\"\", \"time\": 300.25, "
+                "\"state\": [0.5, 0.5, 0.5, 0.5, 0.5, null], \"action\": \"log\", "
+                "\"phase\": \"\" }\n"
+                "    ]\n"
+                "}\n" );
+
+    std::ostringstream emptySummary;
+    writeRunSummary( emptySummary, "ensemble", TrajectoryMetadata( ), EventLog( ), 0.0 );
+    REQUIRE( emptySummary.str( )
+             == "{\n"
+                "    \"status\": \"success\",\n"
+                "    \"mode\": \"ensemble\",\n"
+                "    \"wall_clock_time\": 0,\n"
+                "    \"metadata\": {},\n"
+                "    \"events\": []\n"
+                "}\n" );
+}
+
+//! Get error message of resuming simulator from checkpoint with given configuration.
+static std::string getResumeErrorMessage( const rapidjson::Document& config )
+{
+    try
+    {
+        executeSimulator( config, true );
+    }
+    catch ( const std::runtime_error& error )
+    {
+        return error.what( );
+    }
+    return "";
+}
+
+//! Get configuration of simulator with checkpoints, with given chaser mass.
+static std::string getCheckpointTestConfig( const std::string& chaserMass )
+{
+    return "{"
+           "\"initial_state\": [7000.0, 0.0, 0.0, 0.0, 7.5, 1.0],"
+           "\"start_time\": 0.0, \"end_time\": 600.0, \"initial_step\": 10.0,"
+           "\"models\": [\"central_gravity\"],"
+           "\"gravitational_parameter\": 398600.4418,"
+           "\"chaser\": { \"mass\": " + chaserMass + " },"
+           "\"target\": { \"mass\": 1000.0 },"
+           "\"radiation_pressure\": { \"status\": false },"
+           "\"output\": { \"metadata_file\": \"testSimulatorMetadata.csv\","
+           "\"state_history_file\": \"testSimulatorStateHistory.csv\" },"
+           "\"checkpoint\": { \"status\": true,"
+           "\"checkpoint_file\": \"testSimulatorCheckpoint.bin\" }"
+           "}";
+}
+
+TEST_CASE( "Test checkpoint fingerprint", "[simulator],[checkpoint]" )
+{
+    SimulatorTestSettings testSettings;
+    const boost::uint64_t fingerprint = getCheckpointFingerprint( testSettings.create( ) );
+
+    REQUIRE( getCheckpointFingerprint( testSettings.create( ) ) == fingerprint );
+
+    SECTION( "Test chaser mass changes fingerprint" )
+    {
+        testSettings.chaserSettings = boost::make_shared< ChaserSettings >( 200.0 );
+    }
+
+    SECTION( "Test radiation pressure parameters change fingerprint" )
+    {
+        Position vectorToSource;
+        vectorToSource.fill( 0.0 );
+        testSettings.radiationPressureSettings = boost::make_shared< RadiationPressureSettings >(
+            false, 0.0, 0.0, vectorToSource, 1.0, noShadowModel, 0.0, 0.0, "" );
+    }
+
+    SECTION( "Test spherical harmonics coefficients change fingerprint" )
+    {
+        SphericalHarmonicsCoefficients coefficients( 2, 2 );
+        coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 0 ) ]
+            = -4.84165e-4;
+        testSettings.sphericalHarmonicsSettings = boost::make_shared< SphericalHarmonicsSettings >(
+            false, "", coefficients, 0.0, 0.0, GravityInterpolationSettings( false, 0.0, 0.0, 0 ) );
+    }
+
+    SECTION( "Test drag parameters change fingerprint" )
+    {
+        testSettings.dragSettings = boost::make_shared< DragSettings >(
+            false, 0.0, 1.0, "", AtmosphereTable( ), 0.0, 0.0 );
+    }
+
+    SECTION( "Test event threshold changes fingerprint" )
+    {
+        Position referencePoint;
+        referencePoint.fill( 0.0 );
+        ListOfEventDefinitions listOfEventDefinitions;
+        listOfEventDefinitions.push_back( EventDefinition( "altitude",
+                                                           distanceEventType,
+                                                           7000.0,
+                                                           referencePoint,
+                                                           0,
+                                                           anyEventDirection,
+                                                           logEventAction,
+                                                           "",
+                                                           "" ) );
+        testSettings.eventSettings
+            = boost::make_shared< EventSettings >( "", "", listOfEventDefinitions );
+        const boost::uint64_t eventFingerprint = getCheckpointFingerprint( testSettings.create( ) );
+
+        listOfEventDefinitions.clear( );
+        listOfEventDefinitions.push_back( EventDefinition( "altitude",
+                                                           distanceEventType,
+                                                           7100.0,
+                                                           referencePoint,
+                                                           0,
+                                                           anyEventDirection,
+                                                           logEventAction,
+                                                           "",
+                                                           "" ) );
+        testSettings.eventSettings
+            = boost::make_shared< EventSettings >( "", "", listOfEventDefinitions );
+        REQUIRE( getCheckpointFingerprint( testSettings.create( ) ) != eventFingerprint );
+    }
+
+    SECTION( "Test state history epochs change fingerprint" )
+    {
+        testSettings.outputSettings = boost::make_shared< OutputSettings >(
+            "",
+            "",
+            1,
+            csvStateHistoryFormat,
+            0.0,
+            std::vector< double >( 1, 100.0 ),
+            ChebyshevTrajectorySettings( 0.0, 0.0, 0 ),
+            "" );
+        const boost::uint64_t epochFingerprint = getCheckpointFingerprint( testSettings.create( ) );
+
+        testSettings.outputSettings = boost::make_shared< OutputSettings >(
+            "",
+            "",
+            1,
+            csvStateHistoryFormat,
+            0.0,
+            std::vector< double >( 1, 200.0 ),
+            ChebyshevTrajectorySettings( 0.0, 0.0, 0 ),
+            "" );
+        REQUIRE( getCheckpointFingerprint( testSettings.create( ) ) != epochFingerprint );
+    }
+
+    REQUIRE( getCheckpointFingerprint( testSettings.create( ) ) != fingerprint );
+}
+
+TEST_CASE( "Test resume with different settings is rejected", "[simulator],[checkpoint]" )
+{
+    const LogLevel logLevel = getCurrentLogLevel( );
+    setLogLevel( quietLogLevel );
+
+    rapidjson::Document config;
+    config.Parse( getCheckpointTestConfig( "100.0" ).c_str( ) );
+    Checkpoint checkpoint;
+    checkpoint.writeSize( getCheckpointFingerprint( checkSimulatorSettings( config ) ) );
+    writeCheckpointFile( "testSimulatorCheckpoint.bin", checkpoint );
+    std::ofstream stateHistoryFile( "testSimulatorStateHistory.csv" );
+    stateHistoryFile.close( );
+
+    // The checkpoint only holds the fingerprint, so resuming with the same settings fails later,
+    // when the integrator is restored.
+    REQUIRE( getResumeErrorMessage( config )
+             != "ERROR: Checkpoint does not match simulator settings!" );
+
+    rapidjson::Document changedConfig;
+    changedConfig.Parse( getCheckpointTestConfig( "200.0" ).c_str( ) );
+    REQUIRE( getResumeErrorMessage( changedConfig )
+             == "ERROR: Checkpoint does not match simulator settings!" );
+
+    setLogLevel( logLevel );
+    std::remove( "testSimulatorCheckpoint.bin" );
+    std::remove( "testSimulatorMetadata.csv" );
+    std::remove( "testSimulatorStateHistory.csv" );
+}
+
 } // namespace tests
 } // namespace scarab
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "Scarab/sphericalHarmonicsGravityModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create coefficients of degree and order 10 with random values.
+SphericalHarmonicsCoefficients createRandomCoefficients( )
+{
+    SphericalHarmonicsCoefficients coefficients( 10, 10 );
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > distribution( -1.0e-6, 1.0e-6 );
+    for ( unsigned int n = 2; n <= coefficients.degree; n++ )
+    {
+        for ( unsigned int m = 0; m <= n; m++ )
+        {
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            coefficients.cosineCoefficients[ index ] = distribution( generator );
+            coefficients.sineCoefficients[ index ] = m == 0 ? 0.0 : distribution( generator );
+        }
+    }
+    coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 0 ) ]
+        = -4.84165e-4;
+    return coefficients;
+}
+
+//! Compute potential of non-central terms from fully normalized Legendre functions.
+double computeNonCentralPotential( const SphericalHarmonicsCoefficients& coefficients,
+                                   const double gravitationalParameter,
+                                   const double referenceRadius,
+                                   const double x,
+                                   const double y,
+                                   const double z )
+{
+    const double r = std::sqrt( x * x + y * y + z * z );
+    const double sinLatitude = z / r;
+    const double cosLatitude = std::sqrt( x * x + y * y ) / r;
+    const double longitude = std::atan2( y, x );
+    const unsigned int degree = coefficients.degree;
+
+    std::vector< std::vector< double > > p( degree + 1, std::vector< double >( degree + 1, 0.0 ) );
+    p[ 0 ][ 0 ] = 1.0;
+    for ( unsigned int m = 0; m <= degree; m++ )
+    {
+        if ( m > 0 )
+        {
+            const double sectoralFactor
+                = m == 1 ? std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+            p[ m ][ m ] = sectoralFactor * cosLatitude * p[ m - 1 ][ m - 1 ];
+        }
+        for ( unsigned int n = m + 1; n <= degree; n++ )
+        {
+            const double nm = ( n - m ) * ( n + m + 0.0 );
+            p[ n ][ m ] = std::sqrt( ( 2.0 * n + 1.0 ) * ( 2.0 * n - 1.0 ) / nm )
+                          * sinLatitude * p[ n - 1 ][ m ];
+            if ( n >= m + 2 )
+            {
+                p[ n ][ m ] -= std::sqrt( ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 )
+                                          / ( ( 2.0 * n - 3.0 ) * nm ) )
+                               * p[ n - 2 ][ m ];
+            }
+        }
+    }
+
+    double potential = 0.0;
+    for ( unsigned int n = 2; n <= degree; n++ )
+    {
+        double degreeSum = 0.0;
+        for ( unsigned int m = 0; m <= std::min( n, coefficients.order ); m++ )
+        {
+            const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+            degreeSum += p[ n ][ m ]
+                         * ( coefficients.cosineCoefficients[ index ] * std::cos( m * longitude )
+                             + coefficients.sineCoefficients[ index ] * std::sin( m * longitude ) );
+        }
+        potential += std::pow( referenceRadius / r, n ) * degreeSum;
+    }
+    return gravitationalParameter / r * potential;
+}
+
+TEST_CASE( "Test spherical harmonics gravity model against J2 acceleration",
+           "[spherical_harmonics]" )
+{
+    const double mu = 398600.4418;
+    const double radius = 6378.1363;
+    const double j2 = 1.08262668e-3;
+
+    SphericalHarmonicsCoefficients coefficients( 2, 0 );
+    coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 0 ) ]
+        = -j2 / std::sqrt( 5.0 );
+    const SphericalHarmonicsGravityModel model( mu, radius, coefficients );
+
+    State state;
+    state[ 0 ] = 4000.0;
+    state[ 1 ] = -3000.0;
+    state[ 2 ] = 5000.0;
+    state[ 3 ] = 0.0;
+    state[ 4 ] = 0.0;
+    state[ 5 ] = 0.0;
+    const Acceleration acceleration = model( state, 0.0 );
+
+    const double r2 = state[ 0 ] * state[ 0 ] + state[ 1 ] * state[ 1 ] + state[ 2 ] * state[ 2 ];
+    const double r = std::sqrt( r2 );
+    const double factor = -1.5 * j2 * mu * radius * radius / ( r2 * r2 * r );
+    const double zRatio = 5.0 * state[ 2 ] * state[ 2 ] / r2;
+    REQUIRE( acceleration[ 0 ] == Approx( factor * state[ 0 ] * ( 1.0 - zRatio ) ) );
+    REQUIRE( acceleration[ 1 ] == Approx( factor * state[ 1 ] * ( 1.0 - zRatio ) ) );
+    REQUIRE( acceleration[ 2 ] == Approx( factor * state[ 2 ] * ( 3.0 - zRatio ) ) );
+}
+
+TEST_CASE( "Test spherical harmonics gravity model against gradient of potential",
+           "[spherical_harmonics]" )
+{
+    const double mu = 398600.4418;
+    const double radius = 6378.1363;
+    const SphericalHarmonicsCoefficients coefficients = createRandomCoefficients( );
+    const SphericalHarmonicsGravityModel model( mu, radius, coefficients );
+
+    std::mt19937 generator( 7 );
+    std::uniform_real_distribution< double > distribution( -1.0, 1.0 );
+    const double step = 1.0e-3;
+    for ( unsigned int k = 0; k < 20; k++ )
+    {
+        State state;
+        state.fill( 0.0 );
+        double norm = 0.0;
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            state[ i ] = distribution( generator );
+            norm += state[ i ] * state[ i ];
+        }
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            state[ i ] *= 7000.0 / std::sqrt( norm );
+        }
+
+        const Acceleration acceleration = model( state, 0.0 );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            State forward = state;
+            State backward = state;
+            forward[ i ] += step;
+            backward[ i ] -= step;
+            const double expectedAcceleration
+                = ( computeNonCentralPotential( coefficients, mu, radius,
+                                                forward[ 0 ], forward[ 1 ], forward[ 2 ] )
+                    - computeNonCentralPotential( coefficients, mu, radius,
+                                                  backward[ 0 ], backward[ 1 ], backward[ 2 ] ) )
+                  / ( 2.0 * step );
+            REQUIRE( acceleration[ i ] == Approx( expectedAcceleration ).epsilon( 1.0e-6 ) );
+        }
+    }
+}
+
+TEST_CASE( "Test spherical harmonics gravity model at pole and with rotation",
+           "[spherical_harmonics]" )
+{
+    const double mu = 398600.4418;
+    const double radius = 6378.1363;
+    const SphericalHarmonicsCoefficients coefficients = createRandomCoefficients( );
+
+    SECTION( "Finite acceleration at pole" )
+    {
+        const SphericalHarmonicsGravityModel model( mu, radius, coefficients );
+        State state;
+        state.fill( 0.0 );
+        state[ 2 ] = 7000.0;
+        const Acceleration acceleration = model( state, 0.0 );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            REQUIRE( std::isfinite( acceleration[ i ] ) );
+        }
+    }
+
+    SECTION( "Rotation by half a revolution leaves even orders unchanged" )
+    {
+        SphericalHarmonicsCoefficients evenCoefficients = coefficients;
+        for ( unsigned int n = 2; n <= evenCoefficients.degree; n++ )
+        {
+            for ( unsigned int m = 1; m <= n; m += 2 )
+            {
+                const std::size_t index = SphericalHarmonicsCoefficients::getIndex( n, m );
+                evenCoefficients.cosineCoefficients[ index ] = 0.0;
+                evenCoefficients.sineCoefficients[ index ] = 0.0;
+            }
+        }
+
+        const double rotationRate = 7.292115e-5;
+        const SphericalHarmonicsGravityModel model( mu, radius, evenCoefficients );
+        const SphericalHarmonicsGravityModel rotatingModel(
+            mu, radius, evenCoefficients, rotationRate );
+
+        State state;
+        state[ 0 ] = 5000.0;
+        state[ 1 ] = 3000.0;
+        state[ 2 ] = -4000.0;
+        state[ 3 ] = 0.0;
+        state[ 4 ] = 0.0;
+        state[ 5 ] = 0.0;
+        const double halfRevolutionTime = std::acos( -1.0 ) / rotationRate;
+        const Acceleration acceleration = model( state, 0.0 );
+        const Acceleration rotatingAcceleration = rotatingModel( state, halfRevolutionTime );
+        const Acceleration quarterAcceleration = rotatingModel( state, 0.5 * halfRevolutionTime );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            REQUIRE( rotatingAcceleration[ i ] == Approx( acceleration[ i ] ) );
+        }
+        REQUIRE( quarterAcceleration[ 0 ] != Approx( acceleration[ 0 ] ) );
+    }
+}
+
+TEST_CASE( "Test reading spherical harmonics coefficients", "[spherical_harmonics]" )
+{
+    const std::string filename = "testSphericalHarmonicsCoefficients.gfc";
+    {
+        std::ofstream file( filename.c_str( ) );
+        file << "product_type              gravity_field" << std::endl;
+        file << "earth_gravity_constant    0.3986004415E+15" << std::endl;
+        file << "end_of_head =======================================" << std::endl;
+        file << "# comment" << std::endl;
+        file << std::endl;
+        file << "gfc    0    0  1.0D+00  0.0D+00  0.0 0.0" << std::endl;
+        file << "gfc    2    0 -0.484165143790815D-03  0.0D+00  0.0 0.0" << std::endl;
+        file << "gfc    2    1 -0.206615509074176D-09  0.138441389137979D-08  0.0 0.0"
+             << std::endl;
+        file << "2,2,0.243938357328313E-05,-0.140027370385934E-05" << std::endl;
+        file << "3 0 0.957161207093473E-06 0.0" << std::endl;
+    }
+
+    SECTION( "Read up to degree and order" )
+    {
+        const SphericalHarmonicsCoefficients coefficients
+            = readSphericalHarmonicsCoefficients( filename, 2, 1 );
+        REQUIRE( coefficients.degree == 2 );
+        REQUIRE( coefficients.order == 1 );
+        REQUIRE( coefficients.cosineCoefficients[ 0 ] == 1.0 );
+        REQUIRE( coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 0 ) ]
+                 == -0.484165143790815e-03 );
+        REQUIRE( coefficients.sineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 1 ) ]
+                 == 0.138441389137979e-08 );
+        REQUIRE( coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 2 ) ]
+                 == 0.0 );
+    }
+
+    SECTION( "Comma-separated lines" )
+    {
+        const SphericalHarmonicsCoefficients coefficients
+            = readSphericalHarmonicsCoefficients( filename, 3, 2 );
+        REQUIRE( coefficients.sineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 2, 2 ) ]
+                 == -0.140027370385934e-05 );
+        REQUIRE( coefficients.cosineCoefficients[ SphericalHarmonicsCoefficients::getIndex( 3, 0 ) ]
+                 == 0.957161207093473e-06 );
+    }
+
+    SECTION( "Errors" )
+    {
+        REQUIRE_THROWS_AS( readSphericalHarmonicsCoefficients( filename, 4, 4 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( readSphericalHarmonicsCoefficients( filename, 2, 3 ),
+                           std::runtime_error );
+        REQUIRE_THROWS_AS( readSphericalHarmonicsCoefficients( "nonexistent.gfc", 2, 2 ),
+                           std::runtime_error );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -7,19 +7,117 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
+#include <boost/make_shared.hpp>
+
 #include <catch.hpp>
 
+#include "Scarab/accelerationModel.hpp"
+#include "Scarab/accelerationModelId.hpp"
+#include "Scarab/centralGravityModel.hpp"
+#include "Scarab/dataStore.hpp"
+#include "Scarab/stateDerivativeModel.hpp"
+
 namespace scarab
 {
 namespace tests
 {
 
-// @todo: write up test suite.
+//! Constant acceleration model.
+class ConstantAccelerationModel : public AccelerationModel3d
+{
+public:
+
+    ConstantAccelerationModel( const Acceleration& anAcceleration )
+        : acceleration( anAcceleration )
+    { }
+
+    Acceleration operator( )( const State& /* state */, const double /* time */ ) const
+    {
+        return acceleration;
+    }
+
+private:
 
-TEST_CASE( "Test state derivative model class", "[simulator],[settings]" )
+    const Acceleration acceleration;
+};
+
+TEST_CASE( "Test state derivative model class", "[simulator],[state_derivative_model]" )
 {
-    REQUIRE( false );
+    State state;
+    state[ 0 ] = 7000.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.1;
+    state[ 4 ] = 7.5;
+    state[ 5 ] = -0.2;
+
+    Acceleration constantAcceleration;
+    constantAcceleration[ 0 ] = 1.0e-6;
+    constantAcceleration[ 1 ] = 2.0e-6;
+    constantAcceleration[ 2 ] = 3.0e-6;
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( state, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    data.listOfAccelerationModels[ radiationPressureModelId ]
+        = boost::make_shared< ConstantAccelerationModel >( constantAcceleration );
+
+    const StateDerivativeModel stateDerivativeModel( data );
+    State stateDerivative;
+    stateDerivativeModel( state, stateDerivative, 0.0 );
+
+    const double centralAcceleration = -398600.4418 / ( 7000.0 * 7000.0 );
+    REQUIRE( stateDerivative[ 0 ] == state[ 3 ] );
+    REQUIRE( stateDerivative[ 1 ] == state[ 4 ] );
+    REQUIRE( stateDerivative[ 2 ] == state[ 5 ] );
+    REQUIRE( stateDerivative[ 3 ] == Approx( centralAcceleration + 1.0e-6 ) );
+    REQUIRE( stateDerivative[ 4 ] == Approx( 2.0e-6 ) );
+    REQUIRE( stateDerivative[ 5 ] == Approx( 3.0e-6 ) );
+}
+
+#ifdef SCARAB_INSTRUMENTATION
+TEST_CASE( "Test state derivative model timings", "[simulator],[state_derivative_model]" )
+{
+    State state;
+    state[ 0 ] = 7000.0;
+    state[ 1 ] = 0.0;
+    state[ 2 ] = 0.0;
+    state[ 3 ] = 0.0;
+    state[ 4 ] = 7.5;
+    state[ 5 ] = 1.0;
+
+    Acceleration constantAcceleration;
+    constantAcceleration.fill( 1.0e-6 );
+
+    ListOfAccelerationModels listOfAccelerationModels;
+    DataStore data( state, 0.0, 398600.4418, listOfAccelerationModels );
+    data.listOfAccelerationModels[ centralGravityModelId ]
+        = boost::make_shared< CentralGravityModel >( data.gravitationalParameter );
+    data.listOfAccelerationModels[ dragModelId ]
+        = boost::make_shared< ConstantAccelerationModel >( constantAcceleration );
+    const StateDerivativeModel stateDerivativeModel( data );
+
+    REQUIRE( stateDerivativeModel.getNumberOfAccelerationModels( ) == 2 );
+    REQUIRE( stateDerivativeModel.getAccelerationModelId( 0 ) == centralGravityModelId );
+    REQUIRE( stateDerivativeModel.getAccelerationModelId( 1 ) == dragModelId );
+    REQUIRE( stateDerivativeModel.getAccelerationModelTime( 0 ) == 0.0 );
+    REQUIRE( stateDerivativeModel.getAccelerationModelTime( 1 ) == 0.0 );
+
+    State stateDerivative;
+    stateDerivativeModel( state, stateDerivative, 0.0 );
+
+    REQUIRE( stateDerivativeModel.getAccelerationModelTime( 0 ) > 0.0 );
+
+    for ( unsigned int i = 1; i < 1000; i++ )
+    {
+        stateDerivativeModel( state, stateDerivative, 0.0 );
+    }
+
+    REQUIRE( stateDerivativeModel.getAccelerationModelTime( 0 ) > 0.0 );
+    REQUIRE( stateDerivativeModel.getAccelerationModelTime( 1 ) >= 0.0 );
 }
+#endif
 
 } // namespace tests
 } // namespace scarab
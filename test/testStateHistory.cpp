@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch.hpp>
+
+#include "Scarab/stateHistory.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get state of state history test sample at given index.
+State getStateHistoryTestState( const unsigned int index )
+{
+    State state;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        state[ i ] = 10.0 * index + i;
+    }
+    return state;
+}
+
+TEST_CASE( "Test state history", "[simulator],[state_history]" )
+{
+    StateHistory stateHistory;
+    REQUIRE( stateHistory.empty( ) );
+    REQUIRE( stateHistory.find( 0.0 ) == 0 );
+    REQUIRE( stateHistory.findIndex( 0.0 ) == 0 );
+
+    for ( unsigned int i = 0; i < 10; i++ )
+    {
+        stateHistory.append( 2.0 * i, getStateHistoryTestState( i ) );
+    }
+
+    REQUIRE( stateHistory.size( ) == 10 );
+    REQUIRE( stateHistory.getTime( 0 ) == 0.0 );
+    REQUIRE( stateHistory.getTime( 9 ) == 18.0 );
+    REQUIRE( stateHistory.getTimes( ).size( ) == 10 );
+
+    SECTION( "Test samples are stored as columns" )
+    {
+        for ( unsigned int i = 0; i < stateHistory.size( ); i++ )
+        {
+            const State expectedState = getStateHistoryTestState( i );
+            REQUIRE( stateHistory.getState( i ) == expectedState );
+            for ( unsigned int j = 0; j < StateHistory::numberOfComponents; j++ )
+            {
+                REQUIRE( stateHistory.getComponent( j )[ i ] == expectedState[ j ] );
+            }
+        }
+    }
+
+    SECTION( "Test samples are found by binary search" )
+    {
+        REQUIRE( stateHistory.findIndex( -1.0 ) == stateHistory.size( ) );
+        REQUIRE( stateHistory.findIndex( 0.0 ) == 0 );
+        REQUIRE( stateHistory.findIndex( 3.0 ) == 1 );
+        REQUIRE( stateHistory.findIndex( 4.0 ) == 2 );
+        REQUIRE( stateHistory.findIndex( 100.0 ) == 9 );
+
+        REQUIRE( stateHistory.find( 4.0 ) == 2 );
+        REQUIRE( stateHistory.find( 3.0 ) == stateHistory.size( ) );
+        REQUIRE( stateHistory.find( 100.0 ) == stateHistory.size( ) );
+    }
+
+    SECTION( "Test history is append-only" )
+    {
+        REQUIRE_THROWS( stateHistory.append( 17.0, getStateHistoryTestState( 0 ) ) );
+
+        // Sample at epoch of last sample replaces last sample.
+        stateHistory.append( 18.0, getStateHistoryTestState( 42 ) );
+        REQUIRE( stateHistory.size( ) == 10 );
+        REQUIRE( stateHistory.getState( 9 ) == getStateHistoryTestState( 42 ) );
+    }
+
+    SECTION( "Test clear retains capacity" )
+    {
+        const std::size_t capacity = stateHistory.capacity( );
+        stateHistory.clear( );
+        REQUIRE( stateHistory.empty( ) );
+        REQUIRE( stateHistory.capacity( ) == capacity );
+
+        stateHistory.append( 5.0, getStateHistoryTestState( 1 ) );
+        REQUIRE( stateHistory.getTime( 0 ) == 5.0 );
+    }
+}
+
+TEST_CASE( "Test state history capacity estimate", "[simulator],[state_history]" )
+{
+    REQUIRE( StateHistory::estimateCapacity( 0.0, 100.0, 10.0 ) == 11 );
+    REQUIRE( StateHistory::estimateCapacity( 0.0, 105.0, 10.0 ) == 12 );
+    REQUIRE( StateHistory::estimateCapacity( 0.0, 100.0, 0.0 ) == 1 );
+    REQUIRE( StateHistory::estimateCapacity( 100.0, 0.0, 10.0 ) == 1 );
+    REQUIRE( StateHistory::estimateCapacity( 0.0, 1.0e9, 1.0e-3 )
+             == StateHistory::maximumEstimatedCapacity );
+
+    const StateHistory stateHistory( StateHistory::estimateCapacity( 0.0, 100.0, 10.0 ) );
+    REQUIRE( stateHistory.empty( ) );
+    REQUIRE( stateHistory.capacity( ) >= 11 );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/stateHistorySink.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test state history recorder", "[simulator],[state_history_sink]" )
+{
+    State state;
+    state.fill( 1.0 );
+
+    StateHistory stateHistory;
+    StateHistoryRecorder recorder( stateHistory );
+    recorder.write( 0.0, state );
+    state[ 0 ] = 2.0;
+    recorder.write( 1.0, state );
+    recorder.write( 1.0, state );
+
+    REQUIRE( stateHistory.size( ) == 2 );
+    REQUIRE( stateHistory.getState( stateHistory.find( 0.0 ) )[ 0 ] == 1.0 );
+    REQUIRE( stateHistory.getState( stateHistory.find( 1.0 ) )[ 0 ] == 2.0 );
+
+    // Samples must be written in chronological order.
+    REQUIRE_THROWS( recorder.write( 0.5, state ) );
+}
+
+TEST_CASE( "Test streaming state history writer", "[simulator],[state_history_sink]" )
+{
+    const std::string header = "t,x,y,z,vx,vy,vz";
+
+    // Generate samples with values that are not exactly representable in decimal.
+    StateHistory stateHistory;
+    for ( unsigned int i = 0; i < 25; i++ )
+    {
+        State state;
+        for ( unsigned int j = 0; j < state.size( ); j++ )
+        {
+            state[ j ] = ( 7000.0 + i ) / ( j + 3.0 ) - 1.0e-7 * i * j;
+        }
+        stateHistory.append( 0.1 * i, state );
+    }
+
+    // Reference output, written sample by sample.
+    std::ostringstream expected;
+    {
+        StreamingStateHistoryWriter writer( expected, 1, header );
+        for ( unsigned int i = 0; i < stateHistory.size( ); i++ )
+        {
+            writer.write( stateHistory.getTime( i ), stateHistory.getState( i ) );
+        }
+    }
+
+    SECTION( "Test values round-trip exactly" )
+    {
+        std::istringstream stream( expected.str( ) );
+        std::string line;
+        std::getline( stream, line );
+        REQUIRE( line == header );
+
+        std::size_t index = 0;
+        while ( std::getline( stream, line ) )
+        {
+            REQUIRE( index < stateHistory.size( ) );
+
+            std::istringstream lineStream( line );
+            std::string value;
+            std::getline( lineStream, value, ',' );
+            REQUIRE( std::strtod( value.c_str( ), 0 ) == stateHistory.getTime( index ) );
+            const State state = stateHistory.getState( index );
+            for ( unsigned int i = 0; i < state.size( ); i++ )
+            {
+                std::getline( lineStream, value, ',' );
+                REQUIRE( std::strtod( value.c_str( ), 0 ) == state[ i ] );
+            }
+            index++;
+        }
+        REQUIRE( index == stateHistory.size( ) );
+    }
+
+    SECTION( "Test output is independent of chunk size" )
+    {
+        const std::size_t chunkSizes[ ] = { 5, 7, 25, 100 };
+        for ( unsigned int k = 0; k < 4; k++ )
+        {
+            std::ostringstream stream;
+            {
+                StreamingStateHistoryWriter writer( stream, chunkSizes[ k ], header );
+                for ( unsigned int i = 0; i < stateHistory.size( ); i++ )
+                {
+                    writer.write( stateHistory.getTime( i ), stateHistory.getState( i ) );
+                }
+                REQUIRE( writer.getNumberOfSamples( ) == stateHistory.size( ) );
+            }
+            REQUIRE( stream.str( ) == expected.str( ) );
+        }
+    }
+
+    SECTION( "Test samples are written in chunks" )
+    {
+        std::ostringstream stream;
+        StreamingStateHistoryWriter writer( stream, 10, header );
+        const std::size_t headerLength = stream.str( ).size( );
+
+        for ( unsigned int i = 0; i < 9; i++ )
+        {
+            writer.write( stateHistory.getTime( i ), stateHistory.getState( i ) );
+        }
+        REQUIRE( stream.str( ).size( ) == headerLength );
+
+        writer.write( stateHistory.getTime( 9 ), stateHistory.getState( 9 ) );
+        REQUIRE( stream.str( ).size( ) > headerLength );
+
+        writer.write( stateHistory.getTime( 10 ), stateHistory.getState( 10 ) );
+        const std::size_t chunkLength = stream.str( ).size( );
+        writer.flush( );
+        REQUIRE( stream.str( ).size( ) > chunkLength );
+    }
+
+    SECTION( "Test zero chunk size is rejected" )
+    {
+        std::ostringstream stream;
+        REQUIRE_THROWS( StreamingStateHistoryWriter( stream, 0, header ) );
+    }
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/sweep.hpp"
+
+#include "simulatorTestSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Create simulator settings for a short sweep in low Earth orbit.
+SimulatorSettings createSweepTestSettings( const SweepSettings& sweepSettings )
+{
+    SimulatorTestSettings testSettings;
+    testSettings.sweepSettings = boost::make_shared< SweepSettings >( sweepSettings );
+    return testSettings.create( );
+}
+
+//! Create grid sweep settings over initial x-position and end time.
+SweepSettings createGridSweepTestSettings( const unsigned int numberOfThreads )
+{
+    std::vector< double > positions;
+    positions.push_back( 6900.0 );
+    positions.push_back( 7000.0 );
+    positions.push_back( 7100.0 );
+
+    std::vector< double > endTimes;
+    endTimes.push_back( 300.0 );
+    endTimes.push_back( 600.0 );
+
+    ListOfSweepParameterDefinitions listOfParameterDefinitions;
+    listOfParameterDefinitions.push_back(
+        SweepParameterDefinition( initialXSweepParameter, positions, 6900.0, 7100.0 ) );
+    listOfParameterDefinitions.push_back(
+        SweepParameterDefinition( endTimeSweepParameter, endTimes, 300.0, 600.0 ) );
+
+    return SweepSettings( true,
+                          gridSweepMethod,
+                          0,
+                          numberOfThreads,
+                          0,
+                          listOfParameterDefinitions,
+                          "" );
+}
+
+//! Create Latin hypercube sweep settings over gravitational parameter and initial y-velocity.
+SweepSettings createLatinHypercubeSweepTestSettings( const unsigned int numberOfSamples,
+                                                     const unsigned int seed )
+{
+    ListOfSweepParameterDefinitions listOfParameterDefinitions;
+    listOfParameterDefinitions.push_back( SweepParameterDefinition(
+        gravitationalParameterSweepParameter, std::vector< double >( ), 398000.0, 399000.0 ) );
+    listOfParameterDefinitions.push_back( SweepParameterDefinition(
+        initialVySweepParameter, std::vector< double >( ), 7.0, 8.0 ) );
+
+    return SweepSettings( true,
+                          latinHypercubeSweepMethod,
+                          numberOfSamples,
+                          1,
+                          seed,
+                          listOfParameterDefinitions,
+                          "" );
+}
+
+TEST_CASE( "Test sweep parameter names", "[sweep]" )
+{
+    REQUIRE( getSweepParameter( "initial_x" ) == initialXSweepParameter );
+    REQUIRE( getSweepParameter( "drag_area" ) == dragAreaSweepParameter );
+    REQUIRE( getSweepParameterName( gravitationalParameterSweepParameter )
+             == "gravitational_parameter" );
+
+    for ( int i = initialXSweepParameter; i <= dragAreaSweepParameter; i++ )
+    {
+        const SweepParameter parameter = static_cast< SweepParameter >( i );
+        REQUIRE( getSweepParameter( getSweepParameterName( parameter ) ) == parameter );
+    }
+
+    REQUIRE_THROWS( getSweepParameter( "initial_w" ) );
+}
+
+TEST_CASE( "Test expansion of grid sweep", "[sweep]" )
+{
+    const std::vector< SweepPoint > points = expandSweep( createGridSweepTestSettings( 1 ) );
+
+    REQUIRE( points.size( ) == 6 );
+
+    // The last parameter varies fastest.
+    REQUIRE( points[ 0 ] == SweepPoint( { 6900.0, 300.0 } ) );
+    REQUIRE( points[ 1 ] == SweepPoint( { 6900.0, 600.0 } ) );
+    REQUIRE( points[ 2 ] == SweepPoint( { 7000.0, 300.0 } ) );
+    REQUIRE( points[ 5 ] == SweepPoint( { 7100.0, 600.0 } ) );
+}
+
+TEST_CASE( "Test expansion of Latin hypercube sweep", "[sweep]" )
+{
+    const unsigned int numberOfSamples = 10;
+    const SweepSettings settings = createLatinHypercubeSweepTestSettings( numberOfSamples, 42 );
+    const std::vector< SweepPoint > points = expandSweep( settings );
+
+    REQUIRE( points.size( ) == numberOfSamples );
+    REQUIRE( points == expandSweep( settings ) );
+    REQUIRE( points
+             != expandSweep( createLatinHypercubeSweepTestSettings( numberOfSamples, 43 ) ) );
+
+    // Every stratum of every parameter contains exactly one sample.
+    for ( unsigned int j = 0; j < settings.listOfParameterDefinitions.size( ); j++ )
+    {
+        const SweepParameterDefinition& definition = settings.listOfParameterDefinitions[ j ];
+        std::vector< unsigned int > samplesPerStratum( numberOfSamples, 0 );
+        for ( unsigned int i = 0; i < points.size( ); i++ )
+        {
+            const double fraction
+                = ( points[ i ][ j ] - definition.minimum )
+                  / ( definition.maximum - definition.minimum );
+            REQUIRE( fraction >= 0.0 );
+            REQUIRE( fraction < 1.0 );
+            samplesPerStratum[ static_cast< unsigned int >( fraction * numberOfSamples ) ]++;
+        }
+        REQUIRE( std::count( samplesPerStratum.begin( ), samplesPerStratum.end( ), 1 )
+                 == static_cast< int >( numberOfSamples ) );
+    }
+}
+
+TEST_CASE( "Test simulator settings of sweep run", "[sweep]" )
+{
+    const SimulatorSettings settings = createSweepTestSettings( createGridSweepTestSettings( 1 ) );
+    const SimulatorSettings runSettings
+        = getSweepRunSettings( settings, SweepPoint( { 6950.0, 450.0 } ) );
+
+    REQUIRE( runSettings.integratorSettings.initialState[ 0 ] == 6950.0 );
+    REQUIRE( runSettings.integratorSettings.initialState[ 4 ]
+             == settings.integratorSettings.initialState[ 4 ] );
+    REQUIRE( runSettings.integratorSettings.endTime == 450.0 );
+    REQUIRE( runSettings.integratorSettings.startTime == settings.integratorSettings.startTime );
+    REQUIRE( runSettings.centralGravitySettings.gravitationalParameter
+             == settings.centralGravitySettings.gravitationalParameter );
+
+    REQUIRE_THROWS( getSweepRunSettings( settings, SweepPoint( { 6950.0 } ) ) );
+}
+
+TEST_CASE( "Test invalid sweep run settings are rejected", "[sweep]" )
+{
+    ListOfSweepParameterDefinitions listOfParameterDefinitions;
+    listOfParameterDefinitions.push_back( SweepParameterDefinition(
+        endTimeSweepParameter, std::vector< double >( { -100.0, 300.0 } ), -100.0, 300.0 ) );
+    listOfParameterDefinitions.push_back( SweepParameterDefinition(
+        chaserMassSweepParameter, std::vector< double >( { -1.0, 100.0 } ), -1.0, 100.0 ) );
+    listOfParameterDefinitions.push_back( SweepParameterDefinition(
+        dragAreaSweepParameter, std::vector< double >( { -1.0, 1.0 } ), -1.0, 1.0 ) );
+    const SimulatorSettings settings = createSweepTestSettings(
+        SweepSettings( true, gridSweepMethod, 0, 1, 0, listOfParameterDefinitions, "" ) );
+
+    REQUIRE_NOTHROW( getSweepRunSettings( settings, SweepPoint( { 300.0, 100.0, 1.0 } ) ) );
+    REQUIRE_THROWS_AS( getSweepRunSettings( settings, SweepPoint( { -100.0, 100.0, 1.0 } ) ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS( getSweepRunSettings( settings, SweepPoint( { 300.0, -1.0, 1.0 } ) ),
+                       std::runtime_error );
+    REQUIRE_THROWS_AS( getSweepRunSettings( settings, SweepPoint( { 300.0, 100.0, -1.0 } ) ),
+                       std::runtime_error );
+
+    // A single invalid run fails the sweep before any run is propagated.
+    REQUIRE_THROWS_AS( propagateSweep( settings ), std::runtime_error );
+}
+
+TEST_CASE( "Test sweep is independent of number of threads", "[sweep]" )
+{
+    const Sweep serialSweep
+        = propagateSweep( createSweepTestSettings( createGridSweepTestSettings( 1 ) ) );
+    const Sweep parallelSweep
+        = propagateSweep( createSweepTestSettings( createGridSweepTestSettings( 4 ) ) );
+
+    REQUIRE( serialSweep.size( ) == 6 );
+    REQUIRE( parallelSweep.size( ) == serialSweep.size( ) );
+
+    for ( unsigned int i = 0; i < serialSweep.size( ); i++ )
+    {
+        REQUIRE( serialSweep[ i ].index == i );
+        REQUIRE( parallelSweep[ i ].index == i );
+        REQUIRE( parallelSweep[ i ].point == serialSweep[ i ].point );
+        REQUIRE( parallelSweep[ i ].finalState == serialSweep[ i ].finalState );
+        REQUIRE( serialSweep[ i ].statistics.finalTime == Approx( serialSweep[ i ].point[ 1 ] ) );
+    }
+
+    // Runs that only differ in end time start from the same initial state.
+    REQUIRE( serialSweep[ 0 ].finalState != serialSweep[ 1 ].finalState );
+    REQUIRE( serialSweep[ 0 ].finalState != serialSweep[ 2 ].finalState );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include "Scarab/sweepSettings.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test sweep settings struct", "[simulator],[settings],[sweep]" )
+{
+    std::vector< double > values;
+    values.push_back( 1.0 );
+    values.push_back( 2.0 );
+
+    ListOfSweepParameterDefinitions listOfParameterDefinitions;
+    listOfParameterDefinitions.push_back(
+        SweepParameterDefinition( dragCoefficientSweepParameter, values, 1.0, 2.0 ) );
+
+    const SweepSettings settings( true,
+                                  latinHypercubeSweepMethod,
+                                  100,
+                                  4,
+                                  42,
+                                  listOfParameterDefinitions,
+                                  "sweep.csv" );
+
+    REQUIRE( settings.status                                    == true );
+    REQUIRE( settings.method                                    == latinHypercubeSweepMethod );
+    REQUIRE( settings.numberOfSamples                           == 100 );
+    REQUIRE( settings.numberOfThreads                           == 4 );
+    REQUIRE( settings.seed                                      == 42 );
+    REQUIRE( settings.listOfParameterDefinitions.size( )        == 1 );
+    REQUIRE( settings.listOfParameterDefinitions[ 0 ].parameter == dragCoefficientSweepParameter );
+    REQUIRE( settings.listOfParameterDefinitions[ 0 ].values    == values );
+    REQUIRE( settings.listOfParameterDefinitions[ 0 ].minimum   == 1.0 );
+    REQUIRE( settings.listOfParameterDefinitions[ 0 ].maximum   == 2.0 );
+    REQUIRE( settings.sweepFilename                             == "sweep.csv" );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include <catch.hpp>
+
+#include "Scarab/ephemeris.hpp"
+#include "Scarab/thirdBodyGravityModel.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test third-body gravity acceleration", "[acceleration_models]" )
+{
+    const std::string filename = "testThirdBodyEphemeris.bin";
+
+    // Moon fixed on the x-axis, Sun fixed on the y-axis: only the constant coefficients are set.
+    std::vector< double > moonCoefficients( 3 * 2, 0.0 );
+    moonCoefficients[ 0 ] = 384400.0;
+    std::vector< double > sunCoefficients( 3 * 2, 0.0 );
+    sunCoefficients[ 2 ] = 1.495978707e8;
+
+    std::vector< EphemerisBody > bodies;
+    bodies.push_back( EphemerisBody(
+        "moon", 4902.800066, 0.0, 86400.0, 1, 2, &moonCoefficients[ 0 ] ) );
+    bodies.push_back( EphemerisBody(
+        "sun", 1.32712440018e11, 0.0, 86400.0, 1, 2, &sunCoefficients[ 0 ] ) );
+    writeChebyshevEphemeris( filename, bodies );
+
+    const ChebyshevEphemerisPtr ephemeris = boost::make_shared< ChebyshevEphemeris >( filename );
+
+    State state;
+    state.fill( 0.0 );
+    state[ 0 ] = 7000.0;
+
+    SECTION( "Single body" )
+    {
+        const ThirdBodyGravityModel model( ephemeris, std::vector< std::size_t >( 1, 0 ) );
+
+        // Along the line to the Moon, the perturbation is the difference between the attraction of
+        // the spacecraft and that of the central body.
+        const Acceleration acceleration = model( state, 100.0 );
+        REQUIRE( acceleration[ 0 ] == Approx( 4902.800066 / ( 377400.0 * 377400.0 )
+                                              - 4902.800066 / ( 384400.0 * 384400.0 ) ) );
+        REQUIRE( acceleration[ 1 ] == 0.0 );
+        REQUIRE( acceleration[ 2 ] == 0.0 );
+
+        // At the centre of the central body, the perturbation vanishes.
+        state[ 0 ] = 0.0;
+        const Acceleration centralAcceleration = model( state, 100.0 );
+        REQUIRE( centralAcceleration[ 0 ] == Approx( 0.0 ).margin( 1.0e-20 ) );
+    }
+
+    SECTION( "Multiple bodies" )
+    {
+        std::vector< std::size_t > bodyIndices;
+        bodyIndices.push_back( 0 );
+        bodyIndices.push_back( 1 );
+        const ThirdBodyGravityModel model( ephemeris, bodyIndices );
+        const ThirdBodyGravityModel sunModel( ephemeris, std::vector< std::size_t >( 1, 1 ) );
+        const ThirdBodyGravityModel moonModel( ephemeris, std::vector< std::size_t >( 1, 0 ) );
+
+        const Acceleration acceleration = model( state, 100.0 );
+        const Acceleration sunAcceleration = sunModel( state, 100.0 );
+        const Acceleration moonAcceleration = moonModel( state, 100.0 );
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            REQUIRE( acceleration[ i ]
+                     == Approx( sunAcceleration[ i ] + moonAcceleration[ i ] ).margin( 1.0e-20 ) );
+        }
+
+        // Tidal acceleration of the Sun along the x-axis is compressive.
+        REQUIRE( sunAcceleration[ 0 ] < 0.0 );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <stdexcept>
+
+#include <catch.hpp>
+
+#include "Scarab/threadPool.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+TEST_CASE( "Test thread pool executes all submitted tasks", "[thread_pool]" )
+{
+    ThreadPool threadPool( 4 );
+    REQUIRE( threadPool.size( ) == 4 );
+
+    std::atomic< int > sum( 0 );
+    for ( int i = 1; i <= 1000; i++ )
+    {
+        threadPool.submit( [ &sum, i ]( ) { sum += i; } );
+    }
+    threadPool.wait( );
+
+    REQUIRE( sum == 500500 );
+
+    // Pool can be reused after waiting.
+    threadPool.submit( [ &sum ]( ) { sum = 0; } );
+    threadPool.wait( );
+
+    REQUIRE( sum == 0 );
+}
+
+TEST_CASE( "Test thread pool rethrows exceptions thrown by tasks", "[thread_pool]" )
+{
+    ThreadPool threadPool( 2 );
+
+    std::atomic< int > numberOfExecutedTasks( 0 );
+    for ( int i = 0; i < 10; i++ )
+    {
+        threadPool.submit( [ &numberOfExecutedTasks, i ]( )
+                           {
+                               numberOfExecutedTasks++;
+                               if ( i == 5 )
+                               {
+                                   throw std::runtime_error( "task failed" );
+                               }
+                           } );
+    }
+
+    REQUIRE_THROWS_AS( threadPool.wait( ), std::runtime_error );
+    REQUIRE( numberOfExecutedTasks == 10 );
+
+    // Exception is only rethrown once.
+    REQUIRE_NOTHROW( threadPool.wait( ) );
+}
+
+} // namespace tests
+} // namespace scarab
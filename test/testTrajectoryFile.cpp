@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2015 Kartik Kumar, Dinamica Srl
+ * Copyright (c) 2014-2015 Marko Jankovic, DFKI GmbH
+ * Copyright (c) 2014-2015 Natalia Ortiz, University of Southampton
+ * Copyright (c) 2014-2015 Juan Romero, University of Strathclyde
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <catch.hpp>
+
+#include "Scarab/trajectoryFile.hpp"
+#include "Scarab/typedefs.hpp"
+
+namespace scarab
+{
+namespace tests
+{
+
+//! Get test state for given sample index.
+State getTrajectoryTestState( const unsigned int index )
+{
+    State state;
+    for ( unsigned int i = 0; i < state.size( ); i++ )
+    {
+        state[ i ] = ( 7000.0 + index ) / ( i + 3.0 ) - 1.0e-7 * index * i;
+    }
+    return state;
+}
+
+TEST_CASE( "Test binary trajectory file round trip", "[output],[trajectory_file]" )
+{
+    const std::string filename = "testTrajectoryFile.bin";
+
+    TrajectoryMetadata metadata;
+    metadata.push_back( TrajectoryMetadataEntry( "gravitational_parameter", 398600.4418,
+                                                 "km^3 s^-2" ) );
+    metadata.push_back( TrajectoryMetadataEntry( "start_time", 0.1, "s" ) );
+
+    // Quotes, backslashes and control characters are escaped in the JSON header.
+    metadata.push_back( TrajectoryMetadataEntry( "\"quoted\"\tname\\", 1.0, "\n" ) );
+
+    // Write number of samples that is not a multiple of the chunk size.
+    const unsigned int numberOfSamples = 23;
+    {
+        BinaryStateHistoryWriter writer( filename, 5 );
+        for ( unsigned int i = 0; i < numberOfSamples; i++ )
+        {
+            writer.write( 0.1 * i, getTrajectoryTestState( i ) );
+        }
+        writer.close( metadata );
+        REQUIRE( writer.getNumberOfSamples( ) == numberOfSamples );
+        REQUIRE_THROWS( writer.write( 0.0, getTrajectoryTestState( 0 ) ) );
+    }
+
+    // Spill files are removed on close.
+    REQUIRE( !std::ifstream( ( filename + ".t.tmp" ).c_str( ) ) );
+
+    {
+        const TrajectoryFileReader reader( filename );
+
+        REQUIRE( reader.getNumberOfRows( ) == numberOfSamples );
+        REQUIRE( reader.getColumnNames( ).size( ) == 7 );
+        REQUIRE( reader.getColumnNames( )[ 0 ] == "t" );
+        REQUIRE( reader.getColumnNames( )[ 6 ] == "vz" );
+        REQUIRE( reader.getColumnUnits( )[ 1 ] == "km" );
+
+        REQUIRE( reader.getMetadata( ).size( ) == 3 );
+        REQUIRE( reader.getMetadata( )[ 0 ].name == "gravitational_parameter" );
+        REQUIRE( reader.getMetadata( )[ 0 ].value == 398600.4418 );
+        REQUIRE( reader.getMetadata( )[ 0 ].units == "km^3 s^-2" );
+        REQUIRE( reader.getMetadata( )[ 1 ].value == 0.1 );
+        REQUIRE( reader.getMetadata( )[ 2 ].name == "\"quoted\"\tname\\" );
+        REQUIRE( reader.getMetadata( )[ 2 ].units == "\n" );
+
+        // Columns are aligned and contain values bit-for-bit.
+        const double* time = reader.getColumn( "t" );
+        REQUIRE( reinterpret_cast< std::size_t >( time ) % 8 == 0 );
+        for ( unsigned int i = 0; i < numberOfSamples; i++ )
+        {
+            REQUIRE( time[ i ] == 0.1 * i );
+            REQUIRE( reader.getState( i ) == getTrajectoryTestState( i ) );
+        }
+        REQUIRE( reader.getColumn( 4 ) == reader.getColumn( "vx" ) );
+
+        REQUIRE_THROWS( reader.getColumn( "ax" ) );
+        REQUIRE_THROWS( reader.getColumn( 7 ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+TEST_CASE( "Test trajectory file reader rejects invalid files", "[output],[trajectory_file]" )
+{
+    const std::string filename = "testTrajectoryFileInvalid.bin";
+
+    SECTION( "Test file without magic string" )
+    {
+        {
+            std::ofstream file( filename.c_str( ) );
+            file << "t,x,y,z,vx,vy,vz" << std::endl;
+            file << "0,7000,0,0,0,7.5,1" << std::endl;
+        }
+        REQUIRE_THROWS( TrajectoryFileReader( filename ) );
+    }
+
+    SECTION( "Test file with unsupported version" )
+    {
+        {
+            BinaryStateHistoryWriter writer( filename, 4 );
+            writer.write( 0.0, getTrajectoryTestState( 0 ) );
+            writer.close( TrajectoryMetadata( ) );
+        }
+        {
+            std::fstream file( filename.c_str( ),
+                               std::ios::in | std::ios::out | std::ios::binary );
+            file.seekp( 8 );
+            file.put( 2 );
+        }
+        REQUIRE_THROWS( TrajectoryFileReader( filename ) );
+    }
+
+    std::remove( filename.c_str( ) );
+}
+
+} // namespace tests
+} // namespace scarab
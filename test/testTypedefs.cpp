@@ -7,7 +7,6 @@
  * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
  */
 
-#include <map>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -29,7 +28,6 @@ TEST_CASE( "Test definition of typedefs", "[typedefs]" )
     REQUIRE( typeid( Velocity )         == typeid( boost::array< double, 3 > ) );
     REQUIRE( typeid( Acceleration )     == typeid( boost::array< double, 3 > ) );
     REQUIRE( typeid( State )            == typeid( boost::array< double, 6 > ) );
-    REQUIRE( typeid( StateHistory )     == typeid( std::map< double, State > ) );
     REQUIRE( typeid( ListOfModelNames ) == typeid( std::vector< std::string > ) );
 }
 